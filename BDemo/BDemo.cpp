@@ -5,14 +5,20 @@
 #include <math.h>
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 
-#include <btrieveCpp.h>
+#include <chrono>
+
+#include <btrieveTable.h>
 
 static char* btrieveFileName = (char*)"squaresAndSquareRoots.btr";
 
 #define MIN_X 0
 #define MAX_X 255
 
+#define MIN_BATCH_SIZE 1
+#define MAX_BATCH_SIZE ( MAX_X - MIN_X + 1 )
+
 #pragma pack(1)
 typedef struct {
 	uint8_t x;
@@ -23,6 +29,11 @@ typedef struct {
 
 typedef uint8_t _key_t;
 
+typedef BtrieveTable<record_t, BTRIEVE_KEY ( record_t, x )> squaresTable_t;		// Index 1 is x, unique
+
+static bool verbose = true;													// Cleared by -q, which suppresses the per-record listing
+static int batchSize = 0;													// Set by -b, which selects the bulk-load mode; 0 loads one record at a time
+
 static Btrieve::StatusCode ReportExceptionAndReturn ( const char * pachrMessage, const Btrieve::StatusCode pintStatusCode )
 {
 	printf (
@@ -35,10 +46,15 @@ static Btrieve::StatusCode ReportExceptionAndReturn ( const char * pachrMessage,
 
 static int ShowUsageAndQuit ( const char* pszProgramName , const int pintStatusCode )
 {
-	printf ("Usage: %s uint8_value, where uint8_value is between %u and %u inclusive\n",
+	printf ("Usage: %s uint8_value [-q] [-b batch_size], where uint8_value is between %u and %u inclusive\n"
+		"       -q  suppresses the listing of each record as it is loaded\n"
+		"       -b  loads the table both one record at a time and in BulkCreate batches of batch_size records,\n"
+		"           where batch_size is between %u and %u inclusive, and reports the records/sec of each\n",
 		pszProgramName ,												// Usage: %s uint8_value
 		MIN_X,															// where uint8_value is between %u
-		MAX_X);															// and %u inclusive
+		MAX_X,															// and %u inclusive
+		MIN_BATCH_SIZE,													// where batch_size is between %u
+		MAX_BATCH_SIZE);												// and %u inclusive
 	return pintStatusCode;
 }	// static int ShowUsageAndQuit
 
@@ -52,11 +68,11 @@ static Btrieve::StatusCode createFile ( BtrieveClient* btrieveClient )
 		"createFile: SetFixedRecordLength = %i ... ",							// Format control string
 		( int ) sizeof ( record_t ) );											// SetFixedRecordLength = %i, where the size of record_t is size_t, which must be cast to int to suppress a compiler warning
 
-	// If SetFixedRecordLength() fails.
-	if ( ( status = btrieveFileAttributes.SetFixedRecordLength ( sizeof ( record_t ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	// If GetFileAttributes() fails.
+	if ( ( status = squaresTable_t::GetFileAttributes ( &btrieveFileAttributes ) ) != Btrieve::STATUS_CODE_NO_ERROR )
 	{
 		return ReportExceptionAndReturn (
-			"Error: BtrieveFileAttributes::SetFixedRecordLength():%d:%s.\n", 
+			"Error: squaresTable_t::GetFileAttributes():%d:%s.\n", 
 			status);
 	}
 
@@ -98,12 +114,45 @@ static Btrieve::StatusCode openFile ( BtrieveClient * btrieveClient, BtrieveFile
 }	// static Btrieve::StatusCode openFile
 
 
-static Btrieve::StatusCode loadFile ( BtrieveFile* btrieveFile )
+static void buildRecord ( record_t* record, int i )
 {
+	record->x			= ( uint8_t ) i;
+	record->xSquared	= ( uint16_t ) ( i * i );
+	record->xSquareRoot	= sqrt ( ( double ) i );
+}	// static void buildRecord
+
+
+static void showRecord ( const record_t* record, int j )
+{
+	// If the listing was suppressed.
+	if ( !verbose )
+		return;
+
+	printf (
+		"          Record %i: Index = %i, Square of Index = %i, Squre root of Index = %f\n",
+		j,																	// Record %i
+		record->x,															// Index = %i
+		record->xSquared,													// Square of Index = %i
+		record->xSquareRoot);												// Squre root of Index = %f
+}	// static void showRecord
+
+
+static double recordsPerSecond ( int records, std::chrono::steady_clock::time_point started )
+{
+	double seconds = std::chrono::duration<double> ( std::chrono::steady_clock::now ( ) - started ).count ( );
+
+	return ( seconds > 0.0 ) ? records / seconds : 0.0;
+}	// static double recordsPerSecond
+
+
+static Btrieve::StatusCode loadFile ( BtrieveFile* btrieveFile, double* rate )
+{
+	squaresTable_t squaresTable ( btrieveFile );
 	int i;
 	record_t record;
 	int j						= 0;
 	Btrieve::StatusCode status	= Btrieve::STATUS_CODE_NO_ERROR;
+	std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now ( );
 
 	printf ( "loadFile: Building lookup table of squares and square roots:\n\n" );
 
@@ -111,26 +160,20 @@ static Btrieve::StatusCode loadFile ( BtrieveFile* btrieveFile )
 		  i <= MAX_X;
 		  i++, j++ )
 	{
-		record.x			= ( uint8_t ) i;
-		record.xSquared		= ( uint16_t ) ( i * i );
-		record.xSquareRoot	= sqrt ( ( double ) i );
+		buildRecord ( &record, i );
+		showRecord ( &record, j );
 
-		printf (
-			"          Record %i: Index = %i, Square of Index = %i, Squre root of Index = %f\n",
-			j,																	// Record %i
-			record.x,															// Index = %i
-			record.xSquared,													// Square of Index = %i
-			record.xSquareRoot);												// Squre root of Index = %f
-
-		// If RecordCreate() fails.
-		if ( ( status = btrieveFile->RecordCreate ( ( char* ) &record , sizeof ( record ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		// If Insert() fails.
+		if ( ( status = squaresTable.Insert ( &record ) ) != Btrieve::STATUS_CODE_NO_ERROR )
 		{
 			return ReportExceptionAndReturn (
-				"Error: BtrieveFile::RecordCreate():%d:%s.\n",
+				"Error: squaresTable_t::Insert():%d:%s.\n",
 				status );
-		}	// if ( ( status = btrieveFile->RecordCreate ( ( char* ) &record , sizeof ( record ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		}	// if ( ( status = squaresTable.Insert ( &record ) ) != Btrieve::STATUS_CODE_NO_ERROR )
 	}	// for ( i = MIN_X; i <= MAX_X; i++, j++ )
 
+	*rate = recordsPerSecond ( j, started );
+
 	printf (
 		"\nloadFile finished loading %i items into lookup table\n\n",
 		j );
@@ -138,6 +181,70 @@ static Btrieve::StatusCode loadFile ( BtrieveFile* btrieveFile )
 }	// static Btrieve::StatusCode loadFile
 
 
+static Btrieve::StatusCode bulkLoadFile ( BtrieveFile* btrieveFile, double* rate )
+{
+	int i;
+	record_t record;
+	int j						= 0;
+	Btrieve::StatusCode status	= Btrieve::STATUS_CODE_NO_ERROR;
+	std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now ( );
+
+	printf (
+		"bulkLoadFile: Building lookup table of squares and square roots in batches of %i:\n\n",
+		batchSize );
+
+	for ( i = MIN_X;
+		  i <= MAX_X;
+		  i += batchSize )
+	{
+		BtrieveBulkCreatePayload btrieveBulkCreatePayload;
+		BtrieveBulkCreateResult btrieveBulkCreateResult;
+		int batchCount = 0;
+
+		for ( ; ( batchCount < batchSize ) && ( i + batchCount <= MAX_X ); batchCount++, j++ )
+		{
+			buildRecord ( &record, i + batchCount );
+			showRecord ( &record, j );
+
+			// If AddRecord() fails.
+			if ( ( status = btrieveBulkCreatePayload.AddRecord ( ( char* ) &record, sizeof ( record ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+			{
+				return ReportExceptionAndReturn (
+					"Error: BtrieveBulkCreatePayload::AddRecord():%d:%s.\n",
+					status );
+			}	// if ( ( status = btrieveBulkCreatePayload.AddRecord ( ( char* ) &record, sizeof ( record ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		}	// for ( ; ( batchCount < batchSize ) && ( i + batchCount <= MAX_X ); batchCount++, j++ )
+
+		// If BulkCreate() fails.
+		if ( ( status = btrieveFile->BulkCreate ( &btrieveBulkCreatePayload, &btrieveBulkCreateResult ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::BulkCreate():%d:%s.\n",
+				status );
+		}
+
+		// If BulkCreate() stopped short of the end of the batch.
+		if ( btrieveBulkCreateResult.GetRecordCount ( ) != batchCount )
+		{
+			printf (
+				"Error: BtrieveBulkCreateResult::GetRecordCount():%i of %i records created.\n",
+				btrieveBulkCreateResult.GetRecordCount ( ),
+				batchCount );
+			return ReportExceptionAndReturn (
+				"Error: BtrieveBulkCreateResult::GetLastStatusCode():%d:%s.\n",
+				btrieveBulkCreateResult.GetLastStatusCode ( ) );
+		}	// if ( btrieveBulkCreateResult.GetRecordCount ( ) != batchCount )
+	}	// for ( i = MIN_X; i <= MAX_X; i += batchSize )
+
+	*rate = recordsPerSecond ( j, started );
+
+	printf (
+		"\nbulkLoadFile finished loading %i items into lookup table\n\n",
+		j );
+	return status;
+}	// static Btrieve::StatusCode bulkLoadFile
+
+
 static Btrieve::StatusCode closeFile ( BtrieveClient* btrieveClient, BtrieveFile* btrieveFile )
 {
 	Btrieve::StatusCode status;
@@ -179,25 +286,14 @@ static Btrieve::StatusCode createIndex ( BtrieveFile* btrieveFile )
 {
 	Btrieve::StatusCode status;
 	BtrieveIndexAttributes btrieveIndexAttributes;
-	BtrieveKeySegment btrieveKeySegment;
-
-	printf ( "createIndex: Setting index field ... " );
-
-	// If SetField ( ) fails.
-	if ( ( status = btrieveKeySegment.SetField ( 0, 1, Btrieve::DATA_TYPE_UNSIGNED_BINARY ) ) != Btrieve::STATUS_CODE_NO_ERROR )
-	{
-		return ReportExceptionAndReturn (
-			"Error: BtrieveKeySegment::SetField():%d:%s.\n",
-			status );
-	}
 
-	printf ( "done\n             Adding key segment ... " );
+	printf ( "createIndex: Setting index attributes ... " );
 
-	// If AddKeySegment ( ) fails.
-	if ( ( status = btrieveIndexAttributes.AddKeySegment ( &btrieveKeySegment ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	// If GetIndexAttributes ( ) fails.
+	if ( ( status = squaresTable_t::GetIndexAttributes<0> ( &btrieveIndexAttributes ) ) != Btrieve::STATUS_CODE_NO_ERROR )
 	{
 		return ReportExceptionAndReturn (
-			"Error: BtrieveIndexAttributes::AddKeySegment():%d:%s.\n",
+			"Error: squaresTable_t::GetIndexAttributes():%d:%s.\n",
 			status );
 	}
 
@@ -219,14 +315,15 @@ static Btrieve::StatusCode createIndex ( BtrieveFile* btrieveFile )
 static Btrieve::StatusCode retrieveRecord ( BtrieveFile* btrieveFile, _key_t* key )
 {
 	Btrieve::StatusCode status = Btrieve::STATUS_CODE_NO_ERROR;
+	squaresTable_t squaresTable ( btrieveFile );
 	record_t record;
 
-	// If RecordRetrieve() fails.
-	if ( btrieveFile->RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, ( char* ) key, sizeof ( *key ), ( char* ) &record, sizeof ( record ) ) != sizeof ( record ) )
+	// If Find() fails.
+	if ( ( status = squaresTable.Find<0> ( *key, &record ) ) != Btrieve::STATUS_CODE_NO_ERROR )
 	{
 		return ReportExceptionAndReturn (
-			"Error: BtrieveFile::RecordRetrieve():%d:%s.\n",
-			btrieveFile->GetLastStatusCode ( ) );
+			"Error: squaresTable_t::Find():%d:%s.\n",
+			status );
 	}
 
 	printf (
@@ -244,18 +341,49 @@ int main ( int argc, char* argv [ ] )
 	BtrieveFile btrieveFile;
 	_key_t key;
 	uint64_t integerValue;
+	int argi;
+	double perRecordRate	= 0.0;
+	double bulkRate			= 0.0;
 
 	BtrieveClient btrieveClient ( 0x4232, 0) ;
 	Btrieve::StatusCode status = Btrieve::STATUS_CODE_UNKNOWN;
 
 	// If the incorrect number of arguments were given.
-	if ( argc != 2 )
+	if ( argc < 2 )
 	{
 		return ShowUsageAndQuit (
 			argv [ 0 ] ,
 			1 );
 	}
 
+	for ( argi = 2; argi < argc; argi++ )
+	{
+		// If the listing is to be suppressed.
+		if ( strcmp ( argv [ argi ], "-q" ) == 0 )
+		{
+			verbose = false;
+		}
+		// If the bulk-load mode was selected, and its batch size follows.
+		else if ( ( strcmp ( argv [ argi ], "-b" ) == 0 ) && ( argi + 1 < argc ) )
+		{
+			batchSize = atoi ( argv [ ++argi ] );
+
+			// If batchSize is out of range.
+			if ( ( batchSize < MIN_BATCH_SIZE ) || ( batchSize > MAX_BATCH_SIZE ) )
+			{
+				return ShowUsageAndQuit (
+					argv [ 0 ] ,
+					2 );
+			}
+		}
+		else
+		{
+			return ShowUsageAndQuit (
+				argv [ 0 ] ,
+				1 );
+		}
+	}	// for ( argi = 2; argi < argc; argi++ )
+
 	integerValue = atoi ( argv [ 1 ] );
 
 	// If integerValue is out of range.
@@ -281,11 +409,48 @@ int main ( int argc, char* argv [ ] )
 	}
 
 	// If loadFile ( ) fails.
-	if ( ( status = loadFile ( &btrieveFile ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	if ( ( status = loadFile ( &btrieveFile, &perRecordRate ) ) != Btrieve::STATUS_CODE_NO_ERROR )
 	{
 		return 3;
 	}
 
+	// If the bulk-load mode was selected.
+	if ( batchSize > 0 )
+	{
+		// Start over from an empty file, so that both loads do the same work.
+
+		// If closeFile ( ) fails.
+		if ( ( status = closeFile ( &btrieveClient, &btrieveFile ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return 3;
+		}
+
+		// If createFile ( ) fails.
+		if ( ( status = createFile ( &btrieveClient ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return 3;
+		}
+
+		// If openFile ( ) fails.
+		if ( ( status = openFile ( &btrieveClient, &btrieveFile ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return 3;
+		}
+
+		// If bulkLoadFile ( ) fails.
+		if ( ( status = bulkLoadFile ( &btrieveFile, &bulkRate ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return 3;
+		}
+
+		printf (
+			"load rates: RecordCreate               = %.0f records/sec\n"
+			"            BulkCreate (batches of %3i) = %.0f records/sec\n\n",
+			perRecordRate,														// RecordCreate = %.0f records/sec
+			batchSize,															// BulkCreate (batches of %3i)
+			bulkRate );															// = %.0f records/sec
+	}	// if ( batchSize > 0 )
+
 	// If createIndex ( ) fails.
 	if ( ( status = createIndex ( &btrieveFile ) ) != Btrieve::STATUS_CODE_NO_ERROR )
 	{
@@ -0,0 +1,1734 @@
+// BDemoBench.cpp : Measures the BtrieveFile calls that BDemo relies on, across
+//                  a matrix of record sizes, key types and page sizes, and
+//                  writes the throughput and latency percentiles as JSON.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include <btrieveAdaptiveRetriever.h>
+#include <btrieveAsync.h>
+#include <btrieveClientPool.h>
+#include <btrieveColumns.h>
+#include <btrieveCpp.h>
+#include <btrieveEngineCpp.h>
+#include <btrieveFileCache.h>
+#include <btrieveParallelScan.h>
+#include <btrievePredicate.h>
+#include <btrieveRange.h>
+#include <btrieveRecordCache.h>
+#include <btrieveScanner.h>
+
+static char* btrieveFileName = (char*)"bdemoBench.btr";
+
+#define DEFAULT_RECORD_COUNT 10000
+#define MIN_RECORD_COUNT 1
+#define BULK_BATCH_SIZE 100
+#define ZSTRING_KEY_LENGTH 16
+#define POOL_MAXIMUM_CLIENTS 4
+#define RECORD_CACHE_PASSES 4
+#define RECORD_CACHE_UPDATE_THREADS 2
+#define FILE_CACHE_THREADS 2
+#define PARALLEL_SCAN_PARTITIONS 4
+#define ASYNC_THREADS 2
+#define ASYNC_CLIENTS 4
+#define ASYNC_TRANSACTION_SIZE 64
+
+typedef struct {
+	Btrieve::DataType dataType;
+	int keyLength;
+	const char* name;
+} keyType_t;
+
+static const int recordSizes [ ] = { 16, 128, 1024 };
+
+static const keyType_t keyTypes [ ] = {
+	{ Btrieve::DATA_TYPE_UNSIGNED_BINARY, 4, "UNSIGNED_BINARY" },
+	{ Btrieve::DATA_TYPE_INTEGER, 4, "INTEGER" },
+	{ Btrieve::DATA_TYPE_ZSTRING, ZSTRING_KEY_LENGTH, "ZSTRING" }
+};
+
+static const Btrieve::PageSize pageSizes [ ] = {
+	Btrieve::PAGE_SIZE_512,
+	Btrieve::PAGE_SIZE_1024,
+	Btrieve::PAGE_SIZE_1536,
+	Btrieve::PAGE_SIZE_2048,
+	Btrieve::PAGE_SIZE_3072,
+	Btrieve::PAGE_SIZE_3584,
+	Btrieve::PAGE_SIZE_4096,
+	Btrieve::PAGE_SIZE_8192,
+	Btrieve::PAGE_SIZE_16384
+};
+
+static const int pageSizeBytes [ ] = { 512, 1024, 1536, 2048, 3072, 3584, 4096, 8192, 16384 };
+
+#define COUNT_OF(array) ( ( int ) ( sizeof ( array ) / sizeof ( ( array ) [ 0 ] ) ) )
+
+// One cell of the matrix.
+typedef struct {
+	int recordSize;
+	const keyType_t* keyType;
+	int pageSizeIndex;
+} benchCase_t;
+
+// The timings of one operation in one cell; each call may process several records.
+typedef struct {
+	std::vector<uint64_t> latencies;										// Nanoseconds per call
+	uint64_t records;
+} benchTimings_t;
+
+typedef std::chrono::steady_clock benchClock;
+
+static int recordCount = DEFAULT_RECORD_COUNT;
+static bool firstResult = true;
+
+
+static Btrieve::StatusCode ReportExceptionAndReturn ( const char * pachrMessage, const Btrieve::StatusCode pintStatusCode )
+{
+	fprintf (
+		stderr,
+		pachrMessage,
+		pintStatusCode,
+		Btrieve::StatusCodeToString ( pintStatusCode ) );
+	return pintStatusCode;
+}	// static Btrieve::StatusCode ReportExceptionAndReturn
+
+
+static int ShowUsageAndQuit ( const char* pszProgramName , const int pintStatusCode )
+{
+	fprintf ( stderr,
+		"Usage: %s [-n records] [-o file], where records is at least %u (default %u)\n"
+		"       and the JSON results go to file, or to standard output if -o is omitted\n",
+		pszProgramName ,												// Usage: %s
+		MIN_RECORD_COUNT,												// where records is at least %u
+		DEFAULT_RECORD_COUNT);											// (default %u)
+	return pintStatusCode;
+}	// static int ShowUsageAndQuit
+
+
+static uint64_t elapsedNanoseconds ( benchClock::time_point started )
+{
+	return ( uint64_t ) std::chrono::duration_cast<std::chrono::nanoseconds> ( benchClock::now ( ) - started ).count ( );
+}	// static uint64_t elapsedNanoseconds
+
+
+// Spread the record numbers over the key space, so that neither loads nor lookups run in key order.
+static uint32_t keyValue ( int i )
+{
+	return ( uint32_t ) i * 2654435761u;
+}	// static uint32_t keyValue
+
+
+static void buildKey ( const keyType_t* keyType, uint32_t value, char* key )
+{
+	switch ( keyType->dataType )
+	{
+		case Btrieve::DATA_TYPE_INTEGER:
+		{
+			int32_t signedValue = ( int32_t ) value;
+
+			memcpy ( key, &signedValue, sizeof ( signedValue ) );
+			break;
+		}
+		case Btrieve::DATA_TYPE_ZSTRING:
+			memset ( key, 0, ZSTRING_KEY_LENGTH );
+			snprintf ( key, ZSTRING_KEY_LENGTH, "%010u", value );
+			break;
+		default:
+			memcpy ( key, &value, sizeof ( value ) );
+			break;
+	}	// switch ( keyType->dataType )
+}	// static void buildKey
+
+
+static void buildRecord ( const benchCase_t* benchCase, int i, char* record )
+{
+	memset ( record, ( int ) ( i & 0xFF ), benchCase->recordSize );
+	buildKey ( benchCase->keyType, keyValue ( i ), record );
+}	// static void buildRecord
+
+
+static Btrieve::StatusCode createFile ( BtrieveClient* btrieveClient, BtrieveFile* btrieveFile, const benchCase_t* benchCase )
+{
+	Btrieve::StatusCode status;
+	BtrieveFileAttributes btrieveFileAttributes;
+	BtrieveIndexAttributes btrieveIndexAttributes;
+	BtrieveKeySegment btrieveKeySegment;
+
+	// If SetFixedRecordLength() fails.
+	if ( ( status = btrieveFileAttributes.SetFixedRecordLength ( benchCase->recordSize ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFileAttributes::SetFixedRecordLength():%d:%s.\n",
+			status );
+	}
+
+	// If SetPageSize() fails.
+	if ( ( status = btrieveFileAttributes.SetPageSize ( pageSizes [ benchCase->pageSizeIndex ] ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFileAttributes::SetPageSize():%d:%s.\n",
+			status );
+	}
+
+	// If FileCreate() fails.
+	if ( ( status = btrieveClient->FileCreate ( &btrieveFileAttributes, btrieveFileName, Btrieve::CREATE_MODE_OVERWRITE ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveClient::FileCreate():%d:%s.\n",
+			status );
+	}
+
+	// If FileOpen ( ) fails.
+	if ( ( status = btrieveClient->FileOpen ( btrieveFile, btrieveFileName, NULL, Btrieve::OPEN_MODE_NORMAL ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveClient::FileOpen():%d:%s.\n",
+			status );
+	}
+
+	// If SetField ( ) fails.
+	if ( ( status = btrieveKeySegment.SetField ( 0, benchCase->keyType->keyLength, benchCase->keyType->dataType ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveKeySegment::SetField():%d:%s.\n",
+			status );
+	}
+
+	// If AddKeySegment ( ) fails.
+	if ( ( status = btrieveIndexAttributes.AddKeySegment ( &btrieveKeySegment ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveIndexAttributes::AddKeySegment():%d:%s.\n",
+			status );
+	}
+
+	// If IndexCreate() fails.
+	if ( ( status = btrieveFile->IndexCreate ( &btrieveIndexAttributes ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::IndexCreate():%d:%s.\n",
+			status );
+	}
+
+	return status;
+}	// static Btrieve::StatusCode createFile
+
+
+static Btrieve::StatusCode closeAndDeleteFile ( BtrieveClient* btrieveClient, BtrieveFile* btrieveFile )
+{
+	Btrieve::StatusCode status;
+
+	// If FileClose ( ) fails.
+	if ( ( status = btrieveClient->FileClose ( btrieveFile ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveClient::FileClose():%d:%s.\n",
+			status );
+	}
+
+	// If FileDelete() fails.
+	if ( ( status = btrieveClient->FileDelete ( btrieveFileName ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveClient::FileDelete():%d:%s.\n",
+			status );
+	}
+
+	return status;
+}	// static Btrieve::StatusCode closeAndDeleteFile
+
+
+static uint64_t percentile ( std::vector<uint64_t>* sorted, double fraction )
+{
+	size_t rank;
+
+	// If nothing was measured.
+	if ( sorted->empty ( ) )
+		return 0;
+
+	rank = ( size_t ) ( fraction * ( double ) sorted->size ( ) );
+	rank = ( rank >= sorted->size ( ) ) ? sorted->size ( ) - 1 : rank;
+	return ( *sorted ) [ rank ];
+}	// static uint64_t percentile
+
+
+static void writeResult ( FILE* output, const char* operation, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	uint64_t total = 0;
+
+	for ( size_t i = 0; i < timings->latencies.size ( ); i++ )
+		total += timings->latencies [ i ];
+
+	std::sort ( timings->latencies.begin ( ), timings->latencies.end ( ) );
+
+	fprintf (
+		output,
+		"%s\n    { \"operation\": \"%s\", \"recordSize\": %i, \"keyType\": \"%s\", \"pageSize\": %i, "
+		"\"calls\": %llu, \"records\": %llu, \"opsPerSecond\": %.1f, "
+		"\"p50Nanoseconds\": %llu, \"p99Nanoseconds\": %llu, \"p999Nanoseconds\": %llu }",
+		firstResult ? "" : ",",													// Separates this result from the one before
+		operation,																// "operation": "%s"
+		benchCase->recordSize,													// "recordSize": %i
+		benchCase->keyType->name,												// "keyType": "%s"
+		pageSizeBytes [ benchCase->pageSizeIndex ],								// "pageSize": %i
+		( unsigned long long ) timings->latencies.size ( ),						// "calls": %llu
+		( unsigned long long ) timings->records,								// "records": %llu
+		( total > 0 ) ? ( double ) timings->records * 1e9 / ( double ) total : 0.0,	// "opsPerSecond": %.1f
+		( unsigned long long ) percentile ( &timings->latencies, 0.50 ),		// "p50Nanoseconds": %llu
+		( unsigned long long ) percentile ( &timings->latencies, 0.99 ),		// "p99Nanoseconds": %llu
+		( unsigned long long ) percentile ( &timings->latencies, 0.999 ) );		// "p999Nanoseconds": %llu
+	firstResult = false;
+}	// static void writeResult
+
+
+static Btrieve::StatusCode benchRecordCreate ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	Btrieve::StatusCode status;
+
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		benchClock::time_point started;
+
+		buildRecord ( benchCase, i, &record [ 0 ] );
+		started = benchClock::now ( );
+
+		// If RecordCreate() fails.
+		if ( ( status = btrieveFile->RecordCreate ( &record [ 0 ], benchCase->recordSize ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::RecordCreate():%d:%s.\n",
+				status );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records++;
+	}	// for ( int i = 0; i < recordCount; i++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchRecordCreate
+
+
+static Btrieve::StatusCode benchRecordRetrieve ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		benchClock::time_point started;
+
+		// Look the records up in another order than they were created in.
+		buildKey ( benchCase->keyType, keyValue ( ( int ) ( ( ( uint64_t ) i * 7919 ) % recordCount ) ), key );
+		started = benchClock::now ( );
+
+		// If RecordRetrieve() fails.
+		if ( btrieveFile->RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::RecordRetrieve():%d:%s.\n",
+				btrieveFile->GetLastStatusCode ( ) );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records++;
+	}	// for ( int i = 0; i < recordCount; i++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchRecordRetrieve
+
+
+static Btrieve::StatusCode benchKeyRetrieve ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	Btrieve::StatusCode status;
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		benchClock::time_point started;
+
+		buildKey ( benchCase->keyType, keyValue ( ( int ) ( ( ( uint64_t ) i * 7919 ) % recordCount ) ), key );
+		started = benchClock::now ( );
+
+		// If KeyRetrieve() fails.
+		if ( ( status = btrieveFile->KeyRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::KeyRetrieve():%d:%s.\n",
+				status );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records++;
+	}	// for ( int i = 0; i < recordCount; i++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchKeyRetrieve
+
+
+// Look up keys that no record holds, which the engine's Bloom filters answer without a descent.
+static Btrieve::StatusCode benchKeyRetrieveMissing ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	Btrieve::StatusCode status;
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		benchClock::time_point started;
+
+		// keyValue() is one to one, so the values past the last record number are held by no record.
+		buildKey ( benchCase->keyType, keyValue ( recordCount + i ), key );
+		started = benchClock::now ( );
+
+		status = btrieveFile->KeyRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength );
+
+		// If KeyRetrieve() finds the key.
+		if ( status == Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::KeyRetrieve() found a key no record holds:%d:%s.\n",
+				Btrieve::STATUS_CODE_DUPLICATE_KEY_VALUE );
+		}
+
+		// If KeyRetrieve() fails.
+		if ( status != Btrieve::STATUS_CODE_KEY_VALUE_NOT_FOUND )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::KeyRetrieve():%d:%s.\n",
+				status );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records++;
+	}	// for ( int i = 0; i < recordCount; i++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchKeyRetrieveMissing
+
+
+// Look the records RecordRetrieve looks up one at a time up a batch at a time.
+static Btrieve::StatusCode benchMultiGet ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> keys ( ( size_t ) BULK_BATCH_SIZE * benchCase->keyType->keyLength );
+	std::vector<char> records ( ( size_t ) BULK_BATCH_SIZE * benchCase->recordSize );
+	std::vector<Btrieve::StatusCode> statusCodes ( BULK_BATCH_SIZE );
+	BtrieveMultiGetter btrieveMultiGetter ( btrieveFile );
+	Btrieve::StatusCode status;
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	for ( int i = 0; i < recordCount; i += BULK_BATCH_SIZE )
+	{
+		benchClock::time_point started;
+		int batchCount;
+
+		for ( batchCount = 0; ( batchCount < BULK_BATCH_SIZE ) && ( i + batchCount < recordCount ); batchCount++ )
+		{
+			buildKey ( benchCase->keyType, keyValue ( ( int ) ( ( ( uint64_t ) ( i + batchCount ) * 7919 ) % recordCount ) ), key );
+			memcpy ( &keys [ ( size_t ) batchCount * benchCase->keyType->keyLength ], key, benchCase->keyType->keyLength );
+		}
+
+		started = benchClock::now ( );
+
+		// If MultiGet() fails.
+		if ( ( status = btrieveMultiGetter.MultiGet ( Btrieve::INDEX_1, &keys [ 0 ], benchCase->keyType->keyLength, batchCount, &records [ 0 ], benchCase->recordSize, NULL, &statusCodes [ 0 ] ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveMultiGetter::MultiGet():%d:%s.\n",
+				status );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+
+		for ( int j = 0; j < batchCount; j++ )
+		{
+			// If a key wasn't found.
+			if ( statusCodes [ j ] != Btrieve::STATUS_CODE_NO_ERROR )
+			{
+				return ReportExceptionAndReturn (
+					"Error: BtrieveMultiGetter::MultiGet():%d:%s.\n",
+					statusCodes [ j ] );
+			}
+		}
+
+		timings->records += batchCount;
+	}	// for ( int i = 0; i < recordCount; i += BULK_BATCH_SIZE )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchMultiGet
+
+
+static Btrieve::StatusCode benchRecordRetrieveNext ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+
+	// If RecordRetrieveFirst() fails.
+	if ( btrieveFile->RecordRetrieveFirst ( Btrieve::INDEX_1, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::RecordRetrieveFirst():%d:%s.\n",
+			btrieveFile->GetLastStatusCode ( ) );
+	}
+
+	for ( ;; )
+	{
+		benchClock::time_point started = benchClock::now ( );
+		int length = btrieveFile->RecordRetrieveNext ( &record [ 0 ], benchCase->recordSize );
+		uint64_t latency = elapsedNanoseconds ( started );
+
+		// If the scan reached the end of the index.
+		if ( length != benchCase->recordSize && btrieveFile->GetLastStatusCode ( ) == Btrieve::STATUS_CODE_END_OF_FILE )
+			break;
+
+		// If RecordRetrieveNext() fails.
+		if ( length != benchCase->recordSize )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::RecordRetrieveNext():%d:%s.\n",
+				btrieveFile->GetLastStatusCode ( ) );
+		}
+
+		timings->latencies.push_back ( latency );
+		timings->records++;
+	}	// for ( ;; )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchRecordRetrieveNext
+
+
+static Btrieve::StatusCode benchBulkRetrieveNext ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	BtrieveBulkRetrieveAttributes btrieveBulkRetrieveAttributes;
+	Btrieve::StatusCode status;
+
+	// If SetMaximumRecordCount() fails.
+	if ( ( status = btrieveBulkRetrieveAttributes.SetMaximumRecordCount ( BULK_BATCH_SIZE ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveBulkRetrieveAttributes::SetMaximumRecordCount():%d:%s.\n",
+			status );
+	}
+
+	// If AddField() fails.
+	if ( ( status = btrieveBulkRetrieveAttributes.AddField ( 0, benchCase->recordSize ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveBulkRetrieveAttributes::AddField():%d:%s.\n",
+			status );
+	}
+
+	// If RecordRetrieveFirst() fails.
+	if ( btrieveFile->RecordRetrieveFirst ( Btrieve::INDEX_1, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::RecordRetrieveFirst():%d:%s.\n",
+			btrieveFile->GetLastStatusCode ( ) );
+	}
+
+	for ( bool first = true; ; first = false )
+	{
+		BtrieveBulkRetrieveResult btrieveBulkRetrieveResult;
+		benchClock::time_point started;
+
+		// The first batch starts with the record RecordRetrieveFirst() found; later ones follow the last record retrieved.
+		btrieveBulkRetrieveAttributes.SetSkipCurrentRecord ( !first );
+		started = benchClock::now ( );
+		status = btrieveFile->BulkRetrieveNext ( &btrieveBulkRetrieveAttributes, &btrieveBulkRetrieveResult );
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records += btrieveBulkRetrieveResult.GetRecordCount ( );
+
+		// If the scan reached the end of the index.
+		if ( status == Btrieve::STATUS_CODE_END_OF_FILE )
+			break;
+
+		// If BulkRetrieveNext() fails.
+		if ( status != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::BulkRetrieveNext():%d:%s.\n",
+				status );
+		}
+	}	// for ( bool first = true; ; first = false )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBulkRetrieveNext
+
+
+// The lowest key is all zero bytes, except for a signed integer.
+static void buildLowestKey ( const keyType_t* keyType, char* key )
+{
+	int32_t lowestInteger = INT32_MIN;
+
+	memset ( key, 0, ZSTRING_KEY_LENGTH );
+
+	if ( keyType->dataType == Btrieve::DATA_TYPE_INTEGER )
+		memcpy ( key, &lowestInteger, sizeof ( lowestInteger ) );
+}	// static void buildLowestKey
+
+
+// Walk a range, timing each step, and count its rows.
+static Btrieve::StatusCode walkBtrieveRange ( BtrieveRange* btrieveRange, benchTimings_t* timings )
+{
+	benchClock::time_point started = benchClock::now ( );
+
+	// Each step is timed, batch fetches included, so the percentiles show what one record costs.
+	for ( BtrieveRange::iterator row = btrieveRange->begin ( ); row != btrieveRange->end ( ); ++row )
+	{
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records++;
+		started = benchClock::now ( );
+	}	// for ( BtrieveRange::iterator row = btrieveRange->begin ( ); row != btrieveRange->end ( ); ++row )
+
+	// If the walk failed.
+	if ( btrieveRange->GetLastStatusCode ( ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveRange:%d:%s.\n",
+			btrieveRange->GetLastStatusCode ( ) );
+	}
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode walkBtrieveRange
+
+
+static Btrieve::StatusCode benchBtrieveRange ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	char lowKey [ ZSTRING_KEY_LENGTH ];
+
+	buildLowestKey ( benchCase->keyType, lowKey );
+
+	BtrieveRange btrieveRange ( btrieveFile, Btrieve::INDEX_1, lowKey, benchCase->keyType->keyLength, benchCase->recordSize );
+
+	return walkBtrieveRange ( &btrieveRange, timings );
+}	// static Btrieve::StatusCode benchBtrieveRange
+
+
+// Walk the lower half of the key space, which the upper bound's reject count of one ends, and check the row count.
+static Btrieve::StatusCode benchBtrieveRangeBounded ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	char lowKey [ ZSTRING_KEY_LENGTH ];
+	char highKey [ ZSTRING_KEY_LENGTH ];
+	bool isSigned = ( benchCase->keyType->dataType == Btrieve::DATA_TYPE_INTEGER );
+	uint32_t highValue = isSigned ? 0 : 0x7FFFFFFF;
+	long long expected = 0;
+	Btrieve::StatusCode status;
+
+	buildLowestKey ( benchCase->keyType, lowKey );
+	buildKey ( benchCase->keyType, highValue, highKey );
+
+	// Zero padded decimal strings sort as the unsigned values they spell.
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		if ( isSigned ? ( ( int32_t ) keyValue ( i ) <= ( int32_t ) highValue ) : ( keyValue ( i ) <= highValue ) )
+			expected++;
+	}
+
+	BtrieveRange btrieveRange ( btrieveFile, Btrieve::INDEX_1, lowKey, benchCase->keyType->keyLength, benchCase->recordSize );
+
+	// If SetUpperBound() fails.
+	if ( ( status = btrieveRange.SetUpperBound ( 0, benchCase->keyType->keyLength, benchCase->keyType->dataType, highKey ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveRange::SetUpperBound():%d:%s.\n",
+			status );
+	}
+
+	// If the walk fails.
+	if ( ( status = walkBtrieveRange ( &btrieveRange, timings ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If the walk didn't stop at the bound.
+	if ( btrieveRange.GetRecordCount ( ) != expected )
+	{
+		fprintf ( stderr, "Error: BtrieveRange: %lld records up to the bound, expected %lld.\n", btrieveRange.GetRecordCount ( ), expected );
+		return Btrieve::STATUS_CODE_REJECT_COUNT_REACHED;
+	}
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveRangeBounded
+
+
+static Btrieve::StatusCode benchBtrieveScanner ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	BtrieveClient btrieveClient ( 0x4232, 1 );
+	BtrieveBulkRetrieveResult* btrieveBulkRetrieveResult;
+	Btrieve::StatusCode status;
+
+	// If RecordRetrieveFirst() fails.
+	if ( btrieveFile->RecordRetrieveFirst ( Btrieve::INDEX_1, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::RecordRetrieveFirst():%d:%s.\n",
+			btrieveFile->GetLastStatusCode ( ) );
+	}
+
+	BtrieveScanner btrieveScanner ( &btrieveClient, btrieveFileName );
+
+	// If Start() fails.
+	if ( ( status = btrieveScanner.Start ( Btrieve::INDEX_1, btrieveFile->GetCursorPosition ( ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveScanner::Start():%d:%s.\n",
+			status );
+	}
+
+	// Each call is timed, so the percentiles show how long the caller waited for a batch.
+	for ( ;; )
+	{
+		benchClock::time_point started = benchClock::now ( );
+
+		// If the scan ended.
+		if ( ( btrieveBulkRetrieveResult = btrieveScanner.NextBatch ( ) ) == NULL )
+			break;
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records += btrieveBulkRetrieveResult->GetRecordCount ( );
+	}	// for ( ;; )
+
+	// If the scan failed.
+	if ( ( status = btrieveScanner.GetLastStatusCode ( ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveScanner::NextBatch():%d:%s.\n",
+			status );
+	}
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveScanner
+
+
+static Btrieve::StatusCode benchBtrieveClientPool ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	BtrieveClientPool btrieveClientPool ( POOL_MAXIMUM_CLIENTS );
+	BtrieveVersion btrieveVersion;
+	Btrieve::StatusCode status;
+
+	( void ) benchCase;
+
+	// Each call leases a client, as a request would, and asks it for the file's version.
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		benchClock::time_point started = benchClock::now ( );
+		BtrieveClientPool::Lease lease ( &btrieveClientPool, 0x4232 );
+
+		// If the checkout fails.
+		if ( ( status = lease.GetLastStatusCode ( ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveClientPool::Checkout():%d:%s.\n",
+				status );
+		}
+
+		// If GetVersion() fails.
+		if ( ( status = lease->GetVersion ( &btrieveVersion, btrieveFile ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveClient::GetVersion():%d:%s.\n",
+				status );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records++;
+	}	// for ( int i = 0; i < recordCount; i++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveClientPool
+
+
+static Btrieve::StatusCode benchBtrieveFileCache ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	BtrieveClient btrieveClient ( 0x4232, 2 );
+	BtrieveFileCache btrieveFileCache ( &btrieveClient );
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	( void ) btrieveFile;
+
+	// Each call opens the file through the cache, as a request would, and looks a record up.
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		benchClock::time_point started;
+
+		buildKey ( benchCase->keyType, keyValue ( ( int ) ( ( ( uint64_t ) i * 7919 ) % recordCount ) ), key );
+		started = benchClock::now ( );
+
+		BtrieveFileCache::Handle handle ( &btrieveFileCache, btrieveFileName, NULL, Btrieve::OPEN_MODE_READ_ONLY );
+
+		// If Acquire() fails.
+		if ( handle.Get ( ) == NULL )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFileCache::Acquire():%d:%s.\n",
+				handle.GetLastStatusCode ( ) );
+		}
+
+		// If RecordRetrieve() fails.
+		if ( handle->RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::RecordRetrieve():%d:%s.\n",
+				handle->GetLastStatusCode ( ) );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records++;
+	}	// for ( int i = 0; i < recordCount; i++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveFileCache
+
+
+// The state of one thread of the threaded file cache case.
+typedef struct
+{
+	BtrieveFileCache* btrieveFileCache;
+	const benchCase_t* benchCase;
+	int thread;
+	benchTimings_t timings;
+	const char* operation;
+	Btrieve::StatusCode status;
+} benchFileCacheReader_t;
+
+
+// Step from each record of the thread's share to the next and back through a cached handle; the step back lands where it started only if no other thread moved the cursor.
+static void fileCacheRead ( benchFileCacheReader_t* reader )
+{
+	const benchCase_t* benchCase = reader->benchCase;
+	std::vector<char> record ( benchCase->recordSize );
+	std::vector<char> step ( benchCase->recordSize );
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	reader->status = Btrieve::STATUS_CODE_NO_ERROR;
+
+	for ( int i = reader->thread; i < recordCount; i += FILE_CACHE_THREADS )
+	{
+		benchClock::time_point started;
+
+		buildKey ( benchCase->keyType, keyValue ( i ), key );
+		started = benchClock::now ( );
+
+		BtrieveFileCache::Handle handle ( reader->btrieveFileCache, btrieveFileName, NULL, Btrieve::OPEN_MODE_READ_ONLY );
+
+		// If Acquire() fails.
+		if ( handle.Get ( ) == NULL )
+		{
+			reader->operation = "BtrieveFileCache::Acquire()";
+			reader->status = handle.GetLastStatusCode ( );
+			return;
+		}
+
+		// If RecordRetrieve() fails.
+		if ( handle->RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+		{
+			reader->operation = "BtrieveFile::RecordRetrieve()";
+			reader->status = handle->GetLastStatusCode ( );
+			return;
+		}
+
+		// If RecordRetrieveNext() fails.
+		if ( handle->RecordRetrieveNext ( &step [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+		{
+			// If the record is the last one, there's nothing to step back from.
+			if ( handle->GetLastStatusCode ( ) == Btrieve::STATUS_CODE_END_OF_FILE )
+			{
+				continue;
+			}
+
+			reader->operation = "BtrieveFile::RecordRetrieveNext()";
+			reader->status = handle->GetLastStatusCode ( );
+			return;
+		}
+
+		// If RecordRetrievePrevious() fails.
+		if ( handle->RecordRetrievePrevious ( &step [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+		{
+			reader->operation = "BtrieveFile::RecordRetrievePrevious()";
+			reader->status = handle->GetLastStatusCode ( );
+			return;
+		}
+
+		// If the step back landed on another record; the cursor was moved by another holder.
+		if ( memcmp ( &record [ 0 ], &step [ 0 ], benchCase->recordSize ) != 0 )
+		{
+			reader->operation = "BtrieveFile::RecordRetrievePrevious(): the cursor was moved by another thread";
+			reader->status = Btrieve::STATUS_CODE_POSITION_NOT_SET;
+			return;
+		}
+
+		reader->timings.latencies.push_back ( elapsedNanoseconds ( started ) );
+		reader->timings.records++;
+	}	// for ( int i = reader->thread; i < recordCount; i += FILE_CACHE_THREADS )
+}	// static void fileCacheRead
+
+
+// Read through one file cache from several threads at once; each holder must have a handle, and so a cursor, of its own.
+static Btrieve::StatusCode benchBtrieveFileCacheThreads ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	BtrieveClient btrieveClient ( 0x4232, 2 );
+	BtrieveFileCache btrieveFileCache ( &btrieveClient );
+	benchFileCacheReader_t readers [ FILE_CACHE_THREADS ];
+	std::vector<std::thread> threads;
+
+	( void ) btrieveFile;
+
+	for ( int t = 0; t < FILE_CACHE_THREADS; t++ )
+	{
+		readers [ t ].btrieveFileCache = &btrieveFileCache;
+		readers [ t ].benchCase = benchCase;
+		readers [ t ].thread = t;
+		readers [ t ].timings.records = 0;
+		threads.push_back ( std::thread ( fileCacheRead, &readers [ t ] ) );
+	}
+
+	for ( int t = 0; t < FILE_CACHE_THREADS; t++ )
+	{
+		threads [ t ].join ( );
+	}
+
+	for ( int t = 0; t < FILE_CACHE_THREADS; t++ )
+	{
+		// If the thread's reads failed.
+		if ( readers [ t ].status != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			fprintf ( stderr, "Error: %s:%d:%s.\n", readers [ t ].operation, readers [ t ].status, Btrieve::StatusCodeToString ( readers [ t ].status ) );
+			return readers [ t ].status;
+		}
+
+		timings->latencies.insert ( timings->latencies.end ( ), readers [ t ].timings.latencies.begin ( ), readers [ t ].timings.latencies.end ( ) );
+		timings->records += readers [ t ].timings.records;
+	}	// for ( int t = 0; t < FILE_CACHE_THREADS; t++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveFileCacheThreads
+
+
+static Btrieve::StatusCode benchBtrieveRecordCache ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	BtrieveRecordCache btrieveRecordCache ( btrieveFile );
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	// The first pass fills the cache from the file; the others read the same keys again.
+	for ( int pass = 0; pass < RECORD_CACHE_PASSES; pass++ )
+	{
+		for ( int i = 0; i < recordCount; i++ )
+		{
+			benchClock::time_point started;
+
+			buildKey ( benchCase->keyType, keyValue ( ( int ) ( ( ( uint64_t ) i * 7919 ) % recordCount ) ), key );
+			started = benchClock::now ( );
+
+			// If RecordRetrieve() fails.
+			if ( btrieveRecordCache.RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+			{
+				return ReportExceptionAndReturn (
+					"Error: BtrieveRecordCache::RecordRetrieve():%d:%s.\n",
+					btrieveRecordCache.GetLastStatusCode ( ) );
+			}
+
+			timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+			timings->records++;
+		}	// for ( int i = 0; i < recordCount; i++ )
+	}	// for ( int pass = 0; pass < RECORD_CACHE_PASSES; pass++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveRecordCache
+
+
+// Scan for the keys in the top tenth of the key space, returning only the keys.
+static Btrieve::StatusCode benchBtrieveQuery ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	BtrieveField keyField = { 0, benchCase->keyType->keyLength, benchCase->keyType->dataType };
+	BtrieveBulkRetrieveAttributes btrieveBulkRetrieveAttributes;
+	BtrieveQuery btrieveQuery;
+	Btrieve::StatusCode status;
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	buildKey ( benchCase->keyType, 0xE6666666u, key );
+
+	// If SetPredicate() fails.
+	if ( ( status = btrieveQuery.SetPredicate ( BtrievePredicate::Compare ( keyField, Btrieve::COMPARISON_GREATER_THAN_OR_EQUAL, key, benchCase->keyType->keyLength ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveQuery::SetPredicate():%d:%s.\n",
+			status );
+	}
+
+	// If Select() fails.
+	if ( ( status = btrieveQuery.Select ( keyField ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveQuery::Select():%d:%s.\n",
+			status );
+	}
+
+	// If ApplyTo() fails.
+	if ( ( status = btrieveQuery.ApplyTo ( &btrieveBulkRetrieveAttributes ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveQuery::ApplyTo():%d:%s.\n",
+			status );
+	}
+
+	btrieveBulkRetrieveAttributes.SetMaximumRecordCount ( BULK_BATCH_SIZE );
+	btrieveBulkRetrieveAttributes.SetMaximumRejectCount ( 65535 );
+
+	// If RecordRetrieveFirst() fails.
+	if ( btrieveFile->RecordRetrieveFirst ( Btrieve::INDEX_1, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::RecordRetrieveFirst():%d:%s.\n",
+			btrieveFile->GetLastStatusCode ( ) );
+	}
+
+	for ( bool first = true; ; first = false )
+	{
+		BtrieveBulkRetrieveResult btrieveBulkRetrieveResult;
+		benchClock::time_point started;
+
+		btrieveBulkRetrieveAttributes.SetSkipCurrentRecord ( !first );
+		started = benchClock::now ( );
+		status = btrieveFile->BulkRetrieveNext ( &btrieveBulkRetrieveAttributes, &btrieveBulkRetrieveResult );
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records += btrieveBulkRetrieveResult.GetRecordCount ( );
+
+		// If the scan reached the end of the index.
+		if ( status == Btrieve::STATUS_CODE_END_OF_FILE )
+			break;
+
+		// If BulkRetrieveNext() fails; a full reject count only ends the batch.
+		if ( status != Btrieve::STATUS_CODE_NO_ERROR && status != Btrieve::STATUS_CODE_REJECT_COUNT_REACHED )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::BulkRetrieveNext():%d:%s.\n",
+				status );
+		}
+	}	// for ( bool first = true; ; first = false )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveQuery
+
+
+// Scan the whole index a batch at a time, decoding each batch's keys into a column.
+static Btrieve::StatusCode benchBtrieveColumns ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	BtrieveField keyField = { 0, benchCase->keyType->keyLength, benchCase->keyType->dataType };
+	BtrieveBulkRetrieveAttributes btrieveBulkRetrieveAttributes;
+	BtrieveQuery btrieveQuery;
+	Btrieve::StatusCode decodeStatus;
+	Btrieve::StatusCode status;
+
+	btrieveQuery.Select ( keyField );
+
+	// If ApplyTo() fails.
+	if ( ( status = btrieveQuery.ApplyTo ( &btrieveBulkRetrieveAttributes ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveQuery::ApplyTo():%d:%s.\n",
+			status );
+	}
+
+	btrieveBulkRetrieveAttributes.SetMaximumRecordCount ( BULK_BATCH_SIZE );
+
+	BtrieveColumns btrieveColumns ( btrieveQuery );
+
+	// If RecordRetrieveFirst() fails.
+	if ( btrieveFile->RecordRetrieveFirst ( Btrieve::INDEX_1, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::RecordRetrieveFirst():%d:%s.\n",
+			btrieveFile->GetLastStatusCode ( ) );
+	}
+
+	for ( bool first = true; ; first = false )
+	{
+		BtrieveBulkRetrieveResult btrieveBulkRetrieveResult;
+		benchClock::time_point started;
+
+		btrieveBulkRetrieveAttributes.SetSkipCurrentRecord ( !first );
+		started = benchClock::now ( );
+		status = btrieveFile->BulkRetrieveNext ( &btrieveBulkRetrieveAttributes, &btrieveBulkRetrieveResult );
+
+		// If the scan failed before it reached the end of the index.
+		if ( status != Btrieve::STATUS_CODE_NO_ERROR && status != Btrieve::STATUS_CODE_END_OF_FILE )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::BulkRetrieveNext():%d:%s.\n",
+				status );
+		}
+
+		// If Decode() fails.
+		if ( ( decodeStatus = btrieveColumns.Decode ( &btrieveBulkRetrieveResult ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveColumns::Decode():%d:%s.\n",
+				decodeStatus );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records += btrieveColumns.GetRowCount ( );
+
+		// If the scan reached the end of the index.
+		if ( status == Btrieve::STATUS_CODE_END_OF_FILE )
+			break;
+	}	// for ( bool first = true; ; first = false )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveColumns
+
+
+// Run the BtrieveQuery filter again, with the batches sized by a BtrieveAdaptiveRetriever.
+static Btrieve::StatusCode benchBtrieveAdaptiveRetriever ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	BtrieveField keyField = { 0, benchCase->keyType->keyLength, benchCase->keyType->dataType };
+	BtrieveBulkRetrieveAttributes btrieveBulkRetrieveAttributes;
+	BtrieveQuery btrieveQuery;
+	Btrieve::StatusCode status;
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	buildKey ( benchCase->keyType, 0xE6666666u, key );
+
+	// If SetPredicate() fails.
+	if ( ( status = btrieveQuery.SetPredicate ( BtrievePredicate::Compare ( keyField, Btrieve::COMPARISON_GREATER_THAN_OR_EQUAL, key, benchCase->keyType->keyLength ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveQuery::SetPredicate():%d:%s.\n",
+			status );
+	}
+
+	btrieveQuery.Select ( keyField );
+
+	// If ApplyTo() fails.
+	if ( ( status = btrieveQuery.ApplyTo ( &btrieveBulkRetrieveAttributes ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveQuery::ApplyTo():%d:%s.\n",
+			status );
+	}
+
+	// If RecordRetrieveFirst() fails.
+	if ( btrieveFile->RecordRetrieveFirst ( Btrieve::INDEX_1, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::RecordRetrieveFirst():%d:%s.\n",
+			btrieveFile->GetLastStatusCode ( ) );
+	}
+
+	BtrieveAdaptiveRetriever btrieveAdaptiveRetriever ( btrieveFile, &btrieveBulkRetrieveAttributes );
+
+	do
+	{
+		BtrieveBulkRetrieveResult btrieveBulkRetrieveResult;
+		benchClock::time_point started = benchClock::now ( );
+
+		status = btrieveAdaptiveRetriever.Next ( &btrieveBulkRetrieveResult );
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+
+		// If Next() fails before the end of the index.
+		if ( status != Btrieve::STATUS_CODE_NO_ERROR && status != Btrieve::STATUS_CODE_END_OF_FILE )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveAdaptiveRetriever::Next():%d:%s.\n",
+				status );
+		}
+
+		timings->records += btrieveBulkRetrieveResult.GetRecordCount ( );
+	} while ( status == Btrieve::STATUS_CODE_NO_ERROR );
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveAdaptiveRetriever
+
+
+// Counts the records of a partition of a BtrieveParallelScan.
+struct benchRecordCounter_t
+{
+	long long records;
+
+	void operator() ( const BtrieveRangeRow& )
+	{
+		records++;
+	}
+};	// struct benchRecordCounter_t
+
+
+// Scan the whole index once, in partitions read side by side; the one call is the whole scan.
+static Btrieve::StatusCode benchBtrieveParallelScan ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	BtrieveClient btrieveClient ( 0x4232, 3 );
+	BtrieveParallelScan btrieveParallelScan ( &btrieveClient, btrieveFileName, NULL, PARALLEL_SCAN_PARTITIONS );
+	std::vector<benchRecordCounter_t> counters ( btrieveParallelScan.GetPartitionCount ( ) );
+	benchClock::time_point started = benchClock::now ( );
+	Btrieve::StatusCode status;
+
+	( void ) btrieveFile;
+	( void ) benchCase;
+
+	// If Scan() fails.
+	if ( ( status = btrieveParallelScan.Scan ( Btrieve::INDEX_1, counters.data ( ) ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveParallelScan::Scan():%d:%s.\n",
+			status );
+	}
+
+	timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+
+	for ( size_t i = 0; i < counters.size ( ); i++ )
+	{
+		timings->records += counters [ i ].records;
+	}
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveParallelScan
+
+
+// A client of the async case, with the file opened through it and the timings of its lookups.
+struct benchAsyncClient_t
+{
+	benchAsyncClient_t ( BtrieveExecutor* btrieveExecutor, int clientIdentifier )
+		: btrieveClient ( 0x4232, clientIdentifier ), btrieveAsyncClient ( btrieveExecutor, &btrieveClient ), btrieveAsyncFile ( &btrieveAsyncClient, &btrieveFile )
+	{
+		timings.records = 0;
+	}
+
+	BtrieveClient btrieveClient;
+	BtrieveFile btrieveFile;
+	BtrieveAsyncClient btrieveAsyncClient;
+	BtrieveAsyncFile btrieveAsyncFile;
+	benchTimings_t timings;
+};	// struct benchAsyncClient_t
+
+
+// Look up the record of the i-th key on the client's strand.
+static BtrieveTask<Btrieve::StatusCode> asyncRecordRetrieve ( benchAsyncClient_t* asyncClient, const benchCase_t* benchCase, int i, char* record )
+{
+	char key [ ZSTRING_KEY_LENGTH ];
+	benchClock::time_point started;
+	BtrieveRetrieveResult result;
+
+	buildKey ( benchCase->keyType, keyValue ( ( int ) ( ( ( uint64_t ) i * 7919 ) % recordCount ) ), key );
+	started = benchClock::now ( );
+	result = co_await asyncClient->btrieveAsyncFile.RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength, record, benchCase->recordSize );
+
+	// If RecordRetrieve() fails.
+	if ( result.length != benchCase->recordSize )
+	{
+		co_return result.status;
+	}
+
+	asyncClient->timings.latencies.push_back ( elapsedNanoseconds ( started ) );
+	asyncClient->timings.records++;
+	co_return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static BtrieveTask<Btrieve::StatusCode> asyncRecordRetrieve
+
+
+// Look up every clientCount-th key from first, ASYNC_TRANSACTION_SIZE lookups to a transaction.
+static BtrieveTask<Btrieve::StatusCode> asyncRecordRetrieveShare ( benchAsyncClient_t* asyncClient, const benchCase_t* benchCase, int first, int clientCount )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	Btrieve::StatusCode status;
+
+	for ( int i = first; i < recordCount; )
+	{
+		// If TransactionBegin() fails.
+		if ( ( status = co_await asyncClient->btrieveAsyncClient.TransactionBegin ( Btrieve::TRANSACTION_MODE_CONCURRENT_WRITE_WAIT ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			co_return status;
+		}
+
+		for ( int n = 0; ( n < ASYNC_TRANSACTION_SIZE ) && ( i < recordCount ); n++, i += clientCount )
+		{
+			// If the lookup fails.
+			if ( ( status = co_await asyncRecordRetrieve ( asyncClient, benchCase, i, &record [ 0 ] ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+			{
+				co_await asyncClient->btrieveAsyncClient.TransactionAbort ( );
+				co_return status;
+			}
+		}
+
+		// If TransactionEnd() fails.
+		if ( ( status = co_await asyncClient->btrieveAsyncClient.TransactionEnd ( ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			co_return status;
+		}
+	}	// for ( int i = first; i < recordCount; )
+
+	co_return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static BtrieveTask<Btrieve::StatusCode> asyncRecordRetrieveShare
+
+
+// Look every key up through coroutines of ASYNC_CLIENTS clients, whose calls ASYNC_THREADS threads run.
+static Btrieve::StatusCode benchBtrieveAsync ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	BtrieveExecutor btrieveExecutor ( ASYNC_THREADS );
+	std::vector<benchAsyncClient_t*> asyncClients;
+	std::vector<BtrieveTask<Btrieve::StatusCode> > tasks;
+	Btrieve::StatusCode status = Btrieve::STATUS_CODE_NO_ERROR;
+
+	( void ) btrieveFile;
+
+	for ( int c = 0; c < ASYNC_CLIENTS; c++ )
+	{
+		asyncClients.push_back ( new benchAsyncClient_t ( &btrieveExecutor, 16 + c ) );
+
+		// If FileOpen() fails.
+		if ( ( status = asyncClients [ c ]->btrieveClient.FileOpen ( &asyncClients [ c ]->btrieveFile, btrieveFileName, NULL, Btrieve::OPEN_MODE_NORMAL ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			ReportExceptionAndReturn (
+				"Error: BtrieveClient::FileOpen():%d:%s.\n",
+				status );
+			break;
+		}
+	}	// for ( int c = 0; c < ASYNC_CLIENTS; c++ )
+
+	// If every client opened the file, start their coroutines, then wait for each.
+	if ( status == Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		for ( int c = 0; c < ASYNC_CLIENTS; c++ )
+		{
+			tasks.push_back ( asyncRecordRetrieveShare ( asyncClients [ c ], benchCase, c, ASYNC_CLIENTS ) );
+			tasks [ c ].Start ( );
+		}
+
+		for ( int c = 0; c < ASYNC_CLIENTS; c++ )
+		{
+			Btrieve::StatusCode taskStatus = tasks [ c ].Wait ( );
+
+			// If the client's lookups failed.
+			if ( ( taskStatus != Btrieve::STATUS_CODE_NO_ERROR ) && ( status == Btrieve::STATUS_CODE_NO_ERROR ) )
+			{
+				status = ReportExceptionAndReturn (
+					"Error: BtrieveAsyncFile::RecordRetrieve():%d:%s.\n",
+					taskStatus );
+			}
+
+			timings->latencies.insert ( timings->latencies.end ( ), asyncClients [ c ]->timings.latencies.begin ( ), asyncClients [ c ]->timings.latencies.end ( ) );
+			timings->records += asyncClients [ c ]->timings.records;
+		}	// for ( int c = 0; c < ASYNC_CLIENTS; c++ )
+	}	// if ( status == Btrieve::STATUS_CODE_NO_ERROR )
+
+	for ( size_t c = 0; c < asyncClients.size ( ); c++ )
+	{
+		asyncClients [ c ]->btrieveClient.FileClose ( &asyncClients [ c ]->btrieveFile );
+		delete asyncClients [ c ];
+	}
+
+	return status;
+}	// static Btrieve::StatusCode benchBtrieveAsync
+
+
+// The share of the records one thread of the record cache update case changes.
+typedef struct {
+	BtrieveRecordCache* btrieveRecordCache;
+	const benchCase_t* benchCase;
+	int thread;
+	benchTimings_t timings;
+	Btrieve::StatusCode status;
+} benchRecordCacheUpdater_t;
+
+
+// The mark a thread of the record cache update case leaves in the last byte of a record, past the key.
+static char recordCacheUpdateMark ( int thread )
+{
+	return ( char ) ( 0xA0 + thread );
+}	// static char recordCacheUpdateMark
+
+
+// Look each record of the thread's share up through the cache, twice so the second is a hit, and mark it through the cache.
+static void recordCacheUpdate ( benchRecordCacheUpdater_t* updater )
+{
+	const benchCase_t* benchCase = updater->benchCase;
+	std::vector<char> record ( benchCase->recordSize );
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	updater->status = Btrieve::STATUS_CODE_NO_ERROR;
+
+	for ( int i = updater->thread; i < recordCount; i += RECORD_CACHE_UPDATE_THREADS )
+	{
+		benchClock::time_point started;
+
+		buildKey ( benchCase->keyType, keyValue ( i ), key );
+		started = benchClock::now ( );
+
+		for ( int lookup = 0; lookup < 2; lookup++ )
+		{
+			// If RecordRetrieve() fails.
+			if ( updater->btrieveRecordCache->RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+			{
+				updater->status = BtrieveRecordCache::GetLastStatusCode ( );
+				return;
+			}
+		}
+
+		// If the record holds more than its key, mark it, so the check can tell who changed it.
+		if ( benchCase->recordSize > benchCase->keyType->keyLength )
+		{
+			record [ benchCase->recordSize - 1 ] = recordCacheUpdateMark ( updater->thread );
+		}
+
+		// If RecordUpdate() fails; with the cursor on another thread's record it fails with a duplicate key.
+		if ( ( updater->status = updater->btrieveRecordCache->RecordUpdate ( &record [ 0 ], benchCase->recordSize ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return;
+		}
+
+		updater->timings.latencies.push_back ( elapsedNanoseconds ( started ) );
+		updater->timings.records++;
+	}	// for ( int i = updater->thread; i < recordCount; i += RECORD_CACHE_UPDATE_THREADS )
+}	// static void recordCacheUpdate
+
+
+// Update every record through one record cache from several threads at once, then check each thread changed only its own records.
+static Btrieve::StatusCode benchBtrieveRecordCacheUpdate ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	BtrieveRecordCache btrieveRecordCache ( btrieveFile );
+	benchRecordCacheUpdater_t updaters [ RECORD_CACHE_UPDATE_THREADS ];
+	std::vector<std::thread> threads;
+	std::vector<char> record ( benchCase->recordSize );
+	char key [ ZSTRING_KEY_LENGTH ];
+
+	for ( int t = 0; t < RECORD_CACHE_UPDATE_THREADS; t++ )
+	{
+		updaters [ t ].btrieveRecordCache = &btrieveRecordCache;
+		updaters [ t ].benchCase = benchCase;
+		updaters [ t ].thread = t;
+		updaters [ t ].timings.records = 0;
+		threads.push_back ( std::thread ( recordCacheUpdate, &updaters [ t ] ) );
+	}
+
+	for ( int t = 0; t < RECORD_CACHE_UPDATE_THREADS; t++ )
+	{
+		threads [ t ].join ( );
+
+		// If the thread's updates failed.
+		if ( updaters [ t ].status != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveRecordCache::RecordUpdate():%d:%s.\n",
+				updaters [ t ].status );
+		}
+
+		timings->latencies.insert ( timings->latencies.end ( ), updaters [ t ].timings.latencies.begin ( ), updaters [ t ].timings.latencies.end ( ) );
+		timings->records += updaters [ t ].timings.records;
+	}	// for ( int t = 0; t < RECORD_CACHE_UPDATE_THREADS; t++ )
+
+	// If the records have no room for a mark, the updates succeeding is the check.
+	if ( benchCase->recordSize <= benchCase->keyType->keyLength )
+	{
+		return Btrieve::STATUS_CODE_NO_ERROR;
+	}
+
+	for ( int i = 0; i < recordCount; i++ )
+	{
+		buildKey ( benchCase->keyType, keyValue ( i ), key );
+
+		// If RecordRetrieve() fails.
+		if ( btrieveFile->RecordRetrieve ( Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, key, benchCase->keyType->keyLength, &record [ 0 ], benchCase->recordSize ) != benchCase->recordSize )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::RecordRetrieve():%d:%s.\n",
+				btrieveFile->GetLastStatusCode ( ) );
+		}
+
+		// If another thread's update landed on the record.
+		if ( record [ benchCase->recordSize - 1 ] != recordCacheUpdateMark ( i % RECORD_CACHE_UPDATE_THREADS ) )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveRecordCache::RecordUpdate():%d:%s: a record was changed by the wrong thread.\n",
+				Btrieve::STATUS_CODE_POSITION_NOT_SET );
+		}
+	}	// for ( int i = 0; i < recordCount; i++ )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBtrieveRecordCacheUpdate
+
+
+// Build a second index over the key, on a thread per core, then drop it; the one call is the whole build.
+static Btrieve::StatusCode benchIndexCreate ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	BtrieveIndexBuilder btrieveIndexBuilder ( btrieveFile );
+	BtrieveIndexAttributes btrieveIndexAttributes;
+	BtrieveKeySegment btrieveKeySegment;
+	benchClock::time_point started;
+	Btrieve::StatusCode status;
+
+	// If SetField ( ) fails.
+	if ( ( status = btrieveKeySegment.SetField ( 0, benchCase->keyType->keyLength, benchCase->keyType->dataType ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveKeySegment::SetField():%d:%s.\n",
+			status );
+	}
+
+	// If AddKeySegment ( ) fails.
+	if ( ( status = btrieveIndexAttributes.AddKeySegment ( &btrieveKeySegment ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveIndexAttributes::AddKeySegment():%d:%s.\n",
+			status );
+	}
+
+	// If SetIndex ( ) fails.
+	if ( ( status = btrieveIndexAttributes.SetIndex ( Btrieve::INDEX_2 ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveIndexAttributes::SetIndex():%d:%s.\n",
+			status );
+	}
+
+	started = benchClock::now ( );
+
+	// If IndexCreate() fails.
+	if ( ( status = btrieveIndexBuilder.IndexCreate ( &btrieveIndexAttributes ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveIndexBuilder::IndexCreate():%d:%s.\n",
+			status );
+	}
+
+	timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+	timings->records += recordCount;
+
+	// If IndexDrop() fails.
+	if ( ( status = btrieveFile->IndexDrop ( Btrieve::INDEX_2 ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return ReportExceptionAndReturn (
+			"Error: BtrieveFile::IndexDrop():%d:%s.\n",
+			status );
+	}
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchIndexCreate
+
+
+static Btrieve::StatusCode benchBulkCreate ( BtrieveFile* btrieveFile, const benchCase_t* benchCase, benchTimings_t* timings )
+{
+	std::vector<char> record ( benchCase->recordSize );
+	Btrieve::StatusCode status;
+
+	for ( int i = 0; i < recordCount; )
+	{
+		BtrieveBulkCreatePayload btrieveBulkCreatePayload;
+		BtrieveBulkCreateResult btrieveBulkCreateResult;
+		benchClock::time_point started;
+		int batchCount;
+
+		for ( batchCount = 0; ( batchCount < BULK_BATCH_SIZE ) && ( i + batchCount < recordCount ); batchCount++ )
+		{
+			buildRecord ( benchCase, i + batchCount, &record [ 0 ] );
+
+			status = btrieveBulkCreatePayload.AddRecord ( &record [ 0 ], benchCase->recordSize );
+
+			// If the payload is full, large records make a shorter batch.
+			if ( ( status == Btrieve::STATUS_CODE_INVALID_EXT_INSERT_BUFF ) && ( batchCount > 0 ) )
+				break;
+
+			// If AddRecord() fails.
+			if ( status != Btrieve::STATUS_CODE_NO_ERROR )
+			{
+				return ReportExceptionAndReturn (
+					"Error: BtrieveBulkCreatePayload::AddRecord():%d:%s.\n",
+					status );
+			}
+		}	// for ( batchCount = 0; ( batchCount < BULK_BATCH_SIZE ) && ( i + batchCount < recordCount ); batchCount++ )
+
+		started = benchClock::now ( );
+
+		// If BulkCreate() fails.
+		if ( ( status = btrieveFile->BulkCreate ( &btrieveBulkCreatePayload, &btrieveBulkCreateResult ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return ReportExceptionAndReturn (
+				"Error: BtrieveFile::BulkCreate():%d:%s.\n",
+				status );
+		}
+
+		timings->latencies.push_back ( elapsedNanoseconds ( started ) );
+		timings->records += btrieveBulkCreateResult.GetRecordCount ( );
+		i += batchCount;
+	}	// for ( int i = 0; i < recordCount; )
+
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// static Btrieve::StatusCode benchBulkCreate
+
+
+typedef Btrieve::StatusCode ( *benchFunction_t ) ( BtrieveFile*, const benchCase_t*, benchTimings_t* );
+
+// The operations that run against the file RecordCreate fills, in order.
+static const struct {
+	const char* name;
+	benchFunction_t function;
+} populatedOperations [ ] = {
+	{ "RecordCreate", benchRecordCreate },
+	{ "RecordRetrieve", benchRecordRetrieve },
+	{ "KeyRetrieve", benchKeyRetrieve },
+	{ "KeyRetrieveMissing", benchKeyRetrieveMissing },
+	{ "MultiGet", benchMultiGet },
+	{ "RecordRetrieveNext", benchRecordRetrieveNext },
+	{ "BulkRetrieveNext", benchBulkRetrieveNext },
+	{ "BtrieveRange", benchBtrieveRange },
+	{ "BtrieveRangeBounded", benchBtrieveRangeBounded },
+	{ "BtrieveScanner", benchBtrieveScanner },
+	{ "BtrieveClientPool", benchBtrieveClientPool },
+	{ "BtrieveFileCache", benchBtrieveFileCache },
+	{ "BtrieveFileCacheThreads", benchBtrieveFileCacheThreads },
+	{ "BtrieveRecordCache", benchBtrieveRecordCache },
+	{ "BtrieveQuery", benchBtrieveQuery },
+	{ "BtrieveColumns", benchBtrieveColumns },
+	{ "BtrieveAdaptiveRetriever", benchBtrieveAdaptiveRetriever },
+	{ "BtrieveParallelScan", benchBtrieveParallelScan },
+	{ "BtrieveAsync", benchBtrieveAsync },
+	{ "BtrieveRecordCacheUpdate", benchBtrieveRecordCacheUpdate },
+	{ "IndexCreate", benchIndexCreate }
+};
+
+
+static Btrieve::StatusCode runCase ( BtrieveClient* btrieveClient, const benchCase_t* benchCase, FILE* output )
+{
+	Btrieve::StatusCode status;
+	BtrieveFile btrieveFile;
+	benchTimings_t timings;
+
+	// If createFile ( ) fails.
+	if ( ( status = createFile ( btrieveClient, &btrieveFile, benchCase ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	for ( int i = 0; i < COUNT_OF ( populatedOperations ); i++ )
+	{
+		timings.latencies.clear ( );
+		timings.records = 0;
+
+		// If the operation fails.
+		if ( ( status = populatedOperations [ i ].function ( &btrieveFile, benchCase, &timings ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		writeResult ( output, populatedOperations [ i ].name, benchCase, &timings );
+	}	// for ( int i = 0; i < COUNT_OF ( populatedOperations ); i++ )
+
+	// BulkCreate loads the same records into an empty file of its own.
+
+	// If closeAndDeleteFile ( ) fails.
+	if ( ( status = closeAndDeleteFile ( btrieveClient, &btrieveFile ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If createFile ( ) fails.
+	if ( ( status = createFile ( btrieveClient, &btrieveFile, benchCase ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	timings.latencies.clear ( );
+	timings.records = 0;
+
+	// If benchBulkCreate ( ) fails.
+	if ( ( status = benchBulkCreate ( &btrieveFile, benchCase, &timings ) ) != Btrieve::STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	writeResult ( output, "BulkCreate", benchCase, &timings );
+	return closeAndDeleteFile ( btrieveClient, &btrieveFile );
+}	// static Btrieve::StatusCode runCase
+
+
+int main ( int argc, char* argv [ ] )
+{
+	BtrieveClient btrieveClient ( 0x4232, 0 );
+	Btrieve::StatusCode status = Btrieve::STATUS_CODE_NO_ERROR;
+	const char* outputName = NULL;
+	FILE* output = stdout;
+	benchCase_t benchCase;
+
+	for ( int argi = 1; argi < argc; argi++ )
+	{
+		// If the record count follows.
+		if ( ( strcmp ( argv [ argi ], "-n" ) == 0 ) && ( argi + 1 < argc ) )
+		{
+			recordCount = atoi ( argv [ ++argi ] );
+
+			// If recordCount is out of range.
+			if ( recordCount < MIN_RECORD_COUNT )
+			{
+				return ShowUsageAndQuit (
+					argv [ 0 ] ,
+					2 );
+			}
+		}
+		// If the output file name follows.
+		else if ( ( strcmp ( argv [ argi ], "-o" ) == 0 ) && ( argi + 1 < argc ) )
+		{
+			outputName = argv [ ++argi ];
+		}
+		else
+		{
+			return ShowUsageAndQuit (
+				argv [ 0 ] ,
+				1 );
+		}
+	}	// for ( int argi = 1; argi < argc; argi++ )
+
+	// If the results go to a file and it can't be created.
+	if ( ( outputName != NULL ) && ( ( output = fopen ( outputName, "w" ) ) == NULL ) )
+	{
+		fprintf ( stderr, "Error: unable to create %s.\n", outputName );
+		return 3;
+	}
+
+	fprintf (
+		output,
+		"{\n  \"benchmark\": \"bdemo_bench\",\n  \"recordCount\": %i,\n  \"bulkBatchSize\": %i,\n  \"results\": [",
+		recordCount,															// "recordCount": %i
+		BULK_BATCH_SIZE );														// "bulkBatchSize": %i
+
+	for ( int r = 0; ( r < COUNT_OF ( recordSizes ) ) && ( status == Btrieve::STATUS_CODE_NO_ERROR ); r++ )
+	{
+		for ( int k = 0; ( k < COUNT_OF ( keyTypes ) ) && ( status == Btrieve::STATUS_CODE_NO_ERROR ); k++ )
+		{
+			for ( int p = 0; ( p < COUNT_OF ( pageSizes ) ) && ( status == Btrieve::STATUS_CODE_NO_ERROR ); p++ )
+			{
+				benchCase.recordSize = recordSizes [ r ];
+				benchCase.keyType = &keyTypes [ k ];
+				benchCase.pageSizeIndex = p;
+
+				fprintf (
+					stderr,
+					"bdemo_bench: record size %i, %s key, page size %i ...\n",
+					benchCase.recordSize,
+					benchCase.keyType->name,
+					pageSizeBytes [ p ] );
+				status = runCase ( &btrieveClient, &benchCase, output );
+			}	// for ( int p = 0; ( p < COUNT_OF ( pageSizes ) ) && ( status == Btrieve::STATUS_CODE_NO_ERROR ); p++ )
+		}	// for ( int k = 0; ( k < COUNT_OF ( keyTypes ) ) && ( status == Btrieve::STATUS_CODE_NO_ERROR ); k++ )
+	}	// for ( int r = 0; ( r < COUNT_OF ( recordSizes ) ) && ( status == Btrieve::STATUS_CODE_NO_ERROR ); r++ )
+
+	fprintf ( output, "\n  ]\n}\n" );
+
+	// If the results went to a file.
+	if ( output != stdout )
+		fclose ( output );
+
+	// If there wasn't a failure.
+	if ( status == Btrieve::STATUS_CODE_NO_ERROR )
+		return 0;
+	else
+		return 4;
+}	// int main
@@ -0,0 +1,1851 @@
+// bTree.cpp : On-disk B+tree indexes for the in-process engine.
+//
+// Separators in internal nodes are lower bounds: every entry in the
+// subtree of child i is at least separator i and less than separator
+// i + 1. Deletion is lazy; nodes are never merged, but a node that
+// becomes empty is unlinked and freed, and a root with a single child is
+// collapsed.
+//
+// A separator need only sort above the last entry of the node before, so
+// where memcmp orders the keys it's the shortest prefix of the node's
+// first key that does, padded with zeros, with an address of zero. Changes
+// that keep a page's prefix or trim shift entries in place; the rest
+// gather the page's entries whole and lay them out again, and a split
+// picks a point where both halves fit.
+//
+
+#include <string.h>
+
+#include "bTree.h"
+#include "engine.h"
+#include "sorter.h"
+
+namespace BtrieveEngine
+{
+
+// The keys of a node read as unsigned integers in index order, and the
+// search key read the same way.
+struct NodeOrdinals
+{
+	const uint8_t* base;												// The first stored entry.
+	uint32_t stride;
+	uint32_t count;
+	uint32_t length;													// The stored key bytes of an entry.
+	uint32_t window;													// Entries a search counts rather than bisects.
+	bool bigEndian;														// Whether the first byte is the most significant.
+	uint32_t shift;														// The bits of a leaf prefix below the stored bytes.
+	uint64_t mask;
+	uint64_t prefix;
+	uint64_t flip;
+	uint64_t key;
+};	// struct NodeOrdinals
+
+
+BTree::BTree ( SharedFile* fileIn, IndexDefinition* definitionIn )
+	: file ( fileIn ), definition ( definitionIn )
+{
+	bool isSigned;
+	bool descending;
+
+	pageSize = fileIn->header.pageSize;
+	keyLength = definitionIn->keyLength;
+	leafStride = keyLength + ENGINE_ADDRESS_LENGTH;
+	internalStride = keyLength + ENGINE_ADDRESS_LENGTH + ENGINE_CHILD_LENGTH;
+	byteOrdered = IsByteOrdered ( *definitionIn );
+	integerWidth = ( uint32_t ) GetIntegerKeyWidth ( *definitionIn, &isSigned, &descending );
+	integerFlip = 0;
+
+	// If a signed integer, flipping the sign bit orders it unsigned.
+	if ( integerWidth != 0 && isSigned )
+	{
+		integerFlip ^= ( uint64_t ) 1 << ( integerWidth * 8 - 1 );
+	}
+
+	// If a descending integer, flipping every bit reverses the order.
+	if ( integerWidth != 0 && descending )
+	{
+		integerFlip ^= ~( uint64_t ) 0 >> ( 64 - integerWidth * 8 );
+	}
+}	// BTree::BTree
+
+
+btrieve_status_code_t BTree::CheckCapacity ( uint32_t pageSize, int keyLength )
+{
+	uint32_t internalCapacity = ( pageSize - sizeof ( NodeHeader ) ) / ( keyLength + ENGINE_ADDRESS_LENGTH + ENGINE_CHILD_LENGTH );
+
+	// If a node can't hold enough entries to split.
+	if ( internalCapacity < ENGINE_MINIMUM_NODE_ENTRIES )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_KEYLENGTH;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BTree::CheckCapacity
+
+
+// Return true if every byte is zero.
+static bool IsZero ( const uint8_t* bytes, uint32_t length )
+{
+	for ( uint32_t i = 0; i < length; i++ )
+	{
+		// If the byte isn't zero.
+		if ( bytes [ i ] != 0 )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}	// static bool IsZero
+
+
+uint32_t BTree::LeafCapacity ( uint32_t prefixLength ) const
+{
+	return ( pageSize - sizeof ( NodeHeader ) - prefixLength ) / ( leafStride - prefixLength );
+}	// uint32_t BTree::LeafCapacity
+
+
+uint32_t BTree::InternalCapacity ( uint32_t trimmedLength ) const
+{
+	return ( pageSize - sizeof ( NodeHeader ) ) / ( internalStride - trimmedLength );
+}	// uint32_t BTree::InternalCapacity
+
+
+// Return the stored part of a leaf entry: its key past the leaf's prefix, then its address.
+uint8_t* BTree::LeafEntry ( uint8_t* node, uint32_t slot ) const
+{
+	uint32_t prefixLength = ( ( NodeHeader* ) node )->prefixLength;
+
+	return node + sizeof ( NodeHeader ) + prefixLength + ( size_t ) slot * ( leafStride - prefixLength );
+}	// uint8_t* BTree::LeafEntry
+
+
+// Return the stored part of an internal entry: its separator less the trimmed zeros, its address and its child.
+uint8_t* BTree::InternalEntry ( uint8_t* node, uint32_t slot ) const
+{
+	return node + sizeof ( NodeHeader ) + ( size_t ) slot * ( internalStride - ( ( NodeHeader* ) node )->trimmedLength );
+}	// uint8_t* BTree::InternalEntry
+
+
+uint32_t BTree::InternalChild ( uint8_t* node, uint32_t childIndex ) const
+{
+	uint32_t child;
+
+	// If it's the leftmost child.
+	if ( childIndex == 0 )
+	{
+		return ( ( NodeHeader* ) node )->leftChild;
+	}
+
+	memcpy ( &child, InternalEntry ( node, childIndex - 1 ) + keyLength - ( ( NodeHeader* ) node )->trimmedLength + ENGINE_ADDRESS_LENGTH, sizeof ( child ) );
+	return child;
+}	// uint32_t BTree::InternalChild
+
+
+// Copy a leaf entry whole, its key then its address, into entry.
+void BTree::CopyLeafEntry ( uint8_t* node, uint32_t slot, uint8_t* entry ) const
+{
+	uint32_t prefixLength = ( ( NodeHeader* ) node )->prefixLength;
+
+	memcpy ( entry, node + sizeof ( NodeHeader ), prefixLength );
+	memcpy ( entry + prefixLength, LeafEntry ( node, slot ), leafStride - prefixLength );
+}	// void BTree::CopyLeafEntry
+
+
+// Copy an internal entry whole, its separator then its address and child, into entry.
+void BTree::CopyInternalEntry ( uint8_t* node, uint32_t slot, uint8_t* entry ) const
+{
+	uint32_t trimmedLength = ( ( NodeHeader* ) node )->trimmedLength;
+	uint32_t length = keyLength - trimmedLength;
+	const uint8_t* stored = InternalEntry ( node, slot );
+
+	memcpy ( entry, stored, length );
+	memset ( entry + length, 0, trimmedLength );
+	memcpy ( entry + keyLength, stored + length, ENGINE_ADDRESS_LENGTH + ENGINE_CHILD_LENGTH );
+}	// void BTree::CopyInternalEntry
+
+
+// Return how many leading key bytes count whole leaf entries, in order, share.
+uint32_t BTree::SharedPrefix ( const uint8_t* entries, uint32_t count ) const
+{
+	uint32_t length = ( count > 0 ) ? keyLength : 0;
+
+	// If memcmp orders the keys the first and last entries share the least, else every entry counts.
+	for ( uint32_t i = ( byteOrdered && count > 1 ) ? count - 1 : 1; i < count && length > 0; i++ )
+	{
+		const uint8_t* entry = entries + ( size_t ) i * leafStride;
+		uint32_t shared = 0;
+
+		while ( shared < length && entry [ shared ] == entries [ shared ] )
+		{
+			shared++;
+		}
+
+		length = shared;
+	}	// for ( uint32_t i = ( byteOrdered && count > 1 ) ? count - 1 : 1; i < count && length > 0; i++ )
+
+	return length;
+}	// uint32_t BTree::SharedPrefix
+
+
+// Return how many zero bytes a whole key ends with.
+uint32_t BTree::TrailingZeros ( const uint8_t* key ) const
+{
+	uint32_t zeros = 0;
+
+	while ( zeros < keyLength && key [ keyLength - 1 - zeros ] == 0 )
+	{
+		zeros++;
+	}
+
+	return zeros;
+}	// uint32_t BTree::TrailingZeros
+
+
+// Return how many zero bytes the separators of count whole internal entries all end with.
+uint32_t BTree::SharedTrim ( const uint8_t* entries, uint32_t count ) const
+{
+	uint32_t length = keyLength;
+
+	for ( uint32_t i = 0; i < count && length > 0; i++ )
+	{
+		uint32_t zeros = TrailingZeros ( entries + ( size_t ) i * internalStride );
+
+		length = ( zeros < length ) ? zeros : length;
+	}
+
+	return length;
+}	// uint32_t BTree::SharedTrim
+
+
+bool BTree::LeafFits ( const uint8_t* entries, uint32_t count ) const
+{
+	return count <= LeafCapacity ( SharedPrefix ( entries, count ) );
+}	// bool BTree::LeafFits
+
+
+bool BTree::InternalFits ( const uint8_t* entries, uint32_t count ) const
+{
+	return count <= InternalCapacity ( SharedTrim ( entries, count ) );
+}	// bool BTree::InternalFits
+
+
+// Lay count whole entries out in a leaf under the longest prefix they
+// share. The caller has checked that they fit; entries mustn't be in the leaf.
+void BTree::PackLeaf ( uint8_t* node, const uint8_t* entries, uint32_t count ) const
+{
+	NodeHeader* header = ( NodeHeader* ) node;
+	uint32_t prefixLength = SharedPrefix ( entries, count );
+
+	header->count = ( uint16_t ) count;
+	header->prefixLength = ( uint16_t ) prefixLength;
+	memcpy ( node + sizeof ( NodeHeader ), entries, prefixLength );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		memcpy ( LeafEntry ( node, i ), entries + ( size_t ) i * leafStride + prefixLength, leafStride - prefixLength );
+	}
+}	// void BTree::PackLeaf
+
+
+// Lay count whole entries out in an internal node, dropping the zeros
+// their separators all end with. The caller has checked that they fit;
+// entries mustn't be in the node.
+void BTree::PackInternal ( uint8_t* node, const uint8_t* entries, uint32_t count ) const
+{
+	NodeHeader* header = ( NodeHeader* ) node;
+	uint32_t trimmedLength = SharedTrim ( entries, count );
+	uint32_t length = keyLength - trimmedLength;
+
+	header->count = ( uint16_t ) count;
+	header->trimmedLength = ( uint16_t ) trimmedLength;
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		const uint8_t* entry = entries + ( size_t ) i * internalStride;
+		uint8_t* stored = InternalEntry ( node, i );
+
+		memcpy ( stored, entry, length );
+		memcpy ( stored + length, entry + keyLength, ENGINE_ADDRESS_LENGTH + ENGINE_CHILD_LENGTH );
+	}
+}	// void BTree::PackInternal
+
+
+// Return where to split total whole entries into two leaves: the first of
+// preferred, slot and slot + 1 that leaves both halves fitting, or zero if
+// none does. One of the last two always does unless the entry at slot
+// broke a prefix the rest of the leaf needs.
+uint32_t BTree::ChooseLeafSplit ( const uint8_t* entries, uint32_t total, uint32_t preferred, uint32_t slot ) const
+{
+	uint32_t candidates [ 3 ] = { preferred, slot, slot + 1 };
+
+	for ( int i = 0; i < 3; i++ )
+	{
+		uint32_t leftCount = candidates [ i ];
+
+		// If both halves have entries and fit.
+		if ( leftCount > 0 && leftCount < total
+			&& LeafFits ( entries, leftCount )
+			&& LeafFits ( entries + ( size_t ) leftCount * leafStride, total - leftCount ) )
+		{
+			return leftCount;
+		}
+	}	// for ( int i = 0; i < 3; i++ )
+
+	return 0;
+}	// uint32_t BTree::ChooseLeafSplit
+
+
+// Return how many of the children from first on, at most limit of them,
+// one internal node holds, given the whole separator of each child.
+size_t BTree::FillInternal ( const std::vector<uint8_t>& separators, size_t first, size_t children, size_t limit ) const
+{
+	uint32_t trimmedLength = keyLength;
+	size_t take = 1;
+
+	while ( first + take < children && take < limit )
+	{
+		uint32_t zeros = TrailingZeros ( &separators [ ( first + take ) * leafStride ] );
+
+		zeros = ( zeros < trimmedLength ) ? zeros : trimmedLength;
+
+		// If the node can't hold another separator.
+		if ( take > InternalCapacity ( zeros ) )
+		{
+			break;
+		}
+
+		trimmedLength = zeros;
+		take++;
+	}	// while ( first + take < children && take < limit )
+
+	return take;
+}	// size_t BTree::FillInternal
+
+
+// Fill separator, a whole entry, with the lower bound of a node whose
+// first entry is right, after a node whose last entry is left, if any.
+void BTree::MakeSeparator ( const uint8_t* left, const uint8_t* right, uint8_t* separator ) const
+{
+	uint64_t address = 0;
+	uint32_t length = 0;
+
+	memcpy ( separator, right, leafStride );
+
+	// If there's no node before, or only the whole key orders the entries.
+	if ( left == NULL || !byteOrdered )
+	{
+		return;
+	}
+
+	while ( length < keyLength && left [ length ] == right [ length ] )
+	{
+		length++;
+	}
+
+	// If the keys are equal, the addresses separate the entries.
+	if ( length == keyLength )
+	{
+		return;
+	}
+
+	// Keep the keys' common prefix and the first byte that differs, which is greater in right.
+	memset ( separator + length + 1, 0, keyLength - length - 1 );
+	memcpy ( separator + keyLength, &address, sizeof ( address ) );
+}	// void BTree::MakeSeparator
+
+
+// Order an entry whose key equals the search key against the search entry.
+static int CompareAddress ( const uint8_t* entryAddress, uint64_t address, AddressMode mode )
+{
+	uint64_t value;
+
+	switch ( mode )
+	{
+		case ADDRESS_MODE_LOWEST:
+			return 1;
+		case ADDRESS_MODE_HIGHEST:
+			return -1;
+		default:
+			memcpy ( &value, entryAddress, sizeof ( value ) );
+			return ( value < address ) ? -1 : ( value > address ) ? 1 : 0;
+	}
+}	// static int CompareAddress
+
+
+int BTree::CompareEntry ( const uint8_t* entry, const uint8_t* key, uint64_t address, AddressMode mode ) const
+{
+	int result = CompareKeys ( *definition, entry, key );
+
+	// If the keys differ, or the mode decides the order of equal keys.
+	if ( result != 0 )
+	{
+		return result;
+	}
+
+	return CompareAddress ( entry + keyLength, address, mode );
+}	// int BTree::CompareEntry
+
+
+int BTree::CompareLeafEntry ( uint8_t* node, uint32_t slot, const uint8_t* key, uint64_t address, AddressMode mode ) const
+{
+	uint8_t entry [ BTRIEVE_MAXIMUM_KEY_LENGTH + ENGINE_ADDRESS_LENGTH ];
+
+	CopyLeafEntry ( node, slot, entry );
+	return CompareEntry ( entry, key, address, mode );
+}	// int BTree::CompareLeafEntry
+
+
+// Set ordinals to the keys of a node and the search key as integers;
+// return false if their stored parts don't read as integers.
+bool BTree::ReadOrdinals ( uint8_t* node, const uint8_t* key, NodeOrdinals* ordinals ) const
+{
+	NodeHeader* header = ( NodeHeader* ) node;
+	bool leaf = ( header->level == 0 );
+	uint32_t prefixLength = leaf ? header->prefixLength : 0;
+	uint32_t length = keyLength - prefixLength - ( leaf ? 0 : header->trimmedLength );
+
+	// If the keys aren't integers, nor short enough to read as one.
+	if ( integerWidth == 0 && ( !byteOrdered || length > sizeof ( uint64_t ) ) )
+	{
+		return false;
+	}
+
+	ordinals->base = node + sizeof ( NodeHeader ) + prefixLength;
+	ordinals->stride = leaf ? leafStride - prefixLength : internalStride - header->trimmedLength;
+	ordinals->count = header->count;
+	ordinals->length = length;
+	ordinals->window = ENGINE_NODE_SCAN_BYTES / ordinals->stride;
+	ordinals->window = ( ordinals->window > 0 ) ? ordinals->window : 1;
+	ordinals->prefix = 0;
+	ordinals->key = 0;
+
+	// If the keys are integers, the stored bytes are the high ones; a leaf's prefix holds the rest.
+	if ( integerWidth != 0 )
+	{
+		ordinals->bigEndian = false;
+		ordinals->shift = ( length == 0 ) ? 0 : prefixLength * 8;
+		ordinals->mask = ( length == 0 ) ? 0 : ~( uint64_t ) 0 >> ( 64 - length * 8 );
+		ordinals->flip = integerFlip;
+		memcpy ( &ordinals->prefix, node + sizeof ( NodeHeader ), prefixLength );
+		memcpy ( &ordinals->key, key, integerWidth );
+		ordinals->key ^= integerFlip;
+		return true;
+	}
+
+	// Memcmp orders the keys, so they read with the first byte highest.
+	ordinals->bigEndian = true;
+	ordinals->shift = 0;
+	ordinals->mask = ( length == 0 ) ? 0 : ~( uint64_t ) 0 << ( 64 - length * 8 );
+	ordinals->flip = 0;
+
+	for ( uint32_t i = 0; i < length; i++ )
+	{
+		ordinals->key |= ( uint64_t ) key [ prefixLength + i ] << ( 56 - i * 8 );
+	}
+
+	return true;
+}	// bool BTree::ReadOrdinals
+
+
+// Read the key of an entry as an integer. Its address or child follows
+// the stored bytes, so eight bytes can always be read.
+static inline uint64_t ReadOrdinal ( const NodeOrdinals& ordinals, uint32_t slot )
+{
+	uint64_t bytes;
+
+	memcpy ( &bytes, ordinals.base + ( size_t ) slot * ordinals.stride, sizeof ( bytes ) );
+
+	// If the first byte is the most significant.
+	if ( ordinals.bigEndian )
+	{
+		bytes = __builtin_bswap64 ( bytes );
+	}
+
+	return ( ( ( bytes & ordinals.mask ) << ordinals.shift ) | ordinals.prefix ) ^ ordinals.flip;
+}	// static inline uint64_t ReadOrdinal
+
+
+// Return true if an entry sorts before the search entry or, if through,
+// doesn't sort after it.
+template<AddressMode mode, bool through>
+static inline bool PrecedesOrdinal ( const NodeOrdinals& ordinals, uint32_t slot, uint64_t address )
+{
+	uint64_t ordinal = ReadOrdinal ( ordinals, slot );
+	uint64_t value;
+
+	switch ( mode )
+	{
+		case ADDRESS_MODE_LOWEST:
+			return ordinal < ordinals.key;
+		case ADDRESS_MODE_HIGHEST:
+			return ordinal <= ordinals.key;
+		default:
+			memcpy ( &value, ordinals.base + ( size_t ) slot * ordinals.stride + ordinals.length, sizeof ( value ) );
+			return ( ordinal < ordinals.key ) | ( ( ordinal == ordinals.key ) & ( through ? value <= address : value < address ) );
+	}
+}	// static inline bool PrecedesOrdinal
+
+
+// Return the entries of a node that sort before the search entry or, if
+// through, don't sort after it.
+template<AddressMode mode, bool through>
+static uint32_t CountOrdinals ( const NodeOrdinals& ordinals, uint64_t address )
+{
+	uint32_t first = 0;
+	uint32_t length = ordinals.count;
+	uint32_t below = 0;
+
+	// Keep the half the answer lies in, picked without a branch, until the
+	// rest fit in the window; the entries either next half starts at are
+	// fetched while the middle one is compared.
+	while ( length > ordinals.window )
+	{
+		uint32_t half = length / 2;
+		uint32_t quarter = ( length - half ) / 2;
+
+		__builtin_prefetch ( ordinals.base + ( size_t ) ( first + quarter ) * ordinals.stride );
+		__builtin_prefetch ( ordinals.base + ( size_t ) ( first + half + quarter ) * ordinals.stride );
+		first += PrecedesOrdinal<mode, through> ( ordinals, first + half, address ) ? half : 0;
+		length -= half;
+	}	// while ( length > ordinals.window )
+
+	for ( uint32_t i = 0; i < length; i++ )
+	{
+		below += PrecedesOrdinal<mode, through> ( ordinals, first + i, address );
+	}
+
+	return first + below;
+}	// static uint32_t CountOrdinals
+
+
+// Search the keys of a node as integers, as SearchLeaf does or, if
+// through, as SearchInternal does.
+static uint32_t SearchOrdinals ( const NodeOrdinals& ordinals, uint64_t address, AddressMode mode, bool through )
+{
+	switch ( mode )
+	{
+		case ADDRESS_MODE_LOWEST:
+			return CountOrdinals<ADDRESS_MODE_LOWEST, false> ( ordinals, address );
+		case ADDRESS_MODE_HIGHEST:
+			return CountOrdinals<ADDRESS_MODE_HIGHEST, false> ( ordinals, address );
+		default:
+			return through ? CountOrdinals<ADDRESS_MODE_EXACT, true> ( ordinals, address ) : CountOrdinals<ADDRESS_MODE_EXACT, false> ( ordinals, address );
+	}
+}	// static uint32_t SearchOrdinals
+
+
+// Return the first slot whose entry is at least the search entry.
+uint32_t BTree::SearchLeaf ( uint8_t* node, const uint8_t* key, uint64_t address, AddressMode mode ) const
+{
+	uint32_t prefixLength = ( ( NodeHeader* ) node )->prefixLength;
+	uint32_t low = 0;
+	uint32_t high = ( ( NodeHeader* ) node )->count;
+	NodeOrdinals ordinals;
+
+	// If memcmp orders the keys, the prefix places a key that doesn't share it.
+	if ( prefixLength > 0 && byteOrdered )
+	{
+		int result = memcmp ( node + sizeof ( NodeHeader ), key, prefixLength );
+
+		// If the key sorts before or after every entry.
+		if ( result != 0 )
+		{
+			return ( result > 0 ) ? 0 : high;
+		}
+	}
+
+	// If the keys read as integers.
+	if ( ReadOrdinals ( node, key, &ordinals ) )
+	{
+		return SearchOrdinals ( ordinals, address, mode, false );
+	}
+
+	// If memcmp orders the keys, the rest of the key places a key that shares the prefix.
+	if ( prefixLength > 0 && byteOrdered )
+	{
+		uint32_t suffixLength = keyLength - prefixLength;
+		const uint8_t* suffix = key + prefixLength;
+		const uint8_t* base = LeafEntry ( node, 0 );
+
+		while ( low < high )
+		{
+			uint32_t middle = ( low + high ) / 2;
+			const uint8_t* entry = base + ( size_t ) middle * ( suffixLength + ENGINE_ADDRESS_LENGTH );
+			int result = memcmp ( entry, suffix, suffixLength );
+
+			// If the keys are equal, the addresses decide.
+			if ( result == 0 )
+			{
+				result = CompareAddress ( entry + suffixLength, address, mode );
+			}
+
+			// If the middle entry is less than the search entry.
+			if ( result < 0 )
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}	// while ( low < high )
+
+		return low;
+	}	// if ( prefixLength > 0 && byteOrdered )
+
+	// If the entries share a prefix, rebuild each one the search looks at.
+	if ( prefixLength > 0 )
+	{
+		uint8_t entry [ BTRIEVE_MAXIMUM_KEY_LENGTH + ENGINE_ADDRESS_LENGTH ];
+
+		memcpy ( entry, node + sizeof ( NodeHeader ), prefixLength );
+
+		while ( low < high )
+		{
+			uint32_t middle = ( low + high ) / 2;
+
+			memcpy ( entry + prefixLength, LeafEntry ( node, middle ), leafStride - prefixLength );
+
+			// If the middle entry is less than the search entry.
+			if ( CompareEntry ( entry, key, address, mode ) < 0 )
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}	// while ( low < high )
+
+		return low;
+	}	// if ( prefixLength > 0 )
+
+	while ( low < high )
+	{
+		uint32_t middle = ( low + high ) / 2;
+
+		// If the middle entry is less than the search entry.
+		if ( CompareEntry ( LeafEntry ( node, middle ), key, address, mode ) < 0 )
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}	// while ( low < high )
+
+	return low;
+}	// uint32_t BTree::SearchLeaf
+
+
+// Return the child index of the last separator at most the search entry.
+uint32_t BTree::SearchInternal ( uint8_t* node, const uint8_t* key, uint64_t address, AddressMode mode ) const
+{
+	uint32_t trimmedLength = ( ( NodeHeader* ) node )->trimmedLength;
+	uint32_t length = keyLength - trimmedLength;
+	uint32_t low = 0;
+	uint32_t high = ( ( NodeHeader* ) node )->count;
+	NodeOrdinals ordinals;
+
+	// If the keys read as integers. Where memcmp orders the keys, one that
+	// matches the stored bytes but doesn't end with the zeros is past them.
+	if ( ReadOrdinals ( node, key, &ordinals ) )
+	{
+		// If the key doesn't end with the trimmed zeros.
+		if ( byteOrdered && !IsZero ( key + length, trimmedLength ) )
+		{
+			mode = ADDRESS_MODE_HIGHEST;
+		}
+
+		return SearchOrdinals ( ordinals, address, mode, true );
+	}
+
+	// If memcmp orders the keys, compare the stored bytes; a key that
+	// matches them is past the separator unless it ends with the zeros too.
+	if ( trimmedLength > 0 && byteOrdered )
+	{
+		bool paddedKey = IsZero ( key + length, trimmedLength );
+
+		while ( low < high )
+		{
+			uint32_t middle = ( low + high ) / 2;
+			const uint8_t* entry = InternalEntry ( node, middle );
+			int result = memcmp ( entry, key, length );
+
+			// If the stored bytes are equal, the rest of the key or the addresses decide.
+			if ( result == 0 )
+			{
+				result = paddedKey ? CompareAddress ( entry + length, address, mode ) : -1;
+			}
+
+			// If the middle separator is at most the search entry.
+			if ( result <= 0 )
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}	// while ( low < high )
+
+		return low;
+	}	// if ( trimmedLength > 0 && byteOrdered )
+
+	// If the separators are trimmed, restore the zeros of each one the search looks at.
+	if ( trimmedLength > 0 )
+	{
+		uint8_t entry [ BTRIEVE_MAXIMUM_KEY_LENGTH + ENGINE_ADDRESS_LENGTH ];
+
+		memset ( entry + length, 0, trimmedLength );
+
+		while ( low < high )
+		{
+			uint32_t middle = ( low + high ) / 2;
+
+			memcpy ( entry, InternalEntry ( node, middle ), length );
+			memcpy ( entry + keyLength, InternalEntry ( node, middle ) + length, ENGINE_ADDRESS_LENGTH );
+
+			// If the middle separator is at most the search entry.
+			if ( CompareEntry ( entry, key, address, mode ) <= 0 )
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}	// while ( low < high )
+
+		return low;
+	}	// if ( trimmedLength > 0 )
+
+	while ( low < high )
+	{
+		uint32_t middle = ( low + high ) / 2;
+
+		// If the middle separator is at most the search entry.
+		if ( CompareEntry ( InternalEntry ( node, middle ), key, address, mode ) <= 0 )
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}	// while ( low < high )
+
+	return low;
+}	// uint32_t BTree::SearchInternal
+
+
+btrieve_status_code_t BTree::Initialize ( )
+{
+	PageHandle page;
+	uint32_t pageNumber;
+	btrieve_status_code_t status = file->AllocatePage ( ENGINE_PAGE_TYPE_LEAF, &pageNumber, &page );
+
+	// If AllocatePage ( ) fails.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	definition->rootPage = pageNumber;
+	definition->height = 1;
+	definition->entryCount = 0;
+	definition->pageCount = 1;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BTree::Initialize
+
+
+bool BTree::Descend ( const uint8_t* key, uint64_t address, AddressMode mode, std::vector<PathStep>* path )
+{
+	uint32_t pageNumber = definition->rootPage;
+
+	path->clear ( );
+
+	for ( ;; )
+	{
+		PageHandle page = file->pager.Fetch ( pageNumber );
+		PathStep step;
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		step.page = pageNumber;
+
+		// If this is a leaf the descent is over.
+		if ( ( ( NodeHeader* ) page.GetData ( ) )->level == 0 )
+		{
+			step.childIndex = 0;
+			path->push_back ( step );
+			return true;
+		}
+
+		step.childIndex = SearchInternal ( page.GetData ( ), key, address, mode );
+		path->push_back ( step );
+		pageNumber = InternalChild ( page.GetData ( ), step.childIndex );
+	}	// for ( ;; )
+}	// bool BTree::Descend
+
+
+bool BTree::LowerBound ( const uint8_t* key, uint64_t address, AddressMode mode, TreePosition* position )
+{
+	std::vector<PathStep> path;
+	uint32_t slot;
+
+	// If Descend ( ) fails.
+	if ( !Descend ( key, address, mode, &path ) )
+	{
+		return false;
+	}
+
+	PageHandle page = file->pager.Fetch ( path.back ( ).page );
+
+	// If Fetch ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return false;
+	}
+
+	slot = SearchLeaf ( page.GetData ( ), key, address, mode );
+	position->page = path.back ( ).page;
+	position->slot = slot;
+
+	// If the bound lies past this leaf, it's the first entry of the next.
+	if ( slot >= ( ( NodeHeader* ) page.GetData ( ) )->count )
+	{
+		position->page = ( ( NodeHeader* ) page.GetData ( ) )->next;
+		position->slot = 0;
+	}
+
+	return true;
+}	// bool BTree::LowerBound
+
+
+bool BTree::First ( TreePosition* position )
+{
+	uint32_t pageNumber = definition->rootPage;
+
+	for ( ;; )
+	{
+		PageHandle page = file->pager.Fetch ( pageNumber );
+		NodeHeader* node;
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		node = ( NodeHeader* ) page.GetData ( );
+
+		// If this is a leaf the descent is over.
+		if ( node->level == 0 )
+		{
+			position->page = ( node->count > 0 ) ? pageNumber : 0;
+			position->slot = 0;
+			return true;
+		}
+
+		pageNumber = node->leftChild;
+	}	// for ( ;; )
+}	// bool BTree::First
+
+
+bool BTree::Last ( TreePosition* position )
+{
+	uint32_t pageNumber = definition->rootPage;
+
+	for ( ;; )
+	{
+		PageHandle page = file->pager.Fetch ( pageNumber );
+		NodeHeader* node;
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		node = ( NodeHeader* ) page.GetData ( );
+
+		// If this is a leaf the descent is over.
+		if ( node->level == 0 )
+		{
+			position->page = ( node->count > 0 ) ? pageNumber : 0;
+			position->slot = ( node->count > 0 ) ? node->count - 1u : 0;
+			return true;
+		}
+
+		pageNumber = InternalChild ( page.GetData ( ), node->count );
+	}	// for ( ;; )
+}	// bool BTree::Last
+
+
+bool BTree::Next ( TreePosition* position )
+{
+	PageHandle page = file->pager.Fetch ( position->page );
+	NodeHeader* node;
+
+	// If Fetch ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return false;
+	}
+
+	node = ( NodeHeader* ) page.GetData ( );
+
+	// If the next entry is in the same leaf.
+	if ( position->slot + 1 < node->count )
+	{
+		position->slot++;
+	}
+	else
+	{
+		position->page = node->next;
+		position->slot = 0;
+	}
+
+	return true;
+}	// bool BTree::Next
+
+
+bool BTree::Previous ( TreePosition* position )
+{
+	// If the position is in the middle of a leaf.
+	if ( position->slot > 0 )
+	{
+		position->slot--;
+		return true;
+	}
+
+	PageHandle page = file->pager.Fetch ( position->page );
+
+	// If Fetch ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return false;
+	}
+
+	position->page = ( ( NodeHeader* ) page.GetData ( ) )->previous;
+
+	// If there is a previous leaf, move to its last entry.
+	if ( position->page != 0 )
+	{
+		PageHandle previous = file->pager.Fetch ( position->page );
+
+		// If Fetch ( ) fails.
+		if ( !previous.IsValid ( ) )
+		{
+			return false;
+		}
+
+		position->slot = ( ( NodeHeader* ) previous.GetData ( ) )->count - 1u;
+	}
+
+	return true;
+}	// bool BTree::Previous
+
+
+bool BTree::ReadEntry ( const TreePosition& position, uint8_t* key, uint64_t* address )
+{
+	PageHandle page = file->pager.Fetch ( position.page );
+	uint8_t* entry;
+
+	// If Fetch ( ) fails, or the slot is stale.
+	if ( !page.IsValid ( ) || position.slot >= ( ( NodeHeader* ) page.GetData ( ) )->count )
+	{
+		return false;
+	}
+
+	uint32_t prefixLength = ( ( NodeHeader* ) page.GetData ( ) )->prefixLength;
+
+	entry = LeafEntry ( page.GetData ( ), position.slot );
+
+	// If the caller wants the key.
+	if ( key != NULL )
+	{
+		memcpy ( key, page.GetData ( ) + sizeof ( NodeHeader ), prefixLength );
+		memcpy ( key + prefixLength, entry, keyLength - prefixLength );
+	}
+
+	memcpy ( address, entry + keyLength - prefixLength, sizeof ( *address ) );
+	return true;
+}	// bool BTree::ReadEntry
+
+
+BTreeSeeker::BTreeSeeker ( BTree* treeIn )
+	: tree ( treeIn ),
+	  peekNext ( true ),
+	  pageReads ( 0 )
+{
+}	// BTreeSeeker::BTreeSeeker
+
+
+bool BTreeSeeker::Pin ( uint32_t pageNumber )
+{
+	leaf = tree->file->pager.Fetch ( pageNumber );
+	return leaf.IsValid ( );
+}	// bool BTreeSeeker::Pin
+
+
+// Return true if the key is at most the last key of the pinned leaf, so its bound lies there.
+bool BTreeSeeker::LeafHolds ( const uint8_t* key )
+{
+	NodeHeader* node = ( NodeHeader* ) leaf.GetData ( );
+
+	return node->count > 0 && tree->CompareLeafEntry ( leaf.GetData ( ), node->count - 1u, key, 0, ADDRESS_MODE_LOWEST ) >= 0;
+}	// bool BTreeSeeker::LeafHolds
+
+
+// Point entry at a copy of the bound of the key in the pinned leaf, or of
+// the first entry of the next leaf if the bound lies past this one.
+bool BTreeSeeker::Settle ( const uint8_t* key, const uint8_t** entry )
+{
+	NodeHeader* node = ( NodeHeader* ) leaf.GetData ( );
+	uint32_t slot = tree->SearchLeaf ( leaf.GetData ( ), key, 0, ADDRESS_MODE_LOWEST );
+
+	// If the bound lies past this leaf.
+	if ( slot >= node->count )
+	{
+		// If this is the last leaf there's no bound.
+		if ( node->next == 0 )
+		{
+			return true;
+		}
+
+		// If Pin ( ) fails.
+		if ( !Pin ( node->next ) )
+		{
+			return false;
+		}
+
+		pageReads++;
+		slot = 0;
+
+		// If the next leaf is empty.
+		if ( ( ( NodeHeader* ) leaf.GetData ( ) )->count == 0 )
+		{
+			return true;
+		}
+	}	// if ( slot >= node->count )
+
+	tree->CopyLeafEntry ( leaf.GetData ( ), slot, current );
+	*entry = current;
+	return true;
+}	// bool BTreeSeeker::Settle
+
+
+bool BTreeSeeker::Seek ( const uint8_t* key, const uint8_t** entry )
+{
+	std::vector<BTree::PathStep> path;
+
+	*entry = NULL;
+
+	// If a leaf is pinned, look there before descending.
+	if ( leaf.IsValid ( ) )
+	{
+		uint32_t next = ( ( NodeHeader* ) leaf.GetData ( ) )->next;
+
+		// If the bound is in the pinned leaf.
+		if ( LeafHolds ( key ) )
+		{
+			peekNext = true;
+			return Settle ( key, entry );
+		}
+
+		// If the pinned leaf is the last one, there's no bound.
+		if ( next == 0 )
+		{
+			return true;
+		}
+
+		// If the last look at the next leaf paid off, look again.
+		if ( peekNext )
+		{
+			// If Pin ( ) fails.
+			if ( !Pin ( next ) )
+			{
+				return false;
+			}
+
+			pageReads++;
+
+			// If the bound is in the next leaf.
+			if ( LeafHolds ( key ) )
+			{
+				return Settle ( key, entry );
+			}
+
+			peekNext = false;
+		}	// if ( peekNext )
+	}	// if ( leaf.IsValid ( ) )
+
+	// If Descend ( ) or Pin ( ) fails.
+	if ( !tree->Descend ( key, 0, ADDRESS_MODE_LOWEST, &path ) || !Pin ( path.back ( ).page ) )
+	{
+		return false;
+	}
+
+	pageReads += path.size ( );
+	return Settle ( key, entry );
+}	// bool BTreeSeeker::Seek
+
+
+btrieve_status_code_t BTree::Insert ( const uint8_t* key, uint64_t address )
+{
+	std::vector<PathStep> path;
+	std::vector<uint8_t> entries;
+	uint8_t separator [ BTRIEVE_MAXIMUM_KEY_LENGTH + ENGINE_ADDRESS_LENGTH ];
+	PageHandle rightPage;
+	uint32_t rightNumber;
+	uint32_t slot;
+	uint32_t count;
+	uint32_t prefixLength;
+	uint32_t total;
+	uint32_t leftCount;
+	bool retry = false;
+	btrieve_status_code_t status;
+
+	// If Descend ( ) fails.
+	if ( !Descend ( key, address, ADDRESS_MODE_EXACT, &path ) )
+	{
+		return file->pager.GetLastStatusCode ( );
+	}
+
+	PageHandle page = file->pager.FetchForWrite ( path.back ( ).page );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return file->pager.GetLastStatusCode ( );
+	}
+
+	NodeHeader* node = ( NodeHeader* ) page.GetData ( );
+
+	slot = SearchLeaf ( page.GetData ( ), key, address, ADDRESS_MODE_EXACT );
+	count = node->count;
+	prefixLength = node->prefixLength;
+	definition->entryCount++;
+
+	// If the key shares the leaf's prefix and the leaf has room, shift the entries after the slot up by one.
+	if ( count < LeafCapacity ( prefixLength ) && memcmp ( page.GetData ( ) + sizeof ( NodeHeader ), key, prefixLength ) == 0 )
+	{
+		uint8_t* entry = LeafEntry ( page.GetData ( ), slot );
+		uint32_t stride = leafStride - prefixLength;
+
+		memmove ( entry + stride, entry, ( size_t ) ( count - slot ) * stride );
+		memcpy ( entry, key + prefixLength, keyLength - prefixLength );
+		memcpy ( entry + keyLength - prefixLength, &address, sizeof ( address ) );
+		node->count++;
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// Gather the leaf and the new entry whole.
+	total = count + 1;
+	entries.resize ( ( size_t ) total * leafStride );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		CopyLeafEntry ( page.GetData ( ), i, &entries [ ( size_t ) ( ( i < slot ) ? i : i + 1 ) * leafStride ] );
+	}
+
+	memcpy ( &entries [ ( size_t ) slot * leafStride ], key, keyLength );
+	memcpy ( &entries [ ( size_t ) slot * leafStride + keyLength ], &address, sizeof ( address ) );
+
+	// If they fit under a shorter prefix, lay the leaf out again.
+	if ( LeafFits ( &entries [ 0 ], total ) )
+	{
+		PackLeaf ( page.GetData ( ), &entries [ 0 ], total );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// Appending to the rightmost leaf leaves it full, so ascending loads pack densely.
+	leftCount = ChooseLeafSplit ( &entries [ 0 ], total, ( slot == count && node->next == 0 ) ? count : total / 2, slot );
+
+	// If no split fits, split the leaf alone where the new entry goes, then insert it again.
+	if ( leftCount == 0 )
+	{
+		entries.erase ( entries.begin ( ) + ( size_t ) slot * leafStride, entries.begin ( ) + ( size_t ) ( slot + 1 ) * leafStride );
+		total = count;
+		leftCount = slot;
+		retry = true;
+		definition->entryCount--;
+	}
+
+	// If AllocatePage ( ) fails.
+	if ( ( status = file->AllocatePage ( ENGINE_PAGE_TYPE_LEAF, &rightNumber, &rightPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		// If the new entry is still counted.
+		if ( !retry )
+		{
+			definition->entryCount--;
+		}
+
+		return status;
+	}
+
+	NodeHeader* right = ( NodeHeader* ) rightPage.GetData ( );
+
+	definition->pageCount++;
+	PackLeaf ( page.GetData ( ), &entries [ 0 ], leftCount );
+	PackLeaf ( rightPage.GetData ( ), &entries [ ( size_t ) leftCount * leafStride ], total - leftCount );
+	right->level = 0;
+	right->next = node->next;
+	right->previous = path.back ( ).page;
+	node->next = rightNumber;
+
+	// If there is a leaf after the new one, link it back.
+	if ( right->next != 0 )
+	{
+		PageHandle following = file->pager.FetchForWrite ( right->next );
+
+		// If FetchForWrite ( ) fails.
+		if ( !following.IsValid ( ) )
+		{
+			return file->pager.GetLastStatusCode ( );
+		}
+
+		( ( NodeHeader* ) following.GetData ( ) )->previous = rightNumber;
+	}
+
+	MakeSeparator ( &entries [ ( size_t ) ( leftCount - 1 ) * leafStride ], &entries [ ( size_t ) leftCount * leafStride ], separator );
+	page.Release ( );
+	rightPage.Release ( );
+	status = InsertIntoParent ( &path, path.size ( ) - 1, separator, rightNumber );
+
+	// If the new entry is still to be inserted.
+	if ( status == BTRIEVE_STATUS_CODE_NO_ERROR && retry )
+	{
+		return Insert ( key, address );
+	}
+
+	return status;
+}	// btrieve_status_code_t BTree::Insert
+
+
+btrieve_status_code_t BTree::InsertIntoParent ( std::vector<PathStep>* path, size_t level, const uint8_t* separator, uint32_t rightPage )
+{
+	std::vector<uint8_t> entries;
+	PageHandle newPage;
+	uint32_t newNumber;
+	uint32_t slot;
+	uint32_t count;
+	uint32_t trimmedLength;
+	uint32_t total;
+	uint32_t leftCount;
+	btrieve_status_code_t status;
+
+	entries.resize ( internalStride );
+	memcpy ( &entries [ 0 ], separator, leafStride );
+	memcpy ( &entries [ leafStride ], &rightPage, sizeof ( rightPage ) );
+
+	// If the split node was the root, grow a new root above it.
+	if ( level == 0 )
+	{
+		// If AllocatePage ( ) fails.
+		if ( ( status = file->AllocatePage ( ENGINE_PAGE_TYPE_INTERNAL, &newNumber, &newPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		NodeHeader* root = ( NodeHeader* ) newPage.GetData ( );
+
+		root->level = ( uint16_t ) definition->height;
+		root->leftChild = ( *path ) [ 0 ].page;
+		PackInternal ( newPage.GetData ( ), &entries [ 0 ], 1 );
+		definition->rootPage = newNumber;
+		definition->height++;
+		definition->pageCount++;
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}	// if ( level == 0 )
+
+	PathStep& parentStep = ( *path ) [ level - 1 ];
+	PageHandle page = file->pager.FetchForWrite ( parentStep.page );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return file->pager.GetLastStatusCode ( );
+	}
+
+	NodeHeader* node = ( NodeHeader* ) page.GetData ( );
+
+	// The new child follows the split child, so its separator takes entry slot childIndex.
+	slot = parentStep.childIndex;
+	count = node->count;
+	trimmedLength = node->trimmedLength;
+
+	// If the separator ends with the zeros the node drops and the node has room, shift the entries after the slot up by one.
+	if ( count < InternalCapacity ( trimmedLength ) && IsZero ( separator + keyLength - trimmedLength, trimmedLength ) )
+	{
+		uint8_t* entry = InternalEntry ( page.GetData ( ), slot );
+		uint32_t stride = internalStride - trimmedLength;
+
+		memmove ( entry + stride, entry, ( size_t ) ( count - slot ) * stride );
+		memcpy ( entry, separator, keyLength - trimmedLength );
+		memcpy ( entry + keyLength - trimmedLength, &entries [ keyLength ], ENGINE_ADDRESS_LENGTH + ENGINE_CHILD_LENGTH );
+		node->count++;
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// Gather the node and the new entry whole.
+	total = count + 1;
+	entries.resize ( ( size_t ) total * internalStride );
+	memmove ( &entries [ ( size_t ) slot * internalStride ], &entries [ 0 ], internalStride );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		CopyInternalEntry ( page.GetData ( ), i, &entries [ ( size_t ) ( ( i < slot ) ? i : i + 1 ) * internalStride ] );
+	}
+
+	// If they fit with fewer zeros dropped, lay the node out again.
+	if ( InternalFits ( &entries [ 0 ], total ) )
+	{
+		PackInternal ( page.GetData ( ), &entries [ 0 ], total );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// Split them around a middle entry that moves up. If the halves don't
+	// fit, the new entry moves up instead, which leaves halves of the node's
+	// old entries.
+	leftCount = ( slot == count && node->next == 0 ) ? count - 1 : count / 2;
+
+	// If either half doesn't fit.
+	if ( !InternalFits ( &entries [ 0 ], leftCount ) || !InternalFits ( &entries [ ( size_t ) ( leftCount + 1 ) * internalStride ], total - leftCount - 1 ) )
+	{
+		leftCount = slot;
+	}
+
+	// If AllocatePage ( ) fails.
+	if ( ( status = file->AllocatePage ( ENGINE_PAGE_TYPE_INTERNAL, &newNumber, &newPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	NodeHeader* right = ( NodeHeader* ) newPage.GetData ( );
+	uint8_t* middle = &entries [ ( size_t ) leftCount * internalStride ];
+	uint8_t upSeparator [ BTRIEVE_MAXIMUM_KEY_LENGTH + ENGINE_ADDRESS_LENGTH ];
+
+	definition->pageCount++;
+	PackInternal ( page.GetData ( ), &entries [ 0 ], leftCount );
+	memcpy ( &right->leftChild, middle + leafStride, sizeof ( right->leftChild ) );
+	PackInternal ( newPage.GetData ( ), middle + internalStride, total - leftCount - 1 );
+	right->level = node->level;
+	right->next = node->next;
+	node->next = newNumber;
+	memcpy ( upSeparator, middle, leafStride );
+	page.Release ( );
+	newPage.Release ( );
+	return InsertIntoParent ( path, level - 1, upSeparator, newNumber );
+}	// btrieve_status_code_t BTree::InsertIntoParent
+
+
+btrieve_status_code_t BTree::Remove ( const uint8_t* key, uint64_t address )
+{
+	std::vector<PathStep> path;
+	uint32_t slot;
+
+	// If Descend ( ) fails.
+	if ( !Descend ( key, address, ADDRESS_MODE_EXACT, &path ) )
+	{
+		return file->pager.GetLastStatusCode ( );
+	}
+
+	PageHandle page = file->pager.FetchForWrite ( path.back ( ).page );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return file->pager.GetLastStatusCode ( );
+	}
+
+	NodeHeader* node = ( NodeHeader* ) page.GetData ( );
+
+	slot = SearchLeaf ( page.GetData ( ), key, address, ADDRESS_MODE_EXACT );
+
+	// If the entry isn't there the index is damaged.
+	if ( slot >= node->count || CompareLeafEntry ( page.GetData ( ), slot, key, address, ADDRESS_MODE_EXACT ) != 0 )
+	{
+		return BTRIEVE_STATUS_CODE_UNRECOVERABLE_ERROR;
+	}
+
+	memmove ( LeafEntry ( page.GetData ( ), slot ), LeafEntry ( page.GetData ( ), slot + 1 ), ( size_t ) ( node->count - slot - 1 ) * ( leafStride - node->prefixLength ) );
+	node->count--;
+	definition->entryCount--;
+	// If the leaf still has entries, or is the root, it stays.
+	if ( node->count > 0 || path.size ( ) == 1 )
+	{
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// Unlink the empty leaf from its neighbours.
+	uint32_t previous = node->previous;
+	uint32_t next = node->next;
+
+	page.Release ( );
+
+	// If there is a previous leaf.
+	if ( previous != 0 )
+	{
+		PageHandle neighbour = file->pager.FetchForWrite ( previous );
+
+		// If FetchForWrite ( ) fails.
+		if ( !neighbour.IsValid ( ) )
+		{
+			return file->pager.GetLastStatusCode ( );
+		}
+
+		( ( NodeHeader* ) neighbour.GetData ( ) )->next = next;
+	}
+
+	// If there is a next leaf.
+	if ( next != 0 )
+	{
+		PageHandle neighbour = file->pager.FetchForWrite ( next );
+
+		// If FetchForWrite ( ) fails.
+		if ( !neighbour.IsValid ( ) )
+		{
+			return file->pager.GetLastStatusCode ( );
+		}
+
+		( ( NodeHeader* ) neighbour.GetData ( ) )->previous = previous;
+	}
+
+	return RemoveFromParent ( &path, path.size ( ) - 1 );
+}	// btrieve_status_code_t BTree::Remove
+
+
+// Free the empty node at path level and drop its pointer from the parent.
+btrieve_status_code_t BTree::RemoveFromParent ( std::vector<PathStep>* path, size_t level )
+{
+	btrieve_status_code_t status;
+	PathStep& parentStep = ( *path ) [ level - 1 ];
+
+	// If FreePage ( ) fails.
+	if ( ( status = file->FreePage ( ( *path ) [ level ].page ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	definition->pageCount--;
+
+	PageHandle page = file->pager.FetchForWrite ( parentStep.page );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return file->pager.GetLastStatusCode ( );
+	}
+
+	NodeHeader* node = ( NodeHeader* ) page.GetData ( );
+	uint32_t stride = internalStride - node->trimmedLength;
+
+	// If the parent loses its last child it is empty too.
+	if ( node->count == 0 )
+	{
+		page.Release ( );
+		return RemoveFromParent ( path, level - 1 );
+	}
+
+	// If the leftmost child is removed, the first entry's child takes its place.
+	if ( parentStep.childIndex == 0 )
+	{
+		node->leftChild = InternalChild ( page.GetData ( ), 1 );
+		memmove ( InternalEntry ( page.GetData ( ), 0 ), InternalEntry ( page.GetData ( ), 1 ), ( size_t ) ( node->count - 1 ) * stride );
+	}
+	else
+	{
+		memmove ( InternalEntry ( page.GetData ( ), parentStep.childIndex - 1 ), InternalEntry ( page.GetData ( ), parentStep.childIndex ), ( size_t ) ( node->count - parentStep.childIndex ) * stride );
+	}
+
+	node->count--;
+
+	// Collapse roots with a single child.
+	while ( level - 1 == 0 && node->count == 0 && node->level > 0 )
+	{
+		uint32_t oldRoot = definition->rootPage;
+		uint32_t child = node->leftChild;
+
+		page.Release ( );
+
+		// If FreePage ( ) fails.
+		if ( ( status = file->FreePage ( oldRoot ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		definition->rootPage = child;
+		definition->height--;
+		definition->pageCount--;
+		page = file->pager.Fetch ( child );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return file->pager.GetLastStatusCode ( );
+		}
+
+		node = ( NodeHeader* ) page.GetData ( );
+	}	// while ( level - 1 == 0 && node->count == 0 && node->level > 0 )
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BTree::RemoveFromParent
+
+
+btrieve_status_code_t BTree::DropSubtree ( uint32_t pageNumber )
+{
+	std::vector<uint32_t> children;
+	btrieve_status_code_t status;
+
+	{
+		PageHandle page = file->pager.Fetch ( pageNumber );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return file->pager.GetLastStatusCode ( );
+		}
+
+		NodeHeader* node = ( NodeHeader* ) page.GetData ( );
+
+		// If this is an internal node, gather its children.
+		if ( node->level > 0 )
+		{
+			for ( uint32_t i = 0; i <= node->count; i++ )
+			{
+				children.push_back ( InternalChild ( page.GetData ( ), i ) );
+			}
+		}
+	}
+
+	for ( size_t i = 0; i < children.size ( ); i++ )
+	{
+		// If DropSubtree ( ) fails.
+		if ( ( status = DropSubtree ( children [ i ] ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+	}
+
+	return file->FreePage ( pageNumber );
+}	// btrieve_status_code_t BTree::DropSubtree
+
+
+btrieve_status_code_t BTree::Drop ( )
+{
+	btrieve_status_code_t status = DropSubtree ( definition->rootPage );
+
+	definition->rootPage = 0;
+	definition->height = 0;
+	definition->entryCount = 0;
+	definition->pageCount = 0;
+	return status;
+}	// btrieve_status_code_t BTree::Drop
+
+
+btrieve_status_code_t BTree::Load ( EntryMerger* merger, bool unique )
+{
+	std::vector<uint32_t> children;										// The nodes of the level just built, in order.
+	std::vector<uint8_t> separators;									// The lower bound of each of those nodes, a whole entry.
+	std::vector<uint8_t> pending;										// The entries of the leaf being filled.
+	std::vector<uint32_t> allocated;
+	uint8_t separator [ BTRIEVE_MAXIMUM_KEY_LENGTH + ENGINE_ADDRESS_LENGTH ];
+	const uint8_t* entry;
+	uint32_t pageNumber = definition->rootPage;
+	uint32_t pendingCount = 0;
+	uint32_t prefixLength = 0;											// The key bytes the pending entries share.
+	uint64_t entries = 0;
+	uint32_t height = 1;
+	btrieve_status_code_t status = BTRIEVE_STATUS_CODE_NO_ERROR;
+	PageHandle page = file->pager.FetchForWrite ( pageNumber );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return file->pager.GetLastStatusCode ( );
+	}
+
+	children.push_back ( pageNumber );
+
+	while ( merger->Next ( &entry ) )
+	{
+		// If the index is unique and the key repeats the last pending one.
+		if ( unique && pendingCount > 0 && CompareKeys ( *definition, &pending [ ( size_t ) ( pendingCount - 1 ) * leafStride ], entry ) == 0 )
+		{
+			status = BTRIEVE_STATUS_CODE_DUPLICATE_KEY_VALUE;
+			break;
+		}
+
+		// If the leaf being filled has entries, see whether it takes this one under the prefix they'd share.
+		if ( pendingCount > 0 )
+		{
+			uint32_t shared = prefixLength;
+
+			// If the entry doesn't share the whole prefix, find how much of it it does.
+			if ( memcmp ( entry, &pending [ 0 ], prefixLength ) != 0 )
+			{
+				shared = 0;
+
+				while ( entry [ shared ] == pending [ shared ] )
+				{
+					shared++;
+				}
+			}
+
+			// If the leaf is full, write it and link a new one after it.
+			if ( pendingCount >= LeafCapacity ( shared ) )
+			{
+				PageHandle nextPage;
+				uint32_t nextNumber;
+
+				PackLeaf ( page.GetData ( ), &pending [ 0 ], pendingCount );
+				MakeSeparator ( &pending [ ( size_t ) ( pendingCount - 1 ) * leafStride ], entry, separator );
+
+				// If AllocatePage ( ) fails.
+				if ( ( status = file->AllocatePage ( ENGINE_PAGE_TYPE_LEAF, &nextNumber, &nextPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+				{
+					break;
+				}
+
+				allocated.push_back ( nextNumber );
+				( ( NodeHeader* ) page.GetData ( ) )->next = nextNumber;
+				( ( NodeHeader* ) nextPage.GetData ( ) )->previous = pageNumber;
+				page = std::move ( nextPage );
+				pageNumber = nextNumber;
+				children.push_back ( pageNumber );
+				separators.insert ( separators.end ( ), separator, separator + leafStride );
+				pending.clear ( );
+				pendingCount = 0;
+			}
+			else
+			{
+				prefixLength = shared;
+			}
+		}	// if ( pendingCount > 0 )
+
+		// If this is the first entry of the leaf, it shares its whole key.
+		if ( pendingCount == 0 )
+		{
+			prefixLength = keyLength;
+
+			// If this is the first leaf, its entry bounds it.
+			if ( separators.empty ( ) )
+			{
+				separators.insert ( separators.end ( ), entry, entry + leafStride );
+			}
+		}
+
+		pending.insert ( pending.end ( ), entry, entry + leafStride );
+		pendingCount++;
+		entries++;
+	}	// while ( merger->Next ( &entry ) )
+
+	// If the last leaf has entries, write it.
+	if ( pendingCount > 0 )
+	{
+		PackLeaf ( page.GetData ( ), &pending [ 0 ], pendingCount );
+	}
+
+	page.Release ( );
+
+	// If the merge stopped on an error.
+	if ( status == BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		status = merger->GetLastStatusCode ( );
+	}
+
+	// Build each internal level over the one below until a single node
+	// remains. A first pass packing nodes full counts them; the second
+	// spreads the children evenly over that many, as the separators allow.
+	while ( status == BTRIEVE_STATUS_CODE_NO_ERROR && children.size ( ) > 1 )
+	{
+		std::vector<uint32_t> parents;
+		std::vector<uint8_t> parentSeparators;
+		std::vector<uint8_t> nodeEntries;
+		size_t nodes = 0;
+		size_t child = 0;
+		PageHandle previousNode;
+
+		for ( size_t first = 0; first < children.size ( ); nodes++ )
+		{
+			first += FillInternal ( separators, first, children.size ( ), children.size ( ) );
+		}
+
+		for ( size_t n = 0; child < children.size ( ); n++ )
+		{
+			size_t remaining = ( n < nodes ) ? nodes - n : 1;
+			size_t take = FillInternal ( separators, child, children.size ( ), ( children.size ( ) - child + remaining - 1 ) / remaining );
+			PageHandle parent;
+			uint32_t parentNumber;
+
+			// If AllocatePage ( ) fails.
+			if ( ( status = file->AllocatePage ( ENGINE_PAGE_TYPE_INTERNAL, &parentNumber, &parent ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+			{
+				break;
+			}
+
+			NodeHeader* node = ( NodeHeader* ) parent.GetData ( );
+
+			allocated.push_back ( parentNumber );
+			node->level = ( uint16_t ) height;
+			node->leftChild = children [ child ];
+			nodeEntries.resize ( ( take - 1 ) * internalStride );
+
+			for ( size_t j = 1; j < take; j++ )
+			{
+				memcpy ( &nodeEntries [ ( j - 1 ) * internalStride ], &separators [ ( child + j ) * leafStride ], leafStride );
+				memcpy ( &nodeEntries [ ( j - 1 ) * internalStride + leafStride ], &children [ child + j ], sizeof ( uint32_t ) );
+			}
+
+			PackInternal ( parent.GetData ( ), nodeEntries.data ( ), ( uint32_t ) take - 1 );
+
+			// If there is a node before this one on the level, link it forward.
+			if ( previousNode.IsValid ( ) )
+			{
+				( ( NodeHeader* ) previousNode.GetData ( ) )->next = parentNumber;
+			}
+
+			parents.push_back ( parentNumber );
+			parentSeparators.insert ( parentSeparators.end ( ), &separators [ child * leafStride ], &separators [ child * leafStride ] + leafStride );
+			previousNode = std::move ( parent );
+			child += take;
+		}	// for ( size_t n = 0; child < children.size ( ); n++ )
+
+		children.swap ( parents );
+		separators.swap ( parentSeparators );
+		height++;
+	}	// while ( status == BTRIEVE_STATUS_CODE_NO_ERROR && children.size ( ) > 1 )
+
+	// If the build failed, free every page it added and leave the tree empty.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		for ( size_t i = 0; i < allocated.size ( ); i++ )
+		{
+			file->FreePage ( allocated [ i ] );
+		}
+
+		page = file->pager.FetchForWrite ( definition->rootPage );
+
+		// If the root can be fetched, empty it.
+		if ( page.IsValid ( ) )
+		{
+			( ( NodeHeader* ) page.GetData ( ) )->count = 0;
+			( ( NodeHeader* ) page.GetData ( ) )->next = 0;
+		}
+
+		return status;
+	}	// if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+
+	definition->rootPage = children [ 0 ];
+	definition->height = height;
+	definition->entryCount = entries;
+	definition->pageCount = ( uint32_t ) ( allocated.size ( ) + 1 );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BTree::Load
+
+
+bool BTree::SeekFraction ( double fraction, TreePosition* position )
+{
+	uint32_t pageNumber = definition->rootPage;
+
+	// Clamp the fraction to the index.
+	fraction = ( fraction < 0.0 ) ? 0.0 : ( fraction > 1.0 ) ? 1.0 : fraction;
+
+	for ( ;; )
+	{
+		PageHandle page = file->pager.Fetch ( pageNumber );
+		NodeHeader* node;
+		uint32_t choice;
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		node = ( NodeHeader* ) page.GetData ( );
+
+		// If this is a leaf, pick the entry.
+		if ( node->level == 0 )
+		{
+			// If the index is empty.
+			if ( node->count == 0 )
+			{
+				position->page = 0;
+				position->slot = 0;
+				return true;
+			}
+
+			choice = ( uint32_t ) ( fraction * node->count );
+			position->page = pageNumber;
+			position->slot = ( choice >= node->count ) ? node->count - 1u : choice;
+			return true;
+		}	// if ( node->level == 0 )
+
+		// Pick the child the fraction falls in, then rescale the fraction within it.
+		choice = ( uint32_t ) ( fraction * ( node->count + 1 ) );
+		choice = ( choice > node->count ) ? node->count : choice;
+		fraction = fraction * ( node->count + 1 ) - choice;
+		pageNumber = InternalChild ( page.GetData ( ), choice );
+	}	// for ( ;; )
+}	// bool BTree::SeekFraction
+
+
+bool BTree::GetFraction ( const uint8_t* key, uint64_t address, double* fraction )
+{
+	std::vector<PathStep> path;
+	std::vector<uint32_t> widths;
+	double result;
+
+	// If Descend ( ) fails.
+	if ( !Descend ( key, address, ADDRESS_MODE_EXACT, &path ) )
+	{
+		return false;
+	}
+
+	for ( size_t i = 0; i < path.size ( ); i++ )
+	{
+		PageHandle page = file->pager.Fetch ( path [ i ].page );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		NodeHeader* node = ( NodeHeader* ) page.GetData ( );
+
+		// If this is the leaf, the slot is the position within it.
+		if ( node->level == 0 )
+		{
+			path [ i ].childIndex = SearchLeaf ( page.GetData ( ), key, address, ADDRESS_MODE_EXACT );
+			widths.push_back ( node->count > 0 ? node->count : 1u );
+		}
+		else
+		{
+			widths.push_back ( node->count + 1u );
+		}
+	}	// for ( size_t i = 0; i < path.size ( ); i++ )
+
+	// Fold the positions from the leaf back up to the root.
+	result = 0.0;
+
+	for ( size_t i = path.size ( ); i-- > 0; )
+	{
+		result = ( path [ i ].childIndex + result ) / widths [ i ];
+	}
+
+	*fraction = ( result > 1.0 ) ? 1.0 : result;
+	return true;
+}	// bool BTree::GetFraction
+
+}	// namespace BtrieveEngine
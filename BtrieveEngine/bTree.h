@@ -0,0 +1,188 @@
+// bTree.h : On-disk B+tree indexes for the in-process engine.
+//
+// Every index is a B+tree of fixed length entries. Leaf entries hold the
+// key and the cursor position of the record; internal entries add the
+// child page whose subtree starts at that entry. Entries with equal keys
+// are ordered by cursor position, so every entry is unique.
+//
+// Entries are compressed within a page but keep a fixed stride, so a slot
+// is still found by arithmetic. A leaf stores the key bytes all of its
+// entries share once, after the header, and each entry holds only the rest
+// of its key. An internal node drops the zero bytes all of its separators
+// end with; where memcmp orders the keys, separators are cut short so that
+// they end with zeros. Pages with neither read as they always have.
+//
+// Where the stored part of a node's keys is an integer, or at most eight
+// bytes that memcmp orders, a search reads each key it looks at as one
+// unsigned integer in index order instead of calling the comparator. It
+// bisects without branches, fetching the entries either next step may
+// look at, until the entries left fit in ENGINE_NODE_SCAN_BYTES, about
+// two cache lines, then counts those entries in one pass.
+//
+
+#ifndef _BTRIEVE_ENGINE_BTREE_H
+#define _BTRIEVE_ENGINE_BTREE_H
+
+#include <stdint.h>
+
+#include <vector>
+
+#include <btrieveC.h>
+
+#include "keys.h"
+#include "pager.h"
+
+namespace BtrieveEngine
+{
+
+class EntryMerger;
+class SharedFile;
+struct NodeOrdinals;
+
+#pragma pack(1)
+typedef struct {
+	uint32_t pageType;
+	uint32_t next;
+	uint32_t previous;
+	uint16_t count;
+	uint16_t level;														// Zero for leaves.
+	uint32_t leftChild;													// Internal nodes only.
+	uint16_t prefixLength;												// Leaves: the key bytes every entry shares.
+	uint16_t trimmedLength;												// Internal nodes: the zero bytes every separator ends with.
+} NodeHeader;
+#pragma pack()
+
+#define ENGINE_ADDRESS_LENGTH 8
+#define ENGINE_CHILD_LENGTH 4
+#define ENGINE_MINIMUM_NODE_ENTRIES 4
+#define ENGINE_NODE_SCAN_BYTES 128
+
+// How a search treats entries whose key equals the search key.
+enum AddressMode
+{
+	ADDRESS_MODE_LOWEST,												// Before every equal key.
+	ADDRESS_MODE_EXACT,													// Ordered by the given cursor position.
+	ADDRESS_MODE_HIGHEST												// After every equal key.
+};	// enum AddressMode
+
+// An entry in a leaf. A page of zero is the position past either end.
+struct TreePosition
+{
+	uint32_t page;
+	uint32_t slot;
+};	// struct TreePosition
+
+
+class BTree
+{
+	friend class BTreeSeeker;
+
+public:
+	BTree ( SharedFile* file, IndexDefinition* definition );
+
+	// Return the status code for a key of this length with the page size.
+	static btrieve_status_code_t CheckCapacity ( uint32_t pageSize, int keyLength );
+
+	btrieve_status_code_t Initialize ( );
+	btrieve_status_code_t Insert ( const uint8_t* key, uint64_t address );
+	btrieve_status_code_t Remove ( const uint8_t* key, uint64_t address );
+	btrieve_status_code_t Drop ( );
+
+	// Build a newly initialized tree from the leaves up, from entries in
+	// order. Leaves are packed full; each internal level spreads its
+	// children evenly. A unique index fails on the first repeated key.
+	btrieve_status_code_t Load ( EntryMerger* merger, bool unique );
+
+	// Positioning. These return false on an I/O error.
+	bool LowerBound ( const uint8_t* key, uint64_t address, AddressMode mode, TreePosition* position );
+	bool First ( TreePosition* position );
+	bool Last ( TreePosition* position );
+	bool Next ( TreePosition* position );
+	bool Previous ( TreePosition* position );
+	bool ReadEntry ( const TreePosition& position, uint8_t* key, uint64_t* address );
+
+	// Approximate positioning by fraction of the entries.
+	bool SeekFraction ( double fraction, TreePosition* position );
+	bool GetFraction ( const uint8_t* key, uint64_t address, double* fraction );
+
+	// The entries a leaf holds when they share no prefix.
+	uint32_t GetLeafCapacity ( ) const { return LeafCapacity ( 0 ); }
+
+private:
+	struct PathStep
+	{
+		uint32_t page;
+		uint32_t childIndex;											// Zero for leftChild, else entry childIndex - 1.
+	};	// struct PathStep
+
+	uint32_t LeafCapacity ( uint32_t prefixLength ) const;
+	uint32_t InternalCapacity ( uint32_t trimmedLength ) const;
+	uint8_t* LeafEntry ( uint8_t* node, uint32_t slot ) const;
+	uint8_t* InternalEntry ( uint8_t* node, uint32_t slot ) const;
+	uint32_t InternalChild ( uint8_t* node, uint32_t childIndex ) const;
+	void CopyLeafEntry ( uint8_t* node, uint32_t slot, uint8_t* entry ) const;
+	void CopyInternalEntry ( uint8_t* node, uint32_t slot, uint8_t* entry ) const;
+	uint32_t SharedPrefix ( const uint8_t* entries, uint32_t count ) const;
+	uint32_t TrailingZeros ( const uint8_t* key ) const;
+	uint32_t SharedTrim ( const uint8_t* entries, uint32_t count ) const;
+	bool LeafFits ( const uint8_t* entries, uint32_t count ) const;
+	bool InternalFits ( const uint8_t* entries, uint32_t count ) const;
+	void PackLeaf ( uint8_t* node, const uint8_t* entries, uint32_t count ) const;
+	void PackInternal ( uint8_t* node, const uint8_t* entries, uint32_t count ) const;
+	uint32_t ChooseLeafSplit ( const uint8_t* entries, uint32_t total, uint32_t preferred, uint32_t slot ) const;
+	size_t FillInternal ( const std::vector<uint8_t>& separators, size_t first, size_t children, size_t limit ) const;
+	void MakeSeparator ( const uint8_t* left, const uint8_t* right, uint8_t* separator ) const;
+	int CompareEntry ( const uint8_t* entry, const uint8_t* key, uint64_t address, AddressMode mode ) const;
+	int CompareLeafEntry ( uint8_t* node, uint32_t slot, const uint8_t* key, uint64_t address, AddressMode mode ) const;
+	bool ReadOrdinals ( uint8_t* node, const uint8_t* key, NodeOrdinals* ordinals ) const;
+	uint32_t SearchLeaf ( uint8_t* node, const uint8_t* key, uint64_t address, AddressMode mode ) const;
+	uint32_t SearchInternal ( uint8_t* node, const uint8_t* key, uint64_t address, AddressMode mode ) const;
+	bool Descend ( const uint8_t* key, uint64_t address, AddressMode mode, std::vector<PathStep>* path );
+	btrieve_status_code_t InsertIntoParent ( std::vector<PathStep>* path, size_t level, const uint8_t* separator, uint32_t rightPage );
+	btrieve_status_code_t RemoveFromParent ( std::vector<PathStep>* path, size_t level );
+	btrieve_status_code_t DropSubtree ( uint32_t page );
+
+	SharedFile* file;
+	IndexDefinition* definition;
+	uint32_t pageSize;
+	uint32_t keyLength;
+	uint32_t leafStride;												// A whole leaf entry.
+	uint32_t internalStride;											// A whole internal entry.
+	bool byteOrdered;
+	uint32_t integerWidth;												// Zero unless the comparator reads keys as integers.
+	uint64_t integerFlip;												// Turns an integer key into an unsigned one in index order.
+};	// class BTree
+
+
+// Lower bound searches for a run of keys in ascending index order. The
+// leaf each search ends in stays pinned; the next search looks there, and
+// in the leaf after it, before descending from the root, so keys that
+// share leaves share page reads.
+class BTreeSeeker
+{
+public:
+	explicit BTreeSeeker ( BTree* tree );
+
+	// Point entry at a copy of the first leaf entry whose key is at least
+	// the key, or at NULL if there's none; it stays valid until the next Seek.
+	// Returns false on an I/O error.
+	bool Seek ( const uint8_t* key, const uint8_t** entry );
+
+	// The index pages read so far, counting each pinned leaf once.
+	uint64_t GetPageReadCount ( ) const { return pageReads; }
+
+private:
+	bool Pin ( uint32_t pageNumber );
+	bool Settle ( const uint8_t* key, const uint8_t** entry );
+	bool LeafHolds ( const uint8_t* key );
+
+	BTree* tree;
+	PageHandle leaf;
+	bool peekNext;														// Whether the last search past the leaf found the key in the next one.
+	uint64_t pageReads;
+	uint8_t current [ BTRIEVE_MAXIMUM_KEY_LENGTH + ENGINE_ADDRESS_LENGTH ];
+};	// class BTreeSeeker
+
+}	// namespace BtrieveEngine
+
+#endif
@@ -0,0 +1,157 @@
+// bloomFilter.cpp : Blocked Bloom filters over the keys of an index.
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <new>
+
+#include "bloomFilter.h"
+
+namespace BtrieveEngine
+{
+
+int GetBloomBitsPerKey ( )
+{
+	const char* setting = getenv ( "BTRIEVE_ENGINE_BLOOM_BITS" );
+	char* end;
+	long bits;
+
+	// If there's no setting.
+	if ( setting == NULL || *setting == '\0' )
+	{
+		return ENGINE_DEFAULT_BLOOM_BITS_PER_KEY;
+	}
+
+	bits = strtol ( setting, &end, 10 );
+
+	// If the setting isn't a number.
+	if ( *end != '\0' || bits < 0 )
+	{
+		return ENGINE_DEFAULT_BLOOM_BITS_PER_KEY;
+	}
+
+	return ( bits > ENGINE_BLOOM_MAXIMUM_BITS_PER_KEY ) ? ENGINE_BLOOM_MAXIMUM_BITS_PER_KEY : ( int ) bits;
+}	// int GetBloomBitsPerKey
+
+
+BloomFilter::BloomFilter ( )
+	: blockCount ( 0 ),
+	  capacity ( 0 ),
+	  keyCount ( 0 ),
+	  setBitCount ( 0 )
+{
+}	// BloomFilter::BloomFilter
+
+
+bool BloomFilter::Allocate ( uint64_t expectedKeys, int bitsPerKey )
+{
+	uint64_t bits = expectedKeys * ( uint64_t ) bitsPerKey;
+
+	blockCount = ( bits + ENGINE_BLOOM_BLOCK_WORDS * 64 - 1 ) / ( ENGINE_BLOOM_BLOCK_WORDS * 64 );
+
+	// If the filter would be empty.
+	if ( blockCount == 0 )
+	{
+		blockCount = 1;
+	}
+
+	blocks.reset ( new ( std::nothrow ) uint64_t [ blockCount * ENGINE_BLOOM_BLOCK_WORDS ] );
+
+	// If new fails.
+	if ( !blocks )
+	{
+		blockCount = 0;
+		return false;
+	}
+
+	memset ( blocks.get ( ), 0, blockCount * ENGINE_BLOOM_BLOCK_WORDS * sizeof ( uint64_t ) );
+
+	capacity = expectedKeys;
+	keyCount = 0;
+	setBitCount = 0;
+	return true;
+}	// bool BloomFilter::Allocate
+
+
+// The high half of the hash picks the block, without a division.
+const uint64_t* BloomFilter::FindBlock ( uint64_t hash ) const
+{
+	uint64_t block = ( ( hash >> 32 ) * blockCount ) >> 32;
+
+	return &blocks [ block * ENGINE_BLOOM_BLOCK_WORDS ];
+}	// const uint64_t* BloomFilter::FindBlock
+
+
+// The low half of the hash picks the bits within the block: a start and
+// an odd step, so the probes are distinct bits.
+void BloomFilter::Add ( uint64_t hash )
+{
+	uint64_t* block = ( uint64_t* ) FindBlock ( hash );
+	uint32_t probe = ( uint32_t ) hash;
+	uint32_t step = ( ( uint32_t ) hash >> 16 ) | 1;
+
+	for ( int i = 0; i < ENGINE_BLOOM_PROBES; i++, probe += step )
+	{
+		uint32_t bit = probe & 511;
+		uint64_t mask = ( uint64_t ) 1 << ( bit & 63 );
+
+		// If the bit is newly set.
+		if ( ( block [ bit >> 6 ] & mask ) == 0 )
+		{
+			block [ bit >> 6 ] |= mask;
+			setBitCount++;
+		}
+	}
+
+	keyCount++;
+}	// void BloomFilter::Add
+
+
+bool BloomFilter::MayContain ( uint64_t hash ) const
+{
+	const uint64_t* block = FindBlock ( hash );
+	uint32_t probe = ( uint32_t ) hash;
+	uint32_t step = ( ( uint32_t ) hash >> 16 ) | 1;
+	uint64_t missing = 0;
+
+	for ( int i = 0; i < ENGINE_BLOOM_PROBES; i++, probe += step )
+	{
+		uint32_t bit = probe & 511;
+
+		missing |= ~block [ bit >> 6 ] & ( ( uint64_t ) 1 << ( bit & 63 ) );
+	}
+
+	return missing == 0;
+}	// bool BloomFilter::MayContain
+
+
+void BloomFilter::Merge ( const BloomFilter& other )
+{
+	uint64_t words = blockCount * ENGINE_BLOOM_BLOCK_WORDS;
+
+	setBitCount = 0;
+
+	for ( uint64_t i = 0; i < words; i++ )
+	{
+		blocks [ i ] |= other.blocks [ i ];
+		setBitCount += ( uint64_t ) __builtin_popcountll ( blocks [ i ] );
+	}
+
+	keyCount += other.keyCount;
+}	// void BloomFilter::Merge
+
+
+double BloomFilter::GetEstimatedFalsePositiveRate ( ) const
+{
+	// If there are no bits.
+	if ( blockCount == 0 )
+	{
+		return 1.0;
+	}
+
+	return pow ( ( double ) setBitCount / ( double ) GetBitCount ( ), ENGINE_BLOOM_PROBES );
+}	// double BloomFilter::GetEstimatedFalsePositiveRate
+
+}	// namespace BtrieveEngine
@@ -0,0 +1,109 @@
+// bloomFilter.h : Blocked Bloom filters over the keys of an index, which
+//                 let an equal key search answer for a missing key without
+//                 reading index pages.
+//
+// A filter is an array of 512 bit blocks, each a cache line. A key's hash
+// picks a block and ENGINE_BLOOM_PROBES bits within it, so adding or
+// testing a key touches one cache line. Filters are kept in memory only:
+// one is built when an index is created, or by the first equal search of
+// an index that has none, and keys are added to it as records are created
+// and updated. Bits are never cleared, so removed keys only make a filter
+// less selective; once enough keys have been removed, or many more added
+// than it was sized for, it's dropped and the next search rebuilds it.
+//
+
+#ifndef _BTRIEVE_ENGINE_BLOOMFILTER_H
+#define _BTRIEVE_ENGINE_BLOOMFILTER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_DEFAULT_BLOOM_BITS_PER_KEY 10
+#define ENGINE_BLOOM_MAXIMUM_BITS_PER_KEY 64
+#define ENGINE_BLOOM_BLOCK_WORDS 8
+#define ENGINE_BLOOM_PROBES 6
+// Indexes with fewer entries than this aren't filtered; their trees are a
+// page or two deep, which a filter saves little of.
+#define ENGINE_BLOOM_MINIMUM_ENTRIES 1024
+// A filter is dropped once the keys added since it was sized exceed its
+// sizing by this factor, or the keys removed exceed half its sizing.
+#define ENGINE_BLOOM_GROWTH_FACTOR 2
+
+// Return the bits per key of new filters: BTRIEVE_ENGINE_BLOOM_BITS from
+// the environment if it's set, else ENGINE_DEFAULT_BLOOM_BITS_PER_KEY.
+// Zero turns the filters off.
+int GetBloomBitsPerKey ( );
+
+
+class BloomFilter
+{
+public:
+	BloomFilter ( );
+
+	// Size the filter for a number of keys; false if there's no memory.
+	bool Allocate ( uint64_t expectedKeys, int bitsPerKey );
+
+	void Add ( uint64_t hash );
+
+	// Return false if no key with the hash was added.
+	bool MayContain ( uint64_t hash ) const;
+
+	// Add the keys of a filter sized the same, as a parallel build does
+	// with the filter of each thread.
+	void Merge ( const BloomFilter& other );
+
+	uint64_t GetKeyCount ( ) const { return keyCount; }
+	uint64_t GetCapacity ( ) const { return capacity; }
+	uint64_t GetBitCount ( ) const { return blockCount * ENGINE_BLOOM_BLOCK_WORDS * 64; }
+
+	// Estimate the chance a missing key passes from how full the blocks are.
+	double GetEstimatedFalsePositiveRate ( ) const;
+
+private:
+	const uint64_t* FindBlock ( uint64_t hash ) const;
+
+	std::unique_ptr<uint64_t [ ]> blocks;
+	uint64_t blockCount;
+	uint64_t capacity;
+	uint64_t keyCount;
+	uint64_t setBitCount;
+};	// class BloomFilter
+
+
+struct BloomFilterStatistics
+{
+	bool enabled;
+	uint64_t keyCount;
+	uint64_t bitCount;
+	uint64_t lookupCount;
+	uint64_t negativeCount;
+	uint64_t falsePositiveCount;
+	double estimatedFalsePositiveRate;
+};	// struct BloomFilterStatistics
+
+
+// The filter of one index of a shared file and its counters. Readers load
+// the filter with the file's latch shared; only writers, which hold it
+// exclusively, replace or drop it, so a loaded filter outlives the read.
+struct IndexBloomFilter
+{
+	IndexBloomFilter ( ) : filter ( NULL ), unfilterable ( false ), removedCount ( 0 ), lookupCount ( 0 ), negativeCount ( 0 ), falsePositiveCount ( 0 ) { }
+	~IndexBloomFilter ( ) { delete filter.load ( ); }
+
+	std::atomic<BloomFilter*> filter;
+	std::atomic<bool> unfilterable;										// A key can't be hashed; set until the index is recreated.
+	uint64_t removedCount;
+	std::atomic<uint64_t> lookupCount;
+	std::atomic<uint64_t> negativeCount;								// Lookups the filter answered.
+	std::atomic<uint64_t> falsePositiveCount;							// Lookups it passed that found nothing.
+};	// struct IndexBloomFilter
+
+}	// namespace BtrieveEngine
+
+#endif
@@ -0,0 +1,1666 @@
+// btrieveC.cpp : The client, attribute, key segment, version and timestamp
+//                entry points of the btrieveC.h interface.
+//
+
+#include <errno.h>
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <new>
+
+#include "engine.h"
+
+using namespace BtrieveEngine;
+
+#define ENGINE_CLIENT_VERSION_NUMBER 13
+#define ENGINE_CLIENT_REVISION_NUMBER 0
+
+// Timestamps count 100 nanosecond units from 0001-01-01; the Unix epoch is 62135596800 seconds later.
+#define ENGINE_UNIX_EPOCH_MICROSECONDS 62135596800000000LL
+
+
+static std::string WideToUtf8 ( const wchar_t* wide )
+{
+	std::string text;
+
+	for ( ; wide != NULL && *wide != L'\0'; wide++ )
+	{
+		uint32_t code = ( uint32_t ) *wide;
+
+		// Encode the code point in one to four bytes.
+		if ( code < 0x80 )
+		{
+			text += ( char ) code;
+		}
+		else if ( code < 0x800 )
+		{
+			text += ( char ) ( 0xC0 | ( code >> 6 ) );
+			text += ( char ) ( 0x80 | ( code & 0x3F ) );
+		}
+		else if ( code < 0x10000 )
+		{
+			text += ( char ) ( 0xE0 | ( code >> 12 ) );
+			text += ( char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+			text += ( char ) ( 0x80 | ( code & 0x3F ) );
+		}
+		else
+		{
+			text += ( char ) ( 0xF0 | ( ( code >> 18 ) & 0x07 ) );
+			text += ( char ) ( 0x80 | ( ( code >> 12 ) & 0x3F ) );
+			text += ( char ) ( 0x80 | ( ( code >> 6 ) & 0x3F ) );
+			text += ( char ) ( 0x80 | ( code & 0x3F ) );
+		}
+	}	// for ( ; wide != NULL && *wide != L'\0'; wide++ )
+
+	return text;
+}	// static std::string WideToUtf8
+
+
+static std::wstring Utf8ToWide ( const std::string& text )
+{
+	std::wstring wide;
+
+	for ( size_t i = 0; i < text.size ( ); )
+	{
+		uint8_t lead = ( uint8_t ) text [ i ];
+		int extra = ( lead >= 0xF0 ) ? 3 : ( lead >= 0xE0 ) ? 2 : ( lead >= 0xC0 ) ? 1 : 0;
+		uint32_t code = ( extra == 0 ) ? lead : ( lead & ( 0x3F >> extra ) );
+
+		for ( i++; extra > 0 && i < text.size ( ); extra--, i++ )
+		{
+			code = ( code << 6 ) | ( ( uint8_t ) text [ i ] & 0x3F );
+		}
+
+		wide += ( wchar_t ) code;
+	}	// for ( size_t i = 0; i < text.size ( ); )
+
+	return wide;
+}	// static std::wstring Utf8ToWide
+
+
+static btrieve_status_code_t SetClientStatus ( btrieve_client* client, btrieve_status_code_t status )
+{
+	client->lastStatusCode = status;
+	return status;
+}	// static btrieve_status_code_t SetClientStatus
+
+
+// Resolve a file name against the client's current directory.
+static btrieve_status_code_t ResolvePath ( btrieve_client* client, const char* fileName, std::string* path )
+{
+	char resolved [ PATH_MAX ];
+
+	// If there's no file name.
+	if ( fileName == NULL || *fileName == '\0' )
+	{
+		return BTRIEVE_STATUS_CODE_FILENAME_BAD;
+	}
+
+	// If the name is relative to the current directory.
+	if ( *fileName != '/' && !client->currentDirectory.empty ( ) )
+	{
+		*path = client->currentDirectory + "/" + fileName;
+	}
+	else
+	{
+		*path = fileName;
+	}
+
+	// If the file exists, key it by its canonical path so every handle shares one SharedFile.
+	if ( realpath ( path->c_str ( ), resolved ) != NULL )
+	{
+		*path = resolved;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// static btrieve_status_code_t ResolvePath
+
+
+// Close a handle's hold on its shared file, closing the file with its last handle.
+static btrieve_status_code_t ReleaseFile ( btrieve_file* file )
+{
+	btrieve_status_code_t status = BTRIEVE_STATUS_CODE_NO_ERROR;
+	std::lock_guard<std::mutex> registryGuard ( GetRegistryMutex ( ) );
+	std::shared_ptr<SharedFile> shared = file->shared;
+
+	// If the handle was already released.
+	if ( shared == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( shared->latch );
+
+	InvalidateRecordView ( file );
+	shared->handleCount--;
+
+	// If the handle opened the file exclusively.
+	if ( file->openMode == BTRIEVE_OPEN_MODE_EXCLUSIVE )
+	{
+		shared->exclusiveCount--;
+	}
+
+	// If this was the last handle.
+	if ( shared->handleCount == 0 )
+	{
+		status = shared->Close ( );
+		UnregisterSharedFile ( shared );
+	}
+
+	file->shared.reset ( );
+	return status;
+}	// static btrieve_status_code_t ReleaseFile
+
+
+// End the client's transaction on every file it joined.
+static void FinishTransaction ( btrieve_client* client, bool commit )
+{
+	for ( size_t i = 0; i < client->transactionFiles.size ( ); i++ )
+	{
+		SharedFile* shared = client->transactionFiles [ i ].get ( );
+		std::unique_lock<std::shared_mutex> guard ( shared->latch );
+
+		// If the client still holds the file's transaction.
+		if ( shared->IsTransactionOwner ( client ) )
+		{
+			if ( commit )
+			{
+				shared->CommitTransaction ( );
+			}
+			else
+			{
+				shared->AbortTransaction ( );
+			}
+		}
+	}	// for ( size_t i = 0; i < client->transactionFiles.size ( ); i++ )
+
+	client->transactionFiles.clear ( );
+	client->transactionActive = false;
+}	// static void FinishTransaction
+
+
+// Close every file the client has open. The handles stay allocated but
+// report FILE_NOT_OPEN until BtrieveClientFileClose frees them.
+static btrieve_status_code_t CloseClientFiles ( btrieve_client* client )
+{
+	btrieve_status_code_t status = BTRIEVE_STATUS_CODE_NO_ERROR;
+
+	// If a transaction is active, it's abandoned.
+	if ( client->transactionActive )
+	{
+		FinishTransaction ( client, false );
+	}
+
+	for ( size_t i = 0; i < client->files.size ( ); i++ )
+	{
+		btrieve_status_code_t closeStatus = ReleaseFile ( client->files [ i ] );
+
+		// If this is the first failure.
+		if ( status == BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			status = closeStatus;
+		}
+
+		client->files [ i ]->client = NULL;
+	}	// for ( size_t i = 0; i < client->files.size ( ); i++ )
+
+	client->files.clear ( );
+	return status;
+}	// static btrieve_status_code_t CloseClientFiles
+
+
+btrieve_status_code_t BtrieveClientAllocate ( btrieve_client_t* btrieveClientPtr, int serviceAgentIdentifier, int clientIdentifier )
+{
+	btrieve_client* client;
+
+	// If there's nowhere to return the client.
+	if ( btrieveClientPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( client = new ( std::nothrow ) btrieve_client ( ) ) == NULL )
+	{
+		*btrieveClientPtr = NULL;
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	client->serviceAgentIdentifier = serviceAgentIdentifier;
+	client->clientIdentifier = clientIdentifier;
+	client->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	client->transactionActive = false;
+	*btrieveClientPtr = client;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveClientAllocate
+
+
+btrieve_status_code_t BtrieveClientFree ( btrieve_client_t client )
+{
+	btrieve_status_code_t status;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	status = CloseClientFiles ( client );
+	delete client;
+	return status;
+}	// btrieve_status_code_t BtrieveClientFree
+
+
+int BtrieveClientGetServiceAgentIdentifier ( btrieve_client_t client )
+{
+	return ( client == NULL ) ? -1 : client->serviceAgentIdentifier;
+}	// int BtrieveClientGetServiceAgentIdentifier
+
+
+int BtrieveClientGetClientIdentifier ( btrieve_client_t client )
+{
+	return ( client == NULL ) ? -1 : client->clientIdentifier;
+}	// int BtrieveClientGetClientIdentifier
+
+
+btrieve_status_code_t BtrieveClientGetLastStatusCode ( btrieve_client_t client )
+{
+	return ( client == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : client->lastStatusCode;
+}	// btrieve_status_code_t BtrieveClientGetLastStatusCode
+
+
+btrieve_status_code_t BtrieveClientFileCreate ( btrieve_client_t client, const btrieve_file_attributes_t fileAttributes, const btrieve_index_attributes_t indexAttributes, const char* fileName, btrieve_create_mode_t createMode, btrieve_location_mode_t locationMode )
+{
+	std::string path;
+	btrieve_status_code_t status;
+
+	( void ) locationMode;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If there are no file attributes.
+	if ( fileAttributes == NULL )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	// If ResolvePath ( ) fails.
+	if ( ( status = ResolvePath ( client, fileName, &path ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetClientStatus ( client, status );
+	}
+
+	std::lock_guard<std::mutex> registryGuard ( GetRegistryMutex ( ) );
+
+	// If the file is open; it can't be replaced underneath its handles.
+	if ( FindSharedFile ( path ) != NULL )
+	{
+		return SetClientStatus ( client, ( createMode == BTRIEVE_CREATE_MODE_OVERWRITE ) ? BTRIEVE_STATUS_CODE_FILE_INUSE : BTRIEVE_STATUS_CODE_FILE_ALREADY_EXISTS );
+	}
+
+	status = SharedFile::Create (
+		path,
+		fileAttributes->settings,
+		( indexAttributes == NULL ) ? NULL : &indexAttributes->definition,
+		createMode == BTRIEVE_CREATE_MODE_OVERWRITE );
+	return SetClientStatus ( client, status );
+}	// btrieve_status_code_t BtrieveClientFileCreate
+
+
+btrieve_status_code_t BtrieveClientFileCreateW ( btrieve_client_t client, const btrieve_file_attributes_t fileAttributes, const btrieve_index_attributes_t indexAttributes, const wchar_t* fileName, btrieve_create_mode_t createMode, btrieve_location_mode_t locationMode )
+{
+	return BtrieveClientFileCreate ( client, fileAttributes, indexAttributes, WideToUtf8 ( fileName ).c_str ( ), createMode, locationMode );
+}	// btrieve_status_code_t BtrieveClientFileCreateW
+
+
+// Compare the owner name given at open with the file's owner.
+static btrieve_status_code_t CheckOwner ( const FileHeader& header, const char* ownerName, btrieve_open_mode_t* openMode )
+{
+	// If the file has no owner, or the owner name matches.
+	if ( header.ownerMode == BTRIEVE_OWNER_MODE_NONE
+		|| ( ownerName != NULL && strncmp ( ownerName, header.ownerName, ENGINE_OWNER_NAME_LENGTH ) == 0 ) )
+	{
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// If the owner allows reading without the name.
+	if ( header.ownerMode == BTRIEVE_OWNER_MODE_NO_ENCRYPTION_READ_ALLOWED
+		|| header.ownerMode == BTRIEVE_OWNER_MODE_ENCRYPTION_READ_ALLOWED )
+	{
+		*openMode = BTRIEVE_OPEN_MODE_READ_ONLY;
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	return BTRIEVE_STATUS_CODE_INVALID_OWNER;
+}	// static btrieve_status_code_t CheckOwner
+
+
+btrieve_status_code_t BtrieveClientFileOpen ( btrieve_client_t client, btrieve_file_t* btrieveFilePtr, const char* fileName, const char* ownerName, btrieve_open_mode_t openMode, btrieve_location_mode_t locationMode )
+{
+	std::shared_ptr<SharedFile> shared;
+	std::string path;
+	btrieve_file* file;
+	btrieve_status_code_t status;
+
+	( void ) locationMode;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If there's nowhere to return the file.
+	if ( btrieveFilePtr == NULL )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	// If ResolvePath ( ) fails.
+	if ( ( status = ResolvePath ( client, fileName, &path ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetClientStatus ( client, status );
+	}
+
+	std::lock_guard<std::mutex> registryGuard ( GetRegistryMutex ( ) );
+
+	// If the file isn't open yet, open it.
+	if ( ( shared = FindSharedFile ( path ) ) == NULL )
+	{
+		shared = std::make_shared<SharedFile> ( );
+		status = shared->Open ( path, openMode == BTRIEVE_OPEN_MODE_READ_ONLY );
+
+		// If the file can only be read.
+		if ( status == BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED && openMode != BTRIEVE_OPEN_MODE_READ_ONLY )
+		{
+			shared = std::make_shared<SharedFile> ( );
+			status = shared->Open ( path, true );
+		}
+
+		// If Open ( ) fails.
+		if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return SetClientStatus ( client, status );
+		}
+
+		RegisterSharedFile ( shared );
+	}	// if ( ( shared = FindSharedFile ( path ) ) == NULL )
+
+	std::unique_lock<std::shared_mutex> guard ( shared->latch );
+
+	// If an exclusive handle conflicts with the other handles.
+	if ( shared->exclusiveCount > 0 || ( openMode == BTRIEVE_OPEN_MODE_EXCLUSIVE && shared->handleCount > 0 ) )
+	{
+		status = BTRIEVE_STATUS_CODE_INCOMPATIBLE_MODE_ERROR;
+	}
+	else
+	{
+		status = CheckOwner ( shared->header, ownerName, &openMode );
+	}
+
+	// If the file was opened for readers only and this handle may write.
+	if ( status == BTRIEVE_STATUS_CODE_NO_ERROR && shared->readOnly && openMode != BTRIEVE_OPEN_MODE_READ_ONLY )
+	{
+		status = shared->ReopenForWriting ( );
+
+		// If the file can only be read, it stays read-only, as it would have been opened.
+		if ( status == BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED )
+		{
+			status = BTRIEVE_STATUS_CODE_NO_ERROR;
+		}
+	}
+
+	// If the handle can't be opened.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		// If no other handle holds the file, close it again.
+		if ( shared->handleCount == 0 )
+		{
+			shared->Close ( );
+			UnregisterSharedFile ( shared );
+		}
+
+		return SetClientStatus ( client, status );
+	}
+
+	// If new fails.
+	if ( ( file = new ( std::nothrow ) btrieve_file ( ) ) == NULL )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL );
+	}
+
+	shared->handleCount++;
+
+	// If the handle is exclusive.
+	if ( openMode == BTRIEVE_OPEN_MODE_EXCLUSIVE )
+	{
+		shared->exclusiveCount++;
+	}
+
+	file->client = client;
+	file->shared = shared;
+	file->openMode = openMode;
+	file->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	file->cursor.established = false;
+	file->cursor.index = BTRIEVE_INDEX_NONE;
+	file->cursor.address = 0;
+	file->cursor.recordLoaded = false;
+	file->cursor.hint.page = 0;
+	file->cursor.hint.slot = 0;
+	file->cursor.hintStamp = 0;
+	file->cursor.currentOffset = -1;
+	file->viewGeneration = 1;
+	file->checkViews = IsRecordViewChecking ( );
+	client->files.push_back ( file );
+	*btrieveFilePtr = file;
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientFileOpen
+
+
+btrieve_status_code_t BtrieveClientFileOpenW ( btrieve_client_t client, btrieve_file_t* btrieveFilePtr, const wchar_t* fileName, const char* ownerName, btrieve_open_mode_t openMode, btrieve_location_mode_t locationMode )
+{
+	return BtrieveClientFileOpen ( client, btrieveFilePtr, WideToUtf8 ( fileName ).c_str ( ), ownerName, openMode, locationMode );
+}	// btrieve_status_code_t BtrieveClientFileOpenW
+
+
+btrieve_status_code_t BtrieveClientFileClose ( btrieve_client_t client, btrieve_file_t file )
+{
+	btrieve_status_code_t status;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If there's no file.
+	if ( file == NULL )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_FILE_NOT_OPEN );
+	}
+
+	// If the file's client was freed, only the handle remains.
+	if ( file->client == NULL )
+	{
+		delete file;
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+	}
+
+	// If the file belongs to another client.
+	if ( file->client != client )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_FILE_NOT_OPEN );
+	}
+
+	for ( size_t i = 0; i < client->files.size ( ); i++ )
+	{
+		// If this is the file.
+		if ( client->files [ i ] == file )
+		{
+			client->files.erase ( client->files.begin ( ) + i );
+			break;
+		}
+	}	// for ( size_t i = 0; i < client->files.size ( ); i++ )
+
+	status = ReleaseFile ( file );
+	delete file;
+	return SetClientStatus ( client, status );
+}	// btrieve_status_code_t BtrieveClientFileClose
+
+
+btrieve_status_code_t BtrieveClientFileDelete ( btrieve_client_t client, const char* fileName )
+{
+	std::string path;
+	btrieve_status_code_t status;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If ResolvePath ( ) fails.
+	if ( ( status = ResolvePath ( client, fileName, &path ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetClientStatus ( client, status );
+	}
+
+	std::lock_guard<std::mutex> registryGuard ( GetRegistryMutex ( ) );
+
+	// If the file is open.
+	if ( FindSharedFile ( path ) != NULL )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_FILE_INUSE );
+	}
+
+	// If unlink ( ) fails.
+	if ( unlink ( path.c_str ( ) ) != 0 )
+	{
+		return SetClientStatus ( client, ( errno == ENOENT ) ? BTRIEVE_STATUS_CODE_FILE_NOT_FOUND : ( errno == EACCES || errno == EPERM ) ? BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED : BTRIEVE_STATUS_CODE_IO_ERROR );
+	}
+
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientFileDelete
+
+
+btrieve_status_code_t BtrieveClientFileDeleteW ( btrieve_client_t client, const wchar_t* fileName )
+{
+	return BtrieveClientFileDelete ( client, WideToUtf8 ( fileName ).c_str ( ) );
+}	// btrieve_status_code_t BtrieveClientFileDeleteW
+
+
+btrieve_status_code_t BtrieveClientFileRename ( btrieve_client_t client, const char* existingFileName, const char* newFileName )
+{
+	std::string existingPath;
+	std::string newPath;
+	btrieve_status_code_t status;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If either name can't be resolved.
+	if ( ( status = ResolvePath ( client, existingFileName, &existingPath ) ) != BTRIEVE_STATUS_CODE_NO_ERROR
+		|| ( status = ResolvePath ( client, newFileName, &newPath ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetClientStatus ( client, status );
+	}
+
+	std::lock_guard<std::mutex> registryGuard ( GetRegistryMutex ( ) );
+
+	// If the file is open.
+	if ( FindSharedFile ( existingPath ) != NULL )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_FILE_INUSE );
+	}
+
+	// If the new name is taken.
+	if ( access ( newPath.c_str ( ), F_OK ) == 0 )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_FILE_ALREADY_EXISTS );
+	}
+
+	// If rename ( ) fails.
+	if ( rename ( existingPath.c_str ( ), newPath.c_str ( ) ) != 0 )
+	{
+		return SetClientStatus ( client, ( errno == ENOENT ) ? BTRIEVE_STATUS_CODE_FILE_NOT_FOUND : ( errno == EACCES || errno == EPERM ) ? BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED : BTRIEVE_STATUS_CODE_IO_ERROR );
+	}
+
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientFileRename
+
+
+btrieve_status_code_t BtrieveClientFileRenameW ( btrieve_client_t client, const wchar_t* existingFileName, const wchar_t* newFileName )
+{
+	return BtrieveClientFileRename ( client, WideToUtf8 ( existingFileName ).c_str ( ), WideToUtf8 ( newFileName ).c_str ( ) );
+}	// btrieve_status_code_t BtrieveClientFileRenameW
+
+
+btrieve_status_code_t BtrieveClientGetCurrentDirectory ( btrieve_client_t client, btrieve_disk_drive_t diskDrive, char* currentDirectory, int currentDirectorySize )
+{
+	char workingDirectory [ PATH_MAX ];
+	std::string directory;
+
+	( void ) diskDrive;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If there's nowhere to return the directory.
+	if ( currentDirectory == NULL || currentDirectorySize < 1 )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	// If no directory was set, it's the process's working directory.
+	if ( !client->currentDirectory.empty ( ) )
+	{
+		directory = client->currentDirectory;
+	}
+	else if ( getcwd ( workingDirectory, sizeof ( workingDirectory ) ) != NULL )
+	{
+		directory = workingDirectory;
+	}
+	else
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_DIRECTORY_ERROR );
+	}
+
+	// If the directory doesn't fit.
+	if ( ( int ) directory.size ( ) >= currentDirectorySize )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_DATALENGTH_ERROR );
+	}
+
+	memcpy ( currentDirectory, directory.c_str ( ), directory.size ( ) + 1 );
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientGetCurrentDirectory
+
+
+btrieve_status_code_t BtrieveClientGetCurrentDirectoryW ( btrieve_client_t client, btrieve_disk_drive_t diskDrive, wchar_t* currentDirectoryW, int currentDirectorySize )
+{
+	char directory [ PATH_MAX ];
+	std::wstring wide;
+	btrieve_status_code_t status;
+
+	// If there's nowhere to return the directory.
+	if ( client != NULL && ( currentDirectoryW == NULL || currentDirectorySize < 1 ) )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	// If BtrieveClientGetCurrentDirectory ( ) fails.
+	if ( ( status = BtrieveClientGetCurrentDirectory ( client, diskDrive, directory, sizeof ( directory ) ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	wide = Utf8ToWide ( directory );
+
+	// If the directory doesn't fit.
+	if ( ( int ) wide.size ( ) >= currentDirectorySize )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_DATALENGTH_ERROR );
+	}
+
+	memcpy ( currentDirectoryW, wide.c_str ( ), ( wide.size ( ) + 1 ) * sizeof ( wchar_t ) );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveClientGetCurrentDirectoryW
+
+
+btrieve_status_code_t BtrieveClientSetCurrentDirectory ( btrieve_client_t client, const char* currentDirectory )
+{
+	char resolved [ PATH_MAX ];
+	struct stat information;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the directory doesn't exist.
+	if ( currentDirectory == NULL
+		|| realpath ( currentDirectory, resolved ) == NULL
+		|| stat ( resolved, &information ) != 0
+		|| !S_ISDIR ( information.st_mode ) )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_DIRECTORY_ERROR );
+	}
+
+	client->currentDirectory = resolved;
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientSetCurrentDirectory
+
+
+btrieve_status_code_t BtrieveClientSetCurrentDirectoryW ( btrieve_client_t client, const wchar_t* currentDirectory )
+{
+	return BtrieveClientSetCurrentDirectory ( client, ( currentDirectory == NULL ) ? NULL : WideToUtf8 ( currentDirectory ).c_str ( ) );
+}	// btrieve_status_code_t BtrieveClientSetCurrentDirectoryW
+
+
+btrieve_status_code_t BtrieveClientGetVersion ( btrieve_client_t client, btrieve_version_t version, btrieve_file_t file )
+{
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If there's no version.
+	if ( version == NULL )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	// If the file is given but isn't open.
+	if ( file != NULL && file->shared == NULL )
+	{
+		version->lastStatusCode = BTRIEVE_STATUS_CODE_FILE_NOT_OPEN;
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_FILE_NOT_OPEN );
+	}
+
+	// The client and the engine are one library; there's no remote engine.
+	version->clientVersionNumber = ENGINE_CLIENT_VERSION_NUMBER;
+	version->clientRevisionNumber = ENGINE_CLIENT_REVISION_NUMBER;
+	version->clientVersionType = BTRIEVE_VERSION_TYPE_CLIENT_ENGINE;
+	version->localVersionNumber = ENGINE_CLIENT_VERSION_NUMBER;
+	version->localRevisionNumber = ENGINE_CLIENT_REVISION_NUMBER;
+	version->localVersionType = BTRIEVE_VERSION_TYPE_UNIX;
+	version->remoteVersionNumber = 0;
+	version->remoteRevisionNumber = 0;
+	version->remoteVersionType = BTRIEVE_VERSION_TYPE_NONE;
+	version->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientGetVersion
+
+
+btrieve_status_code_t BtrieveClientLogin ( btrieve_client_t client, const char* databaseURI )
+{
+	( void ) databaseURI;
+
+	// There's no security database; every login succeeds.
+	return ( client == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientLogin
+
+
+btrieve_status_code_t BtrieveClientLoginW ( btrieve_client_t client, const wchar_t* databaseURI )
+{
+	return BtrieveClientLogin ( client, WideToUtf8 ( databaseURI ).c_str ( ) );
+}	// btrieve_status_code_t BtrieveClientLoginW
+
+
+btrieve_status_code_t BtrieveClientLogout ( btrieve_client_t client, const char* databaseURI )
+{
+	( void ) databaseURI;
+	return ( client == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientLogout
+
+
+btrieve_status_code_t BtrieveClientLogoutW ( btrieve_client_t client, const wchar_t* databaseURI )
+{
+	return BtrieveClientLogout ( client, WideToUtf8 ( databaseURI ).c_str ( ) );
+}	// btrieve_status_code_t BtrieveClientLogoutW
+
+
+btrieve_status_code_t BtrieveClientContinuousOperationBegin ( btrieve_client_t client, const char* pathNames )
+{
+	( void ) pathNames;
+
+	// Continuous operation needs a delta file; the engine has none.
+	return ( client == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : SetClientStatus ( client, BTRIEVE_STATUS_CODE_INVALID_FUNCTION );
+}	// btrieve_status_code_t BtrieveClientContinuousOperationBegin
+
+
+btrieve_status_code_t BtrieveClientContinuousOperationBeginW ( btrieve_client_t client, const wchar_t* pathNames )
+{
+	return BtrieveClientContinuousOperationBegin ( client, WideToUtf8 ( pathNames ).c_str ( ) );
+}	// btrieve_status_code_t BtrieveClientContinuousOperationBeginW
+
+
+btrieve_status_code_t BtrieveClientContinuousOperationEnd ( btrieve_client_t client, const char* pathNames )
+{
+	( void ) pathNames;
+	return ( client == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : SetClientStatus ( client, BTRIEVE_STATUS_CODE_INVALID_FUNCTION );
+}	// btrieve_status_code_t BtrieveClientContinuousOperationEnd
+
+
+btrieve_status_code_t BtrieveClientContinuousOperationEndW ( btrieve_client_t client, const wchar_t* pathNames )
+{
+	return BtrieveClientContinuousOperationEnd ( client, WideToUtf8 ( pathNames ).c_str ( ) );
+}	// btrieve_status_code_t BtrieveClientContinuousOperationEndW
+
+
+btrieve_status_code_t BtrieveClientReset ( btrieve_client_t client )
+{
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	return SetClientStatus ( client, CloseClientFiles ( client ) );
+}	// btrieve_status_code_t BtrieveClientReset
+
+
+btrieve_status_code_t BtrieveClientStop ( btrieve_client_t client )
+{
+	return BtrieveClientReset ( client );
+}	// btrieve_status_code_t BtrieveClientStop
+
+
+btrieve_status_code_t BtrieveClientTransactionBegin ( btrieve_client_t client, btrieve_transaction_mode_t transactionMode, btrieve_lock_mode_t lockMode )
+{
+	( void ) transactionMode;
+	( void ) lockMode;
+
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If a transaction is already active.
+	if ( client->transactionActive )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_TRANSACTION_IS_ACTIVE );
+	}
+
+	// Files join the transaction as the client writes to them.
+	client->transactionActive = true;
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientTransactionBegin
+
+
+btrieve_status_code_t BtrieveClientTransactionEnd ( btrieve_client_t client )
+{
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If no transaction is active.
+	if ( !client->transactionActive )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_END_TRANSACTION_ERROR );
+	}
+
+	FinishTransaction ( client, true );
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientTransactionEnd
+
+
+btrieve_status_code_t BtrieveClientTransactionAbort ( btrieve_client_t client )
+{
+	// If there's no client.
+	if ( client == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If no transaction is active.
+	if ( !client->transactionActive )
+	{
+		return SetClientStatus ( client, BTRIEVE_STATUS_CODE_END_TRANSACTION_ERROR );
+	}
+
+	FinishTransaction ( client, false );
+	return SetClientStatus ( client, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveClientTransactionAbort
+
+
+btrieve_status_code_t BtrieveFileAttributesAllocate ( btrieve_file_attributes_t* btrieveFileAttributesPtr )
+{
+	btrieve_file_attributes* fileAttributes;
+
+	// If there's nowhere to return the attributes.
+	if ( btrieveFileAttributesPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( fileAttributes = new ( std::nothrow ) btrieve_file_attributes ( ) ) == NULL )
+	{
+		*btrieveFileAttributesPtr = NULL;
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	fileAttributes->settings.fixedRecordLength = 0;
+	fileAttributes->settings.variableLengthRecordsMode = BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_NO;
+	fileAttributes->settings.recordCompressionMode = BTRIEVE_RECORD_COMPRESSION_MODE_NONE;
+	fileAttributes->settings.fileVersion = BTRIEVE_FILE_VERSION_DEFAULT;
+	fileAttributes->settings.freeSpaceThreshold = BTRIEVE_FREE_SPACE_THRESHOLD_DEFAULT;
+	fileAttributes->settings.systemDataMode = BTRIEVE_SYSTEM_DATA_MODE_DEFAULT;
+	fileAttributes->settings.pageSize = BTRIEVE_PAGE_SIZE_DEFAULT;
+	fileAttributes->settings.pageCompression = 0;
+	fileAttributes->settings.balancedIndexes = 0;
+	fileAttributes->settings.keyOnly = 0;
+	fileAttributes->settings.preallocatedPageCount = 0;
+	fileAttributes->settings.reservedDuplicatePointerCount = 0;
+	*btrieveFileAttributesPtr = fileAttributes;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesAllocate
+
+
+btrieve_status_code_t BtrieveFileAttributesFree ( btrieve_file_attributes_t fileAttributes )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete fileAttributes;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesFree
+
+
+btrieve_status_code_t BtrieveFileAttributesSetFixedRecordLength ( btrieve_file_attributes_t fileAttributes, int fixedRecordLength )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the length is out of range.
+	if ( fixedRecordLength < 1 || fixedRecordLength > BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_RECORD_LENGTH;
+	}
+
+	fileAttributes->settings.fixedRecordLength = fixedRecordLength;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetFixedRecordLength
+
+
+btrieve_status_code_t BtrieveFileAttributesSetVariableLengthRecordsMode ( btrieve_file_attributes_t fileAttributes, btrieve_variable_length_records_mode_t variableLengthRecordsMode )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the mode is out of range.
+	if ( variableLengthRecordsMode < BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_NO || variableLengthRecordsMode > BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_YES_VARIABLE_ALLOCATION_TAILS )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_OPTION;
+	}
+
+	fileAttributes->settings.variableLengthRecordsMode = variableLengthRecordsMode;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetVariableLengthRecordsMode
+
+
+btrieve_status_code_t BtrieveFileAttributesSetRecordCompressionMode ( btrieve_file_attributes_t fileAttributes, btrieve_record_compression_mode_t recordCompressionMode )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// Records are stored uncompressed whatever the mode; the mode is kept for GetInformation.
+	fileAttributes->settings.recordCompressionMode = recordCompressionMode;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetRecordCompressionMode
+
+
+btrieve_status_code_t BtrieveFileAttributesSetFileVersion ( btrieve_file_attributes_t fileAttributes, btrieve_file_version_t fileVersion )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	fileAttributes->settings.fileVersion = fileVersion;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetFileVersion
+
+
+btrieve_status_code_t BtrieveFileAttributesSetFreeSpaceThreshold ( btrieve_file_attributes_t fileAttributes, btrieve_free_space_threshold_t freeSpaceThreshold )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	fileAttributes->settings.freeSpaceThreshold = freeSpaceThreshold;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetFreeSpaceThreshold
+
+
+btrieve_status_code_t BtrieveFileAttributesSetSystemDataMode ( btrieve_file_attributes_t fileAttributes, btrieve_system_data_mode_t systemDataMode )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	fileAttributes->settings.systemDataMode = systemDataMode;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetSystemDataMode
+
+
+btrieve_status_code_t BtrieveFileAttributesSetPageSize ( btrieve_file_attributes_t fileAttributes, btrieve_page_size_t pageSize, int enablePageCompression )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the page size isn't one of the supported sizes.
+	if ( PageSizeToBytes ( pageSize ) == 0 )
+	{
+		return BTRIEVE_STATUS_CODE_PAGE_SIZE_ERROR;
+	}
+
+	fileAttributes->settings.pageSize = pageSize;
+	fileAttributes->settings.pageCompression = enablePageCompression ? 1 : 0;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetPageSize
+
+
+btrieve_status_code_t BtrieveFileAttributesSetBalancedIndexes ( btrieve_file_attributes_t fileAttributes, int enableBalancedIndexes )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	fileAttributes->settings.balancedIndexes = enableBalancedIndexes ? 1 : 0;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetBalancedIndexes
+
+
+btrieve_status_code_t BtrieveFileAttributesSetKeyOnly ( btrieve_file_attributes_t fileAttributes, int enableKeyOnly )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	fileAttributes->settings.keyOnly = enableKeyOnly ? 1 : 0;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetKeyOnly
+
+
+btrieve_status_code_t BtrieveFileAttributesSetPreallocatedPageCount ( btrieve_file_attributes_t fileAttributes, int preallocatedPageCount )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the count is out of range.
+	if ( preallocatedPageCount < 0 || preallocatedPageCount > 65535 )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_OPTION;
+	}
+
+	fileAttributes->settings.preallocatedPageCount = preallocatedPageCount;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetPreallocatedPageCount
+
+
+btrieve_status_code_t BtrieveFileAttributesSetReservedDuplicatePointerCount ( btrieve_file_attributes_t fileAttributes, int reservedDuplicatePointerCount )
+{
+	// If there are no attributes.
+	if ( fileAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the count is out of range.
+	if ( reservedDuplicatePointerCount < 0 || reservedDuplicatePointerCount > 119 )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_OPTION;
+	}
+
+	fileAttributes->settings.reservedDuplicatePointerCount = reservedDuplicatePointerCount;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileAttributesSetReservedDuplicatePointerCount
+
+
+btrieve_status_code_t BtrieveKeySegmentAllocate ( btrieve_key_segment_t* btrieveKeySegmentPtr )
+{
+	btrieve_key_segment* keySegment;
+
+	// If there's nowhere to return the key segment.
+	if ( btrieveKeySegmentPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( keySegment = new ( std::nothrow ) btrieve_key_segment ( ) ) == NULL )
+	{
+		*btrieveKeySegmentPtr = NULL;
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	keySegment->fieldSet = false;
+	keySegment->segment.offset = 0;
+	keySegment->segment.length = 0;
+	keySegment->segment.dataType = BTRIEVE_DATA_TYPE_CHAR;
+	keySegment->segment.descending = 0;
+	keySegment->segment.nullKeyMode = BTRIEVE_NULL_KEY_MODE_NONE;
+	keySegment->segment.nullValue = 0;
+	keySegment->index = BTRIEVE_INDEX_NONE;
+	keySegment->duplicateMode = BTRIEVE_DUPLICATE_MODE_NOT_ALLOWED;
+	keySegment->modifiable = 1;
+	keySegment->acsMode = BTRIEVE_ACS_MODE_NONE;
+	keySegment->acsNumber = 0;
+	keySegment->keyContinues = 0;
+	keySegment->uniqueValueCount = 0;
+	*btrieveKeySegmentPtr = keySegment;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveKeySegmentAllocate
+
+
+btrieve_status_code_t BtrieveKeySegmentFree ( btrieve_key_segment_t keySegment )
+{
+	// If there's no key segment.
+	if ( keySegment == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete keySegment;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveKeySegmentFree
+
+
+btrieve_status_code_t BtrieveKeySegmentGetLastStatusCode ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : keySegment->lastStatusCode;
+}	// btrieve_status_code_t BtrieveKeySegmentGetLastStatusCode
+
+
+btrieve_status_code_t BtrieveKeySegmentSetField ( btrieve_key_segment_t keySegment, int offset, int length, btrieve_data_type_t dataType )
+{
+	// If there's no key segment.
+	if ( keySegment == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the field lies outside any record.
+	if ( offset < 0 || offset >= BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_KEY_POSITION;
+	}
+
+	// If the length can't be a key.
+	if ( length < 1 || length > BTRIEVE_MAXIMUM_KEY_LENGTH )
+	{
+		return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_KEYLENGTH;
+	}
+
+	// If the data type is out of range.
+	if ( dataType < BTRIEVE_DATA_TYPE_CHAR || dataType > BTRIEVE_DATA_TYPE_LEGACY_BINARY )
+	{
+		return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_KEY_TYPE_ERROR;
+	}
+
+	keySegment->segment.offset = ( uint16_t ) offset;
+	keySegment->segment.length = ( uint16_t ) length;
+	keySegment->segment.dataType = dataType;
+	keySegment->fieldSet = true;
+	return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveKeySegmentSetField
+
+
+btrieve_status_code_t BtrieveKeySegmentSetDescendingSortOrder ( btrieve_key_segment_t keySegment, int setDescendingSortOrder )
+{
+	// If there's no key segment.
+	if ( keySegment == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	keySegment->segment.descending = setDescendingSortOrder ? 1 : 0;
+	return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveKeySegmentSetDescendingSortOrder
+
+
+btrieve_status_code_t BtrieveKeySegmentSetNullKeyMode ( btrieve_key_segment_t keySegment, btrieve_null_key_mode_t nullKeyMode )
+{
+	// If there's no key segment.
+	if ( keySegment == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the mode is out of range.
+	if ( nullKeyMode < BTRIEVE_NULL_KEY_MODE_ALL_SEGMENTS || nullKeyMode > BTRIEVE_NULL_KEY_MODE_NONE )
+	{
+		return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_OPTION;
+	}
+
+	keySegment->segment.nullKeyMode = nullKeyMode;
+	return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveKeySegmentSetNullKeyMode
+
+
+btrieve_status_code_t BtrieveKeySegmentSetNullValue ( btrieve_key_segment_t keySegment, int nullValue )
+{
+	// If there's no key segment.
+	if ( keySegment == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the value isn't a byte.
+	if ( nullValue < 0 || nullValue > 255 )
+	{
+		return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_OPTION;
+	}
+
+	keySegment->segment.nullValue = ( uint8_t ) nullValue;
+	return keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveKeySegmentSetNullValue
+
+
+btrieve_acs_mode_t BtrieveKeySegmentGetACSMode ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? BTRIEVE_ACS_MODE_UNKNOWN : ( btrieve_acs_mode_t ) keySegment->acsMode;
+}	// btrieve_acs_mode_t BtrieveKeySegmentGetACSMode
+
+
+int BtrieveKeySegmentGetACSNumber ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->acsNumber;
+}	// int BtrieveKeySegmentGetACSNumber
+
+
+btrieve_data_type_t BtrieveKeySegmentGetDataType ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? BTRIEVE_DATA_TYPE_UNKNOWN : ( btrieve_data_type_t ) keySegment->segment.dataType;
+}	// btrieve_data_type_t BtrieveKeySegmentGetDataType
+
+
+int BtrieveKeySegmentGetDescendingSortOrder ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->segment.descending;
+}	// int BtrieveKeySegmentGetDescendingSortOrder
+
+
+btrieve_duplicate_mode_t BtrieveKeySegmentGetDuplicateMode ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? BTRIEVE_DUPLICATE_MODE_UNKNOWN : ( btrieve_duplicate_mode_t ) keySegment->duplicateMode;
+}	// btrieve_duplicate_mode_t BtrieveKeySegmentGetDuplicateMode
+
+
+btrieve_index_t BtrieveKeySegmentGetIndex ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? BTRIEVE_INDEX_UNKNOWN : ( btrieve_index_t ) keySegment->index;
+}	// btrieve_index_t BtrieveKeySegmentGetIndex
+
+
+int BtrieveKeySegmentGetKeyContinues ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->keyContinues;
+}	// int BtrieveKeySegmentGetKeyContinues
+
+
+int BtrieveKeySegmentGetLength ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->segment.length;
+}	// int BtrieveKeySegmentGetLength
+
+
+int BtrieveKeySegmentGetModifiable ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->modifiable;
+}	// int BtrieveKeySegmentGetModifiable
+
+
+btrieve_null_key_mode_t BtrieveKeySegmentGetNullKeyMode ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? BTRIEVE_NULL_KEY_MODE_UNKNOWN : ( btrieve_null_key_mode_t ) keySegment->segment.nullKeyMode;
+}	// btrieve_null_key_mode_t BtrieveKeySegmentGetNullKeyMode
+
+
+int BtrieveKeySegmentGetNullAllSegments ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : ( keySegment->segment.nullKeyMode == BTRIEVE_NULL_KEY_MODE_ALL_SEGMENTS ) ? 1 : 0;
+}	// int BtrieveKeySegmentGetNullAllSegments
+
+
+int BtrieveKeySegmentGetNullAnySegment ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : ( keySegment->segment.nullKeyMode == BTRIEVE_NULL_KEY_MODE_ANY_SEGMENTS ) ? 1 : 0;
+}	// int BtrieveKeySegmentGetNullAnySegment
+
+
+int BtrieveKeySegmentGetNullValue ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->segment.nullValue;
+}	// int BtrieveKeySegmentGetNullValue
+
+
+int BtrieveKeySegmentGetOffset ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->segment.offset;
+}	// int BtrieveKeySegmentGetOffset
+
+
+int BtrieveKeySegmentGetSegmented ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->keyContinues;
+}	// int BtrieveKeySegmentGetSegmented
+
+
+long long BtrieveKeySegmentGetUniqueValueCount ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : keySegment->uniqueValueCount;
+}	// long long BtrieveKeySegmentGetUniqueValueCount
+
+
+int BtrieveKeySegmentGetUseNumberedACS ( btrieve_key_segment_t keySegment )
+{
+	return ( keySegment == NULL ) ? -1 : ( keySegment->acsMode == BTRIEVE_ACS_MODE_NUMBERED ) ? 1 : 0;
+}	// int BtrieveKeySegmentGetUseNumberedACS
+
+
+btrieve_status_code_t BtrieveIndexAttributesAllocate ( btrieve_index_attributes_t* btrieveIndexAttributesPtr )
+{
+	btrieve_index_attributes* indexAttributes;
+
+	// If there's nowhere to return the attributes.
+	if ( btrieveIndexAttributesPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( indexAttributes = new ( std::nothrow ) btrieve_index_attributes ( ) ) == NULL )
+	{
+		*btrieveIndexAttributesPtr = NULL;
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	indexAttributes->definition.index = BTRIEVE_INDEX_NONE;
+	indexAttributes->definition.duplicateMode = BTRIEVE_DUPLICATE_MODE_NOT_ALLOWED;
+	indexAttributes->definition.modifiable = 1;
+	indexAttributes->definition.acsMode = BTRIEVE_ACS_MODE_NONE;
+	indexAttributes->definition.acsNumber = 0;
+	indexAttributes->definition.hasAcsMap = 0;
+	indexAttributes->definition.keyLength = 0;
+	indexAttributes->definition.keyEncoding = ENGINE_KEY_ENCODING_RAW;
+	indexAttributes->definition.comparator = NULL;
+	indexAttributes->definition.rootPage = 0;
+	indexAttributes->definition.height = 0;
+	indexAttributes->definition.entryCount = 0;
+	indexAttributes->definition.pageCount = 0;
+	*btrieveIndexAttributesPtr = indexAttributes;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesAllocate
+
+
+btrieve_status_code_t BtrieveIndexAttributesFree ( btrieve_index_attributes_t indexAttributes )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete indexAttributes;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesFree
+
+
+btrieve_status_code_t BtrieveIndexAttributesAddKeySegment ( btrieve_index_attributes_t indexAttributes, btrieve_key_segment_t keySegment )
+{
+	// If either argument is missing.
+	if ( indexAttributes == NULL || keySegment == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the segment's field was never set.
+	if ( !keySegment->fieldSet )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_KEY_POSITION;
+	}
+
+	// If the index already holds the most segments a key can have.
+	if ( indexAttributes->definition.segments.size ( ) >= BTRIEVE_MAXIMUM_KEY_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_KEYLENGTH;
+	}
+
+	indexAttributes->definition.segments.push_back ( keySegment->segment );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesAddKeySegment
+
+
+btrieve_status_code_t BtrieveIndexAttributesSetIndex ( btrieve_index_attributes_t indexAttributes, btrieve_index_t index )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the index is out of range.
+	if ( index < BTRIEVE_INDEX_1 || index > BTRIEVE_INDEX_119 )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+	}
+
+	indexAttributes->definition.index = index;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesSetIndex
+
+
+btrieve_status_code_t BtrieveIndexAttributesSetDuplicateMode ( btrieve_index_attributes_t indexAttributes, btrieve_duplicate_mode_t duplicateMode )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the mode is out of range.
+	if ( duplicateMode < BTRIEVE_DUPLICATE_MODE_NOT_ALLOWED || duplicateMode > BTRIEVE_DUPLICATE_MODE_ALLOWED_REPEATING )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_OPTION;
+	}
+
+	indexAttributes->definition.duplicateMode = duplicateMode;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesSetDuplicateMode
+
+
+btrieve_status_code_t BtrieveIndexAttributesSetModifiable ( btrieve_index_attributes_t indexAttributes, int enableModifiable )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	indexAttributes->definition.modifiable = enableModifiable ? 1 : 0;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesSetModifiable
+
+
+btrieve_status_code_t BtrieveIndexAttributesSetACSMode ( btrieve_index_attributes_t indexAttributes, btrieve_acs_mode_t ACSMode )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// Named and numbered modes are set with their names and numbers.
+	if ( ACSMode != BTRIEVE_ACS_MODE_NONE && ACSMode != BTRIEVE_ACS_MODE_CASE_INSENSITIVE && ACSMode != BTRIEVE_ACS_MODE_DEFAULT )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF;
+	}
+
+	indexAttributes->definition.acsMode = ACSMode;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesSetACSMode
+
+
+btrieve_status_code_t BtrieveIndexAttributesSetACSName ( btrieve_index_attributes_t indexAttributes, const char* ACSName )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the name is missing or too long.
+	if ( ACSName == NULL || *ACSName == '\0' || strlen ( ACSName ) > ENGINE_ACS_NAME_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF;
+	}
+
+	// International sort rules aren't installed; the name orders bytes as they are.
+	strcpy ( indexAttributes->definition.acsName, ACSName );
+	indexAttributes->definition.acsMode = BTRIEVE_ACS_MODE_NAMED;
+	indexAttributes->definition.hasAcsMap = 0;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesSetACSName
+
+
+btrieve_status_code_t BtrieveIndexAttributesSetACSNumber ( btrieve_index_attributes_t indexAttributes, int ACSNumber )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the number is negative.
+	if ( ACSNumber < 0 )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF;
+	}
+
+	indexAttributes->definition.acsNumber = ACSNumber;
+	indexAttributes->definition.acsMode = BTRIEVE_ACS_MODE_NUMBERED;
+	indexAttributes->definition.hasAcsMap = 0;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesSetACSNumber
+
+
+btrieve_status_code_t BtrieveIndexAttributesSetACSUserDefined ( btrieve_index_attributes_t indexAttributes, const char* ACSName, const char* ACSMap, int ACSMapLength )
+{
+	// If there are no attributes.
+	if ( indexAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the name or the map is invalid.
+	if ( ACSName == NULL || *ACSName == '\0' || strlen ( ACSName ) > ENGINE_ACS_NAME_LENGTH || ACSMap == NULL || ACSMapLength != ENGINE_ACS_MAP_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF;
+	}
+
+	strcpy ( indexAttributes->definition.acsName, ACSName );
+	memcpy ( indexAttributes->definition.acsMap, ACSMap, ENGINE_ACS_MAP_LENGTH );
+	indexAttributes->definition.acsMode = BTRIEVE_ACS_MODE_NAMED;
+	indexAttributes->definition.hasAcsMap = 1;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveIndexAttributesSetACSUserDefined
+
+
+btrieve_status_code_t BtrieveVersionAllocate ( btrieve_version_t* btrieveVersionPtr )
+{
+	btrieve_version* version;
+
+	// If there's nowhere to return the version.
+	if ( btrieveVersionPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( version = new ( std::nothrow ) btrieve_version ( ) ) == NULL )
+	{
+		*btrieveVersionPtr = NULL;
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	version->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	version->clientVersionType = BTRIEVE_VERSION_TYPE_NONE;
+	version->localVersionType = BTRIEVE_VERSION_TYPE_NONE;
+	version->remoteVersionType = BTRIEVE_VERSION_TYPE_NONE;
+	*btrieveVersionPtr = version;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveVersionAllocate
+
+
+btrieve_status_code_t BtrieveVersionFree ( btrieve_version_t version )
+{
+	// If there's no version.
+	if ( version == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete version;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveVersionFree
+
+
+btrieve_status_code_t BtrieveVersionGetLastStatusCode ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : version->lastStatusCode;
+}	// btrieve_status_code_t BtrieveVersionGetLastStatusCode
+
+
+int BtrieveVersionGetClientVersionNumber ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? -1 : version->clientVersionNumber;
+}	// int BtrieveVersionGetClientVersionNumber
+
+
+int BtrieveVersionGetClientRevisionNumber ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? -1 : version->clientRevisionNumber;
+}	// int BtrieveVersionGetClientRevisionNumber
+
+
+btrieve_version_type_t BtrieveVersionGetClientVersionType ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? BTRIEVE_VERSION_TYPE_UNKNOWN : version->clientVersionType;
+}	// btrieve_version_type_t BtrieveVersionGetClientVersionType
+
+
+int BtrieveVersionGetLocalVersionNumber ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? -1 : version->localVersionNumber;
+}	// int BtrieveVersionGetLocalVersionNumber
+
+
+int BtrieveVersionGetLocalRevisionNumber ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? -1 : version->localRevisionNumber;
+}	// int BtrieveVersionGetLocalRevisionNumber
+
+
+btrieve_version_type_t BtrieveVersionGetLocalVersionType ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? BTRIEVE_VERSION_TYPE_UNKNOWN : version->localVersionType;
+}	// btrieve_version_type_t BtrieveVersionGetLocalVersionType
+
+
+int BtrieveVersionGetRemoteVersionNumber ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? -1 : version->remoteVersionNumber;
+}	// int BtrieveVersionGetRemoteVersionNumber
+
+
+int BtrieveVersionGetRemoteRevisionNumber ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? -1 : version->remoteRevisionNumber;
+}	// int BtrieveVersionGetRemoteRevisionNumber
+
+
+btrieve_version_type_t BtrieveVersionGetRemoteVersionType ( btrieve_version_t version )
+{
+	return ( version == NULL ) ? BTRIEVE_VERSION_TYPE_UNKNOWN : version->remoteVersionType;
+}	// btrieve_version_type_t BtrieveVersionGetRemoteVersionType
+
+
+long long BtrieveUnixEpochMicrosecondsToTimestamp ( long long microseconds )
+{
+	return ( microseconds + ENGINE_UNIX_EPOCH_MICROSECONDS ) * 10;
+}	// long long BtrieveUnixEpochMicrosecondsToTimestamp
+
+
+long long BtrieveTimestampToUnixEpochMicroseconds ( long long timestamp )
+{
+	return timestamp / 10 - ENGINE_UNIX_EPOCH_MICROSECONDS;
+}	// long long BtrieveTimestampToUnixEpochMicroseconds
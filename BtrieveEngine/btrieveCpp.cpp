@@ -0,0 +1,2263 @@
+// btrieveCpp.cpp : The classes of btrieveCpp.h, implemented over the
+//                  btrieveC.h entry points of the in-process engine.
+//
+// Every class owns one handle of the C interface, allocated by its
+// constructor and freed by its destructor, and forwards each method to
+// the matching C function. Methods that return a const char* return a
+// per-thread buffer that the next call on the same thread overwrites.
+//
+
+#include <string.h>
+
+#include <btrieveCpp.h>
+
+#include "engine.h"
+
+#define ENGINE_NAME_BUFFER_LENGTH 256
+#define ENGINE_DIRECTORY_BUFFER_LENGTH 4096
+
+
+const char* Btrieve::ACSModeToString ( ACSMode ACSMode )
+{
+	return BtrieveACSModeToString ( ( btrieve_acs_mode_t ) ACSMode );
+}	// const char* Btrieve::ACSModeToString
+
+
+const char* Btrieve::DuplicateModeToString ( DuplicateMode duplicateMode )
+{
+	return BtrieveDuplicateModeToString ( ( btrieve_duplicate_mode_t ) duplicateMode );
+}	// const char* Btrieve::DuplicateModeToString
+
+
+const char* Btrieve::DataTypeToString ( DataType dataType )
+{
+	return BtrieveDataTypeToString ( ( btrieve_data_type_t ) dataType );
+}	// const char* Btrieve::DataTypeToString
+
+
+const char* Btrieve::FileVersionToString ( FileVersion fileVersion )
+{
+	return BtrieveFileVersionToString ( ( btrieve_file_version_t ) fileVersion );
+}	// const char* Btrieve::FileVersionToString
+
+
+const char* Btrieve::FreeSpaceThresholdToString ( FreeSpaceThreshold freeSpaceThreshold )
+{
+	return BtrieveFreeSpaceThresholdToString ( ( btrieve_free_space_threshold_t ) freeSpaceThreshold );
+}	// const char* Btrieve::FreeSpaceThresholdToString
+
+
+const char* Btrieve::IndexToString ( Index index )
+{
+	return BtrieveIndexToString ( ( btrieve_index_t ) index );
+}	// const char* Btrieve::IndexToString
+
+
+const char* Btrieve::NullKeyModeToString ( NullKeyMode nullKeyMode )
+{
+	return BtrieveNullKeyModeToString ( ( btrieve_null_key_mode_t ) nullKeyMode );
+}	// const char* Btrieve::NullKeyModeToString
+
+
+const char* Btrieve::PageSizeToString ( PageSize pageSize )
+{
+	return BtrievePageSizeToString ( ( btrieve_page_size_t ) pageSize );
+}	// const char* Btrieve::PageSizeToString
+
+
+const char* Btrieve::RecordCompressionModeToString ( RecordCompressionMode recordCompressionMode )
+{
+	return BtrieveRecordCompressionModeToString ( ( btrieve_record_compression_mode_t ) recordCompressionMode );
+}	// const char* Btrieve::RecordCompressionModeToString
+
+
+const char* Btrieve::StatusCodeToString ( StatusCode statusCode )
+{
+	return BtrieveStatusCodeToString ( ( btrieve_status_code_t ) statusCode );
+}	// const char* Btrieve::StatusCodeToString
+
+
+const char* Btrieve::SystemDataModeToString ( SystemDataMode systemDataMode )
+{
+	return BtrieveSystemDataModeToString ( ( btrieve_system_data_mode_t ) systemDataMode );
+}	// const char* Btrieve::SystemDataModeToString
+
+
+const char* Btrieve::VersionTypeToString ( VersionType versionType )
+{
+	return BtrieveVersionTypeToString ( ( btrieve_version_type_t ) versionType );
+}	// const char* Btrieve::VersionTypeToString
+
+
+const char* Btrieve::PageLockTypeToString ( PageLockType pageLockType )
+{
+	return BtrievePageLockTypeToString ( ( btrieve_page_lock_type_t ) pageLockType );
+}	// const char* Btrieve::PageLockTypeToString
+
+
+const char* Btrieve::LockModeToString ( LockMode lockMode )
+{
+	return BtrieveLockModeToString ( ( btrieve_lock_mode_t ) lockMode );
+}	// const char* Btrieve::LockModeToString
+
+
+const char* Btrieve::OwnerModeToString ( OwnerMode ownerMode )
+{
+	return BtrieveOwnerModeToString ( ( btrieve_owner_mode_t ) ownerMode );
+}	// const char* Btrieve::OwnerModeToString
+
+
+const char* Btrieve::VariableLengthRecordsModeToString ( VariableLengthRecordsMode variableLengthRecordsMode )
+{
+	return BtrieveVariableLengthRecordsModeToString ( ( btrieve_variable_length_records_mode_t ) variableLengthRecordsMode );
+}	// const char* Btrieve::VariableLengthRecordsModeToString
+
+
+long long Btrieve::UnixEpochMicrosecondsToTimestamp ( long long microseconds )
+{
+	return BtrieveUnixEpochMicrosecondsToTimestamp ( microseconds );
+}	// long long Btrieve::UnixEpochMicrosecondsToTimestamp
+
+
+long long Btrieve::TimestampToUnixEpochMicroseconds ( long long timestamp )
+{
+	return BtrieveTimestampToUnixEpochMicroseconds ( timestamp );
+}	// long long Btrieve::TimestampToUnixEpochMicroseconds
+
+
+BtrieveClient::BtrieveClient ( int serviceAgentIdentifier, int clientIdentifier )
+{
+	// If BtrieveClientAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveClientAllocate ( &btrieveClient, serviceAgentIdentifier, clientIdentifier ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveClient = NULL;
+	}
+}	// BtrieveClient::BtrieveClient
+
+
+BtrieveClient::BtrieveClient ( )
+{
+	// If BtrieveClientAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveClientAllocate ( &btrieveClient, 0, 0 ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveClient = NULL;
+	}
+}	// BtrieveClient::BtrieveClient
+
+
+BtrieveClient::~BtrieveClient ( )
+{
+	// If there's a client to free; its open files are closed with it.
+	if ( btrieveClient != NULL )
+	{
+		BtrieveClientFree ( btrieveClient );
+	}
+}	// BtrieveClient::~BtrieveClient
+
+
+Btrieve::StatusCode BtrieveClient::GetVersion ( BtrieveVersion* btrieveVersion, BtrieveFile* btrieveFile )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientGetVersion ( btrieveClient, ( btrieveVersion == NULL ) ? NULL : btrieveVersion->GetBtrieveVersion ( ), ( btrieveFile == NULL ) ? NULL : btrieveFile->GetBtrieveFile ( ) );
+}	// Btrieve::StatusCode BtrieveClient::GetVersion
+
+
+Btrieve::StatusCode BtrieveClient::FileOpen ( BtrieveFile* btrieveFile, const char* fileName, const char* ownerName, Btrieve::OpenMode openMode, Btrieve::LocationMode locationMode )
+{
+	// If there's no file object to open.
+	if ( btrieveFile == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	return ( Btrieve::StatusCode ) BtrieveClientFileOpen ( btrieveClient, btrieveFile->GetBtrieveFilePtr ( ), fileName, ownerName, ( btrieve_open_mode_t ) openMode, ( btrieve_location_mode_t ) locationMode );
+}	// Btrieve::StatusCode BtrieveClient::FileOpen
+
+
+Btrieve::StatusCode BtrieveClient::FileOpen ( BtrieveFile* btrieveFile, const wchar_t* fileName, const char* ownerName, Btrieve::OpenMode openMode, Btrieve::LocationMode locationMode )
+{
+	// If there's no file object to open.
+	if ( btrieveFile == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	return ( Btrieve::StatusCode ) BtrieveClientFileOpenW ( btrieveClient, btrieveFile->GetBtrieveFilePtr ( ), fileName, ownerName, ( btrieve_open_mode_t ) openMode, ( btrieve_location_mode_t ) locationMode );
+}	// Btrieve::StatusCode BtrieveClient::FileOpen
+
+
+const char* BtrieveClient::GetCurrentDirectory ( Btrieve::DiskDrive diskDrive )
+{
+	static thread_local char currentDirectory [ ENGINE_DIRECTORY_BUFFER_LENGTH ];
+
+	// If the directory can't be retrieved.
+	if ( BtrieveClientGetCurrentDirectory ( btrieveClient, ( btrieve_disk_drive_t ) diskDrive, currentDirectory, sizeof ( currentDirectory ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return currentDirectory;
+}	// const char* BtrieveClient::GetCurrentDirectory
+
+
+Btrieve::StatusCode BtrieveClient::GetCurrentDirectory ( Btrieve::DiskDrive diskDrive, char* currentDirectory, int currentDirectorySize )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientGetCurrentDirectory ( btrieveClient, ( btrieve_disk_drive_t ) diskDrive, currentDirectory, currentDirectorySize );
+}	// Btrieve::StatusCode BtrieveClient::GetCurrentDirectory
+
+
+Btrieve::StatusCode BtrieveClient::GetCurrentDirectory ( Btrieve::DiskDrive diskDrive, wchar_t* currentDirectory, int currentDirectorySize )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientGetCurrentDirectoryW ( btrieveClient, ( btrieve_disk_drive_t ) diskDrive, currentDirectory, currentDirectorySize );
+}	// Btrieve::StatusCode BtrieveClient::GetCurrentDirectory
+
+
+Btrieve::StatusCode BtrieveClient::ContinuousOperationBegin ( const char* pathNames )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientContinuousOperationBegin ( btrieveClient, pathNames );
+}	// Btrieve::StatusCode BtrieveClient::ContinuousOperationBegin
+
+
+Btrieve::StatusCode BtrieveClient::ContinuousOperationBegin ( const wchar_t* pathNames )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientContinuousOperationBeginW ( btrieveClient, pathNames );
+}	// Btrieve::StatusCode BtrieveClient::ContinuousOperationBegin
+
+
+Btrieve::StatusCode BtrieveClient::ContinuousOperationEnd ( const char* pathNames )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientContinuousOperationEnd ( btrieveClient, pathNames );
+}	// Btrieve::StatusCode BtrieveClient::ContinuousOperationEnd
+
+
+Btrieve::StatusCode BtrieveClient::ContinuousOperationEnd ( const wchar_t* pathNames )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientContinuousOperationEndW ( btrieveClient, pathNames );
+}	// Btrieve::StatusCode BtrieveClient::ContinuousOperationEnd
+
+
+Btrieve::StatusCode BtrieveClient::FileClose ( BtrieveFile* btrieveFile )
+{
+	btrieve_status_code_t status;
+
+	// If there's no file object to close.
+	if ( btrieveFile == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If BtrieveClientFileClose ( ) fails, the file stays open.
+	if ( ( status = BtrieveClientFileClose ( btrieveClient, btrieveFile->GetBtrieveFile ( ) ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return ( Btrieve::StatusCode ) status;
+	}
+
+	*btrieveFile->GetBtrieveFilePtr ( ) = NULL;
+	return Btrieve::STATUS_CODE_NO_ERROR;
+}	// Btrieve::StatusCode BtrieveClient::FileClose
+
+
+Btrieve::StatusCode BtrieveClient::FileCreate ( BtrieveFileAttributes* btrieveFileAttributes, const char* fileName, Btrieve::CreateMode createMode, Btrieve::LocationMode locationMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileCreate ( btrieveClient, ( btrieveFileAttributes == NULL ) ? NULL : btrieveFileAttributes->GetBtrieveFileAttributes ( ), NULL, fileName, ( btrieve_create_mode_t ) createMode, ( btrieve_location_mode_t ) locationMode );
+}	// Btrieve::StatusCode BtrieveClient::FileCreate
+
+
+Btrieve::StatusCode BtrieveClient::FileCreate ( BtrieveFileAttributes* btrieveFileAttributes, BtrieveIndexAttributes* btrieveIndexAttributes, const char* fileName, Btrieve::CreateMode createMode, Btrieve::LocationMode locationMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileCreate ( btrieveClient, ( btrieveFileAttributes == NULL ) ? NULL : btrieveFileAttributes->GetBtrieveFileAttributes ( ), ( btrieveIndexAttributes == NULL ) ? NULL : btrieveIndexAttributes->GetBtrieveIndexAttributes ( ), fileName, ( btrieve_create_mode_t ) createMode, ( btrieve_location_mode_t ) locationMode );
+}	// Btrieve::StatusCode BtrieveClient::FileCreate
+
+
+Btrieve::StatusCode BtrieveClient::FileCreate ( BtrieveFileAttributes* btrieveFileAttributes, const wchar_t* fileName, Btrieve::CreateMode createMode, Btrieve::LocationMode locationMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileCreateW ( btrieveClient, ( btrieveFileAttributes == NULL ) ? NULL : btrieveFileAttributes->GetBtrieveFileAttributes ( ), NULL, fileName, ( btrieve_create_mode_t ) createMode, ( btrieve_location_mode_t ) locationMode );
+}	// Btrieve::StatusCode BtrieveClient::FileCreate
+
+
+Btrieve::StatusCode BtrieveClient::FileCreate ( BtrieveFileAttributes* btrieveFileAttributes, BtrieveIndexAttributes* btrieveIndexAttributes, const wchar_t* fileName, Btrieve::CreateMode createMode, Btrieve::LocationMode locationMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileCreateW ( btrieveClient, ( btrieveFileAttributes == NULL ) ? NULL : btrieveFileAttributes->GetBtrieveFileAttributes ( ), ( btrieveIndexAttributes == NULL ) ? NULL : btrieveIndexAttributes->GetBtrieveIndexAttributes ( ), fileName, ( btrieve_create_mode_t ) createMode, ( btrieve_location_mode_t ) locationMode );
+}	// Btrieve::StatusCode BtrieveClient::FileCreate
+
+
+Btrieve::StatusCode BtrieveClient::FileDelete ( const char* fileName )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileDelete ( btrieveClient, fileName );
+}	// Btrieve::StatusCode BtrieveClient::FileDelete
+
+
+Btrieve::StatusCode BtrieveClient::FileDelete ( const wchar_t* fileName )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileDeleteW ( btrieveClient, fileName );
+}	// Btrieve::StatusCode BtrieveClient::FileDelete
+
+
+Btrieve::StatusCode BtrieveClient::FileRename ( const char* existingFileName, const char* newFileName )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileRename ( btrieveClient, existingFileName, newFileName );
+}	// Btrieve::StatusCode BtrieveClient::FileRename
+
+
+Btrieve::StatusCode BtrieveClient::FileRename ( const wchar_t* existingFileName, const wchar_t* newFileName )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientFileRenameW ( btrieveClient, existingFileName, newFileName );
+}	// Btrieve::StatusCode BtrieveClient::FileRename
+
+
+Btrieve::StatusCode BtrieveClient::GetLastStatusCode ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientGetLastStatusCode ( btrieveClient );
+}	// Btrieve::StatusCode BtrieveClient::GetLastStatusCode
+
+
+Btrieve::StatusCode BtrieveClient::Login ( const char* databaseURI )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientLogin ( btrieveClient, databaseURI );
+}	// Btrieve::StatusCode BtrieveClient::Login
+
+
+Btrieve::StatusCode BtrieveClient::Login ( const wchar_t* databaseURI )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientLoginW ( btrieveClient, databaseURI );
+}	// Btrieve::StatusCode BtrieveClient::Login
+
+
+Btrieve::StatusCode BtrieveClient::Logout ( const char* databaseURI )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientLogout ( btrieveClient, databaseURI );
+}	// Btrieve::StatusCode BtrieveClient::Logout
+
+
+Btrieve::StatusCode BtrieveClient::Logout ( const wchar_t* databaseURI )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientLogoutW ( btrieveClient, databaseURI );
+}	// Btrieve::StatusCode BtrieveClient::Logout
+
+
+Btrieve::StatusCode BtrieveClient::Reset ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientReset ( btrieveClient );
+}	// Btrieve::StatusCode BtrieveClient::Reset
+
+
+Btrieve::StatusCode BtrieveClient::SetCurrentDirectory ( const char* currentDirectory )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientSetCurrentDirectory ( btrieveClient, currentDirectory );
+}	// Btrieve::StatusCode BtrieveClient::SetCurrentDirectory
+
+
+Btrieve::StatusCode BtrieveClient::SetCurrentDirectory ( const wchar_t* currentDirectory )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientSetCurrentDirectoryW ( btrieveClient, currentDirectory );
+}	// Btrieve::StatusCode BtrieveClient::SetCurrentDirectory
+
+
+Btrieve::StatusCode BtrieveClient::Stop ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientStop ( btrieveClient );
+}	// Btrieve::StatusCode BtrieveClient::Stop
+
+
+Btrieve::StatusCode BtrieveClient::TransactionAbort ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientTransactionAbort ( btrieveClient );
+}	// Btrieve::StatusCode BtrieveClient::TransactionAbort
+
+
+Btrieve::StatusCode BtrieveClient::TransactionBegin ( Btrieve::TransactionMode transactionMode, Btrieve::LockMode lockMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientTransactionBegin ( btrieveClient, ( btrieve_transaction_mode_t ) transactionMode, ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveClient::TransactionBegin
+
+
+Btrieve::StatusCode BtrieveClient::TransactionEnd ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveClientTransactionEnd ( btrieveClient );
+}	// Btrieve::StatusCode BtrieveClient::TransactionEnd
+
+
+int BtrieveClient::GetServiceAgentIdentifier ( )
+{
+	return BtrieveClientGetServiceAgentIdentifier ( btrieveClient );
+}	// int BtrieveClient::GetServiceAgentIdentifier
+
+
+int BtrieveClient::GetClientIdentifier ( )
+{
+	return BtrieveClientGetClientIdentifier ( btrieveClient );
+}	// int BtrieveClient::GetClientIdentifier
+
+
+// Collections are JSON document stores built on the engine's SQL layer,
+// which this engine doesn't have.
+Btrieve::StatusCode BtrieveClient::CollectionCreate ( const char* collectionName )
+{
+	( void ) collectionName;
+
+	return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveClient::CollectionCreate
+
+
+Btrieve::StatusCode BtrieveClient::CollectionDelete ( const char* collectionName )
+{
+	( void ) collectionName;
+
+	return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveClient::CollectionDelete
+
+
+Btrieve::StatusCode BtrieveClient::CollectionRename ( const char* existingCollectionName, const char* newCollectionName )
+{
+	( void ) existingCollectionName;
+	( void ) newCollectionName;
+
+	return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveClient::CollectionRename
+
+
+Btrieve::StatusCode BtrieveClient::CollectionOpen ( BtrieveCollection* btrieveCollection, const char* collectionName )
+{
+	( void ) btrieveCollection;
+	( void ) collectionName;
+
+	return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveClient::CollectionOpen
+
+
+Btrieve::StatusCode BtrieveClient::CollectionClose ( BtrieveCollection* btrieveCollection )
+{
+	( void ) btrieveCollection;
+
+	return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveClient::CollectionClose
+
+
+BtrieveFile::BtrieveFile ( )
+{
+	btrieveFile = NULL;
+}	// BtrieveFile::BtrieveFile
+
+
+BtrieveFile::BtrieveFile ( btrieve_file_t btrieveFileIn )
+{
+	btrieveFile = btrieveFileIn;
+}	// BtrieveFile::BtrieveFile
+
+
+BtrieveFile::~BtrieveFile ( )
+{
+	// If the file is still open, close it; if its client is gone, only the handle remains to free.
+	if ( btrieveFile != NULL )
+	{
+		// If the client was freed first.
+		if ( btrieveFile->client == NULL )
+		{
+			delete btrieveFile;
+		}
+		else
+		{
+			BtrieveClientFileClose ( btrieveFile->client, btrieveFile );
+		}
+	}
+}	// BtrieveFile::~BtrieveFile
+
+
+btrieve_file_t BtrieveFile::GetBtrieveFile ( )
+{
+	return btrieveFile;
+}	// btrieve_file_t BtrieveFile::GetBtrieveFile
+
+
+btrieve_file_t* BtrieveFile::GetBtrieveFilePtr ( )
+{
+	return &btrieveFile;
+}	// btrieve_file_t* BtrieveFile::GetBtrieveFilePtr
+
+
+Btrieve::StatusCode BtrieveFile::RecordDelete ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordDelete ( btrieveFile );
+}	// Btrieve::StatusCode BtrieveFile::RecordDelete
+
+
+int BtrieveFile::RecordRetrieveByFraction ( Btrieve::Index index, int numerator, int denominator, char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveByFraction ( btrieveFile, ( btrieve_index_t ) index, numerator, denominator, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveByFraction
+
+
+int BtrieveFile::RecordRetrieveByPercentage ( Btrieve::Index index, int percentage, char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveByPercentage ( btrieveFile, ( btrieve_index_t ) index, percentage, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveByPercentage
+
+
+int BtrieveFile::RecordRetrieveByCursorPosition ( Btrieve::Index index, long long cursorPosition, char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveByCursorPosition ( btrieveFile, ( btrieve_index_t ) index, cursorPosition, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveByCursorPosition
+
+
+int BtrieveFile::RecordRetrieve ( Btrieve::Comparison comparison, Btrieve::Index index, const char* key, int keyLength, char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieve ( btrieveFile, ( btrieve_comparison_t ) comparison, ( btrieve_index_t ) index, key, keyLength, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieve
+
+
+Btrieve::StatusCode BtrieveFile::KeyRetrieve ( Btrieve::Comparison comparison, Btrieve::Index index, const char* key, int keyLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileKeyRetrieve ( btrieveFile, ( btrieve_comparison_t ) comparison, ( btrieve_index_t ) index, key, keyLength );
+}	// Btrieve::StatusCode BtrieveFile::KeyRetrieve
+
+
+Btrieve::StatusCode BtrieveFile::BulkRetrieveNext ( BtrieveBulkRetrieveAttributes* bulkRetrieveAttributes, BtrieveBulkRetrieveResult* bulkRetrieveResult, Btrieve::LockMode lockMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileBulkRetrieveNext ( btrieveFile, ( bulkRetrieveAttributes == NULL ) ? NULL : bulkRetrieveAttributes->GetBtrieveBulkRetrieveAttributes ( ), ( bulkRetrieveResult == NULL ) ? NULL : bulkRetrieveResult->GetBtrieveBulkRetrieveResult ( ), ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveFile::BulkRetrieveNext
+
+
+Btrieve::StatusCode BtrieveFile::BulkRetrievePrevious ( BtrieveBulkRetrieveAttributes* bulkRetrieveAttributes, BtrieveBulkRetrieveResult* bulkRetrieveResult, Btrieve::LockMode lockMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileBulkRetrievePrevious ( btrieveFile, ( bulkRetrieveAttributes == NULL ) ? NULL : bulkRetrieveAttributes->GetBtrieveBulkRetrieveAttributes ( ), ( bulkRetrieveResult == NULL ) ? NULL : bulkRetrieveResult->GetBtrieveBulkRetrieveResult ( ), ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveFile::BulkRetrievePrevious
+
+
+Btrieve::StatusCode BtrieveFile::GetInformation ( BtrieveFileInformation* btrieveFileInformation )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileGetInformation ( btrieveFile, ( btrieveFileInformation == NULL ) ? NULL : btrieveFileInformation->GetBtrieveFileInformation ( ) );
+}	// Btrieve::StatusCode BtrieveFile::GetInformation
+
+
+int BtrieveFile::RecordRetrieveFirst ( Btrieve::Index index, char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveFirst ( btrieveFile, ( btrieve_index_t ) index, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveFirst
+
+
+Btrieve::StatusCode BtrieveFile::KeyRetrieveFirst ( Btrieve::Index index, char* key, int keySize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileKeyRetrieveFirst ( btrieveFile, ( btrieve_index_t ) index, key, keySize );
+}	// Btrieve::StatusCode BtrieveFile::KeyRetrieveFirst
+
+
+int BtrieveFile::GetNumerator ( long long cursorPosition, int denominator )
+{
+	return BtrieveFileGetNumerator ( btrieveFile, BTRIEVE_INDEX_NONE, NULL, 0, cursorPosition, denominator );
+}	// int BtrieveFile::GetNumerator
+
+
+int BtrieveFile::GetNumerator ( Btrieve::Index index, const char* key, int keyLength, int denominator )
+{
+	return BtrieveFileGetNumerator ( btrieveFile, ( btrieve_index_t ) index, key, keyLength, 0, denominator );
+}	// int BtrieveFile::GetNumerator
+
+
+int BtrieveFile::RecordRetrieveLast ( Btrieve::Index index, char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveLast ( btrieveFile, ( btrieve_index_t ) index, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveLast
+
+
+Btrieve::StatusCode BtrieveFile::KeyRetrieveLast ( Btrieve::Index index, char* key, int keySize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileKeyRetrieveLast ( btrieveFile, ( btrieve_index_t ) index, key, keySize );
+}	// Btrieve::StatusCode BtrieveFile::KeyRetrieveLast
+
+
+Btrieve::StatusCode BtrieveFile::GetLastStatusCode ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileGetLastStatusCode ( btrieveFile );
+}	// Btrieve::StatusCode BtrieveFile::GetLastStatusCode
+
+
+Btrieve::StatusCode BtrieveFile::KeyRetrieveNext ( char* key, int keySize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileKeyRetrieveNext ( btrieveFile, key, keySize );
+}	// Btrieve::StatusCode BtrieveFile::KeyRetrieveNext
+
+
+int BtrieveFile::RecordRetrieveNext ( char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveNext ( btrieveFile, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveNext
+
+
+int BtrieveFile::GetPercentage ( long long cursorPosition )
+{
+	return BtrieveFileGetPercentage ( btrieveFile, BTRIEVE_INDEX_NONE, NULL, 0, cursorPosition );
+}	// int BtrieveFile::GetPercentage
+
+
+int BtrieveFile::GetPercentage ( Btrieve::Index index, const char* key, int keyLength )
+{
+	return BtrieveFileGetPercentage ( btrieveFile, ( btrieve_index_t ) index, key, keyLength, 0 );
+}	// int BtrieveFile::GetPercentage
+
+
+long long BtrieveFile::GetCursorPosition ( )
+{
+	return BtrieveFileGetCursorPosition ( btrieveFile );
+}	// long long BtrieveFile::GetCursorPosition
+
+
+Btrieve::StatusCode BtrieveFile::KeyRetrievePrevious ( char* key, int keySize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileKeyRetrievePrevious ( btrieveFile, key, keySize );
+}	// Btrieve::StatusCode BtrieveFile::KeyRetrievePrevious
+
+
+int BtrieveFile::RecordRetrievePrevious ( char* record, int recordSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrievePrevious ( btrieveFile, record, recordSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrievePrevious
+
+
+int BtrieveFile::RecordRetrieveChunk ( int offset, int length, char* chunk, int chunkSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveChunk ( btrieveFile, offset, length, chunk, chunkSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveChunk
+
+
+int BtrieveFile::RecordRetrieveChunk ( int length, char* chunk, int chunkSize, Btrieve::LockMode lockMode )
+{
+	return BtrieveFileRecordRetrieveChunk ( btrieveFile, -1, length, chunk, chunkSize, ( btrieve_lock_mode_t ) lockMode );
+}	// int BtrieveFile::RecordRetrieveChunk
+
+
+Btrieve::StatusCode BtrieveFile::IndexCreate ( BtrieveIndexAttributes* btrieveIndexAttributes )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileIndexCreate ( btrieveFile, ( btrieveIndexAttributes == NULL ) ? NULL : btrieveIndexAttributes->GetBtrieveIndexAttributes ( ) );
+}	// Btrieve::StatusCode BtrieveFile::IndexCreate
+
+
+Btrieve::StatusCode BtrieveFile::IndexDrop ( Btrieve::Index index )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileIndexDrop ( btrieveFile, ( btrieve_index_t ) index );
+}	// Btrieve::StatusCode BtrieveFile::IndexDrop
+
+
+Btrieve::StatusCode BtrieveFile::RecordCreate ( char* record, int recordLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordCreate ( btrieveFile, record, recordLength );
+}	// Btrieve::StatusCode BtrieveFile::RecordCreate
+
+
+Btrieve::StatusCode BtrieveFile::BulkCreate ( BtrieveBulkCreatePayload* btrieveBulkCreatePayload, BtrieveBulkCreateResult* btrieveBulkCreateResult )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileBulkCreate ( btrieveFile, ( btrieveBulkCreatePayload == NULL ) ? NULL : btrieveBulkCreatePayload->GetBtrieveBulkCreatePayload ( ), ( btrieveBulkCreateResult == NULL ) ? NULL : btrieveBulkCreateResult->GetBtrieveBulkCreateResult ( ) );
+}	// Btrieve::StatusCode BtrieveFile::BulkCreate
+
+
+Btrieve::StatusCode BtrieveFile::SetOwner ( Btrieve::OwnerMode ownerMode, const char* ownerName, const char* ownerNameAgain, bool useLongOwnerName )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileSetOwner ( btrieveFile, ( btrieve_owner_mode_t ) ownerMode, ownerName, ownerNameAgain, useLongOwnerName ? 1 : 0 );
+}	// Btrieve::StatusCode BtrieveFile::SetOwner
+
+
+Btrieve::StatusCode BtrieveFile::RecordTruncate ( int offset )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordTruncate ( btrieveFile, offset );
+}	// Btrieve::StatusCode BtrieveFile::RecordTruncate
+
+
+Btrieve::StatusCode BtrieveFile::RecordTruncate ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordTruncate ( btrieveFile, -1 );
+}	// Btrieve::StatusCode BtrieveFile::RecordTruncate
+
+
+Btrieve::StatusCode BtrieveFile::RecordUnlock ( Btrieve::UnlockMode unlockMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordUnlock ( btrieveFile, ( btrieve_unlock_mode_t ) unlockMode );
+}	// Btrieve::StatusCode BtrieveFile::RecordUnlock
+
+
+Btrieve::StatusCode BtrieveFile::UnlockCursorPosition ( long long cursorPosition )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileUnlockCursorPosition ( btrieveFile, cursorPosition );
+}	// Btrieve::StatusCode BtrieveFile::UnlockCursorPosition
+
+
+Btrieve::StatusCode BtrieveFile::RecordUpdate ( const char* record, int recordLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordUpdate ( btrieveFile, record, recordLength );
+}	// Btrieve::StatusCode BtrieveFile::RecordUpdate
+
+
+Btrieve::StatusCode BtrieveFile::RecordAppendChunk ( const char* chunk, int chunkLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordAppendChunk ( btrieveFile, chunk, chunkLength );
+}	// Btrieve::StatusCode BtrieveFile::RecordAppendChunk
+
+
+Btrieve::StatusCode BtrieveFile::RecordUpdateChunk ( int offset, const char* chunk, int chunkLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordUpdateChunk ( btrieveFile, offset, chunk, chunkLength );
+}	// Btrieve::StatusCode BtrieveFile::RecordUpdateChunk
+
+
+Btrieve::StatusCode BtrieveFile::RecordUpdateChunk ( const char* chunk, int chunkLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileRecordUpdateChunk ( btrieveFile, -1, chunk, chunkLength );
+}	// Btrieve::StatusCode BtrieveFile::RecordUpdateChunk
+
+
+BtrieveFileAttributes::BtrieveFileAttributes ( )
+{
+	// If BtrieveFileAttributesAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveFileAttributesAllocate ( &btrieveFileAttributes ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveFileAttributes = NULL;
+	}
+}	// BtrieveFileAttributes::BtrieveFileAttributes
+
+
+BtrieveFileAttributes::~BtrieveFileAttributes ( )
+{
+	// If there's a handle to free.
+	if ( btrieveFileAttributes != NULL )
+	{
+		BtrieveFileAttributesFree ( btrieveFileAttributes );
+	}
+}	// BtrieveFileAttributes::~BtrieveFileAttributes
+
+
+btrieve_file_attributes_t BtrieveFileAttributes::GetBtrieveFileAttributes ( )
+{
+	return btrieveFileAttributes;
+}	// btrieve_file_attributes_t BtrieveFileAttributes::GetBtrieveFileAttributes
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetBalancedIndexes ( bool enableBalancedIndexes )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetBalancedIndexes ( btrieveFileAttributes, enableBalancedIndexes ? 1 : 0 );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetBalancedIndexes
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetRecordCompressionMode ( Btrieve::RecordCompressionMode recordCompressionMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetRecordCompressionMode ( btrieveFileAttributes, ( btrieve_record_compression_mode_t ) recordCompressionMode );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetRecordCompressionMode
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetReservedDuplicatePointerCount ( int reservedDuplicatePointerCount )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetReservedDuplicatePointerCount ( btrieveFileAttributes, reservedDuplicatePointerCount );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetReservedDuplicatePointerCount
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetFileVersion ( Btrieve::FileVersion fileVersion )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetFileVersion ( btrieveFileAttributes, ( btrieve_file_version_t ) fileVersion );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetFileVersion
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetFreeSpaceThreshold ( Btrieve::FreeSpaceThreshold freeSpaceThreshold )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetFreeSpaceThreshold ( btrieveFileAttributes, ( btrieve_free_space_threshold_t ) freeSpaceThreshold );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetFreeSpaceThreshold
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetPageSize ( Btrieve::PageSize pageSize, bool enablePageCompression )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetPageSize ( btrieveFileAttributes, ( btrieve_page_size_t ) pageSize, enablePageCompression ? 1 : 0 );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetPageSize
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetFixedRecordLength ( int fixedRecordLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetFixedRecordLength ( btrieveFileAttributes, fixedRecordLength );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetFixedRecordLength
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetPreallocatedPageCount ( int preallocatedPageCount )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetPreallocatedPageCount ( btrieveFileAttributes, preallocatedPageCount );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetPreallocatedPageCount
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetSystemDataMode ( Btrieve::SystemDataMode systemDataMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetSystemDataMode ( btrieveFileAttributes, ( btrieve_system_data_mode_t ) systemDataMode );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetSystemDataMode
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetVariableLengthRecordsMode ( Btrieve::VariableLengthRecordsMode variableLengthRecordsMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetVariableLengthRecordsMode ( btrieveFileAttributes, ( btrieve_variable_length_records_mode_t ) variableLengthRecordsMode );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetVariableLengthRecordsMode
+
+
+Btrieve::StatusCode BtrieveFileAttributes::SetKeyOnly ( bool enableKeyOnly )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileAttributesSetKeyOnly ( btrieveFileAttributes, enableKeyOnly ? 1 : 0 );
+}	// Btrieve::StatusCode BtrieveFileAttributes::SetKeyOnly
+
+
+BtrieveFileInformation::BtrieveFileInformation ( )
+{
+	// If BtrieveFileInformationAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveFileInformationAllocate ( &btrieveFileInformation ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveFileInformation = NULL;
+	}
+}	// BtrieveFileInformation::BtrieveFileInformation
+
+
+BtrieveFileInformation::~BtrieveFileInformation ( )
+{
+	// If there's a handle to free.
+	if ( btrieveFileInformation != NULL )
+	{
+		BtrieveFileInformationFree ( btrieveFileInformation );
+	}
+}	// BtrieveFileInformation::~BtrieveFileInformation
+
+
+btrieve_file_information_t BtrieveFileInformation::GetBtrieveFileInformation ( )
+{
+	return btrieveFileInformation;
+}	// btrieve_file_information_t BtrieveFileInformation::GetBtrieveFileInformation
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetLastStatusCode ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetLastStatusCode ( btrieveFileInformation );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetLastStatusCode
+
+
+Btrieve::FileVersion BtrieveFileInformation::GetFileVersion ( )
+{
+	return ( Btrieve::FileVersion ) BtrieveFileInformationGetFileVersion ( btrieveFileInformation );
+}	// Btrieve::FileVersion BtrieveFileInformation::GetFileVersion
+
+
+Btrieve::FreeSpaceThreshold BtrieveFileInformation::GetFreeSpaceThreshold ( )
+{
+	return ( Btrieve::FreeSpaceThreshold ) BtrieveFileInformationGetFreeSpaceThreshold ( btrieveFileInformation );
+}	// Btrieve::FreeSpaceThreshold BtrieveFileInformation::GetFreeSpaceThreshold
+
+
+Btrieve::PageSize BtrieveFileInformation::GetPageSize ( )
+{
+	return ( Btrieve::PageSize ) BtrieveFileInformationGetPageSize ( btrieveFileInformation );
+}	// Btrieve::PageSize BtrieveFileInformation::GetPageSize
+
+
+Btrieve::SystemDataMode BtrieveFileInformation::GetSystemDataMode ( )
+{
+	return ( Btrieve::SystemDataMode ) BtrieveFileInformationGetSystemDataMode ( btrieveFileInformation );
+}	// Btrieve::SystemDataMode BtrieveFileInformation::GetSystemDataMode
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetKeySegment ( BtrieveKeySegment* btrieveKeySegment, int keySegmentNumber )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetKeySegment ( btrieveFileInformation, ( btrieveKeySegment == NULL ) ? NULL : btrieveKeySegment->GetBtrieveKeySegment ( ), keySegmentNumber );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetKeySegment
+
+
+int BtrieveFileInformation::GetBalancedIndexes ( )
+{
+	return BtrieveFileInformationGetBalancedIndexes ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetBalancedIndexes
+
+
+int BtrieveFileInformation::GetKeyOnly ( )
+{
+	return BtrieveFileInformationGetKeyOnly ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetKeyOnly
+
+
+int BtrieveFileInformation::GetPageCompression ( )
+{
+	return BtrieveFileInformationGetPageCompression ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetPageCompression
+
+
+int BtrieveFileInformation::GetPagePreallocation ( )
+{
+	return BtrieveFileInformationGetPagePreallocation ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetPagePreallocation
+
+
+int BtrieveFileInformation::GetUnusedDuplicatePointerCount ( )
+{
+	return BtrieveFileInformationGetUnusedDuplicatePointerCount ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetUnusedDuplicatePointerCount
+
+
+int BtrieveFileInformation::GetIndexCount ( )
+{
+	return BtrieveFileInformationGetIndexCount ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetIndexCount
+
+
+int BtrieveFileInformation::GetFixedRecordLength ( )
+{
+	return BtrieveFileInformationGetFixedRecordLength ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetFixedRecordLength
+
+
+int BtrieveFileInformation::GetSegmented ( )
+{
+	return BtrieveFileInformationGetSegmented ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSegmented
+
+
+int BtrieveFileInformation::GetUnusedPageCount ( )
+{
+	return BtrieveFileInformationGetUnusedPageCount ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetUnusedPageCount
+
+
+int BtrieveFileInformation::GetLoggable ( )
+{
+	return BtrieveFileInformationGetLoggable ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLoggable
+
+
+int BtrieveFileInformation::GetSystemIndexPresent ( )
+{
+	return BtrieveFileInformationGetSystemIndexPresent ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSystemIndexPresent
+
+
+int BtrieveFileInformation::GetSystemIndexSize ( )
+{
+	return BtrieveFileInformationGetSystemIndexSize ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSystemIndexSize
+
+
+int BtrieveFileInformation::GetSystemIndexUsed ( )
+{
+	return BtrieveFileInformationGetSystemIndexUsed ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSystemIndexUsed
+
+
+int BtrieveFileInformation::GetSystemIndexVersion ( )
+{
+	return BtrieveFileInformationGetSystemIndexVersion ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSystemIndexVersion
+
+
+int BtrieveFileInformation::GetIdentifier ( )
+{
+	return BtrieveFileInformationGetIdentifier ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetIdentifier
+
+
+int BtrieveFileInformation::GetHandleCount ( )
+{
+	return BtrieveFileInformationGetHandleCount ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetHandleCount
+
+
+int BtrieveFileInformation::GetOpenTimestamp ( )
+{
+	return BtrieveFileInformationGetOpenTimestamp ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetOpenTimestamp
+
+
+int BtrieveFileInformation::GetUsageCount ( )
+{
+	return BtrieveFileInformationGetUsageCount ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetUsageCount
+
+
+int BtrieveFileInformation::GetExplicitLocks ( )
+{
+	return BtrieveFileInformationGetExplicitLocks ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetExplicitLocks
+
+
+int BtrieveFileInformation::GetClientTransactions ( )
+{
+	return BtrieveFileInformationGetClientTransactions ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetClientTransactions
+
+
+int BtrieveFileInformation::GetReadOnly ( )
+{
+	return BtrieveFileInformationGetReadOnly ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetReadOnly
+
+
+int BtrieveFileInformation::GetContinuousOperation ( )
+{
+	return BtrieveFileInformationGetContinuousOperation ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetContinuousOperation
+
+
+int BtrieveFileInformation::GetReferentialIntegrityConstraints ( )
+{
+	return BtrieveFileInformationGetReferentialIntegrityConstraints ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetReferentialIntegrityConstraints
+
+
+int BtrieveFileInformation::GetWrongOwner ( )
+{
+	return BtrieveFileInformationGetWrongOwner ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetWrongOwner
+
+
+int BtrieveFileInformation::GetGatewayMajorVersion ( )
+{
+	return BtrieveFileInformationGetGatewayMajorVersion ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetGatewayMajorVersion
+
+
+int BtrieveFileInformation::GetGatewayMinorVersion ( )
+{
+	return BtrieveFileInformationGetGatewayMinorVersion ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetGatewayMinorVersion
+
+
+int BtrieveFileInformation::GetGatewayPatchLevel ( )
+{
+	return BtrieveFileInformationGetGatewayPatchLevel ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetGatewayPatchLevel
+
+
+int BtrieveFileInformation::GetGatewayPlatform ( )
+{
+	return BtrieveFileInformationGetGatewayPlatform ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetGatewayPlatform
+
+
+int BtrieveFileInformation::GetLockOwnerImplicitLock ( )
+{
+	return BtrieveFileInformationGetLockOwnerImplicitLock ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerImplicitLock
+
+
+int BtrieveFileInformation::GetLockOwnerFileLock ( )
+{
+	return BtrieveFileInformationGetLockOwnerFileLock ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerFileLock
+
+
+int BtrieveFileInformation::GetLockOwnerRecordLock ( )
+{
+	return BtrieveFileInformationGetLockOwnerRecordLock ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerRecordLock
+
+
+int BtrieveFileInformation::GetLockOwnerSameProcess ( )
+{
+	return BtrieveFileInformationGetLockOwnerSameProcess ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerSameProcess
+
+
+int BtrieveFileInformation::GetLockOwnerWriteNoWait ( )
+{
+	return BtrieveFileInformationGetLockOwnerWriteNoWait ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerWriteNoWait
+
+
+int BtrieveFileInformation::GetLockOwnerWriteHold ( )
+{
+	return BtrieveFileInformationGetLockOwnerWriteHold ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerWriteHold
+
+
+int BtrieveFileInformation::GetLockOwnerTimeInTransaction ( )
+{
+	return BtrieveFileInformationGetLockOwnerTimeInTransaction ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerTimeInTransaction
+
+
+int BtrieveFileInformation::GetLockOwnerTransactionLevel ( )
+{
+	return BtrieveFileInformationGetLockOwnerTransactionLevel ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerTransactionLevel
+
+
+int BtrieveFileInformation::GetLockOwnerServiceAgentIdentifier ( )
+{
+	return BtrieveFileInformationGetLockOwnerServiceAgentIdentifier ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerServiceAgentIdentifier
+
+
+int BtrieveFileInformation::GetLockOwnerClientIdentifier ( )
+{
+	return BtrieveFileInformationGetLockOwnerClientIdentifier ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetLockOwnerClientIdentifier
+
+
+int BtrieveFileInformation::GetReferentialIntegrityOperationCode ( )
+{
+	return BtrieveFileInformationGetReferentialIntegrityOperationCode ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetReferentialIntegrityOperationCode
+
+
+int BtrieveFileInformation::GetSegmentCount ( )
+{
+	return BtrieveFileInformationGetSegmentCount ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSegmentCount
+
+
+int BtrieveFileInformation::GetSecurityHandleTrusted ( )
+{
+	return BtrieveFileInformationGetSecurityHandleTrusted ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleTrusted
+
+
+int BtrieveFileInformation::GetSecurityHandleImplicit ( )
+{
+	return BtrieveFileInformationGetSecurityHandleImplicit ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleImplicit
+
+
+int BtrieveFileInformation::GetSecurityHandleExplicit ( )
+{
+	return BtrieveFileInformationGetSecurityHandleExplicit ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleExplicit
+
+
+int BtrieveFileInformation::GetSecurityHandleAuthenticationByDatabase ( )
+{
+	return BtrieveFileInformationGetSecurityHandleAuthenticationByDatabase ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleAuthenticationByDatabase
+
+
+int BtrieveFileInformation::GetSecurityHandleAuthorizationByDatabase ( )
+{
+	return BtrieveFileInformationGetSecurityHandleAuthorizationByDatabase ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleAuthorizationByDatabase
+
+
+int BtrieveFileInformation::GetSecurityHandleWindowsNamedPipe ( )
+{
+	return BtrieveFileInformationGetSecurityHandleWindowsNamedPipe ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleWindowsNamedPipe
+
+
+int BtrieveFileInformation::GetSecurityHandleWorkgroup ( )
+{
+	return BtrieveFileInformationGetSecurityHandleWorkgroup ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleWorkgroup
+
+
+int BtrieveFileInformation::GetSecurityHandleBtpasswd ( )
+{
+	return BtrieveFileInformationGetSecurityHandleBtpasswd ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleBtpasswd
+
+
+int BtrieveFileInformation::GetSecurityHandlePAM ( )
+{
+	return BtrieveFileInformationGetSecurityHandlePAM ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandlePAM
+
+
+int BtrieveFileInformation::GetSecurityHandleRTSSComplete ( )
+{
+	return BtrieveFileInformationGetSecurityHandleRTSSComplete ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleRTSSComplete
+
+
+int BtrieveFileInformation::GetSecurityHandleRTSSPreauthorized ( )
+{
+	return BtrieveFileInformationGetSecurityHandleRTSSPreauthorized ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleRTSSPreauthorized
+
+
+int BtrieveFileInformation::GetSecurityHandleRTSSDisabled ( )
+{
+	return BtrieveFileInformationGetSecurityHandleRTSSDisabled ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityHandleRTSSDisabled
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseTrusted ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseTrusted ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseTrusted
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseImplicit ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseImplicit ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseImplicit
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseExplicit ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseExplicit ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseExplicit
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseAuthenticationByDatabase ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseAuthenticationByDatabase ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseAuthenticationByDatabase
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseAuthorizationByDatabase ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseAuthorizationByDatabase ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseAuthorizationByDatabase
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseWindowsNamedPipe ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseWindowsNamedPipe ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseWindowsNamedPipe
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseWorkgroup ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseWorkgroup ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseWorkgroup
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseBtpasswd ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseBtpasswd ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseBtpasswd
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabasePAM ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabasePAM ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabasePAM
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseRTSSComplete ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseRTSSComplete ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseRTSSComplete
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseRTSSPreauthorized ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseRTSSPreauthorized ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseRTSSPreauthorized
+
+
+int BtrieveFileInformation::GetSecurityCurrentDatabaseRTSSDisabled ( )
+{
+	return BtrieveFileInformationGetSecurityCurrentDatabaseRTSSDisabled ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityCurrentDatabaseRTSSDisabled
+
+
+int BtrieveFileInformation::GetSecurityPermissionNoRights ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionNoRights ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionNoRights
+
+
+int BtrieveFileInformation::GetSecurityPermissionOpen ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionOpen ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionOpen
+
+
+int BtrieveFileInformation::GetSecurityPermissionRead ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionRead ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionRead
+
+
+int BtrieveFileInformation::GetSecurityPermissionCreateFile ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionCreateFile ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionCreateFile
+
+
+int BtrieveFileInformation::GetSecurityPermissionUpdate ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionUpdate ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionUpdate
+
+
+int BtrieveFileInformation::GetSecurityPermissionCreateRecord ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionCreateRecord ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionCreateRecord
+
+
+int BtrieveFileInformation::GetSecurityPermissionDelete ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionDelete ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionDelete
+
+
+int BtrieveFileInformation::GetSecurityPermissionExecute ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionExecute ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionExecute
+
+
+int BtrieveFileInformation::GetSecurityPermissionAlter ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionAlter ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionAlter
+
+
+int BtrieveFileInformation::GetSecurityPermissionRefer ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionRefer ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionRefer
+
+
+int BtrieveFileInformation::GetSecurityPermissionCreateView ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionCreateView ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionCreateView
+
+
+int BtrieveFileInformation::GetSecurityPermissionCreateStoredProcedure ( )
+{
+	return BtrieveFileInformationGetSecurityPermissionCreateStoredProcedure ( btrieveFileInformation );
+}	// int BtrieveFileInformation::GetSecurityPermissionCreateStoredProcedure
+
+
+long long BtrieveFileInformation::GetRecordCount ( )
+{
+	return BtrieveFileInformationGetRecordCount ( btrieveFileInformation );
+}	// long long BtrieveFileInformation::GetRecordCount
+
+
+long long BtrieveFileInformation::GetDuplicateRecordConflictCursorPosition ( )
+{
+	return BtrieveFileInformationGetDuplicateRecordConflictCursorPosition ( btrieveFileInformation );
+}	// long long BtrieveFileInformation::GetDuplicateRecordConflictCursorPosition
+
+
+long long BtrieveFileInformation::GetReferentialIntegrityCursorPosition ( )
+{
+	return BtrieveFileInformationGetReferentialIntegrityCursorPosition ( btrieveFileInformation );
+}	// long long BtrieveFileInformation::GetReferentialIntegrityCursorPosition
+
+
+Btrieve::RecordCompressionMode BtrieveFileInformation::GetRecordCompressionMode ( )
+{
+	return ( Btrieve::RecordCompressionMode ) BtrieveFileInformationGetRecordCompressionMode ( btrieveFileInformation );
+}	// Btrieve::RecordCompressionMode BtrieveFileInformation::GetRecordCompressionMode
+
+
+Btrieve::VariableLengthRecordsMode BtrieveFileInformation::GetVariableLengthRecordsMode ( )
+{
+	return ( Btrieve::VariableLengthRecordsMode ) BtrieveFileInformationGetVariableLengthRecordsMode ( btrieveFileInformation );
+}	// Btrieve::VariableLengthRecordsMode BtrieveFileInformation::GetVariableLengthRecordsMode
+
+
+Btrieve::Index BtrieveFileInformation::GetLogIndex ( )
+{
+	return ( Btrieve::Index ) BtrieveFileInformationGetLogIndex ( btrieveFileInformation );
+}	// Btrieve::Index BtrieveFileInformation::GetLogIndex
+
+
+Btrieve::Index BtrieveFileInformation::GetDuplicateRecordConflictIndex ( )
+{
+	return ( Btrieve::Index ) BtrieveFileInformationGetDuplicateRecordConflictIndex ( btrieveFileInformation );
+}	// Btrieve::Index BtrieveFileInformation::GetDuplicateRecordConflictIndex
+
+
+Btrieve::OwnerMode BtrieveFileInformation::GetOwnerMode ( )
+{
+	return ( Btrieve::OwnerMode ) BtrieveFileInformationGetOwnerMode ( btrieveFileInformation );
+}	// Btrieve::OwnerMode BtrieveFileInformation::GetOwnerMode
+
+
+Btrieve::LockMode BtrieveFileInformation::GetLockOwnerExplicitLockMode ( )
+{
+	return ( Btrieve::LockMode ) BtrieveFileInformationGetLockOwnerExplicitLockMode ( btrieveFileInformation );
+}	// Btrieve::LockMode BtrieveFileInformation::GetLockOwnerExplicitLockMode
+
+
+Btrieve::PageLockType BtrieveFileInformation::GetLockOwnerPageLockType ( )
+{
+	return ( Btrieve::PageLockType ) BtrieveFileInformationGetLockOwnerPageLockType ( btrieveFileInformation );
+}	// Btrieve::PageLockType BtrieveFileInformation::GetLockOwnerPageLockType
+
+
+Btrieve::Index BtrieveFileInformation::GetLockOwnerIndex ( )
+{
+	return ( Btrieve::Index ) BtrieveFileInformationGetLockOwnerIndex ( btrieveFileInformation );
+}	// Btrieve::Index BtrieveFileInformation::GetLockOwnerIndex
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetGatewayName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetGatewayName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetGatewayName
+
+
+const char* BtrieveFileInformation::GetGatewayName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetGatewayName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetGatewayName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetLockOwnerName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetLockOwnerName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetLockOwnerName
+
+
+const char* BtrieveFileInformation::GetLockOwnerName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetLockOwnerName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetLockOwnerName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetReferentialIntegrityFileName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetReferentialIntegrityFileName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetReferentialIntegrityFileName
+
+
+const char* BtrieveFileInformation::GetReferentialIntegrityFileName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetReferentialIntegrityFileName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetReferentialIntegrityFileName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetSecurityHandleDatabaseName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetSecurityHandleDatabaseName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetSecurityHandleDatabaseName
+
+
+const char* BtrieveFileInformation::GetSecurityHandleDatabaseName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetSecurityHandleDatabaseName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetSecurityHandleDatabaseName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetSecurityHandleTableName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetSecurityHandleTableName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetSecurityHandleTableName
+
+
+const char* BtrieveFileInformation::GetSecurityHandleTableName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetSecurityHandleTableName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetSecurityHandleTableName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetSecurityHandleUserName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetSecurityHandleUserName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetSecurityHandleUserName
+
+
+const char* BtrieveFileInformation::GetSecurityHandleUserName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetSecurityHandleUserName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetSecurityHandleUserName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetSecurityCurrentDatabaseName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetSecurityCurrentDatabaseName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetSecurityCurrentDatabaseName
+
+
+const char* BtrieveFileInformation::GetSecurityCurrentDatabaseName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetSecurityCurrentDatabaseName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetSecurityCurrentDatabaseName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetSecurityCurrentUserName ( char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetSecurityCurrentUserName ( btrieveFileInformation, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetSecurityCurrentUserName
+
+
+const char* BtrieveFileInformation::GetSecurityCurrentUserName ( )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetSecurityCurrentUserName ( btrieveFileInformation, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetSecurityCurrentUserName
+
+
+Btrieve::StatusCode BtrieveFileInformation::GetSegmentFileName ( int segmentFileNumber, char* name, int nameSize )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetSegmentFileName ( btrieveFileInformation, segmentFileNumber, name, nameSize );
+}	// Btrieve::StatusCode BtrieveFileInformation::GetSegmentFileName
+
+
+const char* BtrieveFileInformation::GetSegmentFileName ( int segmentFileNumber )
+{
+	static thread_local char name [ ENGINE_NAME_BUFFER_LENGTH ];
+
+	// If the name can't be retrieved.
+	if ( BtrieveFileInformationGetSegmentFileName ( btrieveFileInformation, segmentFileNumber, name, sizeof ( name ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return NULL;
+	}
+
+	return name;
+}	// const char* BtrieveFileInformation::GetSegmentFileName
+
+
+BtrieveFilter::BtrieveFilter ( )
+{
+	// If BtrieveFilterAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveFilterAllocate ( &btrieveFilter ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveFilter = NULL;
+	}
+}	// BtrieveFilter::BtrieveFilter
+
+
+BtrieveFilter::~BtrieveFilter ( )
+{
+	// If there's a handle to free.
+	if ( btrieveFilter != NULL )
+	{
+		BtrieveFilterFree ( btrieveFilter );
+	}
+}	// BtrieveFilter::~BtrieveFilter
+
+
+btrieve_filter_t BtrieveFilter::GetBtrieveFilter ( )
+{
+	return btrieveFilter;
+}	// btrieve_filter_t BtrieveFilter::GetBtrieveFilter
+
+
+Btrieve::StatusCode BtrieveFilter::SetComparison ( Btrieve::Comparison comparison )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetComparison ( btrieveFilter, ( btrieve_comparison_t ) comparison );
+}	// Btrieve::StatusCode BtrieveFilter::SetComparison
+
+
+Btrieve::StatusCode BtrieveFilter::SetComparisonConstant ( const char* constant, int constantLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetComparisonConstant ( btrieveFilter, constant, constantLength );
+}	// Btrieve::StatusCode BtrieveFilter::SetComparisonConstant
+
+
+Btrieve::StatusCode BtrieveFilter::SetComparisonField ( int offset )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetComparisonField ( btrieveFilter, offset );
+}	// Btrieve::StatusCode BtrieveFilter::SetComparisonField
+
+
+Btrieve::StatusCode BtrieveFilter::SetField ( int offset, int length, Btrieve::DataType dataType )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetField ( btrieveFilter, offset, length, ( btrieve_data_type_t ) dataType );
+}	// Btrieve::StatusCode BtrieveFilter::SetField
+
+
+Btrieve::StatusCode BtrieveFilter::SetLikeCodePageName ( const char* name )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetLikeCodePageName ( btrieveFilter, name );
+}	// Btrieve::StatusCode BtrieveFilter::SetLikeCodePageName
+
+
+Btrieve::StatusCode BtrieveFilter::SetConnector ( Btrieve::Connector connector )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetConnector ( btrieveFilter, ( btrieve_connector_t ) connector );
+}	// Btrieve::StatusCode BtrieveFilter::SetConnector
+
+
+Btrieve::StatusCode BtrieveFilter::SetACSMode ( Btrieve::ACSMode ACSMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetACSMode ( btrieveFilter, ( btrieve_acs_mode_t ) ACSMode );
+}	// Btrieve::StatusCode BtrieveFilter::SetACSMode
+
+
+Btrieve::StatusCode BtrieveFilter::SetACSUserDefined ( const char* name )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetACSUserDefined ( btrieveFilter, name );
+}	// Btrieve::StatusCode BtrieveFilter::SetACSUserDefined
+
+
+Btrieve::StatusCode BtrieveFilter::SetACSName ( const char* name )
+{
+	return ( Btrieve::StatusCode ) BtrieveFilterSetACSName ( btrieveFilter, name );
+}	// Btrieve::StatusCode BtrieveFilter::SetACSName
+
+
+BtrieveBulkRetrieveAttributes::BtrieveBulkRetrieveAttributes ( )
+{
+	// If BtrieveBulkRetrieveAttributesAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveBulkRetrieveAttributesAllocate ( &bulkRetrieveAttributes ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		bulkRetrieveAttributes = NULL;
+	}
+}	// BtrieveBulkRetrieveAttributes::BtrieveBulkRetrieveAttributes
+
+
+BtrieveBulkRetrieveAttributes::~BtrieveBulkRetrieveAttributes ( )
+{
+	// If there's a handle to free.
+	if ( bulkRetrieveAttributes != NULL )
+	{
+		BtrieveBulkRetrieveAttributesFree ( bulkRetrieveAttributes );
+	}
+}	// BtrieveBulkRetrieveAttributes::~BtrieveBulkRetrieveAttributes
+
+
+btrieve_bulk_retrieve_attributes_t BtrieveBulkRetrieveAttributes::GetBtrieveBulkRetrieveAttributes ( )
+{
+	return bulkRetrieveAttributes;
+}	// btrieve_bulk_retrieve_attributes_t BtrieveBulkRetrieveAttributes::GetBtrieveBulkRetrieveAttributes
+
+
+Btrieve::StatusCode BtrieveBulkRetrieveAttributes::AddField ( int offset, int length )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkRetrieveAttributesAddField ( bulkRetrieveAttributes, offset, length );
+}	// Btrieve::StatusCode BtrieveBulkRetrieveAttributes::AddField
+
+
+Btrieve::StatusCode BtrieveBulkRetrieveAttributes::AddFilter ( BtrieveFilter* btrieveFilter )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkRetrieveAttributesAddFilter ( bulkRetrieveAttributes, ( btrieveFilter == NULL ) ? NULL : btrieveFilter->GetBtrieveFilter ( ) );
+}	// Btrieve::StatusCode BtrieveBulkRetrieveAttributes::AddFilter
+
+
+Btrieve::StatusCode BtrieveBulkRetrieveAttributes::SetMaximumRecordCount ( int maximumRecordCount )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkRetrieveAttributesSetMaximumRecordCount ( bulkRetrieveAttributes, maximumRecordCount );
+}	// Btrieve::StatusCode BtrieveBulkRetrieveAttributes::SetMaximumRecordCount
+
+
+Btrieve::StatusCode BtrieveBulkRetrieveAttributes::SetMaximumRejectCount ( int maximumRejectCount )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkRetrieveAttributesSetMaximumRejectCount ( bulkRetrieveAttributes, maximumRejectCount );
+}	// Btrieve::StatusCode BtrieveBulkRetrieveAttributes::SetMaximumRejectCount
+
+
+Btrieve::StatusCode BtrieveBulkRetrieveAttributes::SetSkipCurrentRecord ( bool skipCurrentRecord )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkRetrieveAttributesSetSkipCurrentRecord ( bulkRetrieveAttributes, skipCurrentRecord ? 1 : 0 );
+}	// Btrieve::StatusCode BtrieveBulkRetrieveAttributes::SetSkipCurrentRecord
+
+
+BtrieveBulkRetrieveResult::BtrieveBulkRetrieveResult ( )
+{
+	// If BtrieveBulkRetrieveResultAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveBulkRetrieveResultAllocate ( &bulkRetrieveResult ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		bulkRetrieveResult = NULL;
+	}
+}	// BtrieveBulkRetrieveResult::BtrieveBulkRetrieveResult
+
+
+BtrieveBulkRetrieveResult::~BtrieveBulkRetrieveResult ( )
+{
+	// If there's a handle to free.
+	if ( bulkRetrieveResult != NULL )
+	{
+		BtrieveBulkRetrieveResultFree ( bulkRetrieveResult );
+	}
+}	// BtrieveBulkRetrieveResult::~BtrieveBulkRetrieveResult
+
+
+btrieve_bulk_retrieve_result_t BtrieveBulkRetrieveResult::GetBtrieveBulkRetrieveResult ( )
+{
+	return bulkRetrieveResult;
+}	// btrieve_bulk_retrieve_result_t BtrieveBulkRetrieveResult::GetBtrieveBulkRetrieveResult
+
+
+Btrieve::StatusCode BtrieveBulkRetrieveResult::GetLastStatusCode ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkRetrieveResultGetLastStatusCode ( bulkRetrieveResult );
+}	// Btrieve::StatusCode BtrieveBulkRetrieveResult::GetLastStatusCode
+
+
+int BtrieveBulkRetrieveResult::GetRecord ( int recordNumber, char* record, int recordSize )
+{
+	return BtrieveBulkRetrieveResultGetRecord ( bulkRetrieveResult, recordNumber, record, recordSize );
+}	// int BtrieveBulkRetrieveResult::GetRecord
+
+
+int BtrieveBulkRetrieveResult::GetRecordCount ( )
+{
+	return BtrieveBulkRetrieveResultGetRecordCount ( bulkRetrieveResult );
+}	// int BtrieveBulkRetrieveResult::GetRecordCount
+
+
+int BtrieveBulkRetrieveResult::GetRecordLength ( int recordNumber )
+{
+	return BtrieveBulkRetrieveResultGetRecordLength ( bulkRetrieveResult, recordNumber );
+}	// int BtrieveBulkRetrieveResult::GetRecordLength
+
+
+long long BtrieveBulkRetrieveResult::GetRecordCursorPosition ( int recordNumber )
+{
+	return BtrieveBulkRetrieveResultGetRecordCursorPosition ( bulkRetrieveResult, recordNumber );
+}	// long long BtrieveBulkRetrieveResult::GetRecordCursorPosition
+
+
+BtrieveIndexAttributes::BtrieveIndexAttributes ( )
+{
+	// If BtrieveIndexAttributesAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveIndexAttributesAllocate ( &btrieveIndexAttributes ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveIndexAttributes = NULL;
+	}
+}	// BtrieveIndexAttributes::BtrieveIndexAttributes
+
+
+BtrieveIndexAttributes::~BtrieveIndexAttributes ( )
+{
+	// If there's a handle to free.
+	if ( btrieveIndexAttributes != NULL )
+	{
+		BtrieveIndexAttributesFree ( btrieveIndexAttributes );
+	}
+}	// BtrieveIndexAttributes::~BtrieveIndexAttributes
+
+
+btrieve_index_attributes_t BtrieveIndexAttributes::GetBtrieveIndexAttributes ( )
+{
+	return btrieveIndexAttributes;
+}	// btrieve_index_attributes_t BtrieveIndexAttributes::GetBtrieveIndexAttributes
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::AddKeySegment ( BtrieveKeySegment* btrieveKeySegment )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesAddKeySegment ( btrieveIndexAttributes, ( btrieveKeySegment == NULL ) ? NULL : btrieveKeySegment->GetBtrieveKeySegment ( ) );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::AddKeySegment
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::SetIndex ( Btrieve::Index index )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesSetIndex ( btrieveIndexAttributes, ( btrieve_index_t ) index );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::SetIndex
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::SetDuplicateMode ( Btrieve::DuplicateMode duplicateMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesSetDuplicateMode ( btrieveIndexAttributes, ( btrieve_duplicate_mode_t ) duplicateMode );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::SetDuplicateMode
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::SetModifiable ( bool enableModifiable )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesSetModifiable ( btrieveIndexAttributes, enableModifiable ? 1 : 0 );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::SetModifiable
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::SetACSMode ( Btrieve::ACSMode ACSMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesSetACSMode ( btrieveIndexAttributes, ( btrieve_acs_mode_t ) ACSMode );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::SetACSMode
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::SetACSName ( const char* ACSName )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesSetACSName ( btrieveIndexAttributes, ACSName );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::SetACSName
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::SetACSNumber ( int ACSNumber )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesSetACSNumber ( btrieveIndexAttributes, ACSNumber );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::SetACSNumber
+
+
+Btrieve::StatusCode BtrieveIndexAttributes::SetACSUserDefined ( const char* ACSName, const char* ACSMap, int ACSMapLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveIndexAttributesSetACSUserDefined ( btrieveIndexAttributes, ACSName, ACSMap, ACSMapLength );
+}	// Btrieve::StatusCode BtrieveIndexAttributes::SetACSUserDefined
+
+
+BtrieveBulkCreatePayload::BtrieveBulkCreatePayload ( )
+{
+	// If BtrieveBulkCreatePayloadAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveBulkCreatePayloadAllocate ( &btrieveBulkCreatePayload ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveBulkCreatePayload = NULL;
+	}
+}	// BtrieveBulkCreatePayload::BtrieveBulkCreatePayload
+
+
+BtrieveBulkCreatePayload::~BtrieveBulkCreatePayload ( )
+{
+	// If there's a handle to free.
+	if ( btrieveBulkCreatePayload != NULL )
+	{
+		BtrieveBulkCreatePayloadFree ( btrieveBulkCreatePayload );
+	}
+}	// BtrieveBulkCreatePayload::~BtrieveBulkCreatePayload
+
+
+btrieve_bulk_create_payload_t BtrieveBulkCreatePayload::GetBtrieveBulkCreatePayload ( )
+{
+	return btrieveBulkCreatePayload;
+}	// btrieve_bulk_create_payload_t BtrieveBulkCreatePayload::GetBtrieveBulkCreatePayload
+
+
+Btrieve::StatusCode BtrieveBulkCreatePayload::AddRecord ( const char* record, int recordLength )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkCreatePayloadAddRecord ( btrieveBulkCreatePayload, record, recordLength );
+}	// Btrieve::StatusCode BtrieveBulkCreatePayload::AddRecord
+
+
+BtrieveBulkCreateResult::BtrieveBulkCreateResult ( )
+{
+	// If BtrieveBulkCreateResultAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveBulkCreateResultAllocate ( &btrieveBulkCreateResult ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveBulkCreateResult = NULL;
+	}
+}	// BtrieveBulkCreateResult::BtrieveBulkCreateResult
+
+
+BtrieveBulkCreateResult::~BtrieveBulkCreateResult ( )
+{
+	// If there's a handle to free.
+	if ( btrieveBulkCreateResult != NULL )
+	{
+		BtrieveBulkCreateResultFree ( btrieveBulkCreateResult );
+	}
+}	// BtrieveBulkCreateResult::~BtrieveBulkCreateResult
+
+
+btrieve_bulk_create_result_t BtrieveBulkCreateResult::GetBtrieveBulkCreateResult ( )
+{
+	return btrieveBulkCreateResult;
+}	// btrieve_bulk_create_result_t BtrieveBulkCreateResult::GetBtrieveBulkCreateResult
+
+
+Btrieve::StatusCode BtrieveBulkCreateResult::GetLastStatusCode ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveBulkCreateResultGetLastStatusCode ( btrieveBulkCreateResult );
+}	// Btrieve::StatusCode BtrieveBulkCreateResult::GetLastStatusCode
+
+
+int BtrieveBulkCreateResult::GetRecordCount ( )
+{
+	return BtrieveBulkCreateResultGetRecordCount ( btrieveBulkCreateResult );
+}	// int BtrieveBulkCreateResult::GetRecordCount
+
+
+long long BtrieveBulkCreateResult::GetRecordCursorPosition ( int recordNumber )
+{
+	return BtrieveBulkCreateResultGetRecordCursorPosition ( btrieveBulkCreateResult, recordNumber );
+}	// long long BtrieveBulkCreateResult::GetRecordCursorPosition
+
+
+BtrieveKeySegment::BtrieveKeySegment ( )
+{
+	// If BtrieveKeySegmentAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveKeySegmentAllocate ( &btrieveKeySegment ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveKeySegment = NULL;
+	}
+}	// BtrieveKeySegment::BtrieveKeySegment
+
+
+BtrieveKeySegment::BtrieveKeySegment ( btrieve_key_segment_t btrieveKeySegmentIn )
+{
+	btrieveKeySegment = btrieveKeySegmentIn;
+}	// BtrieveKeySegment::BtrieveKeySegment
+
+
+BtrieveKeySegment::~BtrieveKeySegment ( )
+{
+	// If there's a handle to free.
+	if ( btrieveKeySegment != NULL )
+	{
+		BtrieveKeySegmentFree ( btrieveKeySegment );
+	}
+}	// BtrieveKeySegment::~BtrieveKeySegment
+
+
+btrieve_key_segment_t BtrieveKeySegment::GetBtrieveKeySegment ( )
+{
+	return btrieveKeySegment;
+}	// btrieve_key_segment_t BtrieveKeySegment::GetBtrieveKeySegment
+
+
+Btrieve::StatusCode BtrieveKeySegment::GetLastStatusCode ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveKeySegmentGetLastStatusCode ( btrieveKeySegment );
+}	// Btrieve::StatusCode BtrieveKeySegment::GetLastStatusCode
+
+
+Btrieve::ACSMode BtrieveKeySegment::GetACSMode ( )
+{
+	return ( Btrieve::ACSMode ) BtrieveKeySegmentGetACSMode ( btrieveKeySegment );
+}	// Btrieve::ACSMode BtrieveKeySegment::GetACSMode
+
+
+Btrieve::DataType BtrieveKeySegment::GetDataType ( )
+{
+	return ( Btrieve::DataType ) BtrieveKeySegmentGetDataType ( btrieveKeySegment );
+}	// Btrieve::DataType BtrieveKeySegment::GetDataType
+
+
+Btrieve::DuplicateMode BtrieveKeySegment::GetDuplicateMode ( )
+{
+	return ( Btrieve::DuplicateMode ) BtrieveKeySegmentGetDuplicateMode ( btrieveKeySegment );
+}	// Btrieve::DuplicateMode BtrieveKeySegment::GetDuplicateMode
+
+
+Btrieve::Index BtrieveKeySegment::GetIndex ( )
+{
+	return ( Btrieve::Index ) BtrieveKeySegmentGetIndex ( btrieveKeySegment );
+}	// Btrieve::Index BtrieveKeySegment::GetIndex
+
+
+Btrieve::NullKeyMode BtrieveKeySegment::GetNullKeyMode ( )
+{
+	return ( Btrieve::NullKeyMode ) BtrieveKeySegmentGetNullKeyMode ( btrieveKeySegment );
+}	// Btrieve::NullKeyMode BtrieveKeySegment::GetNullKeyMode
+
+
+int BtrieveKeySegment::GetModifiable ( )
+{
+	return BtrieveKeySegmentGetModifiable ( btrieveKeySegment );
+}	// int BtrieveKeySegment::GetModifiable
+
+
+int BtrieveKeySegment::GetKeyContinues ( )
+{
+	return BtrieveKeySegmentGetKeyContinues ( btrieveKeySegment );
+}	// int BtrieveKeySegment::GetKeyContinues
+
+
+int BtrieveKeySegment::GetACSNumber ( )
+{
+	return BtrieveKeySegmentGetACSNumber ( btrieveKeySegment );
+}	// int BtrieveKeySegment::GetACSNumber
+
+
+int BtrieveKeySegment::GetDescendingSortOrder ( )
+{
+	return BtrieveKeySegmentGetDescendingSortOrder ( btrieveKeySegment );
+}	// int BtrieveKeySegment::GetDescendingSortOrder
+
+
+int BtrieveKeySegment::GetLength ( )
+{
+	return BtrieveKeySegmentGetLength ( btrieveKeySegment );
+}	// int BtrieveKeySegment::GetLength
+
+
+int BtrieveKeySegment::GetNullValue ( )
+{
+	return BtrieveKeySegmentGetNullValue ( btrieveKeySegment );
+}	// int BtrieveKeySegment::GetNullValue
+
+
+int BtrieveKeySegment::GetOffset ( )
+{
+	return BtrieveKeySegmentGetOffset ( btrieveKeySegment );
+}	// int BtrieveKeySegment::GetOffset
+
+
+long long BtrieveKeySegment::GetUniqueValueCount ( )
+{
+	return BtrieveKeySegmentGetUniqueValueCount ( btrieveKeySegment );
+}	// long long BtrieveKeySegment::GetUniqueValueCount
+
+
+Btrieve::StatusCode BtrieveKeySegment::SetDescendingSortOrder ( bool setDescendingSortOrder )
+{
+	return ( Btrieve::StatusCode ) BtrieveKeySegmentSetDescendingSortOrder ( btrieveKeySegment, setDescendingSortOrder ? 1 : 0 );
+}	// Btrieve::StatusCode BtrieveKeySegment::SetDescendingSortOrder
+
+
+Btrieve::StatusCode BtrieveKeySegment::SetField ( int offset, int length, Btrieve::DataType dataType )
+{
+	return ( Btrieve::StatusCode ) BtrieveKeySegmentSetField ( btrieveKeySegment, offset, length, ( btrieve_data_type_t ) dataType );
+}	// Btrieve::StatusCode BtrieveKeySegment::SetField
+
+
+Btrieve::StatusCode BtrieveKeySegment::SetNullKeyMode ( Btrieve::NullKeyMode nullKeyMode )
+{
+	return ( Btrieve::StatusCode ) BtrieveKeySegmentSetNullKeyMode ( btrieveKeySegment, ( btrieve_null_key_mode_t ) nullKeyMode );
+}	// Btrieve::StatusCode BtrieveKeySegment::SetNullKeyMode
+
+
+Btrieve::StatusCode BtrieveKeySegment::SetNullValue ( int nullValue )
+{
+	return ( Btrieve::StatusCode ) BtrieveKeySegmentSetNullValue ( btrieveKeySegment, nullValue );
+}	// Btrieve::StatusCode BtrieveKeySegment::SetNullValue
+
+
+BtrieveVersion::BtrieveVersion ( )
+{
+	// If BtrieveVersionAllocate ( ) fails, every method reports the missing handle.
+	if ( BtrieveVersionAllocate ( &btrieveVersion ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		btrieveVersion = NULL;
+	}
+}	// BtrieveVersion::BtrieveVersion
+
+
+BtrieveVersion::~BtrieveVersion ( )
+{
+	// If there's a handle to free.
+	if ( btrieveVersion != NULL )
+	{
+		BtrieveVersionFree ( btrieveVersion );
+	}
+}	// BtrieveVersion::~BtrieveVersion
+
+
+btrieve_version_t BtrieveVersion::GetBtrieveVersion ( )
+{
+	return btrieveVersion;
+}	// btrieve_version_t BtrieveVersion::GetBtrieveVersion
+
+
+Btrieve::StatusCode BtrieveVersion::GetLastStatusCode ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveVersionGetLastStatusCode ( btrieveVersion );
+}	// Btrieve::StatusCode BtrieveVersion::GetLastStatusCode
+
+
+Btrieve::VersionType BtrieveVersion::GetClientVersionType ( )
+{
+	return ( Btrieve::VersionType ) BtrieveVersionGetClientVersionType ( btrieveVersion );
+}	// Btrieve::VersionType BtrieveVersion::GetClientVersionType
+
+
+Btrieve::VersionType BtrieveVersion::GetRemoteVersionType ( )
+{
+	return ( Btrieve::VersionType ) BtrieveVersionGetRemoteVersionType ( btrieveVersion );
+}	// Btrieve::VersionType BtrieveVersion::GetRemoteVersionType
+
+
+Btrieve::VersionType BtrieveVersion::GetLocalVersionType ( )
+{
+	return ( Btrieve::VersionType ) BtrieveVersionGetLocalVersionType ( btrieveVersion );
+}	// Btrieve::VersionType BtrieveVersion::GetLocalVersionType
+
+
+int BtrieveVersion::GetClientRevisionNumber ( )
+{
+	return BtrieveVersionGetClientRevisionNumber ( btrieveVersion );
+}	// int BtrieveVersion::GetClientRevisionNumber
+
+
+int BtrieveVersion::GetClientVersionNumber ( )
+{
+	return BtrieveVersionGetClientVersionNumber ( btrieveVersion );
+}	// int BtrieveVersion::GetClientVersionNumber
+
+
+int BtrieveVersion::GetRemoteRevisionNumber ( )
+{
+	return BtrieveVersionGetRemoteRevisionNumber ( btrieveVersion );
+}	// int BtrieveVersion::GetRemoteRevisionNumber
+
+
+int BtrieveVersion::GetRemoteVersionNumber ( )
+{
+	return BtrieveVersionGetRemoteVersionNumber ( btrieveVersion );
+}	// int BtrieveVersion::GetRemoteVersionNumber
+
+
+int BtrieveVersion::GetLocalRevisionNumber ( )
+{
+	return BtrieveVersionGetLocalRevisionNumber ( btrieveVersion );
+}	// int BtrieveVersion::GetLocalRevisionNumber
+
+
+int BtrieveVersion::GetLocalVersionNumber ( )
+{
+	return BtrieveVersionGetLocalVersionNumber ( btrieveVersion );
+}	// int BtrieveVersion::GetLocalVersionNumber
+
+
+BtrieveCollection::BtrieveCollection ( )
+{
+	btrieveClient = NULL;
+	btrieveFile = NULL;
+	lastStatusCode = Btrieve::STATUS_CODE_NO_ERROR;
+}	// BtrieveCollection::BtrieveCollection
+
+
+BtrieveCollection::~BtrieveCollection ( )
+{
+}	// BtrieveCollection::~BtrieveCollection
+
+
+void BtrieveCollection::SetBtrieveClient ( BtrieveClient* btrieveClientIn )
+{
+	btrieveClient = btrieveClientIn;
+}	// void BtrieveCollection::SetBtrieveClient
+
+
+BtrieveFile* BtrieveCollection::GetBtrieveFile ( )
+{
+	return btrieveFile;
+}	// BtrieveFile* BtrieveCollection::GetBtrieveFile
+
+
+long long BtrieveCollection::DocumentCreate ( const char* json, const char* blob, int blobLength )
+{
+	( void ) json;
+	( void ) blob;
+	( void ) blobLength;
+
+	lastStatusCode = Btrieve::STATUS_CODE_INVALID_FUNCTION;
+	return -1;
+}	// long long BtrieveCollection::DocumentCreate
+
+
+const char* BtrieveCollection::DocumentRetrieve ( long long id, char* blob, int blobSize )
+{
+	( void ) id;
+	( void ) blob;
+	( void ) blobSize;
+
+	lastStatusCode = Btrieve::STATUS_CODE_INVALID_FUNCTION;
+	return NULL;
+}	// const char* BtrieveCollection::DocumentRetrieve
+
+
+const char* BtrieveCollection::DocumentRetrieve ( long long id )
+{
+	return DocumentRetrieve ( id, NULL, 0 );
+}	// const char* BtrieveCollection::DocumentRetrieve
+
+
+Btrieve::StatusCode BtrieveCollection::DocumentUpdate ( long long id, const char* json, const char* blob, int blobLength )
+{
+	( void ) id;
+	( void ) json;
+	( void ) blob;
+	( void ) blobLength;
+
+	return lastStatusCode = Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveCollection::DocumentUpdate
+
+
+Btrieve::StatusCode BtrieveCollection::DocumentDelete ( long long id )
+{
+	( void ) id;
+
+	return lastStatusCode = Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveCollection::DocumentDelete
+
+
+Btrieve::StatusCode BtrieveCollection::Query ( BtrieveDocumentSet* btrieveDocumentSet, const char* query )
+{
+	( void ) btrieveDocumentSet;
+	( void ) query;
+
+	return lastStatusCode = Btrieve::STATUS_CODE_INVALID_FUNCTION;
+}	// Btrieve::StatusCode BtrieveCollection::Query
+
+
+Btrieve::StatusCode BtrieveCollection::GetLastStatusCode ( )
+{
+	return lastStatusCode;
+}	// Btrieve::StatusCode BtrieveCollection::GetLastStatusCode
+
+
+BtrieveDocumentSet::BtrieveDocumentSet ( )
+{
+	stdSet = new std::set<long long> ( );
+	lastStatusCode = Btrieve::STATUS_CODE_NO_ERROR;
+}	// BtrieveDocumentSet::BtrieveDocumentSet
+
+
+BtrieveDocumentSet::~BtrieveDocumentSet ( )
+{
+	delete stdSet;
+}	// BtrieveDocumentSet::~BtrieveDocumentSet
+
+
+std::set<long long>* BtrieveDocumentSet::GetStdSet ( )
+{
+	return stdSet;
+}	// std::set<long long>* BtrieveDocumentSet::GetStdSet
+
+
+long long BtrieveDocumentSet::Size ( )
+{
+	lastStatusCode = Btrieve::STATUS_CODE_NO_ERROR;
+	return ( long long ) stdSet->size ( );
+}	// long long BtrieveDocumentSet::Size
+
+
+long long BtrieveDocumentSet::Pop ( )
+{
+	long long id;
+
+	// If the set is empty.
+	if ( stdSet->empty ( ) )
+	{
+		lastStatusCode = Btrieve::STATUS_CODE_END_OF_FILE;
+		return -1;
+	}
+
+	id = *stdSet->begin ( );
+	stdSet->erase ( stdSet->begin ( ) );
+	lastStatusCode = Btrieve::STATUS_CODE_NO_ERROR;
+	return id;
+}	// long long BtrieveDocumentSet::Pop
+
+
+Btrieve::StatusCode BtrieveDocumentSet::GetLastStatusCode ( )
+{
+	return lastStatusCode;
+}	// Btrieve::StatusCode BtrieveDocumentSet::GetLastStatusCode
@@ -0,0 +1,219 @@
+// btrieveEngineCpp.cpp : The classes of btrieveEngineCpp.h, implemented over
+//                        the btrieveEngineC.h entry points.
+//
+
+#include <string.h>
+
+#include <btrieveEngineCpp.h>
+
+
+// Reaches the handle of a BtrieveFile, which BtrieveFile only shows its friends and subclasses.
+class BtrieveFileHandle : public BtrieveFile
+{
+public:
+	static btrieve_file_t Get ( BtrieveFile* btrieveFile )
+	{
+		btrieve_file_t ( BtrieveFile::*getBtrieveFile ) ( ) = &BtrieveFileHandle::GetBtrieveFile;
+
+		return ( btrieveFile == NULL ) ? NULL : ( btrieveFile->*getBtrieveFile ) ( );
+	}	// static btrieve_file_t Get
+};	// class BtrieveFileHandle
+
+
+// Reaches the handle of a BtrieveFileInformation the same way.
+class BtrieveFileInformationHandle : public BtrieveFileInformation
+{
+public:
+	static btrieve_file_information_t Get ( BtrieveFileInformation* btrieveFileInformation )
+	{
+		btrieve_file_information_t ( BtrieveFileInformation::*getBtrieveFileInformation ) ( ) = &BtrieveFileInformationHandle::GetBtrieveFileInformation;
+
+		return ( btrieveFileInformation == NULL ) ? NULL : ( btrieveFileInformation->*getBtrieveFileInformation ) ( );
+	}	// static btrieve_file_information_t Get
+};	// class BtrieveFileInformationHandle
+
+
+// Reaches the handle of a BtrieveIndexAttributes the same way.
+class BtrieveIndexAttributesHandle : public BtrieveIndexAttributes
+{
+public:
+	static btrieve_index_attributes_t Get ( BtrieveIndexAttributes* btrieveIndexAttributes )
+	{
+		btrieve_index_attributes_t ( BtrieveIndexAttributes::*getBtrieveIndexAttributes ) ( ) = &BtrieveIndexAttributesHandle::GetBtrieveIndexAttributes;
+
+		return ( btrieveIndexAttributes == NULL ) ? NULL : ( btrieveIndexAttributes->*getBtrieveIndexAttributes ) ( );
+	}	// static btrieve_index_attributes_t Get
+};	// class BtrieveIndexAttributesHandle
+
+
+BtrieveRecordView::BtrieveRecordView ( )
+{
+	btrieveFile = NULL;
+	memset ( &view, 0, sizeof ( view ) );
+}	// BtrieveRecordView::BtrieveRecordView
+
+
+bool BtrieveRecordView::IsValid ( ) const
+{
+	return BtrieveFileIsRecordViewValid ( btrieveFile, &view ) != 0;
+}	// bool BtrieveRecordView::IsValid
+
+
+bool BtrieveRecordView::IsCurrent ( ) const
+{
+	return BtrieveFileIsRecordViewCurrent ( btrieveFile, &view ) != 0;
+}	// bool BtrieveRecordView::IsCurrent
+
+
+BtrieveRecordViewer::BtrieveRecordViewer ( BtrieveFile* btrieveFileIn )
+{
+	btrieveFile = btrieveFileIn;
+}	// BtrieveRecordViewer::BtrieveRecordViewer
+
+
+btrieve_file_t BtrieveRecordViewer::GetBtrieveFile ( )
+{
+	return BtrieveFileHandle::Get ( btrieveFile );
+}	// btrieve_file_t BtrieveRecordViewer::GetBtrieveFile
+
+
+Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieve ( Btrieve::Comparison comparison, Btrieve::Index index, const char* key, int keyLength, BtrieveRecordView* btrieveRecordView, Btrieve::LockMode lockMode )
+{
+	// If there's no view.
+	if ( btrieveRecordView == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	btrieveRecordView->btrieveFile = GetBtrieveFile ( );
+	return ( Btrieve::StatusCode ) BtrieveFileRecordRetrieveView ( btrieveRecordView->btrieveFile, ( btrieve_comparison_t ) comparison, ( btrieve_index_t ) index, key, keyLength, &btrieveRecordView->view, ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieve
+
+
+Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieveFirst ( Btrieve::Index index, BtrieveRecordView* btrieveRecordView, Btrieve::LockMode lockMode )
+{
+	// If there's no view.
+	if ( btrieveRecordView == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	btrieveRecordView->btrieveFile = GetBtrieveFile ( );
+	return ( Btrieve::StatusCode ) BtrieveFileRecordRetrieveFirstView ( btrieveRecordView->btrieveFile, ( btrieve_index_t ) index, &btrieveRecordView->view, ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieveFirst
+
+
+Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieveLast ( Btrieve::Index index, BtrieveRecordView* btrieveRecordView, Btrieve::LockMode lockMode )
+{
+	// If there's no view.
+	if ( btrieveRecordView == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	btrieveRecordView->btrieveFile = GetBtrieveFile ( );
+	return ( Btrieve::StatusCode ) BtrieveFileRecordRetrieveLastView ( btrieveRecordView->btrieveFile, ( btrieve_index_t ) index, &btrieveRecordView->view, ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieveLast
+
+
+Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieveNext ( BtrieveRecordView* btrieveRecordView, Btrieve::LockMode lockMode )
+{
+	// If there's no view.
+	if ( btrieveRecordView == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	btrieveRecordView->btrieveFile = GetBtrieveFile ( );
+	return ( Btrieve::StatusCode ) BtrieveFileRecordRetrieveNextView ( btrieveRecordView->btrieveFile, &btrieveRecordView->view, ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveRecordViewer::RecordRetrieveNext
+
+
+Btrieve::StatusCode BtrieveRecordViewer::RecordRetrievePrevious ( BtrieveRecordView* btrieveRecordView, Btrieve::LockMode lockMode )
+{
+	// If there's no view.
+	if ( btrieveRecordView == NULL )
+	{
+		return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	btrieveRecordView->btrieveFile = GetBtrieveFile ( );
+	return ( Btrieve::StatusCode ) BtrieveFileRecordRetrievePreviousView ( btrieveRecordView->btrieveFile, &btrieveRecordView->view, ( btrieve_lock_mode_t ) lockMode );
+}	// Btrieve::StatusCode BtrieveRecordViewer::RecordRetrievePrevious
+
+
+Btrieve::StatusCode BtrieveRecordViewer::Release ( )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileReleaseRecordView ( GetBtrieveFile ( ) );
+}	// Btrieve::StatusCode BtrieveRecordViewer::Release
+
+
+BtrieveMultiGetter::BtrieveMultiGetter ( BtrieveFile* btrieveFileIn )
+{
+	btrieveFile = btrieveFileIn;
+	memset ( &statistics, 0, sizeof ( statistics ) );
+}	// BtrieveMultiGetter::BtrieveMultiGetter
+
+
+btrieve_file_t BtrieveMultiGetter::GetBtrieveFile ( )
+{
+	return BtrieveFileHandle::Get ( btrieveFile );
+}	// btrieve_file_t BtrieveMultiGetter::GetBtrieveFile
+
+
+Btrieve::StatusCode BtrieveMultiGetter::MultiGet ( Btrieve::Index index, const char* keys, int keyLength, int keyCount, char* records, int recordSize, int* recordLengths, Btrieve::StatusCode* statusCodes )
+{
+	static_assert ( sizeof ( Btrieve::StatusCode ) == sizeof ( btrieve_status_code_t ), "status codes are passed through as is" );
+
+	memset ( &statistics, 0, sizeof ( statistics ) );
+	return ( Btrieve::StatusCode ) BtrieveFileMultiGet ( GetBtrieveFile ( ), ( btrieve_index_t ) index, keys, keyLength, keyCount, records, recordSize, recordLengths, ( btrieve_status_code_t* ) statusCodes, &statistics );
+}	// Btrieve::StatusCode BtrieveMultiGetter::MultiGet
+
+
+BtrieveBloomFilterStatistics::BtrieveBloomFilterStatistics ( )
+{
+	memset ( &statistics, 0, sizeof ( statistics ) );
+}	// BtrieveBloomFilterStatistics::BtrieveBloomFilterStatistics
+
+
+Btrieve::StatusCode BtrieveBloomFilterStatistics::Get ( BtrieveFileInformation* btrieveFileInformation, Btrieve::Index index )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileInformationGetBloomFilterStatistics ( BtrieveFileInformationHandle::Get ( btrieveFileInformation ), ( btrieve_index_t ) index, &statistics );
+}	// Btrieve::StatusCode BtrieveBloomFilterStatistics::Get
+
+
+BtrieveIndexBuilder::BtrieveIndexBuilder ( BtrieveFile* btrieveFileIn )
+{
+	btrieveFile = btrieveFileIn;
+	memset ( &options, 0, sizeof ( options ) );
+}	// BtrieveIndexBuilder::BtrieveIndexBuilder
+
+
+btrieve_file_t BtrieveIndexBuilder::GetBtrieveFile ( )
+{
+	return BtrieveFileHandle::Get ( btrieveFile );
+}	// btrieve_file_t BtrieveIndexBuilder::GetBtrieveFile
+
+
+Btrieve::StatusCode BtrieveIndexBuilder::IndexCreate ( BtrieveIndexAttributes* btrieveIndexAttributes )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileIndexCreateWithOptions ( GetBtrieveFile ( ), BtrieveIndexAttributesHandle::Get ( btrieveIndexAttributes ), &options );
+}	// Btrieve::StatusCode BtrieveIndexBuilder::IndexCreate
+
+
+BtrieveAccessHinter::BtrieveAccessHinter ( BtrieveFile* btrieveFileIn )
+{
+	btrieveFile = btrieveFileIn;
+}	// BtrieveAccessHinter::BtrieveAccessHinter
+
+
+btrieve_file_t BtrieveAccessHinter::GetBtrieveFile ( )
+{
+	return BtrieveFileHandle::Get ( btrieveFile );
+}	// btrieve_file_t BtrieveAccessHinter::GetBtrieveFile
+
+
+Btrieve::StatusCode BtrieveAccessHinter::SetAccessHint ( btrieve_access_hint_t hint )
+{
+	return ( Btrieve::StatusCode ) BtrieveFileSetAccessHint ( GetBtrieveFile ( ), hint );
+}	// Btrieve::StatusCode BtrieveAccessHinter::SetAccessHint
@@ -0,0 +1,1422 @@
+// btrieveFile.cpp : The record, key and cursor entry points of the
+//                   btrieveC.h interface.
+//
+// Every entry point takes the shared file's latch: shared for reads and
+// exclusive for writes. A handle's cursor is the index it follows, the
+// key and cursor position of its record, and a hint to the record's leaf
+// entry that stays valid while the file is unchanged.
+//
+
+#include <string.h>
+
+#include "engine.h"
+
+using namespace BtrieveEngine;
+
+#define ENGINE_PERCENTAGE_DENOMINATOR 10000
+
+namespace BtrieveEngine
+{
+
+btrieve_status_code_t SetFileStatus ( btrieve_file* file, btrieve_status_code_t status )
+{
+	file->lastStatusCode = status;
+	return status;
+}	// btrieve_status_code_t SetFileStatus
+
+
+btrieve_status_code_t CheckFileOpen ( btrieve_file* file )
+{
+	// If there's no handle.
+	if ( file == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_FILE_NOT_OPEN;
+	}
+
+	// If the handle was closed by its client.
+	if ( file->shared == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_FILE_NOT_OPEN );
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t CheckFileOpen
+
+
+btrieve_status_code_t BeginFileWrite ( btrieve_file* file )
+{
+	SharedFile* shared = file->shared.get ( );
+	btrieve_client* client = file->client;
+
+	// If the handle or the file can only be read.
+	if ( file->openMode == BTRIEVE_OPEN_MODE_READ_ONLY || shared->readOnly )
+	{
+		return BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED;
+	}
+
+	// If the client's transaction must take in the file.
+	if ( client->transactionActive )
+	{
+		btrieve_status_code_t status;
+
+		// If the file is already in the transaction.
+		if ( shared->IsTransactionOwner ( client ) )
+		{
+			return BTRIEVE_STATUS_CODE_NO_ERROR;
+		}
+
+		// If JoinTransaction ( ) fails.
+		if ( ( status = shared->JoinTransaction ( client ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		client->transactionFiles.push_back ( file->shared );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}	// if ( client->transactionActive )
+
+	// If another client's transaction holds the file.
+	if ( shared->IsLockedByOther ( client ) )
+	{
+		return BTRIEVE_STATUS_CODE_FILE_INUSE;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BeginFileWrite
+
+
+// End the handle's record view: unpin its page and, if views are checked,
+// spoil its copy and keep it aside until the next view ends, so a stale
+// pointer reads the poison rather than the next view's record.
+void InvalidateRecordView ( btrieve_file* file )
+{
+	file->viewGeneration++;
+	file->viewPage.Release ( );
+
+	// If a checked view's copy may still be read through a stale pointer.
+	if ( file->checkViews && !file->viewRecord.empty ( ) )
+	{
+		memset ( &file->viewRecord [ 0 ], ENGINE_VIEW_POISON, file->viewRecord.size ( ) );
+		file->viewRecord.swap ( file->viewRetired );
+		file->viewRecord.clear ( );
+	}
+}	// void InvalidateRecordView
+
+
+void SetCursor ( btrieve_file* file, int index, uint64_t address, const uint8_t* key, const TreePosition* hint )
+{
+	Cursor& cursor = file->cursor;
+
+	InvalidateRecordView ( file );
+	cursor.established = true;
+	cursor.recordLoaded = true;
+	cursor.index = index;
+	cursor.address = address;
+	cursor.currentOffset = -1;
+
+	// If the cursor follows an index, keep the key to find the entry again.
+	if ( key != NULL && index != BTRIEVE_INDEX_NONE )
+	{
+		IndexDefinition* definition = file->shared->FindIndex ( index );
+
+		cursor.key.assign ( key, key + definition->keyLength );
+	}
+	else
+	{
+		cursor.key.clear ( );
+	}
+
+	// If there's a leaf entry to remember.
+	if ( hint != NULL )
+	{
+		cursor.hint = *hint;
+		cursor.hintStamp = file->shared->GetStamp ( );
+	}
+	else
+	{
+		cursor.hint.page = 0;
+		cursor.hint.slot = 0;
+		cursor.hintStamp = 0;
+	}
+}	// void SetCursor
+
+
+// Set the cursor to a record, following an index if one is given.
+static btrieve_status_code_t SetCursorToRecord ( btrieve_file* file, int index, uint64_t address, const uint8_t* record )
+{
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+
+	// If the cursor goes in physical order.
+	if ( index == BTRIEVE_INDEX_NONE )
+	{
+		SetCursor ( file, BTRIEVE_INDEX_NONE, address, NULL, NULL );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	IndexDefinition* definition = file->shared->FindIndex ( index );
+
+	// If the index doesn't exist.
+	if ( definition == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+	}
+
+	// A record left out of the index by its null key still orders by its key.
+	ExtractKey ( *definition, record, key );
+	SetCursor ( file, index, address, key, NULL );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// static btrieve_status_code_t SetCursorToRecord
+
+
+btrieve_status_code_t MoveCursor ( btrieve_file* file, bool forward )
+{
+	SharedFile* shared = file->shared.get ( );
+	Cursor& cursor = file->cursor;
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint64_t address = cursor.address;
+	TreePosition position;
+
+	// If there's no position to move from.
+	if ( !cursor.established )
+	{
+		return BTRIEVE_STATUS_CODE_POSITION_NOT_SET;
+	}
+
+	// If the cursor goes in physical order.
+	if ( cursor.index == BTRIEVE_INDEX_NONE )
+	{
+		// If there's no record in that direction.
+		if ( !( forward ? shared->NextPhysical ( &address ) : shared->PreviousPhysical ( &address ) ) )
+		{
+			return BTRIEVE_STATUS_CODE_END_OF_FILE;
+		}
+
+		SetCursor ( file, BTRIEVE_INDEX_NONE, address, NULL, NULL );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}	// if ( cursor.index == BTRIEVE_INDEX_NONE )
+
+	IndexDefinition* definition = shared->FindIndex ( cursor.index );
+
+	// If the index was dropped.
+	if ( definition == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+	}
+
+	BTree tree ( shared, definition );
+	bool exact;
+
+	// If the file is unchanged the hint is the cursor's entry; otherwise search for it.
+	if ( cursor.hintStamp == shared->GetStamp ( ) && cursor.hint.page != 0 )
+	{
+		position = cursor.hint;
+		exact = true;
+	}
+	else
+	{
+		uint64_t entryAddress;
+
+		// If LowerBound ( ) fails.
+		if ( !tree.LowerBound ( &cursor.key [ 0 ], cursor.address, ADDRESS_MODE_EXACT, &position ) )
+		{
+			return BTRIEVE_STATUS_CODE_IO_ERROR;
+		}
+
+		exact = position.page != 0
+			&& tree.ReadEntry ( position, key, &entryAddress )
+			&& entryAddress == cursor.address
+			&& memcmp ( key, &cursor.key [ 0 ], definition->keyLength ) == 0;
+	}
+
+	// Step from the entry, or from where the entry would be.
+	if ( forward )
+	{
+		// If the position is the cursor's entry, step past it.
+		if ( exact && !tree.Next ( &position ) )
+		{
+			return BTRIEVE_STATUS_CODE_IO_ERROR;
+		}
+	}
+	else if ( position.page == 0 )
+	{
+		// If Last ( ) fails.
+		if ( !tree.Last ( &position ) )
+		{
+			return BTRIEVE_STATUS_CODE_IO_ERROR;
+		}
+	}
+	else if ( !tree.Previous ( &position ) )
+	{
+		return BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	// If there's no entry in that direction.
+	if ( position.page == 0 )
+	{
+		return BTRIEVE_STATUS_CODE_END_OF_FILE;
+	}
+
+	// If ReadEntry ( ) fails.
+	if ( !tree.ReadEntry ( position, key, &address ) )
+	{
+		return BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	SetCursor ( file, cursor.index, address, key, &position );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t MoveCursor
+
+
+// Position the cursor on the first entry of an index that satisfies a comparison with a key.
+btrieve_status_code_t SeekCursor ( btrieve_file* file, btrieve_comparison_t comparison, int index, const uint8_t* searchKey, int keyLength )
+{
+	SharedFile* shared = file->shared.get ( );
+	IndexDefinition* definition = shared->FindIndex ( index );
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint8_t entryKey [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint64_t address;
+	TreePosition position;
+	AddressMode mode;
+	bool filtered = false;
+
+	// If the index doesn't exist.
+	if ( definition == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+	}
+
+	// If the key is shorter than the index's key.
+	if ( searchKey == NULL || keyLength < definition->keyLength )
+	{
+		return BTRIEVE_STATUS_CODE_KEYBUFFER_TOO_SHORT;
+	}
+
+	// Search with the key in the form the index's entries hold it.
+	EncodeKey ( *definition, searchKey, entryKey );
+	searchKey = entryKey;
+
+	switch ( comparison )
+	{
+		case BTRIEVE_COMPARISON_EQUAL:
+		case BTRIEVE_COMPARISON_GREATER_THAN_OR_EQUAL:
+		case BTRIEVE_COMPARISON_LESS_THAN:
+			mode = ADDRESS_MODE_LOWEST;
+			break;
+		case BTRIEVE_COMPARISON_GREATER_THAN:
+		case BTRIEVE_COMPARISON_LESS_THAN_OR_EQUAL:
+			mode = ADDRESS_MODE_HIGHEST;
+			break;
+		default:
+			return BTRIEVE_STATUS_CODE_INVALID_FUNCTION;
+	}
+
+	// If an equal key was wanted and the index's filter rules it out.
+	if ( comparison == BTRIEVE_COMPARISON_EQUAL && shared->ExcludesKey ( definition, searchKey, &filtered ) )
+	{
+		return BTRIEVE_STATUS_CODE_KEY_VALUE_NOT_FOUND;
+	}
+
+	BTree tree ( shared, definition );
+
+	// If LowerBound ( ) fails.
+	if ( !tree.LowerBound ( searchKey, 0, mode, &position ) )
+	{
+		return BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	// Less than comparisons want the entry before the bound.
+	if ( comparison == BTRIEVE_COMPARISON_LESS_THAN || comparison == BTRIEVE_COMPARISON_LESS_THAN_OR_EQUAL )
+	{
+		// If the previous entry can't be read.
+		if ( !( position.page == 0 ? tree.Last ( &position ) : tree.Previous ( &position ) ) )
+		{
+			return BTRIEVE_STATUS_CODE_IO_ERROR;
+		}
+	}
+
+	// If no entry satisfies the comparison.
+	if ( position.page == 0 )
+	{
+		// If the filter passed a key that isn't there.
+		if ( filtered )
+		{
+			shared->CountFalsePositive ( index );
+		}
+
+		return ( comparison == BTRIEVE_COMPARISON_EQUAL ) ? BTRIEVE_STATUS_CODE_KEY_VALUE_NOT_FOUND : BTRIEVE_STATUS_CODE_END_OF_FILE;
+	}
+
+	// If ReadEntry ( ) fails.
+	if ( !tree.ReadEntry ( position, key, &address ) )
+	{
+		return BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	// If an equal key was wanted and the bound is a greater one.
+	if ( comparison == BTRIEVE_COMPARISON_EQUAL && CompareKeys ( *definition, key, searchKey ) != 0 )
+	{
+		// If the filter passed a key that isn't there.
+		if ( filtered )
+		{
+			shared->CountFalsePositive ( index );
+		}
+
+		return BTRIEVE_STATUS_CODE_KEY_VALUE_NOT_FOUND;
+	}
+
+	SetCursor ( file, index, address, key, &position );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SeekCursor
+
+
+// Position the cursor on the first or last record of an index or of the file.
+btrieve_status_code_t SeekEnd ( btrieve_file* file, int index, bool first )
+{
+	SharedFile* shared = file->shared.get ( );
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint64_t address;
+	TreePosition position;
+
+	// If the cursor goes in physical order.
+	if ( index == BTRIEVE_INDEX_NONE )
+	{
+		// If the file is empty.
+		if ( !( first ? shared->FirstPhysical ( &address ) : shared->LastPhysical ( &address ) ) )
+		{
+			return BTRIEVE_STATUS_CODE_END_OF_FILE;
+		}
+
+		SetCursor ( file, BTRIEVE_INDEX_NONE, address, NULL, NULL );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}	// if ( index == BTRIEVE_INDEX_NONE )
+
+	IndexDefinition* definition = shared->FindIndex ( index );
+
+	// If the index doesn't exist.
+	if ( definition == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+	}
+
+	BTree tree ( shared, definition );
+
+	// If First ( ) or Last ( ) fails.
+	if ( !( first ? tree.First ( &position ) : tree.Last ( &position ) ) )
+	{
+		return BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	// If the index is empty.
+	if ( position.page == 0 )
+	{
+		return BTRIEVE_STATUS_CODE_END_OF_FILE;
+	}
+
+	// If ReadEntry ( ) fails.
+	if ( !tree.ReadEntry ( position, key, &address ) )
+	{
+		return BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	SetCursor ( file, index, address, key, &position );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SeekEnd
+
+
+// Read the record at the cursor into the handle's scratch buffer.
+btrieve_status_code_t ReadCursorRecord ( btrieve_file* file )
+{
+	// If there's no current record.
+	if ( !file->cursor.established || !file->cursor.recordLoaded )
+	{
+		return BTRIEVE_STATUS_CODE_POSITION_NOT_SET;
+	}
+
+	return file->shared->ReadRecordData ( file->cursor.address, &file->scratch );
+}	// btrieve_status_code_t ReadCursorRecord
+
+}	// namespace BtrieveEngine
+
+
+// Copy the record at the cursor to the caller, limited to the record buffer.
+static int CopyCursorRecord ( btrieve_file* file, btrieve_status_code_t status, char* record, int recordSize )
+{
+	int length;
+
+	// If the cursor didn't move, or the record can't be read.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR
+		|| ( status = ReadCursorRecord ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		SetFileStatus ( file, status );
+		return -1;
+	}
+
+	// If there's no record buffer.
+	if ( record == NULL || recordSize < 0 )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+		return -1;
+	}
+
+	length = ( int ) file->scratch.size ( );
+
+	// If the record doesn't fit, return as much as fits.
+	if ( length > recordSize )
+	{
+		memcpy ( record, &file->scratch [ 0 ], recordSize );
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_DATALENGTH_ERROR );
+		return recordSize;
+	}
+
+	memcpy ( record, &file->scratch [ 0 ], length );
+	SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+	return length;
+}	// static int CopyCursorRecord
+
+
+// Copy the key at the cursor to the caller.
+static btrieve_status_code_t CopyCursorKey ( btrieve_file* file, btrieve_status_code_t status, char* key, int keySize )
+{
+	// If the cursor didn't move.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// If the key doesn't fit.
+	if ( key == NULL || keySize < ( int ) file->cursor.key.size ( ) )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_KEYBUFFER_TOO_SHORT );
+	}
+
+	IndexDefinition* definition = file->shared->FindIndex ( file->cursor.index );
+
+	// If the index's entries lost the key's original bytes, read them from the record.
+	if ( !DecodeKey ( *definition, &file->cursor.key [ 0 ], ( uint8_t* ) key ) )
+	{
+		PageHandle page;
+		const uint8_t* bytes;
+		int length;
+		std::vector<uint8_t> overflow;
+
+		// If PinRecordData ( ) fails.
+		if ( ( status = file->shared->PinRecordData ( file->cursor.address, &page, &bytes, &length, &overflow ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return SetFileStatus ( file, status );
+		}
+
+		CopyRecordKey ( *definition, bytes, ( uint8_t* ) key );
+	}
+
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// static btrieve_status_code_t CopyCursorKey
+
+
+btrieve_status_code_t BtrieveFileGetLastStatusCode ( btrieve_file_t file )
+{
+	return ( file == NULL ) ? BTRIEVE_STATUS_CODE_FILE_NOT_OPEN : file->lastStatusCode;
+}	// btrieve_status_code_t BtrieveFileGetLastStatusCode
+
+
+int BtrieveFileRecordRetrieve ( btrieve_file_t file, btrieve_comparison_t comparison, btrieve_index_t index, const char* key, int keyLength, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorRecord ( file, SeekCursor ( file, comparison, index, ( const uint8_t* ) key, keyLength ), record, recordSize );
+}	// int BtrieveFileRecordRetrieve
+
+
+int BtrieveFileRecordRetrieveFirst ( btrieve_file_t file, btrieve_index_t index, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorRecord ( file, SeekEnd ( file, index, true ), record, recordSize );
+}	// int BtrieveFileRecordRetrieveFirst
+
+
+int BtrieveFileRecordRetrieveLast ( btrieve_file_t file, btrieve_index_t index, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorRecord ( file, SeekEnd ( file, index, false ), record, recordSize );
+}	// int BtrieveFileRecordRetrieveLast
+
+
+int BtrieveFileRecordRetrieveNext ( btrieve_file_t file, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorRecord ( file, MoveCursor ( file, true ), record, recordSize );
+}	// int BtrieveFileRecordRetrieveNext
+
+
+int BtrieveFileRecordRetrievePrevious ( btrieve_file_t file, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorRecord ( file, MoveCursor ( file, false ), record, recordSize );
+}	// int BtrieveFileRecordRetrievePrevious
+
+
+int BtrieveFileRecordRetrieveByCursorPosition ( btrieve_file_t file, btrieve_index_t index, long long cursorPosition, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	btrieve_status_code_t status;
+
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If there's no record at the position.
+	if ( cursorPosition <= 0 || !file->shared->IsLiveRecord ( ( uint64_t ) cursorPosition ) )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_RECORD_ADDRESS );
+		return -1;
+	}
+
+	// If ReadRecordData ( ) fails.
+	if ( ( status = file->shared->ReadRecordData ( ( uint64_t ) cursorPosition, &file->scratch ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		SetFileStatus ( file, status );
+		return -1;
+	}
+
+	return CopyCursorRecord ( file, SetCursorToRecord ( file, index, ( uint64_t ) cursorPosition, &file->scratch [ 0 ] ), record, recordSize );
+}	// int BtrieveFileRecordRetrieveByCursorPosition
+
+
+// Find the data page a fraction of the way along the data page chain.
+static bool SeekPhysicalFraction ( SharedFile* shared, double fraction, uint64_t* address )
+{
+	uint32_t target = ( uint32_t ) ( fraction * shared->header.dataPageCount );
+	uint32_t pageNumber = shared->header.firstDataPage;
+
+	for ( uint32_t i = 0; pageNumber != 0; i++ )
+	{
+		PageHandle page = shared->pager.Fetch ( pageNumber );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+
+		// If this is the page, or the last page.
+		if ( i >= target || data->link.next == 0 )
+		{
+			*address = ENGINE_ADDRESS ( pageNumber, 0 );
+			page.Release ( );
+
+			// If the page holds no record, take the one after it, or the one before.
+			return shared->IsLiveRecord ( *address )
+				|| shared->NextPhysical ( address )
+				|| shared->PreviousPhysical ( address );
+		}
+
+		pageNumber = data->link.next;
+	}	// for ( uint32_t i = 0; pageNumber != 0; i++ )
+
+	return false;
+}	// static bool SeekPhysicalFraction
+
+
+// Compute how far along the data page chain a record lies.
+static bool GetPhysicalFraction ( SharedFile* shared, uint64_t address, double* fraction )
+{
+	uint32_t pageNumber = shared->header.firstDataPage;
+
+	for ( uint32_t i = 0; pageNumber != 0; i++ )
+	{
+		// If this is the record's page.
+		if ( pageNumber == ENGINE_ADDRESS_PAGE ( address ) )
+		{
+			PageHandle page = shared->pager.Fetch ( pageNumber );
+
+			// If Fetch ( ) fails.
+			if ( !page.IsValid ( ) )
+			{
+				return false;
+			}
+
+			DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+			double slot = ( data->slotCount > 0 ) ? ( double ) ENGINE_ADDRESS_SLOT ( address ) / data->slotCount : 0.0;
+
+			*fraction = ( i + slot ) / shared->header.dataPageCount;
+			return true;
+		}
+
+		PageHandle page = shared->pager.Fetch ( pageNumber );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		pageNumber = ( ( DataPageHeader* ) page.GetData ( ) )->link.next;
+	}	// for ( uint32_t i = 0; pageNumber != 0; i++ )
+
+	return false;
+}	// static bool GetPhysicalFraction
+
+
+int BtrieveFileRecordRetrieveByFraction ( btrieve_file_t file, btrieve_index_t index, int numerator, int denominator, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint64_t address;
+	double fraction;
+	btrieve_status_code_t status = BTRIEVE_STATUS_CODE_NO_ERROR;
+
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	// If the fraction isn't between zero and one.
+	if ( denominator <= 0 || numerator < 0 || numerator > denominator )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_FUNCTION );
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+	SharedFile* shared = file->shared.get ( );
+
+	fraction = ( double ) numerator / denominator;
+
+	// If the cursor goes in physical order.
+	if ( index == BTRIEVE_INDEX_NONE )
+	{
+		// If the file is empty.
+		if ( !SeekPhysicalFraction ( shared, fraction, &address ) )
+		{
+			status = BTRIEVE_STATUS_CODE_END_OF_FILE;
+		}
+		else
+		{
+			SetCursor ( file, BTRIEVE_INDEX_NONE, address, NULL, NULL );
+		}
+	}
+	else
+	{
+		IndexDefinition* definition = shared->FindIndex ( index );
+		TreePosition position;
+
+		// If the index doesn't exist.
+		if ( definition == NULL )
+		{
+			status = BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+		}
+		else
+		{
+			BTree tree ( shared, definition );
+
+			// If SeekFraction ( ) fails.
+			if ( !tree.SeekFraction ( fraction, &position ) || ( position.page != 0 && !tree.ReadEntry ( position, key, &address ) ) )
+			{
+				status = BTRIEVE_STATUS_CODE_IO_ERROR;
+			}
+			else if ( position.page == 0 )
+			{
+				status = BTRIEVE_STATUS_CODE_END_OF_FILE;
+			}
+			else
+			{
+				SetCursor ( file, index, address, key, &position );
+			}
+		}
+	}	// if ( index == BTRIEVE_INDEX_NONE )
+
+	return CopyCursorRecord ( file, status, record, recordSize );
+}	// int BtrieveFileRecordRetrieveByFraction
+
+
+int BtrieveFileRecordRetrieveByPercentage ( btrieve_file_t file, btrieve_index_t index, int percentage, char* record, int recordSize, btrieve_lock_mode_t lockMode )
+{
+	return BtrieveFileRecordRetrieveByFraction ( file, index, percentage, ENGINE_PERCENTAGE_DENOMINATOR, record, recordSize, lockMode );
+}	// int BtrieveFileRecordRetrieveByPercentage
+
+
+int BtrieveFileGetNumerator ( btrieve_file_t file, btrieve_index_t index, const char* key, int keyLength, long long cursorPosition, int denominator )
+{
+	double fraction = 0.0;
+	bool found;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	// If the denominator is invalid.
+	if ( denominator <= 0 )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_FUNCTION );
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+	SharedFile* shared = file->shared.get ( );
+
+	// If the location is a cursor position.
+	if ( index == BTRIEVE_INDEX_NONE )
+	{
+		// If there's no record at the position.
+		if ( cursorPosition <= 0 || !shared->IsLiveRecord ( ( uint64_t ) cursorPosition ) )
+		{
+			SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_RECORD_ADDRESS );
+			return -1;
+		}
+
+		found = GetPhysicalFraction ( shared, ( uint64_t ) cursorPosition, &fraction );
+	}
+	else
+	{
+		IndexDefinition* definition = shared->FindIndex ( index );
+
+		// If the index doesn't exist.
+		if ( definition == NULL )
+		{
+			SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER );
+			return -1;
+		}
+
+		// If the key is shorter than the index's key.
+		if ( key == NULL || keyLength < definition->keyLength )
+		{
+			SetFileStatus ( file, BTRIEVE_STATUS_CODE_KEYBUFFER_TOO_SHORT );
+			return -1;
+		}
+
+		BTree tree ( shared, definition );
+
+		found = tree.GetFraction ( ( const uint8_t* ) key, 0, &fraction );
+	}	// if ( index == BTRIEVE_INDEX_NONE )
+
+	// If the fraction couldn't be computed.
+	if ( !found )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_IO_ERROR );
+		return -1;
+	}
+
+	SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+	return ( int ) ( fraction * denominator + 0.5 );
+}	// int BtrieveFileGetNumerator
+
+
+int BtrieveFileGetPercentage ( btrieve_file_t file, btrieve_index_t index, const char* key, int keyLength, long long cursorPosition )
+{
+	return BtrieveFileGetNumerator ( file, index, key, keyLength, cursorPosition, ENGINE_PERCENTAGE_DENOMINATOR );
+}	// int BtrieveFileGetPercentage
+
+
+long long BtrieveFileGetCursorPosition ( btrieve_file_t file )
+{
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	// If there's no current record.
+	if ( !file->cursor.established || !file->cursor.recordLoaded )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_POSITION_NOT_SET );
+		return -1;
+	}
+
+	SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+	return ( long long ) file->cursor.address;
+}	// long long BtrieveFileGetCursorPosition
+
+
+btrieve_status_code_t BtrieveFileKeyRetrieve ( btrieve_file_t file, btrieve_comparison_t comparison, btrieve_index_t index, const char* key, int keyLength )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return SetFileStatus ( file, SeekCursor ( file, comparison, index, ( const uint8_t* ) key, keyLength ) );
+}	// btrieve_status_code_t BtrieveFileKeyRetrieve
+
+
+btrieve_status_code_t BtrieveFileKeyRetrieveFirst ( btrieve_file_t file, btrieve_index_t index, char* key, int keySize )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no index; keys come from indexes.
+	if ( index == BTRIEVE_INDEX_NONE )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER );
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorKey ( file, SeekEnd ( file, index, true ), key, keySize );
+}	// btrieve_status_code_t BtrieveFileKeyRetrieveFirst
+
+
+btrieve_status_code_t BtrieveFileKeyRetrieveLast ( btrieve_file_t file, btrieve_index_t index, char* key, int keySize )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no index; keys come from indexes.
+	if ( index == BTRIEVE_INDEX_NONE )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER );
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorKey ( file, SeekEnd ( file, index, false ), key, keySize );
+}	// btrieve_status_code_t BtrieveFileKeyRetrieveLast
+
+
+btrieve_status_code_t BtrieveFileKeyRetrieveNext ( btrieve_file_t file, char* key, int keySize )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If the cursor doesn't follow an index.
+	if ( file->cursor.established && file->cursor.index == BTRIEVE_INDEX_NONE )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER );
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorKey ( file, MoveCursor ( file, true ), key, keySize );
+}	// btrieve_status_code_t BtrieveFileKeyRetrieveNext
+
+
+btrieve_status_code_t BtrieveFileKeyRetrievePrevious ( btrieve_file_t file, char* key, int keySize )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If the cursor doesn't follow an index.
+	if ( file->cursor.established && file->cursor.index == BTRIEVE_INDEX_NONE )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER );
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return CopyCursorKey ( file, MoveCursor ( file, false ), key, keySize );
+}	// btrieve_status_code_t BtrieveFileKeyRetrievePrevious
+
+
+btrieve_status_code_t BtrieveFileRecordCreate ( btrieve_file_t file, char* record, int recordLength )
+{
+	uint64_t address;
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no record.
+	if ( record == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If the file can't be written.
+	if ( ( status = BeginFileWrite ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// If CreateRecord ( ) fails.
+	if ( ( status = file->shared->CreateRecord ( ( uint8_t* ) record, recordLength, &address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// The new record becomes current, on the index the cursor follows.
+	return SetFileStatus ( file, SetCursorToRecord ( file, file->cursor.established ? file->cursor.index : BTRIEVE_INDEX_NONE, address, ( const uint8_t* ) record ) );
+}	// btrieve_status_code_t BtrieveFileRecordCreate
+
+
+// Replace the record at the cursor; the caller holds the latch exclusively.
+static btrieve_status_code_t UpdateCursorRecord ( btrieve_file* file, const uint8_t* record, int recordLength, int currentOffset )
+{
+	btrieve_status_code_t status;
+
+	// If the file can't be written.
+	if ( ( status = BeginFileWrite ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If UpdateRecord ( ) fails.
+	if ( ( status = file->shared->UpdateRecord ( file->cursor.address, record, recordLength ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// The cursor stays on the record, which may have a new key.
+	status = SetCursorToRecord ( file, file->cursor.index, file->cursor.address, record );
+	file->cursor.currentOffset = currentOffset;
+	return status;
+}	// static btrieve_status_code_t UpdateCursorRecord
+
+
+btrieve_status_code_t BtrieveFileRecordUpdate ( btrieve_file_t file, const char* record, int recordLength )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no record.
+	if ( record == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If there's no current record.
+	if ( !file->cursor.established || !file->cursor.recordLoaded )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_POSITION_NOT_SET );
+	}
+
+	return SetFileStatus ( file, UpdateCursorRecord ( file, ( const uint8_t* ) record, recordLength, -1 ) );
+}	// btrieve_status_code_t BtrieveFileRecordUpdate
+
+
+btrieve_status_code_t BtrieveFileRecordDelete ( btrieve_file_t file )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If there's no current record.
+	if ( !file->cursor.established || !file->cursor.recordLoaded )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_POSITION_NOT_SET );
+	}
+
+	// If the file can't be written.
+	if ( ( status = BeginFileWrite ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// If DeleteRecord ( ) fails.
+	if ( ( status = file->shared->DeleteRecord ( file->cursor.address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// The cursor keeps its key and position, so next and previous still work.
+	InvalidateRecordView ( file );
+	file->cursor.recordLoaded = false;
+	file->cursor.hintStamp = 0;
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileRecordDelete
+
+
+int BtrieveFileRecordRetrieveChunk ( btrieve_file_t file, int offset, int length, char* chunk, int chunkSize, btrieve_lock_mode_t lockMode )
+{
+	btrieve_status_code_t status;
+	int recordLength;
+
+	( void ) lockMode;
+
+	// If the file isn't open.
+	if ( CheckFileOpen ( file ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return -1;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If ReadCursorRecord ( ) fails.
+	if ( ( status = ReadCursorRecord ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		SetFileStatus ( file, status );
+		return -1;
+	}
+
+	recordLength = ( int ) file->scratch.size ( );
+	offset = ( offset == -1 ) ? ( ( file->cursor.currentOffset < 0 ) ? 0 : file->cursor.currentOffset ) : offset;
+
+	// If the chunk starts past the record.
+	if ( offset < 0 || offset > recordLength )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_CHUNK_OFFSET_TOO_LONG );
+		return -1;
+	}
+
+	// If the length is invalid or there's no buffer.
+	if ( length < 0 || chunk == NULL )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+		return -1;
+	}
+
+	length = ( length > recordLength - offset ) ? recordLength - offset : length;
+
+	// If the chunk doesn't fit.
+	if ( length > chunkSize )
+	{
+		SetFileStatus ( file, BTRIEVE_STATUS_CODE_DATALENGTH_ERROR );
+		return -1;
+	}
+
+	memcpy ( chunk, &file->scratch [ offset ], length );
+	file->cursor.currentOffset = offset + length;
+	SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+	return length;
+}	// int BtrieveFileRecordRetrieveChunk
+
+
+btrieve_status_code_t BtrieveFileRecordUpdateChunk ( btrieve_file_t file, int offset, const char* chunk, int chunkLength )
+{
+	btrieve_status_code_t status;
+	int recordLength;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no chunk.
+	if ( chunk == NULL || chunkLength < 0 )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If ReadCursorRecord ( ) fails.
+	if ( ( status = ReadCursorRecord ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	recordLength = ( int ) file->scratch.size ( );
+	offset = ( offset == -1 ) ? ( ( file->cursor.currentOffset < 0 ) ? 0 : file->cursor.currentOffset ) : offset;
+
+	// If the chunk starts past the record.
+	if ( offset < 0 || offset > recordLength )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_CHUNK_OFFSET_TOO_LONG );
+	}
+
+	// If the chunk extends the record.
+	if ( offset + chunkLength > recordLength )
+	{
+		file->scratch.resize ( offset + chunkLength );
+	}
+
+	memcpy ( &file->scratch [ offset ], chunk, chunkLength );
+	return SetFileStatus ( file, UpdateCursorRecord ( file, &file->scratch [ 0 ], ( int ) file->scratch.size ( ), offset + chunkLength ) );
+}	// btrieve_status_code_t BtrieveFileRecordUpdateChunk
+
+
+btrieve_status_code_t BtrieveFileRecordAppendChunk ( btrieve_file_t file, const char* chunk, int chunkLength )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no chunk.
+	if ( chunk == NULL || chunkLength < 0 )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If ReadCursorRecord ( ) fails.
+	if ( ( status = ReadCursorRecord ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	file->scratch.insert ( file->scratch.end ( ), ( const uint8_t* ) chunk, ( const uint8_t* ) chunk + chunkLength );
+	return SetFileStatus ( file, UpdateCursorRecord ( file, &file->scratch [ 0 ], ( int ) file->scratch.size ( ), ( int ) file->scratch.size ( ) ) );
+}	// btrieve_status_code_t BtrieveFileRecordAppendChunk
+
+
+btrieve_status_code_t BtrieveFileRecordTruncate ( btrieve_file_t file, int offset )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If ReadCursorRecord ( ) fails.
+	if ( ( status = ReadCursorRecord ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	offset = ( offset == -1 ) ? ( ( file->cursor.currentOffset < 0 ) ? ( int ) file->scratch.size ( ) : file->cursor.currentOffset ) : offset;
+
+	// If the offset is past the record.
+	if ( offset < 0 || offset > ( int ) file->scratch.size ( ) )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_CHUNK_OFFSET_TOO_LONG );
+	}
+
+	return SetFileStatus ( file, UpdateCursorRecord ( file, &file->scratch [ 0 ], offset, offset ) );
+}	// btrieve_status_code_t BtrieveFileRecordTruncate
+
+
+btrieve_status_code_t BtrieveFileRecordUnlock ( btrieve_file_t file, btrieve_unlock_mode_t unlockMode )
+{
+	btrieve_status_code_t status;
+
+	( void ) unlockMode;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// Records are never locked; latches last only as long as an operation.
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileRecordUnlock
+
+
+btrieve_status_code_t BtrieveFileUnlockCursorPosition ( btrieve_file_t file, long long cursorPosition )
+{
+	btrieve_status_code_t status;
+
+	( void ) cursorPosition;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileUnlockCursorPosition
+
+
+btrieve_status_code_t BtrieveFileIndexCreate ( btrieve_file_t file, const btrieve_index_attributes_t indexAttributes )
+{
+	return BtrieveFileIndexCreateWithOptions ( file, indexAttributes, NULL );
+}	// btrieve_status_code_t BtrieveFileIndexCreate
+
+
+btrieve_status_code_t BtrieveFileIndexDrop ( btrieve_file_t file, btrieve_index_t index )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If the file can't be written.
+	if ( ( status = BeginFileWrite ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// If DropIndex ( ) fails.
+	if ( ( status = file->shared->DropIndex ( index ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// If the cursor followed the index, it's left without a position.
+	if ( file->cursor.index == index )
+	{
+		InvalidateRecordView ( file );
+		file->cursor.established = false;
+	}
+
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileIndexDrop
+
+
+btrieve_status_code_t BtrieveFileSetOwner ( btrieve_file_t file, btrieve_owner_mode_t ownerMode, const char* ownerName, const char* ownerNameAgain, int useLongOwnerName )
+{
+	size_t maximumLength = useLongOwnerName ? ENGINE_OWNER_NAME_LENGTH : 8;
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// Encryption isn't available; an encrypted owner would promise more than the file holds.
+	if ( ownerMode == BTRIEVE_OWNER_MODE_ENCRYPTION_NO_READ_ALLOWED
+		|| ownerMode == BTRIEVE_OWNER_MODE_ENCRYPTION_READ_ALLOWED )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_FUNCTION );
+	}
+
+	// If a new owner name is invalid.
+	if ( ownerMode != BTRIEVE_OWNER_MODE_NONE
+		&& ( ownerName == NULL || ownerNameAgain == NULL || *ownerName == '\0'
+			|| strcmp ( ownerName, ownerNameAgain ) != 0 || strlen ( ownerName ) > maximumLength ) )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_OWNER );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+	FileHeader& header = file->shared->header;
+
+	// If the file can't be written.
+	if ( ( status = BeginFileWrite ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// If the file already has an owner.
+	if ( ownerMode != BTRIEVE_OWNER_MODE_NONE && header.ownerMode != BTRIEVE_OWNER_MODE_NONE )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_OWNER_ALREADY_SET );
+	}
+
+	header.ownerMode = ownerMode;
+	memset ( header.ownerName, 0, sizeof ( header.ownerName ) );
+
+	// If there's an owner name to keep.
+	if ( ownerMode != BTRIEVE_OWNER_MODE_NONE )
+	{
+		strcpy ( header.ownerName, ownerName );
+	}
+
+	file->shared->headerDirty = true;
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileSetOwner
+
+
+btrieve_status_code_t BtrieveFileSetAccessHint ( btrieve_file_t file, btrieve_access_hint_t hint )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If the hint isn't one of the three.
+	if ( hint != BTRIEVE_ACCESS_HINT_NORMAL && hint != BTRIEVE_ACCESS_HINT_RANDOM && hint != BTRIEVE_ACCESS_HINT_SEQUENTIAL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_FUNCTION );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	file->shared->pager.SetAccessHint ( hint );
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileSetAccessHint
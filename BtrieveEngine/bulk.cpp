@@ -0,0 +1,968 @@
+// bulk.cpp : Filters, bulk retrieve and bulk create for the in-process engine.
+//
+// A bulk retrieve walks the cursor from record to record, evaluating the
+// filters of the attributes against a batch of records at a time (see
+// filterKernels.h). Filters are joined left to right by their connectors,
+// without precedence. Records that pass are copied, or their fields are,
+// into the result until the maximum record count, the maximum reject
+// count, the end of the file or the size of the result buffer stops the
+// walk.
+//
+
+#include <string.h>
+
+#include "engine.h"
+#include "filterKernels.h"
+
+using namespace BtrieveEngine;
+
+#define ENGINE_BULK_BUFFER_LENGTH BTRIEVE_MAXIMUM_RECORD_LENGTH
+#define ENGINE_BULK_RECORD_OVERHEAD 6										// Length and cursor position, as a bulk buffer holds them.
+
+
+btrieve_status_code_t BtrieveFilterAllocate ( btrieve_filter_t* btrieveFilterPtr )
+{
+	btrieve_filter* filter;
+
+	// If there's nowhere to return the filter.
+	if ( btrieveFilterPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( filter = new ( std::nothrow ) btrieve_filter ( ) ) == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	filter->offset = -1;
+	filter->length = 0;
+	filter->dataType = BTRIEVE_DATA_TYPE_CHAR;
+	filter->comparison = BTRIEVE_COMPARISON_NONE;
+	filter->connector = BTRIEVE_CONNECTOR_LAST;
+	filter->comparisonField = -1;
+	filter->acsMode = BTRIEVE_ACS_MODE_NONE;
+
+	*btrieveFilterPtr = filter;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterAllocate
+
+
+btrieve_status_code_t BtrieveFilterFree ( btrieve_filter_t filter )
+{
+	// If there's no filter.
+	if ( filter == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete filter;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterFree
+
+
+btrieve_status_code_t BtrieveFilterSetField ( btrieve_filter_t filter, int offset, int length, btrieve_data_type_t dataType )
+{
+	// If there's no filter.
+	if ( filter == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the field lies outside any record.
+	if ( offset < 0 || length <= 0 || offset + length > BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	filter->offset = offset;
+	filter->length = length;
+	filter->dataType = dataType;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetField
+
+
+btrieve_status_code_t BtrieveFilterSetComparison ( btrieve_filter_t filter, btrieve_comparison_t comparison )
+{
+	// If there's no filter.
+	if ( filter == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the comparison is unknown.
+	if ( comparison < BTRIEVE_COMPARISON_EQUAL || comparison > BTRIEVE_COMPARISON_NOT_LIKE )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	filter->comparison = comparison;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetComparison
+
+
+btrieve_status_code_t BtrieveFilterSetComparisonConstant ( btrieve_filter_t filter, const char* constant, int constantLength )
+{
+	// If there's no filter or no constant.
+	if ( filter == NULL || constant == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the constant is longer than any record.
+	if ( constantLength <= 0 || constantLength > BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	filter->constant.assign ( constant, constant + constantLength );
+	filter->comparisonField = -1;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetComparisonConstant
+
+
+btrieve_status_code_t BtrieveFilterSetComparisonField ( btrieve_filter_t filter, int offset )
+{
+	// If there's no filter.
+	if ( filter == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the field lies outside any record.
+	if ( offset < 0 || offset >= BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	filter->comparisonField = offset;
+	filter->constant.clear ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetComparisonField
+
+
+btrieve_status_code_t BtrieveFilterSetConnector ( btrieve_filter_t filter, btrieve_connector_t connector )
+{
+	// If there's no filter.
+	if ( filter == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the connector is unknown.
+	if ( connector != BTRIEVE_CONNECTOR_LAST && connector != BTRIEVE_CONNECTOR_AND && connector != BTRIEVE_CONNECTOR_OR )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	filter->connector = connector;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetConnector
+
+
+btrieve_status_code_t BtrieveFilterSetACSMode ( btrieve_filter_t filter, btrieve_acs_mode_t ACSMode )
+{
+	// If there's no filter.
+	if ( filter == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// Numbered sequences are unsupported; named ones are set by name.
+	if ( ACSMode != BTRIEVE_ACS_MODE_NONE && ACSMode != BTRIEVE_ACS_MODE_CASE_INSENSITIVE && ACSMode != BTRIEVE_ACS_MODE_DEFAULT )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF;
+	}
+
+	filter->acsMode = ACSMode;
+	filter->acsName.clear ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetACSMode
+
+
+btrieve_status_code_t BtrieveFilterSetACSName ( btrieve_filter_t filter, const char* name )
+{
+	// If there's no filter or no name.
+	if ( filter == NULL || name == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the name doesn't fit an index's sequence name.
+	if ( *name == '\0' || strlen ( name ) > ENGINE_ACS_NAME_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF;
+	}
+
+	filter->acsMode = BTRIEVE_ACS_MODE_NAMED;
+	filter->acsName = name;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetACSName
+
+
+btrieve_status_code_t BtrieveFilterSetACSUserDefined ( btrieve_filter_t filter, const char* name )
+{
+	return BtrieveFilterSetACSName ( filter, name );
+}	// btrieve_status_code_t BtrieveFilterSetACSUserDefined
+
+
+btrieve_status_code_t BtrieveFilterSetLikeCodePageName ( btrieve_filter_t filter, const char* name )
+{
+	// If there's no filter or no name.
+	if ( filter == NULL || name == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// Values are matched byte by byte, so the code page is only recorded.
+	filter->likeCodePageName = name;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFilterSetLikeCodePageName
+
+
+btrieve_status_code_t BtrieveBulkRetrieveAttributesAllocate ( btrieve_bulk_retrieve_attributes_t* bulkRetrieveAttributesPtr )
+{
+	btrieve_bulk_retrieve_attributes* attributes;
+
+	// If there's nowhere to return the attributes.
+	if ( bulkRetrieveAttributesPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( attributes = new ( std::nothrow ) btrieve_bulk_retrieve_attributes ( ) ) == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	attributes->maximumRecordCount = 0;
+	attributes->maximumRejectCount = ENGINE_DEFAULT_MAXIMUM_REJECT_COUNT;
+	attributes->skipCurrentRecord = false;
+
+	*bulkRetrieveAttributesPtr = attributes;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveAttributesAllocate
+
+
+btrieve_status_code_t BtrieveBulkRetrieveAttributesFree ( btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes )
+{
+	// If there are no attributes.
+	if ( bulkRetrieveAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete bulkRetrieveAttributes;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveAttributesFree
+
+
+btrieve_status_code_t BtrieveBulkRetrieveAttributesAddField ( btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, int offset, int length )
+{
+	// If there are no attributes.
+	if ( bulkRetrieveAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the field lies outside any record.
+	if ( offset < 0 || length <= 0 || offset + length > BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	bulkRetrieveAttributes->fields.push_back ( std::make_pair ( offset, length ) );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveAttributesAddField
+
+
+btrieve_status_code_t BtrieveBulkRetrieveAttributesAddFilter ( btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, btrieve_filter_t filter )
+{
+	// If there are no attributes or no filter.
+	if ( bulkRetrieveAttributes == NULL || filter == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the filter has no field, no comparison, or nothing to compare with.
+	if ( filter->offset < 0 || filter->comparison == BTRIEVE_COMPARISON_NONE
+		|| ( filter->constant.empty ( ) && filter->comparisonField < 0 ) )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	// The attributes keep a copy, so the filter may be changed or freed.
+	bulkRetrieveAttributes->filters.push_back ( *filter );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveAttributesAddFilter
+
+
+btrieve_status_code_t BtrieveBulkRetrieveAttributesSetMaximumRecordCount ( btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, int maximumRecordCount )
+{
+	// If there are no attributes.
+	if ( bulkRetrieveAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the count is out of range.
+	if ( maximumRecordCount <= 0 || maximumRecordCount > 65535 )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	bulkRetrieveAttributes->maximumRecordCount = maximumRecordCount;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveAttributesSetMaximumRecordCount
+
+
+btrieve_status_code_t BtrieveBulkRetrieveAttributesSetMaximumRejectCount ( btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, int maximumRejectCount )
+{
+	// If there are no attributes.
+	if ( bulkRetrieveAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the count is out of range.
+	if ( maximumRejectCount < 0 || maximumRejectCount > 65535 )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION;
+	}
+
+	bulkRetrieveAttributes->maximumRejectCount = ( maximumRejectCount == 0 ) ? ENGINE_DEFAULT_MAXIMUM_REJECT_COUNT : maximumRejectCount;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveAttributesSetMaximumRejectCount
+
+
+btrieve_status_code_t BtrieveBulkRetrieveAttributesSetSkipCurrentRecord ( btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, int skipCurrentRecord )
+{
+	// If there are no attributes.
+	if ( bulkRetrieveAttributes == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	bulkRetrieveAttributes->skipCurrentRecord = ( skipCurrentRecord != 0 );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveAttributesSetSkipCurrentRecord
+
+
+btrieve_status_code_t BtrieveBulkRetrieveResultAllocate ( btrieve_bulk_retrieve_result_t* bulkRetrieveResultPtr )
+{
+	btrieve_bulk_retrieve_result* result;
+
+	// If there's nowhere to return the result.
+	if ( bulkRetrieveResultPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( result = new ( std::nothrow ) btrieve_bulk_retrieve_result ( ) ) == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	result->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+
+	*bulkRetrieveResultPtr = result;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveResultAllocate
+
+
+btrieve_status_code_t BtrieveBulkRetrieveResultFree ( btrieve_bulk_retrieve_result_t bulkRetrieveResult )
+{
+	// If there's no result.
+	if ( bulkRetrieveResult == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete bulkRetrieveResult;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkRetrieveResultFree
+
+
+btrieve_status_code_t BtrieveBulkRetrieveResultGetLastStatusCode ( btrieve_bulk_retrieve_result_t bulkRetrieveResult )
+{
+	return ( bulkRetrieveResult == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : bulkRetrieveResult->lastStatusCode;
+}	// btrieve_status_code_t BtrieveBulkRetrieveResultGetLastStatusCode
+
+
+int BtrieveBulkRetrieveResultGetRecordCount ( btrieve_bulk_retrieve_result_t bulkRetrieveResult )
+{
+	// If there's no result.
+	if ( bulkRetrieveResult == NULL )
+	{
+		return -1;
+	}
+
+	bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	return ( int ) bulkRetrieveResult->lengths.size ( );
+}	// int BtrieveBulkRetrieveResultGetRecordCount
+
+
+int BtrieveBulkRetrieveResultGetRecordLength ( btrieve_bulk_retrieve_result_t bulkRetrieveResult, int recordNumber )
+{
+	// If there's no result.
+	if ( bulkRetrieveResult == NULL )
+	{
+		return -1;
+	}
+
+	// If there's no such record.
+	if ( recordNumber < 0 || recordNumber >= ( int ) bulkRetrieveResult->lengths.size ( ) )
+	{
+		bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_FUNCTION;
+		return -1;
+	}
+
+	bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	return bulkRetrieveResult->lengths [ recordNumber ];
+}	// int BtrieveBulkRetrieveResultGetRecordLength
+
+
+int BtrieveBulkRetrieveResultGetRecord ( btrieve_bulk_retrieve_result_t bulkRetrieveResult, int recordNumber, char* record, int recordSize )
+{
+	int length;
+
+	// If there's no result or no record buffer.
+	if ( bulkRetrieveResult == NULL || record == NULL )
+	{
+		return -1;
+	}
+
+	// If there's no such record.
+	if ( recordNumber < 0 || recordNumber >= ( int ) bulkRetrieveResult->lengths.size ( ) )
+	{
+		bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_FUNCTION;
+		return -1;
+	}
+
+	length = bulkRetrieveResult->lengths [ recordNumber ];
+
+	// If the record doesn't fit, return as much as fits.
+	if ( length > recordSize )
+	{
+		length = ( recordSize < 0 ) ? 0 : recordSize;
+		bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_DATALENGTH_ERROR;
+	}
+	else
+	{
+		bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	memcpy ( record, &bulkRetrieveResult->buffer [ bulkRetrieveResult->offsets [ recordNumber ] ], length );
+	return length;
+}	// int BtrieveBulkRetrieveResultGetRecord
+
+
+long long BtrieveBulkRetrieveResultGetRecordCursorPosition ( btrieve_bulk_retrieve_result_t bulkRetrieveResult, int recordNumber )
+{
+	// If there's no result.
+	if ( bulkRetrieveResult == NULL )
+	{
+		return -1;
+	}
+
+	// If there's no such record.
+	if ( recordNumber < 0 || recordNumber >= ( int ) bulkRetrieveResult->cursorPositions.size ( ) )
+	{
+		bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_FUNCTION;
+		return -1;
+	}
+
+	bulkRetrieveResult->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	return bulkRetrieveResult->cursorPositions [ recordNumber ];
+}	// long long BtrieveBulkRetrieveResultGetRecordCursorPosition
+
+
+btrieve_status_code_t BtrieveBulkCreatePayloadAllocate ( btrieve_bulk_create_payload_t* btrieveBulkCreatePayloadPtr )
+{
+	btrieve_bulk_create_payload* payload;
+
+	// If there's nowhere to return the payload.
+	if ( btrieveBulkCreatePayloadPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( payload = new ( std::nothrow ) btrieve_bulk_create_payload ( ) ) == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	*btrieveBulkCreatePayloadPtr = payload;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkCreatePayloadAllocate
+
+
+btrieve_status_code_t BtrieveBulkCreatePayloadFree ( btrieve_bulk_create_payload_t bulkCreatePayload )
+{
+	// If there's no payload.
+	if ( bulkCreatePayload == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete bulkCreatePayload;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkCreatePayloadFree
+
+
+btrieve_status_code_t BtrieveBulkCreatePayloadAddRecord ( btrieve_bulk_create_payload_t bulkCreatePayload, const char* record, int recordLength )
+{
+	// If there's no payload or no record.
+	if ( bulkCreatePayload == NULL || record == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the record length is invalid.
+	if ( recordLength <= 0 || recordLength > BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_DATALENGTH_ERROR;
+	}
+
+	// If the payload is full.
+	if ( bulkCreatePayload->buffer.size ( ) + bulkCreatePayload->lengths.size ( ) * ENGINE_BULK_RECORD_OVERHEAD
+		+ recordLength + ENGINE_BULK_RECORD_OVERHEAD > ENGINE_BULK_BUFFER_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_EXT_INSERT_BUFF;
+	}
+
+	bulkCreatePayload->offsets.push_back ( ( int ) bulkCreatePayload->buffer.size ( ) );
+	bulkCreatePayload->lengths.push_back ( recordLength );
+	bulkCreatePayload->buffer.insert ( bulkCreatePayload->buffer.end ( ), record, record + recordLength );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkCreatePayloadAddRecord
+
+
+btrieve_status_code_t BtrieveBulkCreateResultAllocate ( btrieve_bulk_create_result_t* btrieveBulkCreateResultPtr )
+{
+	btrieve_bulk_create_result* result;
+
+	// If there's nowhere to return the result.
+	if ( btrieveBulkCreateResultPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( result = new ( std::nothrow ) btrieve_bulk_create_result ( ) ) == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	result->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+
+	*btrieveBulkCreateResultPtr = result;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkCreateResultAllocate
+
+
+btrieve_status_code_t BtrieveBulkCreateResultFree ( btrieve_bulk_create_result_t bulkCreateResult )
+{
+	// If there's no result.
+	if ( bulkCreateResult == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete bulkCreateResult;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveBulkCreateResultFree
+
+
+btrieve_status_code_t BtrieveBulkCreateResultGetLastStatusCode ( btrieve_bulk_create_result_t bulkCreateResult )
+{
+	return ( bulkCreateResult == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : bulkCreateResult->lastStatusCode;
+}	// btrieve_status_code_t BtrieveBulkCreateResultGetLastStatusCode
+
+
+int BtrieveBulkCreateResultGetRecordCount ( btrieve_bulk_create_result_t bulkCreateResult )
+{
+	// If there's no result.
+	if ( bulkCreateResult == NULL )
+	{
+		return -1;
+	}
+
+	bulkCreateResult->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	return ( int ) bulkCreateResult->cursorPositions.size ( );
+}	// int BtrieveBulkCreateResultGetRecordCount
+
+
+long long BtrieveBulkCreateResultGetRecordCursorPosition ( btrieve_bulk_create_result_t bulkCreateResult, int recordNumber )
+{
+	// If there's no result.
+	if ( bulkCreateResult == NULL )
+	{
+		return -1;
+	}
+
+	// If there's no such record.
+	if ( recordNumber < 0 || recordNumber >= ( int ) bulkCreateResult->cursorPositions.size ( ) )
+	{
+		bulkCreateResult->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_FUNCTION;
+		return -1;
+	}
+
+	bulkCreateResult->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	return bulkCreateResult->cursorPositions [ recordNumber ];
+}	// long long BtrieveBulkCreateResultGetRecordCursorPosition
+
+
+// Return the collation map a filter compares with, or NULL for none.
+static const uint8_t* GetFilterMap ( SharedFile* shared, const btrieve_filter& filter, btrieve_status_code_t* status )
+{
+	*status = BTRIEVE_STATUS_CODE_NO_ERROR;
+
+	// If the comparison ignores case.
+	if ( filter.acsMode == BTRIEVE_ACS_MODE_CASE_INSENSITIVE )
+	{
+		return GetCaseInsensitiveMap ( );
+	}
+
+	// If the comparison uses no named sequence.
+	if ( filter.acsMode != BTRIEVE_ACS_MODE_NAMED )
+	{
+		return NULL;
+	}
+
+	// A named sequence must belong to one of the file's indexes.
+	for ( size_t i = 0; i < shared->header.indexes.size ( ); i++ )
+	{
+		const IndexDefinition& definition = shared->header.indexes [ i ];
+
+		// If this index holds the sequence.
+		if ( definition.hasAcsMap && filter.acsName == definition.acsName )
+		{
+			return definition.acsMap;
+		}
+	}
+
+	*status = BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF;
+	return NULL;
+}	// static const uint8_t* GetFilterMap
+
+
+// Walk the cursor, collecting the records that pass the filters. Records
+// are read a batch at a time and filtered together; a batch is never
+// longer than the records the result has room for or the rejects left, so
+// only a full result buffer stops a walk before the end of a batch, and
+// then the cursor is put back on the record it stopped at.
+static btrieve_status_code_t BulkRetrieve ( btrieve_file* file, const btrieve_bulk_retrieve_attributes* attributes, btrieve_bulk_retrieve_result* result, bool forward )
+{
+	SharedFile* shared = file->shared.get ( );
+	std::vector<FilterKernel> kernels ( attributes->filters.size ( ) );
+	int maximumRecordCount = ( attributes->maximumRecordCount > 0 ) ? attributes->maximumRecordCount : 65535;
+	int rejectCount = 0;
+	size_t used = 0;
+	btrieve_status_code_t status;
+	bool first = true;
+	FilterBatch batch;
+
+	result->buffer.clear ( );
+	result->offsets.clear ( );
+	result->lengths.clear ( );
+	result->cursorPositions.clear ( );
+
+	// If there's no position to walk from.
+	if ( !file->cursor.established )
+	{
+		return BTRIEVE_STATUS_CODE_POSITION_NOT_SET;
+	}
+
+	for ( size_t i = 0; i < attributes->filters.size ( ); i++ )
+	{
+		const uint8_t* map = GetFilterMap ( shared, attributes->filters [ i ], &status );
+
+		// If the filter's collation can't be found.
+		if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		CompileFilterKernel ( attributes->filters [ i ], map, &kernels [ i ] );
+	}
+
+	file->batchRecords.resize ( ENGINE_FILTER_BATCH_RECORDS );
+	file->batchCursors.resize ( ENGINE_FILTER_BATCH_RECORDS );
+
+	for ( ;; )
+	{
+		int limit = ENGINE_FILTER_BATCH_RECORDS;
+		size_t batchBytes = 0;
+		btrieve_status_code_t walkStatus = BTRIEVE_STATUS_CODE_NO_ERROR;
+		uint64_t passed;
+
+		// A batch stops where the record count or the reject count would stop the walk.
+		if ( limit > maximumRecordCount - ( int ) result->lengths.size ( ) )
+		{
+			limit = maximumRecordCount - ( int ) result->lengths.size ( );
+		}
+
+		if ( limit > attributes->maximumRejectCount - rejectCount )
+		{
+			limit = attributes->maximumRejectCount - rejectCount;
+		}
+
+		for ( batch.count = 0; batch.count < limit; batch.count++ )
+		{
+			std::vector<uint8_t>& record = file->batchRecords [ batch.count ];
+
+			// The current record is examined first, unless it's skipped or gone.
+			if ( !first || attributes->skipCurrentRecord || !file->cursor.recordLoaded )
+			{
+				// If the walk reached the end.
+				if ( ( walkStatus = MoveCursor ( file, forward ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+				{
+					break;
+				}
+			}
+
+			first = false;
+
+			// If there's no current record.
+			if ( !file->cursor.recordLoaded )
+			{
+				walkStatus = BTRIEVE_STATUS_CODE_POSITION_NOT_SET;
+				break;
+			}
+
+			// If ReadRecordData ( ) fails.
+			if ( ( walkStatus = shared->ReadRecordData ( file->cursor.address, &record ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+			{
+				break;
+			}
+
+			file->batchCursors [ batch.count ] = file->cursor;
+			batch.records [ batch.count ] = record.empty ( ) ? NULL : &record [ 0 ];
+			batch.lengths [ batch.count ] = ( int ) record.size ( );
+
+			// If the batch holds as many bytes as it should.
+			if ( ( batchBytes += record.size ( ) ) >= ENGINE_FILTER_BATCH_BYTES )
+			{
+				batch.count++;
+				break;
+			}
+		}	// for ( batch.count = 0; batch.count < limit; batch.count++ )
+
+		passed = EvaluateFilterKernels ( kernels, batch );
+
+		for ( int i = 0; i < batch.count; i++ )
+		{
+			const std::vector<uint8_t>& record = file->batchRecords [ i ];
+			int recordLength = batch.lengths [ i ];
+			int length;
+
+			// If the record is rejected.
+			if ( ( ( passed >> i ) & 1 ) == 0 )
+			{
+				// If the reject count is reached.
+				if ( ++rejectCount >= attributes->maximumRejectCount )
+				{
+					file->cursor = file->batchCursors [ i ];
+					return BTRIEVE_STATUS_CODE_REJECT_COUNT_REACHED;
+				}
+
+				continue;
+			}
+
+			// The result holds the whole record, or its fields one after another.
+			if ( attributes->fields.empty ( ) )
+			{
+				length = recordLength;
+			}
+			else
+			{
+				length = 0;
+
+				for ( size_t j = 0; j < attributes->fields.size ( ); j++ )
+				{
+					length += attributes->fields [ j ].second;
+				}
+			}
+
+			// If the record doesn't fit in what's left of the buffer.
+			if ( used + length + ENGINE_BULK_RECORD_OVERHEAD > ENGINE_BULK_BUFFER_LENGTH )
+			{
+				file->cursor = file->batchCursors [ i ];
+
+				// If the result holds nothing.
+				if ( result->lengths.empty ( ) )
+				{
+					return BTRIEVE_STATUS_CODE_DATA_MESSAGE_TOO_SMALL;
+				}
+
+				// Step back, so the next walk that skips the current record starts with this one.
+				return MoveCursor ( file, !forward );
+			}
+
+			result->offsets.push_back ( ( int ) result->buffer.size ( ) );
+			result->lengths.push_back ( length );
+			result->cursorPositions.push_back ( ( long long ) file->batchCursors [ i ].address );
+
+			// If the whole record is wanted.
+			if ( attributes->fields.empty ( ) )
+			{
+				result->buffer.insert ( result->buffer.end ( ), record.begin ( ), record.end ( ) );
+			}
+			else
+			{
+				for ( size_t j = 0; j < attributes->fields.size ( ); j++ )
+				{
+					int offset = attributes->fields [ j ].first;
+					int fieldLength = attributes->fields [ j ].second;
+					size_t start = result->buffer.size ( );
+
+					result->buffer.resize ( start + fieldLength, 0 );
+
+					// Bytes of a field past the end of the record are zero.
+					if ( offset < recordLength )
+					{
+						memcpy ( &result->buffer [ start ], &record [ offset ], ( offset + fieldLength > recordLength ) ? recordLength - offset : fieldLength );
+					}
+				}
+			}	// if ( attributes->fields.empty ( ) )
+
+			used += length + ENGINE_BULK_RECORD_OVERHEAD;
+
+			// If the result is full.
+			if ( ( int ) result->lengths.size ( ) >= maximumRecordCount )
+			{
+				file->cursor = file->batchCursors [ i ];
+				return BTRIEVE_STATUS_CODE_NO_ERROR;
+			}
+		}	// for ( int i = 0; i < batch.count; i++ )
+
+		// If the batch ended the walk.
+		if ( walkStatus != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return walkStatus;
+		}
+	}	// for ( ;; )
+}	// static btrieve_status_code_t BulkRetrieve
+
+
+static btrieve_status_code_t BulkRetrieveEntry ( btrieve_file_t file, const btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, btrieve_bulk_retrieve_result_t bulkRetrieveResult, bool forward )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there are no attributes or no result.
+	if ( bulkRetrieveAttributes == NULL || bulkRetrieveResult == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	status = BulkRetrieve ( file, bulkRetrieveAttributes, bulkRetrieveResult, forward );
+	file->cursor.currentOffset = -1;
+	bulkRetrieveResult->lastStatusCode = status;
+	return SetFileStatus ( file, status );
+}	// static btrieve_status_code_t BulkRetrieveEntry
+
+
+btrieve_status_code_t BtrieveFileBulkRetrieveNext ( btrieve_file_t file, const btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, btrieve_bulk_retrieve_result_t bulkRetrieveResult, btrieve_lock_mode_t lockMode )
+{
+	( void ) lockMode;
+
+	return BulkRetrieveEntry ( file, bulkRetrieveAttributes, bulkRetrieveResult, true );
+}	// btrieve_status_code_t BtrieveFileBulkRetrieveNext
+
+
+btrieve_status_code_t BtrieveFileBulkRetrievePrevious ( btrieve_file_t file, const btrieve_bulk_retrieve_attributes_t bulkRetrieveAttributes, btrieve_bulk_retrieve_result_t bulkRetrieveResult, btrieve_lock_mode_t lockMode )
+{
+	( void ) lockMode;
+
+	return BulkRetrieveEntry ( file, bulkRetrieveAttributes, bulkRetrieveResult, false );
+}	// btrieve_status_code_t BtrieveFileBulkRetrievePrevious
+
+
+btrieve_status_code_t BtrieveFileBulkCreate ( btrieve_file_t file, const btrieve_bulk_create_payload_t bulkCreatePayload, btrieve_bulk_create_result_t bulkCreateResult )
+{
+	std::vector<uint8_t> record;
+	uint64_t address = 0;
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no payload or no result.
+	if ( bulkCreatePayload == NULL || bulkCreateResult == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	bulkCreateResult->cursorPositions.clear ( );
+
+	// If the payload is empty.
+	if ( bulkCreatePayload->lengths.empty ( ) )
+	{
+		bulkCreateResult->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_EXT_INSERT_BUFF;
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_EXT_INSERT_BUFF );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	// If the file can't be written.
+	if ( ( status = BeginFileWrite ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		bulkCreateResult->lastStatusCode = status;
+		return SetFileStatus ( file, status );
+	}
+
+	// Records are created in order; the first failure stops the rest.
+	for ( size_t i = 0; i < bulkCreatePayload->lengths.size ( ); i++ )
+	{
+		const uint8_t* bytes = &bulkCreatePayload->buffer [ bulkCreatePayload->offsets [ i ] ];
+
+		record.assign ( bytes, bytes + bulkCreatePayload->lengths [ i ] );
+
+		// If CreateRecord ( ) fails.
+		if ( ( status = file->shared->CreateRecord ( &record [ 0 ], ( int ) record.size ( ), &address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			break;
+		}
+
+		bulkCreateResult->cursorPositions.push_back ( ( long long ) address );
+	}	// for ( size_t i = 0; i < bulkCreatePayload->lengths.size ( ); i++ )
+
+	// The last record created becomes current.
+	if ( !bulkCreateResult->cursorPositions.empty ( ) )
+	{
+		uint64_t last = ( uint64_t ) bulkCreateResult->cursorPositions.back ( );
+		int index = file->cursor.established ? file->cursor.index : BTRIEVE_INDEX_NONE;
+		IndexDefinition* definition = ( index == BTRIEVE_INDEX_NONE ) ? NULL : file->shared->FindIndex ( index );
+		uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+
+		// If the cursor follows an index, it keeps following it.
+		if ( definition != NULL && file->shared->ReadRecordData ( last, &record ) == BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			ExtractKey ( *definition, &record [ 0 ], key );
+			SetCursor ( file, index, last, key, NULL );
+		}
+		else
+		{
+			SetCursor ( file, BTRIEVE_INDEX_NONE, last, NULL, NULL );
+		}
+	}	// if ( !bulkCreateResult->cursorPositions.empty ( ) )
+
+	bulkCreateResult->lastStatusCode = status;
+	return SetFileStatus ( file, status );
+}	// btrieve_status_code_t BtrieveFileBulkCreate
@@ -0,0 +1,439 @@
+// engine.h : Internal declarations of the in-process engine that implements
+//            the btrieveC.h entry points on Linux.
+//
+// A SharedFile is one file on disk, shared by every handle that opens it
+// in this process. Handles (struct btrieve_file) own a cursor; the shared
+// file owns the page cache, the file header, the record pages and the
+// B+tree indexes.
+//
+
+#ifndef _BTRIEVE_ENGINE_ENGINE_H
+#define _BTRIEVE_ENGINE_ENGINE_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include <btrieveC.h>
+#include <btrieveEngineC.h>
+
+#include "bTree.h"
+#include "bloomFilter.h"
+#include "keys.h"
+#include "pager.h"
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_FILE_MAGIC "BTRLNX01"
+// Format 2 adds the key encoding of each index; format 1 files, whose
+// indexes all hold keys as the records do, still open. Format 3 adds the
+// shared prefixes of leaves and the shortened separators of internal
+// nodes; older index pages read as pages with neither.
+#define ENGINE_FILE_FORMAT 3
+#define ENGINE_OLDEST_FILE_FORMAT 1
+
+#define ENGINE_PAGE_TYPE_HEADER 0x52444842									// "BHDR"
+#define ENGINE_PAGE_TYPE_CONTINUATION 0x544E4342							// "BCNT"
+#define ENGINE_PAGE_TYPE_DATA 0x54414442									// "BDAT"
+#define ENGINE_PAGE_TYPE_OVERFLOW 0x4C564F42								// "BOVL"
+#define ENGINE_PAGE_TYPE_LEAF 0x46414C42									// "BLAF"
+#define ENGINE_PAGE_TYPE_INTERNAL 0x544E4942								// "BINT"
+#define ENGINE_PAGE_TYPE_FREE 0x45455246									// "FREE"
+
+#define ENGINE_DEFAULT_PAGE_SIZE 4096
+#define ENGINE_DEFAULT_MAXIMUM_REJECT_COUNT 65535
+#define ENGINE_OWNER_NAME_LENGTH 24
+
+// Record views are checked by default in builds with assertions: each view
+// is served from a copy that's overwritten with ENGINE_VIEW_POISON once the
+// view is invalidated. BTRIEVE_ENGINE_CHECK_VIEWS=1 in the environment
+// turns the check on in other builds.
+#ifndef ENGINE_CHECK_RECORD_VIEWS
+	#ifdef NDEBUG
+		#define ENGINE_CHECK_RECORD_VIEWS 0
+	#else
+		#define ENGINE_CHECK_RECORD_VIEWS 1
+	#endif
+#endif
+#define ENGINE_VIEW_POISON 0xDD
+
+// A cursor position is the data page number and the slot within it.
+#define ENGINE_ADDRESS(pageNumber, slot) ( ( ( uint64_t ) ( pageNumber ) << 16 ) | ( uint64_t ) ( slot ) )
+#define ENGINE_ADDRESS_PAGE(address) ( ( uint32_t ) ( ( address ) >> 16 ) )
+#define ENGINE_ADDRESS_SLOT(address) ( ( uint32_t ) ( ( address ) & 0xFFFF ) )
+
+#pragma pack(1)
+typedef struct {
+	char magic [ 8 ];
+	uint32_t format;
+	uint32_t pageSize;
+	uint32_t blobLength;
+	uint32_t nextContinuation;
+} HeaderPageHeader;
+
+typedef struct {
+	uint32_t pageType;
+	uint32_t next;
+	uint32_t previous;
+} PageLink;
+
+typedef struct {
+	PageLink link;
+	uint16_t slotCount;
+	uint16_t dataStart;													// Lowest offset used by record bytes.
+	uint16_t liveCount;
+	uint16_t reclaimable;												// Bytes of deleted records below dataStart.
+} DataPageHeader;
+
+typedef struct {
+	uint16_t offset;													// Zero for a free slot.
+	uint16_t length;													// ENGINE_SLOT_OVERFLOW set for an overflow stub.
+} DataSlot;
+
+typedef struct {
+	uint32_t totalLength;
+	uint32_t firstPage;
+} OverflowStub;
+
+typedef struct {
+	PageLink link;
+	uint32_t used;
+} OverflowPageHeader;
+#pragma pack()
+
+#define ENGINE_SLOT_OVERFLOW 0x8000
+#define ENGINE_SLOT_LENGTH_MASK 0x7FFF
+
+uint32_t PageSizeToBytes ( btrieve_page_size_t pageSize );
+btrieve_page_size_t BytesToPageSize ( uint32_t bytes );
+
+
+// The persistent description of a file, held in page zero and its continuation pages.
+struct FileHeader
+{
+	uint32_t pageSize;
+	uint32_t pageCount;
+	uint32_t freePageHead;
+	uint32_t freePageCount;
+	uint32_t firstDataPage;
+	uint32_t lastDataPage;
+	uint32_t dataPageCount;
+	uint64_t recordCount;
+	int32_t fixedRecordLength;
+	int32_t variableLengthRecordsMode;
+	int32_t recordCompressionMode;
+	int32_t fileVersion;
+	int32_t freeSpaceThreshold;
+	int32_t systemDataMode;
+	int32_t pageCompression;
+	int32_t balancedIndexes;
+	int32_t keyOnly;
+	int32_t preallocatedPageCount;
+	int32_t reservedDuplicatePointerCount;
+	int32_t ownerMode;
+	char ownerName [ ENGINE_OWNER_NAME_LENGTH + 1 ];
+	std::vector<uint32_t> continuationPages;
+	std::vector<IndexDefinition> indexes;
+};	// struct FileHeader
+
+
+// File attributes as given to FileCreate.
+struct FileSettings
+{
+	int fixedRecordLength;
+	int variableLengthRecordsMode;
+	int recordCompressionMode;
+	int fileVersion;
+	int freeSpaceThreshold;
+	int systemDataMode;
+	int pageSize;														// btrieve_page_size_t
+	int pageCompression;
+	int balancedIndexes;
+	int keyOnly;
+	int preallocatedPageCount;
+	int reservedDuplicatePointerCount;
+};	// struct FileSettings
+
+
+class SharedFile
+{
+public:
+	SharedFile ( );
+	~SharedFile ( );
+
+	static btrieve_status_code_t Create ( const std::string& path, const FileSettings& settings, const IndexDefinition* index, bool overwrite );
+	btrieve_status_code_t Open ( const std::string& path, bool readOnly );
+	// Called with the latch held exclusively when a handle that may write
+	// opens a file that was opened read-only.
+	btrieve_status_code_t ReopenForWriting ( );
+	btrieve_status_code_t Close ( );
+
+	// Page allocation.
+	btrieve_status_code_t AllocatePage ( uint32_t pageType, uint32_t* pageNumber, PageHandle* page );
+	btrieve_status_code_t FreePage ( uint32_t pageNumber );
+
+	// Record pages.
+	btrieve_status_code_t InsertRecordData ( const uint8_t* record, int length, uint64_t* address );
+	btrieve_status_code_t ReadRecordData ( uint64_t address, std::vector<uint8_t>* record );
+	btrieve_status_code_t PinRecordData ( uint64_t address, PageHandle* page, const uint8_t** bytes, int* length, std::vector<uint8_t>* overflow );
+	btrieve_status_code_t UpdateRecordData ( uint64_t address, const uint8_t* record, int length );
+	btrieve_status_code_t DeleteRecordData ( uint64_t address );
+	bool FirstPhysical ( uint64_t* address );
+	bool LastPhysical ( uint64_t* address );
+	bool NextPhysical ( uint64_t* address );
+	bool PreviousPhysical ( uint64_t* address );
+	bool IsLiveRecord ( uint64_t address );
+
+	// Records together with their index entries.
+	btrieve_status_code_t CreateRecord ( uint8_t* record, int length, uint64_t* address );
+	btrieve_status_code_t UpdateRecord ( uint64_t address, const uint8_t* record, int length );
+	btrieve_status_code_t DeleteRecord ( uint64_t address );
+	btrieve_status_code_t CheckRecordLength ( int length );
+
+	// Indexes.
+	IndexDefinition* FindIndex ( int index );
+	// Options may be NULL, for the defaults.
+	btrieve_status_code_t CreateIndex ( IndexDefinition* definition, const btrieve_index_build_options_t* options );
+	btrieve_status_code_t DropIndex ( int index );
+
+	// Bloom filters of the indexes. ExcludesKey returns true if no entry of
+	// the index has the key; otherwise filtered tells whether a filter
+	// passed the key, so a search that then finds nothing can count a
+	// false positive. Both are called with the latch held at least shared.
+	bool ExcludesKey ( const IndexDefinition* definition, const uint8_t* key, bool* filtered );
+	void CountFalsePositive ( int index );
+	void GetBloomFilterStatistics ( int index, BloomFilterStatistics* statistics );
+
+	// Transactions.
+	btrieve_status_code_t JoinTransaction ( const void* owner );
+	void CommitTransaction ( );
+	void AbortTransaction ( );
+	bool IsLockedByOther ( const void* owner ) const;
+	bool IsTransactionOwner ( const void* owner ) const { return owner != NULL && transactionOwner == owner; }
+
+	btrieve_status_code_t WriteHeader ( );
+	void Touch ( ) { stamp.fetch_add ( 1, std::memory_order_release ); }
+	uint64_t GetStamp ( ) const { return stamp.load ( std::memory_order_acquire ); }
+
+	std::string path;
+	std::shared_mutex latch;
+	Pager pager;
+	FileHeader header;
+	bool headerDirty;
+	bool readOnly;
+	int handleCount;
+	int exclusiveCount;
+
+private:
+	btrieve_status_code_t ReadHeader ( );
+	btrieve_status_code_t ReadRecordOverflow ( const OverflowStub& stub, std::vector<uint8_t>* record );
+	btrieve_status_code_t WriteRecordOverflow ( const uint8_t* record, int length, uint32_t* firstPage );
+	btrieve_status_code_t FreeRecordOverflow ( uint32_t firstPage );
+	btrieve_status_code_t PlaceInPage ( uint32_t pageNumber, const uint8_t* bytes, int length, uint16_t flags, uint64_t* address, bool* placed );
+	btrieve_status_code_t AppendDataPage ( uint32_t* pageNumber );
+	btrieve_status_code_t AssignAutoIncrement ( uint8_t* record );
+	btrieve_status_code_t InsertIndexEntries ( const uint8_t* record, uint64_t address );
+	btrieve_status_code_t CheckUniqueKeys ( const uint8_t* record, uint64_t address );
+	BloomFilter* BuildBloomFilter ( const IndexDefinition* definition, bool* unfilterable );
+	void AddBloomKey ( const IndexDefinition& definition, const uint8_t* key );
+	void RemoveBloomKey ( const IndexDefinition& definition );
+	void ResetBloomFilter ( int index );
+
+	std::atomic<uint64_t> stamp;
+	std::vector<uint32_t> spacePages;
+	const void* transactionOwner;
+	FileHeader transactionHeader;
+	int bloomBitsPerKey;
+	std::mutex bloomMutex;												// Serializes the builds of searches.
+	IndexBloomFilter bloomFilters [ BTRIEVE_INDEX_119 + 1 ];
+};	// class SharedFile
+
+
+// Open shared files by path; each open handle holds a reference.
+std::shared_ptr<SharedFile> FindSharedFile ( const std::string& path );
+void RegisterSharedFile ( const std::shared_ptr<SharedFile>& file );
+void UnregisterSharedFile ( const std::shared_ptr<SharedFile>& file );
+std::mutex& GetRegistryMutex ( );
+
+
+// The position of a handle within a file.
+struct Cursor
+{
+	bool established;
+	int index;															// BTRIEVE_INDEX_NONE for physical order.
+	uint64_t address;
+	std::vector<uint8_t> key;
+	bool recordLoaded;
+	TreePosition hint;													// Valid while hintStamp matches the file.
+	uint64_t hintStamp;
+	int currentOffset;													// For chunk operations, or -1.
+};	// struct Cursor
+
+}	// namespace BtrieveEngine
+
+
+struct btrieve_file;
+
+namespace BtrieveEngine
+{
+
+// Handle helpers shared by the entry points; the callers hold the file's latch,
+// exclusively for BeginFileWrite.
+btrieve_status_code_t SetFileStatus ( btrieve_file* file, btrieve_status_code_t status );
+btrieve_status_code_t CheckFileOpen ( btrieve_file* file );
+btrieve_status_code_t BeginFileWrite ( btrieve_file* file );
+void SetCursor ( btrieve_file* file, int index, uint64_t address, const uint8_t* key, const TreePosition* hint );
+btrieve_status_code_t MoveCursor ( btrieve_file* file, bool forward );
+btrieve_status_code_t SeekCursor ( btrieve_file* file, btrieve_comparison_t comparison, int index, const uint8_t* searchKey, int keyLength );
+btrieve_status_code_t SeekEnd ( btrieve_file* file, int index, bool first );
+btrieve_status_code_t ReadCursorRecord ( btrieve_file* file );
+void InvalidateRecordView ( btrieve_file* file );
+bool IsRecordViewChecking ( );
+
+}	// namespace BtrieveEngine
+
+
+struct btrieve_client
+{
+	int serviceAgentIdentifier;
+	int clientIdentifier;
+	btrieve_status_code_t lastStatusCode;
+	std::string currentDirectory;
+	std::vector<btrieve_file*> files;
+	bool transactionActive;
+	std::vector<std::shared_ptr<BtrieveEngine::SharedFile> > transactionFiles;
+};	// struct btrieve_client
+
+
+struct btrieve_file
+{
+	btrieve_client* client;
+	std::shared_ptr<BtrieveEngine::SharedFile> shared;
+	btrieve_open_mode_t openMode;
+	btrieve_status_code_t lastStatusCode;
+	BtrieveEngine::Cursor cursor;
+	std::vector<uint8_t> scratch;
+	std::vector<std::vector<uint8_t> > batchRecords;						// The records a bulk retrieve filters together,
+	std::vector<BtrieveEngine::Cursor> batchCursors;					// and the cursor at each.
+	BtrieveEngine::PageHandle viewPage;									// Pins the page of the record view.
+	std::vector<uint8_t> viewRecord;									// An overflow record, or a checked view's copy.
+	std::vector<uint8_t> viewRetired;									// The poisoned copy of the last checked view.
+	uint64_t viewGeneration;											// Counts invalidations; zero is never current.
+	bool checkViews;
+};	// struct btrieve_file
+
+
+struct btrieve_file_attributes
+{
+	BtrieveEngine::FileSettings settings;
+};	// struct btrieve_file_attributes
+
+
+struct btrieve_key_segment
+{
+	btrieve_status_code_t lastStatusCode;
+	bool fieldSet;
+	BtrieveEngine::SegmentDefinition segment;
+
+	// Reported by BtrieveFileInformationGetKeySegment.
+	int index;
+	int duplicateMode;
+	int modifiable;
+	int acsMode;
+	int acsNumber;
+	int keyContinues;
+	long long uniqueValueCount;
+};	// struct btrieve_key_segment
+
+
+struct btrieve_index_attributes
+{
+	BtrieveEngine::IndexDefinition definition;
+};	// struct btrieve_index_attributes
+
+
+struct btrieve_filter
+{
+	int offset;
+	int length;
+	int dataType;
+	int comparison;
+	int connector;
+	std::vector<uint8_t> constant;
+	int comparisonField;												// Offset of a field to compare with, or -1.
+	int acsMode;
+	std::string acsName;
+	std::string likeCodePageName;
+};	// struct btrieve_filter
+
+
+struct btrieve_bulk_retrieve_attributes
+{
+	std::vector<std::pair<int, int> > fields;
+	std::vector<btrieve_filter> filters;
+	int maximumRecordCount;
+	int maximumRejectCount;
+	bool skipCurrentRecord;
+};	// struct btrieve_bulk_retrieve_attributes
+
+
+struct btrieve_bulk_retrieve_result
+{
+	btrieve_status_code_t lastStatusCode;
+	std::vector<uint8_t> buffer;
+	std::vector<int> offsets;
+	std::vector<int> lengths;
+	std::vector<long long> cursorPositions;
+};	// struct btrieve_bulk_retrieve_result
+
+
+struct btrieve_bulk_create_payload
+{
+	std::vector<uint8_t> buffer;
+	std::vector<int> offsets;
+	std::vector<int> lengths;
+};	// struct btrieve_bulk_create_payload
+
+
+struct btrieve_bulk_create_result
+{
+	btrieve_status_code_t lastStatusCode;
+	std::vector<long long> cursorPositions;
+};	// struct btrieve_bulk_create_result
+
+
+struct btrieve_file_information
+{
+	btrieve_status_code_t lastStatusCode;
+	BtrieveEngine::FileHeader header;
+	std::vector<long long> uniqueValueCounts;
+	std::vector<BtrieveEngine::BloomFilterStatistics> bloomFilterStatistics;
+	int handleCount;
+	int readOnly;
+	int openTimestamp;
+	int identifier;
+	int transactionActive;
+};	// struct btrieve_file_information
+
+
+struct btrieve_version
+{
+	btrieve_status_code_t lastStatusCode;
+	int clientVersionNumber;
+	int clientRevisionNumber;
+	btrieve_version_type_t clientVersionType;
+	int localVersionNumber;
+	int localRevisionNumber;
+	btrieve_version_type_t localVersionType;
+	int remoteVersionNumber;
+	int remoteRevisionNumber;
+	btrieve_version_type_t remoteVersionType;
+};	// struct btrieve_version
+
+#endif
@@ -0,0 +1,533 @@
+// fileInformation.cpp : BtrieveFileGetInformation and the file information
+//                       getters of the btrieveC.h interface.
+//
+// The information is a snapshot of the file header, taken with the file's
+// latch held, plus a count of unique key values for every index. The
+// engine has no gateway, security, referential integrity, logging or lock
+// owner to report, so those getters return zero and empty names.
+//
+
+#include <string.h>
+#include <sys/stat.h>
+
+#include <btrieveEngineC.h>
+
+#include "engine.h"
+
+using namespace BtrieveEngine;
+
+
+// Count the distinct keys of an index by walking its leaves.
+static long long CountUniqueValues ( SharedFile* shared, IndexDefinition* definition )
+{
+	uint8_t previous [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint64_t address;
+	TreePosition position;
+	long long count = 0;
+	BTree tree ( shared, definition );
+
+	// If the index has no duplicates, every entry is unique.
+	if ( definition->duplicateMode == BTRIEVE_DUPLICATE_MODE_NOT_ALLOWED )
+	{
+		return ( long long ) definition->entryCount;
+	}
+
+	// If First ( ) fails.
+	if ( !tree.First ( &position ) )
+	{
+		return 0;
+	}
+
+	while ( position.page != 0 && tree.ReadEntry ( position, key, &address ) )
+	{
+		// If the key differs from the one before it.
+		if ( count == 0 || CompareKeys ( *definition, previous, key ) != 0 )
+		{
+			count++;
+			memcpy ( previous, key, definition->keyLength );
+		}
+
+		// If Next ( ) fails.
+		if ( !tree.Next ( &position ) )
+		{
+			break;
+		}
+	}	// while ( position.page != 0 && tree.ReadEntry ( position, key, &address ) )
+
+	return count;
+}	// static long long CountUniqueValues
+
+
+// Copy an empty name to the caller.
+static btrieve_status_code_t GetEmptyName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	// If there's no information or no name buffer.
+	if ( fileInformation == NULL || name == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If the name buffer can't hold the terminator.
+	if ( nameSize < 1 )
+	{
+		return fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_DATALENGTH_ERROR;
+	}
+
+	*name = '\0';
+	return fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// static btrieve_status_code_t GetEmptyName
+
+
+btrieve_status_code_t BtrieveFileInformationAllocate ( btrieve_file_information_t* btrieveFileInformationPtr )
+{
+	btrieve_file_information* fileInformation;
+
+	// If there's nowhere to return the information.
+	if ( btrieveFileInformationPtr == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// If new fails.
+	if ( ( fileInformation = new ( std::nothrow ) btrieve_file_information ( ) ) == NULL )
+	{
+		*btrieveFileInformationPtr = NULL;
+		return BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+	}
+
+	fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	*btrieveFileInformationPtr = fileInformation;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileInformationAllocate
+
+
+btrieve_status_code_t BtrieveFileInformationFree ( btrieve_file_information_t fileInformation )
+{
+	// If there's no information.
+	if ( fileInformation == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	delete fileInformation;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t BtrieveFileInformationFree
+
+
+btrieve_status_code_t BtrieveFileGetInformation ( btrieve_file_t file, btrieve_file_information_t fileInformation )
+{
+	btrieve_status_code_t status;
+	struct stat information;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no information.
+	if ( fileInformation == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+	SharedFile* shared = file->shared.get ( );
+
+	fileInformation->header = shared->header;
+	fileInformation->uniqueValueCounts.clear ( );
+	fileInformation->bloomFilterStatistics.resize ( shared->header.indexes.size ( ) );
+
+	for ( size_t i = 0; i < shared->header.indexes.size ( ); i++ )
+	{
+		fileInformation->uniqueValueCounts.push_back ( CountUniqueValues ( shared, &shared->header.indexes [ i ] ) );
+		shared->GetBloomFilterStatistics ( shared->header.indexes [ i ].index, &fileInformation->bloomFilterStatistics [ i ] );
+	}
+
+	fileInformation->handleCount = shared->handleCount;
+	fileInformation->readOnly = ( shared->readOnly || file->openMode == BTRIEVE_OPEN_MODE_READ_ONLY ) ? 1 : 0;
+	fileInformation->openTimestamp = 0;
+	fileInformation->identifier = ( stat ( shared->path.c_str ( ), &information ) == 0 ) ? ( int ) information.st_ino : 0;
+	fileInformation->transactionActive = shared->IsTransactionOwner ( file->client ) ? 1 : 0;
+	fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileGetInformation
+
+
+btrieve_status_code_t BtrieveFileInformationGetLastStatusCode ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_STATUS_CODE_INVALID_PTR_PARM : fileInformation->lastStatusCode;
+}	// btrieve_status_code_t BtrieveFileInformationGetLastStatusCode
+
+
+btrieve_status_code_t BtrieveFileInformationGetBloomFilterStatistics ( btrieve_file_information_t fileInformation, btrieve_index_t index, btrieve_bloom_filter_statistics_t* statistics )
+{
+	// If there's no information or nowhere to put the statistics.
+	if ( fileInformation == NULL || statistics == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	for ( size_t i = 0; i < fileInformation->header.indexes.size ( ); i++ )
+	{
+		const BloomFilterStatistics& found = fileInformation->bloomFilterStatistics [ i ];
+		uint64_t missingCount = found.negativeCount + found.falsePositiveCount;
+
+		// If this isn't the index.
+		if ( fileInformation->header.indexes [ i ].index != index )
+		{
+			continue;
+		}
+
+		statistics->enabled = found.enabled ? 1 : 0;
+		statistics->keyCount = found.keyCount;
+		statistics->bitCount = found.bitCount;
+		statistics->lookupCount = found.lookupCount;
+		statistics->negativeCount = found.negativeCount;
+		statistics->falsePositiveCount = found.falsePositiveCount;
+		statistics->falsePositiveRate = ( missingCount > 0 ) ? ( double ) found.falsePositiveCount / ( double ) missingCount : 0.0;
+		statistics->estimatedFalsePositiveRate = found.estimatedFalsePositiveRate;
+		return fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	}	// for ( size_t i = 0; i < fileInformation->header.indexes.size ( ); i++ )
+
+	memset ( statistics, 0, sizeof ( *statistics ) );
+	return fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+}	// btrieve_status_code_t BtrieveFileInformationGetBloomFilterStatistics
+
+
+btrieve_status_code_t BtrieveFileInformationGetKeySegment ( btrieve_file_information_t fileInformation, btrieve_key_segment_t keySegment, int keySegmentNumber )
+{
+	// If there's no information or no key segment.
+	if ( fileInformation == NULL || keySegment == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// Key segments are numbered from one, across the indexes in order.
+	for ( size_t i = 0, number = 1; i < fileInformation->header.indexes.size ( ); i++ )
+	{
+		const IndexDefinition& definition = fileInformation->header.indexes [ i ];
+
+		// If the segment isn't in this index.
+		if ( keySegmentNumber >= ( int ) ( number + definition.segments.size ( ) ) )
+		{
+			number += definition.segments.size ( );
+			continue;
+		}
+
+		// If the number is before the first segment.
+		if ( keySegmentNumber < ( int ) number )
+		{
+			break;
+		}
+
+		size_t segment = keySegmentNumber - number;
+
+		keySegment->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+		keySegment->fieldSet = true;
+		keySegment->segment = definition.segments [ segment ];
+		keySegment->index = definition.index;
+		keySegment->duplicateMode = definition.duplicateMode;
+		keySegment->modifiable = definition.modifiable;
+		keySegment->acsMode = definition.acsMode;
+		keySegment->acsNumber = definition.acsNumber;
+		keySegment->keyContinues = ( segment + 1 < definition.segments.size ( ) ) ? 1 : 0;
+		keySegment->uniqueValueCount = fileInformation->uniqueValueCounts [ i ];
+		return fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_NO_ERROR;
+	}	// for ( size_t i = 0, number = 1; i < fileInformation->header.indexes.size ( ); i++ )
+
+	return fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_FUNCTION;
+}	// btrieve_status_code_t BtrieveFileInformationGetKeySegment
+
+
+int BtrieveFileInformationGetBalancedIndexes ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->header.balancedIndexes;
+}	// int BtrieveFileInformationGetBalancedIndexes
+
+
+int BtrieveFileInformationGetClientTransactions ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->transactionActive;
+}	// int BtrieveFileInformationGetClientTransactions
+
+
+btrieve_file_version_t BtrieveFileInformationGetFileVersion ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_FILE_VERSION_UNKNOWN : ( btrieve_file_version_t ) fileInformation->header.fileVersion;
+}	// btrieve_file_version_t BtrieveFileInformationGetFileVersion
+
+
+int BtrieveFileInformationGetFixedRecordLength ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->header.fixedRecordLength;
+}	// int BtrieveFileInformationGetFixedRecordLength
+
+
+btrieve_free_space_threshold_t BtrieveFileInformationGetFreeSpaceThreshold ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_FREE_SPACE_THRESHOLD_UNKNOWN : ( btrieve_free_space_threshold_t ) fileInformation->header.freeSpaceThreshold;
+}	// btrieve_free_space_threshold_t BtrieveFileInformationGetFreeSpaceThreshold
+
+
+int BtrieveFileInformationGetHandleCount ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->handleCount;
+}	// int BtrieveFileInformationGetHandleCount
+
+
+int BtrieveFileInformationGetIdentifier ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->identifier;
+}	// int BtrieveFileInformationGetIdentifier
+
+
+int BtrieveFileInformationGetIndexCount ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : ( int ) fileInformation->header.indexes.size ( );
+}	// int BtrieveFileInformationGetIndexCount
+
+
+int BtrieveFileInformationGetKeyOnly ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->header.keyOnly;
+}	// int BtrieveFileInformationGetKeyOnly
+
+
+int BtrieveFileInformationGetOpenTimestamp ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->openTimestamp;
+}	// int BtrieveFileInformationGetOpenTimestamp
+
+
+btrieve_owner_mode_t BtrieveFileInformationGetOwnerMode ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_OWNER_MODE_UNKNOWN : ( btrieve_owner_mode_t ) fileInformation->header.ownerMode;
+}	// btrieve_owner_mode_t BtrieveFileInformationGetOwnerMode
+
+
+int BtrieveFileInformationGetPageCompression ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->header.pageCompression;
+}	// int BtrieveFileInformationGetPageCompression
+
+
+int BtrieveFileInformationGetPagePreallocation ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : ( fileInformation->header.preallocatedPageCount > 0 ? 1 : 0 );
+}	// int BtrieveFileInformationGetPagePreallocation
+
+
+btrieve_page_size_t BtrieveFileInformationGetPageSize ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_PAGE_SIZE_UNKNOWN : BytesToPageSize ( fileInformation->header.pageSize );
+}	// btrieve_page_size_t BtrieveFileInformationGetPageSize
+
+
+int BtrieveFileInformationGetReadOnly ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->readOnly;
+}	// int BtrieveFileInformationGetReadOnly
+
+
+long long BtrieveFileInformationGetRecordCount ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : ( long long ) fileInformation->header.recordCount;
+}	// long long BtrieveFileInformationGetRecordCount
+
+
+btrieve_record_compression_mode_t BtrieveFileInformationGetRecordCompressionMode ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_RECORD_COMPRESSION_MODE_UNKNOWN : ( btrieve_record_compression_mode_t ) fileInformation->header.recordCompressionMode;
+}	// btrieve_record_compression_mode_t BtrieveFileInformationGetRecordCompressionMode
+
+
+int BtrieveFileInformationGetSegmentCount ( btrieve_file_information_t fileInformation )
+{
+	int count = 0;
+
+	// If there's no information.
+	if ( fileInformation == NULL )
+	{
+		return -1;
+	}
+
+	for ( size_t i = 0; i < fileInformation->header.indexes.size ( ); i++ )
+	{
+		count += ( int ) fileInformation->header.indexes [ i ].segments.size ( );
+	}
+
+	return count;
+}	// int BtrieveFileInformationGetSegmentCount
+
+
+btrieve_system_data_mode_t BtrieveFileInformationGetSystemDataMode ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_SYSTEM_DATA_MODE_UNKNOWN : ( btrieve_system_data_mode_t ) fileInformation->header.systemDataMode;
+}	// btrieve_system_data_mode_t BtrieveFileInformationGetSystemDataMode
+
+
+int BtrieveFileInformationGetUnusedDuplicatePointerCount ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->header.reservedDuplicatePointerCount;
+}	// int BtrieveFileInformationGetUnusedDuplicatePointerCount
+
+
+int BtrieveFileInformationGetUnusedPageCount ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : ( int ) fileInformation->header.freePageCount;
+}	// int BtrieveFileInformationGetUnusedPageCount
+
+
+int BtrieveFileInformationGetUsageCount ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? -1 : fileInformation->handleCount;
+}	// int BtrieveFileInformationGetUsageCount
+
+
+btrieve_variable_length_records_mode_t BtrieveFileInformationGetVariableLengthRecordsMode ( btrieve_file_information_t fileInformation )
+{
+	return ( fileInformation == NULL ) ? BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_UNKNOWN : ( btrieve_variable_length_records_mode_t ) fileInformation->header.variableLengthRecordsMode;
+}	// btrieve_variable_length_records_mode_t BtrieveFileInformationGetVariableLengthRecordsMode
+
+
+// Information the engine has nothing to report for.
+#define ENGINE_INFORMATION_NONE(type, name, value) \
+type name ( btrieve_file_information_t fileInformation ) \
+{ \
+	return ( fileInformation == NULL ) ? ( type ) -1 : ( type ) ( value ); \
+}
+
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetContinuousOperation, 0 )
+ENGINE_INFORMATION_NONE ( long long, BtrieveFileInformationGetDuplicateRecordConflictCursorPosition, 0 )
+ENGINE_INFORMATION_NONE ( btrieve_index_t, BtrieveFileInformationGetDuplicateRecordConflictIndex, BTRIEVE_INDEX_NONE )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetExplicitLocks, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetGatewayMajorVersion, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetGatewayMinorVersion, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetGatewayPatchLevel, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetGatewayPlatform, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerClientIdentifier, 0 )
+ENGINE_INFORMATION_NONE ( btrieve_lock_mode_t, BtrieveFileInformationGetLockOwnerExplicitLockMode, BTRIEVE_LOCK_MODE_NONE )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerFileLock, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerImplicitLock, 0 )
+ENGINE_INFORMATION_NONE ( btrieve_index_t, BtrieveFileInformationGetLockOwnerIndex, BTRIEVE_INDEX_NONE )
+ENGINE_INFORMATION_NONE ( btrieve_page_lock_type_t, BtrieveFileInformationGetLockOwnerPageLockType, BTRIEVE_PAGE_LOCK_TYPE_NONE )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerRecordLock, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerSameProcess, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerServiceAgentIdentifier, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerTimeInTransaction, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerTransactionLevel, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerWriteHold, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLockOwnerWriteNoWait, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetLoggable, 0 )
+ENGINE_INFORMATION_NONE ( btrieve_index_t, BtrieveFileInformationGetLogIndex, BTRIEVE_INDEX_NONE )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetReferentialIntegrityConstraints, 0 )
+ENGINE_INFORMATION_NONE ( long long, BtrieveFileInformationGetReferentialIntegrityCursorPosition, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetReferentialIntegrityOperationCode, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseAuthenticationByDatabase, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseAuthorizationByDatabase, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseBtpasswd, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseExplicit, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseImplicit, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabasePAM, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseRTSSComplete, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseRTSSDisabled, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseRTSSPreauthorized, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseTrusted, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseWindowsNamedPipe, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityCurrentDatabaseWorkgroup, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleAuthenticationByDatabase, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleAuthorizationByDatabase, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleBtpasswd, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleExplicit, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleImplicit, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandlePAM, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleRTSSComplete, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleRTSSDisabled, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleRTSSPreauthorized, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleTrusted, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleWindowsNamedPipe, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityHandleWorkgroup, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionAlter, 1 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionCreateFile, 1 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionCreateRecord, 1 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionCreateStoredProcedure, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionCreateView, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionDelete, 1 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionExecute, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionNoRights, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionOpen, 1 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionRead, 1 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionRefer, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSecurityPermissionUpdate, 1 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSegmented, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSystemIndexPresent, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSystemIndexSize, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSystemIndexUsed, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetSystemIndexVersion, 0 )
+ENGINE_INFORMATION_NONE ( int, BtrieveFileInformationGetWrongOwner, 0 )
+
+
+btrieve_status_code_t BtrieveFileInformationGetGatewayName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetGatewayName
+
+
+btrieve_status_code_t BtrieveFileInformationGetLockOwnerName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetLockOwnerName
+
+
+btrieve_status_code_t BtrieveFileInformationGetReferentialIntegrityFileName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetReferentialIntegrityFileName
+
+
+btrieve_status_code_t BtrieveFileInformationGetSecurityCurrentDatabaseName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetSecurityCurrentDatabaseName
+
+
+btrieve_status_code_t BtrieveFileInformationGetSecurityCurrentUserName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetSecurityCurrentUserName
+
+
+btrieve_status_code_t BtrieveFileInformationGetSecurityHandleDatabaseName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetSecurityHandleDatabaseName
+
+
+btrieve_status_code_t BtrieveFileInformationGetSecurityHandleTableName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetSecurityHandleTableName
+
+
+btrieve_status_code_t BtrieveFileInformationGetSecurityHandleUserName ( btrieve_file_information_t fileInformation, char* name, int nameSize )
+{
+	return GetEmptyName ( fileInformation, name, nameSize );
+}	// btrieve_status_code_t BtrieveFileInformationGetSecurityHandleUserName
+
+
+btrieve_status_code_t BtrieveFileInformationGetSegmentFileName ( btrieve_file_information_t fileInformation, int segmentFileNumber, char* name, int nameSize )
+{
+	// If there's no information.
+	if ( fileInformation == NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_PTR_PARM;
+	}
+
+	// Files are never segmented.
+	( void ) segmentFileNumber;
+	( void ) name;
+	( void ) nameSize;
+	return fileInformation->lastStatusCode = BTRIEVE_STATUS_CODE_INVALID_FUNCTION;
+}	// btrieve_status_code_t BtrieveFileInformationGetSegmentFileName
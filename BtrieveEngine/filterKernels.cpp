@@ -0,0 +1,488 @@
+// filterKernels.cpp : Filter evaluation over a batch of records at a time.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "engine.h"
+#include "filterKernels.h"
+
+#if defined ( __GNUC__ ) && ( defined ( __x86_64__ ) || defined ( __i386__ ) )
+#define ENGINE_FILTER_AVX2
+#include <immintrin.h>
+#endif
+
+namespace BtrieveEngine
+{
+
+static bool DetectFilterSimd ( )
+{
+	const char* setting = getenv ( "BTRIEVE_ENGINE_FILTER_SIMD" );
+
+	// If the setting turns the kernels off.
+	if ( setting != NULL && strcmp ( setting, "0" ) == 0 )
+	{
+		return false;
+	}
+
+#ifdef ENGINE_FILTER_AVX2
+	return __builtin_cpu_supports ( "avx2" );
+#else
+	return false;
+#endif
+}	// static bool DetectFilterSimd
+
+
+bool IsFilterSimdEnabled ( )
+{
+	static const bool enabled = DetectFilterSimd ( );
+
+	return enabled;
+}	// bool IsFilterSimdEnabled
+
+
+// Evaluate one filter against one record.
+static bool EvaluateRecordFilter ( const btrieve_filter& filter, const uint8_t* map, const uint8_t* record, int recordLength )
+{
+	const uint8_t* operand;
+	int operandLength;
+	int comparison;
+
+	// If the field isn't in the record.
+	if ( filter.offset + filter.length > recordLength )
+	{
+		return false;
+	}
+
+	// If the operand is another field of the record.
+	if ( filter.comparisonField >= 0 )
+	{
+		// If that field isn't in the record.
+		if ( filter.comparisonField + filter.length > recordLength )
+		{
+			return false;
+		}
+
+		operand = record + filter.comparisonField;
+		operandLength = filter.length;
+	}
+	else
+	{
+		operand = &filter.constant [ 0 ];
+		operandLength = ( int ) filter.constant.size ( );
+	}
+
+	// If the comparison is a pattern match.
+	if ( filter.comparison == BTRIEVE_COMPARISON_LIKE || filter.comparison == BTRIEVE_COMPARISON_NOT_LIKE )
+	{
+		bool matched = MatchLike ( filter.dataType, record + filter.offset, filter.length, operand, operandLength, map );
+
+		return ( filter.comparison == BTRIEVE_COMPARISON_LIKE ) ? matched : !matched;
+	}
+
+	comparison = CompareValues ( filter.dataType, record + filter.offset, filter.length, operand, operandLength, map );
+
+	switch ( filter.comparison )
+	{
+		case BTRIEVE_COMPARISON_EQUAL:
+			return comparison == 0;
+		case BTRIEVE_COMPARISON_NOT_EQUAL:
+			return comparison != 0;
+		case BTRIEVE_COMPARISON_GREATER_THAN:
+			return comparison > 0;
+		case BTRIEVE_COMPARISON_GREATER_THAN_OR_EQUAL:
+			return comparison >= 0;
+		case BTRIEVE_COMPARISON_LESS_THAN:
+			return comparison < 0;
+		case BTRIEVE_COMPARISON_LESS_THAN_OR_EQUAL:
+			return comparison <= 0;
+		default:
+			return false;
+	}
+}	// static bool EvaluateRecordFilter
+
+
+void CompileFilterKernel ( const btrieve_filter& filter, const uint8_t* map, FilterKernel* kernel )
+{
+	kernel->filter = &filter;
+	kernel->map = map;
+	kernel->kind = NUMBER_KIND_NONE;
+	kernel->integerConstant = 0;
+	kernel->realConstant = 0.0;
+
+	// If the comparison is a pattern match.
+	if ( filter.comparison == BTRIEVE_COMPARISON_LIKE || filter.comparison == BTRIEVE_COMPARISON_NOT_LIKE )
+	{
+		return;
+	}
+
+	NumberKind kind = GetNumberKind ( filter.dataType, filter.length );
+
+	// If the field doesn't compare as a number.
+	if ( kind == NUMBER_KIND_NONE )
+	{
+		return;
+	}
+
+	// If the operand is a constant, it must compare as the same kind of number.
+	if ( filter.comparisonField < 0 )
+	{
+		// If it doesn't.
+		if ( GetNumberKind ( filter.dataType, ( int ) filter.constant.size ( ) ) != kind )
+		{
+			return;
+		}
+
+		// The constant is read once, here, rather than once per record.
+		if ( kind == NUMBER_KIND_INTEGER )
+		{
+			kernel->integerConstant = ReadInteger ( filter.dataType, &filter.constant [ 0 ], ( int ) filter.constant.size ( ) );
+		}
+		else
+		{
+			kernel->realConstant = ReadReal ( filter.dataType, &filter.constant [ 0 ], ( int ) filter.constant.size ( ) );
+		}
+	}
+
+	kernel->kind = kind;
+}	// void CompileFilterKernel
+
+
+// Load an integer field. Form is the width of a signed field, minus that
+// of an unsigned one, which are read directly if it's a common width, or
+// zero for a field ReadInteger has to read.
+static inline int64_t LoadInteger ( int dataType, int form, const uint8_t* value, int length )
+{
+	switch ( form )
+	{
+		case 2:
+		{
+			int16_t signedValue;
+
+			memcpy ( &signedValue, value, sizeof ( signedValue ) );
+			return signedValue;
+		}	// case 2
+		case 4:
+		{
+			int32_t signedValue;
+
+			memcpy ( &signedValue, value, sizeof ( signedValue ) );
+			return signedValue;
+		}	// case 4
+		case 8:
+		{
+			int64_t signedValue;
+
+			memcpy ( &signedValue, value, sizeof ( signedValue ) );
+			return signedValue;
+		}	// case 8
+		case -4:
+		{
+			uint32_t unsignedValue;
+
+			memcpy ( &unsignedValue, value, sizeof ( unsignedValue ) );
+			return ( int64_t ) ( unsignedValue ^ ( ( uint64_t ) 1 << 63 ) );
+		}	// case -4
+		case -8:
+		{
+			uint64_t unsignedValue;
+
+			memcpy ( &unsignedValue, value, sizeof ( unsignedValue ) );
+			return ( int64_t ) ( unsignedValue ^ ( ( uint64_t ) 1 << 63 ) );
+		}	// case -8
+		default:
+			return ReadInteger ( dataType, value, length );
+	}	// switch ( form )
+}	// static inline int64_t LoadInteger
+
+
+// Gather a field of the records of a batch, marking the records that hold it.
+static void GatherIntegers ( int dataType, int offset, int length, const FilterBatch& batch, int padded, int64_t* values, uint64_t* present )
+{
+	bool isSigned = dataType == BTRIEVE_DATA_TYPE_INTEGER || dataType == BTRIEVE_DATA_TYPE_AUTOINCREMENT || dataType == BTRIEVE_DATA_TYPE_CURRENCY;
+	int form = isSigned ? length : ( dataType == BTRIEVE_DATA_TYPE_DATE ) ? 0 : -length;
+
+	for ( int i = 0; i < batch.count; i++ )
+	{
+		// If the field isn't in the record.
+		if ( offset + length > batch.lengths [ i ] )
+		{
+			values [ i ] = 0;
+			*present &= ~( ( uint64_t ) 1 << i );
+			continue;
+		}
+
+		values [ i ] = LoadInteger ( dataType, form, batch.records [ i ] + offset, length );
+	}
+
+	for ( int i = batch.count; i < padded; i++ )
+	{
+		values [ i ] = 0;
+	}
+}	// static void GatherIntegers
+
+
+static void GatherReals ( int dataType, int offset, int length, const FilterBatch& batch, int padded, double* values, uint64_t* present )
+{
+	for ( int i = 0; i < batch.count; i++ )
+	{
+		// If the field isn't in the record.
+		if ( offset + length > batch.lengths [ i ] )
+		{
+			values [ i ] = 0.0;
+			*present &= ~( ( uint64_t ) 1 << i );
+			continue;
+		}
+
+		// If the field is an IEEE single.
+		if ( dataType == BTRIEVE_DATA_TYPE_FLOAT && length == 4 )
+		{
+			float single;
+
+			memcpy ( &single, batch.records [ i ] + offset, sizeof ( single ) );
+			values [ i ] = single;
+		}
+		else if ( dataType == BTRIEVE_DATA_TYPE_FLOAT )
+		{
+			memcpy ( &values [ i ], batch.records [ i ] + offset, sizeof ( double ) );
+		}
+		else
+		{
+			values [ i ] = ReadReal ( dataType, batch.records [ i ] + offset, length );
+		}
+	}	// for ( int i = 0; i < batch.count; i++ )
+
+	for ( int i = batch.count; i < padded; i++ )
+	{
+		values [ i ] = 0.0;
+	}
+}	// static void GatherReals
+
+
+// Compare values with operands, setting a bit of less or greater for each
+// value that orders before or after its operand. A step of zero compares
+// every value with the first operand. Count is a multiple of four.
+static void CompareIntegersScalar ( const int64_t* values, const int64_t* operands, int step, int count, uint64_t* less, uint64_t* greater )
+{
+	for ( int i = 0; i < count; i++ )
+	{
+		int64_t operand = operands [ i * step ];
+
+		*less |= ( uint64_t ) ( values [ i ] < operand ) << i;
+		*greater |= ( uint64_t ) ( values [ i ] > operand ) << i;
+	}
+}	// static void CompareIntegersScalar
+
+
+// Values that are NaN, or are compared with NaN, are neither less nor
+// greater, so they compare equal, as CompareValues has them.
+static void CompareRealsScalar ( const double* values, const double* operands, int step, int count, uint64_t* less, uint64_t* greater )
+{
+	for ( int i = 0; i < count; i++ )
+	{
+		double operand = operands [ i * step ];
+
+		*less |= ( uint64_t ) ( values [ i ] < operand ) << i;
+		*greater |= ( uint64_t ) ( values [ i ] > operand ) << i;
+	}
+}	// static void CompareRealsScalar
+
+
+#ifdef ENGINE_FILTER_AVX2
+
+__attribute__ ( ( target ( "avx2" ) ) )
+static void CompareIntegersAvx2 ( const int64_t* values, const int64_t* operands, int step, int count, uint64_t* less, uint64_t* greater )
+{
+	__m256i constant = _mm256_set1_epi64x ( operands [ 0 ] );
+
+	for ( int i = 0; i < count; i += 4 )
+	{
+		__m256i value = _mm256_loadu_si256 ( ( const __m256i* ) ( values + i ) );
+		__m256i operand = ( step == 0 ) ? constant : _mm256_loadu_si256 ( ( const __m256i* ) ( operands + i ) );
+
+		*less |= ( uint64_t ) _mm256_movemask_pd ( _mm256_castsi256_pd ( _mm256_cmpgt_epi64 ( operand, value ) ) ) << i;
+		*greater |= ( uint64_t ) _mm256_movemask_pd ( _mm256_castsi256_pd ( _mm256_cmpgt_epi64 ( value, operand ) ) ) << i;
+	}
+}	// static void CompareIntegersAvx2
+
+
+__attribute__ ( ( target ( "avx2" ) ) )
+static void CompareRealsAvx2 ( const double* values, const double* operands, int step, int count, uint64_t* less, uint64_t* greater )
+{
+	__m256d constant = _mm256_set1_pd ( operands [ 0 ] );
+
+	for ( int i = 0; i < count; i += 4 )
+	{
+		__m256d value = _mm256_loadu_pd ( values + i );
+		__m256d operand = ( step == 0 ) ? constant : _mm256_loadu_pd ( operands + i );
+
+		// The ordered predicates are false for NaN.
+		*less |= ( uint64_t ) _mm256_movemask_pd ( _mm256_cmp_pd ( value, operand, _CMP_LT_OQ ) ) << i;
+		*greater |= ( uint64_t ) _mm256_movemask_pd ( _mm256_cmp_pd ( value, operand, _CMP_GT_OQ ) ) << i;
+	}
+}	// static void CompareRealsAvx2
+
+#endif	// ENGINE_FILTER_AVX2
+
+
+// Return the mask of the values a comparison passes, from their order.
+static uint64_t ComparisonMask ( int comparison, uint64_t less, uint64_t greater )
+{
+	switch ( comparison )
+	{
+		case BTRIEVE_COMPARISON_EQUAL:
+			return ~( less | greater );
+		case BTRIEVE_COMPARISON_NOT_EQUAL:
+			return less | greater;
+		case BTRIEVE_COMPARISON_GREATER_THAN:
+			return greater;
+		case BTRIEVE_COMPARISON_GREATER_THAN_OR_EQUAL:
+			return ~less;
+		case BTRIEVE_COMPARISON_LESS_THAN:
+			return less;
+		case BTRIEVE_COMPARISON_LESS_THAN_OR_EQUAL:
+			return ~greater;
+		default:
+			return 0;
+	}
+}	// static uint64_t ComparisonMask
+
+
+// Return the mask of the wanted records of a batch that pass one filter;
+// a numeric filter decides every record, since that costs no more.
+static uint64_t EvaluateKernel ( const FilterKernel& kernel, const FilterBatch& batch, uint64_t all, uint64_t wanted )
+{
+	const btrieve_filter& filter = *kernel.filter;
+	int padded = ( batch.count + 3 ) & ~3;
+	uint64_t present = all;
+	uint64_t less = 0;
+	uint64_t greater = 0;
+
+	// If the filter is evaluated record by record.
+	if ( kernel.kind == NUMBER_KIND_NONE )
+	{
+		uint64_t passed = 0;
+
+		for ( int i = 0; i < batch.count; i++ )
+		{
+			// If the record's outcome depends on this filter and it passes.
+			if ( ( wanted >> i ) & 1
+				&& EvaluateRecordFilter ( filter, kernel.map, batch.records [ i ], batch.lengths [ i ] ) )
+			{
+				passed |= ( uint64_t ) 1 << i;
+			}
+		}
+
+		return passed;
+	}	// if ( kernel.kind == NUMBER_KIND_NONE )
+
+	// If the field compares as an integer.
+	if ( kernel.kind == NUMBER_KIND_INTEGER )
+	{
+		int64_t values [ ENGINE_FILTER_BATCH_RECORDS ];
+		int64_t operands [ ENGINE_FILTER_BATCH_RECORDS ];
+		int step = 0;
+
+		GatherIntegers ( filter.dataType, filter.offset, filter.length, batch, padded, values, &present );
+
+		// If the operand is another field.
+		if ( filter.comparisonField >= 0 )
+		{
+			GatherIntegers ( filter.dataType, filter.comparisonField, filter.length, batch, padded, operands, &present );
+			step = 1;
+		}
+		else
+		{
+			operands [ 0 ] = kernel.integerConstant;
+		}
+
+#ifdef ENGINE_FILTER_AVX2
+		// If the processor has AVX2.
+		if ( IsFilterSimdEnabled ( ) )
+		{
+			CompareIntegersAvx2 ( values, operands, step, padded, &less, &greater );
+		}
+		else
+#endif
+		{
+			CompareIntegersScalar ( values, operands, step, padded, &less, &greater );
+		}
+	}
+	else
+	{
+		double values [ ENGINE_FILTER_BATCH_RECORDS ];
+		double operands [ ENGINE_FILTER_BATCH_RECORDS ];
+		int step = 0;
+
+		GatherReals ( filter.dataType, filter.offset, filter.length, batch, padded, values, &present );
+
+		// If the operand is another field.
+		if ( filter.comparisonField >= 0 )
+		{
+			GatherReals ( filter.dataType, filter.comparisonField, filter.length, batch, padded, operands, &present );
+			step = 1;
+		}
+		else
+		{
+			operands [ 0 ] = kernel.realConstant;
+		}
+
+#ifdef ENGINE_FILTER_AVX2
+		// If the processor has AVX2.
+		if ( IsFilterSimdEnabled ( ) )
+		{
+			CompareRealsAvx2 ( values, operands, step, padded, &less, &greater );
+		}
+		else
+#endif
+		{
+			CompareRealsScalar ( values, operands, step, padded, &less, &greater );
+		}
+	}	// if ( kernel.kind == NUMBER_KIND_INTEGER )
+
+	return ComparisonMask ( filter.comparison, less, greater ) & present;
+}	// static uint64_t EvaluateKernel
+
+
+uint64_t EvaluateFilterKernels ( const std::vector<FilterKernel>& kernels, const FilterBatch& batch )
+{
+	uint64_t all = ( batch.count >= 64 ) ? ~( uint64_t ) 0 : ( ( uint64_t ) 1 << batch.count ) - 1;
+	uint64_t result;
+
+	// If there's nothing to reject a record.
+	if ( kernels.empty ( ) )
+	{
+		return all;
+	}
+
+	result = EvaluateKernel ( kernels [ 0 ], batch, all, all );
+
+	for ( size_t i = 1; i < kernels.size ( ); i++ )
+	{
+		int connector = kernels [ i - 1 ].filter->connector;
+
+		// If the chain ended at the previous filter.
+		if ( connector == BTRIEVE_CONNECTOR_LAST )
+		{
+			break;
+		}
+
+		// Only the records whose outcome still depends on the filter are evaluated.
+		if ( connector == BTRIEVE_CONNECTOR_AND )
+		{
+			// If any record is still passing.
+			if ( result != 0 )
+			{
+				result &= EvaluateKernel ( kernels [ i ], batch, all, result );
+			}
+		}
+		else if ( result != all )
+		{
+			result |= EvaluateKernel ( kernels [ i ], batch, all, all & ~result );
+		}
+	}	// for ( size_t i = 1; i < kernels.size ( ); i++ )
+
+	return result;
+}	// uint64_t EvaluateFilterKernels
+
+}	// namespace BtrieveEngine
@@ -0,0 +1,67 @@
+// filterKernels.h : Filter evaluation over a batch of records at a time,
+//                   for the bulk retrieves of the in-process engine.
+//
+// A bulk retrieve reads up to ENGINE_FILTER_BATCH_RECORDS records, or
+// ENGINE_FILTER_BATCH_BYTES of record data, ahead and evaluates its
+// filters over all of them together. A filter on a field that compares as a number (an integer, unsigned binary, float,
+// bfloat, currency, date or time of a width that compares numerically)
+// gathers the field of every record of the batch into an array, then
+// compares the array with the constant, or with the other field's array,
+// four values at a time with AVX2 where the processor has it, and one at
+// a time where it doesn't. Other filters are evaluated record by record.
+// Each filter yields a mask of the records it passes, and the masks are
+// joined by the filters' connectors, left to right, as single records are.
+//
+
+#ifndef _BTRIEVE_ENGINE_FILTERKERNELS_H
+#define _BTRIEVE_ENGINE_FILTERKERNELS_H
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "keys.h"
+
+struct btrieve_filter;
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_FILTER_BATCH_RECORDS 64										// One bit each in a mask.
+#define ENGINE_FILTER_BATCH_BYTES 16384										// Keeps a batch of long records in the cache.
+
+// Return false if BTRIEVE_ENGINE_FILTER_SIMD in the environment is "0",
+// or the processor lacks AVX2, so every kernel runs its scalar loop.
+bool IsFilterSimdEnabled ( );
+
+
+// The records of a batch, which the caller keeps in place while it's evaluated.
+struct FilterBatch
+{
+	int count;
+	const uint8_t* records [ ENGINE_FILTER_BATCH_RECORDS ];
+	int lengths [ ENGINE_FILTER_BATCH_RECORDS ];
+};	// struct FilterBatch
+
+
+// A filter prepared for a bulk retrieve.
+struct FilterKernel
+{
+	const btrieve_filter* filter;
+	const uint8_t* map;													// Collation map, or NULL.
+	NumberKind kind;													// NUMBER_KIND_NONE for record by record evaluation.
+	int64_t integerConstant;
+	double realConstant;
+};	// struct FilterKernel
+
+
+// Prepare a filter, which must outlive the kernel, with its collation map.
+void CompileFilterKernel ( const btrieve_filter& filter, const uint8_t* map, FilterKernel* kernel );
+
+// Return the mask of the records of a batch that pass a chain of filters;
+// bit n is record n. An empty chain passes every record.
+uint64_t EvaluateFilterKernels ( const std::vector<FilterKernel>& kernels, const FilterBatch& batch );
+
+}	// namespace BtrieveEngine
+
+#endif
@@ -0,0 +1,414 @@
+// indexBuild.cpp : The parallel gather of a new index's entries, the
+//                  progress of index builds, and
+//                  BtrieveFileIndexCreateWithOptions of btrieveEngineC.h.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <mutex>
+#include <new>
+#include <thread>
+
+#include "engine.h"
+#include "indexBuild.h"
+#include "sorter.h"
+
+namespace BtrieveEngine
+{
+
+int GetIndexBuildThreadCount ( int requested )
+{
+	const char* setting = getenv ( "BTRIEVE_ENGINE_INDEX_THREADS" );
+	char* end;
+	long threads = requested;
+
+	// If no count was asked for, take the setting, or the cores.
+	if ( threads <= 0 )
+	{
+		threads = ( setting != NULL && *setting != '\0' ) ? strtol ( setting, &end, 10 ) : 0;
+
+		// If there's no setting, or it isn't a number.
+		if ( threads <= 0 || *end != '\0' )
+		{
+			threads = ( long ) std::thread::hardware_concurrency ( );
+		}
+	}
+
+	// If the core count is unknown.
+	if ( threads <= 0 )
+	{
+		return 1;
+	}
+
+	return ( threads > ENGINE_MAXIMUM_INDEX_THREADS ) ? ENGINE_MAXIMUM_INDEX_THREADS : ( int ) threads;
+}	// int GetIndexBuildThreadCount
+
+
+IndexBuildProgress::IndexBuildProgress ( const btrieve_index_build_options_t* options, int threadCount, uint64_t recordCount )
+	: callback ( ( options != NULL ) ? options->callback : NULL ),
+	  context ( ( options != NULL ) ? options->context : NULL ),
+	  started ( std::chrono::steady_clock::now ( ) ),
+	  reported ( started ),
+	  recordsRead ( 0 ),
+	  entryCount ( 0 )
+{
+	memset ( &progress, 0, sizeof ( progress ) );
+	progress.phase = BTRIEVE_INDEX_BUILD_PHASE_READ;
+	progress.threadCount = threadCount;
+	progress.recordCount = recordCount;
+}	// IndexBuildProgress::IndexBuildProgress
+
+
+void IndexBuildProgress::StartPhase ( btrieve_index_build_phase_t phase )
+{
+	progress.phase = phase;
+	Report ( true );
+}	// void IndexBuildProgress::StartPhase
+
+
+void IndexBuildProgress::AddRecordsRead ( uint64_t records, uint64_t entries )
+{
+	recordsRead.fetch_add ( records, std::memory_order_relaxed );
+	entryCount.fetch_add ( entries, std::memory_order_relaxed );
+}	// void IndexBuildProgress::AddRecordsRead
+
+
+void IndexBuildProgress::SetEntriesLoaded ( uint64_t entries )
+{
+	progress.entriesLoaded = entries;
+	Report ( false );
+}	// void IndexBuildProgress::SetEntriesLoaded
+
+
+void IndexBuildProgress::Report ( bool force )
+{
+	std::chrono::steady_clock::time_point now;
+	double seconds;
+
+	// If no one's listening.
+	if ( callback == NULL )
+	{
+		return;
+	}
+
+	now = std::chrono::steady_clock::now ( );
+
+	// If the last report was too recent.
+	if ( !force && std::chrono::duration_cast<std::chrono::nanoseconds> ( now - reported ).count ( ) < ENGINE_INDEX_PROGRESS_NANOSECONDS )
+	{
+		return;
+	}
+
+	reported = now;
+	progress.recordsRead = recordsRead.load ( std::memory_order_relaxed );
+	progress.entryCount = entryCount.load ( std::memory_order_relaxed );
+	progress.elapsedNanoseconds = ( unsigned long long ) std::chrono::duration_cast<std::chrono::nanoseconds> ( now - started ).count ( );
+	seconds = ( double ) progress.elapsedNanoseconds / 1e9;
+	progress.recordsPerSecond = ( seconds > 0 ) ? ( double ) progress.recordsRead / seconds : 0;
+	progress.entriesPerSecond = ( seconds > 0 ) ? ( double ) progress.entriesLoaded / seconds : 0;
+	callback ( &progress, context );
+}	// void IndexBuildProgress::Report
+
+
+// Hands out the data pages of a file, in chain order, to the threads of a gather.
+struct PageChain
+{
+	SharedFile* file;
+	std::mutex latch;
+	uint32_t next;
+	btrieve_status_code_t status;										// The first error of any thread.
+
+	// Pin the next page; false once there are none, or a thread failed.
+	bool TakePage ( uint32_t* pageNumber, PageHandle* page )
+	{
+		std::lock_guard<std::mutex> guard ( latch );
+
+		// If the chain is done with.
+		if ( next == 0 || status != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return false;
+		}
+
+		*page = file->pager.Fetch ( next );
+
+		// If Fetch ( ) fails.
+		if ( !page->IsValid ( ) )
+		{
+			status = file->pager.GetLastStatusCode ( );
+			return false;
+		}
+
+		*pageNumber = next;
+		next = ( ( DataPageHeader* ) page->GetData ( ) )->link.next;
+		return true;
+	}	// bool TakePage
+
+	void Fail ( btrieve_status_code_t failure )
+	{
+		std::lock_guard<std::mutex> guard ( latch );
+
+		// If no thread failed before.
+		if ( status == BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			status = failure;
+		}
+	}	// void Fail
+};	// struct PageChain
+
+
+// What one thread of a gather gathers.
+struct GatherWorker
+{
+	EntrySorter* sorter;
+	BloomFilter* filter;
+	bool unfilterable;
+};	// struct GatherWorker
+
+
+// Read the records of pages from the chain until it runs out; the calling
+// thread's worker also reports progress.
+static void GatherPages ( PageChain* chain, const IndexDefinition* definition, GatherWorker* worker, IndexBuildProgress* progress, bool reporting )
+{
+	std::vector<uint8_t> overflow;
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	PageHandle page;
+	uint32_t pageNumber;
+	uint64_t hash;
+	btrieve_status_code_t status;
+
+	while ( chain->TakePage ( &pageNumber, &page ) )
+	{
+		DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+		DataSlot* slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+		uint64_t records = 0;
+		uint64_t entries = 0;
+
+		for ( uint32_t slot = 0; slot < data->slotCount; slot++ )
+		{
+			const uint8_t* record = page.GetData ( ) + slots [ slot ].offset;
+			uint64_t address = ENGINE_ADDRESS ( pageNumber, slot );
+
+			// If the slot is free.
+			if ( slots [ slot ].offset == 0 )
+			{
+				continue;
+			}
+
+			// If the record overflows the page, read it whole.
+			if ( ( slots [ slot ].length & ENGINE_SLOT_OVERFLOW ) != 0 )
+			{
+				// If ReadRecordData ( ) fails.
+				if ( ( status = chain->file->ReadRecordData ( address, &overflow ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+				{
+					chain->Fail ( status );
+					return;
+				}
+
+				record = &overflow [ 0 ];
+			}
+
+			records++;
+
+			// If the record's key isn't indexed.
+			if ( !ExtractKey ( *definition, record, key ) )
+			{
+				continue;
+			}
+
+			// If Add ( ) fails.
+			if ( ( status = worker->sorter->Add ( key, address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+			{
+				chain->Fail ( status );
+				return;
+			}
+
+			entries++;
+
+			// If there's a filter, add the key, unless it can't be hashed.
+			if ( worker->filter != NULL && HashKey ( *definition, key, &hash ) )
+			{
+				worker->filter->Add ( hash );
+			}
+			else if ( worker->filter != NULL )
+			{
+				delete worker->filter;
+				worker->filter = NULL;
+				worker->unfilterable = true;
+			}
+		}	// for ( uint32_t slot = 0; slot < data->slotCount; slot++ )
+
+		page.Release ( );
+		progress->AddRecordsRead ( records, entries );
+
+		// If this is the calling thread.
+		if ( reporting )
+		{
+			progress->Report ( false );
+		}
+	}	// while ( chain->TakePage ( &pageNumber, &page ) )
+}	// static void GatherPages
+
+
+// Sort what a worker gathered.
+static void FinishSorter ( PageChain* chain, GatherWorker* worker )
+{
+	btrieve_status_code_t status;
+
+	// If Finish ( ) fails.
+	if ( ( status = worker->sorter->Finish ( ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		chain->Fail ( status );
+	}
+}	// static void FinishSorter
+
+
+btrieve_status_code_t GatherIndexEntries ( SharedFile* file, const IndexDefinition& definition, int threadCount, int bitsPerKey, IndexBuildProgress* progress, std::vector<EntrySorter*>* sorters, BloomFilter** filter, bool* unfilterable )
+{
+	std::vector<GatherWorker> workers ( threadCount );
+	std::vector<std::thread> threads;
+	uint64_t filterKeys = file->header.recordCount + file->header.recordCount / 4;
+	size_t memoryBytes = GetSortMemoryBudget ( ) / threadCount;
+	bool filtered = ( bitsPerKey > 0 );
+	PageChain chain;
+
+	chain.file = file;
+	chain.next = file->header.firstDataPage;
+	chain.status = BTRIEVE_STATUS_CODE_NO_ERROR;
+	*filter = NULL;
+	*unfilterable = false;
+
+	for ( int i = 0; i < threadCount; i++ )
+	{
+		workers [ i ].sorter = new ( std::nothrow ) EntrySorter ( definition, memoryBytes );
+		workers [ i ].filter = NULL;
+		workers [ i ].unfilterable = false;
+
+		// If there's a sorter, hand it to the caller.
+		if ( workers [ i ].sorter != NULL )
+		{
+			sorters->push_back ( workers [ i ].sorter );
+		}
+		else
+		{
+			chain.status = BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL;
+		}
+
+		// If there's to be a filter, size one for every record.
+		if ( filtered && ( workers [ i ].filter = new ( std::nothrow ) BloomFilter ( ) ) != NULL && !workers [ i ].filter->Allocate ( filterKeys, bitsPerKey ) )
+		{
+			delete workers [ i ].filter;
+			workers [ i ].filter = NULL;
+		}
+
+		filtered = filtered && workers [ i ].filter != NULL;
+	}	// for ( int i = 0; i < threadCount; i++ )
+
+	// If a sorter couldn't be made.
+	if ( chain.status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		for ( int i = 0; i < threadCount; i++ )
+		{
+			delete workers [ i ].filter;
+		}
+
+		return chain.status;
+	}
+
+	// Read the pages on every thread, the calling thread included.
+	for ( int i = 1; i < threadCount; i++ )
+	{
+		threads.push_back ( std::thread ( GatherPages, &chain, &definition, &workers [ i ], progress, false ) );
+	}
+
+	GatherPages ( &chain, &definition, &workers [ 0 ], progress, true );
+
+	for ( size_t i = 0; i < threads.size ( ); i++ )
+	{
+		threads [ i ].join ( );
+	}
+
+	threads.clear ( );
+
+	// If the read went well, sort each thread's entries on that many threads.
+	if ( chain.status == BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		progress->StartPhase ( BTRIEVE_INDEX_BUILD_PHASE_SORT );
+
+		for ( int i = 1; i < threadCount; i++ )
+		{
+			threads.push_back ( std::thread ( FinishSorter, &chain, &workers [ i ] ) );
+		}
+
+		FinishSorter ( &chain, &workers [ 0 ] );
+
+		for ( size_t i = 0; i < threads.size ( ); i++ )
+		{
+			threads [ i ].join ( );
+		}
+	}	// if ( chain.status == BTRIEVE_STATUS_CODE_NO_ERROR )
+
+	// Fold the filters into the first, if every thread kept its own.
+	for ( int i = 0; i < threadCount; i++ )
+	{
+		*unfilterable = *unfilterable || workers [ i ].unfilterable;
+		filtered = filtered && workers [ i ].filter != NULL;
+	}
+
+	for ( int i = 1; i < threadCount; i++ )
+	{
+		// If there's a whole set of filters.
+		if ( filtered )
+		{
+			workers [ 0 ].filter->Merge ( *workers [ i ].filter );
+		}
+
+		delete workers [ i ].filter;
+	}
+
+	// If the first filter holds every key.
+	if ( filtered )
+	{
+		*filter = workers [ 0 ].filter;
+	}
+	else
+	{
+		delete workers [ 0 ].filter;
+	}
+
+	return chain.status;
+}	// btrieve_status_code_t GatherIndexEntries
+
+}	// namespace BtrieveEngine
+
+
+using namespace BtrieveEngine;
+
+
+btrieve_status_code_t BtrieveFileIndexCreateWithOptions ( btrieve_file_t file, btrieve_index_attributes_t indexAttributes, const btrieve_index_build_options_t* options )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there are no index attributes.
+	if ( indexAttributes == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::unique_lock<std::shared_mutex> guard ( file->shared->latch );
+	IndexDefinition definition = indexAttributes->definition;
+
+	// If the file can't be written.
+	if ( ( status = BeginFileWrite ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	return SetFileStatus ( file, file->shared->CreateIndex ( &definition, options ) );
+}	// btrieve_status_code_t BtrieveFileIndexCreateWithOptions
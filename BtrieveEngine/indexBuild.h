@@ -0,0 +1,85 @@
+// indexBuild.h : The parallel gather of a new index's entries, and the
+//                progress of index builds.
+//
+// An index is created in three phases. In the read phase several threads
+// take the data pages of the file one at a time, in chain order, and add
+// the key of each record to an EntrySorter and a Bloom filter of their
+// own; the calling thread is one of them. In the sort phase each thread
+// sorts what it gathered, spilling runs as a lone build would. In the load
+// phase an EntryMerger merges the sorters on a thread of its own while the
+// calling thread builds the tree from the leaves up; the leaves are
+// allocated in order from the one pager, so that stays on one thread.
+//
+// Only the calling thread reports progress, so a callback never runs
+// concurrently with itself.
+//
+
+#ifndef _BTRIEVE_ENGINE_INDEXBUILD_H
+#define _BTRIEVE_ENGINE_INDEXBUILD_H
+
+#include <stdint.h>
+
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+#include <btrieveEngineC.h>
+
+#include "keys.h"
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_MAXIMUM_INDEX_THREADS 64
+// A thread is worth starting for this many data pages.
+#define ENGINE_INDEX_PAGES_PER_THREAD 16
+#define ENGINE_INDEX_PROGRESS_NANOSECONDS 100000000
+
+class BloomFilter;
+class EntrySorter;
+class SharedFile;
+
+// Return the threads of an index build: requested if it's more than zero,
+// else BTRIEVE_ENGINE_INDEX_THREADS from the environment if it's set, else
+// one per core; never more than ENGINE_MAXIMUM_INDEX_THREADS.
+int GetIndexBuildThreadCount ( int requested );
+
+
+class IndexBuildProgress
+{
+public:
+	// options may be NULL, or have no callback, which makes every report a no-op.
+	IndexBuildProgress ( const btrieve_index_build_options_t* options, int threadCount, uint64_t recordCount );
+
+	void StartPhase ( btrieve_index_build_phase_t phase );
+
+	// Count records read by any thread.
+	void AddRecordsRead ( uint64_t records, uint64_t entries );
+
+	void SetEntriesLoaded ( uint64_t entries );
+
+	// Call the callback, if forced or a report is due; only on the calling thread.
+	void Report ( bool force );
+
+private:
+	btrieve_index_build_callback_t callback;
+	void* context;
+	std::chrono::steady_clock::time_point started;
+	std::chrono::steady_clock::time_point reported;
+	btrieve_index_build_progress_t progress;
+	std::atomic<uint64_t> recordsRead;
+	std::atomic<uint64_t> entryCount;
+};	// class IndexBuildProgress
+
+
+// Read the key of every record of file for an index on threadCount
+// threads, into sorters, one per thread, each finished. If bitsPerKey
+// isn't zero, filter is set to a Bloom filter of every key with that many
+// bits per record, or NULL if there's no memory for one or a key can't be
+// hashed, which sets unfilterable. The caller deletes the sorters and the
+// filter, even on an error.
+btrieve_status_code_t GatherIndexEntries ( SharedFile* file, const IndexDefinition& definition, int threadCount, int bitsPerKey, IndexBuildProgress* progress, std::vector<EntrySorter*>* sorters, BloomFilter** filter, bool* unfilterable );
+
+}	// namespace BtrieveEngine
+
+#endif
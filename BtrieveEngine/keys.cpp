@@ -0,0 +1,1510 @@
+// keys.cpp : Key extraction and data type aware comparisons.
+//
+
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "keys.h"
+
+namespace BtrieveEngine
+{
+
+static uint8_t caseInsensitiveMap [ ENGINE_ACS_MAP_LENGTH ];
+static bool caseInsensitiveMapBuilt = false;
+
+
+const uint8_t* GetCaseInsensitiveMap ( )
+{
+	// If the map hasn't been built yet. Building it twice is harmless.
+	if ( !caseInsensitiveMapBuilt )
+	{
+		for ( int i = 0; i < ENGINE_ACS_MAP_LENGTH; i++ )
+		{
+			caseInsensitiveMap [ i ] = ( uint8_t ) ( ( i >= 'a' && i <= 'z' ) ? i - 'a' + 'A' : i );
+		}
+
+		caseInsensitiveMapBuilt = true;
+	}
+
+	return caseInsensitiveMap;
+}	// const uint8_t* GetCaseInsensitiveMap
+
+
+bool IsStringType ( int dataType )
+{
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_CHAR:
+		case BTRIEVE_DATA_TYPE_ZSTRING:
+		case BTRIEVE_DATA_TYPE_LSTRING:
+		case BTRIEVE_DATA_TYPE_LEGACY_STRING:
+			return true;
+		default:
+			return false;
+	}
+}	// bool IsStringType
+
+
+static bool IsValidLength ( int dataType, int length )
+{
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_INTEGER:
+			return length == 1 || length == 2 || length == 4 || length == 8;
+		case BTRIEVE_DATA_TYPE_AUTOINCREMENT:
+			return length == 2 || length == 4 || length == 8;
+		case BTRIEVE_DATA_TYPE_FLOAT:
+		case BTRIEVE_DATA_TYPE_BFLOAT:
+			return length == 4 || length == 8;
+		case BTRIEVE_DATA_TYPE_DATE:
+		case BTRIEVE_DATA_TYPE_TIME:
+			return length == 4;
+		case BTRIEVE_DATA_TYPE_CURRENCY:
+		case BTRIEVE_DATA_TYPE_TIMESTAMP:
+			return length == 8;
+		case BTRIEVE_DATA_TYPE_GUID:
+			return length == 16;
+		case BTRIEVE_DATA_TYPE_LOGICAL:
+			return length == 1 || length == 2;
+		case BTRIEVE_DATA_TYPE_NULL_INDICATOR_SEGMENT:
+			return length == 1;
+		case BTRIEVE_DATA_TYPE_WSTRING:
+		case BTRIEVE_DATA_TYPE_WZSTRING:
+			return ( length % 2 ) == 0;
+		case BTRIEVE_DATA_TYPE_LSTRING:
+		case BTRIEVE_DATA_TYPE_ZSTRING:
+			return length >= 2;
+		case BTRIEVE_DATA_TYPE_CHAR:
+		case BTRIEVE_DATA_TYPE_UNSIGNED_BINARY:
+		case BTRIEVE_DATA_TYPE_DECIMAL:
+		case BTRIEVE_DATA_TYPE_MONEY:
+		case BTRIEVE_DATA_TYPE_NUMERIC:
+		case BTRIEVE_DATA_TYPE_NUMERICSA:
+		case BTRIEVE_DATA_TYPE_NUMERICSTS:
+		case BTRIEVE_DATA_TYPE_LEGACY_STRING:
+		case BTRIEVE_DATA_TYPE_LEGACY_BINARY:
+			return true;
+		default:
+			return false;
+	}
+}	// static bool IsValidLength
+
+
+btrieve_status_code_t ValidateIndexDefinition ( const IndexDefinition& definition, int fixedRecordLength )
+{
+	int keyLength = 0;
+
+	// If the index has no segments.
+	if ( definition.segments.empty ( ) )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_KEYLENGTH;
+	}
+
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+
+		// If the data type is out of range.
+		if ( segment.dataType < BTRIEVE_DATA_TYPE_CHAR || segment.dataType > BTRIEVE_DATA_TYPE_LEGACY_BINARY )
+		{
+			return BTRIEVE_STATUS_CODE_KEY_TYPE_ERROR;
+		}
+
+		// If the segment doesn't lie within the fixed portion of the record.
+		if ( segment.length < 1 || ( int ) segment.offset + ( int ) segment.length > fixedRecordLength )
+		{
+			return BTRIEVE_STATUS_CODE_INVALID_KEY_POSITION;
+		}
+
+		// If the length doesn't suit the data type.
+		if ( !IsValidLength ( segment.dataType, segment.length ) )
+		{
+			return BTRIEVE_STATUS_CODE_INVALID_KEYLENGTH;
+		}
+
+		keyLength += segment.length;
+	}	// for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+
+	// If the key is too long.
+	if ( keyLength > BTRIEVE_MAXIMUM_KEY_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_KEYLENGTH;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t ValidateIndexDefinition
+
+
+// How a segment is written into a normalized key.
+enum SegmentEncoding
+{
+	SEGMENT_ENCODING_NONE,												// Can't be normalized.
+	SEGMENT_ENCODING_UNSIGNED,											// Big endian.
+	SEGMENT_ENCODING_SIGNED,											// Big endian with the sign bit flipped.
+	SEGMENT_ENCODING_FLOAT,												// Big endian, negatives inverted, else the sign bit flipped.
+	SEGMENT_ENCODING_BYTES,												// Through the collation map, if any.
+	SEGMENT_ENCODING_ZSTRING,											// Through the collation map, zeros past the terminator.
+	SEGMENT_ENCODING_WIDE,												// Big endian code units.
+	SEGMENT_ENCODING_WZSTRING											// Big endian code units, zeros past the terminator.
+};	// enum SegmentEncoding
+
+
+bool IsKeyNormalizationEnabled ( )
+{
+	const char* setting = getenv ( "BTRIEVE_ENGINE_NORMALIZED_KEYS" );
+
+	return setting == NULL || strcmp ( setting, "0" ) != 0;
+}	// bool IsKeyNormalizationEnabled
+
+
+// Return the collation map that applies to a segment of an index.
+static const uint8_t* GetSegmentMap ( const IndexDefinition& definition, const SegmentDefinition& segment )
+{
+	switch ( segment.dataType )
+	{
+		case BTRIEVE_DATA_TYPE_CHAR:
+		case BTRIEVE_DATA_TYPE_ZSTRING:
+		case BTRIEVE_DATA_TYPE_LEGACY_STRING:
+			return definition.hasAcsMap ? definition.acsMap : NULL;
+		default:
+			return NULL;
+	}
+}	// static const uint8_t* GetSegmentMap
+
+
+// Return how a segment is normalized, so that memcmp orders the written
+// bytes as CompareValues orders the values.
+static SegmentEncoding GetSegmentEncoding ( const SegmentDefinition& segment, const uint8_t* acsMap )
+{
+	switch ( segment.dataType )
+	{
+		case BTRIEVE_DATA_TYPE_UNSIGNED_BINARY:
+		case BTRIEVE_DATA_TYPE_LOGICAL:
+		case BTRIEVE_DATA_TYPE_TIME:
+		case BTRIEVE_DATA_TYPE_TIMESTAMP:
+		case BTRIEVE_DATA_TYPE_NULL_INDICATOR_SEGMENT:
+		case BTRIEVE_DATA_TYPE_DATE:
+			// A date's day, month and little endian year order as one little endian number.
+			return SEGMENT_ENCODING_UNSIGNED;
+
+		case BTRIEVE_DATA_TYPE_INTEGER:
+		case BTRIEVE_DATA_TYPE_AUTOINCREMENT:
+		case BTRIEVE_DATA_TYPE_CURRENCY:
+			return ( segment.length <= 8 ) ? SEGMENT_ENCODING_SIGNED : SEGMENT_ENCODING_NONE;
+
+		case BTRIEVE_DATA_TYPE_FLOAT:
+			return SEGMENT_ENCODING_FLOAT;
+
+		case BTRIEVE_DATA_TYPE_CHAR:
+		case BTRIEVE_DATA_TYPE_LEGACY_STRING:
+		case BTRIEVE_DATA_TYPE_GUID:
+		case BTRIEVE_DATA_TYPE_LEGACY_BINARY:
+			return SEGMENT_ENCODING_BYTES;
+
+		case BTRIEVE_DATA_TYPE_ZSTRING:
+			// If the map collates a byte as the terminator, a longer text could tie with a shorter one.
+			if ( acsMap != NULL )
+			{
+				for ( int i = 1; i < ENGINE_ACS_MAP_LENGTH; i++ )
+				{
+					if ( acsMap [ i ] == 0 )
+					{
+						return SEGMENT_ENCODING_NONE;
+					}
+				}
+			}
+
+			return SEGMENT_ENCODING_ZSTRING;
+
+		case BTRIEVE_DATA_TYPE_WSTRING:
+			return SEGMENT_ENCODING_WIDE;
+
+		case BTRIEVE_DATA_TYPE_WZSTRING:
+			return SEGMENT_ENCODING_WZSTRING;
+
+		default:
+			// LSTRING texts may hold zeros, and the decimal types and BFLOAT have no byte order.
+			return SEGMENT_ENCODING_NONE;
+	}	// switch ( segment.dataType )
+}	// static SegmentEncoding GetSegmentEncoding
+
+
+// Return true if every segment of an index can be normalized.
+static bool CanNormalizeKey ( const IndexDefinition& definition )
+{
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+
+		// If the segment can't be normalized.
+		if ( GetSegmentEncoding ( segment, GetSegmentMap ( definition, segment ) ) == SEGMENT_ENCODING_NONE )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}	// static bool CanNormalizeKey
+
+
+// Return the bit pattern of a float whose sign orders it: negatives are
+// inverted, else the sign bit is set; negative zero is zero.
+static uint64_t OrderFloatBits ( uint64_t bits, uint64_t signBit, uint64_t mask )
+{
+	// If the value is negative zero.
+	if ( bits == signBit )
+	{
+		bits = 0;
+	}
+
+	return ( ( bits & signBit ) != 0 ) ? ( ~bits & mask ) : ( bits | signBit );
+}	// static uint64_t OrderFloatBits
+
+
+// Write a segment value in normalized form; value and encoded don't overlap.
+static void EncodeSegment ( SegmentEncoding encoding, const uint8_t* value, int length, const uint8_t* acsMap, uint8_t* encoded )
+{
+	switch ( encoding )
+	{
+		case SEGMENT_ENCODING_UNSIGNED:
+		case SEGMENT_ENCODING_SIGNED:
+			for ( int i = 0; i < length; i++ )
+			{
+				encoded [ i ] = value [ length - 1 - i ];
+			}
+
+			// If the value is signed, negatives order first.
+			if ( encoding == SEGMENT_ENCODING_SIGNED )
+			{
+				encoded [ 0 ] ^= 0x80;
+			}
+
+			break;
+
+		case SEGMENT_ENCODING_FLOAT:
+		{
+			uint64_t signBit = ( uint64_t ) 1 << ( length * 8 - 1 );
+			uint64_t mask = signBit | ( signBit - 1 );
+			uint64_t bits = 0;
+
+			memcpy ( &bits, value, length );
+			bits = OrderFloatBits ( bits, signBit, mask );
+
+			for ( int i = 0; i < length; i++ )
+			{
+				encoded [ i ] = ( uint8_t ) ( bits >> ( ( length - 1 - i ) * 8 ) );
+			}
+
+			break;
+		}	// case SEGMENT_ENCODING_FLOAT
+
+		case SEGMENT_ENCODING_BYTES:
+		case SEGMENT_ENCODING_ZSTRING:
+		{
+			const uint8_t* terminator = ( encoding == SEGMENT_ENCODING_ZSTRING ) ? ( const uint8_t* ) memchr ( value, 0, length ) : NULL;
+			int count = ( terminator == NULL ) ? length : ( int ) ( terminator - value );
+
+			// If there's no collation map, the bytes order as they are.
+			if ( acsMap == NULL )
+			{
+				memcpy ( encoded, value, count );
+			}
+			else
+			{
+				for ( int i = 0; i < count; i++ )
+				{
+					encoded [ i ] = acsMap [ value [ i ] ];
+				}
+			}
+
+			memset ( encoded + count, 0, length - count );
+			break;
+		}	// case SEGMENT_ENCODING_ZSTRING
+
+		case SEGMENT_ENCODING_WIDE:
+		case SEGMENT_ENCODING_WZSTRING:
+		{
+			int count = length / 2;
+
+			for ( int i = 0; i < count; i++ )
+			{
+				// If this is the terminating zero code unit.
+				if ( encoding == SEGMENT_ENCODING_WZSTRING && value [ 2 * i ] == 0 && value [ 2 * i + 1 ] == 0 )
+				{
+					count = i;
+					break;
+				}
+
+				encoded [ 2 * i ] = value [ 2 * i + 1 ];
+				encoded [ 2 * i + 1 ] = value [ 2 * i ];
+			}
+
+			memset ( encoded + 2 * count, 0, length - 2 * count );
+			break;
+		}	// case SEGMENT_ENCODING_WZSTRING
+
+		default:
+			memcpy ( encoded, value, length );
+			break;
+	}	// switch ( encoding )
+}	// static void EncodeSegment
+
+
+// Read a normalized segment value back; encoded and value don't overlap.
+// Returns false if the collation map lost the original bytes.
+static bool DecodeSegment ( SegmentEncoding encoding, const uint8_t* encoded, int length, const uint8_t* acsMap, uint8_t* value )
+{
+	switch ( encoding )
+	{
+		case SEGMENT_ENCODING_UNSIGNED:
+		case SEGMENT_ENCODING_SIGNED:
+			for ( int i = 0; i < length; i++ )
+			{
+				value [ i ] = encoded [ length - 1 - i ];
+			}
+
+			// If the value is signed, restore its sign bit.
+			if ( encoding == SEGMENT_ENCODING_SIGNED )
+			{
+				value [ length - 1 ] ^= 0x80;
+			}
+
+			return true;
+
+		case SEGMENT_ENCODING_FLOAT:
+		{
+			uint64_t signBit = ( uint64_t ) 1 << ( length * 8 - 1 );
+			uint64_t mask = signBit | ( signBit - 1 );
+			uint64_t bits = 0;
+
+			for ( int i = 0; i < length; i++ )
+			{
+				bits = ( bits << 8 ) | encoded [ i ];
+			}
+
+			bits = ( ( bits & signBit ) != 0 ) ? ( bits ^ signBit ) : ( ~bits & mask );
+			memcpy ( value, &bits, length );
+			return true;
+		}	// case SEGMENT_ENCODING_FLOAT
+
+		case SEGMENT_ENCODING_BYTES:
+		case SEGMENT_ENCODING_ZSTRING:
+			// If the collation map rewrote the bytes.
+			if ( acsMap != NULL )
+			{
+				return false;
+			}
+
+			memcpy ( value, encoded, length );
+			return true;
+
+		case SEGMENT_ENCODING_WIDE:
+		case SEGMENT_ENCODING_WZSTRING:
+			for ( int i = 0; i < length / 2; i++ )
+			{
+				value [ 2 * i ] = encoded [ 2 * i + 1 ];
+				value [ 2 * i + 1 ] = encoded [ 2 * i ];
+			}
+
+			return true;
+
+		default:
+			memcpy ( value, encoded, length );
+			return true;
+	}	// switch ( encoding )
+}	// static bool DecodeSegment
+
+
+void EncodeKey ( const IndexDefinition& definition, const uint8_t* key, uint8_t* entryKey )
+{
+	uint8_t encoded [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint8_t* cursor = encoded;
+
+	// If the entries hold keys as the records do.
+	if ( definition.keyEncoding != ENGINE_KEY_ENCODING_NORMALIZED )
+	{
+		memmove ( entryKey, key, definition.keyLength );
+		return;
+	}
+
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+		const uint8_t* acsMap = GetSegmentMap ( definition, segment );
+
+		EncodeSegment ( GetSegmentEncoding ( segment, acsMap ), key, segment.length, acsMap, cursor );
+
+		// If the segment is descending, invert it so memcmp orders it backwards.
+		if ( segment.descending )
+		{
+			for ( int j = 0; j < segment.length; j++ )
+			{
+				cursor [ j ] = ( uint8_t ) ~cursor [ j ];
+			}
+		}
+
+		key += segment.length;
+		cursor += segment.length;
+	}	// for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+
+	memcpy ( entryKey, encoded, definition.keyLength );
+}	// void EncodeKey
+
+
+bool DecodeKey ( const IndexDefinition& definition, const uint8_t* entryKey, uint8_t* key )
+{
+	uint8_t encoded [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	const uint8_t* cursor = encoded;
+
+	// If the entries hold keys as the records do.
+	if ( definition.keyEncoding != ENGINE_KEY_ENCODING_NORMALIZED )
+	{
+		memmove ( key, entryKey, definition.keyLength );
+		return true;
+	}
+
+	memcpy ( encoded, entryKey, definition.keyLength );
+
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+		const uint8_t* acsMap = GetSegmentMap ( definition, segment );
+		uint8_t inverted [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+		const uint8_t* source = cursor;
+
+		// If the segment is descending, undo its inversion first.
+		if ( segment.descending )
+		{
+			for ( int j = 0; j < segment.length; j++ )
+			{
+				inverted [ j ] = ( uint8_t ) ~cursor [ j ];
+			}
+
+			source = inverted;
+		}
+
+		// If the segment can't be read back.
+		if ( !DecodeSegment ( GetSegmentEncoding ( segment, acsMap ), source, segment.length, acsMap, key ) )
+		{
+			return false;
+		}
+
+		key += segment.length;
+		cursor += segment.length;
+	}	// for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+
+	return true;
+}	// bool DecodeKey
+
+
+static int CompareSegmentKeys ( const IndexDefinition& definition, const uint8_t* left, const uint8_t* right );
+
+
+void PrepareIndexDefinition ( IndexDefinition* definition )
+{
+	definition->keyLength = 0;
+
+	for ( size_t i = 0; i < definition->segments.size ( ); i++ )
+	{
+		definition->keyLength = ( uint16_t ) ( definition->keyLength + definition->segments [ i ].length );
+	}
+
+	// Case insensitive collation is an upper case map. A named ACS brings its own map, if any.
+	if ( definition->acsMode == BTRIEVE_ACS_MODE_CASE_INSENSITIVE )
+	{
+		memcpy ( definition->acsMap, GetCaseInsensitiveMap ( ), ENGINE_ACS_MAP_LENGTH );
+		definition->hasAcsMap = 1;
+	}
+	else if ( definition->acsMode != BTRIEVE_ACS_MODE_NAMED )
+	{
+		definition->hasAcsMap = 0;
+	}
+
+	definition->keyEncoding = ENGINE_KEY_ENCODING_RAW;
+	definition->comparator = SelectKeyComparator ( *definition );
+
+	// If the key would otherwise be compared segment by segment, normalize it.
+	if ( definition->comparator == CompareSegmentKeys && IsKeyNormalizationEnabled ( ) && CanNormalizeKey ( *definition ) )
+	{
+		definition->keyEncoding = ENGINE_KEY_ENCODING_NORMALIZED;
+		definition->comparator = SelectKeyComparator ( *definition );
+	}
+}	// void PrepareIndexDefinition
+
+
+static bool IsNullSegment ( const SegmentDefinition& segment, const uint8_t* record )
+{
+	for ( int i = 0; i < segment.length; i++ )
+	{
+		// If a byte differs from the null value.
+		if ( record [ segment.offset + i ] != segment.nullValue )
+		{
+			return false;
+		}
+	}
+
+	return true;
+}	// static bool IsNullSegment
+
+
+bool ExtractKey ( const IndexDefinition& definition, const uint8_t* record, uint8_t* key )
+{
+	int allNull				= 1;
+	int anyNull				= 0;
+	int nullKeyMode			= definition.segments [ 0 ].nullKeyMode;
+	uint8_t* cursor			= key;
+
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+
+		memcpy ( cursor, record + segment.offset, segment.length );
+		cursor += segment.length;
+
+		// If null keys are excluded, track which segments hold the null value.
+		if ( nullKeyMode != BTRIEVE_NULL_KEY_MODE_NONE )
+		{
+			int isNull = IsNullSegment ( segment, record ) ? 1 : 0;
+
+			allNull &= isNull;
+			anyNull |= isNull;
+		}
+	}	// for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+
+	EncodeKey ( definition, key, key );
+
+	switch ( nullKeyMode )
+	{
+		case BTRIEVE_NULL_KEY_MODE_ALL_SEGMENTS:
+			return !allNull;
+		case BTRIEVE_NULL_KEY_MODE_ANY_SEGMENTS:
+			return !anyNull;
+		default:
+			return true;
+	}
+}	// bool ExtractKey
+
+
+void CopyRecordKey ( const IndexDefinition& definition, const uint8_t* record, uint8_t* key )
+{
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+
+		memcpy ( key, record + segment.offset, segment.length );
+		key += segment.length;
+	}
+}	// void CopyRecordKey
+
+
+// Any layout: segment by segment, as CompareValues orders each.
+static int CompareSegmentKeys ( const IndexDefinition& definition, const uint8_t* left, const uint8_t* right )
+{
+	const uint8_t* acsMap = definition.hasAcsMap ? definition.acsMap : NULL;
+
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+		int result = CompareValues (
+			segment.dataType,
+			left,
+			segment.length,
+			right,
+			segment.length,
+			acsMap );
+
+		// If the segments differ the key order is decided.
+		if ( result != 0 )
+		{
+			return segment.descending ? -result : result;
+		}
+
+		left += segment.length;
+		right += segment.length;
+	}	// for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+
+	return 0;
+}	// static int CompareSegmentKeys
+
+
+// A single segment integer of the width of Value, which on the little
+// endian hosts the engine runs on reads as one.
+template<typename Value, bool descending>
+static int CompareIntegerKeys ( const IndexDefinition& definition, const uint8_t* left, const uint8_t* right )
+{
+	Value leftValue;
+	Value rightValue;
+	int result;
+
+	( void ) definition;
+	memcpy ( &leftValue, left, sizeof ( Value ) );
+	memcpy ( &rightValue, right, sizeof ( Value ) );
+	result = ( leftValue < rightValue ) ? -1 : ( leftValue > rightValue ) ? 1 : 0;
+	return descending ? -result : result;
+}	// static int CompareIntegerKeys
+
+
+// A single segment string of bytes that compare as they are, or a
+// normalized key; keys of the same index always have the same length.
+template<bool descending>
+static int CompareByteKeys ( const IndexDefinition& definition, const uint8_t* left, const uint8_t* right )
+{
+	int result = memcmp ( left, right, definition.keyLength );
+
+	result = ( result < 0 ) ? -1 : ( result > 0 ) ? 1 : 0;
+	return descending ? -result : result;
+}	// static int CompareByteKeys
+
+
+template<typename Value>
+static KeyComparator SelectIntegerComparator ( bool descending )
+{
+	return descending ? CompareIntegerKeys<Value, true> : CompareIntegerKeys<Value, false>;
+}	// static KeyComparator SelectIntegerComparator
+
+
+KeyComparator SelectKeyComparator ( const IndexDefinition& definition )
+{
+	// If the entries hold normalized keys, which memcmp orders.
+	if ( definition.keyEncoding == ENGINE_KEY_ENCODING_NORMALIZED )
+	{
+		return CompareByteKeys<false>;
+	}
+
+	// If the key has several segments, or none.
+	if ( definition.segments.size ( ) != 1 )
+	{
+		return CompareSegmentKeys;
+	}
+
+	const SegmentDefinition& segment = definition.segments [ 0 ];
+
+	switch ( segment.dataType )
+	{
+		case BTRIEVE_DATA_TYPE_UNSIGNED_BINARY:
+		case BTRIEVE_DATA_TYPE_LOGICAL:
+		case BTRIEVE_DATA_TYPE_TIME:
+		case BTRIEVE_DATA_TYPE_TIMESTAMP:
+		case BTRIEVE_DATA_TYPE_NULL_INDICATOR_SEGMENT:
+			switch ( segment.length )
+			{
+				case 1:
+					return SelectIntegerComparator<uint8_t> ( segment.descending != 0 );
+				case 2:
+					return SelectIntegerComparator<uint16_t> ( segment.descending != 0 );
+				case 4:
+					return SelectIntegerComparator<uint32_t> ( segment.descending != 0 );
+				case 8:
+					return SelectIntegerComparator<uint64_t> ( segment.descending != 0 );
+				default:
+					return CompareSegmentKeys;
+			}
+
+		case BTRIEVE_DATA_TYPE_INTEGER:
+		case BTRIEVE_DATA_TYPE_AUTOINCREMENT:
+		case BTRIEVE_DATA_TYPE_CURRENCY:
+			switch ( segment.length )
+			{
+				case 1:
+					return SelectIntegerComparator<int8_t> ( segment.descending != 0 );
+				case 2:
+					return SelectIntegerComparator<int16_t> ( segment.descending != 0 );
+				case 4:
+					return SelectIntegerComparator<int32_t> ( segment.descending != 0 );
+				case 8:
+					return SelectIntegerComparator<int64_t> ( segment.descending != 0 );
+				default:
+					return CompareSegmentKeys;
+			}
+
+		case BTRIEVE_DATA_TYPE_CHAR:
+		case BTRIEVE_DATA_TYPE_LEGACY_STRING:
+			// A collation map compares the bytes it maps instead.
+			if ( definition.hasAcsMap )
+			{
+				return CompareSegmentKeys;
+			}
+
+			return ( segment.descending != 0 ) ? CompareByteKeys<true> : CompareByteKeys<false>;
+
+		default:
+			return CompareSegmentKeys;
+	}	// switch ( segment.dataType )
+}	// KeyComparator SelectKeyComparator
+
+
+bool IsByteOrdered ( const IndexDefinition& definition )
+{
+	return definition.comparator == CompareByteKeys<false>;
+}	// bool IsByteOrdered
+
+
+struct IntegerComparator
+{
+	KeyComparator comparator;
+	int width;
+	bool isSigned;
+	bool descending;
+};	// struct IntegerComparator
+
+static const IntegerComparator integerComparators [ ] =
+{
+	{ CompareIntegerKeys<uint8_t, false>, 1, false, false },
+	{ CompareIntegerKeys<uint8_t, true>, 1, false, true },
+	{ CompareIntegerKeys<uint16_t, false>, 2, false, false },
+	{ CompareIntegerKeys<uint16_t, true>, 2, false, true },
+	{ CompareIntegerKeys<uint32_t, false>, 4, false, false },
+	{ CompareIntegerKeys<uint32_t, true>, 4, false, true },
+	{ CompareIntegerKeys<uint64_t, false>, 8, false, false },
+	{ CompareIntegerKeys<uint64_t, true>, 8, false, true },
+	{ CompareIntegerKeys<int8_t, false>, 1, true, false },
+	{ CompareIntegerKeys<int8_t, true>, 1, true, true },
+	{ CompareIntegerKeys<int16_t, false>, 2, true, false },
+	{ CompareIntegerKeys<int16_t, true>, 2, true, true },
+	{ CompareIntegerKeys<int32_t, false>, 4, true, false },
+	{ CompareIntegerKeys<int32_t, true>, 4, true, true },
+	{ CompareIntegerKeys<int64_t, false>, 8, true, false },
+	{ CompareIntegerKeys<int64_t, true>, 8, true, true }
+};
+
+
+int GetIntegerKeyWidth ( const IndexDefinition& definition, bool* isSigned, bool* descending )
+{
+	for ( size_t i = 0; i < sizeof ( integerComparators ) / sizeof ( integerComparators [ 0 ] ); i++ )
+	{
+		// If the index compares its keys as integers of this kind.
+		if ( definition.comparator == integerComparators [ i ].comparator && definition.keyLength == integerComparators [ i ].width )
+		{
+			*isSigned = integerComparators [ i ].isSigned;
+			*descending = integerComparators [ i ].descending;
+			return integerComparators [ i ].width;
+		}
+	}
+
+	return 0;
+}	// int GetIntegerKeyWidth
+
+
+static int CompareSigned ( int64_t left, int64_t right )
+{
+	return ( left < right ) ? -1 : ( left > right ) ? 1 : 0;
+}	// static int CompareSigned
+
+
+static int CompareUnsigned ( uint64_t left, uint64_t right )
+{
+	return ( left < right ) ? -1 : ( left > right ) ? 1 : 0;
+}	// static int CompareUnsigned
+
+
+static int CompareDouble ( double left, double right )
+{
+	return ( left < right ) ? -1 : ( left > right ) ? 1 : 0;
+}	// static int CompareDouble
+
+
+static int64_t ReadSigned ( const uint8_t* value, int length )
+{
+	uint64_t result = 0;
+
+	// If the value is wider than 64 bits only the low 64 bits are significant.
+	if ( length > 8 )
+	{
+		length = 8;
+	}
+
+	for ( int i = length - 1; i >= 0; i-- )
+	{
+		result = ( result << 8 ) | value [ i ];
+	}
+
+	// If the value is negative, sign extend it.
+	if ( length < 8 && ( value [ length - 1 ] & 0x80 ) )
+	{
+		result |= ~( uint64_t ) 0 << ( length * 8 );
+	}
+
+	return ( int64_t ) result;
+}	// static int64_t ReadSigned
+
+
+static uint64_t ReadUnsigned ( const uint8_t* value, int length )
+{
+	uint64_t result = 0;
+
+	for ( int i = length - 1; i >= 0; i-- )
+	{
+		result = ( result << 8 ) | value [ i ];
+	}
+
+	return result;
+}	// static uint64_t ReadUnsigned
+
+
+// Little endian unsigned values of any width; the shorter value is zero extended.
+static int CompareUnsignedBinary ( const uint8_t* left, int leftLength, const uint8_t* right, int rightLength )
+{
+	int length = ( leftLength > rightLength ) ? leftLength : rightLength;
+
+	// If both values fit in 64 bits.
+	if ( length <= 8 )
+	{
+		return CompareUnsigned ( ReadUnsigned ( left, leftLength ), ReadUnsigned ( right, rightLength ) );
+	}
+
+	for ( int i = length - 1; i >= 0; i-- )
+	{
+		int leftByte = ( i < leftLength ) ? left [ i ] : 0;
+		int rightByte = ( i < rightLength ) ? right [ i ] : 0;
+
+		// If the bytes differ the order is decided.
+		if ( leftByte != rightByte )
+		{
+			return ( leftByte < rightByte ) ? -1 : 1;
+		}
+	}
+
+	return 0;
+}	// static int CompareUnsignedBinary
+
+
+// Microsoft binary format: the last byte is the exponent, and the sign is
+// the high bit of the byte before it.
+static double ReadBfloat ( const uint8_t* value, int length )
+{
+	int exponent = value [ length - 1 ];
+	int negative = value [ length - 2 ] & 0x80;
+	uint64_t mantissa = 0;
+	double result;
+
+	// If the exponent is zero, so is the value.
+	if ( exponent == 0 )
+	{
+		return 0.0;
+	}
+
+	for ( int i = length - 2; i >= 0; i-- )
+	{
+		mantissa = ( mantissa << 8 ) | value [ i ];
+	}
+
+	mantissa |= ( uint64_t ) 0x80 << ( ( length - 2 ) * 8 );
+	result = ldexp ( ( double ) mantissa, exponent - 128 - ( length - 1 ) * 8 );
+	return negative ? -result : result;
+}	// static double ReadBfloat
+
+
+static double ReadFloat ( int dataType, const uint8_t* value, int length )
+{
+	// If the value is in Microsoft binary format.
+	if ( dataType == BTRIEVE_DATA_TYPE_BFLOAT )
+	{
+		return ReadBfloat ( value, length );
+	}
+
+	// If the value is single precision.
+	if ( length == 4 )
+	{
+		float single;
+
+		memcpy ( &single, value, sizeof ( single ) );
+		return single;
+	}
+
+	double result;
+
+	memcpy ( &result, value, sizeof ( result ) );
+	return result;
+}	// static double ReadFloat
+
+
+// A decimal value reduced to its sign and significant digits.
+struct DecimalValue
+{
+	bool negative;
+	char digits [ 2 * BTRIEVE_MAXIMUM_KEY_LENGTH + 2 ];
+	int digitCount;
+};	// struct DecimalValue
+
+
+static void AppendDigit ( DecimalValue* decimal, int digit )
+{
+	// If the digit is a leading zero it is not significant.
+	if ( decimal->digitCount == 0 && digit == 0 )
+	{
+		return;
+	}
+
+	// If there is room for the digit.
+	if ( decimal->digitCount < ( int ) sizeof ( decimal->digits ) )
+	{
+		decimal->digits [ decimal->digitCount++ ] = ( char ) ( '0' + digit );
+	}
+}	// static void AppendDigit
+
+
+static void ReadDecimal ( int dataType, const uint8_t* value, int length, DecimalValue* decimal )
+{
+	decimal->negative = false;
+	decimal->digitCount = 0;
+
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_DECIMAL:
+		case BTRIEVE_DATA_TYPE_MONEY:
+		{
+			// Packed decimal; the low nibble of the last byte is the sign.
+			int sign = value [ length - 1 ] & 0x0F;
+
+			for ( int i = 0; i < length; i++ )
+			{
+				AppendDigit ( decimal, value [ i ] >> 4 );
+
+				// If this isn't the sign nibble.
+				if ( i < length - 1 )
+				{
+					AppendDigit ( decimal, value [ i ] & 0x0F );
+				}
+			}
+
+			decimal->negative = ( sign == 0x0D || sign == 0x0B );
+			break;
+		}	// case BTRIEVE_DATA_TYPE_DECIMAL
+
+		case BTRIEVE_DATA_TYPE_NUMERICSTS:
+		{
+			// Digits followed by a separate trailing sign.
+			for ( int i = 0; i < length - 1; i++ )
+			{
+				// If the byte is a digit.
+				if ( value [ i ] >= '0' && value [ i ] <= '9' )
+				{
+					AppendDigit ( decimal, value [ i ] - '0' );
+				}
+			}
+
+			decimal->negative = ( value [ length - 1 ] == '-' );
+			break;
+		}	// case BTRIEVE_DATA_TYPE_NUMERICSTS
+
+		default:
+		{
+			// NUMERIC and NUMERICSA overpunch the sign onto the last digit.
+			for ( int i = 0; i < length; i++ )
+			{
+				int character = value [ i ];
+
+				// If the byte is a plain digit.
+				if ( character >= '0' && character <= '9' )
+				{
+					AppendDigit ( decimal, character - '0' );
+				}
+				else if ( i == length - 1 )
+				{
+					if ( character == '{' )
+					{
+						AppendDigit ( decimal, 0 );
+					}
+					else if ( character >= 'A' && character <= 'I' )
+					{
+						AppendDigit ( decimal, character - 'A' + 1 );
+					}
+					else if ( character == '}' )
+					{
+						AppendDigit ( decimal, 0 );
+						decimal->negative = true;
+					}
+					else if ( character >= 'J' && character <= 'R' )
+					{
+						AppendDigit ( decimal, character - 'J' + 1 );
+						decimal->negative = true;
+					}
+					else if ( character >= 'p' && character <= 'y' )
+					{
+						AppendDigit ( decimal, character - 'p' );
+						decimal->negative = true;
+					}
+				}	// else if ( i == length - 1 )
+			}	// for ( int i = 0; i < length; i++ )
+
+			break;
+		}	// default
+	}	// switch ( dataType )
+
+	// If the value is zero it has no sign.
+	if ( decimal->digitCount == 0 )
+	{
+		decimal->negative = false;
+	}
+}	// static void ReadDecimal
+
+
+static int CompareDecimal ( int dataType, const uint8_t* left, int leftLength, const uint8_t* right, int rightLength )
+{
+	DecimalValue leftValue;
+	DecimalValue rightValue;
+	int result;
+
+	ReadDecimal ( dataType, left, leftLength, &leftValue );
+	ReadDecimal ( dataType, right, rightLength, &rightValue );
+
+	// If the signs differ the order is decided.
+	if ( leftValue.negative != rightValue.negative )
+	{
+		return leftValue.negative ? -1 : 1;
+	}
+
+	// Without leading zeros, more digits means a larger magnitude.
+	if ( leftValue.digitCount != rightValue.digitCount )
+	{
+		result = ( leftValue.digitCount < rightValue.digitCount ) ? -1 : 1;
+	}
+	else
+	{
+		result = memcmp ( leftValue.digits, rightValue.digits, leftValue.digitCount );
+		result = ( result < 0 ) ? -1 : ( result > 0 ) ? 1 : 0;
+	}
+
+	return leftValue.negative ? -result : result;
+}	// static int CompareDecimal
+
+
+static int CompareBytes ( const uint8_t* left, int leftLength, const uint8_t* right, int rightLength, const uint8_t* acsMap )
+{
+	int length = ( leftLength < rightLength ) ? leftLength : rightLength;
+
+	// If there is no collation map, the bytes compare directly.
+	if ( acsMap == NULL )
+	{
+		int result = memcmp ( left, right, length );
+
+		// If the common prefix differs the order is decided.
+		if ( result != 0 )
+		{
+			return ( result < 0 ) ? -1 : 1;
+		}
+	}
+	else
+	{
+		for ( int i = 0; i < length; i++ )
+		{
+			// If the collated bytes differ the order is decided.
+			if ( acsMap [ left [ i ] ] != acsMap [ right [ i ] ] )
+			{
+				return ( acsMap [ left [ i ] ] < acsMap [ right [ i ] ] ) ? -1 : 1;
+			}
+		}
+	}	// if ( acsMap == NULL )
+
+	return ( leftLength < rightLength ) ? -1 : ( leftLength > rightLength ) ? 1 : 0;
+}	// static int CompareBytes
+
+
+static int ZeroTerminatedLength ( const uint8_t* value, int length )
+{
+	const uint8_t* terminator = ( const uint8_t* ) memchr ( value, 0, length );
+
+	return ( terminator == NULL ) ? length : ( int ) ( terminator - value );
+}	// static int ZeroTerminatedLength
+
+
+static int CompareWide ( const uint8_t* left, int leftLength, const uint8_t* right, int rightLength, bool zeroTerminated )
+{
+	int leftCount = leftLength / 2;
+	int rightCount = rightLength / 2;
+	int count;
+
+	// If the strings end at a zero code unit, find it.
+	if ( zeroTerminated )
+	{
+		for ( int i = 0; i < leftCount; i++ )
+		{
+			if ( left [ 2 * i ] == 0 && left [ 2 * i + 1 ] == 0 )
+			{
+				leftCount = i;
+				break;
+			}
+		}
+
+		for ( int i = 0; i < rightCount; i++ )
+		{
+			if ( right [ 2 * i ] == 0 && right [ 2 * i + 1 ] == 0 )
+			{
+				rightCount = i;
+				break;
+			}
+		}
+	}	// if ( zeroTerminated )
+
+	count = ( leftCount < rightCount ) ? leftCount : rightCount;
+
+	for ( int i = 0; i < count; i++ )
+	{
+		int leftUnit = left [ 2 * i ] | ( left [ 2 * i + 1 ] << 8 );
+		int rightUnit = right [ 2 * i ] | ( right [ 2 * i + 1 ] << 8 );
+
+		// If the code units differ the order is decided.
+		if ( leftUnit != rightUnit )
+		{
+			return ( leftUnit < rightUnit ) ? -1 : 1;
+		}
+	}
+
+	return ( leftCount < rightCount ) ? -1 : ( leftCount > rightCount ) ? 1 : 0;
+}	// static int CompareWide
+
+
+static uint32_t ReadDate ( const uint8_t* value )
+{
+	// Day, month, and a little endian year.
+	return ( ( uint32_t ) ( value [ 2 ] | ( value [ 3 ] << 8 ) ) << 16 ) | ( ( uint32_t ) value [ 1 ] << 8 ) | value [ 0 ];
+}	// static uint32_t ReadDate
+
+
+int CompareValues ( int dataType, const uint8_t* left, int leftLength, const uint8_t* right, int rightLength, const uint8_t* acsMap )
+{
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_INTEGER:
+		case BTRIEVE_DATA_TYPE_AUTOINCREMENT:
+		case BTRIEVE_DATA_TYPE_CURRENCY:
+			return CompareSigned ( ReadSigned ( left, leftLength ), ReadSigned ( right, rightLength ) );
+
+		case BTRIEVE_DATA_TYPE_UNSIGNED_BINARY:
+		case BTRIEVE_DATA_TYPE_LOGICAL:
+		case BTRIEVE_DATA_TYPE_TIME:
+		case BTRIEVE_DATA_TYPE_TIMESTAMP:
+		case BTRIEVE_DATA_TYPE_NULL_INDICATOR_SEGMENT:
+			return CompareUnsignedBinary ( left, leftLength, right, rightLength );
+
+		case BTRIEVE_DATA_TYPE_FLOAT:
+		case BTRIEVE_DATA_TYPE_BFLOAT:
+			return CompareDouble ( ReadFloat ( dataType, left, leftLength ), ReadFloat ( dataType, right, rightLength ) );
+
+		case BTRIEVE_DATA_TYPE_DATE:
+			return CompareUnsigned ( ReadDate ( left ), ReadDate ( right ) );
+
+		case BTRIEVE_DATA_TYPE_DECIMAL:
+		case BTRIEVE_DATA_TYPE_MONEY:
+		case BTRIEVE_DATA_TYPE_NUMERIC:
+		case BTRIEVE_DATA_TYPE_NUMERICSA:
+		case BTRIEVE_DATA_TYPE_NUMERICSTS:
+			return CompareDecimal ( dataType, left, leftLength, right, rightLength );
+
+		case BTRIEVE_DATA_TYPE_ZSTRING:
+			return CompareBytes ( left, ZeroTerminatedLength ( left, leftLength ), right, ZeroTerminatedLength ( right, rightLength ), acsMap );
+
+		case BTRIEVE_DATA_TYPE_LSTRING:
+		{
+			int leftCount = ( left [ 0 ] < leftLength ) ? left [ 0 ] : leftLength - 1;
+			int rightCount = ( right [ 0 ] < rightLength ) ? right [ 0 ] : rightLength - 1;
+
+			return CompareBytes ( left + 1, leftCount, right + 1, rightCount, acsMap );
+		}	// case BTRIEVE_DATA_TYPE_LSTRING
+
+		case BTRIEVE_DATA_TYPE_WSTRING:
+			return CompareWide ( left, leftLength, right, rightLength, false );
+
+		case BTRIEVE_DATA_TYPE_WZSTRING:
+			return CompareWide ( left, leftLength, right, rightLength, true );
+
+		case BTRIEVE_DATA_TYPE_CHAR:
+		case BTRIEVE_DATA_TYPE_LEGACY_STRING:
+			return CompareBytes ( left, leftLength, right, rightLength, acsMap );
+
+		default:
+			return CompareBytes ( left, leftLength, right, rightLength, NULL );
+	}	// switch ( dataType )
+}	// int CompareValues
+
+
+NumberKind GetNumberKind ( int dataType, int length )
+{
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_INTEGER:
+		case BTRIEVE_DATA_TYPE_AUTOINCREMENT:
+		case BTRIEVE_DATA_TYPE_CURRENCY:
+			return ( length > 0 ) ? NUMBER_KIND_INTEGER : NUMBER_KIND_NONE;
+
+		case BTRIEVE_DATA_TYPE_UNSIGNED_BINARY:
+		case BTRIEVE_DATA_TYPE_LOGICAL:
+		case BTRIEVE_DATA_TYPE_TIME:
+		case BTRIEVE_DATA_TYPE_TIMESTAMP:
+		case BTRIEVE_DATA_TYPE_NULL_INDICATOR_SEGMENT:
+			// Wider values are compared byte by byte.
+			return ( length > 0 && length <= 8 ) ? NUMBER_KIND_INTEGER : NUMBER_KIND_NONE;
+
+		case BTRIEVE_DATA_TYPE_DATE:
+			return ( length == 4 ) ? NUMBER_KIND_INTEGER : NUMBER_KIND_NONE;
+
+		case BTRIEVE_DATA_TYPE_FLOAT:
+		case BTRIEVE_DATA_TYPE_BFLOAT:
+			return ( length == 4 || length == 8 ) ? NUMBER_KIND_REAL : NUMBER_KIND_NONE;
+
+		default:
+			return NUMBER_KIND_NONE;
+	}	// switch ( dataType )
+}	// NumberKind GetNumberKind
+
+
+int64_t ReadInteger ( int dataType, const uint8_t* value, int length )
+{
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_INTEGER:
+		case BTRIEVE_DATA_TYPE_AUTOINCREMENT:
+		case BTRIEVE_DATA_TYPE_CURRENCY:
+			return ReadSigned ( value, length );
+
+		case BTRIEVE_DATA_TYPE_DATE:
+			return ReadDate ( value );
+
+		default:
+			return ( int64_t ) ( ReadUnsigned ( value, length ) ^ ( ( uint64_t ) 1 << 63 ) );
+	}	// switch ( dataType )
+}	// int64_t ReadInteger
+
+
+double ReadReal ( int dataType, const uint8_t* value, int length )
+{
+	return ReadFloat ( dataType, value, length );
+}	// double ReadReal
+
+
+static int TextLength ( int dataType, const uint8_t** value, int length )
+{
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_ZSTRING:
+			return ZeroTerminatedLength ( *value, length );
+
+		case BTRIEVE_DATA_TYPE_LSTRING:
+		{
+			int count = ( ( *value ) [ 0 ] < length ) ? ( *value ) [ 0 ] : length - 1;
+
+			( *value )++;
+			return count;
+		}	// case BTRIEVE_DATA_TYPE_LSTRING
+
+		default:
+			// Fixed width strings are padded with blanks.
+			while ( length > 0 && ( ( *value ) [ length - 1 ] == ' ' || ( *value ) [ length - 1 ] == 0 ) )
+			{
+				length--;
+			}
+
+			return length;
+	}	// switch ( dataType )
+}	// static int TextLength
+
+
+static bool MatchLikeFrom ( const uint8_t* value, int valueLength, const uint8_t* pattern, int patternLength, const uint8_t* acsMap )
+{
+	// Greedy matching with backtracking to the most recent '%'.
+	int valueIndex		= 0;
+	int patternIndex	= 0;
+	int starPattern		= -1;
+	int starValue		= 0;
+
+	while ( valueIndex < valueLength )
+	{
+		// If the pattern has a wildcard or a matching literal here.
+		if ( patternIndex < patternLength && pattern [ patternIndex ] == '%' )
+		{
+			starPattern = patternIndex++;
+			starValue = valueIndex;
+		}
+		else if ( patternIndex < patternLength
+			   && ( pattern [ patternIndex ] == '_'
+				 || ( acsMap ? acsMap [ pattern [ patternIndex ] ] == acsMap [ value [ valueIndex ] ] : pattern [ patternIndex ] == value [ valueIndex ] ) ) )
+		{
+			patternIndex++;
+			valueIndex++;
+		}
+		else if ( starPattern >= 0 )
+		{
+			patternIndex = starPattern + 1;
+			valueIndex = ++starValue;
+		}
+		else
+		{
+			return false;
+		}
+	}	// while ( valueIndex < valueLength )
+
+	while ( patternIndex < patternLength && pattern [ patternIndex ] == '%' )
+	{
+		patternIndex++;
+	}
+
+	return patternIndex == patternLength;
+}	// static bool MatchLikeFrom
+
+
+bool MatchLike ( int dataType, const uint8_t* value, int valueLength, const uint8_t* pattern, int patternLength, const uint8_t* acsMap )
+{
+	valueLength = TextLength ( dataType, &value, valueLength );
+	patternLength = TextLength ( dataType == BTRIEVE_DATA_TYPE_LSTRING ? BTRIEVE_DATA_TYPE_CHAR : dataType, &pattern, patternLength );
+	return MatchLikeFrom ( value, valueLength, pattern, patternLength, acsMap );
+}	// bool MatchLike
+
+
+// Mix a 64 bit word into a hash; the finalizer of MurmurHash3.
+static uint64_t MixHash ( uint64_t hash, uint64_t word )
+{
+	hash ^= word + 0x9E3779B97F4A7C15ULL + ( hash << 6 ) + ( hash >> 2 );
+	hash ^= hash >> 33;
+	hash *= 0xFF51AFD7ED558CCDULL;
+	hash ^= hash >> 33;
+	hash *= 0xC4CEB93FE1A85EC5ULL;
+	hash ^= hash >> 33;
+	return hash;
+}	// static uint64_t MixHash
+
+
+// Mix bytes, each through the collation map if there is one, and their count into a hash.
+static uint64_t HashBytes ( uint64_t hash, const uint8_t* value, int length, const uint8_t* acsMap )
+{
+	uint64_t word = 0;
+	int filled = 0;
+
+	for ( int i = 0; i < length; i++ )
+	{
+		word = ( word << 8 ) | ( acsMap == NULL ? value [ i ] : acsMap [ value [ i ] ] );
+
+		// If the word is full, mix it in.
+		if ( ++filled == 8 )
+		{
+			hash = MixHash ( hash, word );
+			word = 0;
+			filled = 0;
+		}
+	}
+
+	return MixHash ( MixHash ( hash, word ), ( uint64_t ) length );
+}	// static uint64_t HashBytes
+
+
+// Mix a value into a hash so that values CompareValues finds equal hash alike.
+// Returns false if the value equals others that hash differently, as NaN does.
+static bool HashValue ( int dataType, const uint8_t* value, int length, const uint8_t* acsMap, uint64_t* hash )
+{
+	switch ( dataType )
+	{
+		case BTRIEVE_DATA_TYPE_INTEGER:
+		case BTRIEVE_DATA_TYPE_AUTOINCREMENT:
+		case BTRIEVE_DATA_TYPE_CURRENCY:
+			*hash = MixHash ( *hash, ( uint64_t ) ReadSigned ( value, length ) );
+			return true;
+
+		case BTRIEVE_DATA_TYPE_FLOAT:
+		case BTRIEVE_DATA_TYPE_BFLOAT:
+		{
+			double number = ReadFloat ( dataType, value, length );
+			uint64_t bits;
+
+			// If the value is NaN it compares equal to everything.
+			if ( number != number )
+			{
+				return false;
+			}
+
+			// Zero and negative zero compare equal.
+			if ( number == 0.0 )
+			{
+				number = 0.0;
+			}
+
+			memcpy ( &bits, &number, sizeof ( bits ) );
+			*hash = MixHash ( *hash, bits );
+			return true;
+		}	// case BTRIEVE_DATA_TYPE_BFLOAT
+
+		case BTRIEVE_DATA_TYPE_DATE:
+			*hash = MixHash ( *hash, ReadDate ( value ) );
+			return true;
+
+		case BTRIEVE_DATA_TYPE_DECIMAL:
+		case BTRIEVE_DATA_TYPE_MONEY:
+		case BTRIEVE_DATA_TYPE_NUMERIC:
+		case BTRIEVE_DATA_TYPE_NUMERICSA:
+		case BTRIEVE_DATA_TYPE_NUMERICSTS:
+		{
+			DecimalValue decimal;
+
+			ReadDecimal ( dataType, value, length, &decimal );
+			*hash = HashBytes ( MixHash ( *hash, decimal.negative ? 1 : 0 ), ( const uint8_t* ) decimal.digits, decimal.digitCount, NULL );
+			return true;
+		}	// case BTRIEVE_DATA_TYPE_NUMERICSTS
+
+		case BTRIEVE_DATA_TYPE_ZSTRING:
+			*hash = HashBytes ( *hash, value, ZeroTerminatedLength ( value, length ), acsMap );
+			return true;
+
+		case BTRIEVE_DATA_TYPE_LSTRING:
+			*hash = HashBytes ( *hash, value + 1, ( value [ 0 ] < length ) ? value [ 0 ] : length - 1, acsMap );
+			return true;
+
+		case BTRIEVE_DATA_TYPE_WZSTRING:
+		{
+			int count = length / 2;
+
+			for ( int i = 0; i < count; i++ )
+			{
+				// If this is the terminating zero code unit.
+				if ( value [ 2 * i ] == 0 && value [ 2 * i + 1 ] == 0 )
+				{
+					count = i;
+					break;
+				}
+			}
+
+			*hash = HashBytes ( *hash, value, 2 * count, NULL );
+			return true;
+		}	// case BTRIEVE_DATA_TYPE_WZSTRING
+
+		case BTRIEVE_DATA_TYPE_CHAR:
+		case BTRIEVE_DATA_TYPE_LEGACY_STRING:
+			*hash = HashBytes ( *hash, value, length, acsMap );
+			return true;
+
+		default:
+			// Unsigned binary, wide strings and the rest compare their bytes.
+			*hash = HashBytes ( *hash, value, length, NULL );
+			return true;
+	}	// switch ( dataType )
+}	// static bool HashValue
+
+
+bool HashKey ( const IndexDefinition& definition, const uint8_t* key, uint64_t* hash )
+{
+	const uint8_t* acsMap = definition.hasAcsMap ? definition.acsMap : NULL;
+
+	// If the key is normalized, keys that compare equal have the same bytes.
+	if ( definition.keyEncoding == ENGINE_KEY_ENCODING_NORMALIZED )
+	{
+		*hash = HashBytes ( 0, key, definition.keyLength, NULL );
+		return true;
+	}
+
+	*hash = 0;
+
+	for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+	{
+		const SegmentDefinition& segment = definition.segments [ i ];
+
+		// If the segment can't be hashed.
+		if ( !HashValue ( segment.dataType, key, segment.length, acsMap, hash ) )
+		{
+			return false;
+		}
+
+		key += segment.length;
+	}	// for ( size_t i = 0; i < definition.segments.size ( ); i++ )
+
+	return true;
+}	// bool HashKey
+
+}	// namespace BtrieveEngine
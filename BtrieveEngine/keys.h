@@ -0,0 +1,175 @@
+// keys.h : Key segment and index definitions, key extraction, and the
+//          data type aware comparisons that order index entries and
+//          evaluate filters for the in-process engine.
+//
+// Every index compares keys with a comparator picked for its layout when
+// its definition is prepared or read from a file. Single segment integer
+// keys of 1, 2, 4 or 8 bytes and single segment strings without an ACS
+// get comparators specialized for the type and width, which compare the
+// key as one integer or with one memcmp; every other layout compares
+// segment by segment.
+//
+// Indexes created by this engine that would compare keys segment by
+// segment store normalized keys in their entries instead, when every
+// segment can be normalized: each segment is rewritten into bytes that
+// memcmp orders as the index orders the segment, so that the whole key
+// compares with one memcmp. Integers and dates become big endian with the
+// sign bit of signed integers flipped, floats have their sign bit flipped
+// or all their bits inverted when negative, strings are passed through the
+// collation map, zero terminated strings are zeroed past their terminator,
+// wide strings become big endian code units, and descending segments are
+// inverted. LSTRING, BFLOAT and the decimal types can't be normalized, and
+// leave the index storing keys as the records hold them. Keys taken from
+// callers are normalized before a search, and keys handed back are
+// decoded, or read from the record when the collation map lost the
+// original bytes.
+//
+
+#ifndef _BTRIEVE_ENGINE_KEYS_H
+#define _BTRIEVE_ENGINE_KEYS_H
+
+#include <stdint.h>
+
+#include <string>
+#include <vector>
+
+#include <btrieveC.h>
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_ACS_MAP_LENGTH 256
+#define ENGINE_ACS_NAME_LENGTH 16
+
+// How the entries of an index hold their keys; stored with the index.
+#define ENGINE_KEY_ENCODING_RAW 0											// As the records hold them.
+#define ENGINE_KEY_ENCODING_NORMALIZED 1									// Normalized into memcmp order.
+
+struct SegmentDefinition
+{
+	uint16_t offset;
+	uint16_t length;
+	int32_t dataType;													// btrieve_data_type_t
+	uint8_t descending;
+	int32_t nullKeyMode;												// btrieve_null_key_mode_t
+	uint8_t nullValue;
+};	// struct SegmentDefinition
+
+
+struct IndexDefinition;
+
+// Compares two complete keys of an index in index order.
+typedef int ( *KeyComparator ) ( const IndexDefinition& definition, const uint8_t* left, const uint8_t* right );
+
+
+struct IndexDefinition
+{
+	// Definition, as given to IndexCreate.
+	int32_t index;														// btrieve_index_t
+	int32_t duplicateMode;												// btrieve_duplicate_mode_t
+	uint8_t modifiable;
+	int32_t acsMode;													// btrieve_acs_mode_t
+	int32_t acsNumber;
+	char acsName [ ENGINE_ACS_NAME_LENGTH + 1 ];
+	uint8_t hasAcsMap;
+	uint8_t acsMap [ ENGINE_ACS_MAP_LENGTH ];
+	std::vector<SegmentDefinition> segments;
+	uint16_t keyLength;
+	uint8_t keyEncoding;												// ENGINE_KEY_ENCODING_*
+	KeyComparator comparator;											// Picked for the segments; not stored.
+
+	// B+tree state, maintained by BTree.
+	uint32_t rootPage;
+	uint32_t height;
+	uint64_t entryCount;
+	uint32_t pageCount;
+};	// struct IndexDefinition
+
+
+// Validate the segments of an index against the record layout.
+btrieve_status_code_t ValidateIndexDefinition ( const IndexDefinition& definition, int fixedRecordLength );
+
+// Return false if BTRIEVE_ENGINE_NORMALIZED_KEYS is set to 0 in the
+// environment, which leaves new indexes storing keys as the records do.
+bool IsKeyNormalizationEnabled ( );
+
+// Fill in keyLength, the collation map, the key encoding and the comparator from the segments and ACS settings.
+void PrepareIndexDefinition ( IndexDefinition* definition );
+
+// Return the comparator for the segments and collation map of an index.
+KeyComparator SelectKeyComparator ( const IndexDefinition& definition );
+
+// Return true if memcmp over whole keys orders the entries of an index as
+// its comparator does, as it does for normalized keys.
+bool IsByteOrdered ( const IndexDefinition& definition );
+
+// Return the width of a key the comparator reads as one native integer,
+// or zero; isSigned and descending say how the integers order.
+int GetIntegerKeyWidth ( const IndexDefinition& definition, bool* isSigned, bool* descending );
+
+// Copy the key of a record into key, which must hold definition.keyLength
+// bytes, as the index's entries hold it. Returns false if the record holds
+// a null key that the index's null key mode excludes from the index.
+bool ExtractKey ( const IndexDefinition& definition, const uint8_t* record, uint8_t* key );
+
+// Copy the key of a record into key as the record holds it, whatever the index's encoding.
+void CopyRecordKey ( const IndexDefinition& definition, const uint8_t* record, uint8_t* key );
+
+// Rewrite a key as the record holds it into the form the index's entries
+// hold, which is a plain copy unless the index normalizes its keys. key
+// and entryKey may be the same buffer.
+void EncodeKey ( const IndexDefinition& definition, const uint8_t* key, uint8_t* entryKey );
+
+// Rewrite a key as the index's entries hold it into the form a record
+// holds it. Returns false if the encoding lost the original bytes, as a
+// collation map does; negative zero decodes as zero, and a zero terminated
+// string as its text followed by zeros. entryKey and key may be the same
+// buffer.
+bool DecodeKey ( const IndexDefinition& definition, const uint8_t* entryKey, uint8_t* key );
+
+// Compare two complete keys of an index in index order, with the index's comparator.
+inline int CompareKeys ( const IndexDefinition& definition, const uint8_t* left, const uint8_t* right )
+{
+	return definition.comparator ( definition, left, right );
+}	// inline int CompareKeys
+
+// Hash a complete key of an index so that keys CompareKeys finds equal
+// hash alike. Returns false if the key can't be hashed that way, as a
+// floating point NaN, which compares equal to every value, can't; a
+// normalized key is hashed as its bytes, so it always can.
+bool HashKey ( const IndexDefinition& definition, const uint8_t* key, uint64_t* hash );
+
+// Compare two values of a data type, each with its own length; used for keys and filters alike.
+int CompareValues ( int dataType, const uint8_t* left, int leftLength, const uint8_t* right, int rightLength, const uint8_t* acsMap );
+
+// The kinds of number CompareValues compares the values of some data types as.
+enum NumberKind
+{
+	NUMBER_KIND_NONE,													// Compared some other way.
+	NUMBER_KIND_INTEGER,												// Compared as ReadInteger returns them.
+	NUMBER_KIND_REAL													// Compared as ReadReal returns them.
+};	// enum NumberKind
+
+// Return the kind of number CompareValues compares values of a data type
+// and length as, or NUMBER_KIND_NONE if it compares them some other way.
+NumberKind GetNumberKind ( int dataType, int length );
+
+// Read a value of NUMBER_KIND_INTEGER as a signed number that orders as
+// CompareValues orders the value; unsigned values are offset by 2^63.
+int64_t ReadInteger ( int dataType, const uint8_t* value, int length );
+
+// Read a value of NUMBER_KIND_REAL as the double CompareValues compares.
+double ReadReal ( int dataType, const uint8_t* value, int length );
+
+// Match a value against a LIKE pattern using '%' and '_' wildcards.
+bool MatchLike ( int dataType, const uint8_t* value, int valueLength, const uint8_t* pattern, int patternLength, const uint8_t* acsMap );
+
+// Return true if segment values of the data type are stored as a string of bytes.
+bool IsStringType ( int dataType );
+
+// Return the 256 byte upper case collation map.
+const uint8_t* GetCaseInsensitiveMap ( );
+
+}	// namespace BtrieveEngine
+
+#endif
@@ -0,0 +1,195 @@
+// multiGet.cpp : BtrieveFileMultiGet of btrieveEngineC.h, the equal key
+//                retrieval of many keys in one walk of an index.
+//
+// The keys are put in index order and searched for in that order with a
+// BTreeSeeker, which starts each search in the leaf the last one ended
+// in, so keys that share leaves share page reads. Keys the index's Bloom
+// filter rules out aren't searched for at all. The records, lengths and
+// status codes come back in the order the keys were given, and the cursor
+// doesn't move.
+//
+
+#include <string.h>
+
+#include <algorithm>
+
+#include <btrieveEngineC.h>
+
+#include "engine.h"
+
+using namespace BtrieveEngine;
+
+
+// Orders key numbers by their keys in index order, then by number, so equal keys keep their order.
+struct KeyOrder
+{
+	const IndexDefinition* definition;
+	const uint8_t* keys;
+	int keyLength;
+
+	bool operator ( ) ( int left, int right ) const
+	{
+		int result = CompareKeys ( *definition, keys + ( size_t ) left * keyLength, keys + ( size_t ) right * keyLength );
+
+		return ( result != 0 ) ? ( result < 0 ) : ( left < right );
+	}	// bool operator ( )
+};	// struct KeyOrder
+
+
+// Copy a record to its buffer, limited to the buffer, and return its status.
+static btrieve_status_code_t CopyRecord ( const std::vector<uint8_t>& record, char* buffer, int recordSize, int* recordLength )
+{
+	int length = ( int ) record.size ( );
+
+	// If the record doesn't fit, return as much as fits.
+	if ( length > recordSize )
+	{
+		memcpy ( buffer, &record [ 0 ], recordSize );
+		*recordLength = recordSize;
+		return BTRIEVE_STATUS_CODE_DATALENGTH_ERROR;
+	}
+
+	memcpy ( buffer, &record [ 0 ], length );
+	*recordLength = length;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// static btrieve_status_code_t CopyRecord
+
+
+btrieve_status_code_t BtrieveFileMultiGet ( btrieve_file_t file, btrieve_index_t index, const char* keys, int keyLength, int keyCount, char* records, int recordSize, int* recordLengths, btrieve_status_code_t* statusCodes, btrieve_multi_get_statistics_t* statistics )
+{
+	std::vector<uint8_t> record;
+	std::vector<uint8_t> entryKeys;
+	std::vector<int> order;
+	btrieve_status_code_t status;
+	uint64_t baseline;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If the keys or the status codes are missing, or there are records to copy and nowhere to put them.
+	if ( keyCount < 0 || ( keyCount > 0 && ( keys == NULL || statusCodes == NULL ) ) || recordSize < 0 || ( recordSize > 0 && records == NULL ) )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+	SharedFile* shared = file->shared.get ( );
+	IndexDefinition* definition = shared->FindIndex ( index );
+
+	// If the index doesn't exist.
+	if ( definition == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER );
+	}
+
+	// If the keys are shorter than the index's key.
+	if ( keyLength < definition->keyLength )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_KEYBUFFER_TOO_SHORT );
+	}
+
+	// The keys are searched for in the form the index's entries hold them.
+	entryKeys.resize ( ( size_t ) keyCount * definition->keyLength );
+
+	KeyOrder keyOrder = { definition, entryKeys.data ( ), definition->keyLength };
+	BTree tree ( shared, definition );
+	BTreeSeeker seeker ( &tree );
+
+	order.resize ( keyCount );
+
+	for ( int i = 0; i < keyCount; i++ )
+	{
+		order [ i ] = i;
+		EncodeKey ( *definition, ( const uint8_t* ) keys + ( size_t ) i * keyLength, &entryKeys [ ( size_t ) i * definition->keyLength ] );
+
+		// If the caller wants the lengths, those of keys without a record are zero.
+		if ( recordLengths != NULL )
+		{
+			recordLengths [ i ] = 0;
+		}
+	}
+
+	std::sort ( order.begin ( ), order.end ( ), keyOrder );
+	baseline = ( uint64_t ) keyCount * definition->height;
+	status = BTRIEVE_STATUS_CODE_NO_ERROR;
+
+	for ( int i = 0; i < keyCount; i++ )
+	{
+		int number = order [ i ];
+		const uint8_t* key = &entryKeys [ ( size_t ) number * definition->keyLength ];
+		const uint8_t* entry;
+		uint64_t address;
+		bool filtered;
+		int length;
+
+		// If a search has failed, the keys after it aren't searched for.
+		if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			statusCodes [ number ] = status;
+			continue;
+		}
+
+		// If the index's filter rules the key out.
+		if ( shared->ExcludesKey ( definition, key, &filtered ) )
+		{
+			statusCodes [ number ] = BTRIEVE_STATUS_CODE_KEY_VALUE_NOT_FOUND;
+			continue;
+		}
+
+		// If Seek ( ) fails.
+		if ( !seeker.Seek ( key, &entry ) )
+		{
+			statusCodes [ number ] = status = BTRIEVE_STATUS_CODE_IO_ERROR;
+			continue;
+		}
+
+		// If no entry has the key.
+		if ( entry == NULL || CompareKeys ( *definition, entry, key ) != 0 )
+		{
+			// If the filter passed a key that isn't there.
+			if ( filtered )
+			{
+				shared->CountFalsePositive ( index );
+			}
+
+			statusCodes [ number ] = BTRIEVE_STATUS_CODE_KEY_VALUE_NOT_FOUND;
+			continue;
+		}
+
+		// If only the status codes are wanted.
+		if ( recordSize == 0 )
+		{
+			statusCodes [ number ] = BTRIEVE_STATUS_CODE_NO_ERROR;
+			continue;
+		}
+
+		memcpy ( &address, entry + definition->keyLength, sizeof ( address ) );
+
+		// If ReadRecordData ( ) fails.
+		if ( ( statusCodes [ number ] = shared->ReadRecordData ( address, &record ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			status = statusCodes [ number ];
+			continue;
+		}
+
+		statusCodes [ number ] = CopyRecord ( record, records + ( size_t ) number * recordSize, recordSize, &length );
+
+		// If the caller wants the lengths.
+		if ( recordLengths != NULL )
+		{
+			recordLengths [ number ] = length;
+		}
+	}	// for ( int i = 0; i < keyCount; i++ )
+
+	// If the caller wants the page reads.
+	if ( statistics != NULL )
+	{
+		statistics->pageReadCount = ( long long ) seeker.GetPageReadCount ( );
+		statistics->savedPageReadCount = ( long long ) baseline - ( long long ) seeker.GetPageReadCount ( );
+	}
+
+	return SetFileStatus ( file, status );
+}	// btrieve_status_code_t BtrieveFileMultiGet
@@ -0,0 +1,584 @@
+// pager.cpp : Page cache and page I/O for one open file of the in-process engine.
+//
+// Pages are cached in fixed frames with clock replacement. Frames never
+// move, so a pinned page can be read in place until it is released.
+//
+// A file opened only for reading is mapped whole instead, and its pages
+// are fetched where they lie in the mapping, without the latch, a lookup
+// or a copy; pinning them is free. Pages past the mapping, such as a
+// partial page at the end of the file, still go through the cache.
+// Reopening the file for writing sends every fetch to the cache, but the
+// mapping stays until the file is closed, as pages may still be pinned in
+// it. Another process mustn't truncate a mapped file.
+//
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pager.h"
+
+namespace BtrieveEngine
+{
+
+PageHandle::PageHandle ( )
+	: pager ( NULL ), frame ( 0 ), data ( NULL )
+{
+}	// PageHandle::PageHandle
+
+
+PageHandle::PageHandle ( Pager* pagerIn, uint32_t frameIn, uint8_t* dataIn )
+	: pager ( pagerIn ), frame ( frameIn ), data ( dataIn )
+{
+}	// PageHandle::PageHandle
+
+
+PageHandle::PageHandle ( PageHandle&& other )
+	: pager ( other.pager ), frame ( other.frame ), data ( other.data )
+{
+	other.pager = NULL;
+	other.data = NULL;
+}	// PageHandle::PageHandle
+
+
+PageHandle& PageHandle::operator= ( PageHandle&& other )
+{
+	// If this isn't a self assignment.
+	if ( this != &other )
+	{
+		Release ( );
+		pager = other.pager;
+		frame = other.frame;
+		data = other.data;
+		other.pager = NULL;
+		other.data = NULL;
+	}
+
+	return *this;
+}	// PageHandle& PageHandle::operator=
+
+
+PageHandle::~PageHandle ( )
+{
+	Release ( );
+}	// PageHandle::~PageHandle
+
+
+void PageHandle::Release ( )
+{
+	// If a page is pinned.
+	if ( data != NULL )
+	{
+		pager->Unpin ( frame );
+		pager = NULL;
+		data = NULL;
+	}
+}	// void PageHandle::Release
+
+
+bool IsFileMappingEnabled ( )
+{
+	const char* setting = getenv ( "BTRIEVE_ENGINE_MAPPED_FILES" );
+
+	return setting == NULL || strcmp ( setting, "0" ) != 0;
+}	// bool IsFileMappingEnabled
+
+
+Pager::Pager ( )
+	: fileDescriptor ( -1 ),
+	  readOnly ( false ),
+	  mapping ( NULL ),
+	  mappingLength ( 0 ),
+	  mappedPages ( 0 ),
+	  accessHint ( BTRIEVE_ACCESS_HINT_NORMAL ),
+	  pageSize ( 0 ),
+	  cacheBytes ( ENGINE_DEFAULT_CACHE_BYTES ),
+	  clockHand ( 0 ),
+	  lastStatusCode ( BTRIEVE_STATUS_CODE_NO_ERROR ),
+	  preimagesActive ( false )
+{
+	memset ( &statistics, 0, sizeof ( statistics ) );
+}	// Pager::Pager
+
+
+Pager::~Pager ( )
+{
+	Close ( );
+}	// Pager::~Pager
+
+
+// Return the status code for the errno of a failed open ( ).
+static btrieve_status_code_t GetOpenStatus ( int error, bool create )
+{
+	switch ( error )
+	{
+		case ENOENT:
+			return create ? BTRIEVE_STATUS_CODE_CREATE_IO_ERROR : BTRIEVE_STATUS_CODE_FILE_NOT_FOUND;
+		case EACCES:
+		case EPERM:
+		case EROFS:
+			return BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED;
+		case EMFILE:
+		case ENFILE:
+			return BTRIEVE_STATUS_CODE_MAXIMUM_OPEN_FILES;
+		case ENAMETOOLONG:
+		case EISDIR:
+			return BTRIEVE_STATUS_CODE_FILENAME_BAD;
+		default:
+			return create ? BTRIEVE_STATUS_CODE_CREATE_IO_ERROR : BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+}	// static btrieve_status_code_t GetOpenStatus
+
+
+btrieve_status_code_t Pager::Open ( const std::string& path, bool create, bool readOnlyIn )
+{
+	int flags = readOnlyIn ? O_RDONLY : O_RDWR;
+
+	// If the file is being created.
+	if ( create )
+	{
+		flags |= O_CREAT | O_TRUNC;
+	}
+
+	fileDescriptor = open ( path.c_str ( ), flags | O_CLOEXEC, 0644 );
+
+	// If open ( ) fails.
+	if ( fileDescriptor < 0 )
+	{
+		return GetOpenStatus ( errno, create );
+	}
+
+	readOnly = readOnlyIn;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t Pager::Open
+
+
+bool Pager::Map ( )
+{
+	struct stat status;
+	size_t length;
+	void* address;
+
+	// If the size of the file can't be learned.
+	if ( fstat ( fileDescriptor, &status ) != 0 )
+	{
+		return false;
+	}
+
+	length = ( size_t ) status.st_size - ( size_t ) status.st_size % pageSize;
+
+	// If the file has no whole page.
+	if ( length == 0 )
+	{
+		return false;
+	}
+
+	address = mmap ( NULL, length, PROT_READ, MAP_SHARED, fileDescriptor, 0 );
+
+	// If mmap ( ) fails, the cache reads the pages.
+	if ( address == MAP_FAILED )
+	{
+		return false;
+	}
+
+	mapping = ( uint8_t* ) address;
+	mappingLength = length;
+	mappedPages = ( uint32_t ) ( length / pageSize );
+	return true;
+}	// bool Pager::Map
+
+
+btrieve_status_code_t Pager::ReopenForWriting ( const std::string& path )
+{
+	int descriptor = open ( path.c_str ( ), O_RDWR | O_CLOEXEC );
+
+	// If open ( ) fails.
+	if ( descriptor < 0 )
+	{
+		return GetOpenStatus ( errno, false );
+	}
+
+	close ( fileDescriptor );
+	fileDescriptor = descriptor;
+	readOnly = false;
+	mappedPages = 0;
+	SetAccessHint ( accessHint );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t Pager::ReopenForWriting
+
+
+void Pager::SetAccessHint ( btrieve_access_hint_t hint )
+{
+	int fileAdvice = POSIX_FADV_NORMAL;
+	int mappingAdvice = MADV_NORMAL;
+
+	switch ( hint )
+	{
+		case BTRIEVE_ACCESS_HINT_RANDOM:
+			fileAdvice = POSIX_FADV_RANDOM;
+			mappingAdvice = MADV_RANDOM;
+			break;
+		case BTRIEVE_ACCESS_HINT_SEQUENTIAL:
+			fileAdvice = POSIX_FADV_SEQUENTIAL;
+			mappingAdvice = MADV_SEQUENTIAL;
+			break;
+		default:
+			break;
+	}
+
+	accessHint = hint;
+
+	// If the pages are read from the mapping, it takes the hint too.
+	if ( mappedPages > 0 )
+	{
+		madvise ( mapping, mappingLength, mappingAdvice );
+	}
+
+	posix_fadvise ( fileDescriptor, 0, 0, fileAdvice );
+}	// void Pager::SetAccessHint
+
+
+void Pager::Close ( )
+{
+	// If the file is open.
+	if ( fileDescriptor >= 0 )
+	{
+		Flush ( );
+		close ( fileDescriptor );
+		fileDescriptor = -1;
+	}
+
+	// If the file was mapped.
+	if ( mapping != NULL )
+	{
+		munmap ( mapping, mappingLength );
+		mapping = NULL;
+		mappingLength = 0;
+		mappedPages = 0;
+	}
+
+	accessHint = BTRIEVE_ACCESS_HINT_NORMAL;
+
+	for ( size_t i = 0; i < chunks.size ( ); i++ )
+	{
+		free ( chunks [ i ] );
+	}
+
+	chunks.clear ( );
+	frames.clear ( );
+	pageTable.clear ( );
+	preimages.clear ( );
+	preimagesActive = false;
+}	// void Pager::Close
+
+
+bool Pager::ReadPrefix ( uint8_t* buffer, size_t length )
+{
+	ssize_t bytesRead = pread ( fileDescriptor, buffer, length, 0 );
+
+	return bytesRead == ( ssize_t ) length;
+}	// bool Pager::ReadPrefix
+
+
+void Pager::Configure ( uint32_t pageSizeIn, size_t cacheBytesIn )
+{
+	pageSize = pageSizeIn;
+	cacheBytes = cacheBytesIn;
+}	// void Pager::Configure
+
+
+bool Pager::AddFrames ( uint32_t count )
+{
+	uint8_t* chunk = NULL;
+
+	// Frames are cache line aligned so page contents can be searched in place.
+	if ( posix_memalign ( ( void** ) &chunk, 64, ( size_t ) count * pageSize ) != 0 )
+	{
+		return false;
+	}
+
+	chunks.push_back ( chunk );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		Frame frame;
+
+		frame.pageNumber = 0;
+		frame.data = chunk + ( size_t ) i * pageSize;
+		frame.pinCount = 0;
+		frame.dirty = false;
+		frame.referenced = false;
+		frame.used = false;
+		frames.push_back ( frame );
+	}
+
+	return true;
+}	// bool Pager::AddFrames
+
+
+bool Pager::WriteFrame ( Frame* frame )
+{
+	ssize_t bytesWritten = pwrite ( fileDescriptor, frame->data, pageSize, ( off_t ) frame->pageNumber * pageSize );
+
+	// If pwrite ( ) fails.
+	if ( bytesWritten != ( ssize_t ) pageSize )
+	{
+		lastStatusCode = ( errno == ENOSPC ) ? BTRIEVE_STATUS_CODE_DISKFULL : BTRIEVE_STATUS_CODE_IO_ERROR;
+		return false;
+	}
+
+	frame->dirty = false;
+	statistics.writes++;
+	return true;
+}	// bool Pager::WriteFrame
+
+
+bool Pager::AcquireFrame ( uint32_t* frameIndex )
+{
+	// If the cache hasn't reached its budget, grow it.
+	if ( frames.empty ( ) || ( frames.size ( ) * ( size_t ) pageSize < cacheBytes && pageTable.size ( ) == frames.size ( ) ) )
+	{
+		uint32_t count = frames.empty ( ) ? ENGINE_MINIMUM_CACHE_FRAMES : ( uint32_t ) frames.size ( );
+
+		// If the new frames were allocated, use the first of them.
+		if ( AddFrames ( count ) )
+		{
+			*frameIndex = ( uint32_t ) ( frames.size ( ) - count );
+			return true;
+		}
+	}
+
+	// Clock replacement; two sweeps clear every reference bit.
+	for ( size_t sweep = 0; sweep < 2 * frames.size ( ); sweep++ )
+	{
+		Frame* frame = &frames [ clockHand ];
+		uint32_t candidate = clockHand;
+
+		clockHand = ( clockHand + 1 ) % ( uint32_t ) frames.size ( );
+
+		// If the frame is free.
+		if ( !frame->used )
+		{
+			*frameIndex = candidate;
+			return true;
+		}
+
+		// If the frame is pinned it can't be evicted.
+		if ( frame->pinCount > 0 )
+		{
+			continue;
+		}
+
+		// If the frame was used recently, give it a second chance.
+		if ( frame->referenced )
+		{
+			frame->referenced = false;
+			continue;
+		}
+
+		// If the frame is dirty and can't be written it can't be evicted.
+		if ( frame->dirty && !WriteFrame ( frame ) )
+		{
+			return false;
+		}
+
+		pageTable.erase ( frame->pageNumber );
+		frame->used = false;
+		statistics.evictions++;
+		*frameIndex = candidate;
+		return true;
+	}	// for ( size_t sweep = 0; sweep < 2 * frames.size ( ); sweep++ )
+
+	// Every frame is pinned; grow past the budget rather than fail.
+	if ( AddFrames ( ENGINE_MINIMUM_CACHE_FRAMES ) )
+	{
+		*frameIndex = ( uint32_t ) ( frames.size ( ) - ENGINE_MINIMUM_CACHE_FRAMES );
+		return true;
+	}
+
+	lastStatusCode = BTRIEVE_STATUS_CODE_NO_CACHE_BUFFERS_AVAIL;
+	return false;
+}	// bool Pager::AcquireFrame
+
+
+uint8_t* Pager::Pin ( uint32_t pageNumber, bool forWrite, uint32_t* frameIndex )
+{
+	std::lock_guard<std::mutex> guard ( latch );
+	std::unordered_map<uint32_t, uint32_t>::iterator entry = pageTable.find ( pageNumber );
+	Frame* frame;
+
+	// If the file is read only it can't be written.
+	if ( forWrite && readOnly )
+	{
+		lastStatusCode = BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED;
+		return NULL;
+	}
+
+	// If the page is cached.
+	if ( entry != pageTable.end ( ) )
+	{
+		*frameIndex = entry->second;
+		frame = &frames [ entry->second ];
+		statistics.hits++;
+	}
+	else
+	{
+		ssize_t bytesRead;
+
+		// If a frame can't be found.
+		if ( !AcquireFrame ( frameIndex ) )
+		{
+			return NULL;
+		}
+
+		frame = &frames [ *frameIndex ];
+		bytesRead = pread ( fileDescriptor, frame->data, pageSize, ( off_t ) pageNumber * pageSize );
+
+		// If pread ( ) fails.
+		if ( bytesRead < 0 )
+		{
+			lastStatusCode = BTRIEVE_STATUS_CODE_IO_ERROR;
+			return NULL;
+		}
+
+		// Pages past the end of the file read as zeros.
+		if ( bytesRead < ( ssize_t ) pageSize )
+		{
+			memset ( frame->data + bytesRead, 0, pageSize - bytesRead );
+		}
+
+		frame->pageNumber = pageNumber;
+		frame->dirty = false;
+		frame->used = true;
+		pageTable [ pageNumber ] = *frameIndex;
+		statistics.misses++;
+		statistics.reads++;
+	}	// if ( entry != pageTable.end ( ) )
+
+	// If the page is being written, keep its pre-image for an abort.
+	if ( forWrite )
+	{
+		if ( preimagesActive && preimages.find ( pageNumber ) == preimages.end ( ) )
+		{
+			preimages [ pageNumber ].assign ( frame->data, frame->data + pageSize );
+		}
+
+		frame->dirty = true;
+	}
+
+	frame->pinCount++;
+	frame->referenced = true;
+	return frame->data;
+}	// uint8_t* Pager::Pin
+
+
+void Pager::Unpin ( uint32_t frameIndex )
+{
+	// If the page was fetched from the mapping, nothing holds it.
+	if ( frameIndex == ENGINE_MAPPED_FRAME )
+	{
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard ( latch );
+
+	frames [ frameIndex ].pinCount--;
+}	// void Pager::Unpin
+
+
+PageHandle Pager::Fetch ( uint32_t pageNumber )
+{
+	uint32_t frameIndex = 0;
+	uint8_t* data;
+
+	// If the page is mapped, it's read in place.
+	if ( pageNumber < mappedPages )
+	{
+		return PageHandle ( this, ENGINE_MAPPED_FRAME, mapping + ( size_t ) pageNumber * pageSize );
+	}
+
+	data = Pin ( pageNumber, false, &frameIndex );
+	return ( data == NULL ) ? PageHandle ( ) : PageHandle ( this, frameIndex, data );
+}	// PageHandle Pager::Fetch
+
+
+PageHandle Pager::FetchForWrite ( uint32_t pageNumber )
+{
+	uint32_t frameIndex = 0;
+	uint8_t* data = Pin ( pageNumber, true, &frameIndex );
+
+	return ( data == NULL ) ? PageHandle ( ) : PageHandle ( this, frameIndex, data );
+}	// PageHandle Pager::FetchForWrite
+
+
+btrieve_status_code_t Pager::Flush ( )
+{
+	std::lock_guard<std::mutex> guard ( latch );
+
+	for ( size_t i = 0; i < frames.size ( ); i++ )
+	{
+		// If the frame is dirty and can't be written.
+		if ( frames [ i ].used && frames [ i ].dirty && !WriteFrame ( &frames [ i ] ) )
+		{
+			return lastStatusCode;
+		}
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t Pager::Flush
+
+
+void Pager::BeginPreimages ( )
+{
+	std::lock_guard<std::mutex> guard ( latch );
+
+	preimages.clear ( );
+	preimagesActive = true;
+}	// void Pager::BeginPreimages
+
+
+void Pager::DiscardPreimages ( )
+{
+	std::lock_guard<std::mutex> guard ( latch );
+
+	preimages.clear ( );
+	preimagesActive = false;
+}	// void Pager::DiscardPreimages
+
+
+void Pager::RestorePreimages ( )
+{
+	std::unordered_map<uint32_t, std::vector<uint8_t> > restore;
+
+	{
+		std::lock_guard<std::mutex> guard ( latch );
+
+		restore.swap ( preimages );
+		preimagesActive = false;
+	}
+
+	for ( std::unordered_map<uint32_t, std::vector<uint8_t> >::iterator entry = restore.begin ( ); entry != restore.end ( ); ++entry )
+	{
+		PageHandle page = FetchForWrite ( entry->first );
+
+		// If the page is pinned, put its pre-image back.
+		if ( page.IsValid ( ) )
+		{
+			memcpy ( page.GetData ( ), &entry->second [ 0 ], pageSize );
+		}
+	}
+}	// void Pager::RestorePreimages
+
+
+PagerStatistics Pager::GetStatistics ( )
+{
+	std::lock_guard<std::mutex> guard ( latch );
+
+	return statistics;
+}	// PagerStatistics Pager::GetStatistics
+
+}	// namespace BtrieveEngine
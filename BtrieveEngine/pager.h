@@ -0,0 +1,149 @@
+// pager.h : Page cache and page I/O for one open file of the in-process engine.
+//
+
+#ifndef _BTRIEVE_ENGINE_PAGER_H
+#define _BTRIEVE_ENGINE_PAGER_H
+
+#include <stdint.h>
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <btrieveC.h>
+#include <btrieveEngineC.h>
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_DEFAULT_CACHE_BYTES ( 64 * 1024 * 1024 )
+#define ENGINE_MINIMUM_CACHE_FRAMES 64
+#define ENGINE_MAPPED_FRAME 0xFFFFFFFF										// The frame of a page read in place from the mapping.
+
+class Pager;
+
+// Return false if BTRIEVE_ENGINE_MAPPED_FILES is set to 0 in the
+// environment, which reads the pages of every file through the cache.
+bool IsFileMappingEnabled ( );
+
+// A pinned page. The page stays in the cache, at the same address, until
+// the handle is released.
+class PageHandle
+{
+public:
+	PageHandle ( );
+	PageHandle ( Pager* pager, uint32_t frame, uint8_t* data );
+	PageHandle ( PageHandle&& other );
+	PageHandle& operator= ( PageHandle&& other );
+	~PageHandle ( );
+
+	bool IsValid ( ) const { return data != NULL; }
+	uint8_t* GetData ( ) const { return data; }
+	void Release ( );
+
+private:
+	PageHandle ( const PageHandle& );
+	PageHandle& operator= ( const PageHandle& );
+
+	Pager* pager;
+	uint32_t frame;
+	uint8_t* data;
+};	// class PageHandle
+
+
+struct PagerStatistics
+{
+	uint64_t hits;
+	uint64_t misses;
+	uint64_t reads;
+	uint64_t writes;
+	uint64_t evictions;
+};	// struct PagerStatistics
+
+
+class Pager
+{
+	friend class PageHandle;
+
+public:
+	Pager ( );
+	~Pager ( );
+
+	btrieve_status_code_t Open ( const std::string& path, bool create, bool readOnly );
+	void Close ( );
+	bool IsOpen ( ) const { return fileDescriptor >= 0; }
+
+	// Read bytes from the start of the file, bypassing the cache; used to
+	// learn the page size before the cache is configured.
+	bool ReadPrefix ( uint8_t* buffer, size_t length );
+
+	void Configure ( uint32_t pageSize, size_t cacheBytes );
+	uint32_t GetPageSize ( ) const { return pageSize; }
+
+	// Map the whole pages of a read only file, which are then fetched in
+	// place rather than read into the cache; false if they can't be mapped.
+	bool Map ( );
+	bool IsMapped ( ) const { return mappedPages > 0; }
+
+	// Reopen a read only file for writing; the cache reads its pages from then on.
+	btrieve_status_code_t ReopenForWriting ( const std::string& path );
+
+	// Tell the kernel how the pages of the file will be read.
+	void SetAccessHint ( btrieve_access_hint_t hint );
+
+	// Pin a page for reading, or for writing, which marks it dirty and
+	// saves its pre-image if a transaction is active.
+	PageHandle Fetch ( uint32_t pageNumber );
+	PageHandle FetchForWrite ( uint32_t pageNumber );
+
+	btrieve_status_code_t Flush ( );
+	btrieve_status_code_t GetLastStatusCode ( ) const { return lastStatusCode; }
+
+	// Transaction pre-images.
+	void BeginPreimages ( );
+	void DiscardPreimages ( );
+	void RestorePreimages ( );
+	bool HasPreimages ( ) const { return preimagesActive; }
+
+	PagerStatistics GetStatistics ( );
+
+private:
+	struct Frame
+	{
+		uint32_t pageNumber;
+		uint8_t* data;
+		uint32_t pinCount;
+		bool dirty;
+		bool referenced;
+		bool used;
+	};	// struct Frame
+
+	uint8_t* Pin ( uint32_t pageNumber, bool forWrite, uint32_t* frameIndex );
+	void Unpin ( uint32_t frameIndex );
+	bool AcquireFrame ( uint32_t* frameIndex );
+	bool AddFrames ( uint32_t count );
+	bool WriteFrame ( Frame* frame );
+
+	std::mutex latch;
+	int fileDescriptor;
+	bool readOnly;
+	uint8_t* mapping;
+	size_t mappingLength;
+	uint32_t mappedPages;												// Zero once the file is reopened for writing.
+	btrieve_access_hint_t accessHint;
+	uint32_t pageSize;
+	size_t cacheBytes;
+	std::vector<Frame> frames;
+	std::vector<uint8_t*> chunks;
+	std::unordered_map<uint32_t, uint32_t> pageTable;
+	uint32_t clockHand;
+	btrieve_status_code_t lastStatusCode;
+	bool preimagesActive;
+	std::unordered_map<uint32_t, std::vector<uint8_t> > preimages;
+	PagerStatistics statistics;
+};	// class Pager
+
+}	// namespace BtrieveEngine
+
+#endif
@@ -0,0 +1,221 @@
+// recordView.cpp : The record view entry points of btrieveEngineC.h.
+//
+// A view is the cursor's record left where it lies: the handle pins the
+// record's data page in viewPage and the view points into the page. An
+// overflow record spans pages, so it's read into the handle's viewRecord
+// instead. Every cursor move goes through SetCursor, which invalidates the
+// view by unpinning the page and counting a new view generation.
+//
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <btrieveEngineC.h>
+
+#include "engine.h"
+
+using namespace BtrieveEngine;
+
+namespace BtrieveEngine
+{
+
+bool IsRecordViewChecking ( )
+{
+	const char* setting = getenv ( "BTRIEVE_ENGINE_CHECK_VIEWS" );
+
+	// If the environment doesn't say, the build does.
+	if ( setting == NULL || *setting == '\0' )
+	{
+		return ENGINE_CHECK_RECORD_VIEWS != 0;
+	}
+
+	return atoi ( setting ) != 0;
+}	// bool IsRecordViewChecking
+
+}	// namespace BtrieveEngine
+
+
+// Point the view at the record at the cursor, or clear it if the cursor didn't move.
+static btrieve_status_code_t ViewCursorRecord ( btrieve_file* file, btrieve_status_code_t status, btrieve_record_view_t* view )
+{
+	const uint8_t* bytes;
+	int length;
+
+	view->record = NULL;
+	view->length = 0;
+	view->generation = 0;
+	view->stamp = 0;
+
+	// If the cursor didn't move, the view it had is given up all the same.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		InvalidateRecordView ( file );
+		return SetFileStatus ( file, status );
+	}
+
+	// If there's no current record.
+	if ( !file->cursor.established || !file->cursor.recordLoaded )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_POSITION_NOT_SET );
+	}
+
+	// If PinRecordData ( ) fails.
+	if ( ( status = file->shared->PinRecordData ( file->cursor.address, &file->viewPage, &bytes, &length, &file->viewRecord ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return SetFileStatus ( file, status );
+	}
+
+	// If the view is checked, serve a copy that invalidation can spoil.
+	if ( file->checkViews && file->viewPage.IsValid ( ) )
+	{
+		file->viewRecord.assign ( bytes, bytes + length );
+		file->viewPage.Release ( );
+		bytes = file->viewRecord.empty ( ) ? NULL : &file->viewRecord [ 0 ];
+	}
+
+	view->record = ( const char* ) bytes;
+	view->length = length;
+	view->generation = file->viewGeneration;
+	view->stamp = file->shared->GetStamp ( );
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// static btrieve_status_code_t ViewCursorRecord
+
+
+// Check a view-returning call's arguments.
+static btrieve_status_code_t CheckViewCall ( btrieve_file* file, btrieve_record_view_t* view )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If there's no view to fill in.
+	if ( view == NULL )
+	{
+		return SetFileStatus ( file, BTRIEVE_STATUS_CODE_INVALID_PTR_PARM );
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// static btrieve_status_code_t CheckViewCall
+
+
+btrieve_status_code_t BtrieveFileRecordRetrieveView ( btrieve_file_t file, btrieve_comparison_t comparison, btrieve_index_t index, const char* key, int keyLength, btrieve_record_view_t* view, btrieve_lock_mode_t lockMode )
+{
+	btrieve_status_code_t status;
+
+	( void ) lockMode;
+
+	// If the arguments are unusable.
+	if ( ( status = CheckViewCall ( file, view ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return ViewCursorRecord ( file, SeekCursor ( file, comparison, index, ( const uint8_t* ) key, keyLength ), view );
+}	// btrieve_status_code_t BtrieveFileRecordRetrieveView
+
+
+btrieve_status_code_t BtrieveFileRecordRetrieveFirstView ( btrieve_file_t file, btrieve_index_t index, btrieve_record_view_t* view, btrieve_lock_mode_t lockMode )
+{
+	btrieve_status_code_t status;
+
+	( void ) lockMode;
+
+	// If the arguments are unusable.
+	if ( ( status = CheckViewCall ( file, view ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return ViewCursorRecord ( file, SeekEnd ( file, index, true ), view );
+}	// btrieve_status_code_t BtrieveFileRecordRetrieveFirstView
+
+
+btrieve_status_code_t BtrieveFileRecordRetrieveLastView ( btrieve_file_t file, btrieve_index_t index, btrieve_record_view_t* view, btrieve_lock_mode_t lockMode )
+{
+	btrieve_status_code_t status;
+
+	( void ) lockMode;
+
+	// If the arguments are unusable.
+	if ( ( status = CheckViewCall ( file, view ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return ViewCursorRecord ( file, SeekEnd ( file, index, false ), view );
+}	// btrieve_status_code_t BtrieveFileRecordRetrieveLastView
+
+
+btrieve_status_code_t BtrieveFileRecordRetrieveNextView ( btrieve_file_t file, btrieve_record_view_t* view, btrieve_lock_mode_t lockMode )
+{
+	btrieve_status_code_t status;
+
+	( void ) lockMode;
+
+	// If the arguments are unusable.
+	if ( ( status = CheckViewCall ( file, view ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return ViewCursorRecord ( file, MoveCursor ( file, true ), view );
+}	// btrieve_status_code_t BtrieveFileRecordRetrieveNextView
+
+
+btrieve_status_code_t BtrieveFileRecordRetrievePreviousView ( btrieve_file_t file, btrieve_record_view_t* view, btrieve_lock_mode_t lockMode )
+{
+	btrieve_status_code_t status;
+
+	( void ) lockMode;
+
+	// If the arguments are unusable.
+	if ( ( status = CheckViewCall ( file, view ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	return ViewCursorRecord ( file, MoveCursor ( file, false ), view );
+}	// btrieve_status_code_t BtrieveFileRecordRetrievePreviousView
+
+
+btrieve_status_code_t BtrieveFileReleaseRecordView ( btrieve_file_t file )
+{
+	btrieve_status_code_t status;
+
+	// If the file isn't open.
+	if ( ( status = CheckFileOpen ( file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	std::shared_lock<std::shared_mutex> guard ( file->shared->latch );
+
+	InvalidateRecordView ( file );
+	return SetFileStatus ( file, BTRIEVE_STATUS_CODE_NO_ERROR );
+}	// btrieve_status_code_t BtrieveFileReleaseRecordView
+
+
+int BtrieveFileIsRecordViewValid ( btrieve_file_t file, const btrieve_record_view_t* view )
+{
+	return file != NULL && file->shared != NULL && view != NULL && view->generation != 0 && view->generation == file->viewGeneration;
+}	// int BtrieveFileIsRecordViewValid
+
+
+int BtrieveFileIsRecordViewCurrent ( btrieve_file_t file, const btrieve_record_view_t* view )
+{
+	return BtrieveFileIsRecordViewValid ( file, view ) && view->stamp == file->shared->GetStamp ( );
+}	// int BtrieveFileIsRecordViewCurrent
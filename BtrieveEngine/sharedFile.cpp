@@ -0,0 +1,2195 @@
+// sharedFile.cpp : Files of the in-process engine: the file header, page
+//                  allocation, record pages, index maintenance, and
+//                  transactions.
+//
+// Records live in slotted data pages. The slot array grows up from the
+// page header and record bytes grow down from the end of the page. A
+// record that won't fit in an empty page is kept in a chain of overflow
+// pages, and its slot holds an OverflowStub instead. Every slot holds at
+// least sizeof ( OverflowStub ) bytes, so a record can always become an
+// overflow record in place and its cursor position never changes.
+//
+
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <map>
+
+#include "engine.h"
+#include "indexBuild.h"
+#include "sorter.h"
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_MAXIMUM_SPACE_PAGES 64
+
+static const uint32_t pageSizeBytes [ ] = { 512, 1024, 1536, 2048, 3072, 3584, 4096, 8192, 16384 };
+
+
+uint32_t PageSizeToBytes ( btrieve_page_size_t pageSize )
+{
+	// If it's the default page size.
+	if ( pageSize == BTRIEVE_PAGE_SIZE_DEFAULT )
+	{
+		return ENGINE_DEFAULT_PAGE_SIZE;
+	}
+
+	// If the page size is out of range.
+	if ( pageSize < BTRIEVE_PAGE_SIZE_512 || pageSize > BTRIEVE_PAGE_SIZE_16384 )
+	{
+		return 0;
+	}
+
+	return pageSizeBytes [ pageSize ];
+}	// uint32_t PageSizeToBytes
+
+
+btrieve_page_size_t BytesToPageSize ( uint32_t bytes )
+{
+	for ( int i = BTRIEVE_PAGE_SIZE_512; i <= BTRIEVE_PAGE_SIZE_16384; i++ )
+	{
+		// If this is the page size.
+		if ( pageSizeBytes [ i ] == bytes )
+		{
+			return ( btrieve_page_size_t ) i;
+		}
+	}
+
+	return BTRIEVE_PAGE_SIZE_UNKNOWN;
+}	// btrieve_page_size_t BytesToPageSize
+
+
+// The header is serialized as a blob of little endian fields.
+template<typename T>
+static void Put ( std::vector<uint8_t>* blob, const T& value )
+{
+	const uint8_t* bytes = ( const uint8_t* ) &value;
+
+	blob->insert ( blob->end ( ), bytes, bytes + sizeof ( value ) );
+}	// static void Put
+
+
+static void PutBytes ( std::vector<uint8_t>* blob, const void* bytes, size_t length )
+{
+	blob->insert ( blob->end ( ), ( const uint8_t* ) bytes, ( const uint8_t* ) bytes + length );
+}	// static void PutBytes
+
+
+struct BlobReader
+{
+	const uint8_t* cursor;
+	const uint8_t* end;
+
+	bool GetBytes ( void* bytes, size_t length )
+	{
+		// If the blob is too short.
+		if ( ( size_t ) ( end - cursor ) < length )
+		{
+			return false;
+		}
+
+		memcpy ( bytes, cursor, length );
+		cursor += length;
+		return true;
+	}	// bool GetBytes
+
+	template<typename T>
+	bool Get ( T* value )
+	{
+		return GetBytes ( value, sizeof ( *value ) );
+	}	// bool Get
+};	// struct BlobReader
+
+
+static void SerializeHeader ( const FileHeader& header, std::vector<uint8_t>* blob )
+{
+	uint32_t count;
+
+	blob->clear ( );
+	Put ( blob, header.pageCount );
+	Put ( blob, header.freePageHead );
+	Put ( blob, header.freePageCount );
+	Put ( blob, header.firstDataPage );
+	Put ( blob, header.lastDataPage );
+	Put ( blob, header.dataPageCount );
+	Put ( blob, header.recordCount );
+	Put ( blob, header.fixedRecordLength );
+	Put ( blob, header.variableLengthRecordsMode );
+	Put ( blob, header.recordCompressionMode );
+	Put ( blob, header.fileVersion );
+	Put ( blob, header.freeSpaceThreshold );
+	Put ( blob, header.systemDataMode );
+	Put ( blob, header.pageCompression );
+	Put ( blob, header.balancedIndexes );
+	Put ( blob, header.keyOnly );
+	Put ( blob, header.preallocatedPageCount );
+	Put ( blob, header.reservedDuplicatePointerCount );
+	Put ( blob, header.ownerMode );
+	PutBytes ( blob, header.ownerName, sizeof ( header.ownerName ) );
+
+	count = ( uint32_t ) header.continuationPages.size ( );
+	Put ( blob, count );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		Put ( blob, header.continuationPages [ i ] );
+	}
+
+	count = ( uint32_t ) header.indexes.size ( );
+	Put ( blob, count );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		const IndexDefinition& index = header.indexes [ i ];
+		uint32_t segmentCount = ( uint32_t ) index.segments.size ( );
+
+		Put ( blob, index.index );
+		Put ( blob, index.duplicateMode );
+		Put ( blob, index.modifiable );
+		Put ( blob, index.acsMode );
+		Put ( blob, index.acsNumber );
+		PutBytes ( blob, index.acsName, sizeof ( index.acsName ) );
+		Put ( blob, index.hasAcsMap );
+
+		// If the index has a collation map.
+		if ( index.hasAcsMap )
+		{
+			PutBytes ( blob, index.acsMap, sizeof ( index.acsMap ) );
+		}
+
+		Put ( blob, index.keyLength );
+		Put ( blob, index.keyEncoding );
+		Put ( blob, index.rootPage );
+		Put ( blob, index.height );
+		Put ( blob, index.entryCount );
+		Put ( blob, index.pageCount );
+		Put ( blob, segmentCount );
+
+		for ( uint32_t j = 0; j < segmentCount; j++ )
+		{
+			const SegmentDefinition& segment = index.segments [ j ];
+
+			Put ( blob, segment.offset );
+			Put ( blob, segment.length );
+			Put ( blob, segment.dataType );
+			Put ( blob, segment.descending );
+			Put ( blob, segment.nullKeyMode );
+			Put ( blob, segment.nullValue );
+		}
+	}	// for ( uint32_t i = 0; i < count; i++ )
+}	// static void SerializeHeader
+
+
+static bool ParseHeader ( const std::vector<uint8_t>& blob, uint32_t format, FileHeader* header )
+{
+	BlobReader reader;
+	uint32_t count;
+
+	reader.cursor = blob.empty ( ) ? NULL : &blob [ 0 ];
+	reader.end = reader.cursor + blob.size ( );
+
+	// If a fixed field is missing.
+	if ( !reader.Get ( &header->pageCount )
+		|| !reader.Get ( &header->freePageHead )
+		|| !reader.Get ( &header->freePageCount )
+		|| !reader.Get ( &header->firstDataPage )
+		|| !reader.Get ( &header->lastDataPage )
+		|| !reader.Get ( &header->dataPageCount )
+		|| !reader.Get ( &header->recordCount )
+		|| !reader.Get ( &header->fixedRecordLength )
+		|| !reader.Get ( &header->variableLengthRecordsMode )
+		|| !reader.Get ( &header->recordCompressionMode )
+		|| !reader.Get ( &header->fileVersion )
+		|| !reader.Get ( &header->freeSpaceThreshold )
+		|| !reader.Get ( &header->systemDataMode )
+		|| !reader.Get ( &header->pageCompression )
+		|| !reader.Get ( &header->balancedIndexes )
+		|| !reader.Get ( &header->keyOnly )
+		|| !reader.Get ( &header->preallocatedPageCount )
+		|| !reader.Get ( &header->reservedDuplicatePointerCount )
+		|| !reader.Get ( &header->ownerMode )
+		|| !reader.GetBytes ( header->ownerName, sizeof ( header->ownerName ) )
+		|| !reader.Get ( &count ) )
+	{
+		return false;
+	}
+
+	header->continuationPages.resize ( count );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		// If the page number is missing.
+		if ( !reader.Get ( &header->continuationPages [ i ] ) )
+		{
+			return false;
+		}
+	}
+
+	// If the index count is missing.
+	if ( !reader.Get ( &count ) )
+	{
+		return false;
+	}
+
+	header->indexes.resize ( count );
+
+	for ( uint32_t i = 0; i < count; i++ )
+	{
+		IndexDefinition& index = header->indexes [ i ];
+		uint32_t segmentCount;
+
+		memset ( index.acsMap, 0, sizeof ( index.acsMap ) );
+		index.keyEncoding = ENGINE_KEY_ENCODING_RAW;
+
+		// If a field of the index is missing.
+		if ( !reader.Get ( &index.index )
+			|| !reader.Get ( &index.duplicateMode )
+			|| !reader.Get ( &index.modifiable )
+			|| !reader.Get ( &index.acsMode )
+			|| !reader.Get ( &index.acsNumber )
+			|| !reader.GetBytes ( index.acsName, sizeof ( index.acsName ) )
+			|| !reader.Get ( &index.hasAcsMap )
+			|| ( index.hasAcsMap && !reader.GetBytes ( index.acsMap, sizeof ( index.acsMap ) ) )
+			|| !reader.Get ( &index.keyLength )
+			|| ( format >= 2 && !reader.Get ( &index.keyEncoding ) )
+			|| !reader.Get ( &index.rootPage )
+			|| !reader.Get ( &index.height )
+			|| !reader.Get ( &index.entryCount )
+			|| !reader.Get ( &index.pageCount )
+			|| !reader.Get ( &segmentCount ) )
+		{
+			return false;
+		}
+
+		index.segments.resize ( segmentCount );
+
+		for ( uint32_t j = 0; j < segmentCount; j++ )
+		{
+			SegmentDefinition& segment = index.segments [ j ];
+
+			// If a field of the segment is missing.
+			if ( !reader.Get ( &segment.offset )
+				|| !reader.Get ( &segment.length )
+				|| !reader.Get ( &segment.dataType )
+				|| !reader.Get ( &segment.descending )
+				|| !reader.Get ( &segment.nullKeyMode )
+				|| !reader.Get ( &segment.nullValue ) )
+			{
+				return false;
+			}
+		}
+
+		// If the encoding is one this engine doesn't know.
+		if ( index.keyEncoding != ENGINE_KEY_ENCODING_RAW && index.keyEncoding != ENGINE_KEY_ENCODING_NORMALIZED )
+		{
+			return false;
+		}
+
+		index.comparator = SelectKeyComparator ( index );
+	}	// for ( uint32_t i = 0; i < count; i++ )
+
+	return true;
+}	// static bool ParseHeader
+
+
+SharedFile::SharedFile ( )
+	: headerDirty ( false ),
+	  readOnly ( false ),
+	  handleCount ( 0 ),
+	  exclusiveCount ( 0 ),
+	  stamp ( 1 ),
+	  transactionOwner ( NULL ),
+	  bloomBitsPerKey ( GetBloomBitsPerKey ( ) )
+{
+	memset ( header.ownerName, 0, sizeof ( header.ownerName ) );
+}	// SharedFile::SharedFile
+
+
+SharedFile::~SharedFile ( )
+{
+	Close ( );
+}	// SharedFile::~SharedFile
+
+
+btrieve_status_code_t SharedFile::Create ( const std::string& path, const FileSettings& settings, const IndexDefinition* index, bool overwrite )
+{
+	SharedFile file;
+	struct stat information;
+	btrieve_status_code_t status;
+	uint32_t pageSize = PageSizeToBytes ( ( btrieve_page_size_t ) settings.pageSize );
+
+	// If the file exists and mustn't be overwritten.
+	if ( !overwrite && stat ( path.c_str ( ), &information ) == 0 )
+	{
+		return BTRIEVE_STATUS_CODE_FILE_ALREADY_EXISTS;
+	}
+
+	// If the page size is invalid.
+	if ( pageSize == 0 )
+	{
+		return BTRIEVE_STATUS_CODE_PAGE_SIZE_ERROR;
+	}
+
+	// If the record length is invalid.
+	if ( settings.fixedRecordLength < 1 || settings.fixedRecordLength > BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_RECORD_LENGTH;
+	}
+
+	// If open ( ) fails.
+	if ( ( status = file.pager.Open ( path, true, false ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	file.path = path;
+	file.pager.Configure ( pageSize, ENGINE_DEFAULT_CACHE_BYTES );
+	file.header.pageSize = pageSize;
+	file.header.pageCount = 1;
+	file.header.freePageHead = 0;
+	file.header.freePageCount = 0;
+	file.header.firstDataPage = 0;
+	file.header.lastDataPage = 0;
+	file.header.dataPageCount = 0;
+	file.header.recordCount = 0;
+	file.header.fixedRecordLength = settings.fixedRecordLength;
+	file.header.variableLengthRecordsMode = settings.variableLengthRecordsMode;
+	file.header.recordCompressionMode = settings.recordCompressionMode;
+	file.header.fileVersion = settings.fileVersion;
+	file.header.freeSpaceThreshold = settings.freeSpaceThreshold;
+	file.header.systemDataMode = settings.systemDataMode;
+	file.header.pageCompression = settings.pageCompression;
+	file.header.balancedIndexes = settings.balancedIndexes;
+	file.header.keyOnly = settings.keyOnly;
+	file.header.preallocatedPageCount = settings.preallocatedPageCount;
+	file.header.reservedDuplicatePointerCount = settings.reservedDuplicatePointerCount;
+	file.header.ownerMode = BTRIEVE_OWNER_MODE_NONE;
+
+	// If there's an index to create with the file.
+	if ( index != NULL )
+	{
+		IndexDefinition definition = *index;
+
+		// If CreateIndex ( ) fails.
+		if ( ( status = file.CreateIndex ( &definition, NULL ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			file.Close ( );
+			unlink ( path.c_str ( ) );
+			return status;
+		}
+	}
+
+	file.headerDirty = true;
+	return file.Close ( );
+}	// btrieve_status_code_t SharedFile::Create
+
+
+btrieve_status_code_t SharedFile::Open ( const std::string& pathIn, bool readOnlyIn )
+{
+	HeaderPageHeader prefix;
+	btrieve_status_code_t status;
+
+	// If open ( ) fails.
+	if ( ( status = pager.Open ( pathIn, false, readOnlyIn ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If the file doesn't start with an engine header.
+	if ( !pager.ReadPrefix ( ( uint8_t* ) &prefix, sizeof ( prefix ) )
+		|| memcmp ( prefix.magic, ENGINE_FILE_MAGIC, sizeof ( prefix.magic ) ) != 0
+		|| prefix.format < ENGINE_OLDEST_FILE_FORMAT
+		|| prefix.format > ENGINE_FILE_FORMAT
+		|| BytesToPageSize ( prefix.pageSize ) == BTRIEVE_PAGE_SIZE_UNKNOWN )
+	{
+		pager.Close ( );
+		return BTRIEVE_STATUS_CODE_NOT_A_BTRIEVE_FILE;
+	}
+
+	path = pathIn;
+	readOnly = readOnlyIn;
+	pager.Configure ( prefix.pageSize, ENGINE_DEFAULT_CACHE_BYTES );
+	header.pageSize = prefix.pageSize;
+
+	// If the file can only be read, its pages are read in place from a mapping.
+	if ( readOnly && IsFileMappingEnabled ( ) )
+	{
+		pager.Map ( );
+	}
+
+	// If ReadHeader ( ) fails.
+	if ( ( status = ReadHeader ( ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		pager.Close ( );
+		return status;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::Open
+
+
+btrieve_status_code_t SharedFile::ReopenForWriting ( )
+{
+	btrieve_status_code_t status;
+
+	// If the file can't be opened for writing.
+	if ( ( status = pager.ReopenForWriting ( path ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	readOnly = false;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::ReopenForWriting
+
+
+btrieve_status_code_t SharedFile::Close ( )
+{
+	btrieve_status_code_t status = BTRIEVE_STATUS_CODE_NO_ERROR;
+
+	// If the file isn't open.
+	if ( !pager.IsOpen ( ) )
+	{
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// If there's an uncommitted transaction, it's abandoned.
+	if ( transactionOwner != NULL )
+	{
+		AbortTransaction ( );
+	}
+
+	// If the header changed, write it back.
+	if ( headerDirty && !readOnly )
+	{
+		status = WriteHeader ( );
+	}
+
+	// If Flush ( ) fails.
+	if ( status == BTRIEVE_STATUS_CODE_NO_ERROR && !readOnly )
+	{
+		status = pager.Flush ( );
+	}
+
+	for ( int i = BTRIEVE_INDEX_1; i <= BTRIEVE_INDEX_119; i++ )
+	{
+		ResetBloomFilter ( i );
+	}
+
+	pager.Close ( );
+	return ( status == BTRIEVE_STATUS_CODE_NO_ERROR ) ? status : BTRIEVE_STATUS_CODE_CLOSE_ERROR;
+}	// btrieve_status_code_t SharedFile::Close
+
+
+btrieve_status_code_t SharedFile::ReadHeader ( )
+{
+	std::vector<uint8_t> blob;
+	uint32_t blobLength;
+	uint32_t next;
+	uint32_t capacity;
+	uint32_t format;
+
+	{
+		PageHandle page = pager.Fetch ( 0 );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		HeaderPageHeader* prefix = ( HeaderPageHeader* ) page.GetData ( );
+
+		format = prefix->format;
+		blobLength = prefix->blobLength;
+		next = prefix->nextContinuation;
+		capacity = header.pageSize - sizeof ( HeaderPageHeader );
+		blob.assign ( page.GetData ( ) + sizeof ( HeaderPageHeader ), page.GetData ( ) + sizeof ( HeaderPageHeader ) + ( blobLength < capacity ? blobLength : capacity ) );
+	}
+
+	// Gather the rest of the blob from the continuation pages.
+	while ( blob.size ( ) < blobLength && next != 0 )
+	{
+		PageHandle page = pager.Fetch ( next );
+		uint32_t remaining = blobLength - ( uint32_t ) blob.size ( );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		PageLink* link = ( PageLink* ) page.GetData ( );
+
+		// If the chain is damaged.
+		if ( link->pageType != ENGINE_PAGE_TYPE_CONTINUATION )
+		{
+			return BTRIEVE_STATUS_CODE_NOT_A_BTRIEVE_FILE;
+		}
+
+		capacity = header.pageSize - sizeof ( PageLink );
+		blob.insert ( blob.end ( ), page.GetData ( ) + sizeof ( PageLink ), page.GetData ( ) + sizeof ( PageLink ) + ( remaining < capacity ? remaining : capacity ) );
+		next = link->next;
+	}	// while ( blob.size ( ) < blobLength && next != 0 )
+
+	// If the blob is incomplete or damaged.
+	if ( blob.size ( ) != blobLength || !ParseHeader ( blob, format, &header ) )
+	{
+		return BTRIEVE_STATUS_CODE_NOT_A_BTRIEVE_FILE;
+	}
+
+	headerDirty = false;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::ReadHeader
+
+
+btrieve_status_code_t SharedFile::WriteHeader ( )
+{
+	std::vector<uint8_t> blob;
+	uint32_t firstCapacity = header.pageSize - sizeof ( HeaderPageHeader );
+	uint32_t capacity = header.pageSize - sizeof ( PageLink );
+	size_t written;
+
+	// Continuation pages come from the end of the file, and listing them grows the blob, so repeat until it fits.
+	for ( ;; )
+	{
+		size_t needed;
+
+		SerializeHeader ( header, &blob );
+		needed = ( blob.size ( ) <= firstCapacity ) ? 0 : ( blob.size ( ) - firstCapacity + capacity - 1 ) / capacity;
+
+		// If there are enough continuation pages.
+		if ( needed <= header.continuationPages.size ( ) )
+		{
+			break;
+		}
+
+		header.continuationPages.push_back ( header.pageCount++ );
+	}	// for ( ;; )
+
+	{
+		PageHandle page = pager.FetchForWrite ( 0 );
+
+		// If FetchForWrite ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		HeaderPageHeader* prefix = ( HeaderPageHeader* ) page.GetData ( );
+
+		memset ( page.GetData ( ), 0, header.pageSize );
+		memcpy ( prefix->magic, ENGINE_FILE_MAGIC, sizeof ( prefix->magic ) );
+		prefix->format = ENGINE_FILE_FORMAT;
+		prefix->pageSize = header.pageSize;
+		prefix->blobLength = ( uint32_t ) blob.size ( );
+		prefix->nextContinuation = ( blob.size ( ) > firstCapacity ) ? header.continuationPages [ 0 ] : 0;
+		written = ( blob.size ( ) < firstCapacity ) ? blob.size ( ) : firstCapacity;
+		memcpy ( page.GetData ( ) + sizeof ( HeaderPageHeader ), &blob [ 0 ], written );
+	}
+
+	for ( size_t i = 0; written < blob.size ( ); i++ )
+	{
+		PageHandle page = pager.FetchForWrite ( header.continuationPages [ i ] );
+		size_t chunk = blob.size ( ) - written;
+
+		// If FetchForWrite ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		PageLink* link = ( PageLink* ) page.GetData ( );
+
+		chunk = ( chunk < capacity ) ? chunk : capacity;
+		memset ( page.GetData ( ), 0, header.pageSize );
+		link->pageType = ENGINE_PAGE_TYPE_CONTINUATION;
+		link->next = ( written + chunk < blob.size ( ) ) ? header.continuationPages [ i + 1 ] : 0;
+		memcpy ( page.GetData ( ) + sizeof ( PageLink ), &blob [ written ], chunk );
+		written += chunk;
+	}	// for ( size_t i = 0; written < blob.size ( ); i++ )
+
+	headerDirty = false;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::WriteHeader
+
+
+btrieve_status_code_t SharedFile::AllocatePage ( uint32_t pageType, uint32_t* pageNumber, PageHandle* page )
+{
+	// If there's a free page, reuse it.
+	if ( header.freePageHead != 0 )
+	{
+		*pageNumber = header.freePageHead;
+		*page = pager.FetchForWrite ( *pageNumber );
+
+		// If FetchForWrite ( ) fails.
+		if ( !page->IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		header.freePageHead = ( ( PageLink* ) page->GetData ( ) )->next;
+		header.freePageCount--;
+	}
+	else
+	{
+		*pageNumber = header.pageCount;
+		*page = pager.FetchForWrite ( *pageNumber );
+
+		// If FetchForWrite ( ) fails.
+		if ( !page->IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		header.pageCount++;
+	}
+
+	memset ( page->GetData ( ), 0, header.pageSize );
+	( ( PageLink* ) page->GetData ( ) )->pageType = pageType;
+	headerDirty = true;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::AllocatePage
+
+
+btrieve_status_code_t SharedFile::FreePage ( uint32_t pageNumber )
+{
+	PageHandle page = pager.FetchForWrite ( pageNumber );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return pager.GetLastStatusCode ( );
+	}
+
+	PageLink* link = ( PageLink* ) page.GetData ( );
+
+	memset ( page.GetData ( ), 0, header.pageSize );
+	link->pageType = ENGINE_PAGE_TYPE_FREE;
+	link->next = header.freePageHead;
+	header.freePageHead = pageNumber;
+	header.freePageCount++;
+	headerDirty = true;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::FreePage
+
+
+btrieve_status_code_t SharedFile::AppendDataPage ( uint32_t* pageNumber )
+{
+	PageHandle page;
+	btrieve_status_code_t status = AllocatePage ( ENGINE_PAGE_TYPE_DATA, pageNumber, &page );
+
+	// If AllocatePage ( ) fails.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+
+	data->dataStart = ( uint16_t ) header.pageSize;
+	data->link.previous = header.lastDataPage;
+	page.Release ( );
+
+	// If there's a last data page, link it to the new one.
+	if ( header.lastDataPage != 0 )
+	{
+		PageHandle last = pager.FetchForWrite ( header.lastDataPage );
+
+		// If FetchForWrite ( ) fails.
+		if ( !last.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		( ( DataPageHeader* ) last.GetData ( ) )->link.next = *pageNumber;
+	}
+	else
+	{
+		header.firstDataPage = *pageNumber;
+	}
+
+	header.lastDataPage = *pageNumber;
+	header.dataPageCount++;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::AppendDataPage
+
+
+// Move the record bytes of a page together at the end of the page.
+static void CompactDataPage ( uint8_t* page, uint32_t pageSize )
+{
+	DataPageHeader* data = ( DataPageHeader* ) page;
+	DataSlot* slots = ( DataSlot* ) ( page + sizeof ( DataPageHeader ) );
+	std::vector<uint8_t> copy ( page, page + pageSize );
+	uint32_t top = pageSize;
+
+	for ( uint32_t i = 0; i < data->slotCount; i++ )
+	{
+		uint32_t length;
+
+		// If the slot is free.
+		if ( slots [ i ].offset == 0 )
+		{
+			continue;
+		}
+
+		length = ( slots [ i ].length & ENGINE_SLOT_OVERFLOW ) ? sizeof ( OverflowStub ) : slots [ i ].length;
+		length = ( length < sizeof ( OverflowStub ) ) ? sizeof ( OverflowStub ) : length;
+		top -= length;
+		memcpy ( page + top, &copy [ slots [ i ].offset ], length );
+		slots [ i ].offset = ( uint16_t ) top;
+	}	// for ( uint32_t i = 0; i < data->slotCount; i++ )
+
+	data->dataStart = ( uint16_t ) top;
+	data->reclaimable = 0;
+}	// static void CompactDataPage
+
+
+btrieve_status_code_t SharedFile::PlaceInPage ( uint32_t pageNumber, const uint8_t* bytes, int length, uint16_t flags, uint64_t* address, bool* placed )
+{
+	PageHandle page = pager.Fetch ( pageNumber );
+	uint32_t stored = ( ( uint32_t ) length < sizeof ( OverflowStub ) ) ? sizeof ( OverflowStub ) : ( uint32_t ) length;
+	uint32_t slot;
+	uint32_t slotSpace;
+	uint32_t freeSpace;
+
+	*placed = false;
+
+	// If Fetch ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return pager.GetLastStatusCode ( );
+	}
+
+	DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+	DataSlot* slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+
+	// Reuse a free slot, if there is one.
+	for ( slot = 0; slot < data->slotCount; slot++ )
+	{
+		if ( slots [ slot ].offset == 0 )
+		{
+			break;
+		}
+	}
+
+	slotSpace = ( slot == data->slotCount ) ? sizeof ( DataSlot ) : 0;
+	freeSpace = data->dataStart - ( uint32_t ) ( sizeof ( DataPageHeader ) + data->slotCount * sizeof ( DataSlot ) );
+
+	// If the record won't fit, even after compaction.
+	if ( freeSpace + data->reclaimable < stored + slotSpace )
+	{
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	page.Release ( );
+	page = pager.FetchForWrite ( pageNumber );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return pager.GetLastStatusCode ( );
+	}
+
+	data = ( DataPageHeader* ) page.GetData ( );
+	slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+
+	// If the contiguous space is too small, compact the page.
+	if ( freeSpace < stored + slotSpace )
+	{
+		CompactDataPage ( page.GetData ( ), header.pageSize );
+	}
+
+	// If a new slot is needed.
+	if ( slot == data->slotCount )
+	{
+		data->slotCount++;
+	}
+
+	data->dataStart = ( uint16_t ) ( data->dataStart - stored );
+	slots [ slot ].offset = data->dataStart;
+	slots [ slot ].length = ( uint16_t ) ( length | flags );
+	memcpy ( page.GetData ( ) + data->dataStart, bytes, length );
+	data->liveCount++;
+	*address = ENGINE_ADDRESS ( pageNumber, slot );
+	*placed = true;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::PlaceInPage
+
+
+btrieve_status_code_t SharedFile::WriteRecordOverflow ( const uint8_t* record, int length, uint32_t* firstPage )
+{
+	uint32_t capacity = header.pageSize - sizeof ( OverflowPageHeader );
+	uint32_t previous = 0;
+	int written = 0;
+	btrieve_status_code_t status;
+
+	*firstPage = 0;
+
+	while ( written < length )
+	{
+		PageHandle page;
+		uint32_t pageNumber;
+		uint32_t chunk = ( uint32_t ) ( length - written );
+
+		// If AllocatePage ( ) fails.
+		if ( ( status = AllocatePage ( ENGINE_PAGE_TYPE_OVERFLOW, &pageNumber, &page ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		OverflowPageHeader* overflow = ( OverflowPageHeader* ) page.GetData ( );
+
+		chunk = ( chunk < capacity ) ? chunk : capacity;
+		overflow->used = chunk;
+		overflow->link.previous = previous;
+		memcpy ( page.GetData ( ) + sizeof ( OverflowPageHeader ), record + written, chunk );
+		written += chunk;
+		page.Release ( );
+
+		// If this is the first page, it starts the chain.
+		if ( previous == 0 )
+		{
+			*firstPage = pageNumber;
+		}
+		else
+		{
+			PageHandle last = pager.FetchForWrite ( previous );
+
+			// If FetchForWrite ( ) fails.
+			if ( !last.IsValid ( ) )
+			{
+				return pager.GetLastStatusCode ( );
+			}
+
+			( ( OverflowPageHeader* ) last.GetData ( ) )->link.next = pageNumber;
+		}
+
+		previous = pageNumber;
+	}	// while ( written < length )
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::WriteRecordOverflow
+
+
+btrieve_status_code_t SharedFile::ReadRecordOverflow ( const OverflowStub& stub, std::vector<uint8_t>* record )
+{
+	uint32_t pageNumber = stub.firstPage;
+
+	record->clear ( );
+	record->reserve ( stub.totalLength );
+
+	while ( pageNumber != 0 && record->size ( ) < stub.totalLength )
+	{
+		PageHandle page = pager.Fetch ( pageNumber );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		OverflowPageHeader* overflow = ( OverflowPageHeader* ) page.GetData ( );
+
+		record->insert ( record->end ( ), page.GetData ( ) + sizeof ( OverflowPageHeader ), page.GetData ( ) + sizeof ( OverflowPageHeader ) + overflow->used );
+		pageNumber = overflow->link.next;
+	}	// while ( pageNumber != 0 && record->size ( ) < stub.totalLength )
+
+	// If the chain is damaged.
+	if ( record->size ( ) != stub.totalLength )
+	{
+		return BTRIEVE_STATUS_CODE_UNRECOVERABLE_ERROR;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::ReadRecordOverflow
+
+
+btrieve_status_code_t SharedFile::FreeRecordOverflow ( uint32_t firstPage )
+{
+	btrieve_status_code_t status;
+
+	while ( firstPage != 0 )
+	{
+		uint32_t next;
+
+		{
+			PageHandle page = pager.Fetch ( firstPage );
+
+			// If Fetch ( ) fails.
+			if ( !page.IsValid ( ) )
+			{
+				return pager.GetLastStatusCode ( );
+			}
+
+			next = ( ( OverflowPageHeader* ) page.GetData ( ) )->link.next;
+		}
+
+		// If FreePage ( ) fails.
+		if ( ( status = FreePage ( firstPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		firstPage = next;
+	}	// while ( firstPage != 0 )
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::FreeRecordOverflow
+
+
+btrieve_status_code_t SharedFile::InsertRecordData ( const uint8_t* record, int length, uint64_t* address )
+{
+	uint32_t inlineCapacity = header.pageSize - sizeof ( DataPageHeader ) - sizeof ( DataSlot );
+	const uint8_t* bytes = record;
+	int storedLength = length;
+	uint16_t flags = 0;
+	OverflowStub stub;
+	bool placed = false;
+	uint32_t pageNumber;
+	btrieve_status_code_t status;
+
+	// If the record won't fit in an empty page, keep it in overflow pages.
+	if ( ( uint32_t ) length > inlineCapacity || length > ENGINE_SLOT_LENGTH_MASK )
+	{
+		stub.totalLength = ( uint32_t ) length;
+
+		// If WriteRecordOverflow ( ) fails.
+		if ( ( status = WriteRecordOverflow ( record, length, &stub.firstPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		bytes = ( const uint8_t* ) &stub;
+		storedLength = sizeof ( stub );
+		flags = ENGINE_SLOT_OVERFLOW;
+	}
+
+	// Try the last data page first, so records are appended in order.
+	if ( header.lastDataPage != 0 )
+	{
+		// If PlaceInPage ( ) fails.
+		if ( ( status = PlaceInPage ( header.lastDataPage, bytes, storedLength, flags, address, &placed ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+	}
+
+	// Then the pages known to have space from deletions.
+	while ( !placed && !spacePages.empty ( ) )
+	{
+		pageNumber = spacePages.back ( );
+
+		// If PlaceInPage ( ) fails.
+		if ( ( status = PlaceInPage ( pageNumber, bytes, storedLength, flags, address, &placed ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		// If the page is full it's no longer a candidate.
+		if ( !placed )
+		{
+			spacePages.pop_back ( );
+		}
+	}	// while ( !placed && !spacePages.empty ( ) )
+
+	// If it still isn't placed, start a new page.
+	if ( !placed )
+	{
+		// If AppendDataPage ( ) fails.
+		if ( ( status = AppendDataPage ( &pageNumber ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		// If PlaceInPage ( ) fails.
+		if ( ( status = PlaceInPage ( pageNumber, bytes, storedLength, flags, address, &placed ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+	}
+
+	return placed ? BTRIEVE_STATUS_CODE_NO_ERROR : BTRIEVE_STATUS_CODE_VARIABLE_PAGE_ERROR;
+}	// btrieve_status_code_t SharedFile::InsertRecordData
+
+
+bool SharedFile::IsLiveRecord ( uint64_t address )
+{
+	uint32_t pageNumber = ENGINE_ADDRESS_PAGE ( address );
+	uint32_t slot = ENGINE_ADDRESS_SLOT ( address );
+
+	// If the page is out of range.
+	if ( pageNumber == 0 || pageNumber >= header.pageCount )
+	{
+		return false;
+	}
+
+	PageHandle page = pager.Fetch ( pageNumber );
+
+	// If Fetch ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return false;
+	}
+
+	DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+	DataSlot* slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+
+	return data->link.pageType == ENGINE_PAGE_TYPE_DATA && slot < data->slotCount && slots [ slot ].offset != 0;
+}	// bool SharedFile::IsLiveRecord
+
+
+btrieve_status_code_t SharedFile::ReadRecordData ( uint64_t address, std::vector<uint8_t>* record )
+{
+	PageHandle page;
+	const uint8_t* bytes = NULL;
+	int length = 0;
+	btrieve_status_code_t status;
+
+	// If PinRecordData ( ) fails, or read an overflow record into the vector.
+	if ( ( status = PinRecordData ( address, &page, &bytes, &length, record ) ) != BTRIEVE_STATUS_CODE_NO_ERROR || !page.IsValid ( ) )
+	{
+		return status;
+	}
+
+	record->assign ( bytes, bytes + length );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::ReadRecordData
+
+
+// Point bytes at a record. An inline record is left in its data page, which
+// stays pinned by page; an overflow record is read into overflow, and page
+// is left released.
+btrieve_status_code_t SharedFile::PinRecordData ( uint64_t address, PageHandle* page, const uint8_t** bytes, int* length, std::vector<uint8_t>* overflow )
+{
+	uint32_t pageNumber = ENGINE_ADDRESS_PAGE ( address );
+	uint32_t slot = ENGINE_ADDRESS_SLOT ( address );
+	OverflowStub stub;
+	btrieve_status_code_t status;
+
+	page->Release ( );
+
+	// If the page is out of range.
+	if ( pageNumber == 0 || pageNumber >= header.pageCount )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_RECORD_ADDRESS;
+	}
+
+	{
+		PageHandle data = pager.Fetch ( pageNumber );
+
+		// If Fetch ( ) fails.
+		if ( !data.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		DataPageHeader* dataHeader = ( DataPageHeader* ) data.GetData ( );
+		DataSlot* slots = ( DataSlot* ) ( data.GetData ( ) + sizeof ( DataPageHeader ) );
+
+		// If the address isn't a record.
+		if ( dataHeader->link.pageType != ENGINE_PAGE_TYPE_DATA || slot >= dataHeader->slotCount || slots [ slot ].offset == 0 )
+		{
+			return BTRIEVE_STATUS_CODE_INVALID_RECORD_ADDRESS;
+		}
+
+		// If the record is inline, hand over the pin.
+		if ( ( slots [ slot ].length & ENGINE_SLOT_OVERFLOW ) == 0 )
+		{
+			*bytes = data.GetData ( ) + slots [ slot ].offset;
+			*length = slots [ slot ].length;
+			*page = std::move ( data );
+			return BTRIEVE_STATUS_CODE_NO_ERROR;
+		}
+
+		memcpy ( &stub, data.GetData ( ) + slots [ slot ].offset, sizeof ( stub ) );
+	}
+
+	// If ReadRecordOverflow ( ) fails.
+	if ( ( status = ReadRecordOverflow ( stub, overflow ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	*bytes = overflow->empty ( ) ? NULL : &( *overflow ) [ 0 ];
+	*length = ( int ) overflow->size ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::PinRecordData
+
+
+btrieve_status_code_t SharedFile::UpdateRecordData ( uint64_t address, const uint8_t* record, int length )
+{
+	uint32_t pageNumber = ENGINE_ADDRESS_PAGE ( address );
+	uint32_t slot = ENGINE_ADDRESS_SLOT ( address );
+	uint32_t inlineCapacity = header.pageSize - sizeof ( DataPageHeader ) - sizeof ( DataSlot );
+	uint32_t oldStored;
+	uint32_t newStored = ( ( uint32_t ) length < sizeof ( OverflowStub ) ) ? sizeof ( OverflowStub ) : ( uint32_t ) length;
+	uint32_t freeSpace;
+	OverflowStub stub;
+	btrieve_status_code_t status;
+
+	PageHandle page = pager.FetchForWrite ( pageNumber );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return pager.GetLastStatusCode ( );
+	}
+
+	DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+	DataSlot* slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+
+	// If the address isn't a record.
+	if ( data->link.pageType != ENGINE_PAGE_TYPE_DATA || slot >= data->slotCount || slots [ slot ].offset == 0 )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_RECORD_ADDRESS;
+	}
+
+	// If the old record was in overflow pages, free them.
+	if ( slots [ slot ].length & ENGINE_SLOT_OVERFLOW )
+	{
+		memcpy ( &stub, page.GetData ( ) + slots [ slot ].offset, sizeof ( stub ) );
+		oldStored = sizeof ( OverflowStub );
+		page.Release ( );
+
+		// If FreeRecordOverflow ( ) fails.
+		if ( ( status = FreeRecordOverflow ( stub.firstPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		page = pager.FetchForWrite ( pageNumber );
+
+		// If FetchForWrite ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		data = ( DataPageHeader* ) page.GetData ( );
+		slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+	}
+	else
+	{
+		oldStored = slots [ slot ].length;
+		oldStored = ( oldStored < sizeof ( OverflowStub ) ) ? sizeof ( OverflowStub ) : oldStored;
+	}
+
+	// If the new record fits where the old one was.
+	if ( ( uint32_t ) length <= inlineCapacity && length <= ENGINE_SLOT_LENGTH_MASK && newStored <= oldStored )
+	{
+		memcpy ( page.GetData ( ) + slots [ slot ].offset, record, length );
+		slots [ slot ].length = ( uint16_t ) length;
+		data->reclaimable = ( uint16_t ) ( data->reclaimable + oldStored - newStored );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// Give up the old space, then look for room in the page.
+	slots [ slot ].offset = 0;
+	data->reclaimable = ( uint16_t ) ( data->reclaimable + oldStored );
+	freeSpace = data->dataStart - ( uint32_t ) ( sizeof ( DataPageHeader ) + data->slotCount * sizeof ( DataSlot ) );
+
+	// If the new record fits in the page, inline.
+	if ( ( uint32_t ) length <= inlineCapacity && length <= ENGINE_SLOT_LENGTH_MASK && freeSpace + data->reclaimable >= newStored )
+	{
+		// If the contiguous space is too small, compact the page.
+		if ( freeSpace < newStored )
+		{
+			CompactDataPage ( page.GetData ( ), header.pageSize );
+		}
+
+		data->dataStart = ( uint16_t ) ( data->dataStart - newStored );
+		slots [ slot ].offset = data->dataStart;
+		slots [ slot ].length = ( uint16_t ) length;
+		memcpy ( page.GetData ( ) + data->dataStart, record, length );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// Otherwise the record moves to overflow pages; the stub always fits where the old record was.
+	CompactDataPage ( page.GetData ( ), header.pageSize );
+	data->dataStart = ( uint16_t ) ( data->dataStart - sizeof ( OverflowStub ) );
+	slots [ slot ].offset = data->dataStart;
+	slots [ slot ].length = ( uint16_t ) ( sizeof ( OverflowStub ) | ENGINE_SLOT_OVERFLOW );
+	memset ( &stub, 0, sizeof ( stub ) );
+	memcpy ( page.GetData ( ) + data->dataStart, &stub, sizeof ( stub ) );
+	page.Release ( );
+	stub.totalLength = ( uint32_t ) length;
+
+	// If WriteRecordOverflow ( ) fails.
+	if ( ( status = WriteRecordOverflow ( record, length, &stub.firstPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	page = pager.FetchForWrite ( pageNumber );
+
+	// If FetchForWrite ( ) fails.
+	if ( !page.IsValid ( ) )
+	{
+		return pager.GetLastStatusCode ( );
+	}
+
+	slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+	memcpy ( page.GetData ( ) + slots [ slot ].offset, &stub, sizeof ( stub ) );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::UpdateRecordData
+
+
+btrieve_status_code_t SharedFile::DeleteRecordData ( uint64_t address )
+{
+	uint32_t pageNumber = ENGINE_ADDRESS_PAGE ( address );
+	uint32_t slot = ENGINE_ADDRESS_SLOT ( address );
+	uint32_t stored;
+	uint32_t overflowPage = 0;
+	btrieve_status_code_t status;
+
+	{
+		PageHandle page = pager.FetchForWrite ( pageNumber );
+
+		// If FetchForWrite ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+		DataSlot* slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+
+		// If the address isn't a record.
+		if ( data->link.pageType != ENGINE_PAGE_TYPE_DATA || slot >= data->slotCount || slots [ slot ].offset == 0 )
+		{
+			return BTRIEVE_STATUS_CODE_INVALID_RECORD_ADDRESS;
+		}
+
+		// If the record is in overflow pages, remember the chain.
+		if ( slots [ slot ].length & ENGINE_SLOT_OVERFLOW )
+		{
+			OverflowStub stub;
+
+			memcpy ( &stub, page.GetData ( ) + slots [ slot ].offset, sizeof ( stub ) );
+			overflowPage = stub.firstPage;
+			stored = sizeof ( OverflowStub );
+		}
+		else
+		{
+			stored = slots [ slot ].length;
+			stored = ( stored < sizeof ( OverflowStub ) ) ? sizeof ( OverflowStub ) : stored;
+		}
+
+		slots [ slot ].offset = 0;
+		slots [ slot ].length = 0;
+		data->reclaimable = ( uint16_t ) ( data->reclaimable + stored );
+		data->liveCount--;
+
+		// Trailing free slots are dropped.
+		while ( data->slotCount > 0 && slots [ data->slotCount - 1 ].offset == 0 )
+		{
+			data->slotCount--;
+		}
+	}
+
+	// If the page isn't the last data page, it's a candidate for new records.
+	if ( pageNumber != header.lastDataPage && spacePages.size ( ) < ENGINE_MAXIMUM_SPACE_PAGES
+		&& ( spacePages.empty ( ) || spacePages.back ( ) != pageNumber ) )
+	{
+		spacePages.push_back ( pageNumber );
+	}
+
+	// If the record had overflow pages, free them.
+	if ( overflowPage != 0 && ( status = FreeRecordOverflow ( overflowPage ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::DeleteRecordData
+
+
+// Find the first live slot at or after slot in the data page chain.
+static bool ScanForward ( SharedFile* file, uint32_t pageNumber, uint32_t slot, uint64_t* address )
+{
+	while ( pageNumber != 0 )
+	{
+		PageHandle page = file->pager.Fetch ( pageNumber );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+		DataSlot* slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+
+		for ( ; slot < data->slotCount; slot++ )
+		{
+			// If the slot holds a record.
+			if ( slots [ slot ].offset != 0 )
+			{
+				*address = ENGINE_ADDRESS ( pageNumber, slot );
+				return true;
+			}
+		}
+
+		pageNumber = data->link.next;
+		slot = 0;
+	}	// while ( pageNumber != 0 )
+
+	return false;
+}	// static bool ScanForward
+
+
+// Find the last live slot before slot in the data page chain; a slot of
+// 0xFFFF means the whole page.
+static bool ScanBackward ( SharedFile* file, uint32_t pageNumber, uint32_t slot, uint64_t* address )
+{
+	while ( pageNumber != 0 )
+	{
+		PageHandle page = file->pager.Fetch ( pageNumber );
+
+		// If Fetch ( ) fails.
+		if ( !page.IsValid ( ) )
+		{
+			return false;
+		}
+
+		DataPageHeader* data = ( DataPageHeader* ) page.GetData ( );
+		DataSlot* slots = ( DataSlot* ) ( page.GetData ( ) + sizeof ( DataPageHeader ) );
+
+		slot = ( slot > data->slotCount ) ? data->slotCount : slot;
+
+		while ( slot-- > 0 )
+		{
+			// If the slot holds a record.
+			if ( slots [ slot ].offset != 0 )
+			{
+				*address = ENGINE_ADDRESS ( pageNumber, slot );
+				return true;
+			}
+		}
+
+		pageNumber = data->link.previous;
+		slot = 0xFFFF;
+	}	// while ( pageNumber != 0 )
+
+	return false;
+}	// static bool ScanBackward
+
+
+bool SharedFile::FirstPhysical ( uint64_t* address )
+{
+	return ScanForward ( this, header.firstDataPage, 0, address );
+}	// bool SharedFile::FirstPhysical
+
+
+bool SharedFile::LastPhysical ( uint64_t* address )
+{
+	return ScanBackward ( this, header.lastDataPage, 0xFFFF, address );
+}	// bool SharedFile::LastPhysical
+
+
+bool SharedFile::NextPhysical ( uint64_t* address )
+{
+	return ScanForward ( this, ENGINE_ADDRESS_PAGE ( *address ), ENGINE_ADDRESS_SLOT ( *address ) + 1, address );
+}	// bool SharedFile::NextPhysical
+
+
+bool SharedFile::PreviousPhysical ( uint64_t* address )
+{
+	return ScanBackward ( this, ENGINE_ADDRESS_PAGE ( *address ), ENGINE_ADDRESS_SLOT ( *address ), address );
+}	// bool SharedFile::PreviousPhysical
+
+
+btrieve_status_code_t SharedFile::CheckRecordLength ( int length )
+{
+	// If the record is shorter than the fixed length, or too long.
+	if ( length < header.fixedRecordLength || length > BTRIEVE_MAXIMUM_RECORD_LENGTH )
+	{
+		return BTRIEVE_STATUS_CODE_DATALENGTH_ERROR;
+	}
+
+	// If a file without variable length records gets a longer record.
+	if ( header.variableLengthRecordsMode == BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_NO && length != header.fixedRecordLength )
+	{
+		return BTRIEVE_STATUS_CODE_DATALENGTH_ERROR;
+	}
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::CheckRecordLength
+
+
+IndexDefinition* SharedFile::FindIndex ( int index )
+{
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		// If this is the index.
+		if ( header.indexes [ i ].index == index )
+		{
+			return &header.indexes [ i ];
+		}
+	}
+
+	return NULL;
+}	// IndexDefinition* SharedFile::FindIndex
+
+
+static int64_t ReadAutoIncrement ( const uint8_t* value, int length )
+{
+	switch ( length )
+	{
+		case 2:
+		{
+			int16_t result;
+
+			memcpy ( &result, value, sizeof ( result ) );
+			return result;
+		}
+		case 4:
+		{
+			int32_t result;
+
+			memcpy ( &result, value, sizeof ( result ) );
+			return result;
+		}
+		default:
+		{
+			int64_t result;
+
+			memcpy ( &result, value, sizeof ( result ) );
+			return result;
+		}
+	}	// switch ( length )
+}	// static int64_t ReadAutoIncrement
+
+
+static void WriteAutoIncrement ( uint8_t* value, int length, int64_t number )
+{
+	switch ( length )
+	{
+		case 2:
+		{
+			int16_t result = ( int16_t ) number;
+
+			memcpy ( value, &result, sizeof ( result ) );
+			break;
+		}
+		case 4:
+		{
+			int32_t result = ( int32_t ) number;
+
+			memcpy ( value, &result, sizeof ( result ) );
+			break;
+		}
+		default:
+			memcpy ( value, &number, sizeof ( number ) );
+			break;
+	}	// switch ( length )
+}	// static void WriteAutoIncrement
+
+
+btrieve_status_code_t SharedFile::AssignAutoIncrement ( uint8_t* record )
+{
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		IndexDefinition& definition = header.indexes [ i ];
+		const SegmentDefinition& segment = definition.segments [ 0 ];
+		uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+		TreePosition position;
+		uint64_t address;
+		int64_t maximum = 0;
+
+		// If the index isn't a lone AUTOINCREMENT segment, or the record has its own value.
+		if ( definition.segments.size ( ) != 1 || segment.dataType != BTRIEVE_DATA_TYPE_AUTOINCREMENT
+			|| ReadAutoIncrement ( record + segment.offset, segment.length ) != 0 )
+		{
+			continue;
+		}
+
+		BTree tree ( this, &definition );
+
+		// If the index ends in a key, the next value follows it.
+		if ( !( segment.descending ? tree.First ( &position ) : tree.Last ( &position ) ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		if ( position.page != 0 && tree.ReadEntry ( position, key, &address ) && DecodeKey ( definition, key, key ) )
+		{
+			maximum = ReadAutoIncrement ( key, segment.length );
+		}
+
+		WriteAutoIncrement ( record + segment.offset, segment.length, maximum + 1 );
+	}	// for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::AssignAutoIncrement
+
+
+// Return the status for a record whose unique keys may already be held by
+// another record. An address of zero means a new record.
+btrieve_status_code_t SharedFile::CheckUniqueKeys ( const uint8_t* record, uint64_t address )
+{
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		IndexDefinition& definition = header.indexes [ i ];
+		uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+		uint8_t found [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+		TreePosition position;
+		uint64_t foundAddress;
+
+		// If the index allows duplicates, or the record's key isn't indexed.
+		if ( definition.duplicateMode != BTRIEVE_DUPLICATE_MODE_NOT_ALLOWED || !ExtractKey ( definition, record, key ) )
+		{
+			continue;
+		}
+
+		BTree tree ( this, &definition );
+
+		// If LowerBound ( ) fails.
+		if ( !tree.LowerBound ( key, 0, ADDRESS_MODE_LOWEST, &position ) )
+		{
+			return pager.GetLastStatusCode ( );
+		}
+
+		// If another record holds the key.
+		if ( position.page != 0 && tree.ReadEntry ( position, found, &foundAddress )
+			&& CompareKeys ( definition, found, key ) == 0 && foundAddress != address )
+		{
+			return BTRIEVE_STATUS_CODE_DUPLICATE_KEY_VALUE;
+		}
+	}	// for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::CheckUniqueKeys
+
+
+btrieve_status_code_t SharedFile::InsertIndexEntries ( const uint8_t* record, uint64_t address )
+{
+	btrieve_status_code_t status;
+
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		IndexDefinition& definition = header.indexes [ i ];
+		uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+
+		// If the record's key isn't indexed.
+		if ( !ExtractKey ( definition, record, key ) )
+		{
+			continue;
+		}
+
+		BTree tree ( this, &definition );
+
+		// If Insert ( ) fails.
+		if ( ( status = tree.Insert ( key, address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		AddBloomKey ( definition, key );
+	}	// for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::InsertIndexEntries
+
+
+btrieve_status_code_t SharedFile::CreateRecord ( uint8_t* record, int length, uint64_t* address )
+{
+	btrieve_status_code_t status;
+
+	// If the record length is invalid.
+	if ( ( status = CheckRecordLength ( length ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If AssignAutoIncrement ( ) fails.
+	if ( ( status = AssignAutoIncrement ( record ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If a unique key is taken.
+	if ( ( status = CheckUniqueKeys ( record, 0 ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If InsertRecordData ( ) fails.
+	if ( ( status = InsertRecordData ( record, length, address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	status = InsertIndexEntries ( record, *address );
+	header.recordCount++;
+	headerDirty = true;
+	Touch ( );
+	return status;
+}	// btrieve_status_code_t SharedFile::CreateRecord
+
+
+btrieve_status_code_t SharedFile::UpdateRecord ( uint64_t address, const uint8_t* record, int length )
+{
+	std::vector<uint8_t> old;
+	std::vector<bool> changed ( header.indexes.size ( ), false );
+	btrieve_status_code_t status;
+
+	// If the record length is invalid.
+	if ( ( status = CheckRecordLength ( length ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If ReadRecordData ( ) fails.
+	if ( ( status = ReadRecordData ( address, &old ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		IndexDefinition& definition = header.indexes [ i ];
+		uint8_t oldKey [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+		uint8_t newKey [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+		bool oldIncluded = ExtractKey ( definition, &old [ 0 ], oldKey );
+		bool newIncluded = ExtractKey ( definition, record, newKey );
+
+		// If the key bytes are unchanged the index entry stays.
+		if ( oldIncluded == newIncluded && memcmp ( oldKey, newKey, definition.keyLength ) == 0 )
+		{
+			continue;
+		}
+
+		// If the key mustn't change.
+		if ( !definition.modifiable )
+		{
+			return BTRIEVE_STATUS_CODE_MODIFIABLE_KEYVALUE_ERROR;
+		}
+
+		changed [ i ] = true;
+	}	// for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+
+	// If a unique key is taken.
+	if ( ( status = CheckUniqueKeys ( record, address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If UpdateRecordData ( ) fails.
+	if ( ( status = UpdateRecordData ( address, record, length ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		IndexDefinition& definition = header.indexes [ i ];
+		uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+
+		// If the key didn't change.
+		if ( !changed [ i ] )
+		{
+			continue;
+		}
+
+		BTree tree ( this, &definition );
+
+		// If the old key was indexed.
+		if ( ExtractKey ( definition, &old [ 0 ], key ) )
+		{
+			// If Remove ( ) fails.
+			if ( ( status = tree.Remove ( key, address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+			{
+				return status;
+			}
+
+			RemoveBloomKey ( definition );
+		}
+
+		// If the new key is indexed.
+		if ( ExtractKey ( definition, record, key ) )
+		{
+			// If Insert ( ) fails.
+			if ( ( status = tree.Insert ( key, address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+			{
+				return status;
+			}
+
+			AddBloomKey ( definition, key );
+		}
+	}	// for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+
+	headerDirty = true;
+	Touch ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::UpdateRecord
+
+
+btrieve_status_code_t SharedFile::DeleteRecord ( uint64_t address )
+{
+	std::vector<uint8_t> old;
+	btrieve_status_code_t status;
+
+	// If ReadRecordData ( ) fails.
+	if ( ( status = ReadRecordData ( address, &old ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		IndexDefinition& definition = header.indexes [ i ];
+		uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+
+		// If the record's key isn't indexed.
+		if ( !ExtractKey ( definition, &old [ 0 ], key ) )
+		{
+			continue;
+		}
+
+		BTree tree ( this, &definition );
+
+		// If Remove ( ) fails.
+		if ( ( status = tree.Remove ( key, address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		RemoveBloomKey ( definition );
+	}	// for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+
+	// If DeleteRecordData ( ) fails.
+	if ( ( status = DeleteRecordData ( address ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	header.recordCount--;
+	headerDirty = true;
+	Touch ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::DeleteRecord
+
+
+btrieve_status_code_t SharedFile::CreateIndex ( IndexDefinition* definition, const btrieve_index_build_options_t* options )
+{
+	size_t position;
+	btrieve_status_code_t status;
+
+	// If the definition is invalid.
+	if ( ( status = ValidateIndexDefinition ( *definition, header.fixedRecordLength ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	PrepareIndexDefinition ( definition );
+
+	// If a page can't hold enough keys.
+	if ( ( status = BTree::CheckCapacity ( header.pageSize, definition->keyLength ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// If no index number was given, take the first free one.
+	if ( definition->index == BTRIEVE_INDEX_NONE )
+	{
+		for ( definition->index = BTRIEVE_INDEX_1; FindIndex ( definition->index ) != NULL; definition->index++ )
+		{
+		}
+	}
+
+	// If the index number is out of range or taken.
+	if ( definition->index < BTRIEVE_INDEX_1 || definition->index > BTRIEVE_INDEX_119 || FindIndex ( definition->index ) != NULL )
+	{
+		return BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+	}
+
+	// Keep the indexes in index number order.
+	for ( position = 0; position < header.indexes.size ( ) && header.indexes [ position ].index < definition->index; position++ )
+	{
+	}
+
+	header.indexes.insert ( header.indexes.begin ( ) + position, *definition );
+
+	IndexDefinition* added = &header.indexes [ position ];
+	BTree tree ( this, added );
+
+	// If Initialize ( ) fails.
+	if ( ( status = tree.Initialize ( ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		header.indexes.erase ( header.indexes.begin ( ) + position );
+		return status;
+	}
+
+	std::vector<EntrySorter*> sorters;
+	BloomFilter* filter = NULL;
+	bool unfilterable = false;
+	int threadCount = GetIndexBuildThreadCount ( ( options != NULL ) ? options->threadCount : 0 );
+	uint32_t threadPages = header.dataPageCount / ENGINE_INDEX_PAGES_PER_THREAD;
+
+	// A small file isn't worth every thread.
+	threadCount = ( ( uint32_t ) threadCount > threadPages ) ? ( ( threadPages > 0 ) ? ( int ) threadPages : 1 ) : threadCount;
+
+	IndexBuildProgress progress ( options, threadCount, header.recordCount );
+
+	ResetBloomFilter ( added->index );
+	progress.StartPhase ( BTRIEVE_INDEX_BUILD_PHASE_READ );
+
+	// Gather and sort the key of every record, with a filter if the index will be big enough to filter, then build the tree from the leaves up.
+	if ( ( status = GatherIndexEntries ( this, *added, threadCount, ( header.recordCount >= ENGINE_BLOOM_MINIMUM_ENTRIES ) ? bloomBitsPerKey : 0, &progress, &sorters, &filter, &unfilterable ) ) == BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		EntryMerger merger ( *added, sorters, &progress );
+
+		progress.StartPhase ( BTRIEVE_INDEX_BUILD_PHASE_LOAD );
+		status = tree.Load ( &merger, added->duplicateMode == BTRIEVE_DUPLICATE_MODE_NOT_ALLOWED );
+	}
+
+	for ( size_t i = 0; i < sorters.size ( ); i++ )
+	{
+		delete sorters [ i ];
+	}
+
+	// If the index couldn't be populated, take it back out.
+	if ( status != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		delete filter;
+		tree.Drop ( );
+		header.indexes.erase ( header.indexes.begin ( ) + position );
+		headerDirty = true;
+		return status;
+	}
+
+	bloomFilters [ added->index ].filter.store ( filter, std::memory_order_release );
+	bloomFilters [ added->index ].unfilterable.store ( unfilterable, std::memory_order_relaxed );
+	*definition = *added;
+	headerDirty = true;
+	Touch ( );
+	progress.SetEntriesLoaded ( added->entryCount );
+	progress.StartPhase ( BTRIEVE_INDEX_BUILD_PHASE_DONE );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::CreateIndex
+
+
+btrieve_status_code_t SharedFile::DropIndex ( int index )
+{
+	btrieve_status_code_t status;
+
+	for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+	{
+		// If this isn't the index.
+		if ( header.indexes [ i ].index != index )
+		{
+			continue;
+		}
+
+		BTree tree ( this, &header.indexes [ i ] );
+
+		status = tree.Drop ( );
+		ResetBloomFilter ( index );
+		header.indexes.erase ( header.indexes.begin ( ) + i );
+		headerDirty = true;
+		Touch ( );
+		return status;
+	}	// for ( size_t i = 0; i < header.indexes.size ( ); i++ )
+
+	return BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER;
+}	// btrieve_status_code_t SharedFile::DropIndex
+
+
+// Build the filter of an index from the keys in its leaves. Returns NULL,
+// with unfilterable set if a key can't be hashed, when there's none to use.
+BloomFilter* SharedFile::BuildBloomFilter ( const IndexDefinition* definition, bool* unfilterable )
+{
+	uint8_t key [ BTRIEVE_MAXIMUM_KEY_LENGTH ];
+	uint64_t address;
+	uint64_t hash;
+	TreePosition position;
+	BTree tree ( this, ( IndexDefinition* ) definition );
+	BloomFilter* filter;
+
+	*unfilterable = false;
+
+	// If new fails.
+	if ( ( filter = new ( std::nothrow ) BloomFilter ( ) ) == NULL )
+	{
+		return NULL;
+	}
+
+	// If Allocate ( ) or First ( ) fails.
+	if ( !filter->Allocate ( definition->entryCount + definition->entryCount / 4, bloomBitsPerKey ) || !tree.First ( &position ) )
+	{
+		delete filter;
+		return NULL;
+	}
+
+	while ( position.page != 0 )
+	{
+		// If ReadEntry ( ) fails.
+		if ( !tree.ReadEntry ( position, key, &address ) )
+		{
+			delete filter;
+			return NULL;
+		}
+
+		// If the key can't be hashed, no filter can answer for the index.
+		if ( !HashKey ( *definition, key, &hash ) )
+		{
+			*unfilterable = true;
+			delete filter;
+			return NULL;
+		}
+
+		filter->Add ( hash );
+
+		// If Next ( ) fails.
+		if ( !tree.Next ( &position ) )
+		{
+			delete filter;
+			return NULL;
+		}
+	}	// while ( position.page != 0 )
+
+	return filter;
+}	// BloomFilter* SharedFile::BuildBloomFilter
+
+
+bool SharedFile::ExcludesKey ( const IndexDefinition* definition, const uint8_t* key, bool* filtered )
+{
+	IndexBloomFilter* slot = &bloomFilters [ definition->index ];
+	BloomFilter* filter = slot->filter.load ( std::memory_order_acquire );
+	uint64_t hash;
+
+	*filtered = false;
+
+	// If there's no filter, build one if the index is worth filtering.
+	if ( filter == NULL )
+	{
+		// If filters are off, or the index is too small or can't be filtered.
+		if ( bloomBitsPerKey == 0 || definition->entryCount < ENGINE_BLOOM_MINIMUM_ENTRIES || slot->unfilterable.load ( std::memory_order_relaxed ) )
+		{
+			return false;
+		}
+
+		std::lock_guard<std::mutex> guard ( bloomMutex );
+
+		// If another search hasn't built it meanwhile.
+		if ( ( filter = slot->filter.load ( std::memory_order_acquire ) ) == NULL )
+		{
+			bool unfilterable;
+
+			filter = BuildBloomFilter ( definition, &unfilterable );
+			slot->unfilterable.store ( unfilterable, std::memory_order_relaxed );
+			slot->removedCount = 0;
+			slot->filter.store ( filter, std::memory_order_release );
+		}
+
+		// If the build failed.
+		if ( filter == NULL )
+		{
+			return false;
+		}
+	}	// if ( filter == NULL )
+
+	// If the key can't be hashed.
+	if ( !HashKey ( *definition, key, &hash ) )
+	{
+		return false;
+	}
+
+	slot->lookupCount.fetch_add ( 1, std::memory_order_relaxed );
+
+	// If the filter passes the key, the tree must be searched.
+	if ( filter->MayContain ( hash ) )
+	{
+		*filtered = true;
+		return false;
+	}
+
+	slot->negativeCount.fetch_add ( 1, std::memory_order_relaxed );
+	return true;
+}	// bool SharedFile::ExcludesKey
+
+
+void SharedFile::CountFalsePositive ( int index )
+{
+	bloomFilters [ index ].falsePositiveCount.fetch_add ( 1, std::memory_order_relaxed );
+}	// void SharedFile::CountFalsePositive
+
+
+void SharedFile::GetBloomFilterStatistics ( int index, BloomFilterStatistics* statistics )
+{
+	IndexBloomFilter* slot = &bloomFilters [ index ];
+	BloomFilter* filter = slot->filter.load ( std::memory_order_acquire );
+
+	statistics->enabled = ( filter != NULL );
+	statistics->keyCount = ( filter != NULL ) ? filter->GetKeyCount ( ) : 0;
+	statistics->bitCount = ( filter != NULL ) ? filter->GetBitCount ( ) : 0;
+	statistics->estimatedFalsePositiveRate = ( filter != NULL ) ? filter->GetEstimatedFalsePositiveRate ( ) : 0.0;
+	statistics->lookupCount = slot->lookupCount.load ( std::memory_order_relaxed );
+	statistics->negativeCount = slot->negativeCount.load ( std::memory_order_relaxed );
+	statistics->falsePositiveCount = slot->falsePositiveCount.load ( std::memory_order_relaxed );
+}	// void SharedFile::GetBloomFilterStatistics
+
+
+// Add a key a writer put in an index to its filter, if it has one. A key
+// that can't be hashed drops the filter for good; one that has grown well
+// past its sizing is dropped for the next search to rebuild.
+void SharedFile::AddBloomKey ( const IndexDefinition& definition, const uint8_t* key )
+{
+	IndexBloomFilter* slot = &bloomFilters [ definition.index ];
+	BloomFilter* filter = slot->filter.load ( std::memory_order_relaxed );
+	uint64_t hash;
+	bool hashed;
+
+	// If the index has no filter.
+	if ( filter == NULL )
+	{
+		return;
+	}
+
+	hashed = HashKey ( definition, key, &hash );
+
+	// If the key can be hashed and the filter has room.
+	if ( hashed && filter->GetKeyCount ( ) < filter->GetCapacity ( ) * ENGINE_BLOOM_GROWTH_FACTOR )
+	{
+		filter->Add ( hash );
+		return;
+	}
+
+	slot->unfilterable.store ( !hashed, std::memory_order_relaxed );
+	slot->filter.store ( NULL, std::memory_order_relaxed );
+	slot->removedCount = 0;
+	delete filter;
+}	// void SharedFile::AddBloomKey
+
+
+// Count a key a writer took out of an index; its bits stay set, so once
+// enough have gone, the filter is dropped for the next search to rebuild.
+void SharedFile::RemoveBloomKey ( const IndexDefinition& definition )
+{
+	IndexBloomFilter* slot = &bloomFilters [ definition.index ];
+	BloomFilter* filter = slot->filter.load ( std::memory_order_relaxed );
+
+	// If the index has no filter.
+	if ( filter == NULL )
+	{
+		return;
+	}
+
+	// If too many of the filter's keys are gone.
+	if ( ++slot->removedCount > filter->GetCapacity ( ) / 2 )
+	{
+		slot->filter.store ( NULL, std::memory_order_relaxed );
+		slot->removedCount = 0;
+		delete filter;
+	}
+}	// void SharedFile::RemoveBloomKey
+
+
+// Forget the filter and counters of an index number, as when the index is created or dropped.
+void SharedFile::ResetBloomFilter ( int index )
+{
+	IndexBloomFilter* slot = &bloomFilters [ index ];
+
+	delete slot->filter.exchange ( NULL );
+	slot->unfilterable.store ( false, std::memory_order_relaxed );
+	slot->removedCount = 0;
+	slot->lookupCount.store ( 0, std::memory_order_relaxed );
+	slot->negativeCount.store ( 0, std::memory_order_relaxed );
+	slot->falsePositiveCount.store ( 0, std::memory_order_relaxed );
+}	// void SharedFile::ResetBloomFilter
+
+
+btrieve_status_code_t SharedFile::JoinTransaction ( const void* owner )
+{
+	// If the owner is already in a transaction on this file.
+	if ( transactionOwner == owner )
+	{
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// If another client's transaction holds the file.
+	if ( transactionOwner != NULL )
+	{
+		return BTRIEVE_STATUS_CODE_FILE_INUSE;
+	}
+
+	transactionOwner = owner;
+	transactionHeader = header;
+	pager.BeginPreimages ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t SharedFile::JoinTransaction
+
+
+void SharedFile::CommitTransaction ( )
+{
+	transactionOwner = NULL;
+	pager.DiscardPreimages ( );
+}	// void SharedFile::CommitTransaction
+
+
+void SharedFile::AbortTransaction ( )
+{
+	transactionOwner = NULL;
+	pager.RestorePreimages ( );
+	header = transactionHeader;
+
+	// A filter built during the transaction lacks the keys it removed, which are back.
+	for ( int i = BTRIEVE_INDEX_1; i <= BTRIEVE_INDEX_119; i++ )
+	{
+		delete bloomFilters [ i ].filter.exchange ( NULL );
+		bloomFilters [ i ].removedCount = 0;
+	}
+
+	headerDirty = true;
+	spacePages.clear ( );
+	Touch ( );
+}	// void SharedFile::AbortTransaction
+
+
+bool SharedFile::IsLockedByOther ( const void* owner ) const
+{
+	return transactionOwner != NULL && transactionOwner != owner;
+}	// bool SharedFile::IsLockedByOther
+
+
+static std::mutex registryMutex;
+static std::map<std::string, std::weak_ptr<SharedFile> > registry;
+
+
+std::mutex& GetRegistryMutex ( )
+{
+	return registryMutex;
+}	// std::mutex& GetRegistryMutex
+
+
+std::shared_ptr<SharedFile> FindSharedFile ( const std::string& path )
+{
+	std::map<std::string, std::weak_ptr<SharedFile> >::iterator entry = registry.find ( path );
+
+	return ( entry == registry.end ( ) ) ? std::shared_ptr<SharedFile> ( ) : entry->second.lock ( );
+}	// std::shared_ptr<SharedFile> FindSharedFile
+
+
+void RegisterSharedFile ( const std::shared_ptr<SharedFile>& file )
+{
+	registry [ file->path ] = file;
+}	// void RegisterSharedFile
+
+
+void UnregisterSharedFile ( const std::shared_ptr<SharedFile>& file )
+{
+	std::map<std::string, std::weak_ptr<SharedFile> >::iterator entry = registry.find ( file->path );
+
+	// If the registered file is this one.
+	if ( entry != registry.end ( ) && entry->second.lock ( ) == file )
+	{
+		registry.erase ( entry );
+	}
+}	// void UnregisterSharedFile
+
+}	// namespace BtrieveEngine
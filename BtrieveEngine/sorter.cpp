@@ -0,0 +1,686 @@
+// sorter.cpp : External sort of index entries for the bottom-up index build
+//              of the in-process engine.
+//
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <string>
+
+#include "indexBuild.h"
+#include "sorter.h"
+
+namespace BtrieveEngine
+{
+
+size_t GetSortMemoryBudget ( )
+{
+	const char* setting = getenv ( "BTRIEVE_ENGINE_SORT_BYTES" );
+	char* end;
+	unsigned long long bytes;
+
+	// If there's no setting.
+	if ( setting == NULL || *setting == '\0' )
+	{
+		return ENGINE_DEFAULT_SORT_BYTES;
+	}
+
+	bytes = strtoull ( setting, &end, 10 );
+
+	// If the setting isn't a number.
+	if ( *end != '\0' || bytes == 0 )
+	{
+		return ENGINE_DEFAULT_SORT_BYTES;
+	}
+
+	return ( size_t ) bytes;
+}	// size_t GetSortMemoryBudget
+
+
+// Order entries by key, then by address, as leaf entries are ordered.
+static int CompareEntries ( const IndexDefinition& definition, const uint8_t* left, const uint8_t* right )
+{
+	int result = CompareKeys ( definition, left, right );
+	uint64_t leftAddress;
+	uint64_t rightAddress;
+
+	// If the keys differ.
+	if ( result != 0 )
+	{
+		return result;
+	}
+
+	memcpy ( &leftAddress, left + definition.keyLength, sizeof ( leftAddress ) );
+	memcpy ( &rightAddress, right + definition.keyLength, sizeof ( rightAddress ) );
+	return ( leftAddress < rightAddress ) ? -1 : ( leftAddress > rightAddress ) ? 1 : 0;
+}	// static int CompareEntries
+
+
+// Orders positions in the in-memory buffer by the entries they hold.
+struct BufferOrder
+{
+	const EntrySorter* sorter;
+	const uint8_t* buffer;
+	size_t stride;
+	int ( EntrySorter::*compare ) ( const uint8_t*, const uint8_t* ) const;
+
+	bool operator() ( uint32_t left, uint32_t right ) const
+	{
+		return ( sorter->*compare ) ( buffer + ( size_t ) left * stride, buffer + ( size_t ) right * stride ) < 0;
+	}
+};	// struct BufferOrder
+
+
+// Orders runs in a min-heap by their current entries; std::push_heap keeps the greatest first, so the order is reversed.
+struct HeapOrder
+{
+	const EntrySorter* sorter;
+	const std::vector<const uint8_t*>* heads;
+	int ( EntrySorter::*compare ) ( const uint8_t*, const uint8_t* ) const;
+
+	bool operator() ( size_t left, size_t right ) const
+	{
+		return ( sorter->*compare ) ( ( *heads ) [ left ], ( *heads ) [ right ] ) > 0;
+	}
+};	// struct HeapOrder
+
+
+EntrySorter::EntrySorter ( const IndexDefinition& definitionIn, size_t memoryBytes )
+	: definition ( definitionIn ),
+	  stride ( definitionIn.keyLength + sizeof ( uint64_t ) ),
+	  count ( 0 ),
+	  spilledRuns ( 0 ),
+	  orderPosition ( 0 ),
+	  pendingRun ( 0 ),
+	  merging ( false ),
+	  lastStatusCode ( BTRIEVE_STATUS_CODE_NO_ERROR )
+{
+	// Each buffered entry also costs its place in the sort order.
+	capacity = memoryBytes / ( stride + sizeof ( uint32_t ) );
+	capacity = ( capacity < ENGINE_MINIMUM_SORT_ENTRIES ) ? ENGINE_MINIMUM_SORT_ENTRIES : capacity;
+	capacity = ( capacity > UINT32_MAX ) ? UINT32_MAX : capacity;
+}	// EntrySorter::EntrySorter
+
+
+EntrySorter::~EntrySorter ( )
+{
+	for ( size_t i = 0; i < runs.size ( ); i++ )
+	{
+		fclose ( runs [ i ].file );
+	}
+}	// EntrySorter::~EntrySorter
+
+
+int EntrySorter::Compare ( const uint8_t* left, const uint8_t* right ) const
+{
+	return CompareEntries ( definition, left, right );
+}	// int EntrySorter::Compare
+
+
+btrieve_status_code_t EntrySorter::Add ( const uint8_t* key, uint64_t address )
+{
+	btrieve_status_code_t status;
+
+	// If the buffer is full, spill it as a run.
+	if ( buffer.size ( ) / stride >= capacity && ( status = SpillBuffer ( ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	buffer.insert ( buffer.end ( ), key, key + definition.keyLength );
+	buffer.insert ( buffer.end ( ), ( const uint8_t* ) &address, ( const uint8_t* ) &address + sizeof ( address ) );
+	count++;
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t EntrySorter::Add
+
+
+void EntrySorter::SortBuffer ( )
+{
+	BufferOrder less = { this, buffer.empty ( ) ? NULL : &buffer [ 0 ], stride, &EntrySorter::Compare };
+	uint32_t entries = ( uint32_t ) ( buffer.size ( ) / stride );
+
+	order.resize ( entries );
+
+	for ( uint32_t i = 0; i < entries; i++ )
+	{
+		order [ i ] = i;
+	}
+
+	std::sort ( order.begin ( ), order.end ( ), less );
+	orderPosition = 0;
+}	// void EntrySorter::SortBuffer
+
+
+btrieve_status_code_t EntrySorter::CreateRunFile ( FILE** file )
+{
+	const char* directory = getenv ( "TMPDIR" );
+	std::string path = std::string ( ( directory != NULL && *directory != '\0' ) ? directory : "/tmp" ) + "/btrieveSortXXXXXX";
+	int fileDescriptor = mkstemp ( &path [ 0 ] );
+
+	// If mkstemp ( ) fails.
+	if ( fileDescriptor < 0 )
+	{
+		return lastStatusCode = ( errno == ENOSPC ) ? BTRIEVE_STATUS_CODE_DISKFULL : BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	// The run is only reached through the descriptor, so it goes away with it.
+	unlink ( path.c_str ( ) );
+
+	// If fdopen ( ) fails.
+	if ( ( *file = fdopen ( fileDescriptor, "w+b" ) ) == NULL )
+	{
+		close ( fileDescriptor );
+		return lastStatusCode = BTRIEVE_STATUS_CODE_IO_ERROR;
+	}
+
+	setvbuf ( *file, NULL, _IOFBF, ENGINE_SORT_BLOCK_BYTES );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t EntrySorter::CreateRunFile
+
+
+btrieve_status_code_t EntrySorter::SpillBuffer ( )
+{
+	Run run;
+	btrieve_status_code_t status;
+
+	SortBuffer ( );
+
+	// If CreateRunFile ( ) fails.
+	if ( ( status = CreateRunFile ( &run.file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	for ( size_t i = 0; i < order.size ( ); i++ )
+	{
+		// If fwrite ( ) fails.
+		if ( fwrite ( &buffer [ ( size_t ) order [ i ] * stride ], stride, 1, run.file ) != 1 )
+		{
+			fclose ( run.file );
+			return lastStatusCode = ( errno == ENOSPC ) ? BTRIEVE_STATUS_CODE_DISKFULL : BTRIEVE_STATUS_CODE_IO_ERROR;
+		}
+	}
+
+	run.remaining = order.size ( );
+	run.blockPosition = 0;
+	run.blockLength = 0;
+	runs.push_back ( run );
+	spilledRuns++;
+	buffer.clear ( );
+	order.clear ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t EntrySorter::SpillBuffer
+
+
+// Rewind a run and read its first entry into heads.
+bool EntrySorter::StartRun ( Run* run )
+{
+	// If fflush ( ) or fseek ( ) fails.
+	if ( fflush ( run->file ) != 0 || fseek ( run->file, 0, SEEK_SET ) != 0 )
+	{
+		lastStatusCode = BTRIEVE_STATUS_CODE_IO_ERROR;
+		return false;
+	}
+
+	run->block.resize ( ( ENGINE_SORT_BLOCK_BYTES / stride ) * stride );
+	run->blockPosition = 0;
+	run->blockLength = 0;
+	return true;
+}	// bool EntrySorter::StartRun
+
+
+// Return the next entry of a run, or NULL at its end or on an error.
+const uint8_t* EntrySorter::ReadRun ( Run* run )
+{
+	const uint8_t* entry;
+
+	// If the run is exhausted.
+	if ( run->remaining == 0 )
+	{
+		return NULL;
+	}
+
+	// If the block is used up, read the next one.
+	if ( run->blockPosition >= run->blockLength )
+	{
+		size_t entries = run->block.size ( ) / stride;
+
+		entries = ( run->remaining < entries ) ? ( size_t ) run->remaining : entries;
+
+		// If fread ( ) fails.
+		if ( fread ( &run->block [ 0 ], stride, entries, run->file ) != entries )
+		{
+			lastStatusCode = BTRIEVE_STATUS_CODE_IO_ERROR;
+			return NULL;
+		}
+
+		run->blockPosition = 0;
+		run->blockLength = entries * stride;
+	}	// if ( run->blockPosition >= run->blockLength )
+
+	entry = &run->block [ run->blockPosition ];
+	run->blockPosition += stride;
+	run->remaining--;
+	return entry;
+}	// const uint8_t* EntrySorter::ReadRun
+
+
+void EntrySorter::PushHeap ( size_t run )
+{
+	HeapOrder greater = { this, &heads, &EntrySorter::Compare };
+
+	heap.push_back ( run );
+	std::push_heap ( heap.begin ( ), heap.end ( ), greater );
+}	// void EntrySorter::PushHeap
+
+
+size_t EntrySorter::PopHeap ( )
+{
+	HeapOrder greater = { this, &heads, &EntrySorter::Compare };
+	size_t run;
+
+	std::pop_heap ( heap.begin ( ), heap.end ( ), greater );
+	run = heap.back ( );
+	heap.pop_back ( );
+	return run;
+}	// size_t EntrySorter::PopHeap
+
+
+// Merge runs first to last - 1 into output.
+btrieve_status_code_t EntrySorter::MergeRuns ( size_t first, size_t last, FILE* output, uint64_t* written )
+{
+	heap.clear ( );
+	heads.assign ( runs.size ( ), NULL );
+	*written = 0;
+
+	for ( size_t i = first; i < last; i++ )
+	{
+		// If StartRun ( ) fails.
+		if ( !StartRun ( &runs [ i ] ) )
+		{
+			return lastStatusCode;
+		}
+
+		// If the run has an entry.
+		if ( ( heads [ i ] = ReadRun ( &runs [ i ] ) ) != NULL )
+		{
+			PushHeap ( i );
+		}
+		else if ( lastStatusCode != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return lastStatusCode;
+		}
+	}	// for ( size_t i = first; i < last; i++ )
+
+	while ( !heap.empty ( ) )
+	{
+		size_t run = PopHeap ( );
+
+		// If fwrite ( ) fails.
+		if ( fwrite ( heads [ run ], stride, 1, output ) != 1 )
+		{
+			return lastStatusCode = ( errno == ENOSPC ) ? BTRIEVE_STATUS_CODE_DISKFULL : BTRIEVE_STATUS_CODE_IO_ERROR;
+		}
+
+		( *written )++;
+
+		// If the run has another entry.
+		if ( ( heads [ run ] = ReadRun ( &runs [ run ] ) ) != NULL )
+		{
+			PushHeap ( run );
+		}
+		else if ( lastStatusCode != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return lastStatusCode;
+		}
+	}	// while ( !heap.empty ( ) )
+
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t EntrySorter::MergeRuns
+
+
+btrieve_status_code_t EntrySorter::Finish ( )
+{
+	btrieve_status_code_t status;
+
+	// If nothing was spilled, the buffer is sorted in place and read back directly.
+	if ( runs.empty ( ) )
+	{
+		SortBuffer ( );
+		return BTRIEVE_STATUS_CODE_NO_ERROR;
+	}
+
+	// If SpillBuffer ( ) fails.
+	if ( !buffer.empty ( ) && ( status = SpillBuffer ( ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+	{
+		return status;
+	}
+
+	// Release the buffer before the merge reads blocks.
+	std::vector<uint8_t> ( ).swap ( buffer );
+	std::vector<uint32_t> ( ).swap ( order );
+
+	// While there are too many runs to merge at once, merge the oldest into one.
+	while ( runs.size ( ) > ENGINE_SORT_MAXIMUM_FAN_IN )
+	{
+		Run merged;
+
+		// If CreateRunFile ( ) fails.
+		if ( ( status = CreateRunFile ( &merged.file ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return status;
+		}
+
+		// If MergeRuns ( ) fails.
+		if ( ( status = MergeRuns ( 0, ENGINE_SORT_MAXIMUM_FAN_IN, merged.file, &merged.remaining ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			fclose ( merged.file );
+			return status;
+		}
+
+		for ( size_t i = 0; i < ENGINE_SORT_MAXIMUM_FAN_IN; i++ )
+		{
+			fclose ( runs [ i ].file );
+		}
+
+		runs.erase ( runs.begin ( ), runs.begin ( ) + ENGINE_SORT_MAXIMUM_FAN_IN );
+		merged.blockPosition = 0;
+		merged.blockLength = 0;
+		runs.push_back ( merged );
+	}	// while ( runs.size ( ) > ENGINE_SORT_MAXIMUM_FAN_IN )
+
+	heap.clear ( );
+	heads.assign ( runs.size ( ), NULL );
+
+	for ( size_t i = 0; i < runs.size ( ); i++ )
+	{
+		// If StartRun ( ) fails.
+		if ( !StartRun ( &runs [ i ] ) )
+		{
+			return lastStatusCode;
+		}
+
+		// If the run has an entry.
+		if ( ( heads [ i ] = ReadRun ( &runs [ i ] ) ) != NULL )
+		{
+			PushHeap ( i );
+		}
+		else if ( lastStatusCode != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return lastStatusCode;
+		}
+	}	// for ( size_t i = 0; i < runs.size ( ); i++ )
+
+	merging = true;
+	pendingRun = runs.size ( );
+	return BTRIEVE_STATUS_CODE_NO_ERROR;
+}	// btrieve_status_code_t EntrySorter::Finish
+
+
+bool EntrySorter::Next ( const uint8_t** entry )
+{
+	// If the entries never left memory.
+	if ( !merging )
+	{
+		// If the buffer is used up.
+		if ( orderPosition >= order.size ( ) )
+		{
+			return false;
+		}
+
+		*entry = &buffer [ ( size_t ) order [ orderPosition++ ] * stride ];
+		return true;
+	}	// if ( !merging )
+
+	// The run of the entry handed out last time advances only now, so that entry stayed valid.
+	if ( pendingRun < runs.size ( ) )
+	{
+		// If the run has another entry.
+		if ( ( heads [ pendingRun ] = ReadRun ( &runs [ pendingRun ] ) ) != NULL )
+		{
+			PushHeap ( pendingRun );
+		}
+		else if ( lastStatusCode != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return false;
+		}
+	}	// if ( pendingRun < runs.size ( ) )
+
+	// If every run is exhausted.
+	if ( heap.empty ( ) )
+	{
+		pendingRun = runs.size ( );
+		return false;
+	}
+
+	pendingRun = PopHeap ( );
+	*entry = heads [ pendingRun ];
+	return true;
+}	// bool EntrySorter::Next
+
+
+
+// Orders sorters in a min-heap by their current entries, reversed as HeapOrder is.
+struct MergerOrder
+{
+	const IndexDefinition* definition;
+	const std::vector<const uint8_t*>* heads;
+
+	bool operator() ( size_t left, size_t right ) const
+	{
+		return CompareEntries ( *definition, ( *heads ) [ left ], ( *heads ) [ right ] ) > 0;
+	}
+};	// struct MergerOrder
+
+
+EntryMerger::EntryMerger ( const IndexDefinition& definitionIn, const std::vector<EntrySorter*>& sortersIn, IndexBuildProgress* progressIn )
+	: definition ( definitionIn ),
+	  sorters ( sortersIn ),
+	  progress ( progressIn ),
+	  stride ( definitionIn.keyLength + sizeof ( uint64_t ) ),
+	  pendingSorter ( sortersIn.size ( ) ),
+	  started ( false ),
+	  filled ( -1 ),
+	  reading ( -1 ),
+	  readPosition ( 0 ),
+	  stopping ( false ),
+	  loaded ( 0 ),
+	  lastStatusCode ( BTRIEVE_STATUS_CODE_NO_ERROR )
+{
+}	// EntryMerger::EntryMerger
+
+
+EntryMerger::~EntryMerger ( )
+{
+	// If the merge thread runs, stop it.
+	if ( thread.joinable ( ) )
+	{
+		{
+			std::lock_guard<std::mutex> guard ( latch );
+
+			stopping = true;
+			changed.notify_all ( );
+		}
+
+		thread.join ( );
+	}
+}	// EntryMerger::~EntryMerger
+
+
+// Point entry at the next entry of the merge; false at the end, or on an error.
+bool EntryMerger::MergeNext ( const uint8_t** entry )
+{
+	MergerOrder greater = { &definition, &heads };
+
+	// If the merge is starting, take the first entry of every sorter.
+	if ( !started )
+	{
+		started = true;
+		heads.assign ( sorters.size ( ), NULL );
+
+		for ( size_t i = 0; i < sorters.size ( ); i++ )
+		{
+			// If the sorter has an entry.
+			if ( sorters [ i ]->Next ( &heads [ i ] ) )
+			{
+				heap.push_back ( i );
+				std::push_heap ( heap.begin ( ), heap.end ( ), greater );
+			}
+			else if ( ( lastStatusCode = sorters [ i ]->GetLastStatusCode ( ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+			{
+				return false;
+			}
+		}
+	}
+	else if ( pendingSorter < sorters.size ( ) )
+	{
+		// The sorter of the entry handed out last time advances only now, so that entry stayed valid.
+		if ( sorters [ pendingSorter ]->Next ( &heads [ pendingSorter ] ) )
+		{
+			heap.push_back ( pendingSorter );
+			std::push_heap ( heap.begin ( ), heap.end ( ), greater );
+		}
+		else if ( ( lastStatusCode = sorters [ pendingSorter ]->GetLastStatusCode ( ) ) != BTRIEVE_STATUS_CODE_NO_ERROR )
+		{
+			return false;
+		}
+	}	// if ( !started )
+
+	// If every sorter is exhausted.
+	if ( heap.empty ( ) )
+	{
+		pendingSorter = sorters.size ( );
+		return false;
+	}
+
+	std::pop_heap ( heap.begin ( ), heap.end ( ), greater );
+	pendingSorter = heap.back ( );
+	heap.pop_back ( );
+	*entry = heads [ pendingSorter ];
+	return true;
+}	// bool EntryMerger::MergeNext
+
+
+// The merge thread: fill the blocks in turn, each once the reader is done with it.
+void EntryMerger::FillBlocks ( )
+{
+	for ( int next = 0; ; next = 1 - next )
+	{
+		Block* block = &blocks [ next ];
+		const uint8_t* entry;
+
+		{
+			std::unique_lock<std::mutex> guard ( latch );
+
+			while ( !stopping && ( reading == next || filled == next ) )
+			{
+				changed.wait ( guard );
+			}
+
+			// If the reader went away.
+			if ( stopping )
+			{
+				return;
+			}
+		}
+
+		block->entries.resize ( ( size_t ) ENGINE_MERGE_BLOCK_ENTRIES * stride );
+		block->count = 0;
+
+		while ( block->count < ENGINE_MERGE_BLOCK_ENTRIES && MergeNext ( &entry ) )
+		{
+			memcpy ( &block->entries [ block->count * stride ], entry, stride );
+			block->count++;
+		}
+
+		block->last = ( block->count < ENGINE_MERGE_BLOCK_ENTRIES );
+
+		std::unique_lock<std::mutex> guard ( latch );
+
+		while ( !stopping && filled >= 0 )
+		{
+			changed.wait ( guard );
+		}
+
+		filled = next;
+		changed.notify_all ( );
+
+		// If the merge ended, with this block.
+		if ( block->last )
+		{
+			return;
+		}
+	}	// for ( int next = 0; ; next = 1 - next )
+}	// void EntryMerger::FillBlocks
+
+
+// Hand the block the reader holds back, and wait for the next; false after the last.
+bool EntryMerger::TakeBlock ( )
+{
+	std::unique_lock<std::mutex> guard ( latch );
+
+	// If the block held was the last.
+	if ( reading >= 0 && blocks [ reading ].last )
+	{
+		return false;
+	}
+
+	reading = -1;
+	changed.notify_all ( );
+
+	while ( filled < 0 )
+	{
+		changed.wait ( guard );
+	}
+
+	reading = filled;
+	filled = -1;
+	readPosition = 0;
+	changed.notify_all ( );
+	return blocks [ reading ].count > 0;
+}	// bool EntryMerger::TakeBlock
+
+
+bool EntryMerger::Next ( const uint8_t** entry )
+{
+	// A lone sorter needs no merge, nor a thread.
+	if ( sorters.size ( ) <= 1 )
+	{
+		// If the sorter is exhausted.
+		if ( sorters.empty ( ) || !sorters [ 0 ]->Next ( entry ) )
+		{
+			lastStatusCode = sorters.empty ( ) ? BTRIEVE_STATUS_CODE_NO_ERROR : sorters [ 0 ]->GetLastStatusCode ( );
+			return false;
+		}
+	}
+	else
+	{
+		// If the merge hasn't started, start its thread.
+		if ( !thread.joinable ( ) )
+		{
+			thread = std::thread ( &EntryMerger::FillBlocks, this );
+		}
+
+		// If the block held is used up, and there's no next one.
+		if ( ( reading < 0 || readPosition >= blocks [ reading ].count ) && !TakeBlock ( ) )
+		{
+			return false;
+		}
+
+		*entry = &blocks [ reading ].entries [ readPosition * stride ];
+		readPosition++;
+	}	// if ( sorters.size ( ) <= 1 )
+
+	// If a block's worth more were handed out, say so.
+	if ( ++loaded % ENGINE_MERGE_BLOCK_ENTRIES == 0 && progress != NULL )
+	{
+		progress->SetEntriesLoaded ( loaded );
+	}
+
+	return true;
+}	// bool EntryMerger::Next
+
+}	// namespace BtrieveEngine
@@ -0,0 +1,152 @@
+// sorter.h : External sort of index entries for the bottom-up index build
+//            of the in-process engine.
+//
+// Entries are a key followed by the record's cursor position, the layout
+// of a leaf entry, and are ordered like leaf entries. Entries accumulate
+// in memory up to a budget; each time the budget fills, the entries are
+// sorted and spilled to an unlinked temporary file as a run. The runs are
+// then merged, in several passes if there are too many to merge at once.
+//
+// A parallel build gives each thread a sorter of its own, and an
+// EntryMerger merges the finished sorters into the one stream the build
+// reads. With more than one sorter the merge runs on a thread of its own,
+// a block of entries ahead of the reader, so it overlaps the leaf build.
+//
+
+#ifndef _BTRIEVE_ENGINE_SORTER_H
+#define _BTRIEVE_ENGINE_SORTER_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <btrieveC.h>
+
+#include "keys.h"
+
+namespace BtrieveEngine
+{
+
+#define ENGINE_DEFAULT_SORT_BYTES ( 64 * 1024 * 1024 )
+#define ENGINE_MINIMUM_SORT_ENTRIES 1024
+#define ENGINE_SORT_MAXIMUM_FAN_IN 64
+#define ENGINE_SORT_BLOCK_BYTES ( 256 * 1024 )
+#define ENGINE_MERGE_BLOCK_ENTRIES 4096
+
+// Return the memory budget of an index build: BTRIEVE_ENGINE_SORT_BYTES
+// from the environment if it's set, else ENGINE_DEFAULT_SORT_BYTES.
+size_t GetSortMemoryBudget ( );
+
+
+class EntrySorter
+{
+public:
+	EntrySorter ( const IndexDefinition& definition, size_t memoryBytes );
+	~EntrySorter ( );
+
+	btrieve_status_code_t Add ( const uint8_t* key, uint64_t address );
+
+	// Sort what's left in memory and prepare the merge; call once, after the last Add.
+	btrieve_status_code_t Finish ( );
+
+	// Point entry at the next entry in order; it stays valid until the
+	// next call. Returns false at the end, or on an I/O error.
+	bool Next ( const uint8_t** entry );
+
+	btrieve_status_code_t GetLastStatusCode ( ) const { return lastStatusCode; }
+	uint64_t GetCount ( ) const { return count; }
+	size_t GetSpilledRunCount ( ) const { return spilledRuns; }
+
+private:
+	struct Run
+	{
+		FILE* file;
+		uint64_t remaining;
+		std::vector<uint8_t> block;
+		size_t blockPosition;
+		size_t blockLength;
+	};	// struct Run
+
+	int Compare ( const uint8_t* left, const uint8_t* right ) const;
+	void SortBuffer ( );
+	btrieve_status_code_t SpillBuffer ( );
+	btrieve_status_code_t CreateRunFile ( FILE** file );
+	bool StartRun ( Run* run );
+	const uint8_t* ReadRun ( Run* run );
+	btrieve_status_code_t MergeRuns ( size_t first, size_t last, FILE* output, uint64_t* written );
+	void PushHeap ( size_t run );
+	size_t PopHeap ( );
+
+	const IndexDefinition& definition;
+	size_t stride;
+	size_t capacity;
+	uint64_t count;
+	size_t spilledRuns;
+	std::vector<uint8_t> buffer;
+	std::vector<uint32_t> order;
+	size_t orderPosition;
+	std::vector<Run> runs;
+	std::vector<size_t> heap;
+	std::vector<const uint8_t*> heads;
+	size_t pendingRun;
+	bool merging;
+	btrieve_status_code_t lastStatusCode;
+};	// class EntrySorter
+
+
+class IndexBuildProgress;
+
+class EntryMerger
+{
+public:
+	// The sorters must be finished, and outlive the merger; progress may be NULL.
+	EntryMerger ( const IndexDefinition& definition, const std::vector<EntrySorter*>& sorters, IndexBuildProgress* progress );
+	~EntryMerger ( );
+
+	// Point entry at the next entry in order, as EntrySorter::Next does.
+	bool Next ( const uint8_t** entry );
+
+	btrieve_status_code_t GetLastStatusCode ( ) const { return lastStatusCode; }
+
+private:
+	// A block of merged entries, back to back.
+	struct Block
+	{
+		std::vector<uint8_t> entries;
+		size_t count;
+		bool last;
+	};	// struct Block
+
+	bool MergeNext ( const uint8_t** entry );
+	void FillBlocks ( );
+	bool TakeBlock ( );
+
+	const IndexDefinition& definition;
+	std::vector<EntrySorter*> sorters;
+	IndexBuildProgress* progress;
+	size_t stride;
+	std::vector<const uint8_t*> heads;
+	std::vector<size_t> heap;
+	size_t pendingSorter;
+	bool started;
+
+	// The merge thread fills the block the reader doesn't hold.
+	std::thread thread;
+	std::mutex latch;
+	std::condition_variable changed;
+	Block blocks [ 2 ];
+	int filled;															// The block ready for the reader, or -1.
+	int reading;														// The block the reader holds, or -1.
+	size_t readPosition;
+	bool stopping;
+	uint64_t loaded;													// Entries handed to the reader.
+	btrieve_status_code_t lastStatusCode;
+};	// class EntryMerger
+
+}	// namespace BtrieveEngine
+
+#endif
@@ -0,0 +1,672 @@
+// strings.cpp : The ToString functions of the btrieveC.h interface.
+//
+
+#include <stddef.h>
+
+#include <btrieveC.h>
+
+namespace
+{
+
+struct EnumString
+{
+	int value;
+	const char* text;
+};	// struct EnumString
+
+
+const char* LookupString ( const EnumString* strings, size_t count, int value )
+{
+	for ( size_t i = 0; i < count; i++ )
+	{
+		// If this is the value.
+		if ( strings [ i ].value == value )
+		{
+			return strings [ i ].text;
+		}
+	}
+
+	return "Unknown";
+}	// const char* LookupString
+
+
+const EnumString aCSModeStrings [ ] =
+{
+	{ BTRIEVE_ACS_MODE_NONE, "None" },
+	{ BTRIEVE_ACS_MODE_NAMED, "Named" },
+	{ BTRIEVE_ACS_MODE_NUMBERED, "Numbered" },
+	{ BTRIEVE_ACS_MODE_CASE_INSENSITIVE, "Case insensitive" },
+	{ BTRIEVE_ACS_MODE_DEFAULT, "Default" },
+	{ BTRIEVE_ACS_MODE_UNKNOWN, "Unknown" },
+};	// aCSModeStrings
+
+
+const EnumString dataTypeStrings [ ] =
+{
+	{ BTRIEVE_DATA_TYPE_CHAR, "Char" },
+	{ BTRIEVE_DATA_TYPE_ZSTRING, "Zstring" },
+	{ BTRIEVE_DATA_TYPE_INTEGER, "Integer" },
+	{ BTRIEVE_DATA_TYPE_UNSIGNED_BINARY, "Unsigned binary" },
+	{ BTRIEVE_DATA_TYPE_FLOAT, "Float" },
+	{ BTRIEVE_DATA_TYPE_AUTOINCREMENT, "Autoincrement" },
+	{ BTRIEVE_DATA_TYPE_DATE, "Date" },
+	{ BTRIEVE_DATA_TYPE_NUMERICSTS, "Numericsts" },
+	{ BTRIEVE_DATA_TYPE_TIME, "Time" },
+	{ BTRIEVE_DATA_TYPE_NUMERICSA, "Numericsa" },
+	{ BTRIEVE_DATA_TYPE_DECIMAL, "Decimal" },
+	{ BTRIEVE_DATA_TYPE_CURRENCY, "Currency" },
+	{ BTRIEVE_DATA_TYPE_MONEY, "Money" },
+	{ BTRIEVE_DATA_TYPE_TIMESTAMP, "Timestamp" },
+	{ BTRIEVE_DATA_TYPE_LOGICAL, "Logical" },
+	{ BTRIEVE_DATA_TYPE_WSTRING, "Wstring" },
+	{ BTRIEVE_DATA_TYPE_NUMERIC, "Numeric" },
+	{ BTRIEVE_DATA_TYPE_WZSTRING, "Wzstring" },
+	{ BTRIEVE_DATA_TYPE_BFLOAT, "Bfloat" },
+	{ BTRIEVE_DATA_TYPE_GUID, "GUID" },
+	{ BTRIEVE_DATA_TYPE_LSTRING, "Lstring" },
+	{ BTRIEVE_DATA_TYPE_NULL_INDICATOR_SEGMENT, "Null indicator segment" },
+	{ BTRIEVE_DATA_TYPE_LEGACY_STRING, "Legacy string" },
+	{ BTRIEVE_DATA_TYPE_LEGACY_BINARY, "Legacy binary" },
+	{ BTRIEVE_DATA_TYPE_UNKNOWN, "Unknown" },
+};	// dataTypeStrings
+
+
+const EnumString duplicateModeStrings [ ] =
+{
+	{ BTRIEVE_DUPLICATE_MODE_NOT_ALLOWED, "Not allowed" },
+	{ BTRIEVE_DUPLICATE_MODE_ALLOWED_NONREPEATING, "Allowed nonrepeating" },
+	{ BTRIEVE_DUPLICATE_MODE_ALLOWED_REPEATING, "Allowed repeating" },
+	{ BTRIEVE_DUPLICATE_MODE_UNKNOWN, "Unknown" },
+};	// duplicateModeStrings
+
+
+const EnumString fileVersionStrings [ ] =
+{
+	{ BTRIEVE_FILE_VERSION_6_0, "6.0" },
+	{ BTRIEVE_FILE_VERSION_6_1, "6.1" },
+	{ BTRIEVE_FILE_VERSION_7_0, "7.0" },
+	{ BTRIEVE_FILE_VERSION_8_0, "8.0" },
+	{ BTRIEVE_FILE_VERSION_9_0, "9.0" },
+	{ BTRIEVE_FILE_VERSION_9_5, "9.5" },
+	{ BTRIEVE_FILE_VERSION_DEFAULT, "Default" },
+	{ BTRIEVE_FILE_VERSION_13_0, "13.0" },
+	{ BTRIEVE_FILE_VERSION_UNKNOWN, "Unknown" },
+};	// fileVersionStrings
+
+
+const EnumString freeSpaceThresholdStrings [ ] =
+{
+	{ BTRIEVE_FREE_SPACE_THRESHOLD_10_PERCENT, "10%" },
+	{ BTRIEVE_FREE_SPACE_THRESHOLD_20_PERCENT, "20%" },
+	{ BTRIEVE_FREE_SPACE_THRESHOLD_30_PERCENT, "30%" },
+	{ BTRIEVE_FREE_SPACE_THRESHOLD_DEFAULT, "Default" },
+	{ BTRIEVE_FREE_SPACE_THRESHOLD_UNKNOWN, "Unknown" },
+};	// freeSpaceThresholdStrings
+
+
+const EnumString indexStrings [ ] =
+{
+	{ BTRIEVE_INDEX_1, "Index 1" },
+	{ BTRIEVE_INDEX_2, "Index 2" },
+	{ BTRIEVE_INDEX_3, "Index 3" },
+	{ BTRIEVE_INDEX_4, "Index 4" },
+	{ BTRIEVE_INDEX_5, "Index 5" },
+	{ BTRIEVE_INDEX_6, "Index 6" },
+	{ BTRIEVE_INDEX_7, "Index 7" },
+	{ BTRIEVE_INDEX_8, "Index 8" },
+	{ BTRIEVE_INDEX_9, "Index 9" },
+	{ BTRIEVE_INDEX_10, "Index 10" },
+	{ BTRIEVE_INDEX_11, "Index 11" },
+	{ BTRIEVE_INDEX_12, "Index 12" },
+	{ BTRIEVE_INDEX_13, "Index 13" },
+	{ BTRIEVE_INDEX_14, "Index 14" },
+	{ BTRIEVE_INDEX_15, "Index 15" },
+	{ BTRIEVE_INDEX_16, "Index 16" },
+	{ BTRIEVE_INDEX_17, "Index 17" },
+	{ BTRIEVE_INDEX_18, "Index 18" },
+	{ BTRIEVE_INDEX_19, "Index 19" },
+	{ BTRIEVE_INDEX_20, "Index 20" },
+	{ BTRIEVE_INDEX_21, "Index 21" },
+	{ BTRIEVE_INDEX_22, "Index 22" },
+	{ BTRIEVE_INDEX_23, "Index 23" },
+	{ BTRIEVE_INDEX_24, "Index 24" },
+	{ BTRIEVE_INDEX_25, "Index 25" },
+	{ BTRIEVE_INDEX_26, "Index 26" },
+	{ BTRIEVE_INDEX_27, "Index 27" },
+	{ BTRIEVE_INDEX_28, "Index 28" },
+	{ BTRIEVE_INDEX_29, "Index 29" },
+	{ BTRIEVE_INDEX_30, "Index 30" },
+	{ BTRIEVE_INDEX_31, "Index 31" },
+	{ BTRIEVE_INDEX_32, "Index 32" },
+	{ BTRIEVE_INDEX_33, "Index 33" },
+	{ BTRIEVE_INDEX_34, "Index 34" },
+	{ BTRIEVE_INDEX_35, "Index 35" },
+	{ BTRIEVE_INDEX_36, "Index 36" },
+	{ BTRIEVE_INDEX_37, "Index 37" },
+	{ BTRIEVE_INDEX_38, "Index 38" },
+	{ BTRIEVE_INDEX_39, "Index 39" },
+	{ BTRIEVE_INDEX_40, "Index 40" },
+	{ BTRIEVE_INDEX_41, "Index 41" },
+	{ BTRIEVE_INDEX_42, "Index 42" },
+	{ BTRIEVE_INDEX_43, "Index 43" },
+	{ BTRIEVE_INDEX_44, "Index 44" },
+	{ BTRIEVE_INDEX_45, "Index 45" },
+	{ BTRIEVE_INDEX_46, "Index 46" },
+	{ BTRIEVE_INDEX_47, "Index 47" },
+	{ BTRIEVE_INDEX_48, "Index 48" },
+	{ BTRIEVE_INDEX_49, "Index 49" },
+	{ BTRIEVE_INDEX_50, "Index 50" },
+	{ BTRIEVE_INDEX_51, "Index 51" },
+	{ BTRIEVE_INDEX_52, "Index 52" },
+	{ BTRIEVE_INDEX_53, "Index 53" },
+	{ BTRIEVE_INDEX_54, "Index 54" },
+	{ BTRIEVE_INDEX_55, "Index 55" },
+	{ BTRIEVE_INDEX_56, "Index 56" },
+	{ BTRIEVE_INDEX_57, "Index 57" },
+	{ BTRIEVE_INDEX_58, "Index 58" },
+	{ BTRIEVE_INDEX_59, "Index 59" },
+	{ BTRIEVE_INDEX_60, "Index 60" },
+	{ BTRIEVE_INDEX_61, "Index 61" },
+	{ BTRIEVE_INDEX_62, "Index 62" },
+	{ BTRIEVE_INDEX_63, "Index 63" },
+	{ BTRIEVE_INDEX_64, "Index 64" },
+	{ BTRIEVE_INDEX_65, "Index 65" },
+	{ BTRIEVE_INDEX_66, "Index 66" },
+	{ BTRIEVE_INDEX_67, "Index 67" },
+	{ BTRIEVE_INDEX_68, "Index 68" },
+	{ BTRIEVE_INDEX_69, "Index 69" },
+	{ BTRIEVE_INDEX_70, "Index 70" },
+	{ BTRIEVE_INDEX_71, "Index 71" },
+	{ BTRIEVE_INDEX_72, "Index 72" },
+	{ BTRIEVE_INDEX_73, "Index 73" },
+	{ BTRIEVE_INDEX_74, "Index 74" },
+	{ BTRIEVE_INDEX_75, "Index 75" },
+	{ BTRIEVE_INDEX_76, "Index 76" },
+	{ BTRIEVE_INDEX_77, "Index 77" },
+	{ BTRIEVE_INDEX_78, "Index 78" },
+	{ BTRIEVE_INDEX_79, "Index 79" },
+	{ BTRIEVE_INDEX_80, "Index 80" },
+	{ BTRIEVE_INDEX_81, "Index 81" },
+	{ BTRIEVE_INDEX_82, "Index 82" },
+	{ BTRIEVE_INDEX_83, "Index 83" },
+	{ BTRIEVE_INDEX_84, "Index 84" },
+	{ BTRIEVE_INDEX_85, "Index 85" },
+	{ BTRIEVE_INDEX_86, "Index 86" },
+	{ BTRIEVE_INDEX_87, "Index 87" },
+	{ BTRIEVE_INDEX_88, "Index 88" },
+	{ BTRIEVE_INDEX_89, "Index 89" },
+	{ BTRIEVE_INDEX_90, "Index 90" },
+	{ BTRIEVE_INDEX_91, "Index 91" },
+	{ BTRIEVE_INDEX_92, "Index 92" },
+	{ BTRIEVE_INDEX_93, "Index 93" },
+	{ BTRIEVE_INDEX_94, "Index 94" },
+	{ BTRIEVE_INDEX_95, "Index 95" },
+	{ BTRIEVE_INDEX_96, "Index 96" },
+	{ BTRIEVE_INDEX_97, "Index 97" },
+	{ BTRIEVE_INDEX_98, "Index 98" },
+	{ BTRIEVE_INDEX_99, "Index 99" },
+	{ BTRIEVE_INDEX_100, "Index 100" },
+	{ BTRIEVE_INDEX_101, "Index 101" },
+	{ BTRIEVE_INDEX_102, "Index 102" },
+	{ BTRIEVE_INDEX_103, "Index 103" },
+	{ BTRIEVE_INDEX_104, "Index 104" },
+	{ BTRIEVE_INDEX_105, "Index 105" },
+	{ BTRIEVE_INDEX_106, "Index 106" },
+	{ BTRIEVE_INDEX_107, "Index 107" },
+	{ BTRIEVE_INDEX_108, "Index 108" },
+	{ BTRIEVE_INDEX_109, "Index 109" },
+	{ BTRIEVE_INDEX_110, "Index 110" },
+	{ BTRIEVE_INDEX_111, "Index 111" },
+	{ BTRIEVE_INDEX_112, "Index 112" },
+	{ BTRIEVE_INDEX_113, "Index 113" },
+	{ BTRIEVE_INDEX_114, "Index 114" },
+	{ BTRIEVE_INDEX_115, "Index 115" },
+	{ BTRIEVE_INDEX_116, "Index 116" },
+	{ BTRIEVE_INDEX_117, "Index 117" },
+	{ BTRIEVE_INDEX_118, "Index 118" },
+	{ BTRIEVE_INDEX_119, "Index 119" },
+	{ BTRIEVE_INDEX_SYSTEM, "System" },
+	{ BTRIEVE_INDEX_NONE, "None" },
+	{ BTRIEVE_INDEX_UNKNOWN, "Unknown" },
+};	// indexStrings
+
+
+const EnumString lockModeStrings [ ] =
+{
+	{ BTRIEVE_LOCK_MODE_NONE, "None" },
+	{ BTRIEVE_LOCK_MODE_SINGLE_WAIT, "Single wait" },
+	{ BTRIEVE_LOCK_MODE_SINGLE_NO_WAIT, "Single no wait" },
+	{ BTRIEVE_LOCK_MODE_MULTIPLE_WAIT, "Multiple wait" },
+	{ BTRIEVE_LOCK_MODE_MULTIPLE_NO_WAIT, "Multiple no wait" },
+	{ BTRIEVE_LOCK_MODE_UNKNOWN, "Unknown" },
+};	// lockModeStrings
+
+
+const EnumString nullKeyModeStrings [ ] =
+{
+	{ BTRIEVE_NULL_KEY_MODE_ALL_SEGMENTS, "All segments" },
+	{ BTRIEVE_NULL_KEY_MODE_ANY_SEGMENTS, "Any segments" },
+	{ BTRIEVE_NULL_KEY_MODE_NONE, "None" },
+	{ BTRIEVE_NULL_KEY_MODE_UNKNOWN, "Unknown" },
+};	// nullKeyModeStrings
+
+
+const EnumString ownerModeStrings [ ] =
+{
+	{ BTRIEVE_OWNER_MODE_NONE, "None" },
+	{ BTRIEVE_OWNER_MODE_NO_ENCRYPTION_NO_READ_ALLOWED, "No encryption no read allowed" },
+	{ BTRIEVE_OWNER_MODE_NO_ENCRYPTION_READ_ALLOWED, "No encryption read allowed" },
+	{ BTRIEVE_OWNER_MODE_ENCRYPTION_NO_READ_ALLOWED, "Encryption no read allowed" },
+	{ BTRIEVE_OWNER_MODE_ENCRYPTION_READ_ALLOWED, "Encryption read allowed" },
+	{ BTRIEVE_OWNER_MODE_UNKNOWN, "Unknown" },
+};	// ownerModeStrings
+
+
+const EnumString pageLockTypeStrings [ ] =
+{
+	{ BTRIEVE_PAGE_LOCK_TYPE_NONE, "None" },
+	{ BTRIEVE_PAGE_LOCK_TYPE_DATA_PAGE, "Data page" },
+	{ BTRIEVE_PAGE_LOCK_TYPE_INDEX_PAGE, "Index page" },
+	{ BTRIEVE_PAGE_LOCK_TYPE_VARIABLE_PAGE, "Variable page" },
+	{ BTRIEVE_PAGE_LOCK_TYPE_UNKNOWN, "Unknown" },
+};	// pageLockTypeStrings
+
+
+const EnumString pageSizeStrings [ ] =
+{
+	{ BTRIEVE_PAGE_SIZE_512, "512" },
+	{ BTRIEVE_PAGE_SIZE_1024, "1024" },
+	{ BTRIEVE_PAGE_SIZE_1536, "1536" },
+	{ BTRIEVE_PAGE_SIZE_2048, "2048" },
+	{ BTRIEVE_PAGE_SIZE_3072, "3072" },
+	{ BTRIEVE_PAGE_SIZE_3584, "3584" },
+	{ BTRIEVE_PAGE_SIZE_4096, "4096" },
+	{ BTRIEVE_PAGE_SIZE_8192, "8192" },
+	{ BTRIEVE_PAGE_SIZE_16384, "16384" },
+	{ BTRIEVE_PAGE_SIZE_DEFAULT, "Default" },
+	{ BTRIEVE_PAGE_SIZE_UNKNOWN, "Unknown" },
+};	// pageSizeStrings
+
+
+const EnumString recordCompressionModeStrings [ ] =
+{
+	{ BTRIEVE_RECORD_COMPRESSION_MODE_NONE, "None" },
+	{ BTRIEVE_RECORD_COMPRESSION_MODE_BLANK_TRUNCATION, "Blank truncation" },
+	{ BTRIEVE_RECORD_COMPRESSION_MODE_RUN_LENGTH_ENCODING, "Run length encoding" },
+	{ BTRIEVE_RECORD_COMPRESSION_MODE_UNKNOWN, "Unknown" },
+};	// recordCompressionModeStrings
+
+
+const EnumString statusCodeStrings [ ] =
+{
+	{ BTRIEVE_STATUS_CODE_NO_ERROR, "No error" },
+	{ BTRIEVE_STATUS_CODE_INVALID_FUNCTION, "Invalid function" },
+	{ BTRIEVE_STATUS_CODE_IO_ERROR, "I/O error" },
+	{ BTRIEVE_STATUS_CODE_FILE_NOT_OPEN, "File not open" },
+	{ BTRIEVE_STATUS_CODE_KEY_VALUE_NOT_FOUND, "Key value not found" },
+	{ BTRIEVE_STATUS_CODE_DUPLICATE_KEY_VALUE, "Duplicate key value" },
+	{ BTRIEVE_STATUS_CODE_INVALID_INDEX_NUMBER, "Invalid index number" },
+	{ BTRIEVE_STATUS_CODE_DIFFERENT_INDEX_NUMBER, "Different index number" },
+	{ BTRIEVE_STATUS_CODE_POSITION_NOT_SET, "Position not set" },
+	{ BTRIEVE_STATUS_CODE_END_OF_FILE, "End of file" },
+	{ BTRIEVE_STATUS_CODE_MODIFIABLE_KEYVALUE_ERROR, "Modifiable keyvalue error" },
+	{ BTRIEVE_STATUS_CODE_FILENAME_BAD, "Filename bad" },
+	{ BTRIEVE_STATUS_CODE_FILE_NOT_FOUND, "File not found" },
+	{ BTRIEVE_STATUS_CODE_EXTENDED_FILE_ERROR, "Extended file error" },
+	{ BTRIEVE_STATUS_CODE_PREIMAGE_OPEN_ERROR, "Preimage open error" },
+	{ BTRIEVE_STATUS_CODE_PREIMAGE_IO_ERROR, "Preimage I/O error" },
+	{ BTRIEVE_STATUS_CODE_EXPANSION_ERROR, "Expansion error" },
+	{ BTRIEVE_STATUS_CODE_CLOSE_ERROR, "Close error" },
+	{ BTRIEVE_STATUS_CODE_DISKFULL, "Diskfull" },
+	{ BTRIEVE_STATUS_CODE_UNRECOVERABLE_ERROR, "Unrecoverable error" },
+	{ BTRIEVE_STATUS_CODE_RECORD_MANAGER_INACTIVE, "Record manager inactive" },
+	{ BTRIEVE_STATUS_CODE_KEYBUFFER_TOO_SHORT, "Keybuffer too short" },
+	{ BTRIEVE_STATUS_CODE_DATALENGTH_ERROR, "Datalength error" },
+	{ BTRIEVE_STATUS_CODE_POSITIONBLOCK_LENGTH, "Positionblock length" },
+	{ BTRIEVE_STATUS_CODE_PAGE_SIZE_ERROR, "Page size error" },
+	{ BTRIEVE_STATUS_CODE_CREATE_IO_ERROR, "Create I/O error" },
+	{ BTRIEVE_STATUS_CODE_NUMBER_OF_INDEXES, "Number of indexes" },
+	{ BTRIEVE_STATUS_CODE_INVALID_KEY_POSITION, "Invalid key position" },
+	{ BTRIEVE_STATUS_CODE_INVALID_RECORD_LENGTH, "Invalid record length" },
+	{ BTRIEVE_STATUS_CODE_INVALID_KEYLENGTH, "Invalid keylength" },
+	{ BTRIEVE_STATUS_CODE_NOT_A_BTRIEVE_FILE, "Not a btrieve file" },
+	{ BTRIEVE_STATUS_CODE_FILE_ALREADY_EXTENDED, "File already extended" },
+	{ BTRIEVE_STATUS_CODE_EXTEND_IO_ERROR, "Extend I/O error" },
+	{ BTRIEVE_STATUS_CODE_BTR_CANNOT_UNLOAD, "BTR cannot unload" },
+	{ BTRIEVE_STATUS_CODE_INVALID_EXTENSION_NAME, "Invalid extension name" },
+	{ BTRIEVE_STATUS_CODE_DIRECTORY_ERROR, "Directory error" },
+	{ BTRIEVE_STATUS_CODE_TRANSACTION_ERROR, "Transaction error" },
+	{ BTRIEVE_STATUS_CODE_TRANSACTION_IS_ACTIVE, "Transaction is active" },
+	{ BTRIEVE_STATUS_CODE_TRANSACTION_FILE_IO_ERROR, "Transaction file I/O error" },
+	{ BTRIEVE_STATUS_CODE_END_TRANSACTION_ERROR, "End transaction error" },
+	{ BTRIEVE_STATUS_CODE_TRANSACTION_MAX_FILES, "Transaction max files" },
+	{ BTRIEVE_STATUS_CODE_OPERATION_NOT_ALLOWED, "Operation not allowed" },
+	{ BTRIEVE_STATUS_CODE_INCOMPLETE_ACCEL_ACCESS, "Incomplete accel access" },
+	{ BTRIEVE_STATUS_CODE_INVALID_RECORD_ADDRESS, "Invalid record address" },
+	{ BTRIEVE_STATUS_CODE_NULL_KEYPATH, "Null keypath" },
+	{ BTRIEVE_STATUS_CODE_INCONSISTENT_KEY_FLAGS, "Inconsistent key flags" },
+	{ BTRIEVE_STATUS_CODE_ACCESS_TO_FILE_DENIED, "Access to file denied" },
+	{ BTRIEVE_STATUS_CODE_MAXIMUM_OPEN_FILES, "Maximum open files" },
+	{ BTRIEVE_STATUS_CODE_INVALID_ALT_SEQUENCE_DEF, "Invalid alt sequence def" },
+	{ BTRIEVE_STATUS_CODE_KEY_TYPE_ERROR, "Key type error" },
+	{ BTRIEVE_STATUS_CODE_OWNER_ALREADY_SET, "Owner already set" },
+	{ BTRIEVE_STATUS_CODE_INVALID_OWNER, "Invalid owner" },
+	{ BTRIEVE_STATUS_CODE_ERROR_WRITING_CACHE, "Error writing cache" },
+	{ BTRIEVE_STATUS_CODE_INVALID_INTERFACE, "Invalid interface" },
+	{ BTRIEVE_STATUS_CODE_VARIABLE_PAGE_ERROR, "Variable page error" },
+	{ BTRIEVE_STATUS_CODE_AUTOINCREMENT_ERROR, "Autoincrement error" },
+	{ BTRIEVE_STATUS_CODE_INCOMPLETE_INDEX, "Incomplete index" },
+	{ BTRIEVE_STATUS_CODE_EXPANED_MEM_ERROR, "Expaned mem error" },
+	{ BTRIEVE_STATUS_CODE_COMPRESS_BUFFER_TOO_SHORT, "Compress buffer too short" },
+	{ BTRIEVE_STATUS_CODE_FILE_ALREADY_EXISTS, "File already exists" },
+	{ BTRIEVE_STATUS_CODE_REJECT_COUNT_REACHED, "Reject count reached" },
+	{ BTRIEVE_STATUS_CODE_SMALL_EX_GET_BUFFER_ERROR, "Small EX get buffer error" },
+	{ BTRIEVE_STATUS_CODE_INVALID_GET_EXPRESSION, "Invalid get expression" },
+	{ BTRIEVE_STATUS_CODE_INVALID_EXT_INSERT_BUFF, "Invalid ext insert buff" },
+	{ BTRIEVE_STATUS_CODE_OPTIMIZE_LIMIT_REACHED, "Optimize limit reached" },
+	{ BTRIEVE_STATUS_CODE_INVALID_EXTRACTOR, "Invalid extractor" },
+	{ BTRIEVE_STATUS_CODE_RI_TOO_MANY_DATABASES, "RI too many databases" },
+	{ BTRIEVE_STATUS_CODE_RIDDF_CANNOT_OPEN, "RIDDF cannot open" },
+	{ BTRIEVE_STATUS_CODE_RI_CASCADE_TOO_DEEP, "RI cascade too deep" },
+	{ BTRIEVE_STATUS_CODE_RI_CASCADE_ERROR, "RI cascade error" },
+	{ BTRIEVE_STATUS_CODE_RI_VIOLATION, "RI violation" },
+	{ BTRIEVE_STATUS_CODE_RI_REFERENCED_FILE_CANNOT_OPEN, "RI referenced file cannot open" },
+	{ BTRIEVE_STATUS_CODE_RI_OUT_OF_SYNC, "RI out of sync" },
+	{ BTRIEVE_STATUS_CODE_END_CHANGED_TO_ABORT, "End changed to abort" },
+	{ BTRIEVE_STATUS_CODE_RI_CONFLICT, "RI conflict" },
+	{ BTRIEVE_STATUS_CODE_CANT_LOOP_IN_SERVER, "Cant loop in server" },
+	{ BTRIEVE_STATUS_CODE_DEAD_LOCK, "Dead lock" },
+	{ BTRIEVE_STATUS_CODE_PROGRAMMING_ERROR, "Programming error" },
+	{ BTRIEVE_STATUS_CODE_CONFLICT, "Conflict" },
+	{ BTRIEVE_STATUS_CODE_LOCKERROR, "Lockerror" },
+	{ BTRIEVE_STATUS_CODE_LOST_POSITION, "Lost position" },
+	{ BTRIEVE_STATUS_CODE_READ_OUTSIDE_TRANSACTION, "Read outside transaction" },
+	{ BTRIEVE_STATUS_CODE_RECORD_INUSE, "Record inuse" },
+	{ BTRIEVE_STATUS_CODE_FILE_INUSE, "File inuse" },
+	{ BTRIEVE_STATUS_CODE_FILE_TABLE_FULL, "File table full" },
+	{ BTRIEVE_STATUS_CODE_NOHANDLES_AVAILABLE, "Nohandles available" },
+	{ BTRIEVE_STATUS_CODE_INCOMPATIBLE_MODE_ERROR, "Incompatible mode error" },
+	{ BTRIEVE_STATUS_CODE_DEVICE_TABLE_FULL, "Device table full" },
+	{ BTRIEVE_STATUS_CODE_SERVER_ERROR, "Server error" },
+	{ BTRIEVE_STATUS_CODE_TRANSACTION_TABLE_FULL, "Transaction table full" },
+	{ BTRIEVE_STATUS_CODE_INCOMPATIBLE_LOCK_TYPE, "Incompatible lock type" },
+	{ BTRIEVE_STATUS_CODE_PERMISSION_ERROR, "Permission error" },
+	{ BTRIEVE_STATUS_CODE_SESSION_NO_LONGER_VALID, "Session no longer valid" },
+	{ BTRIEVE_STATUS_CODE_COMMUNICATIONS_ERROR, "Communications error" },
+	{ BTRIEVE_STATUS_CODE_DATA_MESSAGE_TOO_SMALL, "Data message too small" },
+	{ BTRIEVE_STATUS_CODE_INTERNAL_TRANSACTION_ERROR, "Internal transaction error" },
+	{ BTRIEVE_STATUS_CODE_REQUESTER_CANT_ACCESS_RUNTIME, "Requester cant access runtime" },
+	{ BTRIEVE_STATUS_CODE_NO_CACHE_BUFFERS_AVAIL, "No cache buffers avail" },
+	{ BTRIEVE_STATUS_CODE_NO_OS_MEMORY_AVAIL, "No OS memory avail" },
+	{ BTRIEVE_STATUS_CODE_NO_STACK_AVAIL, "No stack avail" },
+	{ BTRIEVE_STATUS_CODE_CHUNK_OFFSET_TOO_LONG, "Chunk offset too long" },
+	{ BTRIEVE_STATUS_CODE_LOCALE_ERROR, "Locale error" },
+	{ BTRIEVE_STATUS_CODE_CANNOT_CREATE_WITH_VAT, "Cannot create with VAT" },
+	{ BTRIEVE_STATUS_CODE_CHUNK_CANNOT_GET_NEXT, "Chunk cannot get next" },
+	{ BTRIEVE_STATUS_CODE_CHUNK_INCOMPATIBLE_FILE, "Chunk incompatible file" },
+	{ BTRIEVE_STATUS_CODE_TRANSACTION_TOO_COMPLEX, "Transaction too complex" },
+	{ BTRIEVE_STATUS_CODE_ARCH_BLOG_OPEN_ERROR, "Arch blog open error" },
+	{ BTRIEVE_STATUS_CODE_ARCH_FILE_NOT_LOGGED, "Arch file not logged" },
+	{ BTRIEVE_STATUS_CODE_ARCH_FILE_IN_USE, "Arch file in use" },
+	{ BTRIEVE_STATUS_CODE_ARCH_LOGFILE_NOT_FOUND, "Arch logfile not found" },
+	{ BTRIEVE_STATUS_CODE_ARCH_LOGFILE_INVALID, "Arch logfile invalid" },
+	{ BTRIEVE_STATUS_CODE_ARCH_DUMPFILE_ACCESS_ERROR, "Arch dumpfile access error" },
+	{ BTRIEVE_STATUS_CODE_LOCATOR_FILE_INDICATOR, "Locator file indicator" },
+	{ BTRIEVE_STATUS_CODE_NO_SYSTEM_LOCKS_AVAILABLE, "No system locks available" },
+	{ BTRIEVE_STATUS_CODE_FILE_FULL, "File full" },
+	{ BTRIEVE_STATUS_CODE_MORE_THAN_5_CONCURRENT_USERS, "More than 5 concurrent users" },
+	{ BTRIEVE_STATUS_CODE_ISR_NOT_FOUND, "ISR not found" },
+	{ BTRIEVE_STATUS_CODE_ISR_INVALID, "ISR invalid" },
+	{ BTRIEVE_STATUS_CODE_ACS_NOT_FOUND, "ACS not found" },
+	{ BTRIEVE_STATUS_CODE_CANNOT_CONVERT_RP, "Cannot convert RP" },
+	{ BTRIEVE_STATUS_CODE_INVALID_NULL_INDICATOR, "Invalid null indicator" },
+	{ BTRIEVE_STATUS_CODE_INVALID_KEY_OPTION, "Invalid key option" },
+	{ BTRIEVE_STATUS_CODE_INCOMPATIBLE_CLOSE, "Incompatible close" },
+	{ BTRIEVE_STATUS_CODE_INVALID_USERNAME, "Invalid username" },
+	{ BTRIEVE_STATUS_CODE_INVALID_DATABASE, "Invalid database" },
+	{ BTRIEVE_STATUS_CODE_NO_SSQL_RIGHTS, "No ssql rights" },
+	{ BTRIEVE_STATUS_CODE_ALREADY_LOGGED_IN, "Already logged in" },
+	{ BTRIEVE_STATUS_CODE_NO_DATABASE_SERVICES, "No database services" },
+	{ BTRIEVE_STATUS_CODE_DUPLICATE_SYSTEM_KEY, "Duplicate system key" },
+	{ BTRIEVE_STATUS_CODE_LOG_SEGMENT_MISSING, "Log segment missing" },
+	{ BTRIEVE_STATUS_CODE_ROLL_FORWARD_ERROR, "Roll forward error" },
+	{ BTRIEVE_STATUS_CODE_SYSTEM_KEY_INTERNAL, "System key internal" },
+	{ BTRIEVE_STATUS_CODE_DBS_INTERNAL_ERROR, "Dbs internal error" },
+	{ BTRIEVE_STATUS_CODE_NESTING_DEPTH_ERROR, "Nesting depth error" },
+	{ BTRIEVE_STATUS_CODE_INVALID_PARAMETER_TO_MKDE, "Invalid parameter to MKDE" },
+	{ BTRIEVE_STATUS_CODE_USER_COUNT_LIMIT_EXCEEDED, "User count limit exceeded" },
+	{ BTRIEVE_STATUS_CODE_CLIENT_TABLE_FULL, "Client table full" },
+	{ BTRIEVE_STATUS_CODE_LAST_SEGMENT_ERROR, "Last segment error" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_FAILED_BAD_USERNAME, "Login failed bad username" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_FAILED_BAD_PASSWORD, "Login failed bad password" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_FAILED_BAD_DATABASE, "Login failed bad database" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_ALREADY_LOGGED_IN, "Login already logged in" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_LOGOUT_FAILED, "Login logout failed" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_WRONG_URI_FORMAT, "Login wrong URI format" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_FILE_AND_TABLE_NOT_FOUND, "Login file and table not found" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_TABLE_NOT_IN_DATABASE, "Login table not in database" },
+	{ BTRIEVE_STATUS_CODE_LOGIN_DIRECTORY_NOT_IN_DATABASE, "Login directory not in database" },
+	{ BTRIEVE_STATUS_CODE_LOCK_PARM_OUTOFRANGE, "Lock parm outofrange" },
+	{ BTRIEVE_STATUS_CODE_MEM_ALLOCATION_ERR, "Mem allocation err" },
+	{ BTRIEVE_STATUS_CODE_MEM_PARM_TOO_SMALL, "Mem parm too small" },
+	{ BTRIEVE_STATUS_CODE_PAGE_SIZE_PARM_OUTOFRANGE, "Page size parm outofrange" },
+	{ BTRIEVE_STATUS_CODE_INVALID_PREIMAGE_PARM, "Invalid preimage parm" },
+	{ BTRIEVE_STATUS_CODE_PREIMAGE_BUF_PARM_OUTOFRANGE, "Preimage buf parm outofrange" },
+	{ BTRIEVE_STATUS_CODE_FILES_PARM_OUTOFRANGE, "Files parm outofrange" },
+	{ BTRIEVE_STATUS_CODE_INVALID_INIT_PARM, "Invalid init parm" },
+	{ BTRIEVE_STATUS_CODE_INVALID_TRANS_PARM, "Invalid trans parm" },
+	{ BTRIEVE_STATUS_CODE_ERROR_ACC_TRANS_CONTROL_FILE, "Error acc trans control file" },
+	{ BTRIEVE_STATUS_CODE_COMPRESSION_BUF_PARM_OUTOFRANGE, "Compression buf parm outofrange" },
+	{ BTRIEVE_STATUS_CODE_INV_N_OPTION, "Inv n option" },
+	{ BTRIEVE_STATUS_CODE_TASK_LIST_FULL, "Task list full" },
+	{ BTRIEVE_STATUS_CODE_STOP_WARNING, "Stop warning" },
+	{ BTRIEVE_STATUS_CODE_POINTER_PARM_INVALID, "Pointer parm invalid" },
+	{ BTRIEVE_STATUS_CODE_ALREADY_INITIALIZED, "Already initialized" },
+	{ BTRIEVE_STATUS_CODE_REQ_CANT_FIND_RES_DLL, "Req cant find res DLL" },
+	{ BTRIEVE_STATUS_CODE_ALREADY_INSIDE_BTR_FUNCTION, "Already inside BTR function" },
+	{ BTRIEVE_STATUS_CODE_CALLBACK_ABORT, "Callback abort" },
+	{ BTRIEVE_STATUS_CODE_INTF_COMM_ERROR, "Intf comm error" },
+	{ BTRIEVE_STATUS_CODE_FAILED_TO_INITIALIZE, "Failed to initialize" },
+	{ BTRIEVE_STATUS_CODE_MKDE_SHUTTING_DOWN, "MKDE shutting down" },
+	{ BTRIEVE_STATUS_CODE_INTERNAL_ERROR, "Internal error" },
+	{ BTRIEVE_STATUS_CODE_INSUFFICIENT_MEM_ALLOC, "Insufficient mem alloc" },
+	{ BTRIEVE_STATUS_CODE_INVALID_OPTION, "Invalid option" },
+	{ BTRIEVE_STATUS_CODE_NO_LOCAL_ACCESS_ALLOWED, "No local access allowed" },
+	{ BTRIEVE_STATUS_CODE_SPX_NOT_INSTALLED, "SPX not installed" },
+	{ BTRIEVE_STATUS_CODE_INCORRECT_SPX_VERSION, "Incorrect SPX version" },
+	{ BTRIEVE_STATUS_CODE_NO_AVAIL_SPX_CONNECTION, "No avail SPX connection" },
+	{ BTRIEVE_STATUS_CODE_INVALID_PTR_PARM, "Invalid ptr parm" },
+	{ BTRIEVE_STATUS_CODE_CANT_CONNECT_TO_615, "Cant connect to 615" },
+	{ BTRIEVE_STATUS_CODE_CANT_LOAD_MKDE_ROUTER, "Cant load MKDE router" },
+	{ BTRIEVE_STATUS_CODE_UT_THUNK_NOT_LOADED, "Ut thunk not loaded" },
+	{ BTRIEVE_STATUS_CODE_NO_RESOURCE_DLL, "No resource DLL" },
+	{ BTRIEVE_STATUS_CODE_OS_ERROR, "OS error" },
+	{ BTRIEVE_STATUS_CODE_MK_ROUTER_MEM_ERROR, "Mk router mem error" },
+	{ BTRIEVE_STATUS_CODE_MK_NO_LOCAL_ACCESS_ALLOWED, "Mk no local access allowed" },
+	{ BTRIEVE_STATUS_CODE_MK_NO_RESOURCE_DLL, "Mk no resource DLL" },
+	{ BTRIEVE_STATUS_CODE_MK_INCOMPAT_COMPONENT, "Mk incompat component" },
+	{ BTRIEVE_STATUS_CODE_MK_TIMEOUT_ERROR, "Mk timeout error" },
+	{ BTRIEVE_STATUS_CODE_MK_OS_ERROR, "Mk OS error" },
+	{ BTRIEVE_STATUS_CODE_MK_INVALID_SESSION, "Mk invalid session" },
+	{ BTRIEVE_STATUS_CODE_MK_SERVER_NOT_FOUND, "Mk server not found" },
+	{ BTRIEVE_STATUS_CODE_MK_INVALID_CONFIG, "Mk invalid config" },
+	{ BTRIEVE_STATUS_CODE_MK_NETAPI_NOT_LOADED, "Mk netapi not loaded" },
+	{ BTRIEVE_STATUS_CODE_MK_NWAPI_NOT_LOADED, "Mk nwapi not loaded" },
+	{ BTRIEVE_STATUS_CODE_MK_THUNK_NOT_LOADED, "Mk thunk not loaded" },
+	{ BTRIEVE_STATUS_CODE_MK_LOCAL_NOT_LOADED, "Mk local not loaded" },
+	{ BTRIEVE_STATUS_CODE_MK_PNSL_NOT_LOADED, "Mk pnsl not loaded" },
+	{ BTRIEVE_STATUS_CODE_MK_CANT_FIND_ENGINE, "Mk cant find engine" },
+	{ BTRIEVE_STATUS_CODE_MK_INIT_ERROR, "Mk init error" },
+	{ BTRIEVE_STATUS_CODE_MK_INTERNAL_ERROR, "Mk internal error" },
+	{ BTRIEVE_STATUS_CODE_MK_LOCAL_MKDE_DATABUF_TOO_SMALL, "Mk local MKDE databuf too small" },
+	{ BTRIEVE_STATUS_CODE_MK_CLOSED_ERROR, "Mk closed error" },
+	{ BTRIEVE_STATUS_CODE_MK_SEMAPHORE_ERROR, "Mk semaphore error" },
+	{ BTRIEVE_STATUS_CODE_MK_LOADING_ERROR, "Mk loading error" },
+	{ BTRIEVE_STATUS_CODE_MK_BAD_SRB_FORMAT, "Mk bad srb format" },
+	{ BTRIEVE_STATUS_CODE_MK_DATABUF_LEN_TOO_LARGE, "Mk databuf len too large" },
+	{ BTRIEVE_STATUS_CODE_MK_TASK_TABLE_FULL, "Mk task table full" },
+	{ BTRIEVE_STATUS_CODE_MK_INVALID_OP_ON_REMOTE, "Mk invalid op on remote" },
+	{ BTRIEVE_STATUS_CODE_MK_PIDS_NOT_LOADED, "Mk pids not loaded" },
+	{ BTRIEVE_STATUS_CODE_MK_BAD_PIDS, "Mk bad pids" },
+	{ BTRIEVE_STATUS_CODE_MK_IDS_CONNECT_FAILURE, "Mk ids connect failure" },
+	{ BTRIEVE_STATUS_CODE_MK_IDS_LOGIN_FAILURE, "Mk ids login failure" },
+	{ BTRIEVE_STATUS_CODE_NL_FAILURE, "Nl failure" },
+	{ BTRIEVE_STATUS_CODE_NL_NOT_INITIALIZED, "Nl not initialized" },
+	{ BTRIEVE_STATUS_CODE_NL_NAME_NOT_FOUND, "Nl name not found" },
+	{ BTRIEVE_STATUS_CODE_NL_PERMISSION_ERROR, "Nl permission error" },
+	{ BTRIEVE_STATUS_CODE_NL_NO_AVAILABLE_TRANSPORT, "Nl no available transport" },
+	{ BTRIEVE_STATUS_CODE_NL_CONNECTION_FAILURE, "Nl connection failure" },
+	{ BTRIEVE_STATUS_CODE_NL_OUT_OF_MEMORY, "Nl out of memory" },
+	{ BTRIEVE_STATUS_CODE_NL_INVALID_SESSION, "Nl invalid session" },
+	{ BTRIEVE_STATUS_CODE_NL_MORE_DATA, "Nl more data" },
+	{ BTRIEVE_STATUS_CODE_NL_NOT_CONNECTED, "Nl not connected" },
+	{ BTRIEVE_STATUS_CODE_NL_SEND_FAILURE, "Nl send failure" },
+	{ BTRIEVE_STATUS_CODE_NL_RECEIVE_FAILURE, "Nl receive failure" },
+	{ BTRIEVE_STATUS_CODE_NL_INVALID_SERVER_TYPE, "Nl invalid server type" },
+	{ BTRIEVE_STATUS_CODE_NL_SRT_FULL, "Nl srt full" },
+	{ BTRIEVE_STATUS_CODE_NL_TRANSPORT_FAILURE, "Nl transport failure" },
+	{ BTRIEVE_STATUS_CODE_NL_RCV_DATA_OVERFLOW, "Nl rcv data overflow" },
+	{ BTRIEVE_STATUS_CODE_NL_CST_FULL, "Nl cst full" },
+	{ BTRIEVE_STATUS_CODE_NL_INVALID_ADDRESS_FAMILY, "Nl invalid address family" },
+	{ BTRIEVE_STATUS_CODE_NL_NO_AUTH_CONTEXT_AVAILABLE, "Nl no auth context available" },
+	{ BTRIEVE_STATUS_CODE_NL_INVALID_AUTH_TYPE, "Nl invalid auth type" },
+	{ BTRIEVE_STATUS_CODE_NL_INVALID_AUTH_OBJECT, "Nl invalid auth object" },
+	{ BTRIEVE_STATUS_CODE_NL_AUTH_LEN_TOO_SMALL, "Nl auth len too small" },
+	{ BTRIEVE_STATUS_CODE_NL_INVALID_SESSION_LEVEL_PARM, "Nl invalid session level parm" },
+	{ BTRIEVE_STATUS_CODE_NL_TASK_TABLE_FULL, "Nl task table full" },
+	{ BTRIEVE_STATUS_CODE_NL_NDS_NAME_RESOLUTION_ERROR, "Nl nds name resolution error" },
+	{ BTRIEVE_STATUS_CODE_NL_FILE_NAME_RESOLUTION_ERROR, "Nl file name resolution error" },
+	{ BTRIEVE_STATUS_CODE_NL_IDS_SEND_FAILURE, "Nl ids send failure" },
+	{ BTRIEVE_STATUS_CODE_NL_IDS_RCV_FAILURE, "Nl ids rcv failure" },
+	{ BTRIEVE_STATUS_CODE_UNKNOWN, "Unknown" },
+};	// statusCodeStrings
+
+
+const EnumString systemDataModeStrings [ ] =
+{
+	{ BTRIEVE_SYSTEM_DATA_MODE_YES, "Yes" },
+	{ BTRIEVE_SYSTEM_DATA_MODE_NO, "No" },
+	{ BTRIEVE_SYSTEM_DATA_MODE_DEFAULT, "Default" },
+	{ BTRIEVE_SYSTEM_DATA_MODE_UNKNOWN, "Unknown" },
+};	// systemDataModeStrings
+
+
+const EnumString variableLengthRecordsModeStrings [ ] =
+{
+	{ BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_NO, "No" },
+	{ BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_YES, "Yes" },
+	{ BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_YES_VARIABLE_ALLOCATION_TAILS, "Yes variable allocation tails" },
+	{ BTRIEVE_VARIABLE_LENGTH_RECORDS_MODE_UNKNOWN, "Unknown" },
+};	// variableLengthRecordsModeStrings
+
+
+const EnumString versionTypeStrings [ ] =
+{
+	{ BTRIEVE_VERSION_TYPE_NONE, "None" },
+	{ BTRIEVE_VERSION_TYPE_BTRIEVE_ENGINE, "Btrieve engine" },
+	{ BTRIEVE_VERSION_TYPE_WORKGROUP_ENGINE, "Workgroup engine" },
+	{ BTRIEVE_VERSION_TYPE_DOS_WORKSTATION, "DOS workstation" },
+	{ BTRIEVE_VERSION_TYPE_CLIENT_REQUESTOR, "Client requestor" },
+	{ BTRIEVE_VERSION_TYPE_WINDOWS_SERVER_ENGINE, "Windows server engine" },
+	{ BTRIEVE_VERSION_TYPE_UNIX, "UNIX" },
+	{ BTRIEVE_VERSION_TYPE_CLIENT_ENGINE, "Client engine" },
+	{ BTRIEVE_VERSION_TYPE_UNKNOWN, "Unknown" },
+};	// versionTypeStrings
+
+}	// namespace
+
+
+const char* BtrieveACSModeToString ( btrieve_acs_mode_t ACSMode )
+{
+	return LookupString ( aCSModeStrings, sizeof ( aCSModeStrings ) / sizeof ( aCSModeStrings [ 0 ] ), ACSMode );
+}	// const char* BtrieveACSModeToString
+
+
+const char* BtrieveDataTypeToString ( btrieve_data_type_t dataType )
+{
+	return LookupString ( dataTypeStrings, sizeof ( dataTypeStrings ) / sizeof ( dataTypeStrings [ 0 ] ), dataType );
+}	// const char* BtrieveDataTypeToString
+
+
+const char* BtrieveDuplicateModeToString ( btrieve_duplicate_mode_t duplicateMode )
+{
+	return LookupString ( duplicateModeStrings, sizeof ( duplicateModeStrings ) / sizeof ( duplicateModeStrings [ 0 ] ), duplicateMode );
+}	// const char* BtrieveDuplicateModeToString
+
+
+const char* BtrieveFileVersionToString ( btrieve_file_version_t fileVersion )
+{
+	return LookupString ( fileVersionStrings, sizeof ( fileVersionStrings ) / sizeof ( fileVersionStrings [ 0 ] ), fileVersion );
+}	// const char* BtrieveFileVersionToString
+
+
+const char* BtrieveFreeSpaceThresholdToString ( btrieve_free_space_threshold_t freeSpaceThreshold )
+{
+	return LookupString ( freeSpaceThresholdStrings, sizeof ( freeSpaceThresholdStrings ) / sizeof ( freeSpaceThresholdStrings [ 0 ] ), freeSpaceThreshold );
+}	// const char* BtrieveFreeSpaceThresholdToString
+
+
+const char* BtrieveIndexToString ( btrieve_index_t index )
+{
+	return LookupString ( indexStrings, sizeof ( indexStrings ) / sizeof ( indexStrings [ 0 ] ), index );
+}	// const char* BtrieveIndexToString
+
+
+const char* BtrieveLockModeToString ( btrieve_lock_mode_t lockMode )
+{
+	return LookupString ( lockModeStrings, sizeof ( lockModeStrings ) / sizeof ( lockModeStrings [ 0 ] ), lockMode );
+}	// const char* BtrieveLockModeToString
+
+
+const char* BtrieveNullKeyModeToString ( btrieve_null_key_mode_t nullKeyMode )
+{
+	return LookupString ( nullKeyModeStrings, sizeof ( nullKeyModeStrings ) / sizeof ( nullKeyModeStrings [ 0 ] ), nullKeyMode );
+}	// const char* BtrieveNullKeyModeToString
+
+
+const char* BtrieveOwnerModeToString ( btrieve_owner_mode_t ownerMode )
+{
+	return LookupString ( ownerModeStrings, sizeof ( ownerModeStrings ) / sizeof ( ownerModeStrings [ 0 ] ), ownerMode );
+}	// const char* BtrieveOwnerModeToString
+
+
+const char* BtrievePageLockTypeToString ( btrieve_page_lock_type_t pageLockType )
+{
+	return LookupString ( pageLockTypeStrings, sizeof ( pageLockTypeStrings ) / sizeof ( pageLockTypeStrings [ 0 ] ), pageLockType );
+}	// const char* BtrievePageLockTypeToString
+
+
+const char* BtrievePageSizeToString ( btrieve_page_size_t pageSize )
+{
+	return LookupString ( pageSizeStrings, sizeof ( pageSizeStrings ) / sizeof ( pageSizeStrings [ 0 ] ), pageSize );
+}	// const char* BtrievePageSizeToString
+
+
+const char* BtrieveRecordCompressionModeToString ( btrieve_record_compression_mode_t RecordCompressionMode )
+{
+	return LookupString ( recordCompressionModeStrings, sizeof ( recordCompressionModeStrings ) / sizeof ( recordCompressionModeStrings [ 0 ] ), RecordCompressionMode );
+}	// const char* BtrieveRecordCompressionModeToString
+
+
+const char* BtrieveStatusCodeToString ( btrieve_status_code_t statusCode )
+{
+	return LookupString ( statusCodeStrings, sizeof ( statusCodeStrings ) / sizeof ( statusCodeStrings [ 0 ] ), statusCode );
+}	// const char* BtrieveStatusCodeToString
+
+
+const char* BtrieveSystemDataModeToString ( btrieve_system_data_mode_t systemDataMode )
+{
+	return LookupString ( systemDataModeStrings, sizeof ( systemDataModeStrings ) / sizeof ( systemDataModeStrings [ 0 ] ), systemDataMode );
+}	// const char* BtrieveSystemDataModeToString
+
+
+const char* BtrieveVariableLengthRecordsModeToString ( btrieve_variable_length_records_mode_t variableLengthRecordsMode )
+{
+	return LookupString ( variableLengthRecordsModeStrings, sizeof ( variableLengthRecordsModeStrings ) / sizeof ( variableLengthRecordsModeStrings [ 0 ] ), variableLengthRecordsMode );
+}	// const char* BtrieveVariableLengthRecordsModeToString
+
+
+const char* BtrieveVersionTypeToString ( btrieve_version_type_t versionType )
+{
+	return LookupString ( versionTypeStrings, sizeof ( versionTypeStrings ) / sizeof ( versionTypeStrings [ 0 ] ), versionType );
+}	// const char* BtrieveVersionTypeToString
@@ -0,0 +1,231 @@
+// btrieveAdaptiveRetriever.h : Bulk retrieves that size themselves from
+//                              what the calls before them returned.
+//
+// A BtrieveAdaptiveRetriever calls BulkRetrieveNext, or BulkRetrievePrevious,
+// with attributes the caller set up, filters and fields included, and sets
+// their maximum record count and maximum reject count before each call:
+//
+//    BtrieveAdaptiveRetriever retriever(&btrieveFile, &attributes);
+//
+//    do
+//    {
+//       status = retriever.Next(&result);
+//       for (int i = 0; i < result.GetRecordCount(); i++)
+//          ...
+//    } while (status == Btrieve::STATUS_CODE_NO_ERROR);
+//
+// The first call starts with the current record. The record count aims at
+// the smaller of a full result buffer, from the average length of the
+// records returned so far, and the records a call returns within the target
+// latency, from the average time per record returned so far; time spent on
+// rejected records counts against the records returned with it, so a
+// selective filter makes for smaller batches. A call stopped by the reject
+// count doubles it if the call ran within the target latency, and cuts it
+// in proportion if the call ran over.
+//
+// Reaching the reject count doesn't end the retrieval: Next returns
+// Btrieve::STATUS_CODE_NO_ERROR, perhaps with no records, and the next call
+// carries on past the rejected records. To stop at the end of a key range,
+// use a BtrieveRange.
+
+#ifndef _BTRIEVEADAPTIVERETRIEVER_H
+#define _BTRIEVEADAPTIVERETRIEVER_H
+
+#include <stdint.h>
+
+#include <chrono>
+
+#include "btrieveCpp.h"
+
+/// \brief Bulk retrieves whose maximum record and reject counts follow the batches they return.
+class BtrieveAdaptiveRetriever
+{
+public:
+   /// \brief The length of a result buffer, which holds the records of one call.
+   static const int BUFFER_LENGTH = Btrieve::MAXIMUM_RECORD_LENGTH;
+   /// \brief The bytes a result buffer spends on each record besides its data, its length and cursor position.
+   static const int RECORD_OVERHEAD = 6;
+   /// \brief The largest maximum record count and maximum reject count.
+   static const int MAXIMUM_COUNT = 65535;
+   /// \brief The time a call aims to take unless SetTargetLatency says otherwise.
+   static const uint64_t DEFAULT_TARGET_NANOSECONDS = 1000000;
+   /// \brief The record count and reject count of the first call.
+   static const int INITIAL_RECORD_COUNT = 64;
+   static const int INITIAL_REJECT_COUNT = 256;
+
+   /// \param[in] btrieveFile The file, positioned at the record to start with.
+   /// \param[in] btrieveBulkRetrieveAttributes The attributes of every call, which the retriever changes the counts of.
+   /// \param[in] forward Retrieve with BulkRetrieveNext if true, or BulkRetrievePrevious if false.
+   BtrieveAdaptiveRetriever(BtrieveFile *btrieveFile, BtrieveBulkRetrieveAttributes *btrieveBulkRetrieveAttributes, bool forward = true)
+      : btrieveFile(btrieveFile), btrieveBulkRetrieveAttributes(btrieveBulkRetrieveAttributes), forward(forward),
+        targetNanoseconds(DEFAULT_TARGET_NANOSECONDS)
+   {
+      Reset();
+   }
+
+   /// \brief Set the time a call aims to take, which must be more than zero.
+   Btrieve::StatusCode SetTargetLatency(uint64_t nanoseconds)
+   {
+      if (nanoseconds == 0)
+         return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+      targetNanoseconds = nanoseconds;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Start over with the current record and the initial counts, forgetting the calls made so far.
+   void Reset()
+   {
+      maximumRecordCount = INITIAL_RECORD_COUNT;
+      maximumRejectCount = INITIAL_REJECT_COUNT;
+      recordBytes = 0;
+      recordNanoseconds = 0;
+      first = true;
+      callCount = 0;
+      recordCount = 0;
+      byteCount = 0;
+      overrunCount = 0;
+      totalNanoseconds = 0;
+   }
+
+   /// \brief Retrieve the next batch, then size the one after it.
+   /// \return Btrieve::STATUS_CODE_NO_ERROR while there may be more records, or the status that ended the
+   ///    retrieval, Btrieve::STATUS_CODE_END_OF_FILE at the end. The result holds the records either way.
+   Btrieve::StatusCode Next(BtrieveBulkRetrieveResult *btrieveBulkRetrieveResult)
+   {
+      std::chrono::steady_clock::time_point started;
+      Btrieve::StatusCode status;
+      uint64_t nanoseconds;
+      int count;
+      int bytes = 0;
+
+      if ((status = btrieveBulkRetrieveAttributes->SetMaximumRecordCount(maximumRecordCount)) != Btrieve::STATUS_CODE_NO_ERROR
+         || (status = btrieveBulkRetrieveAttributes->SetMaximumRejectCount(maximumRejectCount)) != Btrieve::STATUS_CODE_NO_ERROR
+         || (status = btrieveBulkRetrieveAttributes->SetSkipCurrentRecord(!first)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+
+      started = std::chrono::steady_clock::now();
+      if (forward)
+         status = btrieveFile->BulkRetrieveNext(btrieveBulkRetrieveAttributes, btrieveBulkRetrieveResult);
+      else
+         status = btrieveFile->BulkRetrievePrevious(btrieveBulkRetrieveAttributes, btrieveBulkRetrieveResult);
+      nanoseconds = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+
+      // The end of the file still leaves the records before it in the result.
+      if (status != Btrieve::STATUS_CODE_NO_ERROR && status != Btrieve::STATUS_CODE_REJECT_COUNT_REACHED
+         && status != Btrieve::STATUS_CODE_END_OF_FILE)
+         return status;
+      first = false;
+      if ((count = btrieveBulkRetrieveResult->GetRecordCount()) < 0)
+         return btrieveBulkRetrieveResult->GetLastStatusCode();
+      for (int i = 0; i < count; i++)
+         bytes += btrieveBulkRetrieveResult->GetRecordLength(i) + RECORD_OVERHEAD;
+
+      callCount++;
+      recordCount += count;
+      byteCount += bytes;
+      totalNanoseconds += nanoseconds;
+      if (nanoseconds > targetNanoseconds)
+         overrunCount++;
+
+      if (status == Btrieve::STATUS_CODE_END_OF_FILE)
+         return status;
+      Adapt(count, bytes, nanoseconds, status == Btrieve::STATUS_CODE_REJECT_COUNT_REACHED);
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Get the maximum record count the next call will use.
+   int GetMaximumRecordCount() const
+   {
+      return maximumRecordCount;
+   }
+
+   /// \brief Get the maximum reject count the next call will use.
+   int GetMaximumRejectCount() const
+   {
+      return maximumRejectCount;
+   }
+
+   /// \brief Get the number of calls that returned since Reset.
+   int GetCallCount() const
+   {
+      return callCount;
+   }
+
+   /// \brief Get the number of records returned since Reset.
+   long long GetRecordCount() const
+   {
+      return recordCount;
+   }
+
+   /// \brief Get the average share of the result buffer the calls since Reset filled, from 0 through 1.
+   double GetAverageFill() const
+   {
+      return (callCount > 0) ? (double)byteCount / ((double)callCount * BUFFER_LENGTH) : 0.0;
+   }
+
+   /// \brief Get the number of calls since Reset that took longer than the target latency.
+   int GetOverrunCount() const
+   {
+      return overrunCount;
+   }
+
+   /// \brief Get the time the calls since Reset took.
+   uint64_t GetTotalNanoseconds() const
+   {
+      return totalNanoseconds;
+   }
+
+private:
+   BtrieveAdaptiveRetriever(const BtrieveAdaptiveRetriever &);
+   BtrieveAdaptiveRetriever &operator=(const BtrieveAdaptiveRetriever &);
+
+   static int Clamp(double count)
+   {
+      if (count < 1.0)
+         return 1;
+      if (count > MAXIMUM_COUNT)
+         return MAXIMUM_COUNT;
+      return (int)count;
+   }
+
+   // Fold a call into the averages, each call weighing as much as all before it, and size the next call.
+   void Adapt(int count, int bytes, uint64_t nanoseconds, bool rejectCountReached)
+   {
+      if (count > 0)
+      {
+         double callRecordBytes = (double)bytes / count;
+         double callRecordNanoseconds = (double)nanoseconds / count;
+
+         recordBytes = (recordBytes > 0) ? (recordBytes + callRecordBytes) / 2 : callRecordBytes;
+         recordNanoseconds = (recordNanoseconds > 0) ? (recordNanoseconds + callRecordNanoseconds) / 2 : callRecordNanoseconds;
+         maximumRecordCount = Clamp(BUFFER_LENGTH / recordBytes);
+         if (recordNanoseconds > 0 && maximumRecordCount > targetNanoseconds / recordNanoseconds)
+            maximumRecordCount = Clamp(targetNanoseconds / recordNanoseconds);
+      }
+
+      if (rejectCountReached)
+      {
+         if (nanoseconds <= targetNanoseconds)
+            maximumRejectCount = Clamp(maximumRejectCount * 2.0);
+         else
+            maximumRejectCount = Clamp((double)maximumRejectCount * targetNanoseconds / nanoseconds);
+      }
+   }
+
+   BtrieveFile *btrieveFile;
+   BtrieveBulkRetrieveAttributes *btrieveBulkRetrieveAttributes;
+   bool forward;
+   uint64_t targetNanoseconds;
+   int maximumRecordCount;
+   int maximumRejectCount;
+   double recordBytes;                                                  // The average bytes of buffer a record takes.
+   double recordNanoseconds;                                            // The average time a call takes per record returned.
+   bool first;
+   int callCount;
+   long long recordCount;
+   long long byteCount;
+   int overrunCount;
+   uint64_t totalNanoseconds;
+};
+
+#endif
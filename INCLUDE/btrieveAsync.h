@@ -0,0 +1,598 @@
+// btrieveAsync.h : C++20 coroutine versions of the blocking BtrieveClient and
+//                  BtrieveFile calls.
+//
+// A BtrieveExecutor runs the calls on a fixed number of threads. Each
+// BtrieveAsyncClient is a strand: the calls on the client and on the files
+// opened through it run one at a time, in the order they were issued,
+// while the calls of different clients run side by side. A coroutine that
+// awaits a call gives up its thread until the call is done, so a few
+// threads keep many requests in flight:
+//
+//    BtrieveTask<Btrieve::StatusCode> Lookup(BtrieveAsyncFile *file, uint32_t key, record_t *record)
+//    {
+//       BtrieveRetrieveResult result = co_await file->RecordRetrieve(Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, (char *)&key, sizeof(key), (char *)record, sizeof(*record));
+//
+//       co_return result.status;
+//    }
+//
+//    BtrieveExecutor btrieveExecutor(4);
+//    BtrieveAsyncClient btrieveAsyncClient(&btrieveExecutor, &btrieveClient);
+//    BtrieveAsyncFile btrieveAsyncFile(&btrieveAsyncClient, &btrieveFile);
+//    BtrieveTask<Btrieve::StatusCode> task = Lookup(&btrieveAsyncFile, 42, &record);
+//
+//    task.Start();
+//    ...
+//    Btrieve::StatusCode status = task.Wait();
+//
+// A call that returns a length also returns the status of that same call,
+// taken on the strand before the next call runs; the file's last status
+// code may belong to another coroutine's call by the time this one resumes.
+//
+// A coroutine resumes on the executor thread that finished its call. The
+// buffers a call is given must outlive the call, as they do when they are
+// locals of the awaiting coroutine.
+
+#ifndef _BTRIEVEASYNC_H
+#define _BTRIEVEASYNC_H
+
+#include <assert.h>
+#include <stddef.h>
+
+#include <condition_variable>
+#include <coroutine>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "btrieveCpp.h"
+
+class BtrieveStrand;
+
+/// \brief A fixed number of threads that run the calls of strands.
+class BtrieveExecutor
+{
+   friend class BtrieveStrand;
+
+public:
+   /// \brief A call waiting to run on a strand.
+   class Operation
+   {
+      friend class BtrieveExecutor;
+      friend class BtrieveStrand;
+
+   public:
+      virtual ~Operation()
+      {
+      }
+
+   protected:
+      // Make the blocking call; runs on an executor thread, alone on its strand.
+      virtual void Run() = 0;
+      // Resume whoever awaits the call, after the strand has moved on.
+      virtual void Complete() = 0;
+   };
+
+   /// \param[in] threadCount The number of threads; zero for one per hardware thread.
+   explicit BtrieveExecutor(unsigned threadCount = 0)
+      : stopping(false), completedCount(0)
+   {
+      if (threadCount == 0)
+         threadCount = (std::thread::hardware_concurrency() > 0) ? std::thread::hardware_concurrency() : 1;
+      for (unsigned i = 0; i < threadCount; i++)
+         threads.emplace_back(&BtrieveExecutor::Work, this);
+   }
+
+   /// \brief Finish the calls already issued, then stop the threads.
+   ~BtrieveExecutor()
+   {
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         stopping = true;
+         ready.notify_all();
+      }
+      for (size_t i = 0; i < threads.size(); i++)
+         threads[i].join();
+   }
+
+   /// \brief Get the number of threads.
+   int GetThreadCount() const
+   {
+      return (int)threads.size();
+   }
+
+   /// \brief Get the number of calls run so far.
+   unsigned long long GetCompletedCount()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return completedCount;
+   }
+
+private:
+   BtrieveExecutor(const BtrieveExecutor &);
+   BtrieveExecutor &operator=(const BtrieveExecutor &);
+
+   void Schedule(BtrieveStrand *strand)
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      strands.push_back(strand);
+      ready.notify_one();
+   }
+
+   void Work();
+
+   std::mutex latch;
+   std::condition_variable ready;
+   std::deque<BtrieveStrand *> strands;                                 // Strands with a call to run, each once.
+   std::vector<std::thread> threads;
+   bool stopping;
+   unsigned long long completedCount;
+};
+
+/// \brief Calls that run one at a time, in order, on an executor.
+class BtrieveStrand
+{
+   friend class BtrieveExecutor;
+
+public:
+   explicit BtrieveStrand(BtrieveExecutor *btrieveExecutor)
+      : btrieveExecutor(btrieveExecutor), scheduled(false)
+   {
+   }
+
+   ~BtrieveStrand()
+   {
+      assert(operations.empty() && !scheduled);
+   }
+
+   BtrieveExecutor *GetExecutor() const
+   {
+      return btrieveExecutor;
+   }
+
+   /// \brief Queue a call; the strand is scheduled if it's idle.
+   void Post(BtrieveExecutor::Operation *operation)
+   {
+      bool idle;
+
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         operations.push_back(operation);
+         idle = !scheduled;
+         scheduled = true;
+      }
+      if (idle)
+         btrieveExecutor->Schedule(this);
+   }
+
+private:
+   BtrieveStrand(const BtrieveStrand &);
+   BtrieveStrand &operator=(const BtrieveStrand &);
+
+   // Run the strand's first call, then hand the strand on if there's another.
+   void RunNext()
+   {
+      BtrieveExecutor::Operation *operation;
+      bool more;
+
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         operation = operations.front();
+         operations.pop_front();
+      }
+      operation->Run();
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         more = !operations.empty();
+         scheduled = more;
+      }
+      if (more)
+         btrieveExecutor->Schedule(this);
+      operation->Complete();
+   }
+
+   BtrieveExecutor *btrieveExecutor;
+   std::mutex latch;
+   std::deque<BtrieveExecutor::Operation *> operations;
+   bool scheduled;
+};
+
+inline void BtrieveExecutor::Work()
+{
+   for (;;)
+   {
+      BtrieveStrand *strand;
+
+      {
+         std::unique_lock<std::mutex> guard(latch);
+
+         while (!stopping && strands.empty())
+            ready.wait(guard);
+         if (strands.empty())
+            return;
+         strand = strands.front();
+         strands.pop_front();
+      }
+      strand->RunNext();
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         completedCount++;
+      }
+   }
+}
+
+/// \brief The awaitable of a blocking call made on a strand.
+/// \tparam Result The result of the call.
+/// \tparam Call A function object that makes the call.
+template <typename Result, typename Call>
+class BtrieveOperation : public BtrieveExecutor::Operation
+{
+public:
+   BtrieveOperation(BtrieveStrand *strand, Call call)
+      : strand(strand), call(call)
+   {
+   }
+
+   bool await_ready() const
+   {
+      return false;
+   }
+
+   void await_suspend(std::coroutine_handle<> awaiting)
+   {
+      // The call may finish, and resume the coroutine, before Post returns.
+      this->awaiting = awaiting;
+      strand->Post(this);
+   }
+
+   Result await_resume()
+   {
+      return result;
+   }
+
+protected:
+   void Run() override
+   {
+      result = call();
+   }
+
+   void Complete() override
+   {
+      awaiting.resume();
+   }
+
+private:
+   BtrieveStrand *strand;
+   Call call;
+   Result result;
+   std::coroutine_handle<> awaiting;
+};
+
+template <typename Result, typename Call>
+BtrieveOperation<Result, Call> MakeBtrieveOperation(BtrieveStrand *strand, Call call)
+{
+   return BtrieveOperation<Result, Call>(strand, call);
+}
+
+template <typename T>
+class BtrieveTask;
+
+/// \brief The part of a task's promise that doesn't depend on its result.
+class BtrieveTaskPromiseBase
+{
+public:
+   BtrieveTaskPromiseBase()
+      : done(false)
+   {
+   }
+
+   std::suspend_always initial_suspend() noexcept
+   {
+      return std::suspend_always();
+   }
+
+   // At the end, go on with the awaiting coroutine, or wake whoever waits.
+   struct FinalAwaiter
+   {
+      bool await_ready() noexcept
+      {
+         return false;
+      }
+
+      template <typename Promise>
+      std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> finished) noexcept
+      {
+         BtrieveTaskPromiseBase &promise = finished.promise();
+
+         if (promise.continuation)
+            return promise.continuation;
+         {
+            std::lock_guard<std::mutex> guard(promise.latch);
+
+            promise.done = true;
+            promise.finishedCondition.notify_all();
+         }
+         return std::noop_coroutine();
+      }
+
+      void await_resume() noexcept
+      {
+      }
+   };
+
+   FinalAwaiter final_suspend() noexcept
+   {
+      return FinalAwaiter();
+   }
+
+   void unhandled_exception()
+   {
+      std::terminate();
+   }
+
+   std::coroutine_handle<> continuation;
+   std::mutex latch;
+   std::condition_variable finishedCondition;
+   bool done;
+};
+
+template <typename T>
+class BtrieveTaskPromise : public BtrieveTaskPromiseBase
+{
+public:
+   BtrieveTask<T> get_return_object();
+
+   void return_value(T value)
+   {
+      this->value = value;
+   }
+
+   T GetValue()
+   {
+      return value;
+   }
+
+private:
+   T value;
+};
+
+template <>
+class BtrieveTaskPromise<void> : public BtrieveTaskPromiseBase
+{
+public:
+   BtrieveTask<void> get_return_object();
+
+   void return_void()
+   {
+   }
+
+   void GetValue()
+   {
+   }
+};
+
+/// \brief A coroutine that returns a \a T, started when it's awaited, or by Start or Wait.
+template <typename T>
+class BtrieveTask
+{
+public:
+   typedef BtrieveTaskPromise<T> promise_type;
+
+   explicit BtrieveTask(std::coroutine_handle<promise_type> coroutine)
+      : coroutine(coroutine), started(false)
+   {
+   }
+
+   BtrieveTask(BtrieveTask &&other)
+      : coroutine(other.coroutine), started(other.started)
+   {
+      other.coroutine = std::coroutine_handle<promise_type>();
+   }
+
+   ~BtrieveTask()
+   {
+      if (coroutine)
+         coroutine.destroy();
+   }
+
+   /// \brief Run the coroutine on this thread until it first awaits a call.
+   void Start()
+   {
+      if (!started)
+      {
+         started = true;
+         coroutine.resume();
+      }
+   }
+
+   /// \brief Start the coroutine if need be, and block until it returns.
+   T Wait()
+   {
+      Start();
+      {
+         promise_type &promise = coroutine.promise();
+         std::unique_lock<std::mutex> guard(promise.latch);
+
+         while (!promise.done)
+            promise.finishedCondition.wait(guard);
+      }
+      return coroutine.promise().GetValue();
+   }
+
+   bool await_ready() const
+   {
+      return false;
+   }
+
+   // Awaiting a task starts it; when it returns it goes straight on with the awaiting coroutine.
+   std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting)
+   {
+      assert(!started);
+      started = true;
+      coroutine.promise().continuation = awaiting;
+      return coroutine;
+   }
+
+   T await_resume()
+   {
+      return coroutine.promise().GetValue();
+   }
+
+private:
+   BtrieveTask(const BtrieveTask &);
+   BtrieveTask &operator=(const BtrieveTask &);
+
+   std::coroutine_handle<promise_type> coroutine;
+   bool started;
+};
+
+template <typename T>
+inline BtrieveTask<T> BtrieveTaskPromise<T>::get_return_object()
+{
+   return BtrieveTask<T>(std::coroutine_handle<BtrieveTaskPromise<T> >::from_promise(*this));
+}
+
+inline BtrieveTask<void> BtrieveTaskPromise<void>::get_return_object()
+{
+   return BtrieveTask<void>(std::coroutine_handle<BtrieveTaskPromise<void> >::from_promise(*this));
+}
+
+/// \brief The awaitable calls of a BtrieveClient; the client and its files share one strand.
+class BtrieveAsyncClient
+{
+public:
+   /// \param[in] btrieveExecutor The executor that runs the calls.
+   /// \param[in] btrieveClient The client. Only the strand may use it while calls are in flight.
+   BtrieveAsyncClient(BtrieveExecutor *btrieveExecutor, BtrieveClient *btrieveClient)
+      : btrieveClient(btrieveClient), strand(btrieveExecutor)
+   {
+   }
+
+   BtrieveClient *GetClient() const
+   {
+      return btrieveClient;
+   }
+
+   BtrieveStrand *GetStrand()
+   {
+      return &strand;
+   }
+
+   /// \see BtrieveClient::TransactionBegin
+   auto TransactionBegin(Btrieve::TransactionMode transactionMode, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE)
+   {
+      BtrieveClient *client = btrieveClient;
+
+      return MakeBtrieveOperation<Btrieve::StatusCode>(&strand, [=] { return client->TransactionBegin(transactionMode, lockMode); });
+   }
+
+   /// \see BtrieveClient::TransactionEnd
+   auto TransactionEnd()
+   {
+      BtrieveClient *client = btrieveClient;
+
+      return MakeBtrieveOperation<Btrieve::StatusCode>(&strand, [=] { return client->TransactionEnd(); });
+   }
+
+   /// \see BtrieveClient::TransactionAbort
+   auto TransactionAbort()
+   {
+      BtrieveClient *client = btrieveClient;
+
+      return MakeBtrieveOperation<Btrieve::StatusCode>(&strand, [=] { return client->TransactionAbort(); });
+   }
+
+private:
+   BtrieveAsyncClient(const BtrieveAsyncClient &);
+   BtrieveAsyncClient &operator=(const BtrieveAsyncClient &);
+
+   BtrieveClient *btrieveClient;
+   BtrieveStrand strand;
+};
+
+/// \brief The result of an awaitable retrieval: the length retrieved and the status of the same call.
+struct BtrieveRetrieveResult
+{
+   int length;
+   Btrieve::StatusCode status;
+};
+
+/// \brief The awaitable calls of a BtrieveFile, made on the strand of the client that opened it.
+class BtrieveAsyncFile
+{
+public:
+   /// \param[in] btrieveAsyncClient The client the file was opened through.
+   /// \param[in] btrieveFile The open file.
+   BtrieveAsyncFile(BtrieveAsyncClient *btrieveAsyncClient, BtrieveFile *btrieveFile)
+      : btrieveFile(btrieveFile), strand(btrieveAsyncClient->GetStrand())
+   {
+   }
+
+   BtrieveFile *GetFile() const
+   {
+      return btrieveFile;
+   }
+
+   /// \see BtrieveFile::RecordRetrieve
+   auto RecordRetrieve(Btrieve::Comparison comparison, Btrieve::Index index, const char *key, int keyLength, char *record, int recordSize, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE)
+   {
+      BtrieveFile *file = btrieveFile;
+
+      return MakeBtrieveOperation<BtrieveRetrieveResult>(strand, [=] {
+         BtrieveRetrieveResult result;
+
+         result.length = file->RecordRetrieve(comparison, index, key, keyLength, record, recordSize, lockMode);
+         result.status = file->GetLastStatusCode();
+         return result;
+      });
+   }
+
+   /// \see BtrieveFile::RecordCreate
+   auto RecordCreate(char *record, int recordLength)
+   {
+      BtrieveFile *file = btrieveFile;
+
+      return MakeBtrieveOperation<Btrieve::StatusCode>(strand, [=] { return file->RecordCreate(record, recordLength); });
+   }
+
+   /// \see BtrieveFile::RecordUpdate
+   auto RecordUpdate(const char *record, int recordLength)
+   {
+      BtrieveFile *file = btrieveFile;
+
+      return MakeBtrieveOperation<Btrieve::StatusCode>(strand, [=] { return file->RecordUpdate(record, recordLength); });
+   }
+
+   /// \see BtrieveFile::BulkRetrieveNext
+   auto BulkRetrieveNext(BtrieveBulkRetrieveAttributes *bulkRetrieveAttributes, BtrieveBulkRetrieveResult *bulkRetrieveResult, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE)
+   {
+      BtrieveFile *file = btrieveFile;
+
+      return MakeBtrieveOperation<Btrieve::StatusCode>(strand, [=] { return file->BulkRetrieveNext(bulkRetrieveAttributes, bulkRetrieveResult, lockMode); });
+   }
+
+   /// \see BtrieveFile::BulkCreate
+   auto BulkCreate(BtrieveBulkCreatePayload *btrieveBulkCreatePayload, BtrieveBulkCreateResult *btrieveBulkCreateResult)
+   {
+      BtrieveFile *file = btrieveFile;
+
+      return MakeBtrieveOperation<Btrieve::StatusCode>(strand, [=] { return file->BulkCreate(btrieveBulkCreatePayload, btrieveBulkCreateResult); });
+   }
+
+private:
+   BtrieveAsyncFile(const BtrieveAsyncFile &);
+   BtrieveAsyncFile &operator=(const BtrieveAsyncFile &);
+
+   BtrieveFile *btrieveFile;
+   BtrieveStrand *strand;
+};
+
+#endif
@@ -0,0 +1,453 @@
+// btrieveClientPool.h : A pool of BtrieveClient objects that outlive the
+//                       requests that use them.
+//
+// A BtrieveClientPool keeps clients keyed by service agent identifier and
+// client identifier, creating and logging in each once, and lends them out
+// one holder at a time:
+//
+//    BtrieveClientPool btrieveClientPool(64);
+//    BtrieveClient *btrieveClient;
+//
+//    if (btrieveClientPool.Checkout(&btrieveClient, 0x4232) == Btrieve::STATUS_CODE_NO_ERROR)
+//    {
+//       ...
+//       btrieveClientPool.Return(btrieveClient);
+//    }
+//
+// or, with a lease that returns the client when it goes out of scope:
+//
+//    BtrieveClientPool::Lease lease(&btrieveClientPool, 0x4232);
+//
+//    if (lease.GetLastStatusCode() == Btrieve::STATUS_CODE_NO_ERROR)
+//       lease->FileOpen(...);
+//
+// Checking out by service agent identifier alone takes any idle client of
+// that agent, preferring the one the calling thread returned last, so a
+// thread keeps working with the client, and the engine state behind it,
+// that it used before. When none is idle a client is created with the
+// lowest unused client identifier. Checking out by both identifiers waits
+// for that client if another thread holds it.
+//
+// The pool holds at most maximumClients clients. When it's full an idle
+// client of another key is closed to make room, and when none is idle the
+// checkout waits. A client must be returned with no transaction active and
+// its files closed.
+
+#ifndef _BTRIEVECLIENTPOOL_H
+#define _BTRIEVECLIENTPOOL_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "btrieveCpp.h"
+
+/// \brief A bounded pool of clients keyed by service agent identifier and client identifier.
+class BtrieveClientPool
+{
+public:
+   /// \brief The most clients a pool holds unless its constructor says otherwise.
+   static const int DEFAULT_MAXIMUM_CLIENTS = 64;
+
+   /// \brief The pool's counters, since it was created.
+   struct Statistics
+   {
+      long long checkoutCount;                                          ///< Checkouts that got a client.
+      long long reuseCount;                                             ///< Checkouts served by a client the pool already held.
+      long long affinityCount;                                          ///< Reuses of the client the calling thread returned last.
+      long long createCount;                                            ///< Clients created.
+      long long evictionCount;                                          ///< Idle clients closed to make room.
+      long long waitCount;                                              ///< Checkouts that had to wait.
+      long long saturationCount;                                        ///< Checkouts that found every client of a full pool in use.
+      long long timeoutCount;                                           ///< Checkouts that gave up waiting.
+      uint64_t waitNanoseconds;                                         ///< Time checkouts spent waiting.
+      int clientCount;                                                  ///< Clients held now.
+      int inUseCount;                                                   ///< Clients checked out now.
+      int peakInUseCount;                                               ///< The most clients checked out at once.
+
+      /// \brief Get the share of checkouts served by a client the pool already held.
+      double GetReuseRate() const
+      {
+         return (checkoutCount > 0) ? (double)reuseCount / (double)checkoutCount : 0.0;
+      }
+
+      /// \brief Get the share of checkouts that found the pool full and busy.
+      double GetSaturationRate() const
+      {
+         return (checkoutCount > 0) ? (double)saturationCount / (double)checkoutCount : 0.0;
+      }
+   };
+
+   /// \brief A client checked out of a pool for the lifetime of the lease.
+   class Lease
+   {
+   public:
+      /// \brief Check out any client of a service agent.
+      Lease(BtrieveClientPool *btrieveClientPool, int serviceAgentIdentifier)
+         : btrieveClientPool(btrieveClientPool), btrieveClient(NULL)
+      {
+         lastStatusCode = btrieveClientPool->Checkout(&btrieveClient, serviceAgentIdentifier);
+      }
+
+      /// \brief Check out the client of a service agent and client identifier.
+      Lease(BtrieveClientPool *btrieveClientPool, int serviceAgentIdentifier, int clientIdentifier)
+         : btrieveClientPool(btrieveClientPool), btrieveClient(NULL)
+      {
+         lastStatusCode = btrieveClientPool->Checkout(&btrieveClient, serviceAgentIdentifier, clientIdentifier);
+      }
+
+      ~Lease()
+      {
+         if (btrieveClient != NULL)
+            btrieveClientPool->Return(btrieveClient);
+      }
+
+      /// \brief Get the status of the checkout.
+      Btrieve::StatusCode GetLastStatusCode() const
+      {
+         return lastStatusCode;
+      }
+
+      /// \brief Get the client, or NULL if the checkout failed.
+      BtrieveClient *Get() const
+      {
+         return btrieveClient;
+      }
+
+      BtrieveClient *operator->() const
+      {
+         assert(btrieveClient != NULL);
+         return btrieveClient;
+      }
+
+   private:
+      Lease(const Lease &);
+      Lease &operator=(const Lease &);
+
+      BtrieveClientPool *btrieveClientPool;
+      BtrieveClient *btrieveClient;
+      Btrieve::StatusCode lastStatusCode;
+   };
+
+   /// \param[in] maximumClients The most clients the pool holds.
+   /// \param[in] databaseURI The database each new client logs in to, if any; clients log out of it when closed.
+   explicit BtrieveClientPool(int maximumClients = DEFAULT_MAXIMUM_CLIENTS, const char *databaseURI = NULL)
+      : maximumClients((maximumClients > 0) ? maximumClients : 1), timeoutMilliseconds(0), clientCount(0), returnCount(0)
+   {
+      if (databaseURI != NULL)
+         this->databaseURI = databaseURI;
+      memset(&statistics, 0, sizeof(statistics));
+   }
+
+   /// \brief Close every client; none may be checked out.
+   ~BtrieveClientPool()
+   {
+      std::map<Key, Entry *>::iterator entry;
+
+      for (entry = entries.begin(); entry != entries.end(); ++entry)
+      {
+         assert(!entry->second->inUse);
+         Close(entry->second);
+      }
+   }
+
+   /// \brief Set how long a checkout waits for a client before it fails; zero, the default, waits for as long as it takes.
+   void SetCheckoutTimeout(int milliseconds)
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      timeoutMilliseconds = (milliseconds > 0) ? milliseconds : 0;
+   }
+
+   /// \brief Check out any client of a service agent, preferably the one the calling thread returned last.
+   /// \param[out] btrieveClient The client.
+   /// \param[in] serviceAgentIdentifier The service agent identifier.
+   /// \retval Btrieve::STATUS_CODE_CLIENT_TABLE_FULL The checkout timed out.
+   Btrieve::StatusCode Checkout(BtrieveClient **btrieveClient, int serviceAgentIdentifier)
+   {
+      std::unique_lock<std::mutex> guard(latch);
+      std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+      bool waited = false;
+
+      if (btrieveClient == NULL)
+         return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+      *btrieveClient = NULL;
+
+      for (;;)
+      {
+         std::map<int, std::vector<Entry *> >::iterator idle = idleEntries.find(serviceAgentIdentifier);
+         Entry *entry;
+
+         if (idle != idleEntries.end() && !idle->second.empty())
+         {
+            std::vector<Entry *> &idleOfAgent = idle->second;
+            size_t i;
+
+            // Take the client this thread returned last if it's idle, else the one returned most recently.
+            for (i = idleOfAgent.size(); i-- > 0;)
+               if (idleOfAgent[i]->lastThread == std::this_thread::get_id())
+                  break;
+            if (i == (size_t)-1)
+               i = idleOfAgent.size() - 1;
+            else
+               statistics.affinityCount++;
+            entry = idleOfAgent[i];
+            idleOfAgent.erase(idleOfAgent.begin() + i);
+            statistics.reuseCount++;
+            return Lend(entry, btrieveClient, started, waited);
+         }
+
+         if (MakeRoom())
+            return Create(guard, Key(serviceAgentIdentifier, FreeClientIdentifier(serviceAgentIdentifier)), btrieveClient, started, waited);
+
+         if (!Wait(guard, started, &waited))
+            return Btrieve::STATUS_CODE_CLIENT_TABLE_FULL;
+      }
+   }
+
+   /// \brief Check out the client of a service agent and client identifier, waiting for it if it's checked out.
+   /// \param[out] btrieveClient The client.
+   /// \param[in] serviceAgentIdentifier The service agent identifier.
+   /// \param[in] clientIdentifier The client identifier.
+   /// \retval Btrieve::STATUS_CODE_CLIENT_TABLE_FULL The checkout timed out.
+   Btrieve::StatusCode Checkout(BtrieveClient **btrieveClient, int serviceAgentIdentifier, int clientIdentifier)
+   {
+      std::unique_lock<std::mutex> guard(latch);
+      std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+      Key key(serviceAgentIdentifier, clientIdentifier);
+      bool waited = false;
+
+      if (btrieveClient == NULL)
+         return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+      *btrieveClient = NULL;
+
+      for (;;)
+      {
+         std::map<Key, Entry *>::iterator entry = entries.find(key);
+
+         if (entry != entries.end())
+         {
+            if (!entry->second->inUse)
+            {
+               RemoveIdle(entry->second);
+               if (entry->second->lastThread == std::this_thread::get_id())
+                  statistics.affinityCount++;
+               statistics.reuseCount++;
+               return Lend(entry->second, btrieveClient, started, waited);
+            }
+         }
+         else if (MakeRoom())
+            return Create(guard, key, btrieveClient, started, waited);
+
+         if (!Wait(guard, started, &waited))
+            return Btrieve::STATUS_CODE_CLIENT_TABLE_FULL;
+      }
+   }
+
+   /// \brief Return a checked out client to the pool.
+   void Return(BtrieveClient *btrieveClient)
+   {
+      std::lock_guard<std::mutex> guard(latch);
+      std::map<Key, Entry *>::iterator entry;
+
+      if (btrieveClient == NULL)
+         return;
+      entry = entries.find(Key(btrieveClient->GetServiceAgentIdentifier(), btrieveClient->GetClientIdentifier()));
+      assert(entry != entries.end() && entry->second->client == btrieveClient && entry->second->inUse);
+      if (entry == entries.end() || entry->second->client != btrieveClient)
+         return;
+
+      entry->second->inUse = false;
+      entry->second->lastThread = std::this_thread::get_id();
+      entry->second->returnNumber = ++returnCount;
+      idleEntries[entry->first.first].push_back(entry->second);
+      statistics.inUseCount--;
+      changed.notify_all();
+   }
+
+   /// \brief Get the pool's counters.
+   Statistics GetStatistics()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+      Statistics snapshot = statistics;
+
+      snapshot.clientCount = clientCount;
+      return snapshot;
+   }
+
+private:
+   BtrieveClientPool(const BtrieveClientPool &);
+   BtrieveClientPool &operator=(const BtrieveClientPool &);
+
+   typedef std::pair<int, int> Key;                                     // The service agent identifier and client identifier.
+
+   struct Entry
+   {
+      BtrieveClient *client;                                            // NULL while it's being created.
+      bool inUse;
+      std::thread::id lastThread;                                       // The thread that returned it last.
+      unsigned long long returnNumber;                                  // When it was returned last.
+   };
+
+   static uint64_t ElapsedNanoseconds(std::chrono::steady_clock::time_point started)
+   {
+      return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+   }
+
+   // Make sure there's room for another client, closing the idle client returned longest ago if the pool is full.
+   bool MakeRoom()
+   {
+      std::map<int, std::vector<Entry *> >::iterator idle;
+      Entry *oldest = NULL;
+
+      if (clientCount < maximumClients)
+         return true;
+
+      // Each agent's idle clients are in the order they were returned, so the oldest is at the front of one of them.
+      for (idle = idleEntries.begin(); idle != idleEntries.end(); ++idle)
+         if (!idle->second.empty() && (oldest == NULL || idle->second.front()->returnNumber < oldest->returnNumber))
+            oldest = idle->second.front();
+      if (oldest == NULL)
+         return false;
+
+      RemoveIdle(oldest);
+      entries.erase(Key(oldest->client->GetServiceAgentIdentifier(), oldest->client->GetClientIdentifier()));
+      Close(oldest);
+      clientCount--;
+      statistics.evictionCount++;
+      return true;
+   }
+
+   void RemoveIdle(Entry *entry)
+   {
+      std::vector<Entry *> &idleOfAgent = idleEntries[entry->client->GetServiceAgentIdentifier()];
+      size_t i;
+
+      for (i = 0; i < idleOfAgent.size(); i++)
+         if (idleOfAgent[i] == entry)
+         {
+            idleOfAgent.erase(idleOfAgent.begin() + i);
+            return;
+         }
+   }
+
+   // The lowest client identifier of the agent that no client of the pool has.
+   int FreeClientIdentifier(int serviceAgentIdentifier)
+   {
+      std::map<Key, Entry *>::iterator entry = entries.lower_bound(Key(serviceAgentIdentifier, 0));
+      int clientIdentifier = 0;
+
+      for (; entry != entries.end() && entry->first.first == serviceAgentIdentifier && entry->first.second == clientIdentifier; ++entry)
+         clientIdentifier++;
+      return clientIdentifier;
+   }
+
+   // Wait for a client to be returned; false if the checkout timed out.
+   bool Wait(std::unique_lock<std::mutex> &guard, std::chrono::steady_clock::time_point started, bool *waited)
+   {
+      if (!*waited)
+      {
+         *waited = true;
+         statistics.waitCount++;
+         if (clientCount >= maximumClients && statistics.inUseCount >= clientCount)
+            statistics.saturationCount++;
+      }
+      if (timeoutMilliseconds == 0)
+      {
+         changed.wait(guard);
+         return true;
+      }
+      if (changed.wait_until(guard, started + std::chrono::milliseconds(timeoutMilliseconds)) == std::cv_status::no_timeout)
+         return true;
+      statistics.waitNanoseconds += ElapsedNanoseconds(started);
+      statistics.timeoutCount++;
+      return false;
+   }
+
+   Btrieve::StatusCode Lend(Entry *entry, BtrieveClient **btrieveClient, std::chrono::steady_clock::time_point started, bool waited)
+   {
+      entry->inUse = true;
+      statistics.checkoutCount++;
+      if (waited)
+         statistics.waitNanoseconds += ElapsedNanoseconds(started);
+      if (++statistics.inUseCount > statistics.peakInUseCount)
+         statistics.peakInUseCount = statistics.inUseCount;
+      *btrieveClient = entry->client;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   // Create and log in a client for the key, outside the latch; the entry holds the key meanwhile.
+   Btrieve::StatusCode Create(std::unique_lock<std::mutex> &guard, Key key, BtrieveClient **btrieveClient, std::chrono::steady_clock::time_point started, bool waited)
+   {
+      Entry *entry = new (std::nothrow) Entry();
+      Btrieve::StatusCode status = Btrieve::STATUS_CODE_NO_ERROR;
+      BtrieveClient *client;
+
+      if (entry == NULL)
+         return Btrieve::STATUS_CODE_NO_OS_MEMORY_AVAIL;
+      entry->client = NULL;
+      entry->inUse = true;
+      entry->returnNumber = 0;
+      entries[key] = entry;
+      clientCount++;
+      guard.unlock();
+
+      client = new (std::nothrow) BtrieveClient(key.first, key.second);
+      if (client == NULL)
+         status = Btrieve::STATUS_CODE_NO_OS_MEMORY_AVAIL;
+      else if (!databaseURI.empty() && (status = client->Login(databaseURI.c_str())) != Btrieve::STATUS_CODE_NO_ERROR)
+      {
+         delete client;
+         client = NULL;
+      }
+
+      guard.lock();
+      if (client == NULL)
+      {
+         entries.erase(key);
+         delete entry;
+         clientCount--;
+         changed.notify_all();
+         return status;
+      }
+      entry->client = client;
+      statistics.createCount++;
+      return Lend(entry, btrieveClient, started, waited);
+   }
+
+   void Close(Entry *entry)
+   {
+      if (entry->client != NULL)
+      {
+         if (!databaseURI.empty())
+            entry->client->Logout(databaseURI.c_str());
+         delete entry->client;
+      }
+      delete entry;
+   }
+
+   int maximumClients;
+   std::string databaseURI;
+   int timeoutMilliseconds;
+
+   std::mutex latch;
+   std::condition_variable changed;
+   std::map<Key, Entry *> entries;
+   std::map<int, std::vector<Entry *> > idleEntries;                    // Each agent's idle clients, in the order they were returned.
+   int clientCount;
+   unsigned long long returnCount;
+   Statistics statistics;
+};
+
+#endif
@@ -0,0 +1,255 @@
+// btrieveColumns.h : Columnar decoding of bulk retrieve results.
+//
+// BtrieveColumns scatters the rows of bulk retrieve results into one array
+// per field, so aggregation can run over a column at a time instead of
+// picking fields out of each row:
+//
+//    BtrieveColumns columns(query);
+//
+//    while (btrieveFile.BulkRetrieveNext(&attributes, &result) == Btrieve::STATUS_CODE_NO_ERROR)
+//       columns.Append(&result);
+//    for (int i = 0; i < columns.GetRowCount(); i++)
+//       total += columns.GetColumn<uint32_t>(0)[i];
+//
+// A column holds its field's values back to back, with no padding between
+// them, and starts on a BtrieveColumns::ALIGNMENT byte boundary. The
+// layout comes from a BtrieveQuery, column by column in the order its
+// fields were selected, or from AddColumn calls that give where each field
+// lies in a row.
+
+#ifndef _BTRIEVECOLUMNS_H
+#define _BTRIEVECOLUMNS_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <new>
+#include <vector>
+
+#include "btrieveCpp.h"
+#include "btrievePredicate.h"
+
+/// \brief Bulk retrieve results decoded into a column per field.
+class BtrieveColumns
+{
+public:
+   /// \brief The boundary every column starts on, a cache line and a vector register's worth.
+   static const size_t ALIGNMENT = 64;
+
+   BtrieveColumns()
+      : rowLength(0), rowCount(0), rowCapacity(0)
+   {
+   }
+
+   /// \brief Lay the columns out as a query's selected fields are laid out in its rows.
+   explicit BtrieveColumns(const BtrieveQuery &query)
+      : rowLength(0), rowCount(0), rowCapacity(0)
+   {
+      for (int i = 0; i < query.GetSelectedFieldCount(); i++)
+         AddColumn(query.GetRowOffset(i), query.GetSelectedField(i).length);
+   }
+
+   ~BtrieveColumns()
+   {
+      for (size_t i = 0; i < columns.size(); i++)
+         Free(columns[i].data);
+   }
+
+   /// \brief Add a column for a field of the rows, dropping any rows already decoded.
+   /// \param[in] rowOffset Where the field starts in a row.
+   /// \param[in] width The length of the field.
+   Btrieve::StatusCode AddColumn(int rowOffset, int width)
+   {
+      Column column;
+
+      if (rowOffset < 0 || width <= 0 || rowOffset + width > Btrieve::MAXIMUM_RECORD_LENGTH)
+         return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+      Clear();
+      column.rowOffset = rowOffset;
+      column.width = width;
+      column.data = NULL;
+      if (rowCapacity > 0 && (column.data = Allocate((size_t)rowCapacity * width)) == NULL)
+         return Btrieve::STATUS_CODE_NO_OS_MEMORY_AVAIL;
+      columns.push_back(column);
+      if (rowOffset + width > rowLength)
+         rowLength = rowOffset + width;
+      row.resize(rowLength);
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Append the rows of a result to the columns.
+   /// \details Bytes of a field past the end of a shorter row are zero.
+   /// \retval Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION There are no columns to decode into.
+   Btrieve::StatusCode Append(BtrieveBulkRetrieveResult *btrieveBulkRetrieveResult)
+   {
+      int count = btrieveBulkRetrieveResult->GetRecordCount();
+      Btrieve::StatusCode status;
+
+      if (columns.empty())
+         return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+      if (count < 0)
+         return btrieveBulkRetrieveResult->GetLastStatusCode();
+      if ((status = Reserve(rowCount + count)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+
+      for (int i = 0; i < count; i++)
+      {
+         int length = btrieveBulkRetrieveResult->GetRecord(i, row.data(), rowLength);
+
+         // A row longer than the layout comes back cut short, which is all the layout needs of it.
+         // A failure drops the rows of the result already taken, so the cursor positions match the columns.
+         if (length < 0)
+         {
+            cursorPositions.resize(rowCount);
+            return btrieveBulkRetrieveResult->GetLastStatusCode();
+         }
+         if (length < rowLength)
+            memset(row.data() + length, 0, rowLength - length);
+         Scatter(rowCount + i);
+         cursorPositions.push_back(btrieveBulkRetrieveResult->GetRecordCursorPosition(i));
+      }
+
+      rowCount += count;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Replace the rows of the columns with those of a result.
+   Btrieve::StatusCode Decode(BtrieveBulkRetrieveResult *btrieveBulkRetrieveResult)
+   {
+      Clear();
+      return Append(btrieveBulkRetrieveResult);
+   }
+
+   /// \brief Drop the rows, keeping the columns and their memory.
+   void Clear()
+   {
+      rowCount = 0;
+      cursorPositions.clear();
+   }
+
+   /// \brief Get the number of rows decoded.
+   int GetRowCount() const
+   {
+      return rowCount;
+   }
+
+   /// \brief Get the number of columns.
+   int GetColumnCount() const
+   {
+      return (int)columns.size();
+   }
+
+   /// \brief Get the length of a column's values.
+   int GetColumnWidth(int columnNumber) const
+   {
+      return columns[columnNumber].width;
+   }
+
+   /// \brief Get the values of a column, GetColumnWidth bytes apiece.
+   const char *GetColumnData(int columnNumber) const
+   {
+      return columns[columnNumber].data;
+   }
+
+   /// \brief Get the values of a column as \a T, which must be as long as the field.
+   template <typename T>
+   const T *GetColumn(int columnNumber) const
+   {
+      assert(sizeof(T) == (size_t)columns[columnNumber].width);
+      return (const T *)columns[columnNumber].data;
+   }
+
+   /// \brief Get the cursor positions of the rows.
+   const long long *GetCursorPositions() const
+   {
+      return cursorPositions.data();
+   }
+
+private:
+   struct Column
+   {
+      int rowOffset;
+      int width;
+      char *data;
+   };
+
+   BtrieveColumns(const BtrieveColumns &);
+   BtrieveColumns &operator=(const BtrieveColumns &);
+
+   static char *Allocate(size_t length)
+   {
+      return (char *)::operator new[](length, std::align_val_t(ALIGNMENT), std::nothrow);
+   }
+
+   static void Free(char *data)
+   {
+      if (data != NULL)
+         ::operator delete[](data, std::align_val_t(ALIGNMENT));
+   }
+
+   // Make room for a number of rows in every column, doubling the room as it runs out.
+   Btrieve::StatusCode Reserve(int rows)
+   {
+      int capacity = (rowCapacity > 0) ? rowCapacity : 256;
+
+      if (rows <= rowCapacity)
+         return Btrieve::STATUS_CODE_NO_ERROR;
+      while (capacity < rows)
+         capacity *= 2;
+
+      for (size_t i = 0; i < columns.size(); i++)
+      {
+         char *data = Allocate((size_t)capacity * columns[i].width);
+
+         if (data == NULL)
+            return Btrieve::STATUS_CODE_NO_OS_MEMORY_AVAIL;
+         if (rowCount > 0)
+            memcpy(data, columns[i].data, (size_t)rowCount * columns[i].width);
+         Free(columns[i].data);
+         columns[i].data = data;
+      }
+
+      rowCapacity = capacity;
+      cursorPositions.reserve(capacity);
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   // Copy the fields of the row into their columns; the common widths copy with one move.
+   void Scatter(int rowNumber)
+   {
+      for (size_t i = 0; i < columns.size(); i++)
+      {
+         const char *field = row.data() + columns[i].rowOffset;
+         char *value = columns[i].data + (size_t)rowNumber * columns[i].width;
+
+         switch (columns[i].width)
+         {
+         case 1:
+            *value = *field;
+            break;
+         case 2:
+            memcpy(value, field, 2);
+            break;
+         case 4:
+            memcpy(value, field, 4);
+            break;
+         case 8:
+            memcpy(value, field, 8);
+            break;
+         default:
+            memcpy(value, field, columns[i].width);
+            break;
+         }
+      }
+   }
+
+   std::vector<Column> columns;
+   std::vector<char> row;
+   std::vector<long long> cursorPositions;
+   int rowLength;
+   int rowCount;
+   int rowCapacity;
+};
+
+#endif
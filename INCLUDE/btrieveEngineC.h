@@ -0,0 +1,146 @@
+// btrieveEngineC.h : Entry points of the in-process engine that go beyond
+//                    the btrieveC.h interface.
+//
+// Record views: the view-returning retrievals move the cursor like their
+// btrieveC.h counterparts, but instead of copying the record they point a
+// view at it where it lies in the engine's page cache. The page stays
+// pinned, and the view stays valid, until the handle's cursor next moves
+// or another view is asked for, the record is deleted through the handle,
+// the view is released or the handle is closed. The bytes are read-only.
+// A view doesn't block writers: other handles may change the record while
+// it's viewed, which the view's stamp reveals.
+//
+// In builds with assertions, and when BTRIEVE_ENGINE_CHECK_VIEWS=1 is set
+// in the environment, views are checked: each is served from a copy that
+// is overwritten with 0xDD bytes when the view is invalidated and kept
+// until the next view is, so a stale pointer reads garbage rather than a
+// later record.
+//
+// Bloom filters: an equal key retrieval first asks a filter over the keys
+// of the index, which answers for most missing keys without reading index
+// pages. Filters are built in memory for indexes of 1024 or more entries,
+// with BTRIEVE_ENGINE_BLOOM_BITS bits per key (10 unless the environment
+// says otherwise; 0 turns them off). The counters of a file's filters are
+// part of its information: falsePositiveRate is the share of retrievals of
+// missing keys that a filter passed on to the index, and
+// estimatedFalsePositiveRate the share predicted from how full it is.
+//
+// Multiple gets: BtrieveFileMultiGet retrieves the records of many keys of
+// an index at once, as RecordRetrieve with COMPARISON_EQUAL would one at a
+// time, but in one walk of the index in key order, so keys that share
+// index pages share their reads. The keys are keyCount keys of keyLength
+// bytes each, back to back; the records go to keyCount buffers of
+// recordSize bytes each, back to back, in the same order, and each key
+// gets its own status code and, if recordLengths isn't NULL, the length
+// copied. A recordSize of zero asks for the status codes alone. The call
+// fails as a whole only for bad arguments or an I/O error, and it doesn't
+// move the cursor. The statistics, if asked for, count the index pages
+// read and how many fewer that is than one retrieval per key would read.
+//
+// Index builds: BtrieveFileIndexCreateWithOptions creates an index as
+// BtrieveFileIndexCreate does, on threadCount threads, or one per core if
+// it's zero (BTRIEVE_ENGINE_INDEX_THREADS in the environment overrides the
+// core count). The threads read the data pages and sort the keys they
+// find; the sorted keys are then merged on a thread of their own while
+// the calling thread builds the index from the leaves up. Files of few
+// data pages are read on fewer threads. If callback isn't NULL it's called
+// on the calling thread as each phase starts, every tenth of a second or
+// so within a phase, and once the index is built, with the counts so far
+// and the rates since the build started. The file is locked throughout,
+// so the callback mustn't use it.
+//
+// Mapped files: a file opened with BTRIEVE_OPEN_MODE_READ_ONLY while no
+// other handle has it open is mapped into memory, and its pages are read
+// in place from the mapping rather than through the page cache, so record
+// views point into the mapping. When a handle that may write opens the
+// file it's reopened for writing and the pages opened from then on go
+// through the cache again. BTRIEVE_ENGINE_MAPPED_FILES=0 in the
+// environment turns mapping off. Another process mustn't truncate a
+// mapped file. BtrieveFileSetAccessHint tells the system how the file's
+// pages will be read, which shapes its read-ahead; the hint is shared by
+// every handle of the file, and the last one set applies.
+//
+
+#ifndef _BTRIEVEENGINEC_H
+#define _BTRIEVEENGINEC_H
+
+#include "btrieveC.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+	const char *record;
+	int length;
+	unsigned long long generation;
+	unsigned long long stamp;
+} btrieve_record_view_t;
+
+typedef struct {
+	int enabled;
+	unsigned long long keyCount;
+	unsigned long long bitCount;
+	unsigned long long lookupCount;
+	unsigned long long negativeCount;
+	unsigned long long falsePositiveCount;
+	double falsePositiveRate;
+	double estimatedFalsePositiveRate;
+} btrieve_bloom_filter_statistics_t;
+
+typedef struct {
+	long long pageReadCount;
+	long long savedPageReadCount;
+} btrieve_multi_get_statistics_t;
+
+typedef enum {
+	BTRIEVE_INDEX_BUILD_PHASE_READ,
+	BTRIEVE_INDEX_BUILD_PHASE_SORT,
+	BTRIEVE_INDEX_BUILD_PHASE_LOAD,
+	BTRIEVE_INDEX_BUILD_PHASE_DONE
+} btrieve_index_build_phase_t;
+
+typedef struct {
+	btrieve_index_build_phase_t phase;
+	int threadCount;
+	unsigned long long recordCount;
+	unsigned long long recordsRead;
+	unsigned long long entryCount;
+	unsigned long long entriesLoaded;
+	unsigned long long elapsedNanoseconds;
+	double recordsPerSecond;
+	double entriesPerSecond;
+} btrieve_index_build_progress_t;
+
+typedef void (*btrieve_index_build_callback_t)(const btrieve_index_build_progress_t *progress, void *context);
+
+typedef struct {
+	int threadCount;
+	btrieve_index_build_callback_t callback;
+	void *context;
+} btrieve_index_build_options_t;
+
+typedef enum {
+	BTRIEVE_ACCESS_HINT_NORMAL,
+	BTRIEVE_ACCESS_HINT_RANDOM,
+	BTRIEVE_ACCESS_HINT_SEQUENTIAL
+} btrieve_access_hint_t;
+
+extern LINKAGE btrieve_status_code_t BtrieveFileRecordRetrieveView(btrieve_file_t file, btrieve_comparison_t comparison, btrieve_index_t index, const char *key, int keyLength, btrieve_record_view_t *view, btrieve_lock_mode_t lockMode);
+extern LINKAGE btrieve_status_code_t BtrieveFileRecordRetrieveFirstView(btrieve_file_t file, btrieve_index_t index, btrieve_record_view_t *view, btrieve_lock_mode_t lockMode);
+extern LINKAGE btrieve_status_code_t BtrieveFileRecordRetrieveLastView(btrieve_file_t file, btrieve_index_t index, btrieve_record_view_t *view, btrieve_lock_mode_t lockMode);
+extern LINKAGE btrieve_status_code_t BtrieveFileRecordRetrieveNextView(btrieve_file_t file, btrieve_record_view_t *view, btrieve_lock_mode_t lockMode);
+extern LINKAGE btrieve_status_code_t BtrieveFileRecordRetrievePreviousView(btrieve_file_t file, btrieve_record_view_t *view, btrieve_lock_mode_t lockMode);
+extern LINKAGE btrieve_status_code_t BtrieveFileReleaseRecordView(btrieve_file_t file);
+extern LINKAGE int BtrieveFileIsRecordViewValid(btrieve_file_t file, const btrieve_record_view_t *view);
+extern LINKAGE int BtrieveFileIsRecordViewCurrent(btrieve_file_t file, const btrieve_record_view_t *view);
+extern LINKAGE btrieve_status_code_t BtrieveFileMultiGet(btrieve_file_t file, btrieve_index_t index, const char *keys, int keyLength, int keyCount, char *records, int recordSize, int *recordLengths, btrieve_status_code_t *statusCodes, btrieve_multi_get_statistics_t *statistics);
+extern LINKAGE btrieve_status_code_t BtrieveFileIndexCreateWithOptions(btrieve_file_t file, btrieve_index_attributes_t indexAttributes, const btrieve_index_build_options_t *options);
+extern LINKAGE btrieve_status_code_t BtrieveFileSetAccessHint(btrieve_file_t file, btrieve_access_hint_t hint);
+extern LINKAGE btrieve_status_code_t BtrieveFileInformationGetBloomFilterStatistics(btrieve_file_information_t fileInformation, btrieve_index_t index, btrieve_bloom_filter_statistics_t *statistics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
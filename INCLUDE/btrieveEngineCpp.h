@@ -0,0 +1,219 @@
+// btrieveEngineCpp.h : Classes over the btrieveEngineC.h entry points of the
+//                      in-process engine.
+//
+
+#ifndef _BTRIEVEENGINECPP_H
+#define _BTRIEVEENGINECPP_H
+
+#include <assert.h>
+
+#include "btrieveCpp.h"
+#include "btrieveEngineC.h"
+
+class BtrieveRecordViewer;
+
+/// \brief A read-only view of a record where it lies in the engine's page cache.
+/// \details A view is filled in by a BtrieveRecordViewer and stays valid until the cursor of
+/// its file next moves, the record is deleted through the file, the view is released or the
+/// file is closed. Reading an invalid view asserts in builds with assertions; the engine also
+/// spoils the bytes of invalidated views in those builds. See btrieveEngineC.h.
+class LINKAGE BtrieveRecordView
+{
+   friend class BtrieveRecordViewer;
+
+public:
+   BtrieveRecordView();
+
+   /// \brief Get the record.
+   /// \return The first byte of the record. The bytes are not null terminated.
+   const char *GetRecord() const
+   {
+      assert(IsValid());
+      return view.record;
+   }
+
+   /// \brief Get the length of the record.
+   int GetLength() const
+   {
+      assert(IsValid());
+      return view.length;
+   }
+
+   /// \brief Get the record as a \a Record, which must be no longer than the record.
+   template <typename Record>
+   const Record *As() const
+   {
+      assert(IsValid() && (size_t)view.length >= sizeof(Record));
+      return (const Record *)view.record;
+   }
+
+   /// \brief Return true if the view hasn't been invalidated.
+   bool IsValid() const;
+   /// \brief Return true if the view is valid and the file hasn't been changed since it was taken.
+   bool IsCurrent() const;
+
+private:
+   btrieve_file_t btrieveFile;
+   btrieve_record_view_t view;
+};
+
+/// \brief Retrieves records of a file as views instead of copies.
+/// \details Each retrieval moves the cursor of the file just like its BtrieveFile counterpart,
+/// which invalidates the view taken by the previous one.
+class LINKAGE BtrieveRecordViewer
+{
+public:
+   /// \param[in] btrieveFile The file, which must outlive the viewer.
+   explicit BtrieveRecordViewer(BtrieveFile *btrieveFile);
+
+   /// \brief Retrieve a record as a view.
+   /// \param[in] comparison The comparison.
+   /// \param[in] index The index.
+   /// \param[in] key The key.
+   /// \param[in] keyLength The key length.
+   /// \param[out] btrieveRecordView The view.
+   /// \param[in] lockMode The lock mode.
+   /// \retval "= Btrieve::STATUS_CODE_NO_ERROR" \SUCCESS
+   /// \retval "!= Btrieve::STATUS_CODE_NO_ERROR" \ERROR_HAS_OCCURRED
+   /// \see BtrieveFile::RecordRetrieve
+   Btrieve::StatusCode RecordRetrieve(Btrieve::Comparison comparison, Btrieve::Index index, const char *key, int keyLength, BtrieveRecordView *btrieveRecordView, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE);
+   /// \brief Retrieve the first record as a view.
+   /// \see BtrieveFile::RecordRetrieveFirst
+   Btrieve::StatusCode RecordRetrieveFirst(Btrieve::Index index, BtrieveRecordView *btrieveRecordView, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE);
+   /// \brief Retrieve the last record as a view.
+   /// \see BtrieveFile::RecordRetrieveLast
+   Btrieve::StatusCode RecordRetrieveLast(Btrieve::Index index, BtrieveRecordView *btrieveRecordView, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE);
+   /// \brief Retrieve the next record as a view.
+   /// \see BtrieveFile::RecordRetrieveNext
+   Btrieve::StatusCode RecordRetrieveNext(BtrieveRecordView *btrieveRecordView, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE);
+   /// \brief Retrieve the previous record as a view.
+   /// \see BtrieveFile::RecordRetrievePrevious
+   Btrieve::StatusCode RecordRetrievePrevious(BtrieveRecordView *btrieveRecordView, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE);
+   /// \brief Release the current view, unpinning its page, without moving the cursor.
+   Btrieve::StatusCode Release();
+
+private:
+   btrieve_file_t GetBtrieveFile();
+
+   BtrieveFile *btrieveFile;
+};
+
+/// \brief Retrieves the records of many keys of an index in one walk of the index.
+/// \details The keys are searched for in index order, so keys that share index pages share their
+/// reads, and the results come back in the order the keys were given. The cursor of the file
+/// doesn't move. See btrieveEngineC.h.
+class LINKAGE BtrieveMultiGetter
+{
+public:
+   /// \param[in] btrieveFile The file, which must outlive the getter.
+   explicit BtrieveMultiGetter(BtrieveFile *btrieveFile);
+
+   /// \brief Retrieve the record of every key, as BtrieveFile::RecordRetrieve with Btrieve::COMPARISON_EQUAL would.
+   /// \param[in] index The index.
+   /// \param[in] keys The keys, keyCount of keyLength bytes each, back to back.
+   /// \param[in] keyLength The length of each key.
+   /// \param[in] keyCount The number of keys.
+   /// \param[out] records The records, keyCount buffers of recordSize bytes each, back to back, or NULL if recordSize is zero.
+   /// \param[in] recordSize The size of each record buffer; zero asks for the status codes alone.
+   /// \param[out] recordLengths The length copied to each record buffer, or NULL.
+   /// \param[out] statusCodes The status code of each key: Btrieve::STATUS_CODE_NO_ERROR, Btrieve::STATUS_CODE_KEY_VALUE_NOT_FOUND or Btrieve::STATUS_CODE_DATALENGTH_ERROR.
+   /// \retval "= Btrieve::STATUS_CODE_NO_ERROR" Every key was searched for; see statusCodes.
+   /// \retval "!= Btrieve::STATUS_CODE_NO_ERROR" \ERROR_HAS_OCCURRED
+   Btrieve::StatusCode MultiGet(Btrieve::Index index, const char *keys, int keyLength, int keyCount, char *records, int recordSize, int *recordLengths, Btrieve::StatusCode *statusCodes);
+
+   /// \brief Get the number of index pages the last MultiGet read.
+   long long GetPageReadCount() const { return statistics.pageReadCount; }
+   /// \brief Get how many fewer index pages the last MultiGet read than one retrieval per key would have.
+   long long GetSavedPageReadCount() const { return statistics.savedPageReadCount; }
+
+private:
+   btrieve_file_t GetBtrieveFile();
+
+   BtrieveFile *btrieveFile;
+   btrieve_multi_get_statistics_t statistics;
+};
+
+/// \brief The counters of the Bloom filter of an index, taken from file information.
+/// \details See btrieveEngineC.h.
+class LINKAGE BtrieveBloomFilterStatistics
+{
+public:
+   BtrieveBloomFilterStatistics();
+
+   /// \brief Get the statistics of an index.
+   /// \param[in] btrieveFileInformation The file information, filled in by BtrieveFile::GetInformation.
+   /// \param[in] index The index.
+   /// \retval "= Btrieve::STATUS_CODE_NO_ERROR" \SUCCESS
+   /// \retval "!= Btrieve::STATUS_CODE_NO_ERROR" \ERROR_HAS_OCCURRED
+   Btrieve::StatusCode Get(BtrieveFileInformation *btrieveFileInformation, Btrieve::Index index);
+
+   /// \brief Return true if the index has a filter now.
+   bool IsEnabled() const { return statistics.enabled != 0; }
+   /// \brief Get the number of keys in the filter.
+   long long GetKeyCount() const { return (long long)statistics.keyCount; }
+   /// \brief Get the number of bits in the filter.
+   long long GetBitCount() const { return (long long)statistics.bitCount; }
+   /// \brief Get the number of equal key retrievals the filter was asked about.
+   long long GetLookupCount() const { return (long long)statistics.lookupCount; }
+   /// \brief Get the number of retrievals the filter answered without reading the index.
+   long long GetNegativeCount() const { return (long long)statistics.negativeCount; }
+   /// \brief Get the number of retrievals the filter passed that found no key.
+   long long GetFalsePositiveCount() const { return (long long)statistics.falsePositiveCount; }
+   /// \brief Get the share of retrievals of missing keys the filter passed.
+   double GetFalsePositiveRate() const { return statistics.falsePositiveRate; }
+   /// \brief Get the false positive rate predicted from how full the filter is.
+   double GetEstimatedFalsePositiveRate() const { return statistics.estimatedFalsePositiveRate; }
+
+private:
+   btrieve_bloom_filter_statistics_t statistics;
+};
+
+/// \brief Creates indexes on several threads, and reports the progress of each build.
+/// \details See btrieveEngineC.h.
+class LINKAGE BtrieveIndexBuilder
+{
+public:
+   /// \param[in] btrieveFile The file, which must outlive the builder.
+   explicit BtrieveIndexBuilder(BtrieveFile *btrieveFile);
+
+   /// \brief Set the number of threads; zero, the default, means one per core.
+   void SetThreadCount(int threadCount) { options.threadCount = threadCount; }
+   /// \brief Set the function called, on the thread that called IndexCreate, with the progress of each build.
+   /// \param[in] callback The function, or NULL for none. It mustn't use the file.
+   /// \param[in] context Passed to the function as is.
+   void SetProgressCallback(btrieve_index_build_callback_t callback, void *context = NULL) { options.callback = callback; options.context = context; }
+
+   /// \brief Create an index, as BtrieveFile::IndexCreate does.
+   /// \param[in] btrieveIndexAttributes The index attributes.
+   /// \retval "= Btrieve::STATUS_CODE_NO_ERROR" \SUCCESS
+   /// \retval "!= Btrieve::STATUS_CODE_NO_ERROR" \ERROR_HAS_OCCURRED
+   Btrieve::StatusCode IndexCreate(BtrieveIndexAttributes *btrieveIndexAttributes);
+
+private:
+   btrieve_file_t GetBtrieveFile();
+
+   BtrieveFile *btrieveFile;
+   btrieve_index_build_options_t options;
+};
+
+/// \brief Tells the system how the pages of a file will be read.
+/// \details See btrieveEngineC.h.
+class LINKAGE BtrieveAccessHinter
+{
+public:
+   /// \param[in] btrieveFile The file, which must outlive the hinter.
+   explicit BtrieveAccessHinter(BtrieveFile *btrieveFile);
+
+   /// \brief Set the access hint of the file, for every handle of it.
+   /// \param[in] hint The hint.
+   /// \retval "= Btrieve::STATUS_CODE_NO_ERROR" \SUCCESS
+   /// \retval "!= Btrieve::STATUS_CODE_NO_ERROR" \ERROR_HAS_OCCURRED
+   Btrieve::StatusCode SetAccessHint(btrieve_access_hint_t hint);
+
+private:
+   btrieve_file_t GetBtrieveFile();
+
+   BtrieveFile *btrieveFile;
+};
+
+#endif
@@ -0,0 +1,429 @@
+// btrieveFileCache.h : A cache of open BtrieveFile handles, so requests that
+//                      open and close the same files reuse the handles.
+//
+// A BtrieveFileCache keeps the files a client opens, keyed by file name,
+// owner name, open mode and location mode, and hands each request an idle
+// handle of its key, opening the file again when every one is held:
+//
+//    BtrieveFileCache btrieveFileCache(&btrieveClient);
+//    BtrieveFile *btrieveFile;
+//
+//    if (btrieveFileCache.Acquire(&btrieveFile, "squares.btr", NULL, Btrieve::OPEN_MODE_READ_ONLY) == Btrieve::STATUS_CODE_NO_ERROR)
+//    {
+//       ...
+//       btrieveFileCache.Release(btrieveFile);
+//    }
+//
+// or, with a handle that releases the file when it goes out of scope:
+//
+//    BtrieveFileCache::Handle handle(&btrieveFileCache, "squares.btr", NULL, Btrieve::OPEN_MODE_READ_ONLY);
+//
+// A handle has one holder at a time, so threads never share a cursor, but
+// a holder gets whatever position the last one left: it must position the
+// handle before reading, as a keyed RecordRetrieve does, and must not hold
+// a transaction or lock across a release.
+//
+// A handle nobody holds stays open until it has been idle for the idle
+// time, or until room is needed: the cache holds at most maximumHandles
+// handles, of one key or many, and when it's full, or the engine runs out
+// of open files, the handle released longest ago is closed. When every
+// handle is held, an Acquire that finds no idle handle of its key fails
+// with Btrieve::STATUS_CODE_MAXIMUM_OPEN_FILES.
+//
+// Handles are opened and closed outside the cache's latch, so a slow close
+// holds up only other opens and closes; the client should not open or close
+// files elsewhere while other threads use the cache.
+
+#ifndef _BTRIEVEFILECACHE_H
+#define _BTRIEVEFILECACHE_H
+
+#include <assert.h>
+#include <limits.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <chrono>
+#include <list>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "btrieveCpp.h"
+
+/// \brief A bounded cache of the open files of a client, released longest ago first out.
+class BtrieveFileCache
+{
+public:
+   /// \brief The most handles a cache holds unless its constructor says otherwise.
+   static const int DEFAULT_MAXIMUM_HANDLES = 64;
+   /// \brief How long a handle nobody holds stays open unless the constructor says otherwise.
+   static const int DEFAULT_IDLE_MILLISECONDS = 60000;
+
+   /// \brief The cache's counters, since it was created.
+   struct Statistics
+   {
+      long long hitCount;                                               ///< Acquires served by an idle handle.
+      long long missCount;                                              ///< Acquires that opened another handle.
+      long long evictionCount;                                          ///< Idle handles closed to make room.
+      long long idleEvictionCount;                                      ///< Handles closed after the idle time.
+      long long failureCount;                                           ///< Acquires that failed.
+      int handleCount;                                                  ///< Handles open, or being opened, now.
+      int inUseCount;                                                   ///< Handles held now.
+
+      /// \brief Get the share of acquires served by an idle handle.
+      double GetHitRatio() const
+      {
+         return (hitCount + missCount > 0) ? (double)hitCount / (double)(hitCount + missCount) : 0.0;
+      }
+   };
+
+   /// \brief A file acquired from a cache for the lifetime of the handle.
+   class Handle
+   {
+   public:
+      Handle(BtrieveFileCache *btrieveFileCache, const char *fileName, const char *ownerName, Btrieve::OpenMode openMode, Btrieve::LocationMode locationMode = Btrieve::LOCATION_MODE_NO_PREFERENCE)
+         : btrieveFileCache(btrieveFileCache), btrieveFile(NULL)
+      {
+         lastStatusCode = btrieveFileCache->Acquire(&btrieveFile, fileName, ownerName, openMode, locationMode);
+      }
+
+      ~Handle()
+      {
+         if (btrieveFile != NULL)
+            btrieveFileCache->Release(btrieveFile);
+      }
+
+      /// \brief Get the status of the acquire.
+      Btrieve::StatusCode GetLastStatusCode() const
+      {
+         return lastStatusCode;
+      }
+
+      /// \brief Get the file, or NULL if the acquire failed.
+      BtrieveFile *Get() const
+      {
+         return btrieveFile;
+      }
+
+      BtrieveFile *operator->() const
+      {
+         assert(btrieveFile != NULL);
+         return btrieveFile;
+      }
+
+   private:
+      Handle(const Handle &);
+      Handle &operator=(const Handle &);
+
+      BtrieveFileCache *btrieveFileCache;
+      BtrieveFile *btrieveFile;
+      Btrieve::StatusCode lastStatusCode;
+   };
+
+   /// \param[in] btrieveClient The client that opens and closes the files.
+   /// \param[in] maximumHandles The most handles the cache holds.
+   /// \param[in] idleMilliseconds How long a handle nobody holds stays open; zero keeps it until room is needed.
+   explicit BtrieveFileCache(BtrieveClient *btrieveClient, int maximumHandles = DEFAULT_MAXIMUM_HANDLES, int idleMilliseconds = DEFAULT_IDLE_MILLISECONDS)
+      : btrieveClient(btrieveClient), maximumHandles((maximumHandles > 0) ? maximumHandles : 1), idleMilliseconds((idleMilliseconds > 0) ? idleMilliseconds : 0)
+   {
+      memset(&statistics, 0, sizeof(statistics));
+   }
+
+   /// \brief Close every handle; none may be held.
+   ~BtrieveFileCache()
+   {
+      std::multimap<Key, Entry *>::iterator entry;
+      std::vector<Entry *> evicted;
+
+      for (entry = entries.begin(); entry != entries.end(); ++entry)
+      {
+         assert(!entry->second->held);
+         evicted.push_back(entry->second);
+      }
+      Close(&evicted);
+   }
+
+   /// \brief Get an idle handle of a key, opening the file again if every one is held.
+   /// \param[out] btrieveFile The file.
+   /// \param[in] fileName The file name.
+   /// \param[in] ownerName The owner name, if any.
+   /// \param[in] openMode The open mode.
+   /// \param[in] locationMode The location mode.
+   /// \retval Btrieve::STATUS_CODE_MAXIMUM_OPEN_FILES Every handle is held and there's no room for another.
+   Btrieve::StatusCode Acquire(BtrieveFile **btrieveFile, const char *fileName, const char *ownerName, Btrieve::OpenMode openMode, Btrieve::LocationMode locationMode = Btrieve::LOCATION_MODE_NO_PREFERENCE)
+   {
+      std::vector<Entry *> evicted;
+      Btrieve::StatusCode status;
+      Entry *entry = NULL;
+      bool hit = false;
+      bool room;
+
+      if (btrieveFile == NULL || fileName == NULL)
+         return Btrieve::STATUS_CODE_INVALID_PTR_PARM;
+      *btrieveFile = NULL;
+
+      Key key(fileName, (ownerName == NULL) ? "" : ownerName, (int)openMode, (int)locationMode);
+
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         EvictExpired(&evicted);
+         if ((entry = FindIdle(key)) != NULL)
+         {
+            idle.erase(entry->idlePosition);
+            entry->held = true;
+            statistics.inUseCount++;
+            statistics.hitCount++;
+            hit = true;
+            status = Btrieve::STATUS_CODE_NO_ERROR;
+         }
+         else
+         {
+            statistics.missCount++;
+            status = Reserve(&entry, key, &evicted);
+         }
+      }
+      Close(&evicted);
+      if (status != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      if (hit)
+      {
+         *btrieveFile = entry->file;
+         return Btrieve::STATUS_CODE_NO_ERROR;
+      }
+
+      // The engine may run out of open files before the cache is full; make room and try again.
+      for (;;)
+      {
+         {
+            std::lock_guard<std::mutex> guard(clientLatch);
+
+            status = btrieveClient->FileOpen(entry->file, fileName, ownerName, openMode, locationMode);
+         }
+         if (status != Btrieve::STATUS_CODE_MAXIMUM_OPEN_FILES)
+            break;
+         {
+            std::lock_guard<std::mutex> guard(latch);
+
+            room = EvictOldest(&evicted);
+         }
+         if (!room)
+            break;
+         Close(&evicted);
+      }
+
+      std::lock_guard<std::mutex> guard(latch);
+
+      if (status != Btrieve::STATUS_CODE_NO_ERROR)
+      {
+         files.erase(entry->file);
+         entries.erase(entry->position);
+         statistics.inUseCount--;
+         statistics.failureCount++;
+         delete entry->file;
+         delete entry;
+         return status;
+      }
+      *btrieveFile = entry->file;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Give back a file Acquire returned; the handle stays open while it's idle.
+   void Release(BtrieveFile *btrieveFile)
+   {
+      std::vector<Entry *> evicted;
+
+      {
+         std::lock_guard<std::mutex> guard(latch);
+         std::map<BtrieveFile *, Entry *>::iterator found = files.find(btrieveFile);
+         Entry *entry;
+
+         assert(found != files.end() && found->second->held);
+         if (found == files.end() || !found->second->held)
+            return;
+
+         entry = found->second;
+         entry->held = false;
+         entry->released = std::chrono::steady_clock::now();
+         entry->idlePosition = idle.insert(idle.end(), entry);
+         statistics.inUseCount--;
+         EvictExpired(&evicted);
+      }
+      Close(&evicted);
+   }
+
+   /// \brief Close the handles of a file that nobody holds, as before deleting or renaming it.
+   /// \return Whether no handle of the file is left open.
+   bool Evict(const char *fileName)
+   {
+      std::vector<Entry *> evicted;
+      bool closed = true;
+
+      {
+         std::lock_guard<std::mutex> guard(latch);
+         std::multimap<Key, Entry *>::iterator entry = entries.lower_bound(Key(fileName, "", INT_MIN, INT_MIN));
+
+         while (entry != entries.end() && std::get<0>(entry->first) == fileName)
+         {
+            Entry *candidate = entry->second;
+
+            ++entry;
+            if (candidate->held)
+               closed = false;
+            else
+               Remove(candidate, &evicted);
+         }
+      }
+      Close(&evicted);
+      return closed;
+   }
+
+   /// \brief Close the handles that have been idle for the idle time.
+   void EvictIdle()
+   {
+      std::vector<Entry *> evicted;
+
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         EvictExpired(&evicted);
+      }
+      Close(&evicted);
+   }
+
+   /// \brief Get the cache's counters.
+   Statistics GetStatistics()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+      Statistics snapshot = statistics;
+
+      snapshot.handleCount = (int)entries.size();
+      return snapshot;
+   }
+
+private:
+   BtrieveFileCache(const BtrieveFileCache &);
+   BtrieveFileCache &operator=(const BtrieveFileCache &);
+
+   typedef std::tuple<std::string, std::string, int, int> Key;         // The file name, owner name, open mode and location mode.
+
+   struct Entry
+   {
+      Entry()
+         : file(NULL), held(false)
+      {
+      }
+
+      BtrieveFile *file;
+      bool held;
+      std::multimap<Key, Entry *>::iterator position;
+      std::list<Entry *>::iterator idlePosition;                        // Set while nobody holds it.
+      std::chrono::steady_clock::time_point released;
+   };
+
+   // Find the idle handle of a key released last, or NULL if every one is held.
+   Entry *FindIdle(const Key &key)
+   {
+      std::pair<std::multimap<Key, Entry *>::iterator, std::multimap<Key, Entry *>::iterator> range = entries.equal_range(key);
+      Entry *found = NULL;
+
+      for (; range.first != range.second; ++range.first)
+         if (!range.first->second->held && (found == NULL || range.first->second->released > found->released))
+            found = range.first->second;
+      return found;
+   }
+
+   // Add a held handle of a key for the caller to open, making room for it first.
+   Btrieve::StatusCode Reserve(Entry **reserved, const Key &key, std::vector<Entry *> *evicted)
+   {
+      Entry *entry;
+
+      if ((int)entries.size() >= maximumHandles && !EvictOldest(evicted))
+      {
+         statistics.failureCount++;
+         return Btrieve::STATUS_CODE_MAXIMUM_OPEN_FILES;
+      }
+      if ((entry = new (std::nothrow) Entry()) == NULL || (entry->file = new (std::nothrow) BtrieveFile()) == NULL)
+      {
+         delete entry;
+         statistics.failureCount++;
+         return Btrieve::STATUS_CODE_NO_OS_MEMORY_AVAIL;
+      }
+
+      entry->held = true;
+      entry->position = entries.insert(std::make_pair(key, entry));
+      files[entry->file] = entry;
+      statistics.inUseCount++;
+      *reserved = entry;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   // Forget the handle released longest ago, to close; false if every handle is held.
+   bool EvictOldest(std::vector<Entry *> *evicted)
+   {
+      if (idle.empty())
+         return false;
+      Remove(idle.front(), evicted);
+      statistics.evictionCount++;
+      return true;
+   }
+
+   // Forget the handles, oldest first, that have been idle for the idle time, to close.
+   void EvictExpired(std::vector<Entry *> *evicted)
+   {
+      std::chrono::steady_clock::time_point now;
+
+      if (idleMilliseconds == 0 || idle.empty())
+         return;
+      now = std::chrono::steady_clock::now();
+      while (!idle.empty() && now - idle.front()->released >= std::chrono::milliseconds(idleMilliseconds))
+      {
+         Remove(idle.front(), evicted);
+         statistics.idleEvictionCount++;
+      }
+   }
+
+   // Forget an idle handle, to close once the latch is released.
+   void Remove(Entry *entry, std::vector<Entry *> *evicted)
+   {
+      idle.erase(entry->idlePosition);
+      files.erase(entry->file);
+      entries.erase(entry->position);
+      evicted->push_back(entry);
+   }
+
+   // Close the handles forgotten under the latch, without holding it.
+   void Close(std::vector<Entry *> *evicted)
+   {
+      std::vector<Entry *>::iterator entry;
+
+      if (evicted->empty())
+         return;
+
+      std::lock_guard<std::mutex> guard(clientLatch);
+
+      for (entry = evicted->begin(); entry != evicted->end(); ++entry)
+      {
+         btrieveClient->FileClose((*entry)->file);
+         delete (*entry)->file;
+         delete *entry;
+      }
+      evicted->clear();
+   }
+
+   BtrieveClient *btrieveClient;
+   int maximumHandles;
+   int idleMilliseconds;
+
+   std::mutex latch;                                                    // Guards the handles and counters.
+   std::mutex clientLatch;                                              // Serializes the opens and closes on the client; never taken with the latch held.
+   std::multimap<Key, Entry *> entries;                                 // Every handle, held, idle or being opened.
+   std::map<BtrieveFile *, Entry *> files;
+   std::list<Entry *> idle;                                             // The handles nobody holds, released longest ago first.
+   Statistics statistics;
+};
+
+#endif
@@ -0,0 +1,441 @@
+// btrieveParallelScan.h : A full scan of a file split into partitions that
+//                         are read side by side, each on a thread of its own.
+//
+// A BtrieveParallelScan opens a handle of its own on the file for each
+// partition. Scan positions the handle of partition p at the record
+// RecordRetrieveByFraction finds at p / partitionCount of the index, then
+// reads the partition with BulkRetrieveNext on its own thread, in batches a
+// BtrieveAdaptiveRetriever sizes, up to the record the next partition
+// starts with. Each partition's records go to a consumer of its own:
+//
+//    BtrieveParallelScan scan(&btrieveClient, "squares.btr");
+//    std::vector<Summer> summers(scan.GetPartitionCount());
+//
+//    scan.Scan(Btrieve::INDEX_1, summers.data());
+//
+// or, with ScanOrdered, to one consumer on the calling thread in the order
+// of the index, partition after partition, while the threads read ahead:
+//
+//    scan.ScanOrdered(Btrieve::INDEX_1, [&](const BtrieveRangeRow &row) { ... });
+//
+// A consumer is called with a BtrieveRangeRow, valid for the call. The
+// partitions meet at records, by cursor position, so every record is read
+// once, provided the file isn't changed during the scan. Fractions of a
+// small file can find the same record, which leaves some partitions empty.
+// The client must not be used by another thread while the scan opens or
+// closes its handles, in its constructor and destructor.
+
+#ifndef _BTRIEVEPARALLELSCAN_H
+#define _BTRIEVEPARALLELSCAN_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "btrieveAdaptiveRetriever.h"
+#include "btrieveCpp.h"
+#include "btrieveRange.h"
+
+/// \brief A full scan of a file, in partitions read in parallel.
+class BtrieveParallelScan
+{
+public:
+   /// \brief The number of batches a partition reads ahead of ScanOrdered's consumer.
+   static const int QUEUE_DEPTH = 4;
+
+   /// \param[in] btrieveClient The client that opens the scan's handles.
+   /// \param[in] fileName The file.
+   /// \param[in] ownerName The owner name, if any.
+   /// \param[in] partitionCount The number of partitions and threads; zero for one per hardware thread.
+   BtrieveParallelScan(BtrieveClient *btrieveClient, const char *fileName, const char *ownerName = NULL, int partitionCount = 0)
+      : btrieveClient(btrieveClient), openStatus(Btrieve::STATUS_CODE_NO_ERROR), stopping(false)
+   {
+      if (partitionCount <= 0)
+         partitionCount = (std::thread::hardware_concurrency() > 0) ? (int)std::thread::hardware_concurrency() : 1;
+
+      for (int p = 0; p < partitionCount && openStatus == Btrieve::STATUS_CODE_NO_ERROR; p++)
+      {
+         Partition *partition = new (std::nothrow) Partition();
+
+         if (partition == NULL)
+         {
+            openStatus = Btrieve::STATUS_CODE_NO_OS_MEMORY_AVAIL;
+            break;
+         }
+         if ((openStatus = btrieveClient->FileOpen(&partition->btrieveFile, fileName, ownerName, Btrieve::OPEN_MODE_READ_ONLY)) != Btrieve::STATUS_CODE_NO_ERROR)
+         {
+            delete partition;
+            break;
+         }
+         partitions.push_back(partition);
+      }
+   }
+
+   ~BtrieveParallelScan()
+   {
+      for (size_t p = 0; p < partitions.size(); p++)
+      {
+         btrieveClient->FileClose(&partitions[p]->btrieveFile);
+         Release(partitions[p]);
+         delete partitions[p];
+      }
+   }
+
+   /// \brief Get the number of partitions.
+   int GetPartitionCount() const
+   {
+      return (int)partitions.size();
+   }
+
+   /// \brief Get the cursor position of the first record of a partition in the last scan, or -1 if it was empty.
+   long long GetPartitionStart(int partitionNumber) const
+   {
+      return partitions[partitionNumber]->start;
+   }
+
+   /// \brief Get the number of records a partition held in the last scan.
+   long long GetPartitionRecordCount(int partitionNumber) const
+   {
+      return partitions[partitionNumber]->recordCount;
+   }
+
+   /// \brief Scan the file, giving each partition's records to its consumer on the partition's thread.
+   /// \param[in] index The index to scan in the order of, or Btrieve::INDEX_NONE for physical order.
+   /// \param[in] consumers GetPartitionCount consumers, called as consumers[p](row).
+   /// \return The first status a partition failed with, or Btrieve::STATUS_CODE_NO_ERROR.
+   template <typename Consumer>
+   Btrieve::StatusCode Scan(Btrieve::Index index, Consumer *consumers)
+   {
+      std::vector<std::thread> threads;
+      Btrieve::StatusCode status;
+
+      if ((status = Split(index)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+
+      for (size_t p = 0; p < partitions.size(); p++)
+      {
+         Consumer *consumer = &consumers[p];
+
+         threads.push_back(std::thread([this, p, consumer] { Read(partitions[p], *consumer); }));
+      }
+      for (size_t p = 0; p < threads.size(); p++)
+         threads[p].join();
+      return Finish();
+   }
+
+   /// \brief Scan the file, giving every record to one consumer on the calling thread, in the order of the index.
+   /// \param[in] index The index to scan in the order of, or Btrieve::INDEX_NONE for physical order.
+   /// \param[in] consumer Called as consumer(row).
+   /// \return The first status a partition failed with, or Btrieve::STATUS_CODE_NO_ERROR.
+   template <typename Consumer>
+   Btrieve::StatusCode ScanOrdered(Btrieve::Index index, Consumer consumer)
+   {
+      std::vector<std::thread> threads;
+      Btrieve::StatusCode status;
+
+      if ((status = Split(index)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+
+      for (size_t p = 0; p < partitions.size(); p++)
+      {
+         Partition *partition = partitions[p];
+
+         threads.push_back(std::thread([this, partition] { Queue queue(this, partition); Read(partition, queue); }));
+      }
+
+      for (size_t p = 0; p < partitions.size() && !IsStopping(); p++)
+      {
+         Batch *batch;
+
+         while ((batch = Take(partitions[p])) != NULL)
+         {
+            for (size_t i = 0; i < batch->rows.size(); i++)
+               consumer(batch->rows[i]);
+            delete batch;
+         }
+      }
+
+      Stop();
+      for (size_t p = 0; p < threads.size(); p++)
+         threads[p].join();
+      return Finish();
+   }
+
+private:
+   // Records read by a partition for ScanOrdered; the rows point into the data.
+   struct Batch
+   {
+      std::vector<char> data;
+      std::vector<int> offsets;
+      std::vector<BtrieveRangeRow> rows;
+   };
+
+   struct Partition
+   {
+      BtrieveFile btrieveFile;
+      long long start;                                                  // The cursor position of the first record, or -1 if empty.
+      long long end;                                                    // The cursor position of the next partition's first record, or -1.
+      Btrieve::StatusCode status;
+      long long recordCount;
+      std::deque<Batch *> batches;
+      bool finished;
+   };
+
+   // Collects a partition's records into batches for the calling thread.
+   class Queue
+   {
+   public:
+      Queue(BtrieveParallelScan *scan, Partition *partition)
+         : scan(scan), partition(partition), batch(NULL)
+      {
+      }
+
+      ~Queue()
+      {
+         delete batch;
+      }
+
+      bool operator()(const BtrieveRangeRow &row)
+      {
+         if (batch == NULL && (batch = new (std::nothrow) Batch()) == NULL)
+            return false;
+         batch->offsets.push_back((int)batch->data.size());
+         batch->data.insert(batch->data.end(), row.record, row.record + row.length);
+         batch->rows.push_back(row);
+         return true;
+      }
+
+      // Hand the records collected so far to the calling thread, waiting for room in the partition's queue.
+      bool Flush()
+      {
+         Batch *full = batch;
+
+         if (full == NULL)
+            return true;
+         batch = NULL;
+         for (size_t i = 0; i < full->rows.size(); i++)
+            full->rows[i].record = full->data.data() + full->offsets[i];
+         return scan->Put(partition, full);
+      }
+
+   private:
+      BtrieveParallelScan *scan;
+      Partition *partition;
+      Batch *batch;
+   };
+
+   BtrieveParallelScan(const BtrieveParallelScan &);
+   BtrieveParallelScan &operator=(const BtrieveParallelScan &);
+
+   // Position each partition's handle at its first record, and find where each partition ends.
+   Btrieve::StatusCode Split(Btrieve::Index index)
+   {
+      std::vector<char> record(Btrieve::MAXIMUM_RECORD_LENGTH);
+      long long previous = -1;
+
+      if (openStatus != Btrieve::STATUS_CODE_NO_ERROR)
+         return openStatus;
+      stopping = false;
+
+      for (size_t p = 0; p < partitions.size(); p++)
+      {
+         Partition *partition = partitions[p];
+         BtrieveFile *btrieveFile = &partition->btrieveFile;
+         int length;
+
+         Release(partition);
+         partition->start = -1;
+         partition->end = -1;
+         partition->status = Btrieve::STATUS_CODE_NO_ERROR;
+         partition->recordCount = 0;
+         partition->finished = false;
+
+         if (p == 0)
+            length = btrieveFile->RecordRetrieveFirst(index, record.data(), (int)record.size());
+         else
+            length = btrieveFile->RecordRetrieveByFraction(index, (int)p, (int)partitions.size(), record.data(), (int)record.size());
+         if (length < 0)
+         {
+            if (btrieveFile->GetLastStatusCode() != Btrieve::STATUS_CODE_END_OF_FILE)
+               return btrieveFile->GetLastStatusCode();
+            continue;
+         }
+
+         // A fraction that finds the record an earlier one found leaves its partition empty.
+         if (btrieveFile->GetCursorPosition() == previous)
+            continue;
+         partition->start = previous = btrieveFile->GetCursorPosition();
+      }
+
+      for (size_t p = 0, next = 1; p < partitions.size(); p++)
+      {
+         if (partitions[p]->start < 0)
+            continue;
+         for (next = p + 1; next < partitions.size() && partitions[next]->start < 0; next++)
+            ;
+         partitions[p]->end = (next < partitions.size()) ? partitions[next]->start : -1;
+      }
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   // Read a partition, on its thread, giving its records to a sink that returns false to stop.
+   template <typename Sink>
+   void Read(Partition *partition, Sink &sink)
+   {
+      BtrieveBulkRetrieveAttributes btrieveBulkRetrieveAttributes;
+      BtrieveAdaptiveRetriever retriever(&partition->btrieveFile, &btrieveBulkRetrieveAttributes);
+      std::vector<char> record(Btrieve::MAXIMUM_RECORD_LENGTH);
+      Btrieve::StatusCode status = Btrieve::STATUS_CODE_NO_ERROR;
+      bool ended = (partition->start < 0);
+
+      while (!ended && !IsStopping())
+      {
+         BtrieveBulkRetrieveResult btrieveBulkRetrieveResult;
+         int count;
+
+         status = retriever.Next(&btrieveBulkRetrieveResult);
+         if (status != Btrieve::STATUS_CODE_NO_ERROR && status != Btrieve::STATUS_CODE_END_OF_FILE)
+            break;
+         ended = (status == Btrieve::STATUS_CODE_END_OF_FILE);
+         status = Btrieve::STATUS_CODE_NO_ERROR;
+
+         count = btrieveBulkRetrieveResult.GetRecordCount();
+         for (int i = 0; i < count; i++)
+         {
+            BtrieveRangeRow row;
+
+            // The next partition's first record ends this one.
+            if ((row.cursorPosition = btrieveBulkRetrieveResult.GetRecordCursorPosition(i)) == partition->end)
+            {
+               ended = true;
+               break;
+            }
+            if ((row.length = btrieveBulkRetrieveResult.GetRecord(i, record.data(), (int)record.size())) < 0)
+            {
+               status = btrieveBulkRetrieveResult.GetLastStatusCode();
+               break;
+            }
+            row.record = record.data();
+            if (!Deliver(sink, row))
+            {
+               status = Btrieve::STATUS_CODE_NO_OS_MEMORY_AVAIL;
+               break;
+            }
+            partition->recordCount++;
+         }
+
+         if (status != Btrieve::STATUS_CODE_NO_ERROR || !Flush(sink))
+            break;
+      }
+
+      std::lock_guard<std::mutex> guard(latch);
+
+      partition->status = status;
+      partition->finished = true;
+      if (status != Btrieve::STATUS_CODE_NO_ERROR)
+         stopping = true;
+      changed.notify_all();
+   }
+
+   template <typename Consumer>
+   static bool Deliver(Consumer &consumer, const BtrieveRangeRow &row)
+   {
+      consumer(row);
+      return true;
+   }
+
+   static bool Deliver(Queue &queue, const BtrieveRangeRow &row)
+   {
+      return queue(row);
+   }
+
+   template <typename Consumer>
+   static bool Flush(Consumer &)
+   {
+      return true;
+   }
+
+   static bool Flush(Queue &queue)
+   {
+      return queue.Flush();
+   }
+
+   // Queue a batch for the calling thread; false if the scan is stopping.
+   bool Put(Partition *partition, Batch *batch)
+   {
+      std::unique_lock<std::mutex> guard(latch);
+
+      while (!stopping && partition->batches.size() >= (size_t)QUEUE_DEPTH)
+         changed.wait(guard);
+      if (stopping)
+      {
+         delete batch;
+         return false;
+      }
+      partition->batches.push_back(batch);
+      changed.notify_all();
+      return true;
+   }
+
+   // Take a partition's next batch, waiting for it; NULL once the partition is done or the scan stops.
+   Batch *Take(Partition *partition)
+   {
+      std::unique_lock<std::mutex> guard(latch);
+      Batch *batch;
+
+      while (!stopping && partition->batches.empty() && !partition->finished)
+         changed.wait(guard);
+      if (stopping || partition->batches.empty())
+         return NULL;
+      batch = partition->batches.front();
+      partition->batches.pop_front();
+      changed.notify_all();
+      return batch;
+   }
+
+   bool IsStopping()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return stopping;
+   }
+
+   void Stop()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      stopping = true;
+      changed.notify_all();
+   }
+
+   // The first status a partition failed with.
+   Btrieve::StatusCode Finish()
+   {
+      for (size_t p = 0; p < partitions.size(); p++)
+      {
+         Release(partitions[p]);
+         if (partitions[p]->status != Btrieve::STATUS_CODE_NO_ERROR)
+            return partitions[p]->status;
+      }
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   static void Release(Partition *partition)
+   {
+      for (size_t i = 0; i < partition->batches.size(); i++)
+         delete partition->batches[i];
+      partition->batches.clear();
+   }
+
+   BtrieveClient *btrieveClient;
+   Btrieve::StatusCode openStatus;
+   std::vector<Partition *> partitions;
+   std::mutex latch;
+   std::condition_variable changed;
+   bool stopping;
+};
+
+#endif
@@ -0,0 +1,506 @@
+// btrievePredicate.h : Predicates compiled into BtrieveFilter chains.
+//
+// A BtrievePredicate is a tree of field comparisons joined by AND and OR.
+// A BtrieveQuery compiles one into the BtrieveFilter chain a bulk retrieve
+// evaluates, and turns the fields the caller selects into AddField calls,
+// so records are filtered and cut down in the engine rather than after
+// they're transferred:
+//
+//    BtrieveQuery query;
+//
+//    query.SetPredicate((BtrievePredicate::Compare(BTRIEVE_FIELD(record_t, y), Btrieve::COMPARISON_GREATER_THAN, low)
+//       || BtrievePredicate::Like(BTRIEVE_FIELD(record_t, name), "A%"))
+//       && BtrievePredicate::CompareFields(BTRIEVE_FIELD(record_t, x), Btrieve::COMPARISON_LESS_THAN, BTRIEVE_FIELD(record_t, y)));
+//    query.Select(BTRIEVE_FIELD(record_t, x));
+//    query.ApplyTo(&btrieveBulkRetrieveAttributes);
+//
+// The engine joins the filters of a chain left to right, without
+// precedence, so a chain is a left fold: a || b && c means (a || b) && c.
+// A predicate compiles if each of its ANDs and ORs, once nested ones of
+// the same kind are flattened and duplicate and absorbed operands are
+// dropped, has at most one operand that's itself an AND or an OR; that
+// operand's chain goes first. (a || b) && (c || d) has no chain, and
+// SetPredicate returns Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION for it.
+
+#ifndef _BTRIEVEPREDICATE_H
+#define _BTRIEVEPREDICATE_H
+
+#include <stddef.h>
+#include <string.h>
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "btrieveCpp.h"
+#include "btrieveTable.h"
+
+/// \brief A field of a record: where it lies and how it compares.
+struct BtrieveField
+{
+   int offset;
+   int length;
+   Btrieve::DataType dataType;
+
+   bool operator==(const BtrieveField &other) const
+   {
+      return offset == other.offset && length == other.length && dataType == other.dataType;
+   }
+};
+
+/// \brief The field of a record that a member is, with the data type derived from the member.
+#define BTRIEVE_FIELD(Record, member) BtrieveField{ (int)offsetof(Record, member), (int)sizeof(((Record *)0)->member), BtrieveDataTypeOf<decltype(((Record *)0)->member)>::value }
+
+/// \brief A predicate over the fields of a record; the default one holds for every record.
+/// \details Predicates are immutable and share their operands, so copies are cheap.
+class BtrievePredicate
+{
+   friend class BtrieveQuery;
+
+public:
+   BtrievePredicate()
+   {
+   }
+
+   /// \brief Compare a field with a constant.
+   /// \param[in] field The field.
+   /// \param[in] comparison The comparison.
+   /// \param[in] constant The constant, laid out as the field is.
+   /// \param[in] constantLength The length of the constant, from 1 through Btrieve::MAXIMUM_KEY_LENGTH.
+   static BtrievePredicate Compare(const BtrieveField &field, Btrieve::Comparison comparison, const char *constant, int constantLength)
+   {
+      std::shared_ptr<Node> node = std::make_shared<Node>(COMPARISON);
+
+      node->field = field;
+      node->comparison = comparison;
+      if (constant != NULL && constantLength > 0)
+         node->constant.assign(constant, constant + constantLength);
+      return BtrievePredicate(node);
+   }
+
+   /// \brief Compare a field with a constant held in a \a T, such as an integer or a character array.
+   template <typename T>
+   static BtrievePredicate Compare(const BtrieveField &field, Btrieve::Comparison comparison, const T &constant)
+   {
+      static_assert(std::is_trivially_copyable<T>::value && !std::is_pointer<T>::value, "Pass a pointer constant with its length.");
+      return Compare(field, comparison, (const char *)&constant, (int)sizeof(T));
+   }
+
+   /// \brief Compare a field with another field of the same record, of the same length and data type.
+   static BtrievePredicate CompareFields(const BtrieveField &field, Btrieve::Comparison comparison, const BtrieveField &otherField)
+   {
+      std::shared_ptr<Node> node = std::make_shared<Node>(COMPARISON);
+
+      node->field = field;
+      node->comparison = comparison;
+      node->otherField = otherField;
+      node->hasOtherField = true;
+      return BtrievePredicate(node);
+   }
+
+   /// \brief Match a string field against a pattern, in which '%' matches any run of characters and '_' any one.
+   static BtrievePredicate Like(const BtrieveField &field, const char *pattern)
+   {
+      return Compare(field, Btrieve::COMPARISON_LIKE, pattern, (int)strlen(pattern));
+   }
+
+   /// \brief Match a string field against a pattern, holding where Like doesn't.
+   static BtrievePredicate NotLike(const BtrieveField &field, const char *pattern)
+   {
+      return Compare(field, Btrieve::COMPARISON_NOT_LIKE, pattern, (int)strlen(pattern));
+   }
+
+   /// \brief Hold where both predicates do.
+   static BtrievePredicate And(const BtrievePredicate &left, const BtrievePredicate &right)
+   {
+      return Join(AND, left, right);
+   }
+
+   /// \brief Hold where either predicate does.
+   static BtrievePredicate Or(const BtrievePredicate &left, const BtrievePredicate &right)
+   {
+      return Join(OR, left, right);
+   }
+
+   /// \brief Return the comparison with string fields compared without regard to case.
+   /// \details Only a comparison may ignore case; other predicates are returned unchanged.
+   BtrievePredicate IgnoringCase() const
+   {
+      return WithACS(Btrieve::ACS_MODE_CASE_INSENSITIVE, std::string());
+   }
+
+   /// \brief Return the comparison with string fields compared by a named alternate collation sequence of the file.
+   BtrievePredicate WithACSName(const char *name) const
+   {
+      return WithACS(Btrieve::ACS_MODE_NAMED, std::string(name));
+   }
+
+   /// \brief Return true if the predicate holds for every record.
+   bool IsEmpty() const
+   {
+      return !node;
+   }
+
+private:
+   enum Kind
+   {
+      COMPARISON,
+      AND,
+      OR
+   };
+
+   struct Node
+   {
+      explicit Node(Kind kind)
+         : kind(kind), comparison(Btrieve::COMPARISON_NONE), hasOtherField(false), acsMode(Btrieve::ACS_MODE_NONE)
+      {
+         field.offset = otherField.offset = -1;
+         field.length = otherField.length = 0;
+         field.dataType = otherField.dataType = Btrieve::DATA_TYPE_UNKNOWN;
+      }
+
+      Kind kind;
+
+      // A comparison.
+      BtrieveField field;
+      Btrieve::Comparison comparison;
+      std::vector<char> constant;
+      BtrieveField otherField;
+      bool hasOtherField;
+      Btrieve::ACSMode acsMode;
+      std::string acsName;
+
+      // An AND or an OR.
+      std::vector<BtrievePredicate> operands;
+   };
+
+   explicit BtrievePredicate(const std::shared_ptr<const Node> &node)
+      : node(node)
+   {
+   }
+
+   static BtrievePredicate Join(Kind kind, const BtrievePredicate &left, const BtrievePredicate &right)
+   {
+      // Every record satisfies an empty predicate, so it drops out of an AND and decides an OR.
+      if (left.IsEmpty() || right.IsEmpty())
+      {
+         if (kind == AND)
+            return left.IsEmpty() ? right : left;
+         return BtrievePredicate();
+      }
+
+      std::shared_ptr<Node> node = std::make_shared<Node>(kind);
+
+      node->operands.push_back(left);
+      node->operands.push_back(right);
+      return BtrievePredicate(node);
+   }
+
+   BtrievePredicate WithACS(Btrieve::ACSMode acsMode, const std::string &acsName) const
+   {
+      if (IsEmpty() || node->kind != COMPARISON)
+         return *this;
+
+      std::shared_ptr<Node> copy = std::make_shared<Node>(*node);
+
+      copy->acsMode = acsMode;
+      copy->acsName = acsName;
+      return BtrievePredicate(copy);
+   }
+
+   /// \brief Return true if the predicates have the same form, operand for operand.
+   bool IsSameAs(const BtrievePredicate &other) const
+   {
+      if (node == other.node)
+         return true;
+      if (IsEmpty() || other.IsEmpty() || node->kind != other.node->kind)
+         return false;
+      if (node->kind == COMPARISON)
+         return node->field == other.node->field && node->comparison == other.node->comparison && node->constant == other.node->constant
+            && node->hasOtherField == other.node->hasOtherField && (!node->hasOtherField || node->otherField == other.node->otherField)
+            && node->acsMode == other.node->acsMode && node->acsName == other.node->acsName;
+      if (node->operands.size() != other.node->operands.size())
+         return false;
+      for (size_t i = 0; i < node->operands.size(); i++)
+         if (!node->operands[i].IsSameAs(other.node->operands[i]))
+            return false;
+      return true;
+   }
+
+   /// \brief Return true if \a operand is one of the operands of this AND or OR.
+   bool HasOperand(const BtrievePredicate &operand) const
+   {
+      for (size_t i = 0; i < node->operands.size(); i++)
+         if (node->operands[i].IsSameAs(operand))
+            return true;
+      return false;
+   }
+
+   /// \brief Return the predicate with nested ANDs and ORs of the same kind flattened, and duplicate and absorbed operands dropped.
+   BtrievePredicate Simplify() const
+   {
+      if (IsEmpty() || node->kind == COMPARISON)
+         return *this;
+
+      std::vector<BtrievePredicate> operands;
+      Kind other = (node->kind == AND) ? OR : AND;
+
+      for (size_t i = 0; i < node->operands.size(); i++)
+      {
+         BtrievePredicate operand = node->operands[i].Simplify();
+
+         // a && (b && c) is a && b && c.
+         if (operand.node->kind == node->kind)
+            operands.insert(operands.end(), operand.node->operands.begin(), operand.node->operands.end());
+         else
+            operands.push_back(operand);
+      }
+
+      std::vector<BtrievePredicate> kept;
+
+      for (size_t i = 0; i < operands.size(); i++)
+      {
+         bool redundant = false;
+
+         // a && a is a, and a && (a || b) is a; the same goes for OR and AND.
+         for (size_t j = 0; j < operands.size() && !redundant; j++)
+         {
+            if (j == i)
+               continue;
+            if (operands[j].IsSameAs(operands[i]))
+               redundant = j < i;
+            else if (operands[i].node->kind == other && operands[i].HasOperand(operands[j]))
+               redundant = true;
+         }
+
+         if (!redundant)
+            kept.push_back(operands[i]);
+      }
+
+      if (kept.size() == 1)
+         return kept[0];
+
+      std::shared_ptr<Node> simplified = std::make_shared<Node>(node->kind);
+
+      simplified->operands = kept;
+      return BtrievePredicate(simplified);
+   }
+
+   std::shared_ptr<const Node> node;
+};
+
+/// \brief Hold where both predicates do.
+inline BtrievePredicate operator&&(const BtrievePredicate &left, const BtrievePredicate &right)
+{
+   return BtrievePredicate::And(left, right);
+}
+
+/// \brief Hold where either predicate does.
+inline BtrievePredicate operator||(const BtrievePredicate &left, const BtrievePredicate &right)
+{
+   return BtrievePredicate::Or(left, right);
+}
+
+/// \brief A predicate compiled into a BtrieveFilter chain, and the fields a bulk retrieve returns.
+class BtrieveQuery
+{
+public:
+   BtrieveQuery()
+      : rowLength(0)
+   {
+   }
+
+   /// \brief Compile a predicate into the filter chain, replacing the chain of any earlier one.
+   /// \retval "= Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION" The predicate has no chain, or a comparison is incomplete.
+   Btrieve::StatusCode SetPredicate(const BtrievePredicate &predicate)
+   {
+      std::vector<std::unique_ptr<BtrieveFilter> > compiled;
+      Btrieve::StatusCode status;
+
+      if ((status = Emit(predicate.Simplify(), &compiled)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      filters.swap(compiled);
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Add a field to the rows a bulk retrieve returns, after those already selected.
+   /// \details Rows hold the selected fields one after another; with none selected they hold whole records.
+   /// A field selected again isn't added twice, and fields that follow one another in both the record
+   /// and the row are returned by one AddField.
+   /// \param[in] field The field.
+   /// \param[out] rowOffset Where the field starts in a row, or NULL.
+   Btrieve::StatusCode Select(const BtrieveField &field, int *rowOffset = NULL)
+   {
+      if (field.offset < 0 || field.length <= 0 || field.offset + field.length > Btrieve::MAXIMUM_RECORD_LENGTH)
+         return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+
+      for (size_t i = 0; i < selected.size(); i++)
+      {
+         if (selected[i].first == field)
+         {
+            if (rowOffset != NULL)
+               *rowOffset = selected[i].second;
+            return Btrieve::STATUS_CODE_NO_ERROR;
+         }
+      }
+
+      if (rowLength + field.length > Btrieve::MAXIMUM_RECORD_LENGTH)
+         return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+      if (!extents.empty() && extents.back().first + extents.back().second == field.offset)
+         extents.back().second += field.length;
+      else
+         extents.push_back(std::make_pair(field.offset, field.length));
+      selected.push_back(std::make_pair(field, rowLength));
+      if (rowOffset != NULL)
+         *rowOffset = rowLength;
+      rowLength += field.length;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Add the filters and the selected fields to bulk retrieve attributes that have neither.
+   Btrieve::StatusCode ApplyTo(BtrieveBulkRetrieveAttributes *btrieveBulkRetrieveAttributes)
+   {
+      Btrieve::StatusCode status;
+
+      for (size_t i = 0; i < filters.size(); i++)
+         if ((status = btrieveBulkRetrieveAttributes->AddFilter(filters[i].get())) != Btrieve::STATUS_CODE_NO_ERROR)
+            return status;
+      for (size_t i = 0; i < extents.size(); i++)
+         if ((status = btrieveBulkRetrieveAttributes->AddField(extents[i].first, extents[i].second)) != Btrieve::STATUS_CODE_NO_ERROR)
+            return status;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Get the number of filters in the chain.
+   int GetFilterCount() const
+   {
+      return (int)filters.size();
+   }
+
+   /// \brief Get the number of AddField calls the selected fields take.
+   int GetExtentCount() const
+   {
+      return (int)extents.size();
+   }
+
+   /// \brief Get the number of fields selected.
+   int GetSelectedFieldCount() const
+   {
+      return (int)selected.size();
+   }
+
+   /// \brief Get a selected field, numbered from zero in the order it was selected.
+   const BtrieveField &GetSelectedField(int fieldNumber) const
+   {
+      return selected[fieldNumber].first;
+   }
+
+   /// \brief Get where a selected field starts in a row.
+   int GetRowOffset(int fieldNumber) const
+   {
+      return selected[fieldNumber].second;
+   }
+
+   /// \brief Get the length of a row, or zero if rows hold whole records.
+   int GetRowLength() const
+   {
+      return rowLength;
+   }
+
+private:
+   // Append the chain of a simplified predicate. An AND or an OR appends its compound operand's
+   // chain, if it has one, then joins each comparison on with its own connector.
+   static Btrieve::StatusCode Emit(const BtrievePredicate &predicate, std::vector<std::unique_ptr<BtrieveFilter> > *chain)
+   {
+      if (predicate.IsEmpty())
+         return Btrieve::STATUS_CODE_NO_ERROR;
+
+      const BtrievePredicate::Node *node = predicate.node.get();
+
+      if (node->kind == BtrievePredicate::COMPARISON)
+         return EmitComparison(*node, chain);
+
+      Btrieve::Connector connector = (node->kind == BtrievePredicate::AND) ? Btrieve::CONNECTOR_AND : Btrieve::CONNECTOR_OR;
+      const BtrievePredicate *compound = NULL;
+      Btrieve::StatusCode status;
+
+      for (size_t i = 0; i < node->operands.size(); i++)
+      {
+         if (node->operands[i].node->kind == BtrievePredicate::COMPARISON)
+            continue;
+         if (compound != NULL)
+            return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+         compound = &node->operands[i];
+      }
+
+      bool joined = false;
+
+      if (compound != NULL)
+      {
+         if ((status = Emit(*compound, chain)) != Btrieve::STATUS_CODE_NO_ERROR)
+            return status;
+         joined = true;
+      }
+
+      for (size_t i = 0; i < node->operands.size(); i++)
+      {
+         if (&node->operands[i] == compound)
+            continue;
+         if (joined && (status = chain->back()->SetConnector(connector)) != Btrieve::STATUS_CODE_NO_ERROR)
+            return status;
+         if ((status = EmitComparison(*node->operands[i].node, chain)) != Btrieve::STATUS_CODE_NO_ERROR)
+            return status;
+         joined = true;
+      }
+
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   static Btrieve::StatusCode EmitComparison(const BtrievePredicate::Node &node, std::vector<std::unique_ptr<BtrieveFilter> > *chain)
+   {
+      std::unique_ptr<BtrieveFilter> filter(new BtrieveFilter());
+      Btrieve::StatusCode status;
+
+      if (node.comparison == Btrieve::COMPARISON_NONE)
+         return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+      if ((status = filter->SetField(node.field.offset, node.field.length, node.field.dataType)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      if ((status = filter->SetComparison(node.comparison)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+
+      if (node.hasOtherField)
+      {
+         // The engine reads the other field with the length of the first.
+         if (node.otherField.length != node.field.length || node.otherField.dataType != node.field.dataType)
+            return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+         if ((status = filter->SetComparisonField(node.otherField.offset)) != Btrieve::STATUS_CODE_NO_ERROR)
+            return status;
+      }
+      else
+      {
+         if (node.constant.empty())
+            return Btrieve::STATUS_CODE_INVALID_GET_EXPRESSION;
+         if ((status = filter->SetComparisonConstant(&node.constant[0], (int)node.constant.size())) != Btrieve::STATUS_CODE_NO_ERROR)
+            return status;
+      }
+
+      if (node.acsMode == Btrieve::ACS_MODE_NAMED)
+         status = filter->SetACSName(node.acsName.c_str());
+      else if (node.acsMode != Btrieve::ACS_MODE_NONE)
+         status = filter->SetACSMode(node.acsMode);
+      if (status != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+
+      chain->push_back(std::move(filter));
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   std::vector<std::unique_ptr<BtrieveFilter> > filters;
+   std::vector<std::pair<BtrieveField, int> > selected;
+   std::vector<std::pair<int, int> > extents;
+   int rowLength;
+};
+
+#endif
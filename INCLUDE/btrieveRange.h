@@ -0,0 +1,292 @@
+// btrieveRange.h : Batched iteration over a range of an index.
+//
+// A BtrieveRange walks an index from a low key up to an optional upper
+// bound, fetching records in batches with BulkRetrieveNext rather than
+// one RecordRetrieveNext per record, so a range-for loop makes one engine
+// call per batch:
+//
+//    BtrieveRange range(&btrieveFile, Btrieve::INDEX_1, (char *)&low, sizeof(low));
+//
+//    range.SetUpperBound(0, sizeof(high), Btrieve::DATA_TYPE_UNSIGNED_BINARY, (char *)&high);
+//    for (const BtrieveRangeRow &row : range)
+//       ...
+//
+// The upper bound is a filter on a key segment with a reject count of one,
+// so the engine ends the last batch at the first record past the bound.
+// It must be the leading, ascending segment of the index.
+
+#ifndef _BTRIEVERANGE_H
+#define _BTRIEVERANGE_H
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+
+#include <iterator>
+#include <vector>
+
+#include "btrieveCpp.h"
+
+/// \brief A record of a range, valid until the iterator that returned it advances.
+struct BtrieveRangeRow
+{
+   const char *record;
+   int length;
+   long long cursorPosition;
+
+   /// \brief Get the record as a \a Record, which must be no longer than the record.
+   template <typename Record>
+   const Record *As() const
+   {
+      assert((size_t)length >= sizeof(Record));
+      return (const Record *)record;
+   }
+};
+
+/// \brief A range of an index, from a low key to an optional upper bound, read in batches.
+class BtrieveRange
+{
+public:
+   /// \brief The number of records a batch holds unless SetBatchSize says otherwise.
+   static const int DEFAULT_BATCH_SIZE = 256;
+
+   /// \brief An input iterator over the records of a range.
+   class iterator
+   {
+      friend class BtrieveRange;
+
+   public:
+      typedef std::input_iterator_tag iterator_category;
+      typedef BtrieveRangeRow value_type;
+      typedef ptrdiff_t difference_type;
+      typedef const BtrieveRangeRow *pointer;
+      typedef const BtrieveRangeRow &reference;
+
+      iterator()
+         : range(NULL)
+      {
+      }
+
+      reference operator*() const
+      {
+         return range->row;
+      }
+
+      pointer operator->() const
+      {
+         return &range->row;
+      }
+
+      iterator &operator++()
+      {
+         if (!range->Advance())
+            range = NULL;
+         return *this;
+      }
+
+      bool operator==(const iterator &other) const
+      {
+         return range == other.range;
+      }
+
+      bool operator!=(const iterator &other) const
+      {
+         return range != other.range;
+      }
+
+   private:
+      explicit iterator(BtrieveRange *range)
+         : range(range)
+      {
+      }
+
+      BtrieveRange *range;
+   };
+
+   /// \param[in] btrieveFile The open file. The range doesn't own it, and moves its cursor.
+   /// \param[in] index The index.
+   /// \param[in] lowKey The key the range starts at; the first record has a key greater than or equal to it.
+   /// \param[in] lowKeyLength The length of the low key.
+   /// \param[in] recordSize The length of the longest record of the range.
+   BtrieveRange(BtrieveFile *btrieveFile, Btrieve::Index index, const char *lowKey, int lowKeyLength, int recordSize = Btrieve::MAXIMUM_RECORD_LENGTH)
+      : btrieveFile(btrieveFile), index(index), lowKey(lowKey, lowKey + lowKeyLength), record(recordSize), batchSize(DEFAULT_BATCH_SIZE), bounded(false),
+        boundStatusCode(Btrieve::STATUS_CODE_NO_ERROR)
+   {
+      Reset(Btrieve::STATUS_CODE_NO_ERROR);
+   }
+
+   /// \brief End the range at a key segment's value.
+   /// \param[in] offset The offset of the segment.
+   /// \param[in] length The length of the segment.
+   /// \param[in] dataType The data type of the segment.
+   /// \param[in] highKey The value of the segment the range ends at.
+   /// \param[in] inclusive Whether records whose segment equals the value are in the range.
+   /// \details If the bound can't be set, GetLastStatusCode and every walk report why, and the walks
+   /// return no records, until a bound is set; the range doesn't quietly run past where it should end.
+   Btrieve::StatusCode SetUpperBound(int offset, int length, Btrieve::DataType dataType, const char *highKey, bool inclusive = true)
+   {
+      Btrieve::StatusCode status;
+
+      if ((status = upperBound.SetField(offset, length, dataType)) == Btrieve::STATUS_CODE_NO_ERROR
+         && (status = upperBound.SetComparison(inclusive ? Btrieve::COMPARISON_LESS_THAN_OR_EQUAL : Btrieve::COMPARISON_LESS_THAN)) == Btrieve::STATUS_CODE_NO_ERROR)
+         status = upperBound.SetComparisonConstant(highKey, length);
+      bounded = (status == Btrieve::STATUS_CODE_NO_ERROR);
+      boundStatusCode = status;
+      if (status != Btrieve::STATUS_CODE_NO_ERROR)
+         lastStatusCode = status;
+      return status;
+   }
+
+   /// \brief Set the most records a batch holds, from 1 through 65535.
+   Btrieve::StatusCode SetBatchSize(int batchSize)
+   {
+      if (batchSize <= 0 || batchSize > 65535)
+         return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+      this->batchSize = batchSize;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Start the walk at the low key. Each call starts it again.
+   iterator begin()
+   {
+      return Start() ? iterator(this) : iterator();
+   }
+
+   iterator end()
+   {
+      return iterator();
+   }
+
+   /// \brief Get the status the last walk ended with; Btrieve::STATUS_CODE_NO_ERROR if it reached the end of the range.
+   Btrieve::StatusCode GetLastStatusCode() const
+   {
+      return lastStatusCode;
+   }
+
+   /// \brief Get the number of batches the last walk fetched.
+   int GetBatchCount() const
+   {
+      return batchCount;
+   }
+
+   /// \brief Get the number of records the last walk returned so far.
+   long long GetRecordCount() const
+   {
+      return recordCount;
+   }
+
+private:
+   BtrieveRange(const BtrieveRange &);
+   BtrieveRange &operator=(const BtrieveRange &);
+
+   void Reset(Btrieve::StatusCode status)
+   {
+      lastStatusCode = status;
+      batchCount = 0;
+      recordCount = 0;
+      position = 0;
+      count = 0;
+      lastBatch = true;
+      memset(&row, 0, sizeof(row));
+   }
+
+   // Position the cursor at the low key and fetch the first batch, which starts with that record.
+   bool Start()
+   {
+      int length;
+
+      Reset(boundStatusCode);
+      if (boundStatusCode != Btrieve::STATUS_CODE_NO_ERROR)
+         return false;
+      length = btrieveFile->RecordRetrieve(Btrieve::COMPARISON_GREATER_THAN_OR_EQUAL, index, lowKey.data(), (int)lowKey.size(), record.data(), (int)record.size());
+      if (length < 0)
+         return Finish(btrieveFile->GetLastStatusCode());
+      if (!Fetch(false))
+         return false;
+      return Load();
+   }
+
+   bool Advance()
+   {
+      if (++position < count)
+         return Load();
+      if (lastBatch || !Fetch(true))
+         return Finish(lastStatusCode);
+      return Load();
+   }
+
+   // Fetch the next batch; the first batch takes in the record at the cursor.
+   bool Fetch(bool skipCurrentRecord)
+   {
+      BtrieveBulkRetrieveAttributes btrieveBulkRetrieveAttributes;
+      Btrieve::StatusCode status;
+
+      if ((status = btrieveBulkRetrieveAttributes.SetMaximumRecordCount(batchSize)) != Btrieve::STATUS_CODE_NO_ERROR
+         || (status = btrieveBulkRetrieveAttributes.SetSkipCurrentRecord(skipCurrentRecord)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return Finish(status);
+      if (bounded)
+      {
+         if ((status = btrieveBulkRetrieveAttributes.AddFilter(&upperBound)) != Btrieve::STATUS_CODE_NO_ERROR
+            || (status = btrieveBulkRetrieveAttributes.SetMaximumRejectCount(1)) != Btrieve::STATUS_CODE_NO_ERROR)
+            return Finish(status);
+      }
+
+      status = btrieveFile->BulkRetrieveNext(&btrieveBulkRetrieveAttributes, &result);
+      batchCount++;
+      position = 0;
+      count = result.GetRecordCount();
+
+      // The end of the file, or the first record past the bound, ends the range with this batch.
+      if (status == Btrieve::STATUS_CODE_END_OF_FILE || status == Btrieve::STATUS_CODE_REJECT_COUNT_REACHED)
+         lastBatch = true;
+      else if (status != Btrieve::STATUS_CODE_NO_ERROR)
+         return Finish(status);
+      else
+         lastBatch = (count <= 0);
+      return count > 0 || Finish(Btrieve::STATUS_CODE_NO_ERROR);
+   }
+
+   // Copy the record at the batch position into the row.
+   bool Load()
+   {
+      int length = result.GetRecord(position, record.data(), (int)record.size());
+
+      if (length < 0 || length > (int)record.size())
+         return Finish((length < 0) ? result.GetLastStatusCode() : Btrieve::STATUS_CODE_DATALENGTH_ERROR);
+      row.record = record.data();
+      row.length = length;
+      row.cursorPosition = result.GetRecordCursorPosition(position);
+      recordCount++;
+      return true;
+   }
+
+   // End the walk; running out of records isn't an error.
+   bool Finish(Btrieve::StatusCode status)
+   {
+      if (status == Btrieve::STATUS_CODE_END_OF_FILE || status == Btrieve::STATUS_CODE_KEY_VALUE_NOT_FOUND || status == Btrieve::STATUS_CODE_REJECT_COUNT_REACHED)
+         status = Btrieve::STATUS_CODE_NO_ERROR;
+      lastStatusCode = status;
+      position = count = 0;
+      lastBatch = true;
+      return false;
+   }
+
+   BtrieveFile *btrieveFile;
+   Btrieve::Index index;
+   std::vector<char> lowKey;
+   std::vector<char> record;
+   int batchSize;
+   BtrieveFilter upperBound;
+   bool bounded;
+   Btrieve::StatusCode boundStatusCode;                                 // Why the last SetUpperBound failed, if it did.
+   BtrieveBulkRetrieveResult result;
+   int position;
+   int count;
+   bool lastBatch;
+   BtrieveRangeRow row;
+   Btrieve::StatusCode lastStatusCode;
+   int batchCount;
+   long long recordCount;
+};
+
+#endif
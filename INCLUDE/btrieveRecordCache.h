@@ -0,0 +1,489 @@
+// btrieveRecordCache.h : A read-through cache in front of the equality
+//                        lookups of a BtrieveFile.
+//
+// A BtrieveRecordCache wraps an open file. RecordRetrieve with
+// Btrieve::COMPARISON_EQUAL and no lock is answered from the cache when it
+// can be, and otherwise from the file, whose answer, the record or
+// Btrieve::STATUS_CODE_KEY_VALUE_NOT_FOUND, is kept for the next lookup of
+// the key:
+//
+//    BtrieveRecordCache btrieveRecordCache(&btrieveFile);
+//
+//    if (btrieveRecordCache.RecordRetrieve(Btrieve::COMPARISON_EQUAL, Btrieve::INDEX_1, (char *)&key, sizeof(key), (char *)&record, sizeof(record)) < 0)
+//       ... btrieveRecordCache.GetLastStatusCode() ...
+//
+// Writes through the cache, RecordCreate, RecordUpdate and RecordDelete,
+// drop what they make stale: an update or delete drops every key cached for
+// the record, and a create or update drops the keys cached as not found.
+// Writes by other handles aren't seen; a time to live bounds how long the
+// cache may answer from before them.
+//
+// The cache is split into shards, each with its own latch and its share of
+// the memory budget, over which it drops the entries used longest ago, so
+// threads that hit the cache don't wait for each other. Lookups that miss
+// take turns on the file.
+//
+// A lookup answered from the cache doesn't move the file's cursor. Each
+// thread has a record of its own on each cache instead: the one its last
+// retrieval or create through the cache returned. Updates and deletes
+// through the cache first move the cursor to the calling thread's record,
+// so threads that share a cache change the records they looked up, and
+// fail with Btrieve::STATUS_CODE_POSITION_NOT_SET if they have none.
+// Anything else that relies on the cursor must position it itself.
+
+#ifndef _BTRIEVERECORDCACHE_H
+#define _BTRIEVERECORDCACHE_H
+
+#include <stddef.h>
+#include <string.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "btrieveCpp.h"
+
+/// \brief A sharded, bounded read-through cache of the equality lookups of a file.
+class BtrieveRecordCache
+{
+public:
+   /// \brief The memory budget of a cache unless its constructor says otherwise.
+   static const size_t DEFAULT_MAXIMUM_BYTES = 16 * 1024 * 1024;
+   /// \brief The number of shards of a cache unless its constructor says otherwise.
+   static const int DEFAULT_SHARD_COUNT = 16;
+
+   /// \brief The cache's counters, since it was created or last cleared.
+   struct Statistics
+   {
+      long long hitCount;                                               ///< Lookups answered from the cache.
+      long long negativeHitCount;                                       ///< Hits that answered Btrieve::STATUS_CODE_KEY_VALUE_NOT_FOUND.
+      long long missCount;                                              ///< Lookups answered from the file.
+      long long evictionCount;                                          ///< Entries dropped to stay within the budget.
+      long long invalidationCount;                                      ///< Entries dropped by writes through the cache.
+      long long expirationCount;                                        ///< Entries dropped for outliving the time to live.
+      long long entryCount;                                             ///< Entries held now.
+      size_t byteCount;                                                 ///< Memory the entries take now.
+      size_t maximumBytes;                                              ///< The memory budget.
+
+      /// \brief Get the share of lookups answered from the cache.
+      double GetHitRatio() const
+      {
+         return (hitCount + missCount > 0) ? (double)hitCount / (double)(hitCount + missCount) : 0.0;
+      }
+   };
+
+   /// \param[in] btrieveFile The open file. The cache doesn't own it.
+   /// \param[in] maximumBytes The memory budget, shared evenly by the shards.
+   /// \param[in] shardCount The number of shards.
+   /// \param[in] ttlMilliseconds How long an entry may be used; zero for as long as it's in the cache.
+   explicit BtrieveRecordCache(BtrieveFile *btrieveFile, size_t maximumBytes = DEFAULT_MAXIMUM_BYTES, int shardCount = DEFAULT_SHARD_COUNT, int ttlMilliseconds = 0)
+      : btrieveFile(btrieveFile), maximumBytes(maximumBytes), shards((shardCount > 0) ? shardCount : 1), ttlMilliseconds((ttlMilliseconds > 0) ? ttlMilliseconds : 0),
+        notFoundGeneration(0), identifier(NextIdentifier())
+   {
+      shardBytes = maximumBytes / shards.size();
+   }
+
+   /// \brief Get the wrapped file.
+   BtrieveFile *GetFile() const
+   {
+      return btrieveFile;
+   }
+
+   /// \brief Retrieve a record by key, from the cache if it's an unlocked equality lookup.
+   /// \see BtrieveFile::RecordRetrieve
+   int RecordRetrieve(Btrieve::Comparison comparison, Btrieve::Index index, const char *key, int keyLength, char *record, int recordSize, Btrieve::LockMode lockMode = Btrieve::LOCK_MODE_NONE)
+   {
+      std::string cacheKey;
+      unsigned long long generation;
+      int length;
+
+      if (comparison != Btrieve::COMPARISON_EQUAL || lockMode != Btrieve::LOCK_MODE_NONE || key == NULL || keyLength < 0)
+      {
+         std::lock_guard<std::mutex> guard(fileLatch);
+
+         length = btrieveFile->RecordRetrieve(comparison, index, key, keyLength, record, recordSize, lockMode);
+         SetPosition((length >= 0) ? btrieveFile->GetCursorPosition() : -1, index);
+         return Finish(length, btrieveFile->GetLastStatusCode());
+      }
+
+      cacheKey.reserve(sizeof(index) + keyLength);
+      cacheKey.append((const char *)&index, sizeof(index));
+      cacheKey.append(key, keyLength);
+      Shard &shard = GetShard(cacheKey);
+
+      {
+         std::lock_guard<std::mutex> guard(shard.latch);
+         std::unordered_map<std::string, NodeList::iterator>::iterator found = shard.nodes.find(cacheKey);
+
+         if (found != shard.nodes.end() && IsFresh(&shard, found->second))
+         {
+            Node &node = *found->second;
+
+            shard.lru.splice(shard.lru.begin(), shard.lru, found->second);
+            shard.statistics.hitCount++;
+            if (!node.found)
+            {
+               shard.statistics.negativeHitCount++;
+               SetPosition(-1, index);
+               return Finish(-1, Btrieve::STATUS_CODE_KEY_VALUE_NOT_FOUND);
+            }
+            if (record == NULL)
+               return Finish(-1, Btrieve::STATUS_CODE_INVALID_PTR_PARM);
+            if ((int)node.record.size() > recordSize)
+               return Finish(-1, Btrieve::STATUS_CODE_DATALENGTH_ERROR);
+            memcpy(record, node.record.data(), node.record.size());
+            SetPosition(node.position, index);
+            return Finish((int)node.record.size(), Btrieve::STATUS_CODE_NO_ERROR);
+         }
+         shard.statistics.missCount++;
+      }
+
+      std::lock_guard<std::mutex> guard(fileLatch);
+      Btrieve::StatusCode status;
+      long long position = -1;
+
+      generation = notFoundGeneration;
+      length = btrieveFile->RecordRetrieve(comparison, index, key, keyLength, record, recordSize, lockMode);
+      status = btrieveFile->GetLastStatusCode();
+      if (length >= 0)
+         Store(&shard, cacheKey, true, record, length, position = btrieveFile->GetCursorPosition(), generation);
+      else if (status == Btrieve::STATUS_CODE_KEY_VALUE_NOT_FOUND)
+         Store(&shard, cacheKey, false, NULL, 0, -1, generation);
+      SetPosition(position, index);
+      return Finish(length, status);
+   }
+
+   /// \brief Create a record, dropping the keys cached as not found; it becomes the calling thread's record.
+   /// \see BtrieveFile::RecordCreate
+   Btrieve::StatusCode RecordCreate(char *record, int recordLength)
+   {
+      std::lock_guard<std::mutex> guard(fileLatch);
+      Btrieve::StatusCode status;
+
+      if ((status = btrieveFile->RecordCreate(record, recordLength)) == Btrieve::STATUS_CODE_NO_ERROR)
+      {
+         notFoundGeneration++;
+         SetPosition(btrieveFile->GetCursorPosition(), Btrieve::INDEX_NONE);
+      }
+      else
+         SetPosition(-1, Btrieve::INDEX_NONE);
+      return Finish(status);
+   }
+
+   /// \brief Update the calling thread's record, dropping the keys cached for it and those cached as not found.
+   /// \see BtrieveFile::RecordUpdate
+   Btrieve::StatusCode RecordUpdate(const char *record, int recordLength)
+   {
+      std::lock_guard<std::mutex> guard(fileLatch);
+      Btrieve::StatusCode status;
+      long long position;
+
+      if ((status = Reposition()) != Btrieve::STATUS_CODE_NO_ERROR)
+         return Finish(status);
+      position = btrieveFile->GetCursorPosition();
+      if ((status = btrieveFile->RecordUpdate(record, recordLength)) == Btrieve::STATUS_CODE_NO_ERROR)
+      {
+         Invalidate(position);
+         notFoundGeneration++;
+         SetPosition(btrieveFile->GetCursorPosition(), GetPosition().index);
+      }
+      return Finish(status);
+   }
+
+   /// \brief Delete the calling thread's record, dropping the keys cached for it.
+   /// \see BtrieveFile::RecordDelete
+   Btrieve::StatusCode RecordDelete()
+   {
+      std::lock_guard<std::mutex> guard(fileLatch);
+      Btrieve::StatusCode status;
+      long long position;
+
+      if ((status = Reposition()) != Btrieve::STATUS_CODE_NO_ERROR)
+         return Finish(status);
+      position = btrieveFile->GetCursorPosition();
+      if ((status = btrieveFile->RecordDelete()) == Btrieve::STATUS_CODE_NO_ERROR)
+      {
+         Invalidate(position);
+         SetPosition(-1, Btrieve::INDEX_NONE);
+      }
+      return Finish(status);
+   }
+
+   /// \brief Drop every entry and reset the counters.
+   void Clear()
+   {
+      for (size_t i = 0; i < shards.size(); i++)
+      {
+         std::lock_guard<std::mutex> guard(shards[i].latch);
+
+         shards[i].lru.clear();
+         shards[i].nodes.clear();
+         shards[i].positions.clear();
+         shards[i].byteCount = 0;
+         shards[i].statistics = ShardStatistics();
+      }
+   }
+
+   /// \brief Get the status of the calling thread's last call on a cache.
+   static Btrieve::StatusCode GetLastStatusCode()
+   {
+      return LastStatusCode();
+   }
+
+   /// \brief Get the cache's counters, summed over the shards.
+   Statistics GetStatistics()
+   {
+      Statistics statistics;
+
+      memset(&statistics, 0, sizeof(statistics));
+      statistics.maximumBytes = maximumBytes;
+      for (size_t i = 0; i < shards.size(); i++)
+      {
+         std::lock_guard<std::mutex> guard(shards[i].latch);
+         const ShardStatistics &shard = shards[i].statistics;
+
+         statistics.hitCount += shard.hitCount;
+         statistics.negativeHitCount += shard.negativeHitCount;
+         statistics.missCount += shard.missCount;
+         statistics.evictionCount += shard.evictionCount;
+         statistics.invalidationCount += shard.invalidationCount;
+         statistics.expirationCount += shard.expirationCount;
+         statistics.entryCount += (long long)shards[i].nodes.size();
+         statistics.byteCount += shards[i].byteCount;
+      }
+      return statistics;
+   }
+
+private:
+   BtrieveRecordCache(const BtrieveRecordCache &);
+   BtrieveRecordCache &operator=(const BtrieveRecordCache &);
+
+   struct Node
+   {
+      std::string key;
+      bool found;                                                       // False if the key was not found.
+      std::vector<char> record;
+      long long position;                                               // The record's cursor position, if found.
+      unsigned long long generation;                                    // The not found generation when it was looked up.
+      std::chrono::steady_clock::time_point stored;
+   };
+
+   typedef std::list<Node> NodeList;
+
+   struct ShardStatistics
+   {
+      ShardStatistics()
+         : hitCount(0), negativeHitCount(0), missCount(0), evictionCount(0), invalidationCount(0), expirationCount(0)
+      {
+      }
+
+      long long hitCount;
+      long long negativeHitCount;
+      long long missCount;
+      long long evictionCount;
+      long long invalidationCount;
+      long long expirationCount;
+   };
+
+   struct Shard
+   {
+      Shard()
+         : byteCount(0)
+      {
+      }
+
+      std::mutex latch;
+      NodeList lru;                                                     // Used most recently first.
+      std::unordered_map<std::string, NodeList::iterator> nodes;
+      std::unordered_multimap<long long, NodeList::iterator> positions;
+      size_t byteCount;
+      ShardStatistics statistics;
+   };
+
+   // The memory an entry takes besides its key and record: the node and its place in the maps.
+   static const size_t NODE_OVERHEAD = sizeof(Node) + 96;
+
+   // A thread's record on a cache: its cursor position, or -1 for none, and the index it was found by.
+   struct Position
+   {
+      Position()
+         : position(-1), index(Btrieve::INDEX_NONE)
+      {
+      }
+
+      long long position;
+      Btrieve::Index index;
+   };
+
+   static Btrieve::StatusCode &LastStatusCode()
+   {
+      static thread_local Btrieve::StatusCode lastStatusCode = Btrieve::STATUS_CODE_NO_ERROR;
+
+      return lastStatusCode;
+   }
+
+   // The calling thread's records, by cache identifier.
+   static std::unordered_map<unsigned long long, Position> &ThreadPositions()
+   {
+      static thread_local std::unordered_map<unsigned long long, Position> threadPositions;
+
+      return threadPositions;
+   }
+
+   // Identifiers aren't reused, so a cache never sees the records of one destroyed before it.
+   static unsigned long long NextIdentifier()
+   {
+      static std::atomic<unsigned long long> nextIdentifier(0);
+
+      return ++nextIdentifier;
+   }
+
+   Position GetPosition() const
+   {
+      std::unordered_map<unsigned long long, Position>::const_iterator found = ThreadPositions().find(identifier);
+
+      return (found == ThreadPositions().end()) ? Position() : found->second;
+   }
+
+   void SetPosition(long long position, Btrieve::Index index)
+   {
+      Position &threadPosition = ThreadPositions()[identifier];
+
+      threadPosition.position = position;
+      threadPosition.index = index;
+   }
+
+   static int Finish(int result, Btrieve::StatusCode status)
+   {
+      LastStatusCode() = status;
+      return result;
+   }
+
+   static Btrieve::StatusCode Finish(Btrieve::StatusCode status)
+   {
+      return LastStatusCode() = status;
+   }
+
+   Shard &GetShard(const std::string &cacheKey)
+   {
+      return shards[std::hash<std::string>()(cacheKey) % shards.size()];
+   }
+
+   // Whether an entry may still be used; drops it if not. The shard's latch is held.
+   bool IsFresh(Shard *shard, NodeList::iterator node)
+   {
+      if (!node->found && node->generation != notFoundGeneration)
+      {
+         shard->statistics.invalidationCount++;
+         Erase(shard, node);
+         return false;
+      }
+      if (ttlMilliseconds > 0 && std::chrono::steady_clock::now() - node->stored >= std::chrono::milliseconds(ttlMilliseconds))
+      {
+         shard->statistics.expirationCount++;
+         Erase(shard, node);
+         return false;
+      }
+      return true;
+   }
+
+   void Store(Shard *shard, const std::string &cacheKey, bool found, const char *record, int length, long long position, unsigned long long generation)
+   {
+      std::lock_guard<std::mutex> guard(shard->latch);
+      std::unordered_map<std::string, NodeList::iterator>::iterator existing = shard->nodes.find(cacheKey);
+      size_t bytes = NODE_OVERHEAD + cacheKey.size() + length;
+
+      if (bytes > shardBytes)
+         return;
+      if (existing != shard->nodes.end())
+         Erase(shard, existing->second);
+
+      shard->lru.push_front(Node());
+      Node &node = shard->lru.front();
+
+      node.key = cacheKey;
+      node.found = found;
+      node.record.assign(record, record + length);
+      node.position = position;
+      node.generation = generation;
+      node.stored = std::chrono::steady_clock::now();
+      shard->nodes[cacheKey] = shard->lru.begin();
+      if (found)
+         shard->positions.insert(std::make_pair(position, shard->lru.begin()));
+      shard->byteCount += bytes;
+
+      while (shard->byteCount > shardBytes)
+      {
+         shard->statistics.evictionCount++;
+         Erase(shard, --shard->lru.end());
+      }
+   }
+
+   void Erase(Shard *shard, NodeList::iterator node)
+   {
+      if (node->found)
+      {
+         std::pair<std::unordered_multimap<long long, NodeList::iterator>::iterator, std::unordered_multimap<long long, NodeList::iterator>::iterator> range = shard->positions.equal_range(node->position);
+
+         for (; range.first != range.second; ++range.first)
+            if (range.first->second == node)
+            {
+               shard->positions.erase(range.first);
+               break;
+            }
+      }
+      shard->byteCount -= NODE_OVERHEAD + node->key.size() + node->record.size();
+      shard->nodes.erase(node->key);
+      shard->lru.erase(node);
+   }
+
+   // Drop every key cached for the record at a cursor position.
+   void Invalidate(long long position)
+   {
+      for (size_t i = 0; i < shards.size(); i++)
+      {
+         Shard &shard = shards[i];
+         std::lock_guard<std::mutex> guard(shard.latch);
+         std::unordered_multimap<long long, NodeList::iterator>::iterator found;
+
+         while ((found = shard.positions.find(position)) != shard.positions.end())
+         {
+            shard.statistics.invalidationCount++;
+            Erase(&shard, found->second);
+         }
+      }
+   }
+
+   // Move the cursor to the calling thread's record, unless it's there already. The file's latch is held.
+   Btrieve::StatusCode Reposition()
+   {
+      Position threadPosition = GetPosition();
+
+      if (threadPosition.position < 0)
+         return Btrieve::STATUS_CODE_POSITION_NOT_SET;
+      if (btrieveFile->GetCursorPosition() == threadPosition.position)
+         return Btrieve::STATUS_CODE_NO_ERROR;
+      scratch.resize(Btrieve::MAXIMUM_RECORD_LENGTH);
+      if (btrieveFile->RecordRetrieveByCursorPosition(threadPosition.index, threadPosition.position, scratch.data(), (int)scratch.size()) < 0)
+         return btrieveFile->GetLastStatusCode();
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   BtrieveFile *btrieveFile;
+   size_t maximumBytes;
+   size_t shardBytes;
+   std::vector<Shard> shards;
+   int ttlMilliseconds;
+
+   std::mutex fileLatch;                                                // Held for every call on the file.
+   std::atomic<unsigned long long> notFoundGeneration;                  // Counts the writes that may have added keys.
+   const unsigned long long identifier;                                 // Keys the threads' records on this cache.
+   std::vector<char> scratch;
+};
+
+#endif
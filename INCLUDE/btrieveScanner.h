@@ -0,0 +1,298 @@
+// btrieveScanner.h : A scan of an index that fetches its next batch while
+//                    the caller works on the current one.
+//
+// A BtrieveScanner opens a handle of its own on the file and gives it to
+// a background thread, which reads batches with BulkRetrieveNext into one
+// of two results while the caller holds the other:
+//
+//    BtrieveScanner scanner(&btrieveClient, "squares.btr");
+//
+//    scanner.Start(Btrieve::INDEX_1, btrieveFile.GetCursorPosition());
+//    while ((btrieveBulkRetrieveResult = scanner.NextBatch()) != NULL)
+//       ...
+//
+// The scan starts at a cursor position, which RecordRetrieveByCursorPosition
+// turns into a position in the index on the scanner's handle. The client
+// must not be used by another thread while the scanner opens or closes its
+// handle, in its constructor and destructor.
+//
+// The scanner counts the time the thread spent fetching and the time the
+// caller spent waiting for a batch; the difference is the fetch time that
+// overlapped the caller's processing.
+
+#ifndef _BTRIEVESCANNER_H
+#define _BTRIEVESCANNER_H
+
+#include <stdint.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "btrieveCpp.h"
+
+/// \brief A double buffered scan of an index, read in batches on a thread of its own.
+class BtrieveScanner
+{
+public:
+   /// \brief The number of records a batch holds unless SetBatchSize says otherwise.
+   static const int DEFAULT_BATCH_SIZE = 256;
+
+   /// \param[in] btrieveClient The client that opens the scanner's handle.
+   /// \param[in] fileName The file.
+   /// \param[in] ownerName The owner name, if any.
+   BtrieveScanner(BtrieveClient *btrieveClient, const char *fileName, const char *ownerName = NULL)
+      : btrieveClient(btrieveClient), batchSize(DEFAULT_BATCH_SIZE), running(false), stopping(false)
+   {
+      Reset();
+      openStatus = btrieveClient->FileOpen(&btrieveFile, fileName, ownerName, Btrieve::OPEN_MODE_READ_ONLY);
+   }
+
+   ~BtrieveScanner()
+   {
+      Stop();
+      if (openStatus == Btrieve::STATUS_CODE_NO_ERROR)
+         btrieveClient->FileClose(&btrieveFile);
+   }
+
+   /// \brief Set the most records a batch holds, from 1 through 65535. Takes effect at the next Start.
+   Btrieve::StatusCode SetBatchSize(int batchSize)
+   {
+      if (batchSize <= 0 || batchSize > 65535)
+         return Btrieve::STATUS_CODE_INVALID_FUNCTION;
+      this->batchSize = batchSize;
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Start the scan at a record and begin fetching the first batch, which starts with that record.
+   /// \param[in] index The index to scan in the order of, or Btrieve::INDEX_NONE for physical order.
+   /// \param[in] cursorPosition The cursor position of the first record.
+   Btrieve::StatusCode Start(Btrieve::Index index, long long cursorPosition)
+   {
+      Stop();
+      Reset();
+      if (openStatus != Btrieve::STATUS_CODE_NO_ERROR)
+         return lastStatusCode = openStatus;
+
+      this->index = index;
+      this->cursorPosition = cursorPosition;
+      stopping = false;
+      requested = 0;
+      running = true;
+      thread = std::thread(&BtrieveScanner::Run, this);
+      return Btrieve::STATUS_CODE_NO_ERROR;
+   }
+
+   /// \brief Take the next batch, waiting for it if it's still being fetched.
+   /// \details The batch stays valid until the next call, which hands it back to be refilled.
+   /// \return The batch, or NULL at the end of the scan or on an error; see GetLastStatusCode.
+   BtrieveBulkRetrieveResult *NextBatch()
+   {
+      std::unique_lock<std::mutex> guard(latch);
+      std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+      Btrieve::StatusCode status;
+
+      if (!running || (exhausted && fetched < 0))
+         return NULL;
+      while (fetched < 0)
+         changed.wait(guard);
+      waitNanoseconds += ElapsedNanoseconds(started);
+
+      held = fetched;
+      fetched = -1;
+      status = fetchedStatus;
+
+      // The end of the file, or a rejected record, ends the scan with this batch.
+      if (status == Btrieve::STATUS_CODE_END_OF_FILE || status == Btrieve::STATUS_CODE_REJECT_COUNT_REACHED)
+         exhausted = true;
+      else if (status != Btrieve::STATUS_CODE_NO_ERROR)
+      {
+         exhausted = true;
+         lastStatusCode = status;
+         return NULL;
+      }
+      else if (results[held].GetRecordCount() <= 0)
+         exhausted = true;
+
+      // While the caller works on this batch, fetch the next one into the other result.
+      if (!exhausted)
+      {
+         requested = 1 - held;
+         changed.notify_all();
+      }
+
+      if (results[held].GetRecordCount() <= 0)
+         return NULL;
+      batchCount++;
+      recordCount += results[held].GetRecordCount();
+      return &results[held];
+   }
+
+   /// \brief End the scan, waiting for a fetch in progress.
+   void Stop()
+   {
+      {
+         std::lock_guard<std::mutex> guard(latch);
+
+         stopping = true;
+         changed.notify_all();
+      }
+      if (thread.joinable())
+         thread.join();
+      running = false;
+   }
+
+   /// \brief Get the status the scan ended with; Btrieve::STATUS_CODE_NO_ERROR if it reached the end.
+   Btrieve::StatusCode GetLastStatusCode()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return lastStatusCode;
+   }
+
+   /// \brief Get the number of batches taken since Start.
+   int GetBatchCount()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return batchCount;
+   }
+
+   /// \brief Get the number of records taken since Start.
+   long long GetRecordCount()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return recordCount;
+   }
+
+   /// \brief Get the time the thread spent fetching since Start.
+   uint64_t GetFetchNanoseconds()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return fetchNanoseconds;
+   }
+
+   /// \brief Get the time NextBatch spent waiting for batches since Start.
+   uint64_t GetWaitNanoseconds()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return waitNanoseconds;
+   }
+
+   /// \brief Get the fetch time that overlapped the caller's processing since Start.
+   uint64_t GetOverlappedNanoseconds()
+   {
+      std::lock_guard<std::mutex> guard(latch);
+
+      return (fetchNanoseconds > waitNanoseconds) ? fetchNanoseconds - waitNanoseconds : 0;
+   }
+
+private:
+   BtrieveScanner(const BtrieveScanner &);
+   BtrieveScanner &operator=(const BtrieveScanner &);
+
+   static uint64_t ElapsedNanoseconds(std::chrono::steady_clock::time_point started)
+   {
+      return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - started).count();
+   }
+
+   void Reset()
+   {
+      lastStatusCode = Btrieve::STATUS_CODE_NO_ERROR;
+      requested = -1;
+      fetched = -1;
+      held = -1;
+      exhausted = false;
+      batchCount = 0;
+      recordCount = 0;
+      fetchNanoseconds = 0;
+      waitNanoseconds = 0;
+   }
+
+   // The thread: fetch a batch into each result the caller hands back, until stopped.
+   void Run()
+   {
+      bool first = true;
+
+      for (;;)
+      {
+         std::chrono::steady_clock::time_point started;
+         Btrieve::StatusCode status;
+         int result;
+
+         {
+            std::unique_lock<std::mutex> guard(latch);
+
+            while (!stopping && requested < 0)
+               changed.wait(guard);
+            if (stopping)
+               return;
+            result = requested;
+            requested = -1;
+         }
+
+         started = std::chrono::steady_clock::now();
+         status = Fetch(&results[result], first);
+         first = false;
+
+         {
+            std::lock_guard<std::mutex> guard(latch);
+
+            fetchNanoseconds += ElapsedNanoseconds(started);
+            fetched = result;
+            fetchedStatus = status;
+            changed.notify_all();
+         }
+      }
+   }
+
+   // Fetch a batch on the scanner's handle; the first positions it at the starting record.
+   Btrieve::StatusCode Fetch(BtrieveBulkRetrieveResult *btrieveBulkRetrieveResult, bool first)
+   {
+      BtrieveBulkRetrieveAttributes btrieveBulkRetrieveAttributes;
+      Btrieve::StatusCode status;
+
+      if ((status = btrieveBulkRetrieveAttributes.SetMaximumRecordCount(batchSize)) != Btrieve::STATUS_CODE_NO_ERROR
+         || (status = btrieveBulkRetrieveAttributes.SetSkipCurrentRecord(!first)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      if (first)
+      {
+         std::vector<char> record(Btrieve::MAXIMUM_RECORD_LENGTH);
+
+         if (btrieveFile.RecordRetrieveByCursorPosition(index, cursorPosition, record.data(), (int)record.size()) < 0)
+            return btrieveFile.GetLastStatusCode();
+      }
+      return btrieveFile.BulkRetrieveNext(&btrieveBulkRetrieveAttributes, btrieveBulkRetrieveResult);
+   }
+
+   BtrieveClient *btrieveClient;
+   BtrieveFile btrieveFile;
+   Btrieve::StatusCode openStatus;
+   Btrieve::Index index;
+   long long cursorPosition;
+   int batchSize;
+
+   std::thread thread;
+   std::mutex latch;
+   std::condition_variable changed;
+   BtrieveBulkRetrieveResult results[2];
+   bool running;
+   bool stopping;
+   int requested;                                                       // The result to fetch into, or -1.
+   int fetched;                                                         // The result fetched and not yet taken, or -1.
+   int held;                                                            // The result the caller holds, or -1.
+   Btrieve::StatusCode fetchedStatus;
+   bool exhausted;
+   Btrieve::StatusCode lastStatusCode;
+   int batchCount;
+   long long recordCount;
+   uint64_t fetchNanoseconds;
+   uint64_t waitNanoseconds;
+};
+
+#endif
@@ -0,0 +1,366 @@
+// btrieveTable.h : Typed tables over packed record structs.
+//
+// A BtrieveTable binds a BtrieveFile to a packed record struct. Its
+// indexes are described by types, so key segment offsets, lengths and
+// data types are fixed at compile time:
+//
+//    typedef BtrieveTable<record_t, BTRIEVE_KEY(record_t, x)> squaresTable_t;
+//
+// The lengths and data types come from the members' types, and whether a
+// segment fits in the record is checked at compile time. The offsets are
+// not checked against the members: BTRIEVE_KEY and BTRIEVE_KEY_AS take
+// both the member pointer and offsetof from the same member name, which
+// is what keeps them in agreement.
+//
+// Typed calls pass the caller's record and key storage straight through
+// to BtrieveFile; nothing is looked up or copied at run time, except the
+// segments of a multi-segment key searched for by example.
+
+#ifndef _BTRIEVETABLE_H
+#define _BTRIEVETABLE_H
+
+#include <stddef.h>
+#include <string.h>
+
+#include <tuple>
+#include <type_traits>
+
+#include "btrieveCpp.h"
+#include "btrieveRange.h"
+
+/// \brief The data type a member of type \a T is keyed as, unless its key says otherwise.
+/// \details Unsigned integers are Btrieve::DATA_TYPE_UNSIGNED_BINARY, signed integers
+/// Btrieve::DATA_TYPE_INTEGER, floating point numbers Btrieve::DATA_TYPE_FLOAT and
+/// character arrays Btrieve::DATA_TYPE_ZSTRING. Other types need an explicit data type.
+template <typename T, typename Enable = void>
+struct BtrieveDataTypeOf
+{
+   static_assert(sizeof(T) == 0, "No default Btrieve data type for this member type; give the key one.");
+   static const Btrieve::DataType value = Btrieve::DATA_TYPE_UNKNOWN;
+};
+
+template <typename T>
+struct BtrieveDataTypeOf<T, typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value>::type>
+{
+   static const Btrieve::DataType value = Btrieve::DATA_TYPE_UNSIGNED_BINARY;
+};
+
+template <typename T>
+struct BtrieveDataTypeOf<T, typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value>::type>
+{
+   static const Btrieve::DataType value = Btrieve::DATA_TYPE_INTEGER;
+};
+
+template <typename T>
+struct BtrieveDataTypeOf<T, typename std::enable_if<std::is_floating_point<T>::value>::type>
+{
+   static const Btrieve::DataType value = Btrieve::DATA_TYPE_FLOAT;
+};
+
+template <size_t N>
+struct BtrieveDataTypeOf<char[N], void>
+{
+   static const Btrieve::DataType value = Btrieve::DATA_TYPE_ZSTRING;
+};
+
+/// \brief The record type and value type of a pointer to a data member.
+template <auto Member>
+struct BtrieveMemberTraits;
+
+template <typename Record, typename T, T Record::*Member>
+struct BtrieveMemberTraits<Member>
+{
+   typedef Record RecordType;
+   typedef T ValueType;
+};
+
+/// \brief A key segment over one member of a record.
+/// \details Prefer BTRIEVE_KEY or BTRIEVE_KEY_AS, which supply the offset of the member.
+/// \tparam Member A pointer to the member.
+/// \tparam Offset The offset of the member within the record, which isn't checked against \a Member.
+/// \tparam DataType The data type of the segment.
+/// \tparam Descending Whether the segment sorts in descending order.
+template <auto Member, size_t Offset, Btrieve::DataType DataType = BtrieveDataTypeOf<typename BtrieveMemberTraits<Member>::ValueType>::value, bool Descending = false>
+struct BtrieveKey
+{
+   typedef typename BtrieveMemberTraits<Member>::RecordType RecordType;
+   typedef typename BtrieveMemberTraits<Member>::ValueType ValueType;
+
+   static const int OFFSET = (int)Offset;
+   static const int LENGTH = (int)sizeof(ValueType);
+   static const Btrieve::DataType DATA_TYPE = DataType;
+   static const bool DESCENDING = Descending;
+
+   static_assert(Offset + sizeof(ValueType) <= sizeof(RecordType), "The key segment lies outside the record.");
+   static_assert(sizeof(ValueType) <= (size_t)Btrieve::MAXIMUM_KEY_LENGTH, "The key segment is longer than Btrieve::MAXIMUM_KEY_LENGTH.");
+
+   /// \brief Add the segment to index attributes.
+   static Btrieve::StatusCode AddTo(BtrieveIndexAttributes *btrieveIndexAttributes)
+   {
+      BtrieveKeySegment btrieveKeySegment;
+      Btrieve::StatusCode status;
+
+      if ((status = btrieveKeySegment.SetField(OFFSET, LENGTH, DataType)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      if (Descending && (status = btrieveKeySegment.SetDescendingSortOrder(true)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      return btrieveIndexAttributes->AddKeySegment(&btrieveKeySegment);
+   }
+
+   /// \brief Copy the segment of a record into a key buffer.
+   static char *CopyTo(const RecordType &record, char *key)
+   {
+      memcpy(key, (const char *)&record + Offset, sizeof(ValueType));
+      return key + sizeof(ValueType);
+   }
+};
+
+/// \brief A key segment over a member of a record, with the data type derived from the member.
+#define BTRIEVE_KEY(Record, member) BtrieveKey<&Record::member, offsetof(Record, member)>
+
+/// \brief A key segment over a member of a record, with an explicit data type and sort order.
+#define BTRIEVE_KEY_AS(Record, member, dataType, descending) BtrieveKey<&Record::member, offsetof(Record, member), dataType, descending>
+
+/// \brief An index of one or more key segments of the same record.
+/// \tparam DuplicateMode The duplicate mode of the index.
+/// \tparam Segments The key segments, each a BtrieveKey, in key order.
+template <Btrieve::DuplicateMode DuplicateMode, typename... Segments>
+struct BtrieveIndex
+{
+   static_assert(sizeof...(Segments) > 0, "An index needs at least one key segment.");
+
+   typedef typename std::tuple_element<0, std::tuple<Segments...> >::type FirstSegment;
+   typedef typename FirstSegment::RecordType RecordType;
+   typedef typename FirstSegment::ValueType ValueType;
+
+   static const int SEGMENT_COUNT = (int)sizeof...(Segments);
+   static const int KEY_LENGTH = (Segments::LENGTH + ...);
+
+   static_assert((std::is_same<typename Segments::RecordType, RecordType>::value && ...), "Every key segment of an index must be a member of the same record.");
+   static_assert(KEY_LENGTH <= Btrieve::MAXIMUM_KEY_LENGTH, "The key is longer than Btrieve::MAXIMUM_KEY_LENGTH.");
+
+   /// \brief Fill in index attributes for the index, numbered \a index.
+   static Btrieve::StatusCode GetIndexAttributes(Btrieve::Index index, BtrieveIndexAttributes *btrieveIndexAttributes)
+   {
+      Btrieve::StatusCode status;
+
+      if ((status = btrieveIndexAttributes->SetIndex(index)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      if ((status = btrieveIndexAttributes->SetDuplicateMode(DuplicateMode)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      ((status == Btrieve::STATUS_CODE_NO_ERROR && (status = Segments::AddTo(btrieveIndexAttributes)) == Btrieve::STATUS_CODE_NO_ERROR) && ...);
+      return status;
+   }
+
+   /// \brief Build the key of a record, which must hold KEY_LENGTH bytes.
+   static void BuildKey(const RecordType &record, char *key)
+   {
+      ((key = Segments::CopyTo(record, key)), ...);
+   }
+};
+
+/// \brief The index a table's index type stands for; a lone key segment is a unique index over it.
+template <typename Index>
+struct BtrieveIndexOf
+{
+   typedef Index type;
+};
+
+template <auto Member, size_t Offset, Btrieve::DataType DataType, bool Descending>
+struct BtrieveIndexOf<BtrieveKey<Member, Offset, DataType, Descending> >
+{
+   typedef BtrieveIndex<Btrieve::DUPLICATE_MODE_NOT_ALLOWED, BtrieveKey<Member, Offset, DataType, Descending> > type;
+};
+
+/// \brief A typed view of a file of fixed length \a Record records.
+/// \tparam Record A packed, trivially copyable struct.
+/// \tparam Indexes The indexes of the file, numbered from Btrieve::INDEX_1; each a BtrieveIndex or a BtrieveKey.
+template <typename Record, typename... Indexes>
+class BtrieveTable
+{
+public:
+   static_assert(std::is_standard_layout<Record>::value && std::is_trivially_copyable<Record>::value, "A record must be a standard layout, trivially copyable struct.");
+   static_assert(sizeof(Record) <= (size_t)Btrieve::MAXIMUM_RECORD_LENGTH, "The record is longer than Btrieve::MAXIMUM_RECORD_LENGTH.");
+   static_assert(sizeof...(Indexes) <= Btrieve::INDEX_119 - Btrieve::INDEX_1 + 1, "A file has at most 119 indexes.");
+   static_assert((std::is_same<typename BtrieveIndexOf<Indexes>::type::RecordType, Record>::value && ...), "Every index of a table must be over its record.");
+
+   /// \brief The number of indexes.
+   static const int INDEX_COUNT = (int)sizeof...(Indexes);
+
+   /// \brief The index type of the index numbered \a I from zero.
+   template <size_t I>
+   using IndexAt = typename BtrieveIndexOf<typename std::tuple_element<I, std::tuple<Indexes...> >::type>::type;
+
+   /// \brief The index number of the index numbered \a I from zero.
+   template <size_t I>
+   static constexpr Btrieve::Index IndexNumber()
+   {
+      return (Btrieve::Index)(Btrieve::INDEX_1 + (int)I);
+   }
+
+   /// \param[in] btrieveFile The open file. The table doesn't own it.
+   explicit BtrieveTable(BtrieveFile *btrieveFile)
+      : btrieveFile(btrieveFile)
+   {
+   }
+
+   /// \brief Get the file.
+   BtrieveFile *GetFile() const
+   {
+      return btrieveFile;
+   }
+
+   /// \brief Fill in file attributes for a file of \a Record records.
+   static Btrieve::StatusCode GetFileAttributes(BtrieveFileAttributes *btrieveFileAttributes)
+   {
+      return btrieveFileAttributes->SetFixedRecordLength((int)sizeof(Record));
+   }
+
+   /// \brief Fill in index attributes for the index numbered \a I from zero.
+   template <size_t I>
+   static Btrieve::StatusCode GetIndexAttributes(BtrieveIndexAttributes *btrieveIndexAttributes)
+   {
+      return IndexAt<I>::GetIndexAttributes(IndexNumber<I>(), btrieveIndexAttributes);
+   }
+
+   /// \brief Create every index of the table.
+   Btrieve::StatusCode CreateIndexes()
+   {
+      return CreateIndexes(std::make_index_sequence<sizeof...(Indexes)>());
+   }
+
+   /// \brief Create a record.
+   /// \param[in,out] record The record. The engine may fill in system assigned fields.
+   Btrieve::StatusCode Insert(Record *record)
+   {
+      return btrieveFile->RecordCreate((char *)record, (int)sizeof(Record));
+   }
+
+   /// \brief Update the current record.
+   Btrieve::StatusCode Update(const Record &record)
+   {
+      return btrieveFile->RecordUpdate((const char *)&record, (int)sizeof(Record));
+   }
+
+   /// \brief Delete the current record.
+   Btrieve::StatusCode Delete()
+   {
+      return btrieveFile->RecordDelete();
+   }
+
+   /// \brief Retrieve a record by the value of a single segment index.
+   /// \param[in] key The value of the key member.
+   /// \param[out] record The record.
+   /// \param[in] comparison The comparison.
+   template <size_t I>
+   Btrieve::StatusCode Find(const typename IndexAt<I>::ValueType &key, Record *record, Btrieve::Comparison comparison = Btrieve::COMPARISON_EQUAL)
+   {
+      static_assert(IndexAt<I>::SEGMENT_COUNT == 1, "Find takes the key of a single segment index; use FindByExample.");
+      return Retrieved(btrieveFile->RecordRetrieve(comparison, IndexNumber<I>(), (const char *)&key, (int)sizeof(key), (char *)record, (int)sizeof(Record)));
+   }
+
+   /// \brief Retrieve a record by the key of another record.
+   /// \param[in] example A record holding the key.
+   /// \param[out] record The record.
+   /// \param[in] comparison The comparison.
+   template <size_t I>
+   Btrieve::StatusCode FindByExample(const Record &example, Record *record, Btrieve::Comparison comparison = Btrieve::COMPARISON_EQUAL)
+   {
+      char key[IndexAt<I>::KEY_LENGTH];
+
+      IndexAt<I>::BuildKey(example, key);
+      return Retrieved(btrieveFile->RecordRetrieve(comparison, IndexNumber<I>(), key, (int)sizeof(key), (char *)record, (int)sizeof(Record)));
+   }
+
+   /// \brief Visit every record in the order of an index.
+   /// \param[in] visit Called with each record; returns false to stop the scan.
+   /// \retval "= Btrieve::STATUS_CODE_NO_ERROR" The scan reached the end, or \a visit stopped it.
+   template <size_t I, typename Visitor>
+   Btrieve::StatusCode Scan(Visitor visit)
+   {
+      Record record;
+
+      return Visit(Retrieved(btrieveFile->RecordRetrieveFirst(IndexNumber<I>(), (char *)&record, (int)sizeof(Record))), &record, visit);
+   }
+
+   /// \brief Visit the records from a key onwards in the order of a single segment index.
+   /// \param[in] key The value of the key member to start from.
+   /// \param[in] visit Called with each record; returns false to stop the scan.
+   template <size_t I, typename Visitor>
+   Btrieve::StatusCode ScanFrom(const typename IndexAt<I>::ValueType &key, Visitor visit)
+   {
+      Record record;
+
+      return Visit(Find<I>(key, &record, Btrieve::COMPARISON_GREATER_THAN_OR_EQUAL), &record, visit);
+   }
+
+   /// \brief The records of a single segment index from one key through another, read in batches.
+   /// \details Iterate with a range-for loop; each row's As<Record>() is the record.
+   template <size_t I>
+   class Range : public BtrieveRange
+   {
+   public:
+      static_assert(IndexAt<I>::SEGMENT_COUNT == 1, "A range is over a single segment index.");
+      static_assert(!IndexAt<I>::FirstSegment::DESCENDING, "A range's upper bound needs an ascending segment.");
+
+      /// \param[in] btrieveTable The table.
+      /// \param[in] low The value of the key member the range starts at.
+      /// \param[in] high The value of the key member the range ends at, inclusive.
+      /// \details If the bound can't be set, begin() returns no rows and GetLastStatusCode reports why.
+      Range(BtrieveTable *btrieveTable, const typename IndexAt<I>::ValueType &low, const typename IndexAt<I>::ValueType &high)
+         : BtrieveRange(btrieveTable->GetFile(), IndexNumber<I>(), (const char *)&low, (int)sizeof(low), (int)sizeof(Record))
+      {
+         typedef typename IndexAt<I>::FirstSegment Segment;
+
+         SetUpperBound(Segment::OFFSET, Segment::LENGTH, Segment::DATA_TYPE, (const char *)&high);
+      }
+   };
+
+private:
+   template <size_t... I>
+   Btrieve::StatusCode CreateIndexes(std::index_sequence<I...>)
+   {
+      Btrieve::StatusCode status = Btrieve::STATUS_CODE_NO_ERROR;
+
+      ((status == Btrieve::STATUS_CODE_NO_ERROR && (status = CreateIndex<I>()) == Btrieve::STATUS_CODE_NO_ERROR) && ...);
+      return status;
+   }
+
+   template <size_t I>
+   Btrieve::StatusCode CreateIndex()
+   {
+      BtrieveIndexAttributes btrieveIndexAttributes;
+      Btrieve::StatusCode status;
+
+      if ((status = GetIndexAttributes<I>(&btrieveIndexAttributes)) != Btrieve::STATUS_CODE_NO_ERROR)
+         return status;
+      return btrieveFile->IndexCreate(&btrieveIndexAttributes);
+   }
+
+   // Turn the length a retrieval returned into a status code.
+   Btrieve::StatusCode Retrieved(int length)
+   {
+      Btrieve::StatusCode status;
+
+      if (length == (int)sizeof(Record))
+         return Btrieve::STATUS_CODE_NO_ERROR;
+      status = btrieveFile->GetLastStatusCode();
+      return (status != Btrieve::STATUS_CODE_NO_ERROR) ? status : Btrieve::STATUS_CODE_DATALENGTH_ERROR;
+   }
+
+   template <typename Visitor>
+   Btrieve::StatusCode Visit(Btrieve::StatusCode status, Record *record, Visitor &visit)
+   {
+      while (status == Btrieve::STATUS_CODE_NO_ERROR)
+      {
+         if (!visit((const Record &)*record))
+            return Btrieve::STATUS_CODE_NO_ERROR;
+         status = Retrieved(btrieveFile->RecordRetrieveNext((char *)record, (int)sizeof(Record)));
+      }
+      return (status == Btrieve::STATUS_CODE_END_OF_FILE) ? Btrieve::STATUS_CODE_NO_ERROR : status;
+   }
+
+   BtrieveFile *btrieveFile;
+};
+
+#endif